@@ -103,6 +103,17 @@ void RunnerConfig::SetConfigPath(const std::string &config_path) { SetConfigPath
 
 std::string RunnerConfig::GetConfigPath() const { return CharToString(GetConfigPathChar()); }
 
+/// \brief The latency histogram of the dynamic batches of one batch size. Bucket i counts the batches whose latency is
+/// in [2^(i-1), 2^i) milliseconds, bucket 0 counts the batches faster than 1 millisecond and the last bucket counts the
+/// rest. The latency of a batch includes the time its first request waits in the queue.
+struct BatchLatencyHistogram {
+  static constexpr size_t kBucketNum = 16;
+  size_t count = 0;
+  double total_ms = 0;
+  double max_ms = 0;
+  size_t buckets[kBucketNum] = {0};
+};
+
 class ModelParallelRunnerImpl;
 
 /// \brief The ModelParallelRunner class is used to define a MindSpore ModelParallelRunner, facilitating Model
@@ -156,6 +167,12 @@ class MS_API ModelParallelRunner {
   Status Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
                  const MSKernelCallBack &before = nullptr, const MSKernelCallBack &after = nullptr);
 
+  /// \brief Obtains the latency histograms of the dynamic batches. Only valid when dynamic batching is enabled by the
+  /// "dynamic_batching" section of the runner config.
+  ///
+  /// \return The latency histograms keyed by the batch size, empty if dynamic batching is disabled.
+  std::map<size_t, BatchLatencyHistogram> GetBatchLatencyHistograms();
+
  private:
   Status Init(const std::vector<char> &model_path, const std::shared_ptr<RunnerConfig> &runner_config);
   std::shared_ptr<ModelParallelRunnerImpl> model_parallel_runner_impl_ = nullptr;
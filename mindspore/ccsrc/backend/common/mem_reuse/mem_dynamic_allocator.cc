@@ -38,6 +38,10 @@ constexpr size_t kGBToByte = 1024 << 20;
 // The smallest memory request size, if it is smaller than this size, the device memory request may fail
 // Set experience value to 10M
 const size_t kMinimumAllocMem = 10 << 20;
+// The upper bound of the count of the mem bufs refilled into a thread cache at a time.
+constexpr size_t kThreadCacheRefillNum = 16;
+// The size of the mem bufs refilled at a time is bounded by this fraction of the thread cache size.
+constexpr size_t kThreadCacheRefillSizeDivisor = 8;
 
 thread_local AllocatorDebugInfo DynamicMemAllocatorDebugInfo::debug_info_;
 
@@ -61,10 +65,35 @@ static const std::map<AllocatorType, std::string> kAllocatorTypeString = {
   {AllocatorType::kOther, "other"},
 };
 
+namespace {
+// The thread caches of the current thread for every pool, which are orphaned when the thread exits.
+struct ThreadMemCacheHolder {
+  ~ThreadMemCacheHolder() {
+    for (auto &iter : caches) {
+      iter.second->Orphan();
+    }
+  }
+  std::vector<std::pair<uint64_t, ThreadMemCachePtr>> caches;
+};
+thread_local ThreadMemCacheHolder thread_mem_cache_holder;
+
+void UpdateAtomicMax(std::atomic<size_t> *value, size_t new_value) {
+  auto old_value = value->load();
+  while (old_value < new_value && !value->compare_exchange_weak(old_value, new_value)) {
+  }
+}
+}  // namespace
+
 DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
   persistent_mem_->Clear();
   common_mem_->Clear();
   stream_pair_addresses_.clear();
+  thread_caches_.clear();
+}
+
+uint64_t DynamicMemPoolBestFit::NextPoolId() {
+  static std::atomic<uint64_t> next_pool_id{0};
+  return next_pool_id++;
 }
 
 void DynamicMemBlock::update_border_addr(DeviceMemPtr left_addr, DeviceMemPtr right_addr) {
@@ -94,6 +123,21 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persis
     MS_LOG(DEBUG) << "Rewrite stream id from INT32 MAX to 0.";
     stream_id = kDefaultStreamIndex;
   }
+  if (enable_thread_cache_ && !from_persistent_mem && !need_recycle && stream_id == kDefaultStreamIndex &&
+      size <= kThreadCacheMaxBufSize && IsThreadCacheAvailable()) {
+    size_t align_size = AlignMemorySize(size);
+    if (align_size <= kThreadCacheMaxBufSize && align_size % kDynamicMemAlignSize == 0) {
+      auto device_addr = AllocTensorMemFromThreadCache(align_size);
+      if (device_addr != nullptr) {
+        return device_addr;
+      }
+    }
+  }
+  return AllocTensorMemFromPool(size, from_persistent_mem, need_recycle, stream_id);
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMemFromPool(size_t size, bool from_persistent_mem, bool need_recycle,
+                                                           uint32_t stream_id) {
   size_t align_size = AlignMemorySize(size);
 #ifdef __APPLE__
   std::lock_guard<SpinLock> spin_lock(spin_lock_);
@@ -113,8 +157,9 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persis
     device_addr = AddMemBlockAndMemBuf(align_size, from_persistent_mem, need_recycle, stream_id);
 
     if (device_addr == nullptr) {
-      MS_LOG(INFO) << "Alloc tensor mem failed and try to sync all events to release memory.";
+      MS_LOG(INFO) << "Alloc tensor mem failed and try to sync all events and drain thread caches to release memory.";
       SyncAllEventsInner();
+      DrainThreadCaches(false);
       device_addr = FindAvailableMemBuf(align_size, from_persistent_mem, stream_id);
     }
 
@@ -165,8 +210,8 @@ std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(const
                                                                           uint32_t stream_id) {
   std::vector<DeviceMemPtr> device_addr_list;
   size_t total_size = std::accumulate(size_list.begin(), size_list.end(), IntToSize(0));
-  // Pre-alloc the one whole piece memory.
-  auto device_addr = AllocTensorMem(total_size, false, false, stream_id);
+  // Pre-alloc the one whole piece memory, which is split below so it can't be served by the thread caches.
+  auto device_addr = AllocTensorMemFromPool(total_size, false, false, stream_id);
   if (!device_addr) {
     return device_addr_list;
   }
@@ -293,7 +338,7 @@ DeviceMemPtr DynamicMemPoolBestFit::FindMemBufInSpecifiedMng(size_t size, bool f
     mem_buf->status_ = DynamicMemBufStatus::kMemBufUsed;
     // Memory statistics
     mem_mng->mps_.total_used_mem_size_ += mem_buf->size_;
-    mem_mng->mps_.UpdatePeakSize();
+    UpdatePeakSize(mem_mng);
     if (target_status == DynamicMemBufStatus::kMemBufIdle) {
       mem_mng->mps_.total_idle_mem_size_ -= mem_buf->size_;
     } else if (target_status == DynamicMemBufStatus::kMemBufEagerFree) {
@@ -447,7 +492,7 @@ DeviceMemPtr DynamicMemPoolBestFit::CreateMemBlockAndMemBuf(size_t size, bool fr
   // Memory statistics
   mem_mng->mps_.total_mem_size_ += mem_block->size();
   mem_mng->mps_.total_used_mem_size_ += mem_buf->size_;
-  mem_mng->mps_.UpdatePeakSize();
+  UpdatePeakSize(mem_mng);
   if (mem_buf_status == DynamicMemBufStatus::kMemBufIdle) {
     mem_mng->mps_.total_idle_mem_size_ += source_size - mem_buf->size_;
   } else if (mem_buf_status == DynamicMemBufStatus::kMemBufEagerFree) {
@@ -490,6 +535,8 @@ size_t DynamicMemPoolBestFit::CalMemBlockAllocSize(size_t size, bool from_persis
 
 const size_t DynamicMemPoolBestFit::FreeIdleMemsByEagerFree() {
   eager_free_count_++;
+  // The mem bufs held by the thread caches are used in the view of the pool, return them to be freed too.
+  DrainThreadCaches(false);
 
   auto eager_free_mem_func = [&](MemStatusManagerPtr &mem_mng) {
     const auto &stream_ids = mem_mng->GetStreamIds();
@@ -615,6 +662,13 @@ DynamicMemBlockPtr DynamicMemPoolBestFit::FindMemBlock(const DeviceMemPtr &devic
 }
 
 void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
+  if (enable_thread_cache_) {
+    auto size = TakeThreadCacheBuf(device_addr);
+    if (size != 0) {
+      FreeTensorMemToThreadCache(device_addr, size);
+      return;
+    }
+  }
 #ifdef __APPLE__
   std::lock_guard<SpinLock> spin_lock(spin_lock_);
 #else
@@ -739,6 +793,9 @@ void DynamicMemPoolBestFit::CombineMemBuf(const DynamicMemBlockPtr &mem_block,
   } else {
     MS_LOG(INTERNAL_EXCEPTION) << "Unsupported target status : " << target_status << ".";
   }
+  if (mem_mng == common_mem_) {
+    PublishCommonUsedSize();
+  }
   // Combine backward(combine the next_mem_buf to mem_buf)
   auto next_iter = iter;
   (void)next_iter++;
@@ -810,6 +867,9 @@ void DynamicMemPoolBestFit::FreePartTensorMems(const std::vector<DeviceMemPtr> &
 #endif
 
   for (auto &free_addr : free_addrs) {
+    if (enable_thread_cache_) {
+      (void)TakeThreadCacheBuf(free_addr);
+    }
     FreeTensorMemInner(free_addr);
   }
 
@@ -869,7 +929,7 @@ void DynamicMemPoolBestFit::KeepTensorMemByAddr(const DeviceMemPtr &device_addr,
 
   // Memory statistics.
   mem_mng->mps_.total_used_mem_size_ += size;
-  mem_mng->mps_.UpdatePeakSize();
+  UpdatePeakSize(mem_mng);
   mem_mng->mps_.total_idle_mem_size_ -= size;
   MS_LOG(DEBUG) << "Keep memory details, name:" << DynamicMemAllocatorDebugInfo::GetDebugInfo().name_
                 << ", address:" << device_addr << ", size:" << size << "B, total allocated mem:" << TotalMemStatistics()
@@ -925,6 +985,11 @@ void DynamicMemPoolBestFit::ReleaseDeviceRes() {
 #else
   std::lock_guard<std::mutex> locker(mutex_);
 #endif
+  DrainThreadCaches(false);
+  for (auto &shard : thread_cache_buf_shards_) {
+    std::lock_guard<ThreadCacheLock> lock(shard.lock);
+    shard.bufs.clear();
+  }
   DumpDynamicMemPoolStateInfo();
 
   auto fn = [this](const MemStatusManagerPtr &mem_mng) {
@@ -943,6 +1008,7 @@ void DynamicMemPoolBestFit::ReleaseDeviceRes() {
   };
   fn(common_mem_);
   fn(persistent_mem_);
+  PublishCommonUsedSize();
 
   tracker::MemTrackerManager::GetInstance().Dump();
 }
@@ -1110,6 +1176,10 @@ bool DynamicMemPoolBestFit::RecordEvent(int64_t task_id_on_stream, uint32_t user
       MS_LOG(DEBUG) << "Can't find memblock by address in memory pool.";
       continue;
     }
+    // The mem buf with events is freed through the pool rather than the thread caches.
+    if (enable_thread_cache_) {
+      (void)TakeThreadCacheBuf(address);
+    }
     auto mem_buf = (std::get<1>(mem_buf_tuple))->second;
     (void)mem_buf->RecordEvent(task_id_on_stream, user_stream_id, event);
     (void)stream_pair_addresses_[std::make_pair(user_stream_id, memory_stream_id)].emplace(mem_buf);
@@ -1206,6 +1276,222 @@ bool DynamicMemPoolBestFit::SyncAllEventsInner() {
   return true;
 }
 
+void DynamicMemPoolBestFit::UpdatePeakSize(const MemStatusManagerPtr &mem_mng) {
+  if (mem_mng != common_mem_) {
+    mem_mng->mps_.UpdatePeakSize();
+    return;
+  }
+  PublishCommonUsedSize();
+  mem_mng->mps_.UpdatePeakSize(thread_cached_size_);
+}
+
+void DynamicMemPoolBestFit::PublishCommonUsedSize() {
+  common_used_size_ = common_mem_->mps_.total_used_mem_size_ + common_mem_->mps_.total_used_by_event_mem_size_;
+}
+
+bool DynamicMemPoolBestFit::IsThreadCacheAvailable() const {
+  // Every alloc has to go through the pool when it is recorded by the recycle, the profiler or the memory tracker.
+  if (IsMemoryPoolRecycle() || common::IsNeedProfileMemory() ||
+      device::tracker::MemTrackerManager::GetInstance().IsEnabled()) {
+    return false;
+  }
+#ifdef ENABLE_DEBUGGER
+  static auto profiler_inst = profiler::cpu::CPUProfiler::GetInstance();
+  MS_EXCEPTION_IF_NULL(profiler_inst);
+  if (profiler_inst->GetEnableFlag() && profiler_inst->GetProfileMemoryFlag()) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+ThreadMemCache *DynamicMemPoolBestFit::GetThreadCache() {
+  auto &caches = thread_mem_cache_holder.caches;
+  for (const auto &[pool_id, cache] : caches) {
+    if (pool_id == pool_id_) {
+      return cache.get();
+    }
+  }
+  auto cache = std::make_shared<ThreadMemCache>();
+  {
+#ifdef __APPLE__
+    std::lock_guard<SpinLock> spin_lock(spin_lock_);
+#else
+    std::lock_guard<std::mutex> locker(mutex_);
+#endif
+    // Take back the mem bufs left by the exited threads.
+    DrainThreadCaches(true);
+    (void)thread_caches_.emplace_back(cache);
+  }
+  (void)caches.emplace_back(pool_id_, cache);
+  MS_LOG(DEBUG) << "Create the thread cache of memory pool " << GetMemoryPoolType() << " for thread "
+                << std::this_thread::get_id() << ".";
+  return cache.get();
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMemFromThreadCache(size_t size) {
+  auto cache = GetThreadCache();
+  MS_EXCEPTION_IF_NULL(cache);
+  auto device_addr = cache->Pop(size);
+  if (device_addr == nullptr) {
+    return RefillThreadCache(cache, size);
+  }
+  thread_cached_size_ -= size;
+  UpdateThreadCachePeakSize();
+  AddThreadCacheBuf(device_addr, size);
+  MS_LOG(DEBUG) << "Alloc memory from thread cache, name:" << DynamicMemAllocatorDebugInfo::GetDebugInfo().name_
+                << ", address:" << device_addr << ", size:" << size << "B.";
+  return device_addr;
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::RefillThreadCache(ThreadMemCache *cache, size_t size) {
+  MS_EXCEPTION_IF_NULL(cache);
+  // The first mem buf is handed out and the others are refilled into the cache.
+  auto device_addr = AllocTensorMemFromPool(size, false, false, kDefaultStreamIndex);
+  if (device_addr == nullptr) {
+    return nullptr;
+  }
+  size_t refill_num = std::min(kThreadCacheRefillNum, kThreadCacheMaxSize / kThreadCacheRefillSizeDivisor / size);
+  std::vector<DeviceMemPtr> refill_addrs;
+  bool is_cacheable = false;
+  {
+#ifdef __APPLE__
+    std::lock_guard<SpinLock> spin_lock(spin_lock_);
+#else
+    std::lock_guard<std::mutex> locker(mutex_);
+#endif
+    // The mem buf at the end of a memory block may be a bit larger than the size, which is left to the pool.
+    auto is_exact_size = [this, size](const DeviceMemPtr &addr) {
+      auto [mem_block, iter, mem_mng] = FindByStrictAddr(addr);
+      return mem_block != nullptr && mem_mng == common_mem_ && iter->second->size_ == size;
+    };
+    is_cacheable = is_exact_size(device_addr);
+    for (size_t i = 1; is_cacheable && i < refill_num; ++i) {
+      // Counted as cached before it is counted as used, so the peak size doesn't include it.
+      thread_cached_size_ += size;
+      auto addr = FindAvailableMemBuf(size, false, kDefaultStreamIndex);
+      if (addr == nullptr) {
+        thread_cached_size_ -= size;
+        break;
+      }
+      if (!is_exact_size(addr)) {
+        FreeTensorMemInner(addr);
+        thread_cached_size_ -= size;
+        break;
+      }
+      (void)refill_addrs.emplace_back(addr);
+    }
+  }
+  if (is_cacheable) {
+    AddThreadCacheBuf(device_addr, size);
+  }
+  if (!refill_addrs.empty() && cache->Push(size, refill_addrs)) {
+    FlushThreadCache(cache);
+  }
+  MS_LOG(DEBUG) << "Refill " << refill_addrs.size() << " mem bufs of size " << size << " into the thread cache.";
+  return device_addr;
+}
+
+void DynamicMemPoolBestFit::FreeTensorMemToThreadCache(const DeviceMemPtr &device_addr, size_t size) {
+  auto cache = GetThreadCache();
+  MS_EXCEPTION_IF_NULL(cache);
+  thread_cached_size_ += size;
+  if (cache->Push(size, {device_addr})) {
+    FlushThreadCache(cache);
+  }
+  MS_LOG(DEBUG) << "Free memory to thread cache, name:" << DynamicMemAllocatorDebugInfo::GetDebugInfo().name_
+                << ", address:" << device_addr << ", size:" << size << "B.";
+}
+
+void DynamicMemPoolBestFit::FlushThreadCache(ThreadMemCache *cache) {
+  std::vector<std::pair<DeviceMemPtr, size_t>> bufs;
+  cache->Take(false, &bufs);
+  if (bufs.empty()) {
+    return;
+  }
+#ifdef __APPLE__
+  std::lock_guard<SpinLock> spin_lock(spin_lock_);
+#else
+  std::lock_guard<std::mutex> locker(mutex_);
+#endif
+  ReturnThreadCacheBufs(bufs);
+}
+
+void DynamicMemPoolBestFit::FlushThreadCaches() {
+#ifdef __APPLE__
+  std::lock_guard<SpinLock> spin_lock(spin_lock_);
+#else
+  std::lock_guard<std::mutex> locker(mutex_);
+#endif
+  DrainThreadCaches(false);
+}
+
+void DynamicMemPoolBestFit::ReturnThreadCacheBufs(const std::vector<std::pair<DeviceMemPtr, size_t>> &bufs) {
+  for (const auto &[device_addr, size] : bufs) {
+    // Counted as not cached after it is counted as not used, so the used size never goes beyond the real one.
+    FreeTensorMemInner(device_addr);
+    thread_cached_size_ -= size;
+  }
+  MS_LOG(DEBUG) << "Return " << bufs.size() << " mem bufs from the thread caches to the pool, thread cached mem:"
+                << thread_cached_size_ << "B.";
+}
+
+void DynamicMemPoolBestFit::DrainThreadCaches(bool orphaned_only) {
+  if (thread_caches_.empty()) {
+    return;
+  }
+  std::vector<std::pair<DeviceMemPtr, size_t>> bufs;
+  for (auto iter = thread_caches_.begin(); iter != thread_caches_.end();) {
+    const auto &cache = *iter;
+    MS_EXCEPTION_IF_NULL(cache);
+    bool orphaned = cache->orphaned();
+    if (orphaned_only && !orphaned) {
+      ++iter;
+      continue;
+    }
+    cache->Take(true, &bufs);
+    iter = orphaned ? thread_caches_.erase(iter) : iter + 1;
+  }
+  if (!bufs.empty()) {
+    ReturnThreadCacheBufs(bufs);
+  }
+}
+
+void DynamicMemPoolBestFit::AddThreadCacheBuf(const DeviceMemPtr &device_addr, size_t size) {
+  auto &shard = thread_cache_buf_shards_[(reinterpret_cast<uintptr_t>(device_addr) / kDynamicMemAlignSize) %
+                                         kThreadCacheBufShardNum];
+  std::lock_guard<ThreadCacheLock> lock(shard.lock);
+  shard.bufs[device_addr] = size;
+}
+
+size_t DynamicMemPoolBestFit::TakeThreadCacheBuf(const DeviceMemPtr &device_addr) {
+  auto &shard = thread_cache_buf_shards_[(reinterpret_cast<uintptr_t>(device_addr) / kDynamicMemAlignSize) %
+                                         kThreadCacheBufShardNum];
+  std::lock_guard<ThreadCacheLock> lock(shard.lock);
+  auto iter = shard.bufs.find(device_addr);
+  if (iter == shard.bufs.end()) {
+    return 0;
+  }
+  auto size = iter->second;
+  (void)shard.bufs.erase(iter);
+  return size;
+}
+
+void DynamicMemPoolBestFit::UpdateThreadCachePeakSize() {
+  // The used size of the pool is published under the lock and may be a bit behind, which only lowers the peak size.
+  size_t used_size = common_used_size_;
+  size_t cached_size = thread_cached_size_;
+  if (used_size <= cached_size) {
+    return;
+  }
+  used_size -= cached_size;
+  UpdateAtomicMax(&thread_cache_peak_size_, used_size);
+  size_t temp_used_size = common_temp_used_size_;
+  if (used_size > temp_used_size) {
+    UpdateAtomicMax(&thread_cache_temp_peak_size_, used_size - temp_used_size);
+  }
+}
+
 std::unordered_map<device::DeviceMemPtr, std::unordered_map<std::string, size_t>>
 DynamicMemPoolBestFit::ExtractBlocksListInfo(const MemStatusManagerPtr &mem_mng) const {
   std::unordered_map<device::DeviceMemPtr, std::unordered_map<std::string, size_t>> blocks_list_info;
@@ -1223,22 +1509,26 @@ size_t DynamicMemPoolBestFit::TotalMemStatistics() const {
   return common_mem_->mps_.total_mem_size_ + persistent_mem_->mps_.total_mem_size_;
 }
 size_t DynamicMemPoolBestFit::TotalUsedMemStatistics() const {
-  return common_mem_->mps_.total_used_mem_size_ + persistent_mem_->mps_.total_used_mem_size_;
+  size_t common_used_size = common_mem_->mps_.total_used_mem_size_;
+  common_used_size -= std::min(common_used_size, thread_cached_size_.load());
+  return common_used_size + persistent_mem_->mps_.total_used_mem_size_;
 }
 size_t DynamicMemPoolBestFit::TotalUsedByEventMemStatistics() const {
   return common_mem_->mps_.total_used_by_event_mem_size_ + persistent_mem_->mps_.total_used_by_event_mem_size_;
 }
 size_t DynamicMemPoolBestFit::TotalIdleMemStatistics() const {
-  return common_mem_->mps_.total_idle_mem_size_ + persistent_mem_->mps_.total_idle_mem_size_;
+  return common_mem_->mps_.total_idle_mem_size_ + persistent_mem_->mps_.total_idle_mem_size_ + thread_cached_size_;
 }
 size_t DynamicMemPoolBestFit::TotalEagerFreeMemStatistics() const {
   return common_mem_->mps_.total_eager_free_mem_size_ + persistent_mem_->mps_.total_eager_free_mem_size_;
 }
 size_t DynamicMemPoolBestFit::UsedMemPeakStatistics() const {
-  return common_mem_->mps_.used_mem_peak_size_ + persistent_mem_->mps_.used_mem_peak_size_;
+  return std::max(common_mem_->mps_.used_mem_peak_size_, thread_cache_peak_size_.load()) +
+         persistent_mem_->mps_.used_mem_peak_size_;
 }
 size_t DynamicMemPoolBestFit::MaxMemAllocatedStatistics() const {
-  return common_mem_->mps_.temp_used_mem_peak_size_ + persistent_mem_->mps_.temp_used_mem_peak_size_;
+  return std::max(common_mem_->mps_.temp_used_mem_peak_size_, thread_cache_temp_peak_size_.load()) +
+         persistent_mem_->mps_.temp_used_mem_peak_size_;
 }
 size_t DynamicMemPoolBestFit::MaxMemReservedStatistics() const {
   return common_mem_->mps_.total_mem_size_ + persistent_mem_->mps_.total_mem_size_ -
@@ -1276,12 +1566,18 @@ void DynamicMemPoolBestFit::ResetMaxMemReserved() const {
   persistent_mem_->mps_.temp_total_mem_size_ = persistent_mem_->mps_.total_mem_size_;
 }
 void DynamicMemPoolBestFit::ResetMaxMemAllocated() const {
-  common_mem_->mps_.temp_total_used_mem_size_ = common_mem_->mps_.total_used_mem_size_;
+  // The mem bufs held by the thread caches are not in use.
+  size_t common_used_size = common_mem_->mps_.total_used_mem_size_;
+  common_mem_->mps_.temp_total_used_mem_size_ =
+    common_used_size - std::min(common_used_size, thread_cached_size_.load());
   persistent_mem_->mps_.temp_total_used_mem_size_ = persistent_mem_->mps_.total_used_mem_size_;
   common_mem_->mps_.temp_total_used_by_event_mem_size_ = common_mem_->mps_.total_used_by_event_mem_size_;
   persistent_mem_->mps_.temp_total_used_by_event_mem_size_ = persistent_mem_->mps_.total_used_by_event_mem_size_;
   common_mem_->mps_.temp_used_mem_peak_size_ = 0;
   persistent_mem_->mps_.temp_used_mem_peak_size_ = 0;
+  common_temp_used_size_ =
+    common_mem_->mps_.temp_total_used_mem_size_ + common_mem_->mps_.temp_total_used_by_event_mem_size_;
+  thread_cache_temp_peak_size_ = 0;
 }
 
 size_t MemStatusManager::CalActualPeak() {
@@ -1296,6 +1592,59 @@ size_t MemStatusManager::CalActualPeak() {
   return actual_peak;
 }
 
+DeviceMemPtr ThreadMemCache::Pop(size_t size) {
+  std::lock_guard<ThreadCacheLock> lock(lock_);
+  auto &bin = bins_[size / kDynamicMemAlignSize - 1];
+  if (bin.empty()) {
+    return nullptr;
+  }
+  // The last freed mem buf is reused first, which is most likely still in the cpu cache.
+  auto device_addr = bin.back();
+  bin.pop_back();
+  cached_size_ -= size;
+  return device_addr;
+}
+
+bool ThreadMemCache::Push(size_t size, const std::vector<DeviceMemPtr> &addrs) {
+  std::lock_guard<ThreadCacheLock> lock(lock_);
+  auto &bin = bins_[size / kDynamicMemAlignSize - 1];
+  (void)bin.insert(bin.end(), addrs.begin(), addrs.end());
+  cached_size_ += size * addrs.size();
+  return bin.size() > kThreadCacheBinCapacity || cached_size_ > kThreadCacheMaxSize;
+}
+
+void ThreadMemCache::Take(bool all, std::vector<std::pair<DeviceMemPtr, size_t>> *bufs) {
+  MS_EXCEPTION_IF_NULL(bufs);
+  std::lock_guard<ThreadCacheLock> lock(lock_);
+  bool is_over_size = cached_size_ > kThreadCacheMaxSize;
+  for (size_t i = 0; i < bins_.size(); ++i) {
+    auto &bin = bins_[i];
+    size_t take_num = bin.size();
+    if (!all) {
+      if (!is_over_size && bin.size() <= kThreadCacheBinCapacity) {
+        continue;
+      }
+      take_num = (bin.size() + 1) / 2;
+    }
+    size_t size = (i + 1) * kDynamicMemAlignSize;
+    for (size_t j = 0; j < take_num; ++j) {
+      (void)bufs->emplace_back(bin[j], size);
+    }
+    (void)bin.erase(bin.begin(), bin.begin() + take_num);
+    cached_size_ -= size * take_num;
+  }
+}
+
+void ThreadMemCache::Orphan() {
+  std::lock_guard<ThreadCacheLock> lock(lock_);
+  orphaned_ = true;
+}
+
+bool ThreadMemCache::orphaned() {
+  std::lock_guard<ThreadCacheLock> lock(lock_);
+  return orphaned_;
+}
+
 bool DynamicMemBuf::RecordEvent(int64_t task_id_on_stream, uint32_t user_stream_id, const DeviceEventPtr &event) {
   MS_EXCEPTION_IF_NULL(event);
   if (events_ == nullptr) {
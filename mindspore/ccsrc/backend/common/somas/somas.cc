@@ -16,9 +16,13 @@
 
 #include "backend/common/somas/somas.h"
 #include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <functional>
 #include <iterator>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <set>
 #include <random>
@@ -78,6 +82,68 @@ constexpr auto kLifeEnd = "life_end";
 constexpr auto kOffset = "offset";
 constexpr auto kCachedResultThreshold = 2000;
 constexpr size_t kLogMergedBlockSize = 10;
+constexpr size_t kMaxIncrementalPlans = 4;
+constexpr double kIncrementalReuseRatio = 0.9;
+constexpr size_t kIncrementalSlackPercent = 5;
+constexpr size_t kPercent = 100;
+
+namespace {
+// The memory plan of a graph, which is kept for the incremental planning of the graphs compiled later.
+struct SomasPlan {
+  std::string device_name;
+  uint32_t graph_id{0};
+  size_t reused_memory_size{0};
+  // key: tensor signature, value: offset and aligned size
+  HashMap<size_t, std::pair<size_t, size_t>> tensors;
+};
+using SomasPlanPtr = std::shared_ptr<SomasPlan>;
+
+class SomasPlanCache {
+ public:
+  static SomasPlanCache &Instance() {
+    static SomasPlanCache instance;
+    return instance;
+  }
+
+  // Get the plan of the graph, or the latest plan of the device if the graph has not been planned, which is the case
+  // when a changed graph is recompiled with a new graph id.
+  SomasPlanPtr Get(const std::string &device_name, uint32_t graph_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SomasPlanPtr latest_plan = nullptr;
+    for (const auto &plan : plans_) {
+      if (plan->device_name != device_name) {
+        continue;
+      }
+      if (plan->graph_id == graph_id) {
+        return plan;
+      }
+      if (latest_plan == nullptr) {
+        latest_plan = plan;
+      }
+    }
+    return latest_plan;
+  }
+
+  void Put(const SomasPlanPtr &new_plan) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    plans_.remove_if([&new_plan](const SomasPlanPtr &plan) {
+      return plan->device_name == new_plan->device_name && plan->graph_id == new_plan->graph_id;
+    });
+    plans_.push_front(new_plan);
+    if (plans_.size() > kMaxIncrementalPlans) {
+      plans_.pop_back();
+    }
+  }
+
+ private:
+  SomasPlanCache() = default;
+  ~SomasPlanCache() = default;
+
+  mutable std::mutex mutex_;
+  // The latest plan is at the front.
+  std::list<SomasPlanPtr> plans_;
+};
+}  // namespace
 
 // set somas result
 void SetSomasResult(std::vector<std::pair<size_t, size_t>> &&output_somas_result,
@@ -152,6 +218,7 @@ bool Somas::Assign(const session::KernelGraph &graph) {
   if (!IsSupportSomas(graph)) {
     return false;
   }
+  auto start_time = std::chrono::system_clock::now();
   auto ret = ConfigSomas(graph);
   if (!ret) {
     MS_LOG(INTERNAL_EXCEPTION) << "Config Somas Failed.";
@@ -182,6 +249,9 @@ bool Somas::Assign(const session::KernelGraph &graph) {
       GenGraphStatisticInfo();
       UpdateSomasResultToGraph(graph);
       DumpSomasModelInfo("somas_tensor_offset", graph.graph_id());
+      auto total_time =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start_time).count();
+      PlanningSummaryLog(graph, total_time, 0, 0);
       MS_LOG(INFO) << "Somas Allocate end.";
       return true;
     }
@@ -189,17 +259,27 @@ bool Somas::Assign(const session::KernelGraph &graph) {
 
   // Computing Conflict pairs
   MS_LOG(INFO) << "Start Computing Conflict Matrix";
+  auto conflict_start = std::chrono::system_clock::now();
   ComputeConflictMatrix();
+  auto solve_start = std::chrono::system_clock::now();
   MS_LOG(INFO) << "End Computing Conflict Matrix";
 
   Solve(graph);
+  auto solve_end = std::chrono::system_clock::now();
 
   if (enable_cache_) {
     SaveSomasResult(graph);
   }
+  if (enable_incremental_) {
+    SaveIncrementalPlan(graph);
+  }
 
   UpdateSomasResultToGraph(graph);
   DumpSomasModelInfo("somas_tensor_offset", graph.graph_id());
+  auto end_time = std::chrono::system_clock::now();
+  PlanningSummaryLog(graph, std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count(),
+                     std::chrono::duration_cast<std::chrono::milliseconds>(solve_start - conflict_start).count(),
+                     std::chrono::duration_cast<std::chrono::milliseconds>(solve_end - solve_start).count());
 
   MS_LOG(INFO) << "Somas Allocate end.";
   return true;
@@ -264,6 +344,7 @@ bool Somas::ConfigSomas(const session::KernelGraph &graph) {
   device_name_ = GetDeviceName();
   communication_gap_size_ = GetCommunicationReservedSize();
   enable_cache_ = GetEnableCacheFlag(graph);
+  enable_incremental_ = common::IsEnableRuntimeConfig(common::kRuntimeSomasIncremental);
   depend_exec_order_ = GetDependExecOrderFlag(graph);
   auto debug_config = GetDebugConfig();
   save_debug_info_ = debug_config.first;
@@ -1316,6 +1397,29 @@ std::vector<int> GetCoreList() {
   static std::vector<int> core_list = InnerGetCoreList();
   return core_list;
 }
+
+size_t GetJobNum(size_t size, bool parallel) {
+  return !parallel || size < static_cast<size_t>(kParallelComputeSizeThreshold) ? 1 : static_cast<size_t>(kProcessNum);
+}
+
+// Split [0, total) into job_num ranges and run func on them in the thread pool, or in the current thread for one job.
+void ParallelRun(size_t total, size_t job_num, const std::function<void(size_t, size_t)> &func) {
+  if (job_num <= 1 || total <= 1) {
+    func(0, total);
+    return;
+  }
+  size_t job_size = (total + job_num - 1) / job_num;
+  std::vector<common::Task> tasks;
+  for (size_t start = 0; start < total; start += job_size) {
+    size_t end = std::min(start + job_size, total);
+    (void)tasks.emplace_back([&func, start, end]() {
+      func(start, end);
+      return common::SUCCESS;
+    });
+  }
+  auto core_list = GetCoreList();
+  (void)common::ThreadPool::GetInstance().SyncRun(tasks, core_list);
+}
 }  // namespace
 
 void Somas::ComputeBasicMatrix() {
@@ -1330,49 +1434,75 @@ void Somas::ComputeBasicMatrix() {
   std::vector<DynamicBitSet> nodes_dependency(count, DynamicBitSet(count));
 
   MS_LOG(INFO) << "Start Path Computing";
-  // Loop to compute ancestor paths via bitset for time dependence
   for (const auto &node : nodes_list_) {
     MS_EXCEPTION_IF_NULL(node);
     for (const auto &ancestor : node->ancestor_nodes_) {
       MS_EXCEPTION_IF_NULL(ancestor);
-      nodes_dependency[node->GetId()].SetBitTrue(ancestor->GetId());
-      Union(&nodes_dependency[node->GetId()], &nodes_dependency[ancestor->GetId()]);
       ancestor->user_nodes_.push_back(node);
     }
   }
+  // Loop to compute ancestor paths via bitset for time dependence, the nodes are split into ranges of bitset words and
+  // every job walks through the whole graph to compute the bits of its own range.
+  size_t word_count = nodes_dependency[0].bit_size_;
+  size_t job_num = GetJobNum(count, parallel_compute_);
+  ParallelRun(word_count, job_num, [this, &nodes_dependency](size_t begin, size_t end) {
+    for (const auto &node : nodes_list_) {
+      auto &dependency = nodes_dependency[node->GetId()];
+      for (const auto &ancestor : node->ancestor_nodes_) {
+        auto ancestor_id = ancestor->GetId();
+        auto word_index = ancestor_id / DynamicBitSet::bit_width_;
+        if (word_index >= begin && word_index < end) {
+          dependency.SetBitTrue(ancestor_id);
+        }
+        UnionRange(&dependency, &nodes_dependency[ancestor_id], begin, end);
+      }
+    }
+  });
   MS_LOG(INFO) << "End Path Computing";
 
   MS_LOG(INFO) << "Start Reverse Dependency Computing";
   std::vector<DynamicBitSet> nodes_reverse_dependency(count, DynamicBitSet(count));
-  for (auto nir = nodes_list_.rbegin(); nir != nodes_list_.rend(); nir++) {
-    auto node = *nir;
-    MS_EXCEPTION_IF_NULL(node);
-    for (const auto &user : node->user_nodes_) {
-      auto user_node = user.lock();
-      MS_EXCEPTION_IF_NULL(user_node);
-      if (nodes_dependency[user_node->GetId()].IsBitTrue(node->GetId())) {
-        nodes_reverse_dependency[node->GetId()].SetBitTrue(user_node->GetId());
-        Union(&nodes_reverse_dependency[node->GetId()], &nodes_reverse_dependency[user_node->GetId()]);
-      }
-    }
-  }
+  ParallelRun(word_count, job_num,
+              [this, &nodes_dependency, &nodes_reverse_dependency](size_t begin, size_t end) {
+                for (auto nir = nodes_list_.rbegin(); nir != nodes_list_.rend(); nir++) {
+                  auto node_id = (*nir)->GetId();
+                  auto &reverse_dependency = nodes_reverse_dependency[node_id];
+                  for (const auto &user : (*nir)->user_nodes_) {
+                    auto user_node = user.lock();
+                    MS_EXCEPTION_IF_NULL(user_node);
+                    auto user_id = user_node->GetId();
+                    if (!nodes_dependency[user_id].IsBitTrue(node_id)) {
+                      continue;
+                    }
+                    auto word_index = user_id / DynamicBitSet::bit_width_;
+                    if (word_index >= begin && word_index < end) {
+                      reverse_dependency.SetBitTrue(user_id);
+                    }
+                    UnionRange(&reverse_dependency, &nodes_reverse_dependency[user_id], begin, end);
+                  }
+                }
+              });
   MS_LOG(INFO) << "End Reverse Dependency Computing";
 
   MS_LOG(INFO) << "Start Tensor To Node Dependency Computing";
   MS_EXCEPTION_IF_NULL(tensors_list_.back());
   auto tensor_count = tensors_list_.back()->GetId() + 1;
   std::vector<DynamicBitSet> tensor_to_node_dependency(tensor_count, DynamicBitSet(count));
-  for (const auto &tensor : tensors_list_) {
-    MS_EXCEPTION_IF_NULL(tensor);
-    auto id = tensor->GetId();
-    if (tensor->consumer_list_.empty()) {
-      continue;
-    }
-    tensor_to_node_dependency[id] = nodes_reverse_dependency[tensor->consumer_list_[0]];
-    for (size_t i = 1; i < tensor->consumer_list_.size(); i++) {
-      And(&tensor_to_node_dependency[id], &nodes_reverse_dependency[tensor->consumer_list_[i]]);
-    }
-  }
+  ParallelRun(tensors_list_.size(), GetJobNum(tensors_list_.size(), parallel_compute_),
+              [this, &nodes_reverse_dependency, &tensor_to_node_dependency](size_t begin, size_t end) {
+                for (size_t index = begin; index < end; ++index) {
+                  const auto &tensor = tensors_list_[index];
+                  MS_EXCEPTION_IF_NULL(tensor);
+                  auto id = tensor->GetId();
+                  if (tensor->consumer_list_.empty()) {
+                    continue;
+                  }
+                  tensor_to_node_dependency[id] = nodes_reverse_dependency[tensor->consumer_list_[0]];
+                  for (size_t i = 1; i < tensor->consumer_list_.size(); i++) {
+                    And(&tensor_to_node_dependency[id], &nodes_reverse_dependency[tensor->consumer_list_[i]]);
+                  }
+                }
+              });
   MS_LOG(INFO) << "End Tensor To Node Dependency Computing";
 
   MS_LOG(INFO) << "Start Tensor Relation Computing";
@@ -1425,29 +1555,46 @@ void Somas::ComputeBasicMatrix() {
 }
 
 void Somas::ProcessSemiLifeLongTensor() {
-  for (const auto &calc_tensor : tensors_list_) {
-    MS_EXCEPTION_IF_NULL(calc_tensor);
-    // if the tensor is semi-life long start, it can't reuse with tensor with smaller id.
-    // if the tensor is semi-life long end, it can't reuse with tensor with larger id.
-    if (!calc_tensor->IsSemiLifelongStart() && !calc_tensor->IsSemiLifelongEnd()) {
-      continue;
-    }
-    for (const auto &target_tensor : tensors_list_) {
-      if (calc_tensor == target_tensor) {
-        continue;
-      }
-      if (depend_exec_order_) {
-        if ((calc_tensor->IsSemiLifelongStart() && target_tensor->GetId() < calc_tensor->GetId()) ||
-            (calc_tensor->IsSemiLifelongEnd() && target_tensor->GetId() > calc_tensor->GetId())) {
-          reuse_matrix_[calc_tensor->GetId()].SetBitFalse(target_tensor->GetId());
-          reuse_matrix_[target_tensor->GetId()].SetBitFalse(calc_tensor->GetId());
-        }
-      } else {
-        reuse_matrix_[calc_tensor->GetId()].SetBitFalse(target_tensor->GetId());
-        reuse_matrix_[target_tensor->GetId()].SetBitFalse(calc_tensor->GetId());
-      }
+  std::vector<SomasTensorPtr> semi_lifelong_tensors;
+  for (const auto &tensor : tensors_list_) {
+    MS_EXCEPTION_IF_NULL(tensor);
+    if (tensor->IsSemiLifelongStart() || tensor->IsSemiLifelongEnd()) {
+      semi_lifelong_tensors.push_back(tensor);
     }
   }
+  if (semi_lifelong_tensors.empty()) {
+    return;
+  }
+  // if the tensor is semi-life long start, it can't reuse with tensor with smaller id.
+  // if the tensor is semi-life long end, it can't reuse with tensor with larger id.
+  auto is_conflict = [this](const SomasTensorPtr &semi_tensor, const SomasTensorPtr &target_tensor) {
+    if (!depend_exec_order_) {
+      return true;
+    }
+    return (semi_tensor->IsSemiLifelongStart() && target_tensor->GetId() < semi_tensor->GetId()) ||
+           (semi_tensor->IsSemiLifelongEnd() && target_tensor->GetId() > semi_tensor->GetId());
+  };
+  // Every job only updates the rows of its own tensors, so a conflict is set from both tensors of the pair.
+  ParallelRun(tensors_list_.size(), GetJobNum(tensors_list_.size(), parallel_compute_),
+              [this, &semi_lifelong_tensors, &is_conflict](size_t begin, size_t end) {
+                for (size_t index = begin; index < end; ++index) {
+                  const auto &calc_tensor = tensors_list_[index];
+                  bool is_semi_lifelong = calc_tensor->IsSemiLifelongStart() || calc_tensor->IsSemiLifelongEnd();
+                  auto &reuse_row = reuse_matrix_[calc_tensor->GetId()];
+                  const auto &target_tensors = is_semi_lifelong ? tensors_list_ : semi_lifelong_tensors;
+                  for (const auto &target_tensor : target_tensors) {
+                    if (calc_tensor == target_tensor) {
+                      continue;
+                    }
+                    bool is_target_semi_lifelong =
+                      target_tensor->IsSemiLifelongStart() || target_tensor->IsSemiLifelongEnd();
+                    if ((is_semi_lifelong && is_conflict(calc_tensor, target_tensor)) ||
+                        (is_target_semi_lifelong && is_conflict(target_tensor, calc_tensor))) {
+                      reuse_row.SetBitFalse(target_tensor->GetId());
+                    }
+                  }
+                }
+              });
 }
 
 void Somas::ComputeConflictMatrix() {
@@ -1559,16 +1706,19 @@ void Somas::Solve(const session::KernelGraph &graph) {
     return;
   }
 
-  somas_solver_ = std::make_shared<SomasSolverPre>();
-  MS_EXCEPTION_IF_NULL(somas_solver_);
-  auto core_list = GetCoreList();
-  auto status = somas_solver_->Solving(graph, &solver_tensor_desc_map_, &reuse_matrix_,
-                                       processed_contiguous_tensors_list_, core_list, false);
-  MS_LOG(INFO) << "End Solving";
-
-  if (status != SUCCESS) {
-    MS_LOG(INTERNAL_EXCEPTION) << "SOMAS Solving Failed.";
+  plan_reused_ = enable_incremental_ && IncrementalSolve(graph);
+  if (!plan_reused_) {
+    somas_solver_ = std::make_shared<SomasSolverPre>();
+    MS_EXCEPTION_IF_NULL(somas_solver_);
+    auto core_list = GetCoreList();
+    auto status = somas_solver_->Solving(graph, &solver_tensor_desc_map_, &reuse_matrix_,
+                                         processed_contiguous_tensors_list_, core_list, false);
+    if (status != SUCCESS) {
+      MS_LOG(INTERNAL_EXCEPTION) << "SOMAS Solving Failed.";
+    }
+    reused_memory_size_ = static_cast<size_t>(somas_solver_->GetMaxOffset());
   }
+  MS_LOG(INFO) << "End Solving";
 
   // Update solver_tensor_desc offset to tensors list
   for (const auto &tensor : tensors_list_) {
@@ -1579,11 +1729,241 @@ void Somas::Solve(const session::KernelGraph &graph) {
   UpdateUnionTensorsOffset();
   UpdateContiguousTensorsOffset(contiguous_list_with_ref_index_map_);
 
-  reused_memory_size_ = static_cast<size_t>(somas_solver_->GetMaxOffset());
-
   MS_LOG(INFO) << "Somas Assign end.";
 }
 
+std::vector<size_t> Somas::GetTensorSignatures() const {
+  // The signature of a tensor is the hash of the name of its node and its index, which is kept across the recompiles.
+  // Tensors with the same signature in a graph are ambiguous and get no signature.
+  std::vector<size_t> signatures(tensors_list_.size(), 0);
+  HashMap<size_t, size_t> signature_count;
+  std::hash<std::string> hasher;
+  auto set_signatures = [&signatures, &signature_count, &hasher](const std::string &prefix,
+                                                                 const std::vector<SomasTensorPtr> &tensors) {
+    for (size_t i = 0; i < tensors.size(); ++i) {
+      MS_EXCEPTION_IF_NULL(tensors[i]);
+      if (tensors[i]->GetId() >= signatures.size()) {
+        continue;
+      }
+      auto signature = hasher(prefix + std::to_string(i));
+      signatures[tensors[i]->GetId()] = signature;
+      ++signature_count[signature];
+    }
+  };
+  for (const auto &node : nodes_list_) {
+    MS_EXCEPTION_IF_NULL(node);
+    set_signatures(node->scope_full_name_ + ":output:", node->output_tensors_);
+    set_signatures(node->scope_full_name_ + ":workspace:", node->workspace_tensors_);
+  }
+  for (auto &signature : signatures) {
+    if (signature_count[signature] > 1) {
+      signature = 0;
+    }
+  }
+  return signatures;
+}
+
+bool Somas::IncrementalSolve(const session::KernelGraph &graph) {
+  auto plan = SomasPlanCache::Instance().Get(device_name_, graph.graph_id());
+  if (plan == nullptr) {
+    MS_LOG(INFO) << "No previous SOMAS plan to reuse for graph " << graph.graph_id();
+    return false;
+  }
+  auto tensor_count = reuse_matrix_.size();
+  std::vector<size_t> sizes(tensor_count, 0);
+  std::vector<char> lifelong(tensor_count, false);
+  for (const auto &[id, desc] : solver_tensor_desc_map_) {
+    MS_EXCEPTION_IF_NULL(desc);
+    if (id >= tensor_count) {
+      return false;
+    }
+    sizes[id] = desc->size_;
+    lifelong[id] = desc->lifelong_;
+  }
+  auto is_conflict = [this, &lifelong](size_t id1, size_t id2) {
+    return lifelong[id1] || lifelong[id2] || !reuse_matrix_[id1].IsBitTrue(id2) || !reuse_matrix_[id2].IsBitTrue(id1);
+  };
+
+  // A unit is placed as a whole, which is a contiguous list or a single tensor.
+  struct PlanUnit {
+    std::vector<size_t> tensor_ids;
+    size_t size{0};
+    size_t offset{0};
+    bool reused{false};
+  };
+  std::vector<PlanUnit> units;
+  std::vector<char> in_contiguous_list(tensor_count, false);
+  for (const auto &contiguous_list : processed_contiguous_tensors_list_) {
+    PlanUnit unit;
+    for (auto id : contiguous_list) {
+      if (id >= tensor_count || solver_tensor_desc_map_.count(id) == 0) {
+        return false;
+      }
+      in_contiguous_list[id] = true;
+      unit.size += sizes[id];
+    }
+    unit.tensor_ids = contiguous_list;
+    units.push_back(std::move(unit));
+  }
+  for (const auto &tensor : tensors_list_) {
+    MS_EXCEPTION_IF_NULL(tensor);
+    auto id = tensor->GetId();
+    if (id < tensor_count && !in_contiguous_list[id] && solver_tensor_desc_map_.count(id) != 0) {
+      units.push_back({{id}, sizes[id], 0, false});
+    }
+  }
+
+  // Take the offsets of the previous plan for the units whose tensors are all found in it with the same layout.
+  auto signatures = GetTensorSignatures();
+  std::vector<size_t> reused_units;
+  for (size_t i = 0; i < units.size(); ++i) {
+    auto &unit = units[i];
+    size_t next_offset = 0;
+    unit.reused = true;
+    for (size_t j = 0; j < unit.tensor_ids.size(); ++j) {
+      auto id = unit.tensor_ids[j];
+      auto iter = plan->tensors.end();
+      if (id < signatures.size() && signatures[id] != 0) {
+        iter = plan->tensors.find(signatures[id]);
+      }
+      if (iter == plan->tensors.end() || iter->second.second != sizes[id] ||
+          (j != 0 && iter->second.first != next_offset)) {
+        unit.reused = false;
+        break;
+      }
+      if (j == 0) {
+        unit.offset = iter->second.first;
+      }
+      next_offset = iter->second.first + sizes[id];
+    }
+    if (unit.reused) {
+      reused_units.push_back(i);
+    }
+  }
+
+  // The lifetimes may have changed, so keep a previous offset only if the unit conflicts with none of the units
+  // kept before it at the overlapped addresses.
+  struct PlacedTensor {
+    size_t id;
+    size_t begin;
+    size_t end;
+  };
+  std::vector<PlacedTensor> placed_tensors;
+  std::vector<PlacedTensor> active_tensors;
+  std::sort(reused_units.begin(), reused_units.end(),
+            [&units](size_t i, size_t j) { return units[i].offset < units[j].offset; });
+  size_t reused_size = 0;
+  for (auto i : reused_units) {
+    auto &unit = units[i];
+    auto is_inactive = [&unit](const PlacedTensor &tensor) { return tensor.end <= unit.offset; };
+    (void)active_tensors.erase(std::remove_if(active_tensors.begin(), active_tensors.end(), is_inactive),
+                               active_tensors.end());
+    std::vector<PlacedTensor> unit_tensors;
+    size_t offset = unit.offset;
+    for (auto id : unit.tensor_ids) {
+      unit_tensors.push_back({id, offset, offset + sizes[id]});
+      offset += sizes[id];
+    }
+    unit.reused = std::none_of(unit_tensors.begin(), unit_tensors.end(), [&](const PlacedTensor &tensor) {
+      return std::any_of(active_tensors.begin(), active_tensors.end(), [&](const PlacedTensor &active) {
+        return active.begin < tensor.end && tensor.begin < active.end && is_conflict(tensor.id, active.id);
+      });
+    });
+    if (unit.reused) {
+      active_tensors.insert(active_tensors.end(), unit_tensors.begin(), unit_tensors.end());
+      placed_tensors.insert(placed_tensors.end(), unit_tensors.begin(), unit_tensors.end());
+      reused_size += unit.size;
+    }
+  }
+  size_t total_size = std::accumulate(units.begin(), units.end(), size_t(0),
+                                      [](size_t sum, const PlanUnit &unit) { return sum + unit.size; });
+  if (static_cast<double>(reused_size) < static_cast<double>(total_size) * kIncrementalReuseRatio) {
+    MS_LOG(INFO) << "Only " << reused_size << " of " << total_size << " bytes of graph " << graph.graph_id()
+                 << " can reuse the previous plan of graph " << plan->graph_id << ", solve it from scratch.";
+    return false;
+  }
+
+  // Place the rest units from the larger ones at the lowest offset where they conflict with no placed tensor.
+  std::vector<size_t> rest_units;
+  for (size_t i = 0; i < units.size(); ++i) {
+    if (!units[i].reused) {
+      rest_units.push_back(i);
+    }
+  }
+  std::sort(rest_units.begin(), rest_units.end(), [&units](size_t i, size_t j) {
+    return units[i].size > units[j].size ||
+           (units[i].size == units[j].size && units[i].tensor_ids[0] < units[j].tensor_ids[0]);
+  });
+  for (auto i : rest_units) {
+    auto &unit = units[i];
+    // The ranges [begin, end) of the unit offset which make the unit overlap a conflicting tensor.
+    std::vector<std::pair<size_t, size_t>> forbidden_ranges;
+    size_t relative_offset = 0;
+    for (auto id : unit.tensor_ids) {
+      for (const auto &placed : placed_tensors) {
+        if (placed.end <= relative_offset || !is_conflict(id, placed.id)) {
+          continue;
+        }
+        auto tensor_end = relative_offset + sizes[id];
+        auto begin = placed.begin + 1 > tensor_end ? placed.begin + 1 - tensor_end : 0;
+        forbidden_ranges.emplace_back(begin, placed.end - relative_offset);
+      }
+      relative_offset += sizes[id];
+    }
+    std::sort(forbidden_ranges.begin(), forbidden_ranges.end());
+    size_t offset = 0;
+    for (const auto &range : forbidden_ranges) {
+      if (range.first > offset) {
+        break;
+      }
+      offset = std::max(offset, range.second);
+    }
+    unit.offset = offset;
+    for (auto id : unit.tensor_ids) {
+      placed_tensors.push_back({id, offset, offset + sizes[id]});
+      offset += sizes[id];
+    }
+  }
+
+  size_t footprint = 0;
+  for (const auto &unit : units) {
+    footprint = std::max(footprint, unit.offset + unit.size);
+  }
+  if (footprint * kPercent > std::max(plan->reused_memory_size, lower_bound_) * (kPercent + kIncrementalSlackPercent)) {
+    MS_LOG(INFO) << "The incremental plan of graph " << graph.graph_id() << " takes " << footprint
+                 << " bytes, which is much more than the previous " << plan->reused_memory_size
+                 << " bytes, solve it from scratch.";
+    return false;
+  }
+  for (const auto &tensor : placed_tensors) {
+    solver_tensor_desc_map_[tensor.id]->offset_ = tensor.begin;
+  }
+  reused_memory_size_ = footprint;
+  MS_LOG(INFO) << "Graph " << graph.graph_id() << " reuses the plan of graph " << plan->graph_id << " for "
+               << reused_size << " of " << total_size << " bytes, " << rest_units.size() << " of " << units.size()
+               << " tensor blocks are placed again, total " << footprint << " bytes.";
+  return true;
+}
+
+void Somas::SaveIncrementalPlan(const session::KernelGraph &graph) const {
+  if (solver_tensor_desc_map_.empty()) {
+    return;
+  }
+  auto plan = std::make_shared<SomasPlan>();
+  plan->device_name = device_name_;
+  plan->graph_id = graph.graph_id();
+  plan->reused_memory_size = reused_memory_size_;
+  auto signatures = GetTensorSignatures();
+  plan->tensors.reserve(solver_tensor_desc_map_.size());
+  for (const auto &[id, desc] : solver_tensor_desc_map_) {
+    MS_EXCEPTION_IF_NULL(desc);
+    if (id < signatures.size() && signatures[id] != 0) {
+      plan->tensors[signatures[id]] = std::make_pair(desc->offset_, desc->size_);
+    }
+  }
+  SomasPlanCache::Instance().Put(plan);
+}
+
 std::map<size_t, std::map<size_t, std::set<size_t>>> Somas::GetContiguousRefListErrorCheckMap() {
   std::map<size_t, std::map<size_t, std::set<size_t>>> contiguous_ref_list_error_check_map;
   std::map<size_t, size_t> ref_tensors_in_contiguous_map = GetRefTensorsInContiguousList();
@@ -2196,6 +2576,16 @@ void Somas::GenGraphStatisticInfo() {
                << " GB), Upper Bound: " << upper_bound_ << " (" << static_cast<double>(upper_bound_) / giga << " GB)";
 }
 
+void Somas::PlanningSummaryLog(const session::KernelGraph &graph, int64_t total_time, int64_t conflict_time,
+                               int64_t solve_time) const {
+  const double giga = 1024. * 1024. * 1024.;
+  MS_LOG(INFO) << "SOMAS planning of graph " << graph.graph_id() << " with " << nodes_list_.size() << " nodes and "
+               << tensors_list_.size() << " tensors takes " << total_time << " ms (conflict matrix: " << conflict_time
+               << " ms, solving: " << solve_time << " ms" << (plan_reused_ ? ", previous plan reused" : "")
+               << "), peak memory: " << reused_memory_size_ << " (" << static_cast<double>(reused_memory_size_) / giga
+               << " GB), lower bound: " << lower_bound_ << " (" << static_cast<double>(lower_bound_) / giga << " GB)";
+}
+
 std::vector<std::pair<size_t, size_t>> Somas::GetNodeOutputSomasResult(const AnfNodePtr &node) const {
   MS_EXCEPTION_IF_NULL(node);
   auto key = node.get();
@@ -105,6 +105,9 @@ class BACKEND_EXPORT Somas {
 
   bool depend_exec_order_{false};
   bool enable_cache_{false};
+  bool enable_incremental_{false};
+  // Whether the conflict matrix of a large graph is computed by several jobs, the result is the same either way.
+  bool parallel_compute_{true};
   bool save_debug_info_{false};
   std::string debug_info_path_;
 
@@ -134,6 +137,7 @@ class BACKEND_EXPORT Somas {
   size_t lifelong_all_total_size_{0};
   size_t lifelong_start_total_size_{0};
   size_t lifelong_end_total_size_{0};
+  bool plan_reused_{false};
 
   std::vector<vector<size_t>> processed_contiguous_tensors_list_;
   // key: contiguous list index with first union tensor; value: contiguous list index with other union tensor
@@ -192,12 +196,19 @@ class BACKEND_EXPORT Somas {
   bool CalcSomasModelHash(const session::KernelGraph &graph);
   bool LoadSomasCache(const session::KernelGraph &graph);
 
+  // incremental planning
+  std::vector<size_t> GetTensorSignatures() const;
+  bool IncrementalSolve(const session::KernelGraph &graph);
+  void SaveIncrementalPlan(const session::KernelGraph &graph) const;
+
   // log
   std::string Offline() const;
   void DumpOfflineIR(const string &filename) const;
   size_t CalcLowerBound() const;
   void UpdateTensorPeak(const std::vector<SomasTensorPtr> &peak_tensors) const;
   void GenGraphStatisticInfo();
+  void PlanningSummaryLog(const session::KernelGraph &graph, int64_t total_time, int64_t conflict_time,
+                          int64_t solve_time) const;
   void DumpParameters(std::ostringstream &oss) const;
   void DumpTensors(std::ostringstream &oss) const;
   void DumpNodes(std::ostringstream &oss) const;
@@ -89,16 +89,25 @@ Status SomasSolverPre::AddContiguousInfoInMultiMaps(const vector<vector<size_t>>
   }
   return SUCCESS;
 }
-vector<TensorsDescMap> SomasSolverPre::CreateTensorsMaps(const TensorsDescMap &tensors, size_t total_sol) const {
+vector<TensorsDescMap> SomasSolverPre::CreateTensorsMaps(const TensorsDescMap &tensors, size_t total_sol,
+                                                         const std::vector<int> &core_list) const {
   vector<TensorsDescMap> vecTensorsMap(total_sol);
   vecTensorsMap[0] = tensors;
-  for (auto &pairT : tensors) {
-    for (size_t sol = 1; sol < total_sol; sol++) {
-      SomasSolverTensorDesc newDesc = *(pairT.second.get());
-      SomasSolverTensorDescPtr newDescPtr = std::make_shared<SomasSolverTensorDesc>(newDesc);
-      (void)vecTensorsMap[sol].emplace(pairT.first, newDescPtr);
-    }
+  // Every solution gets its own copy of the tensors, which is filled in a task of its own
+  std::vector<common::Task> tasks;
+  for (size_t sol = 1; sol < total_sol; sol++) {
+    (void)tasks.emplace_back([&tensors, &vecTensorsMap, sol]() {
+      auto &tensors_sol = vecTensorsMap[sol];
+      tensors_sol.reserve(tensors.size());
+      for (auto &pairT : tensors) {
+        SomasSolverTensorDesc newDesc = *(pairT.second.get());
+        SomasSolverTensorDescPtr newDescPtr = std::make_shared<SomasSolverTensorDesc>(newDesc);
+        (void)tensors_sol.emplace(pairT.first, newDescPtr);
+      }
+      return common::SUCCESS;
+    });
   }
+  (void)common::ThreadPool::GetInstance().SyncRun(tasks, core_list);
   return vecTensorsMap;
 }
 void FindBest(size_t total_sol, const vector<std::shared_ptr<SomasSolverCore>> &solvers, BestInfo *best_info) {
@@ -138,7 +147,7 @@ Status SomasSolverPre::Solving(const session::KernelGraph &graph, TensorsDescMap
 
     vector<std::shared_ptr<SomasSolverCore>> solvers;
     std::vector<common::Task> tasks;
-    vector<TensorsDescMap> vecTensorsMap = CreateTensorsMaps(tensors, total_sol);
+    vector<TensorsDescMap> vecTensorsMap = CreateTensorsMaps(tensors, total_sol, core_list);
     if (AddContiguousInfoInMultiMaps(continuous_v, &vecTensorsMap, ptensors) == FAILED) {
       return FAILED;
     }
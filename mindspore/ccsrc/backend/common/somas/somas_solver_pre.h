@@ -141,6 +141,13 @@ class DynamicBitSet {
     }
   }
 
+  // Union the words in [begin, end) only, the words out of the range may be updated by other threads meanwhile.
+  friend void UnionRange(DynamicBitSet *a, const DynamicBitSet *b, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      (*a).bit_[i] |= (*b).bit_[i];
+    }
+  }
+
   friend void And(DynamicBitSet *a, DynamicBitSet *b) {
     for (size_t i = 0; i < (*a).bit_size_; i++) {
       (*a).bit_[i] &= (*b).bit_[i];
@@ -245,7 +252,8 @@ class SomasSolverPre {
   void SolverInputLog(const session::KernelGraph &graph, const TensorsDescMap &tensors,
                       const vector<vector<size_t>> &continuous_v) const;
   void SolverOutputLog(const session::KernelGraph &graph, const TensorsDescMap &tensors) const;
-  vector<TensorsDescMap> CreateTensorsMaps(const TensorsDescMap &tensors, size_t total_sol) const;
+  vector<TensorsDescMap> CreateTensorsMaps(const TensorsDescMap &tensors, size_t total_sol,
+                                           const std::vector<int> &core_list) const;
   void TensorRelationLog(const std::vector<VectorBitSet> *pConstraints, const session::KernelGraph &graph) const;
 };
 using SomasSolverPrePtr = std::shared_ptr<SomasSolverPre>;
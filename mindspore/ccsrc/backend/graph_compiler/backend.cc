@@ -899,8 +899,8 @@ void MindRTBackend::SyncStream() {
   }
 }
 
-void MindRTBackend::EraseSingleOpCache(const GraphInfo &graph_info) const {
-  pynative::OpCompiler::GetInstance().ClearOpCache(graph_info);
+void MindRTBackend::EraseSingleOpCache(const OpCompilerInfoPtr &op_compiler_info) const {
+  pynative::OpCompiler::GetInstance().ClearOpCache(op_compiler_info);
 }
 
 void MindRTBackend::ReleaseForwardOutput(const std::vector<ValuePtr> &input_values) {
@@ -1046,7 +1046,7 @@ void MindRTBackend::RunOpImpl(bool single_op_cache_hit, const OpCompilerInfoPtr
     UpdateOutputAbstract(*outputs, op_run_info);
   }
   if (op_compiler_info->need_erase_) {
-    EraseSingleOpCache(op_compiler_info->graph_info_);
+    EraseSingleOpCache(op_compiler_info);
   }
 }
 
@@ -1095,7 +1095,7 @@ void MindRTBackend::RunOpImplDynamic(bool single_op_cache_hit, const OpCompilerI
   UpdateOutputAbstract(*outputs, op_run_info);
   ClearOpInputOutput(op_compiler_info);
   if (op_compiler_info->need_erase_) {
-    EraseSingleOpCache(op_compiler_info->graph_info_);
+    EraseSingleOpCache(op_compiler_info);
   }
 }
 
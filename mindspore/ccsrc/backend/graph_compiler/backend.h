@@ -98,7 +98,7 @@ class BACKEND_EXPORT MindRTBackend : public MindRTBackendBase {
 
   // In PyNative mode, the size of single op cache list will be increasing, which lead to memory cost increasing,
   // so the latest single op cache should be erased when cache list size exceeds threshold value.
-  void EraseSingleOpCache(const GraphInfo &graph_info) const;
+  void EraseSingleOpCache(const OpCompilerInfoPtr &op_compiler_info) const;
 
   // Run op or dispatch  build task and run task.
   void RunOpImpl(bool single_op_cache_hit, const OpCompilerInfoPtr &op_compiler_info,
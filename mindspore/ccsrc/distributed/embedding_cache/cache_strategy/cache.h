@@ -45,6 +45,28 @@ class Cache {
   // on different cache strategies.
   virtual bool Get(const KeyType &key, ValueType *value) = 0;
 
+  // Batch version of Put, insert `key_num` elements whose keys and values are recorded in the arrays `keys` and
+  // `values` in order.
+  virtual void Put(const KeyType *keys, size_t key_num, const ValueType *values) {
+    for (size_t i = 0; i < key_num; ++i) {
+      Put(keys[i], values[i]);
+    }
+  }
+
+  // Batch version of Get, query `key_num` keys in order. If the i-th key exists, its Value is assigned to values[i] and
+  // hits[i] is set to true, otherwise hits[i] is set to false. Return the number of hit keys.
+  // The hit and miss counters of the cache are only accumulated by this batch interface.
+  virtual size_t Get(const KeyType *keys, size_t key_num, ValueType *values, bool *hits) {
+    size_t hit_num = 0;
+    for (size_t i = 0; i < key_num; ++i) {
+      hits[i] = Get(keys[i], values + i);
+      hit_num += hits[i] ? 1 : 0;
+    }
+    hit_count_ += hit_num;
+    miss_count_ += key_num - hit_num;
+    return hit_num;
+  }
+
   // Get the most recently used element.
   virtual const Element &Front() const = 0;
 
@@ -74,9 +96,19 @@ class Cache {
   // Get the maximum number of elements that the cache can hold.
   size_t capacity() const { return capacity_; }
 
+  // Get the number of hit and miss keys queried by the batch Get, and the number of evicted elements.
+  size_t hit_count() const { return hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+  size_t evicted_count() const { return evicted_count_; }
+
  protected:
   // The maximum number of elements that the cache can hold.
   size_t capacity_;
+
+  // The statistics of the cache.
+  size_t hit_count_{0};
+  size_t miss_count_{0};
+  size_t evicted_count_{0};
 };
 }  // namespace distributed
 }  // namespace mindspore
@@ -0,0 +1,214 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_CLOCK_CHCHE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_CLOCK_CHCHE_H_
+
+#include <list>
+#include <vector>
+#include <utility>
+#include <functional>
+
+#include "distributed/embedding_cache/cache_strategy/cache.h"
+#include "utils/hash_map.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+// This class implements the CLOCK (second chance) caching strategy, which approximates LRU with a reference bit for
+// each element: accessing an element only sets its reference bit, and the eviction hand sweeps the slots circularly,
+// clears the reference bits which are set and evicts the first element whose reference bit is clear.
+// The elements are stored in a contiguous array of slots and a hash table maps the key to its slot, so accessing an
+// element does not move any element. The newly inserted element starts with a clear reference bit, so the one-off keys
+// of a large scan are evicted before the elements which have been accessed again.
+template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>,
+          typename KeyEqual = std::equal_to<KeyType>>
+class ClockCache : public Cache<KeyType, ValueType> {
+ public:
+  // The elements in cache are stored as key-value pairs.
+  using Element = typename Cache<KeyType, ValueType>::Element;
+  // Keep the batch interfaces of the base class visible.
+  using Cache<KeyType, ValueType>::Put;
+  using Cache<KeyType, ValueType>::Get;
+
+  explicit ClockCache(size_t capacity)
+      : Cache<KeyType, ValueType>(capacity), elements_(capacity), referenced_(capacity, 0), occupied_(capacity, 0) {
+    free_slots_.reserve(capacity);
+    for (size_t i = capacity; i > 0; --i) {
+      free_slots_.push_back(i - 1);
+    }
+    element_keys_to_slots_.reserve(capacity);
+  }
+
+  ~ClockCache() override = default;
+
+  // Insert an element (key-value pair) into the clock cache.
+  // If the key exists, update the value and set the reference bit, otherwise put the element into a free slot.
+  void Put(const KeyType &key, const ValueType &value) override {
+    const auto &iter = element_keys_to_slots_.find(key);
+    if (iter != element_keys_to_slots_.end()) {
+      elements_[iter->second].second = value;
+      referenced_[iter->second] = 1;
+      front_slot_ = iter->second;
+      return;
+    }
+
+    if (IsFull()) {
+      MS_LOG(EXCEPTION) << "There is no space in clock cache.";
+    }
+
+    size_t slot = free_slots_.back();
+    free_slots_.pop_back();
+    elements_[slot] = Element(key, value);
+    occupied_[slot] = 1;
+    referenced_[slot] = 0;
+    front_slot_ = slot;
+    (void)element_keys_to_slots_.emplace(key, slot);
+  }
+
+  // Query the corresponding Value from the cache according to the Key. If the element exists, the corresponding Value
+  // is assigned to parameter value and return true. If the element does not exist, return false.
+  // The reference bit of the accessed element is set, which gives the element a second chance to survive the hand.
+  bool Get(const KeyType &key, ValueType *value) override {
+    const auto &iter = element_keys_to_slots_.find(key);
+    if (iter == element_keys_to_slots_.end()) {
+      return false;
+    }
+    MS_EXCEPTION_IF_NULL(value);
+    referenced_[iter->second] = 1;
+    front_slot_ = iter->second;
+    *value = elements_[iter->second].second;
+    return true;
+  }
+
+  // Get the most recently accessed or inserted element.
+  const Element &Front() const override {
+    if (element_keys_to_slots_.empty()) {
+      MS_LOG(EXCEPTION) << "There is no element in clock cache.";
+    }
+    if (front_slot_ >= occupied_.size() || occupied_[front_slot_] == 0) {
+      MS_LOG(EXCEPTION) << "The most recently used element has been evicted from clock cache.";
+    }
+    return elements_[front_slot_];
+  }
+
+  // Get the element which will be evicted next.
+  const Element &Back() const override {
+    if (element_keys_to_slots_.empty()) {
+      MS_LOG(EXCEPTION) << "There is no element in clock cache.";
+    }
+    return elements_[NextVictim()];
+  }
+
+  // Query whether the element corresponding to a particular key exists in the cache.
+  bool Exists(const KeyType &key) const override {
+    return element_keys_to_slots_.find(key) != element_keys_to_slots_.end();
+  }
+
+  // When the size of the cache is close to capacity, you can use this interface to evict some non-hot data to reserve
+  // space for new elements to be inserted into the cache. If the current cache has enough free space, this function
+  // does nothing.
+  // The input parameter 'reserve_size' indicates the number of element slots that are expected to be reserved. If the
+  // reserve_size is less than or equal to the number of slots remaining in the cache, the function does nothing.
+  // The output parameter 'evicted_elements' is used to hold the evicted element.
+  void TryEvict(size_t reserve_size, std::vector<Element> *evicted_elements) override {
+    MS_EXCEPTION_IF_NULL(evicted_elements);
+    const auto &capacity = Cache<KeyType, ValueType>::capacity();
+    if (reserve_size > capacity) {
+      MS_LOG(EXCEPTION) << "The evict number must be less or equal to clock cache capacity: " << capacity
+                        << ", but got: " << reserve_size;
+    }
+
+    while (size() > capacity - reserve_size) {
+      // Sweep the hand until an element without reference bit is found, which terminates within two rounds.
+      while (occupied_[hand_] == 0 || referenced_[hand_] != 0) {
+        referenced_[hand_] = 0;
+        hand_ = (hand_ + 1) % capacity;
+      }
+      evicted_elements->emplace_back(elements_[hand_].first, elements_[hand_].second);
+      (void)element_keys_to_slots_.erase(elements_[hand_].first);
+      occupied_[hand_] = 0;
+      free_slots_.push_back(hand_);
+      ++this->evicted_count_;
+      hand_ = (hand_ + 1) % capacity;
+    }
+  }
+
+  // Check whether the number of elements in cache reaches capacity.
+  bool IsFull() const override { return size() >= Cache<KeyType, ValueType>::capacity(); }
+
+  // Get the current number of elements in the cache.
+  size_t size() const override { return element_keys_to_slots_.size(); }
+
+  // Dump all elements in the clock cache, the back of the list is the element which will be evicted next.
+  // The list is a snapshot which is rebuilt by every call.
+  const std::list<Element> &Export() const override {
+    exported_elements_.clear();
+    const auto &capacity = Cache<KeyType, ValueType>::capacity();
+    // The hand evicts the unreferenced elements in order first, and then the referenced ones in the next round.
+    for (uint8_t referenced : {0, 1}) {
+      for (size_t i = 0; i < capacity; ++i) {
+        size_t slot = (hand_ + i) % capacity;
+        if (occupied_[slot] != 0 && referenced_[slot] == referenced) {
+          exported_elements_.push_front(elements_[slot]);
+        }
+      }
+    }
+    return exported_elements_;
+  }
+
+ private:
+  // Find the slot which will be evicted next without moving the hand.
+  size_t NextVictim() const {
+    const auto &capacity = Cache<KeyType, ValueType>::capacity();
+    size_t first_occupied = capacity;
+    for (size_t i = 0; i < capacity; ++i) {
+      size_t slot = (hand_ + i) % capacity;
+      if (occupied_[slot] == 0) {
+        continue;
+      }
+      if (referenced_[slot] == 0) {
+        return slot;
+      }
+      if (first_occupied == capacity) {
+        first_occupied = slot;
+      }
+    }
+    return first_occupied;
+  }
+
+  // The slots used to hold elements.
+  std::vector<Element> elements_;
+  // The reference bit and occupied flag of each slot.
+  std::vector<uint8_t> referenced_;
+  std::vector<uint8_t> occupied_;
+  // The free slots, the last one is used first.
+  std::vector<size_t> free_slots_;
+
+  // The current position of the eviction hand.
+  size_t hand_{0};
+  // The slot of the most recently accessed or inserted element.
+  size_t front_slot_{0};
+
+  // The hash table used to quickly find the slot of an element.
+  mindspore::HashMap<KeyType, size_t, Hash, KeyEqual> element_keys_to_slots_;
+
+  // The snapshot of all elements returned by Export.
+  mutable std::list<Element> exported_elements_;
+};
+}  // namespace distributed
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_CLOCK_CHCHE_H_
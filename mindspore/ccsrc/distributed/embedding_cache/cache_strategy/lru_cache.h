@@ -40,6 +40,9 @@ class LRUCache : public Cache<KeyType, ValueType> {
   using Element = typename Cache<KeyType, ValueType>::Element;
   // The Iter type is the iterator type of the linked list.
   using Iter = typename std::list<Element>::iterator;
+  // Keep the batch interfaces of the base class visible.
+  using Cache<KeyType, ValueType>::Put;
+  using Cache<KeyType, ValueType>::Get;
 
   explicit LRUCache(size_t capacity) : Cache<KeyType, ValueType>(capacity) {}
 
@@ -125,6 +128,7 @@ class LRUCache : public Cache<KeyType, ValueType> {
       evicted_elements->emplace_back(back_element.first, back_element.second);
       (void)element_keys_to_iters_.erase(back_element.first);
       elements_.pop_back();
+      ++this->evicted_count_;
     }
   }
 
@@ -0,0 +1,387 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_TINY_LFU_CHCHE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_TINY_LFU_CHCHE_H_
+
+#include <algorithm>
+#include <list>
+#include <vector>
+#include <utility>
+#include <functional>
+
+#include "distributed/embedding_cache/cache_strategy/cache.h"
+#include "utils/hash_map.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+// A count-min sketch which estimates the access frequency of keys with saturating counters (at most 15). The counters
+// are updated conservatively, only the smallest counters of a key are increased. All the counters are halved once the
+// number of recorded accesses reaches ten times the capacity, so the frequency of history hot keys decays.
+template <typename KeyType, typename Hash = std::hash<KeyType>>
+class FrequencySketch {
+ public:
+  explicit FrequencySketch(size_t capacity) {
+    // Each row has 4 counters for every element of the cache to keep the estimation error small.
+    constexpr size_t kCountersPerElement = 4;
+    width_ = 1;
+    while (width_ < std::max(capacity * kCountersPerElement, kMinWidth)) {
+      width_ <<= 1;
+    }
+    counters_.resize(width_ * kDepth, 0);
+    sample_size_ = std::max(capacity, kMinWidth) * kSampleRatio;
+  }
+  ~FrequencySketch() = default;
+
+  // Record an access of the key.
+  void Increment(const KeyType &key) {
+    uint64_t hash = static_cast<uint64_t>(Hash()(key));
+    size_t indices[kDepth];
+    uint8_t frequency = kMaxCount;
+    for (size_t row = 0; row < kDepth; ++row) {
+      indices[row] = Index(hash, row);
+      frequency = std::min(frequency, counters_[indices[row]]);
+    }
+    if (frequency == kMaxCount) {
+      return;
+    }
+    for (size_t row = 0; row < kDepth; ++row) {
+      if (counters_[indices[row]] == frequency) {
+        ++counters_[indices[row]];
+      }
+    }
+    if (++additions_ >= sample_size_) {
+      Reset();
+    }
+  }
+
+  // Get the estimated access frequency of the key.
+  uint8_t Frequency(const KeyType &key) const {
+    uint64_t hash = static_cast<uint64_t>(Hash()(key));
+    uint8_t frequency = kMaxCount;
+    for (size_t row = 0; row < kDepth; ++row) {
+      frequency = std::min(frequency, counters_[Index(hash, row)]);
+    }
+    return frequency;
+  }
+
+ private:
+  static constexpr size_t kDepth = 4;
+  static constexpr size_t kMinWidth = 16;
+  static constexpr size_t kSampleRatio = 10;
+  static constexpr uint8_t kMaxCount = 15;
+
+  // Each row uses an independent hash which is derived from the hash of key by the finalizer of murmur3.
+  size_t Index(uint64_t hash, size_t row) const {
+    constexpr uint64_t kSeeds[kDepth] = {0x97cb3127ULL, 0xab7d4f8bULL, 0x4f9e1b85ULL, 0xc2b2ae35ULL};
+    hash ^= kSeeds[row];
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return row * width_ + static_cast<size_t>(hash & (width_ - 1));
+  }
+
+  void Reset() {
+    for (auto &counter : counters_) {
+      counter >>= 1;
+    }
+    additions_ /= 2;
+  }
+
+  // The counters of all rows, the counters of row i are in [i * width_, (i + 1) * width_).
+  std::vector<uint8_t> counters_;
+  size_t width_;
+  size_t sample_size_;
+  size_t additions_{0};
+};
+
+// This class implements a W-TinyLFU caching strategy, which is resistant to the scan of one-off keys.
+// The elements are split into an admission window (1% of capacity) and the main space. New elements are inserted into
+// the window in FIFO order. When an element has to be evicted, the oldest element of the window becomes the eviction
+// candidate, which competes with the eviction victim of the main space by the access frequency estimated by a
+// count-min sketch: the winner stays in (or moves into) the main space and the loser is evicted. So a key accessed only
+// once hardly replaces a hot element of the main space.
+// All the elements are stored in a contiguous array of slots instead of linked lists, the window is a ring buffer of
+// slots and the main space is managed by the CLOCK (second chance) algorithm. The window may temporarily exceed its
+// target size, since the space of a batch is reserved by TryEvict before the keys of the batch are inserted, and the
+// admission of these keys is decided by the next eviction.
+template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>,
+          typename KeyEqual = std::equal_to<KeyType>>
+class TinyLFUCache : public Cache<KeyType, ValueType> {
+ public:
+  // The elements in cache are stored as key-value pairs.
+  using Element = typename Cache<KeyType, ValueType>::Element;
+  // Keep the batch interfaces of the base class visible.
+  using Cache<KeyType, ValueType>::Put;
+  using Cache<KeyType, ValueType>::Get;
+
+  explicit TinyLFUCache(size_t capacity)
+      : Cache<KeyType, ValueType>(capacity),
+        elements_(capacity),
+        referenced_(capacity, 0),
+        occupied_(capacity, 0),
+        in_window_(capacity, 0),
+        window_(capacity),
+        sketch_(capacity) {
+    constexpr size_t kWindowPercent = 1;
+    constexpr size_t kPercentBase = 100;
+    window_target_size_ =
+      std::min(capacity, std::max(capacity * kWindowPercent / kPercentBase, static_cast<size_t>(1)));
+    free_slots_.reserve(capacity);
+    for (size_t i = capacity; i > 0; --i) {
+      free_slots_.push_back(i - 1);
+    }
+    element_keys_to_slots_.reserve(capacity);
+  }
+
+  ~TinyLFUCache() override = default;
+
+  // Insert an element (key-value pair) into the cache.
+  // If the key exists, update the value and set the reference bit, otherwise put the element into the window.
+  // Put does not record the access in the frequency sketch, because an element is generally inserted after its key
+  // missed in Get, which has recorded the access.
+  void Put(const KeyType &key, const ValueType &value) override {
+    const auto &iter = element_keys_to_slots_.find(key);
+    if (iter != element_keys_to_slots_.end()) {
+      elements_[iter->second].second = value;
+      referenced_[iter->second] = 1;
+      front_slot_ = iter->second;
+      return;
+    }
+
+    if (IsFull()) {
+      MS_LOG(EXCEPTION) << "There is no space in tiny lfu cache.";
+    }
+
+    size_t slot = free_slots_.back();
+    free_slots_.pop_back();
+    elements_[slot] = Element(key, value);
+    occupied_[slot] = 1;
+    referenced_[slot] = 0;
+    in_window_[slot] = 1;
+    window_[(window_head_ + window_size_) % window_.size()] = slot;
+    ++window_size_;
+    front_slot_ = slot;
+    (void)element_keys_to_slots_.emplace(key, slot);
+  }
+
+  // Query the corresponding Value from the cache according to the Key. If the element exists, the corresponding Value
+  // is assigned to parameter value and return true. If the element does not exist, return false.
+  // Both hit and miss keys are recorded by the frequency sketch.
+  bool Get(const KeyType &key, ValueType *value) override {
+    sketch_.Increment(key);
+    const auto &iter = element_keys_to_slots_.find(key);
+    if (iter == element_keys_to_slots_.end()) {
+      return false;
+    }
+    MS_EXCEPTION_IF_NULL(value);
+    referenced_[iter->second] = 1;
+    front_slot_ = iter->second;
+    *value = elements_[iter->second].second;
+    return true;
+  }
+
+  // Get the most recently accessed or inserted element.
+  const Element &Front() const override {
+    if (element_keys_to_slots_.empty()) {
+      MS_LOG(EXCEPTION) << "There is no element in tiny lfu cache.";
+    }
+    if (front_slot_ >= occupied_.size() || occupied_[front_slot_] == 0) {
+      MS_LOG(EXCEPTION) << "The most recently used element has been evicted from tiny lfu cache.";
+    }
+    return elements_[front_slot_];
+  }
+
+  // Get the element which will be evicted next.
+  const Element &Back() const override {
+    if (element_keys_to_slots_.empty()) {
+      MS_LOG(EXCEPTION) << "There is no element in tiny lfu cache.";
+    }
+    if (window_size_ == 0) {
+      return elements_[PeekMainVictim()];
+    }
+    size_t candidate = window_[window_head_];
+    if (main_size() == 0) {
+      return elements_[candidate];
+    }
+    size_t victim = PeekMainVictim();
+    return Admit(candidate, victim) ? elements_[victim] : elements_[candidate];
+  }
+
+  // Query whether the element corresponding to a particular key exists in the cache.
+  bool Exists(const KeyType &key) const override {
+    return element_keys_to_slots_.find(key) != element_keys_to_slots_.end();
+  }
+
+  // When the size of the cache is close to capacity, you can use this interface to evict some non-hot data to reserve
+  // space for new elements to be inserted into the cache. If the current cache has enough free space, this function
+  // does nothing.
+  // The input parameter 'reserve_size' indicates the number of element slots that are expected to be reserved. If the
+  // reserve_size is less than or equal to the number of slots remaining in the cache, the function does nothing.
+  // The output parameter 'evicted_elements' is used to hold the evicted element.
+  void TryEvict(size_t reserve_size, std::vector<Element> *evicted_elements) override {
+    MS_EXCEPTION_IF_NULL(evicted_elements);
+    const auto &capacity = Cache<KeyType, ValueType>::capacity();
+    if (reserve_size > capacity) {
+      MS_LOG(EXCEPTION) << "The evict number must be less or equal to tiny lfu cache capacity: " << capacity
+                        << ", but got: " << reserve_size;
+    }
+
+    // The overflowed elements of the window move into the main space directly if nothing needs to be evicted, or if the
+    // main space is empty, which happens when the cache is filled without eviction.
+    if (size() <= capacity - reserve_size || main_size() == 0) {
+      while (window_size_ > window_target_size_) {
+        in_window_[PopWindow()] = 0;
+      }
+    }
+
+    while (size() > capacity - reserve_size) {
+      if (window_size_ == 0) {
+        EvictSlot(SelectMainVictim(), evicted_elements);
+        continue;
+      }
+      if (main_size() == 0) {
+        EvictSlot(PopWindow(), evicted_elements);
+        continue;
+      }
+      // The reserved space will be taken by the new elements of the window, so the oldest element of the window
+      // competes with the main victim.
+      size_t candidate = PopWindow();
+      size_t victim = SelectMainVictim();
+      if (Admit(candidate, victim)) {
+        EvictSlot(victim, evicted_elements);
+        in_window_[candidate] = 0;
+      } else {
+        EvictSlot(candidate, evicted_elements);
+      }
+    }
+  }
+
+  // Check whether the number of elements in cache reaches capacity.
+  bool IsFull() const override { return size() >= Cache<KeyType, ValueType>::capacity(); }
+
+  // Get the current number of elements in the cache.
+  size_t size() const override { return element_keys_to_slots_.size(); }
+
+  // Dump all elements in the cache, the elements of the main space are in front of the elements of the window.
+  // The list is a snapshot which is rebuilt by every call.
+  const std::list<Element> &Export() const override {
+    exported_elements_.clear();
+    for (size_t slot = 0; slot < occupied_.size(); ++slot) {
+      if (occupied_[slot] != 0 && in_window_[slot] == 0) {
+        exported_elements_.push_back(elements_[slot]);
+      }
+    }
+    for (size_t i = window_size_; i > 0; --i) {
+      exported_elements_.push_back(elements_[window_[(window_head_ + i - 1) % window_.size()]]);
+    }
+    return exported_elements_;
+  }
+
+ private:
+  size_t main_size() const { return size() - window_size_; }
+
+  // Whether the window candidate should replace the main victim, the candidate is admitted only if it is accessed more
+  // frequently than the victim.
+  bool Admit(size_t candidate, size_t victim) const {
+    return sketch_.Frequency(elements_[candidate].first) > sketch_.Frequency(elements_[victim].first);
+  }
+
+  // Remove the oldest element from the window and return its slot.
+  size_t PopWindow() {
+    size_t slot = window_[window_head_];
+    window_head_ = (window_head_ + 1) % window_.size();
+    --window_size_;
+    return slot;
+  }
+
+  bool IsMainSlot(size_t slot) const { return occupied_[slot] != 0 && in_window_[slot] == 0; }
+
+  // Sweep the hand of the non-empty main space to the first element without reference bit and return its slot.
+  size_t SelectMainVictim() {
+    const auto &capacity = Cache<KeyType, ValueType>::capacity();
+    while (!IsMainSlot(hand_) || referenced_[hand_] != 0) {
+      referenced_[hand_] = 0;
+      hand_ = (hand_ + 1) % capacity;
+    }
+    size_t victim = hand_;
+    hand_ = (hand_ + 1) % capacity;
+    return victim;
+  }
+
+  // Find the slot which will be selected by SelectMainVictim without moving the hand.
+  size_t PeekMainVictim() const {
+    const auto &capacity = Cache<KeyType, ValueType>::capacity();
+    size_t first_main_slot = capacity;
+    for (size_t i = 0; i < capacity; ++i) {
+      size_t slot = (hand_ + i) % capacity;
+      if (!IsMainSlot(slot)) {
+        continue;
+      }
+      if (referenced_[slot] == 0) {
+        return slot;
+      }
+      if (first_main_slot == capacity) {
+        first_main_slot = slot;
+      }
+    }
+    return first_main_slot;
+  }
+
+  void EvictSlot(size_t slot, std::vector<Element> *evicted_elements) {
+    evicted_elements->emplace_back(elements_[slot].first, elements_[slot].second);
+    (void)element_keys_to_slots_.erase(elements_[slot].first);
+    occupied_[slot] = 0;
+    in_window_[slot] = 0;
+    free_slots_.push_back(slot);
+    ++this->evicted_count_;
+  }
+
+  // The slots used to hold elements.
+  std::vector<Element> elements_;
+  // The reference bit, occupied flag and window flag of each slot.
+  std::vector<uint8_t> referenced_;
+  std::vector<uint8_t> occupied_;
+  std::vector<uint8_t> in_window_;
+  // The free slots, the last one is used first.
+  std::vector<size_t> free_slots_;
+
+  // The ring buffer of the window slots in insertion order, the oldest one is at window_head_.
+  std::vector<size_t> window_;
+  size_t window_head_{0};
+  size_t window_size_{0};
+  size_t window_target_size_;
+
+  // The current position of the eviction hand of the main space.
+  size_t hand_{0};
+  // The slot of the most recently accessed or inserted element.
+  size_t front_slot_{0};
+
+  // The frequency sketch records the accesses of all keys, including the keys not in the cache.
+  FrequencySketch<KeyType, Hash> sketch_;
+
+  // The hash table used to quickly find the slot of an element.
+  mindspore::HashMap<KeyType, size_t, Hash, KeyEqual> element_keys_to_slots_;
+
+  // The snapshot of all elements returned by Export.
+  mutable std::list<Element> exported_elements_;
+};
+}  // namespace distributed
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_TINY_LFU_CHCHE_H_
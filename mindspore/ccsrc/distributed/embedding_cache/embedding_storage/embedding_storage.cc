@@ -18,6 +18,8 @@
 #include <map>
 #include <string>
 #include "distributed/embedding_cache/cache_strategy/lru_cache.h"
+#include "distributed/embedding_cache/cache_strategy/clock_cache.h"
+#include "distributed/embedding_cache/cache_strategy/tiny_lfu_cache.h"
 #include "distributed/persistent/storage/local_file.h"
 #if defined(__linux__) && defined(WITH_BACKEND)
 #include "include/backend/distributed/ps/ps_context.h"
@@ -33,6 +35,11 @@ namespace {
 constexpr auto kEnvEmbeddingRemoteStoragePath = "MS_EMBEDDING_REMOTE_STORAGE_PATH";
 // Default value for embedding remote persistent file storage path.
 constexpr auto kDefaultEmbeddingRemoteStoragePath = "./embedding_storage";
+// The environment variable used to set the cache strategy of the host cache, the options are "lru"(default), "clock"
+// and "tinylfu".
+constexpr auto kEnvEmbeddingCacheStrategy = "MS_EMBEDDING_CACHE_STRATEGY";
+constexpr auto kClockCacheStrategy = "clock";
+constexpr auto kTinyLFUCacheStrategy = "tinylfu";
 
 // Get embedding remote persistent file storage path from environment variable.
 std::string GetEmbeddingRemoteStoragePath() {
@@ -43,6 +50,22 @@ std::string GetEmbeddingRemoteStoragePath() {
 
   return stoage_path;
 }
+
+// Create the host cache of the cache strategy specified by environment variable.
+template <typename KeyType>
+std::unique_ptr<Cache<KeyType, int>> CreateHostCache(size_t cache_capacity) {
+  std::string cache_strategy = common::GetEnv(kEnvEmbeddingCacheStrategy);
+  if (cache_strategy == kClockCacheStrategy) {
+    return std::make_unique<ClockCache<KeyType, int>>(cache_capacity);
+  }
+  if (cache_strategy == kTinyLFUCacheStrategy) {
+    return std::make_unique<TinyLFUCache<KeyType, int>>(cache_capacity);
+  }
+  if (!cache_strategy.empty() && cache_strategy != "lru") {
+    MS_LOG(WARNING) << "Unsupported embedding cache strategy: " << cache_strategy << ", use lru cache instead.";
+  }
+  return std::make_unique<LRUCache<KeyType, int>>(cache_capacity);
+}
 }  // namespace
 
 template <typename KeyType, typename ValueType, typename Allocator>
@@ -57,7 +80,7 @@ void EmbeddingStorage<KeyType, ValueType, Allocator>::Initialize(const DeviceAdd
 #endif
 
   // 2. Create the host memory cache instance.
-  cache_ = std::make_unique<LRUCache<KeyType, int>>(cache_capacity_);
+  cache_ = CreateHostCache<KeyType>(cache_capacity_);
   MS_EXCEPTION_IF_NULL(cache_);
 
   // 3. Create the persistent storage instance.
@@ -86,12 +109,28 @@ void EmbeddingStorage<KeyType, ValueType, Allocator>::Initialize(const DeviceAdd
 template <typename KeyType, typename ValueType, typename Allocator>
 void EmbeddingStorage<KeyType, ValueType, Allocator>::Finalize() {
   MS_EXCEPTION_IF_NULL(cache_);
+  const auto &statistics = GetCacheStatistics();
+  MS_LOG(INFO) << "The host cache statistics of embedding table " << embedding_key_
+               << ", hit number: " << statistics.hit_count << ", miss number: " << statistics.miss_count
+               << ", hit rate: " << statistics.hit_rate() << ", evicted number: " << statistics.evicted_count;
   cache_ = nullptr;
   MS_EXCEPTION_IF_NULL(storage_);
   storage_->Finalize();
   storage_ = nullptr;
 }
 
+template <typename KeyType, typename ValueType, typename Allocator>
+EmbeddingCacheStatistics EmbeddingStorage<KeyType, ValueType, Allocator>::GetCacheStatistics() const {
+  EmbeddingCacheStatistics statistics;
+  if (cache_ == nullptr) {
+    return statistics;
+  }
+  statistics.hit_count = cache_->hit_count();
+  statistics.miss_count = cache_->miss_count();
+  statistics.evicted_count = cache_->evicted_count();
+  return statistics;
+}
+
 template class EmbeddingStorage<int32_t, bool>;
 template class EmbeddingStorage<int32_t, int8_t>;
 template class EmbeddingStorage<int32_t, int16_t>;
@@ -100,6 +100,12 @@ class EmbeddingStorage : public AbstractEmbeddingStorage {
     return std::vector<std::shared_ptr<std::vector<char>>>();
   }
 
+  /**
+   * @brief Get the hit, miss and eviction statistics of the host cache.
+   * @return The statistics of the host cache.
+   */
+  EmbeddingCacheStatistics GetCacheStatistics() const override;
+
  protected:
   /**
    * @brief Allocate host memory use alloc_.
@@ -150,18 +150,15 @@ void SparseEmbeddingStorage<KeyType, ValueType, Allocator>::QueryCache(const Key
   MS_EXCEPTION_IF_NULL(cache_hit);
   MS_EXCEPTION_IF_NULL(this->cache_);
 
-  int fake_index;
+  // Touch keys to affect the location or order of the elements in the cache, the returned values for hash table are
+  // useless.
+  std::vector<int> fake_indices(key_num);
+  (void)this->cache_->Get(keys, key_num, fake_indices.data(), cache_hit);
   for (size_t i = 0; i < key_num; i++) {
-    if (this->cache_->Get(keys[i], &fake_index)) {
-      // Touch keys to affect the location or order of the elements in the cache, the return value for hash table is
-      // useless.
-      cache_hit[i] = true;
-      continue;
+    if (!cache_hit[i]) {
+      // Record cache miss key's offset in all query keys.
+      cache_miss_offsets[(*cache_miss_cnt)++] = i;
     }
-
-    cache_hit[i] = false;
-    // Record cache miss key's offset in all query keys.
-    cache_miss_offsets[(*cache_miss_cnt)++] = i;
   }
 
   MS_LOG(DEBUG) << "Total keys number: " << key_num << ", cache hit number: " << (key_num - *cache_miss_cnt)
@@ -245,12 +242,13 @@ bool SparseEmbeddingStorage<KeyType, ValueType, Allocator>::InsertMissCacheFromS
   MS_EXCEPTION_IF_NULL(this->storage_);
   this->storage_->Read({cache_miss_keys, cache_miss_keys_len}, {cache_miss_values, cache_miss_values_len});
 
-  // 2. Insert the cache miss elements into cache, and copy them to the returned values.
-  for (size_t i = 0; i < cache_miss_cnt; i++) {
-    // Insert key-index pairs of the cache miss elements into the cache, the index for hash embedding table is useless,
-    // set the value to 0.
-    this->cache_->Put(cache_miss_keys[i], 0);
+  // 2. Insert key-index pairs of the cache miss elements into the cache, the index for hash embedding table is useless,
+  // set the value to 0.
+  std::vector<int> fake_indices(cache_miss_cnt, 0);
+  this->cache_->Put(cache_miss_keys, cache_miss_cnt, fake_indices.data());
 
+  // 3. Insert the cache miss elements into hash table, and copy them to the returned values.
+  for (size_t i = 0; i < cache_miss_cnt; i++) {
     // Insert the embedding vectors of cache miss elements to the cache.
     RETURN_IF_FALSE_WITH_LOG(
       hash_table_->Insert(cache_miss_keys + i, 1, cache_miss_values + this->embedding_dim_ * i, nullptr),
@@ -282,11 +280,16 @@ bool SparseEmbeddingStorage<KeyType, ValueType, Allocator>::InsertMissCacheFromM
   MS_EXCEPTION_IF_NULL(this->cache_);
   MS_EXCEPTION_IF_NULL(hash_table_);
 
+  // Insert key-index pairs of the cache miss elements into the cache, the index for hash embedding table is useless,
+  // set the value to 0.
+  std::vector<KeyType> cache_miss_keys(cache_miss_cnt);
   for (size_t i = 0; i < cache_miss_cnt; i++) {
-    // Insert key-index pairs of the cache miss elements into the cache, the index for hash embedding table is useless,
-    // set the value to 0.
-    this->cache_->Put(keys[cache_miss_offsets[i]], 0);
+    cache_miss_keys[i] = keys[cache_miss_offsets[i]];
+  }
+  std::vector<int> fake_indices(cache_miss_cnt, 0);
+  this->cache_->Put(cache_miss_keys.data(), cache_miss_cnt, fake_indices.data());
 
+  for (size_t i = 0; i < cache_miss_cnt; i++) {
     // Insert the embedding vectors of cache miss elements to the cache.
     RETURN_IF_FALSE_WITH_LOG(hash_table_->Insert(keys + cache_miss_offsets[i], 1,
                                                  values + this->embedding_dim_ * cache_miss_offsets[i], nullptr),
@@ -40,6 +40,11 @@ constexpr char kFileStoragePath[] = "file_storage_path";
 constexpr char kMaxBlockLength[] = "max_block_length";
 
 constexpr char kElementSize[] = "element_size";
+
+// Whether to read the values of key-value pairs through the memory mapped block files, "true" or "false".
+constexpr char kEnableMmapRead[] = "enable_mmap_read";
+// The number of coalesced ranges which are prefetched ahead of the copying when reading key-value pairs.
+constexpr char kReadQueueDepth[] = "read_queue_depth";
 }  // namespace storage
 }  // namespace distributed
 }  // namespace mindspore
@@ -16,9 +16,16 @@
 
 #include "distributed/persistent/storage/local_file.h"
 #include <dirent.h>
+#include <fcntl.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <securec.h>
 #include <cmath>
 #include <algorithm>
 #include <numeric>
+#include <stdexcept>
 #include <tuple>
 #include <utility>
 #include "utils/convert_utils_base.h"
@@ -52,10 +59,36 @@ LocalFile<KeyType, ValueType>::LocalFile(const std::map<std::string, std::string
   } else {
     element_size_ = 0;
   }
+
+  auto enable_mmap_read_iter = storage_config.find(kEnableMmapRead);
+  if (enable_mmap_read_iter != storage_config.end()) {
+    enable_mmap_read_ = (enable_mmap_read_iter->second != "false");
+  }
+#if defined(_WIN32) || defined(_WIN64)
+  enable_mmap_read_ = false;
+#endif
+
+  auto read_queue_depth_iter = storage_config.find(kReadQueueDepth);
+  if (read_queue_depth_iter != storage_config.end() && !(read_queue_depth_iter->second).empty()) {
+    // Parse as a signed value, std::stoul would wrap a negative depth around to a huge one.
+    int64_t read_queue_depth = 0;
+    size_t parsed_length = 0;
+    try {
+      read_queue_depth = std::stoll(read_queue_depth_iter->second, &parsed_length);
+    } catch (const std::exception &e) {
+      MS_LOG(EXCEPTION) << "Invalid " << kReadQueueDepth << ": " << read_queue_depth_iter->second << ", " << e.what();
+    }
+    if (parsed_length != read_queue_depth_iter->second.size() || read_queue_depth <= 0) {
+      MS_LOG(EXCEPTION) << "Invalid " << kReadQueueDepth << ": " << read_queue_depth_iter->second
+                        << ", it should be a positive integer.";
+    }
+    read_queue_depth_ = LongToSize(read_queue_depth);
+  }
 }
 
 template <typename KeyType, typename ValueType>
 LocalFile<KeyType, ValueType>::~LocalFile() {
+  UnmapBlockFiles();
   for (const auto &file : block_files_) {
     if (file == nullptr) {
       continue;
@@ -76,6 +109,7 @@ void LocalFile<KeyType, ValueType>::Initialize() {
 
 template <typename KeyType, typename ValueType>
 void LocalFile<KeyType, ValueType>::Finalize() {
+  UnmapBlockFiles();
   block_files_.clear();
   fs_ = nullptr;
   keys_to_locations_.clear();
@@ -411,22 +445,133 @@ void LocalFile<KeyType, ValueType>::Read(const ConstDataWithLen &keys, const Dat
     MS_LOG(EXCEPTION) << "The value length is insufficient.";
   }
 
+  // 1. Find the location {block index, offset in block} of each key, the location is measured in bytes from the
+  // beginning of the block file.
+  std::vector<std::tuple<size_t, size_t, size_t>> locations;
+  locations.reserve(key_num);
   for (size_t i = 0; i < key_num; i++) {
-    // 1. Find the position offset measured in bytes from the beginning of this file by keys.
     auto iter = keys_to_locations_.find(keys_data[i]);
     if (iter == keys_to_locations_.end()) {
       MS_LOG(DEBUG) << "Can not find key: " << keys_data[i] << " to locate the position in file.";
       continue;
     }
-    const std::pair<size_t, size_t> &offset = iter->second;
+    (void)locations.emplace_back(iter->second.first, iter->second.second, i);
+  }
+  if (locations.empty()) {
+    return;
+  }
+
+  // 2. Sort the locations by (block, offset) and coalesce the adjacent ones into contiguous ranges.
+  std::sort(locations.begin(), locations.end());
+  std::vector<ReadRange> ranges;
+  for (size_t i = 0; i < locations.size(); i++) {
+    size_t block_index = std::get<0>(locations[i]);
+    size_t offset = std::get<1>(locations[i]);
+    if (!ranges.empty() && ranges.back().block_index == block_index && ranges.back().end == offset) {
+      ranges.back().end += element_len;
+      ranges.back().last = i + 1;
+      continue;
+    }
+    (void)ranges.emplace_back(ReadRange{block_index, offset, offset + element_len, i, i + 1});
+  }
 
-    const system::WriteFilePtr &block_file = block_files_.at(offset.first);
-    MS_EXCEPTION_IF_NULL(block_file);
-    size_t offset_in_block = offset.second;
-    // 2. Read the values corresponding to keys.
-    MS_EXCEPTION_IF_CHECK_FAIL(block_file->PRead(values_data + i * element_size_, element_len, offset_in_block),
-                               "PRead file failed.");
+  // 3. Read the values of each range: copy from the memory mapped block file with the ranges ahead prefetched, or read
+  // the whole range by one PRead.
+  std::vector<char> range_buffer;
+  size_t prefetched_num = 0;
+  for (size_t range_index = 0; range_index < ranges.size(); range_index++) {
+    const auto &range = ranges[range_index];
+    const char *mapped_block = enable_mmap_read_ ? GetMappedBlock(range.block_index) : nullptr;
+    const char *range_data = nullptr;
+    if (mapped_block != nullptr) {
+      for (prefetched_num = std::max(prefetched_num, range_index);
+           prefetched_num < ranges.size() && prefetched_num <= range_index + read_queue_depth_; prefetched_num++) {
+        const char *prefetch_block = GetMappedBlock(ranges[prefetched_num].block_index);
+        if (prefetch_block != nullptr) {
+          Prefetch(prefetch_block, ranges[prefetched_num]);
+        }
+      }
+      range_data = mapped_block + range.begin;
+    } else {
+      const system::WriteFilePtr &block_file = block_files_.at(range.block_index);
+      MS_EXCEPTION_IF_NULL(block_file);
+      range_buffer.resize(range.end - range.begin);
+      MS_EXCEPTION_IF_CHECK_FAIL(block_file->PRead(range_buffer.data(), range_buffer.size(), range.begin),
+                                 "PRead file failed.");
+      range_data = range_buffer.data();
+    }
+
+    for (size_t i = range.first; i < range.last; i++) {
+      size_t key_index = std::get<2>(locations[i]);
+      auto ret = memcpy_s(values_data + key_index * element_size_, element_len,
+                          range_data + (std::get<1>(locations[i]) - range.begin), element_len);
+      if (ret != EOK) {
+        MS_LOG(EXCEPTION) << "Failed to copy data, memcpy_s errorno: " << ret;
+      }
+    }
+  }
+}
+
+template <typename KeyType, typename ValueType>
+const char *LocalFile<KeyType, ValueType>::GetMappedBlock(size_t block_index) {
+  if (mapped_blocks_.size() < block_files_.size()) {
+    mapped_blocks_.resize(block_files_.size(), nullptr);
+  }
+  if (mapped_blocks_[block_index] != nullptr) {
+    return mapped_blocks_[block_index];
+  }
+
+#if !defined(_WIN32) && !defined(_WIN64)
+  const system::WriteFilePtr &block_file = block_files_.at(block_index);
+  MS_EXCEPTION_IF_NULL(block_file);
+  size_t block_length = block_size_ * element_size_ * sizeof(ValueType);
+  int fd = open(block_file->get_file_name().c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(WARNING) << "Open block file[" << block_file->get_file_name()
+                    << "] failed, fall back to read the block files by PRead, errno: " << errno;
+    enable_mmap_read_ = false;
+    return nullptr;
+  }
+  // The block files are written by pwrite, the shared mapping always sees the latest values in the page cache.
+  void *addr = mmap(nullptr, block_length, PROT_READ, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(WARNING) << "Mmap block file[" << block_file->get_file_name()
+                    << "] failed, fall back to read the block files by PRead, errno: " << errno;
+    enable_mmap_read_ = false;
+    return nullptr;
+  }
+  // The values of key-value pairs are accessed randomly, the read-ahead is issued explicitly by Prefetch.
+  (void)madvise(addr, block_length, MADV_RANDOM);
+  mapped_blocks_[block_index] = static_cast<char *>(addr);
+  return mapped_blocks_[block_index];
+#else
+  enable_mmap_read_ = false;
+  return nullptr;
+#endif
+}
+
+template <typename KeyType, typename ValueType>
+void LocalFile<KeyType, ValueType>::Prefetch(const char *mapped_block, const ReadRange &range) const {
+#if !defined(_WIN32) && !defined(_WIN64)
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t aligned_begin = range.begin / page_size * page_size;
+  (void)madvise(const_cast<char *>(mapped_block) + aligned_begin, range.end - aligned_begin, MADV_WILLNEED);
+#endif
+}
+
+template <typename KeyType, typename ValueType>
+void LocalFile<KeyType, ValueType>::UnmapBlockFiles() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  size_t block_length = block_size_ * element_size_ * sizeof(ValueType);
+  for (auto &mapped_block : mapped_blocks_) {
+    if (mapped_block != nullptr) {
+      (void)munmap(mapped_block, block_length);
+      mapped_block = nullptr;
+    }
   }
+#endif
+  mapped_blocks_.clear();
 }
 
 template <typename KeyType, typename ValueType>
@@ -34,6 +34,8 @@ namespace distributed {
 namespace storage {
 // The default maximum block length : 128MB.
 constexpr size_t DEFAULT_MAX_BLOCK_LENGTH = 128 << 20;
+// The default number of coalesced ranges prefetched ahead when reading key-value pairs.
+constexpr size_t DEFAULT_READ_QUEUE_DEPTH = 8;
 
 // File type persistence storage implementation class.
 template <typename KeyType = int32_t, typename ValueType = float>
@@ -71,6 +73,9 @@ class LocalFile : public StorageBase<KeyType, ValueType> {
   void Read(const std::vector<OutputData> &outputs) override;
 
   // Read key-value pairs' values data from local file storage.
+  // The locations of the keys are sorted by (block, offset) and the adjacent ones are coalesced into contiguous ranges.
+  // If the block files are memory mapped, the ranges ahead are prefetched asynchronously (at most `read_queue_depth_`
+  // ranges in flight) while the values of current range are copied, otherwise each range is read by one PRead.
   // Parameter[in] `keys`: The keys whose values need to read, containing data pointer and data buffer length.
   // Parameter[out] `values`: The values corresponding to keys need to read, containing data pointer and data buffer
   // length.
@@ -93,6 +98,26 @@ class LocalFile : public StorageBase<KeyType, ValueType> {
   // Load file list info of block files and block meta files in the 'file_path_' to block list and block meta list.
   bool LoadBlocksInfo();
 
+  // A contiguous byte range [begin, end) in a block file, which holds the values of locations [first, last) of the
+  // sorted read locations.
+  struct ReadRange {
+    size_t block_index;
+    size_t begin;
+    size_t end;
+    size_t first;
+    size_t last;
+  };
+
+  // Get the memory mapped address of the block file, map the block file at the first time. Return nullptr if the block
+  // file can not be mapped, the caller should fall back to PRead.
+  const char *GetMappedBlock(size_t block_index);
+
+  // Advise the kernel to read the range of a mapped block file asynchronously.
+  void Prefetch(const char *mapped_block, const ReadRange &range) const;
+
+  // Unmap all the memory mapped block files.
+  void UnmapBlockFiles();
+
   // The local file is composed of many block files, and each block file corresponds to a Block object in memory.
   std::vector<std::shared_ptr<Block>> block_list_;
 
@@ -129,6 +154,15 @@ class LocalFile : public StorageBase<KeyType, ValueType> {
 
   // Record latest used position in latest created block file.
   size_t current_offset_in_block_{0};
+
+  // Whether to read the values of key-value pairs through the memory mapped block files.
+  bool enable_mmap_read_{true};
+
+  // The number of coalesced ranges which are prefetched ahead of the copying.
+  size_t read_queue_depth_{DEFAULT_READ_QUEUE_DEPTH};
+
+  // The memory mapped address of each block file, nullptr means the block file has not been mapped yet.
+  std::vector<char *> mapped_blocks_;
 };
 }  // namespace storage
 }  // namespace distributed
@@ -16,6 +16,8 @@
 
 #include "distributed/rpc/tcp/connection.h"
 
+#include <linux/errqueue.h>
+#include <sys/socket.h>
 #include <memory>
 #include <utility>
 
@@ -53,6 +55,18 @@ void SocketEventHandler(int fd, uint32_t events, void *context) {
     }
     return;
   }
+  // The completions of the zero copy sends are reported through the error queue of the socket, which raises EPOLLERR
+  // as well. It is a real error only if the socket has an error pending after the completions are read.
+  if ((events & EPOLLERR) > 0 && conn->zero_copy_enabled) {
+    auto conn_mutex = conn->conn_mutex;
+    std::lock_guard<std::mutex> lock(*conn_mutex);
+    int so_error = 0;
+    socklen_t len = sizeof(so_error);
+    if (conn->ReapZeroCopyCompletions() && getsockopt(fd, SOL_SOCKET, SO_ERROR, &so_error, &len) == 0 &&
+        so_error == 0) {
+      events &= ~static_cast<uint32_t>(EPOLLERR);
+    }
+  }
   // Handle write event.
   if ((events & EPOLLOUT) > 0) {
     (void)conn->recv_event_loop->UpdateEpollEvent(fd, EPOLLIN | EPOLLHUP | EPOLLERR);
@@ -255,6 +269,12 @@ void Connection::Close() {
     send_message = nullptr;
   }
 
+  // The sending is over, so the bodies waiting for the zero copy completions can be released.
+  while (!zero_copy_pending.empty()) {
+    ReleaseSendMessage(zero_copy_pending.front().second);
+    zero_copy_pending.pop_front();
+  }
+
   MessageBase *tmpMsg = nullptr;
   while (!send_message_queue.empty()) {
     tmpMsg = send_message_queue.front();
@@ -392,6 +412,8 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
       total_send_len =
         UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() + real_data_size;
       send_message = msg;
+      send_zero_copy = zero_copy_enabled && zero_copy_threshold > 0 && real_data_size >= zero_copy_threshold;
+      send_zero_copy_issued = false;
 
       // update metrics
       send_metrics->UpdateMax(real_data_size);
@@ -417,6 +439,8 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
     send_kernel_msg.msg_iovlen = index;
     total_send_len = UlongToUint(real_data_size);
     send_message = msg;
+    send_zero_copy = false;
+    send_zero_copy_issued = false;
 
     // update metrics
     send_metrics->UpdateMax(real_data_size);
@@ -449,6 +473,12 @@ void Connection::FillRecvMessage() {
 
   if (allocate_cb_) {
     void *allocated_mem = allocate_cb_(recvBodyLen);
+    if (allocated_mem == nullptr && recvBodyLen != 0) {
+      MS_LOG(ERROR) << "Failed to allocate " << recvBodyLen << " bytes for the message from " << destination;
+      delete msg;
+      state = ConnectionState::kDisconnecting;
+      return;
+    }
     msg->data = allocated_mem;
     msg->size = recvBodyLen;
   } else {
@@ -500,10 +530,12 @@ size_t Connection::Flush() {
         output_buffer_size -= real_data_size;
         total_send_bytes += real_data_size;
 
-        if (!FreeMessageMemory(send_message)) {
-          MS_LOG(ERROR) << "Failed to free memory of the send message.";
+        if (send_zero_copy_issued) {
+          // The kernel still reads the body until the completion of the last zero copy send is reported.
+          (void)zero_copy_pending.emplace_back(zero_copy_next_id - 1, send_message);
+        } else {
+          ReleaseSendMessage(send_message);
         }
-        delete send_message;
         send_message = nullptr;
         break;
       }
@@ -635,6 +667,72 @@ bool Connection::FreeMessageMemory(MessageBase *msg) {
   return true;
 }
 
+void Connection::EnableZeroCopy(size_t threshold) {
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+  int enable = 1;
+  if (setsockopt(socket_fd, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) != 0) {
+    MS_LOG(WARNING) << "Failed to enable zero copy for fd: " << socket_fd << ", errno: " << errno << " "
+                    << strerror(errno) << ". The messages to " << destination << " are copied into the kernel.";
+    return;
+  }
+  zero_copy_enabled = true;
+  zero_copy_threshold = threshold;
+#else
+  MS_LOG(WARNING) << "Zero copy is not supported on this platform, the messages are copied into the kernel.";
+#endif
+}
+
+bool Connection::ReapZeroCopyCompletions() {
+  bool reaped = false;
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+  constexpr size_t kControlLen = 128;
+  char control[kControlLen];
+  while (true) {
+    struct msghdr msg = {};
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    // Returns EAGAIN once the error queue is empty.
+    if (recvmsg(socket_fd, &msg, MSG_ERRQUEUE) < 0) {
+      break;
+    }
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (!(cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) &&
+          !(cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+        continue;
+      }
+      auto *err = reinterpret_cast<struct sock_extended_err *>(CMSG_DATA(cmsg));
+      if (err->ee_errno != 0 || err->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+      reaped = true;
+      // The kernel had to copy the data anyway(eg. over the loopback), pinning the pages only costs more.
+      if ((err->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0 && zero_copy_threshold > 0) {
+        MS_LOG(INFO) << "The zero copy sends to " << destination << " are copied by the kernel, stop using zero copy.";
+        zero_copy_threshold = 0;
+      }
+      // The completions of the sends from ee_info to ee_data are reported.
+      ReleaseZeroCopyMessages(err->ee_data);
+    }
+  }
+#endif
+  return reaped;
+}
+
+void Connection::ReleaseZeroCopyMessages(uint32_t last_id) {
+  // The ids wrap around, so compare them by the distance.
+  while (!zero_copy_pending.empty() && static_cast<int32_t>(last_id - zero_copy_pending.front().first) >= 0) {
+    ReleaseSendMessage(zero_copy_pending.front().second);
+    zero_copy_pending.pop_front();
+  }
+}
+
+void Connection::ReleaseSendMessage(MessageBase *msg) {
+  if (!FreeMessageMemory(msg)) {
+    MS_LOG(ERROR) << "Failed to free memory of the send message.";
+  }
+  delete msg;
+}
+
 void *Connection::GetMessageBaseRealData(const MessageBase *msg) const {
   MS_ERROR_IF_NULL_W_RET_VAL(msg, nullptr);
   // The 'data' attribute is preferred.
@@ -17,10 +17,12 @@
 #ifndef MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_CONNECTION_H_
 #define MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_CONNECTION_H_
 
+#include <deque>
 #include <queue>
 #include <string>
 #include <mutex>
 #include <memory>
+#include <utility>
 
 #include "actor/msg.h"
 #include "include/backend/distributed/rpc/tcp/constants.h"
@@ -139,6 +141,20 @@ struct Connection {
    */
   bool FreeMessageMemory(MessageBase *msg);
 
+  /**
+   * @description: Send the message bodies no smaller than the threshold with MSG_ZEROCOPY. Only for tcp connections.
+   * @param {size_t} threshold: The minimum body size in bytes to be sent without copying.
+   * @return {void}
+   */
+  void EnableZeroCopy(size_t threshold);
+
+  /**
+   * @description: Read the completions of the zero copy sends from the error queue of the socket, and release the
+   * messages whose bodies are no longer referenced by the kernel.
+   * @return {bool}: Whether any completion is read.
+   */
+  bool ReapZeroCopyCompletions();
+
   // The socket used by this connection.
   int socket_fd;
 
@@ -235,6 +251,23 @@ struct Connection {
   // The method used to free the memory after client sending data to the remote.
   MemFreeCallback free_cb_;
 
+  // Whether the socket accepts MSG_ZEROCOPY, and the minimum body size to use it.
+  bool zero_copy_enabled{false};
+  size_t zero_copy_threshold{0};
+
+  // Whether the body of the message being sent goes with MSG_ZEROCOPY.
+  bool send_zero_copy{false};
+
+  // Whether any part of the message being sent has actually gone out with MSG_ZEROCOPY. A message whose zero copy
+  // sends all fell back to copying is not referenced by the kernel, and no completion will be reported for it.
+  bool send_zero_copy_issued{false};
+
+  // The id of the next zero copy send, which is counted by the kernel for every successful sendmsg with MSG_ZEROCOPY.
+  uint32_t zero_copy_next_id{0};
+
+  // The messages sent out but still referenced by the kernel, with the id of their last zero copy send.
+  std::deque<std::pair<uint32_t, MessageBase *>> zero_copy_pending;
+
  private:
   // Add handler for socket connect event.
   int AddConnnectEventHandler();
@@ -265,6 +298,12 @@ struct Connection {
    */
   size_t GetMessageBaseRealDataSize(const MessageBase *msg) const;
 
+  // Free the data through the free callback and delete the message which has been sent.
+  void ReleaseSendMessage(MessageBase *msg);
+
+  // Release the zero copy messages whose last send id is no later than the given one.
+  void ReleaseZeroCopyMessages(uint32_t last_id);
+
   std::string advertise_addr_;
 };
 }  // namespace rpc
@@ -16,6 +16,8 @@
 
 #include "distributed/rpc/tcp/tcp_comm.h"
 
+#include <algorithm>
+#include <functional>
 #include <mutex>
 #include <utility>
 #include <memory>
@@ -27,6 +29,21 @@
 namespace mindspore {
 namespace distributed {
 namespace rpc {
+namespace {
+size_t GetSizeFromEnv(const char *env, size_t default_value) {
+  std::string value = common::GetEnv(env);
+  if (value.empty()) {
+    return default_value;
+  }
+  try {
+    return std::stoul(value);
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Invalid value of " << env << ": " << value << ", use the default value " << default_value;
+    return default_value;
+  }
+}
+}  // namespace
+
 void DoDisconnect(int fd, Connection *conn, uint32_t error, int soError) {
   if (conn == nullptr) {
     return;
@@ -91,7 +108,7 @@ void OnAccept(int server, uint32_t events, void *arg) {
   if (tcpmgr == nullptr || tcpmgr->conn_pool_ == nullptr) {
     return;
   }
-  if (tcpmgr->recv_event_loop_ == nullptr) {
+  if (tcpmgr->recv_event_loops_.empty()) {
     MS_LOG(ERROR) << "EventLoop is null, server fd: " << server << ", events: " << events;
     return;
   }
@@ -133,10 +150,8 @@ void OnAccept(int server, uint32_t events, void *arg) {
   conn->peer = conn->destination;
 
   conn->is_remote = true;
-  conn->recv_event_loop = tcpmgr->recv_event_loop_;
-  conn->send_event_loop = tcpmgr->send_event_loop_;
+  tcpmgr->AssignEventLoops(conn, conn->destination);
 
-  conn->conn_mutex = tcpmgr->conn_mutex_;
   conn->message_handler = tcpmgr->message_handler_;
 
   conn->event_callback = std::bind(&TCPComm::EventCallBack, tcpmgr, std::placeholders::_1);
@@ -170,40 +185,74 @@ bool TCPComm::Initialize() {
   conn_mutex_ = std::make_shared<std::mutex>();
   MS_EXCEPTION_IF_NULL(conn_mutex_);
 
-  recv_event_loop_ = new (std::nothrow) EventLoop();
-  if (recv_event_loop_ == nullptr) {
-    MS_LOG(ERROR) << "Failed to create recv evLoop.";
-    return false;
+  size_t event_loop_num = std::min(std::max(GetSizeFromEnv(kEnvEventLoopNum, kDefaultEventLoopNum), size_t(1)),
+                                   kMaxEventLoopNum);
+  for (size_t i = 0; i < event_loop_num; ++i) {
+    if (!CreateEventLoop(TCP_RECV_EVLOOP_THREADNAME, &recv_event_loops_) ||
+        !CreateEventLoop(TCP_SEND_EVLOOP_THREADNAME, &send_event_loops_)) {
+      ReleaseEventLoops();
+      return false;
+    }
   }
 
-  bool ok = recv_event_loop_->Initialize(TCP_RECV_EVLOOP_THREADNAME);
-  if (!ok) {
-    MS_LOG(ERROR) << "Failed to init recv evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    return false;
-  }
+  zero_copy_threshold_ = enable_ssl_ ? 0 : GetSizeFromEnv(kEnvZeroCopyThreshold, 0);
+  MS_LOG(INFO) << "Tcp comm runs " << event_loop_num << " pairs of event loops, zero copy threshold is "
+               << zero_copy_threshold_ << " bytes.";
+  return true;
+}
 
-  send_event_loop_ = new (std::nothrow) EventLoop();
-  if (send_event_loop_ == nullptr) {
-    MS_LOG(ERROR) << "Failed to create send evLoop.";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
+bool TCPComm::CreateEventLoop(const std::string &thread_name, std::vector<EventLoop *> *event_loops) {
+  MS_EXCEPTION_IF_NULL(event_loops);
+  EventLoop *event_loop = new (std::nothrow) EventLoop();
+  if (event_loop == nullptr) {
+    MS_LOG(ERROR) << "Failed to create " << thread_name;
     return false;
   }
-  ok = send_event_loop_->Initialize(TCP_SEND_EVLOOP_THREADNAME);
-  if (!ok) {
-    MS_LOG(ERROR) << "Failed to init send evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
+  if (!event_loop->Initialize(thread_name)) {
+    MS_LOG(ERROR) << "Failed to init " << thread_name;
+    delete event_loop;
     return false;
   }
-
+  event_loops->push_back(event_loop);
   return true;
 }
 
+void TCPComm::ReleaseEventLoops() {
+  for (auto *event_loops : {&send_event_loops_, &recv_event_loops_}) {
+    for (auto event_loop : *event_loops) {
+      event_loop->Finalize();
+      delete event_loop;
+    }
+    event_loops->clear();
+  }
+}
+
+size_t TCPComm::RemainingTaskNum() {
+  size_t task_num = 0;
+  for (auto *event_loops : {&send_event_loops_, &recv_event_loops_}) {
+    for (auto event_loop : *event_loops) {
+      task_num += event_loop->RemainingTaskNum();
+    }
+  }
+  return task_num;
+}
+
+size_t TCPComm::EventLoopIndex(const std::string &peer) const {
+  MS_EXCEPTION_IF_CHECK_FAIL(!send_event_loops_.empty(), "The event loops of the tcp comm are not initialized.");
+  return std::hash<std::string>()(peer) % send_event_loops_.size();
+}
+
+void TCPComm::AssignEventLoops(Connection *conn, const std::string &peer) {
+  MS_EXCEPTION_IF_NULL(conn);
+  size_t index = EventLoopIndex(peer);
+  conn->recv_event_loop = recv_event_loops_[index];
+  conn->send_event_loop = send_event_loops_[index];
+  conn->conn_mutex = std::make_shared<std::mutex>();
+  if (!enable_ssl_ && zero_copy_threshold_ > 0 && conn->socket_fd >= 0) {
+    conn->EnableZeroCopy(zero_copy_threshold_);
+  }
+}
+
 int TCPComm::StartServerSocket(const std::string &url, const MemAllocateCallback &allocate_cb) {
   server_fd_ = SocketOperation::Listen(url);
   if (server_fd_ < 0) {
@@ -221,7 +270,7 @@ int TCPComm::StartServerSocket(const std::string &url, const MemAllocateCallback
   }
 
   // Register read event callback for server socket
-  int retval = recv_event_loop_->SetEventHandler(server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
+  int retval = recv_event_loops_[0]->SetEventHandler(server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
                                                  reinterpret_cast<void *>(this));
   if (retval != RPC_OK) {
     MS_LOG(ERROR) << "Failed to add server event, url: " << url.c_str();
@@ -277,6 +326,9 @@ void TCPComm::EventCallBack(void *connection) {
     }
     MS_LOG(INFO) << "The connection state is kDisconnecting. Start disconnecting from " << conn->source << " to "
                  << conn->destination;
+    // Wait for the sending on the connection in the send event loop.
+    auto conn_mutex = current_conn != nullptr ? current_conn->conn_mutex : conn->conn_mutex;
+    std::lock_guard<std::mutex> conn_lock(*conn_mutex);
     conn_pool_->DeleteConnection(conn->destination);
   }
 }
@@ -358,7 +410,7 @@ bool TCPComm::Send(MessageBase *msg, size_t *const send_bytes, bool sync) {
     return false;
   }
   auto task = [msg, send_bytes, this] {
-    std::lock_guard<std::mutex> lock(*conn_mutex_);
+    std::unique_lock<std::mutex> lock(*conn_mutex_);
     // Search connection by the target address
     std::string destination = msg->to.Url();
     Connection *conn = conn_pool_->FindConnection(destination);
@@ -391,6 +443,10 @@ bool TCPComm::Send(MessageBase *msg, size_t *const send_bytes, bool sync) {
       return false;
     }
 
+    // Only the connection is locked during sending, the other connections are free to go.
+    auto conn_mutex = conn->conn_mutex;
+    std::lock_guard<std::mutex> conn_lock(*conn_mutex);
+    lock.unlock();
     if (conn->total_send_len == 0) {
       conn->FillSendMessage(msg, url_, false);
     } else {
@@ -405,7 +461,7 @@ bool TCPComm::Send(MessageBase *msg, size_t *const send_bytes, bool sync) {
   if (sync) {
     return task();
   } else {
-    send_event_loop_->AddTask(task);
+    send_event_loops_[EventLoopIndex(msg->to.Url())]->AddTask(task);
     return true;
   }
 }
@@ -441,9 +497,6 @@ bool TCPComm::Connect(const std::string &dst_url, const MemFreeCallback &free_cb
       return false;
     }
     conn->enable_ssl = enable_ssl_;
-    conn->recv_event_loop = this->recv_event_loop_;
-    conn->send_event_loop = this->send_event_loop_;
-    conn->conn_mutex = conn_mutex_;
     conn->message_handler = message_handler_;
     conn->InitSocketOperation();
 
@@ -460,6 +513,7 @@ bool TCPComm::Connect(const std::string &dst_url, const MemFreeCallback &free_cb
     }
 
     conn->socket_fd = sock_fd;
+    AssignEventLoops(conn, dst_url);
     conn->event_callback = std::bind(&TCPComm::EventCallBack, this, std::placeholders::_1);
     conn->write_callback = std::bind(&TCPComm::WriteCallBack, this, std::placeholders::_1);
     conn->read_callback = std::bind(&TCPComm::ReadCallBack, this, std::placeholders::_1);
@@ -514,16 +568,14 @@ bool TCPComm::IsConnected(const std::string &dst_url) {
 bool TCPComm::Disconnect(const std::string &dst_url) {
   MS_EXCEPTION_IF_NULL(conn_mutex_);
   MS_EXCEPTION_IF_NULL(conn_pool_);
-  MS_EXCEPTION_IF_NULL(recv_event_loop_);
-  MS_EXCEPTION_IF_NULL(send_event_loop_);
 
   unsigned int interval = 100000;
   size_t retry = 30;
-  while (recv_event_loop_->RemainingTaskNum() != 0 && send_event_loop_->RemainingTaskNum() != 0 && retry > 0) {
+  while (RemainingTaskNum() != 0 && retry > 0) {
     (void)usleep(interval);
     retry--;
   }
-  if (recv_event_loop_->RemainingTaskNum() > 0 || send_event_loop_->RemainingTaskNum() > 0) {
+  if (RemainingTaskNum() > 0) {
     MS_LOG(ERROR) << "Failed to disconnect from url " << dst_url
                   << ", because there are still pending tasks to be executed, please try later.";
     return false;
@@ -531,6 +583,8 @@ bool TCPComm::Disconnect(const std::string &dst_url) {
   std::lock_guard<std::mutex> lock(*conn_mutex_);
   auto conn = conn_pool_->FindConnection(dst_url);
   if (conn != nullptr) {
+    auto conn_mutex = conn->conn_mutex;
+    std::lock_guard<std::mutex> send_lock(*conn_mutex);
     std::lock_guard<std::mutex> conn_lock(conn->conn_owned_mutex_);
     conn_pool_->DeleteConnection(dst_url);
   }
@@ -546,28 +600,15 @@ Connection *TCPComm::CreateDefaultConn(const std::string &to) {
   conn->enable_ssl = enable_ssl_;
   conn->source = url_.data();
   conn->destination = to;
-  conn->recv_event_loop = this->recv_event_loop_;
-  conn->send_event_loop = this->send_event_loop_;
-  conn->conn_mutex = conn_mutex_;
+  AssignEventLoops(conn, to);
   conn->message_handler = message_handler_;
   conn->InitSocketOperation();
   return conn;
 }
 
 void TCPComm::Finalize() {
-  if (send_event_loop_ != nullptr) {
-    MS_LOG(INFO) << "Delete send event loop";
-    send_event_loop_->Finalize();
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
-  }
-
-  if (recv_event_loop_ != nullptr) {
-    MS_LOG(INFO) << "Delete recv event loop";
-    recv_event_loop_->Finalize();
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-  }
+  MS_LOG(INFO) << "Delete send and recv event loops";
+  ReleaseEventLoops();
 
   if (server_fd_ > 0) {
     if (close(server_fd_) != 0) {
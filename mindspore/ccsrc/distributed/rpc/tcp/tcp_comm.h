@@ -21,6 +21,7 @@
 #include <string>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "actor/msg.h"
 #include "distributed/rpc/tcp/connection.h"
@@ -40,7 +41,7 @@ void ConnectedEventHandler(int fd, uint32_t events, void *context);
 class TCPComm {
  public:
   explicit TCPComm(bool enable_ssl = false)
-      : server_fd_(-1), recv_event_loop_(nullptr), send_event_loop_(nullptr), enable_ssl_(enable_ssl) {}
+      : server_fd_(-1), zero_copy_threshold_(0), enable_ssl_(enable_ssl) {}
   TCPComm(const TCPComm &) = delete;
   TCPComm &operator=(const TCPComm &) = delete;
   ~TCPComm() = default;
@@ -100,6 +101,20 @@ class TCPComm {
 
   static void DropMessage(MessageBase *msg);
 
+  // Create an event loop thread and append it to the given list.
+  static bool CreateEventLoop(const std::string &thread_name, std::vector<EventLoop *> *event_loops);
+
+  // Stop and delete all the event loops.
+  void ReleaseEventLoops();
+
+  // The number of tasks not executed yet in all the event loops.
+  size_t RemainingTaskNum();
+
+  // Bind the connection to the event loops chosen by the hash of the peer address, and set the lock and the zero copy
+  // of it. All the messages to the same peer are sent in the same event loop, so the order of them is kept.
+  void AssignEventLoops(Connection *conn, const std::string &peer);
+  size_t EventLoopIndex(const std::string &peer) const;
+
   // Read and write events.
   void ReadCallBack(void *conn);
   void WriteCallBack(void *conn);
@@ -115,16 +130,20 @@ class TCPComm {
   // User defined handler for Handling received messages.
   MessageHandler message_handler_;
 
-  // All the connections share the same read and write event loop objects.
-  EventLoop *recv_event_loop_;
-  EventLoop *send_event_loop_;
+  // The read and write event loops, every connection is handled by a pair of them with the same index.
+  std::vector<EventLoop *> recv_event_loops_;
+  std::vector<EventLoop *> send_event_loops_;
 
   // The connection pool used to store new connections.
   std::shared_ptr<ConnectionPool> conn_pool_;
 
-  // The mutex for connection operations.
+  // The mutex for the connection pool operations(eg. connect, disconnect and looking up). Every connection has a
+  // mutex of its own for sending and receiving, so the connections in different event loops don't block each other.
   std::shared_ptr<std::mutex> conn_mutex_;
 
+  // The minimum size of the message body sent with zero copy, 0 means disabled.
+  size_t zero_copy_threshold_;
+
   // The method used to allocate memory when tcp servers of this TcpComm receive message from the remote.
   MemAllocateCallback allocate_cb_;
 
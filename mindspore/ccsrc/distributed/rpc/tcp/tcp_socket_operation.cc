@@ -125,7 +125,35 @@ int TCPSocketOperation::SendMessage(Connection *connection, struct msghdr *sendM
   *sendLen = 0;
 
   while (*sendLen != totalSendLen) {
-    auto retval = sendmsg(connection->socket_fd, sendMsg, MSG_NOSIGNAL);
+    // Skip the parts which have been sent out.
+    while (sendMsg->msg_iovlen > 1 && sendMsg->msg_iov[0].iov_len == 0) {
+      ++sendMsg->msg_iov;
+      --sendMsg->msg_iovlen;
+    }
+    int flags = MSG_NOSIGNAL;
+    size_t iovlen = sendMsg->msg_iovlen;
+#ifdef MSG_ZEROCOPY
+    // Only the body is sent with zero copy. The header parts are owned by the connection and reused by the next
+    // message, so they are copied by a send of their own, which is coalesced with the body by MSG_MORE.
+    bool zero_copy = connection->send_zero_copy && iovlen == 1;
+    if (connection->send_zero_copy && iovlen > 1) {
+      sendMsg->msg_iovlen = iovlen - 1;
+      flags |= MSG_MORE;
+    } else if (zero_copy) {
+      flags |= MSG_ZEROCOPY;
+    }
+#endif
+    auto retval = sendmsg(connection->socket_fd, sendMsg, flags);
+    sendMsg->msg_iovlen = iovlen;
+#ifdef MSG_ZEROCOPY
+    if (zero_copy && retval < 0 && errno == ENOBUFS) {
+      // Out of the socket option memory for pinning the pages, fall back to copying this time.
+      retval = sendmsg(connection->socket_fd, sendMsg, MSG_NOSIGNAL);
+    } else if (zero_copy && retval >= 0) {
+      ++connection->zero_copy_next_id;
+      connection->send_zero_copy_issued = true;
+    }
+#endif
     if (retval < 0) {
       ++eagainCount;
       if (errno != EAGAIN) {
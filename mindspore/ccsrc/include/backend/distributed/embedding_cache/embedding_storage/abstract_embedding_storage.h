@@ -29,6 +29,22 @@ namespace storage {
 using mindspore::device::DeviceAddress;
 constexpr size_t kDefaultSliceSizeInMB = 1024;
 
+/**
+ * @brief The statistics of the host cache of an embedding storage.
+ */
+struct EmbeddingCacheStatistics {
+  // The number of keys hit and missed in the host cache.
+  size_t hit_count{0};
+  size_t miss_count{0};
+  // The number of elements evicted from the host cache to the persistent storage.
+  size_t evicted_count{0};
+
+  double hit_rate() const {
+    size_t total = hit_count + miss_count;
+    return total == 0 ? 0.0 : static_cast<double>(hit_count) / static_cast<double>(total);
+  }
+};
+
 /**
  * @brief AbstractEmbeddingStorage is encapsulated within the Huge Embedding Table's lookup and update interface. It
  * supports embeddingstorage query and modification of Embeddings, interaction between the host cache(for hot spot data)
@@ -92,6 +108,12 @@ class AbstractEmbeddingStorage {
    */
   virtual std::vector<std::shared_ptr<std::vector<char>>> ExportSlice(
     bool incremental, bool *last_slice, size_t slice_size_in_mega_bytes = kDefaultSliceSizeInMB) = 0;
+
+  /**
+   * @brief Get the hit, miss and eviction statistics of the host cache.
+   * @return The statistics of the host cache.
+   */
+  virtual EmbeddingCacheStatistics GetCacheStatistics() const = 0;
 };
 }  // namespace storage
 }  // namespace distributed
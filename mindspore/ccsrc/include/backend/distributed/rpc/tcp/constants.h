@@ -88,6 +88,16 @@ constexpr int IP_LEN_MAX = 128;
 constexpr char kEnvReceiveMsgTimeOut[] = "MS_RECEIVE_MSG_TIMEOUT";
 static const size_t kDefaultReceiveMsgTimeOut = 300;
 
+// The number of event loop threads for receiving and for sending of every tcp comm, the connections are spread over
+// them by the hash of the peer address. Default: 1.
+constexpr char kEnvEventLoopNum[] = "MS_RPC_EVENT_LOOP_NUM";
+static const size_t kDefaultEventLoopNum = 1;
+static const size_t kMaxEventLoopNum = 64;
+
+// The message bodies no smaller than this size(bytes) are sent with MSG_ZEROCOPY, 0 disables zero copy. The body is
+// handed back to the free callback only after the kernel reports the transmission is done. Default: 0.
+constexpr char kEnvZeroCopyThreshold[] = "MS_RPC_ZERO_COPY_THRESHOLD";
+
 // Kill the process for safe exiting.
 inline void KillProcess(const std::string &ret) {
   MS_LOG(ERROR) << ret;
@@ -18,6 +18,8 @@
 #define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_ALLOCATOR_H_
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <functional>
 #include <list>
 #include <map>
@@ -52,6 +54,12 @@ constexpr int kAllocatorTypeNum = 6;
 constexpr size_t kDynamicMemAlignSize = 512;
 // The minimum unit size (1G) of memory block used for dynamic extend.
 constexpr size_t kDynamicMemAllocUnitSize = 1024 << 20;
+// The mem bufs of the common pool no larger than this size are served by the thread caches.
+constexpr size_t kThreadCacheMaxBufSize = 64 << 10;
+// The upper bound of the total size of the mem bufs held by one thread cache.
+constexpr size_t kThreadCacheMaxSize = 4 << 20;
+// The upper bound of the count of the mem bufs held by one bin of a thread cache.
+constexpr size_t kThreadCacheBinCapacity = 64;
 
 // The Comparator of device address from small to large.
 using DeviceMemPtr = void(*);
@@ -75,6 +83,15 @@ using DynamicMemBlockPtr = std::shared_ptr<DynamicMemBlock>;
 struct MemStatusManager;
 using MemStatusManagerPtr = std::shared_ptr<MemStatusManager>;
 
+// The per thread cache of the small mem bufs in front of the common pool.
+class ThreadMemCache;
+using ThreadMemCachePtr = std::shared_ptr<ThreadMemCache>;
+#ifdef __APPLE__
+using ThreadCacheLock = SpinLock;
+#else
+using ThreadCacheLock = std::mutex;
+#endif
+
 // pair has no hash method, need override it.
 struct pair_hash {
   template <class L, class R>
@@ -142,6 +159,8 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   void DumpDynamicMemPoolDebugInfo();
 
   void DefragMemory();
+  // Return the mem bufs held by the thread caches of all the threads to the pool.
+  void FlushThreadCaches();
 
   // The related interface of device memory real operation, needs override by device type.
   virtual size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) = 0;
@@ -176,6 +195,9 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   virtual const bool IsEnableEagerFree() const { return false; }
   const bool IsEnableVmm() const { return enable_vmm_; }
   void SetEnableVmm(bool enable_vmm) { enable_vmm_ = enable_vmm; }
+  // The small mem bufs of the common pool on the default stream are cached by every thread when enabled.
+  bool IsEnableThreadCache() const { return enable_thread_cache_; }
+  void SetEnableThreadCache(bool enable_thread_cache) { enable_thread_cache_ = enable_thread_cache; }
   virtual const bool SyncAllStreams() { return false; }
   virtual size_t AllocDeviceMemByEagerFree(size_t size, DeviceMemPtr *addr) { return 0; }
   virtual size_t FreeDeviceMemByEagerFree(const DeviceMemPtr addr, const size_t size) { return 0; }
@@ -185,6 +207,8 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
 
  private:
 #endif
+  // Alloc memory from the best fit pools without the thread caches.
+  DeviceMemPtr AllocTensorMemFromPool(size_t size, bool from_persistent_mem, bool need_recycle, uint32_t stream_id);
   // Find available memory buf from total pools by status, which contains idle and eager free.
   DeviceMemPtr FindAvailableMemBuf(size_t size, bool from_persistent_mem, uint32_t stream_id);
   // Find the target status memory buf from total pools by aligned size when memory alloc.
@@ -232,6 +256,32 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   DynamicMemBufPtr FindMemBufByKeepAddr(const DeviceMemPtr &device_addr, const DynamicMemBlockPtr &mem_block) const;
   // Sync all events inner without lock.
   bool SyncAllEventsInner();
+  // Update the peak size after the used size of the pool increased, the caller need lock.
+  void UpdatePeakSize(const MemStatusManagerPtr &mem_mng);
+  // Publish the used size of the common pool to the thread caches, the caller need lock.
+  void PublishCommonUsedSize();
+
+  // Whether the alloc can be served by the thread caches, which are bypassed when every alloc has to be recorded.
+  bool IsThreadCacheAvailable() const;
+  // Get the thread cache of the current thread, which is created and registered at the first time.
+  ThreadMemCache *GetThreadCache();
+  // Alloc the aligned size from the thread cache, which is refilled from the pool in batch when empty.
+  DeviceMemPtr AllocTensorMemFromThreadCache(size_t size);
+  DeviceMemPtr RefillThreadCache(ThreadMemCache *cache, size_t size);
+  // Free the mem buf allocated by the thread caches into the thread cache of the current thread.
+  void FreeTensorMemToThreadCache(const DeviceMemPtr &device_addr, size_t size);
+  // Return the mem bufs of the thread cache over its bounds to the pool.
+  void FlushThreadCache(ThreadMemCache *cache);
+  // Return the mem bufs taken out of the thread caches to the pool, the caller need lock.
+  void ReturnThreadCacheBufs(const std::vector<std::pair<DeviceMemPtr, size_t>> &bufs);
+  // Return the mem bufs held by the thread caches to the pool, the caller need lock.
+  void DrainThreadCaches(bool orphaned_only);
+  // Record and remove the mem buf handed out by the thread caches, the size is 0 if not handed out by them.
+  void AddThreadCacheBuf(const DeviceMemPtr &device_addr, size_t size);
+  size_t TakeThreadCacheBuf(const DeviceMemPtr &device_addr);
+  // Update the peak size after the used size increased by the thread caches without lock.
+  void UpdateThreadCachePeakSize();
+  static uint64_t NextPoolId();
 
 #ifdef __APPLE__
   // There are some problems with using mutex on Mac, use spinlocks instead.
@@ -254,6 +304,54 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   bool enable_vmm_{false};
   size_t eager_free_count_{0};
   size_t last_eager_free_count_{0};
+
+  // The thread caches are looked up by the id of the pool, since the address of a pool may be reused by another one.
+  const uint64_t pool_id_{NextPoolId()};
+  bool enable_thread_cache_{false};
+  // The thread caches of all the threads, which are protected by the lock of the pool.
+  std::vector<ThreadMemCachePtr> thread_caches_;
+  // The mem bufs handed out by the thread caches and their sizes, sharded by address to spread the lock contention.
+  struct ThreadCacheBufShard {
+    ThreadCacheLock lock;
+    std::unordered_map<DeviceMemPtr, size_t> bufs;
+  };
+  static constexpr size_t kThreadCacheBufShardNum = 16;
+  std::array<ThreadCacheBufShard, kThreadCacheBufShardNum> thread_cache_buf_shards_;
+  // The mem bufs held by the thread caches are used in the view of the common pool, the statistics exclude them.
+  std::atomic<size_t> thread_cached_size_{0};
+  // The used size of the common pool including the used by event size, which is read by the thread caches.
+  std::atomic<size_t> common_used_size_{0};
+  // The used size of the common pool when the maximum allocated memory is reset.
+  mutable std::atomic<size_t> common_temp_used_size_{0};
+  // The peak sizes of the common pool reached when allocating from the thread caches.
+  std::atomic<size_t> thread_cache_peak_size_{0};
+  mutable std::atomic<size_t> thread_cache_temp_peak_size_{0};
+};
+
+// ThreadMemCache holds the idle small mem bufs of the common pool for one thread in bins of every aligned size, so most
+// of the alloc and free of the small tensors are done without the lock of the pool. The mem bufs in the cache are still
+// used in the view of the pool, and are returned to the pool in batch when the cache is over its bounds, or when the
+// pool needs them back for eager free, defrag or an alloc failure.
+class ThreadMemCache {
+ public:
+  ThreadMemCache() : bins_(kThreadCacheMaxBufSize / kDynamicMemAlignSize) {}
+  ~ThreadMemCache() = default;
+
+  // Pop a mem buf of the aligned size, return nullptr if the bin is empty.
+  DeviceMemPtr Pop(size_t size);
+  // Push the mem bufs of the aligned size, return whether the cache is over its bounds.
+  bool Push(size_t size, const std::vector<DeviceMemPtr> &addrs);
+  // Take out all the mem bufs, or the older half of the bins over the bounds.
+  void Take(bool all, std::vector<std::pair<DeviceMemPtr, size_t>> *bufs);
+  // The thread of the cache has exited, the mem bufs are left for the pool to take back.
+  void Orphan();
+  bool orphaned();
+
+ private:
+  ThreadCacheLock lock_;
+  std::vector<std::vector<DeviceMemPtr>> bins_;
+  size_t cached_size_{0};
+  bool orphaned_{false};
 };
 
 // Recording information for debugging the memory allocator.
@@ -359,9 +457,10 @@ class DynamicMemBlock {
 };
 
 struct DeviceState {
-  // Update peak size.
-  void UpdatePeakSize() {
+  // Update peak size, the cached size is the memory held by the thread caches which is counted as used.
+  void UpdatePeakSize(size_t cached_size = 0) {
     size_t total_used_size_ = total_used_mem_size_ + total_used_by_event_mem_size_;
+    total_used_size_ -= std::min(total_used_size_, cached_size);
     size_t temp_used_size_ = temp_total_used_mem_size_ + temp_total_used_by_event_mem_size_;
     used_mem_peak_size_ = std::max(used_mem_peak_size_, total_used_size_);
     if (total_used_size_ > temp_used_size_) {
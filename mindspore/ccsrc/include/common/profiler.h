@@ -94,6 +94,7 @@ enum class ProfilerEvent {
   kPyNativeDeviceTask,
   kPyNativeLaunchTask,
   kPyNativeBpropTask,
+  kWaitQueueNotFull,
   // PyNative inner Event
   kPyNativeGilAcquire,
   kPyNativeCast,
@@ -177,6 +178,7 @@ static const std::map<ProfilerEvent, std::string> kProfilerEventString = {
   {ProfilerEvent::kPyNativeDeviceTask, "DeviceTask"},
   {ProfilerEvent::kPyNativeLaunchTask, "LaunchTask"},
   {ProfilerEvent::kPyNativeBpropTask, "BpropTask"},
+  {ProfilerEvent::kWaitQueueNotFull, "WaitQueueNotFull"},
   {ProfilerEvent::kPyNativeGilAcquire, "AcquireGil"},
   {ProfilerEvent::kPyNativeCast, "PyNativeCast"},
   {ProfilerEvent::kPyNativeInfer, "PyNativeInfer"},
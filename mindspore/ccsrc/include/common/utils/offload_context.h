@@ -53,6 +53,9 @@ class COMMON_EXPORT OffloadContext {
   void set_aio_queue_depth(size_t aio_queue_depth);
   size_t aio_queue_depth() const { return aio_queue_depth_; }
 
+  void set_prefetch_kernel_num(size_t prefetch_kernel_num);
+  size_t prefetch_kernel_num() const { return prefetch_kernel_num_; }
+
   void set_enable_pinned_mem(bool enable_pinned_mem);
   bool enable_pinned_mem() const { return enable_pinned_mem_; }
 
@@ -80,6 +83,7 @@ class COMMON_EXPORT OffloadContext {
   bool enable_aio_;
   size_t aio_block_size_;
   size_t aio_queue_depth_;
+  size_t prefetch_kernel_num_;
   bool enable_pinned_mem_;
   bool auto_offload_;
   size_t host_mem_block_size_;
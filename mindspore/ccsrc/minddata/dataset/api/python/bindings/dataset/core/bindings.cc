@@ -77,6 +77,10 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_dynamic_shape", &ConfigManager::dynamic_shape)
                     .def("set_fast_recovery", &ConfigManager::set_fast_recovery)
                     .def("get_fast_recovery", &ConfigManager::fast_recovery)
+                    .def("set_first_ready_mode", &ConfigManager::set_first_ready_mode)
+                    .def("get_first_ready_mode", &ConfigManager::first_ready_mode)
+                    .def("set_zero_copy_batch", &ConfigManager::set_zero_copy_batch)
+                    .def("get_zero_copy_batch", &ConfigManager::zero_copy_batch)
                     .def("set_debug_mode", &ConfigManager::set_debug_mode)
                     .def("get_debug_mode", &ConfigManager::get_debug_mode)
                     .def("set_error_samples_mode", &ConfigManager::set_error_samples_mode)
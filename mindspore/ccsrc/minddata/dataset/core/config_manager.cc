@@ -87,6 +87,8 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_seed(j.value("seed", seed_));
   set_monitor_sampling_interval(j.value("monitorSamplingInterval", monitor_sampling_interval_));
   set_fast_recovery(j.value("fast_recovery", fast_recovery_));
+  set_first_ready_mode(j.value("first_ready_mode", first_ready_mode_));
+  set_zero_copy_batch(j.value("zero_copy_batch", zero_copy_batch_));
   set_error_samples_mode(j.value("error_samples_mode", error_samples_mode_));
   set_cache_host(j.value("cacheHost", cache_host_));
   set_cache_port(j.value("cachePort", cache_port_));
@@ -295,6 +295,27 @@ class ConfigManager {
   // @return - Flag to indicate whether md pipeline recovers fast in failover reset
   bool fast_recovery() const { return fast_recovery_; }
 
+  // setter function
+  // @notes In first ready mode, the rows are not guaranteed to be produced in the same order as in ordered mode
+  //     (System default = false)
+  // @param first_ready_mode - Set whether the parallel operations deliver whichever row is ready first instead of
+  //     preserving the row order
+  void set_first_ready_mode(const bool first_ready_mode) { first_ready_mode_ = first_ready_mode; }
+
+  // getter function
+  // @return - Flag to indicate whether the parallel operations deliver whichever row is ready first
+  bool first_ready_mode() const { return first_ready_mode_; }
+
+  // setter function
+  // @notes Only the batches without per_batch_map or padding after a map operation are written in place
+  //     (System default = false)
+  // @param zero_copy_batch - Set whether the map workers write the rows into the batch tensors directly
+  void set_zero_copy_batch(const bool zero_copy_batch) { zero_copy_batch_ = zero_copy_batch; }
+
+  // getter function
+  // @return - Flag to indicate whether the map workers write the rows into the batch tensors directly
+  bool zero_copy_batch() const { return zero_copy_batch_; }
+
   // setter function
   // @param debug_mode_flag - Set whether debug mode is on. When enabled, the dataset pipeline runs synchronously and
   //    sequentially.
@@ -354,8 +375,10 @@ class ConfigManager {
   uint32_t multiprocessing_timeout_interval_;  // Multiprocessing timeout interval in seconds
   std::string autotune_json_filepath_;         // Filepath name of the final AutoTune Configuration JSON file
   bool dynamic_shape_{false};
-  bool fast_recovery_{true};     // Used for failover scenario to recover quickly or produce same augmentations
-  bool debug_mode_flag_{false};  // Indicator for debug mode
+  bool fast_recovery_{true};      // Used for failover scenario to recover quickly or produce same augmentations
+  bool first_ready_mode_{false};  // Deliver whichever row is ready first instead of preserving the row order
+  bool zero_copy_batch_{false};   // Map workers write the rows into the batch tensors directly
+  bool debug_mode_flag_{false};   // Indicator for debug mode
   ErrorSamplesMode error_samples_mode_{ErrorSamplesMode::kReturn};  // The method to process erroneous samples
 };
 }  // namespace dataset
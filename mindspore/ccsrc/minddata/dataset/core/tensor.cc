@@ -63,7 +63,11 @@ namespace dataset {
 Tensor::Tensor(TensorShape shape, DataType type) : shape_(std::move(shape)), type_(type), data_(nullptr) {}
 
 Tensor::Tensor(Tensor &&other) noexcept
-    : shape_(std::move(other.shape_)), type_(other.type_), data_(other.data_), data_end_(other.data_end_) {
+    : shape_(std::move(other.shape_)),
+      type_(other.type_),
+      data_(other.data_),
+      data_end_(other.data_end_),
+      view_base_(std::move(other.view_base_)) {
 #ifdef ENABLE_PYTHON
   if (type_.value() == DataType::DE_PYTHON) {
     py::gil_scoped_acquire gil_acquire;
@@ -84,6 +88,7 @@ Tensor &Tensor::operator=(Tensor &&other) noexcept {
     type_ = other.type_;
     data_ = other.data_;
     data_end_ = other.data_end_;
+    view_base_ = std::move(other.view_base_);
     yuv_shape_ = std::move(other.yuv_shape_);
 #ifdef ENABLE_PYTHON
     if (type_.value() == DataType::DE_PYTHON) {
@@ -126,6 +131,27 @@ Status Tensor::CreateEmpty(const TensorShape &shape, const DataType &type, Tenso
   return Status::OK();
 }
 
+Status Tensor::CreateSliceView(const TensorPtr &base, dsize_t index, TensorPtr *out) {
+  RETURN_UNEXPECTED_IF_NULL(base);
+  RETURN_UNEXPECTED_IF_NULL(out);
+  CHECK_FAIL_RETURN_UNEXPECTED(base->type().IsNumeric(), "Failed to create slice view, base tensor is not numeric.");
+  CHECK_FAIL_RETURN_UNEXPECTED(base->Rank() > 0 && index >= 0 && index < base->shape()[0],
+                               "Failed to create slice view, index " + std::to_string(index) +
+                                 " is out of the first dimension of the base tensor.");
+  std::vector<dsize_t> dims = base->shape().AsVector();
+  (void)dims.erase(dims.begin());
+  *out = std::make_shared<Tensor>(TensorShape(dims), base->type());
+  CHECK_FAIL_RETURN_UNEXPECTED(*out != nullptr, "Failed to create slice view, allocate memory failed.");
+  dsize_t slice_size = (*out)->SizeInBytes();
+  if (slice_size != 0) {
+    // a view on a view shares the memory of the tensor which owns it.
+    (*out)->view_base_ = base->view_base_ != nullptr ? base->view_base_ : base;
+    (*out)->data_ = base->data_ + index * slice_size;
+    (*out)->data_end_ = (*out)->data_ + slice_size;
+  }
+  return Status::OK();
+}
+
 Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src, TensorPtr *out) {
   RETURN_IF_NOT_OK(CreateEmpty(shape, type, out));
   if (src != nullptr && out != nullptr) {
@@ -429,7 +455,8 @@ Tensor::~Tensor() {
   if (!static_cast<bool>(python_array_)) {  // the data is not np.ndarray from python layer
 #endif
     if (!type().IsPython()) {  // The Tensor is a python_dict_
-      if (data_ != nullptr) {
+      // the memory of a view is released by its base
+      if (data_ != nullptr && view_base_ == nullptr) {
         if (GetAllocator() != nullptr) {
           GetAllocator()->deallocate(data_);
           data_ = nullptr;
@@ -611,6 +638,7 @@ void Tensor::Invalidate() {
   type_ = DataType(DataType::DE_UNKNOWN);
   data_ = nullptr;
   data_end_ = nullptr;
+  view_base_ = nullptr;
 #ifdef ENABLE_PYTHON
   if (type_.value() == DataType::DE_PYTHON) {
     py::gil_scoped_acquire gil_acquire;
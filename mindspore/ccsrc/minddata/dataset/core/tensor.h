@@ -115,6 +115,14 @@ class DATASET_API Tensor {
     return CreateFromMemory(in->shape(), in->type(), in->GetBuffer(), in->SizeInBytes(), out);
   }
 
+  /// Create a tensor which shares the memory of the index-th element along the first dimension of the base tensor.
+  /// No data is copied, writing to the view writes to the base, and the view keeps the base alive.
+  /// \param[in] base numeric tensor to create the view on
+  /// \param[in] index index along the first dimension of the base
+  /// \param[out] out the view, its shape is the shape of the base without the first dimension
+  /// \return Status
+  static Status CreateSliceView(const TensorPtr &base, dsize_t index, TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in MSTensor to create DETensor from.
   /// \param[in] out DETensor created.
@@ -455,6 +463,10 @@ class DATASET_API Tensor {
   /// Calling this method will make the Tensor and its data inaccessible, use it with caution.
   void Invalidate();
 
+  /// Getter of the tensor this tensor is a view on
+  /// \return the base tensor, or nullptr if this tensor owns its memory
+  const TensorPtr &ViewBase() const { return view_base_; }
+
   /// Copy input tensor into self at the location index.
   /// Index is a vector of axes which can be incomplete:
   /// Ex: shape <2,3>, inserting into index {0} will replace the first row. index {1,2} will replace the last cell.
@@ -850,6 +862,8 @@ class DATASET_API Tensor {
   unsigned char *data_;
   /// pointer to the end of the physical data
   unsigned char *data_end_ = nullptr;
+  /// the tensor which owns the memory if this tensor is a view created by CreateSliceView
+  TensorPtr view_base_;
 
   /// shape for interpretation of YUV image
   std::vector<uint32_t> yuv_shape_;
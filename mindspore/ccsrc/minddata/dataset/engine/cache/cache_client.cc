@@ -23,7 +23,14 @@
 namespace mindspore {
 namespace dataset {
 CacheClient::Builder::Builder()
-    : session_id_(0), cache_mem_sz_(0), spill_(false), hostname_(""), port_(0), num_connections_(0), prefetch_size_(0) {
+    : session_id_(0),
+      cache_mem_sz_(0),
+      spill_(false),
+      compress_(false),
+      hostname_(""),
+      port_(0),
+      num_connections_(0),
+      prefetch_size_(0) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   hostname_ = cfg->cache_host();
   port_ = cfg->cache_port();
@@ -34,8 +41,8 @@ CacheClient::Builder::Builder()
 Status CacheClient::Builder::Build(std::shared_ptr<CacheClient> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
   RETURN_IF_NOT_OK(SanityCheck());
-  *out = std::make_shared<CacheClient>(session_id_, cache_mem_sz_, spill_, hostname_, port_, num_connections_,
-                                       prefetch_size_);
+  *out = std::make_shared<CacheClient>(session_id_, cache_mem_sz_, spill_, compress_, hostname_, port_,
+                                       num_connections_, prefetch_size_);
   return Status::OK();
 }
 
@@ -53,10 +60,11 @@ Status CacheClient::Builder::SanityCheck() {
 }
 
 // Constructor
-CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname,
-                         int32_t port, int32_t num_connections, int32_t prefetch_size)
+CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, bool compress,
+                         std::string hostname, int32_t port, int32_t num_connections, int32_t prefetch_size)
     : cache_mem_sz_(cache_mem_sz),
       spill_(spill),
+      compress_(compress),
       server_connection_id_(0),
       client_id_(-1),
       local_bypass_(false),
@@ -193,6 +201,9 @@ Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
     if (spill_) {
       createFlag |= CreateCacheRequest::CreateCacheFlag::kSpillToDisk;
     }
+    if (compress_) {
+      createFlag |= CreateCacheRequest::CreateCacheFlag::kCompress;
+    }
     if (generate_id) {
       createFlag |= CreateCacheRequest::CreateCacheFlag::kGenerateRowId;
     }
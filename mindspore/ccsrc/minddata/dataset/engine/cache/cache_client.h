@@ -85,6 +85,14 @@ class CacheClient {
       return *this;
     }
 
+    /// Setter function to compress attribute
+    /// \param compress Compress the rows cached by the server
+    /// \return Builder object itself
+    Builder &SetCompress(bool compress) {
+      compress_ = compress;
+      return *this;
+    }
+
     /// Setter function to set rpc hostname
     /// \param host
     /// \return Builder object itself
@@ -121,6 +129,7 @@ class CacheClient {
     session_id_type GetSessionId() const { return session_id_; }
     uint64_t GetCacheMemSz() const { return cache_mem_sz_; }
     bool isSpill() const { return spill_; }
+    bool isCompress() const { return compress_; }
     const std::string &GetHostname() const { return hostname_; }
     int32_t GetPort() const { return port_; }
     int32_t GetNumConnections() const { return num_connections_; }
@@ -134,6 +143,7 @@ class CacheClient {
     session_id_type session_id_;
     uint64_t cache_mem_sz_;
     bool spill_;
+    bool compress_;
     std::string hostname_;
     int32_t port_;
     int32_t num_connections_;
@@ -144,8 +154,9 @@ class CacheClient {
   /// \param session_id A user assigned session id for the current pipeline
   /// \param cache_mem_sz Size of the memory set aside for the row caching. 0 for unlimited
   /// \param spill Spill to disk if out of memory
-  CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname, int32_t port,
-              int32_t num_connections, int32_t prefetch_size);
+  /// \param compress Compress the rows in the cache
+  CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, bool compress, std::string hostname,
+              int32_t port, int32_t num_connections, int32_t prefetch_size);
 
   /// \brief Destructor
   ~CacheClient();
@@ -229,6 +240,7 @@ class CacheClient {
   session_id_type session_id() const { return cinfo_.session_id(); }
   uint64_t GetCacheMemSz() const { return cache_mem_sz_; }
   bool isSpill() const { return spill_; }
+  bool isCompress() const { return compress_; }
   int32_t GetNumConnections() const { return num_connections_; }
   int32_t GetPrefetchSize() const { return prefetch_size_; }
   int32_t GetClientId() const { return client_id_; }
@@ -273,6 +285,7 @@ class CacheClient {
   mutable RWLock mux_;
   uint64_t cache_mem_sz_;
   bool spill_;
+  bool compress_;
   // The session_id_ and cache_crc_ work together to uniquely identify this particular cache and allow
   // sharing of the cache.
   CacheClientInfo cinfo_;
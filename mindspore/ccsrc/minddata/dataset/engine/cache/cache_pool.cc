@@ -15,14 +15,26 @@
  */
 #include "minddata/dataset/engine/cache/cache_pool.h"
 
+#include <zlib.h>
+
+#include <limits>
+
 #include "minddata/dataset/engine/cache/cache_server.h"
 #include "minddata/dataset/util/services.h"
 #include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace dataset {
-CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root)
-    : mp_(std::move(mp)), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {
+CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root, bool compress)
+    : mp_(std::move(mp)),
+      root_(root),
+      subfolder_(Services::GetUniqueID()),
+      sm_(nullptr),
+      tree_(nullptr),
+      compress_(compress),
+      num_mem_hit_(0),
+      num_disk_hit_(0),
+      num_miss_(0) {
   // Initialize soft memory cap to the current available memory on the machine.
   soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
   temp_mem_usage_ = 0;
@@ -88,23 +100,36 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     sz += v.GetSize();
   }
   bl.sz = sz;
+  bl.stored_sz = sz;
+  // A compressed buffer is kept only if it is smaller, and it is stored as one slice.
+  std::string compressed;
+  std::vector<ReadableSlice> compressed_buf;
+  const std::vector<ReadableSlice> *data = &buf;
+  if (compress_) {
+    RETURN_IF_NOT_OK(Compress(buf, sz, &compressed));
+    if (!compressed.empty() && compressed.size() < sz) {
+      bl.stored_sz = compressed.size();
+      compressed_buf.emplace_back(compressed.data(), compressed.size());
+      data = &compressed_buf;
+    }
+  }
   // If required memory size exceeds the available size, it gives OOM status. To avoid cache server process got killed
   // or crashing the machine, set lower bound memory, which means stopping cache once the rest available memory is less
   // than the lower bound. (The default is 20% of physical RAM)
-  if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(sz) < min_avail_mem_) {
+  if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(bl.stored_sz) < min_avail_mem_) {
     MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
                     << ". The cache server will not cache any more data.";
     rc = STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of memory.");
   } else {
-    rc = mp_->Allocate(sz, reinterpret_cast<void **>(&bl.ptr));
+    rc = mp_->Allocate(bl.stored_sz, reinterpret_cast<void **>(&bl.ptr));
     // Adjust the soft limit and usage counting when every 100M memory are used.
-    if (temp_mem_usage_ + sz >= kMemoryCapAdjustInterval) {
+    if (temp_mem_usage_ + bl.stored_sz >= kMemoryCapAdjustInterval) {
       soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
       temp_mem_usage_ = 0;
     }
   }
   if (rc.IsOk()) {
-    temp_mem_usage_ += sz;
+    temp_mem_usage_ += bl.stored_sz;
     // Write down which numa node where we allocate from. It only make sense if the policy is kOnNode.
     if (CacheServerHW::numa_enabled()) {
       auto &cs = CacheServer::GetInstance();
@@ -114,9 +139,9 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
       bl.node_hit = (bl.node_id == node_id);
     }
     // We will do a piecewise copy.
-    WritableSlice dest(bl.ptr, bl.sz);
+    WritableSlice dest(bl.ptr, bl.stored_sz);
     size_t pos = 0;
-    for (auto &v : buf) {
+    for (auto &v : *data) {
       WritableSlice out(dest, pos);
       rc = WritableSlice::Copy(&out, v);
       if (rc.IsError()) {
@@ -132,8 +157,8 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
   } else if (rc == StatusCode::kMDOutOfMemory) {
     // If no memory, write to disk.
     if (sm_ != nullptr) {
-      MS_LOG(DEBUG) << "Spill to disk directly ... " << bl.sz << " bytes.";
-      RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
+      MS_LOG(DEBUG) << "Spill to disk directly ... " << bl.stored_sz << " bytes.";
+      RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, *data));
     } else {
       // If asked to spill to disk instead but there is no storage set up, simply return no memory
       // instead.
@@ -162,17 +187,35 @@ Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *byt
   auto r = tree_->Search(key);
   if (r.second) {
     auto &it = r.first;
+    bool compressed = it->stored_sz < it->sz;
     if (it->ptr != nullptr) {
-      ReadableSlice src(it->ptr, it->sz);
-      RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
+      if (compressed) {
+        RETURN_IF_NOT_OK(Decompress(it->ptr, it->stored_sz, dest, it->sz));
+      } else {
+        ReadableSlice src(it->ptr, it->sz);
+        RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
+      }
     } else if (sm_ != nullptr) {
+      // A compressed buffer is read into a temporary buffer first and decompressed from there.
+      std::string stored;
+      if (compressed) {
+        try {
+          stored.resize(it->stored_sz);
+        } catch (const std::bad_alloc &e) {
+          RETURN_STATUS_OOM("Out of memory.");
+        }
+      }
+      WritableSlice stored_slice(stored.data(), stored.size());
       size_t expectedLength = 0;
-      RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
-      if (expectedLength != it->sz) {
-        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << it->sz << "."
+      RETURN_IF_NOT_OK(sm_->Read(it->storage_key, compressed ? &stored_slice : dest, &expectedLength));
+      if (expectedLength != it->stored_sz) {
+        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << it->stored_sz << "."
                       << " Internal key: " << key << "\n";
         RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
       }
+      if (compressed) {
+        RETURN_IF_NOT_OK(Decompress(stored.data(), stored.size(), dest, it->sz));
+      }
     }
     if (bytesRead != nullptr) {
       *bytesRead = it->sz;
@@ -183,6 +226,56 @@ Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *byt
   return Status::OK();
 }
 
+Status CachePool::Compress(const std::vector<ReadableSlice> &buf, size_t sz, std::string *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  out->clear();
+  if (sz > std::numeric_limits<uInt>::max()) {
+    return Status::OK();
+  }
+  z_stream strm{};
+  CHECK_FAIL_RETURN_UNEXPECTED(deflateInit(&strm, Z_BEST_SPEED) == Z_OK, "Failed to initialize zlib.");
+  try {
+    out->resize(deflateBound(&strm, sz));
+  } catch (const std::bad_alloc &e) {
+    (void)deflateEnd(&strm);
+    RETURN_STATUS_OOM("Out of memory.");
+  }
+  strm.next_out = reinterpret_cast<Bytef *>(out->data());
+  strm.avail_out = static_cast<uInt>(out->size());
+  bool consumed = true;
+  for (auto &v : buf) {
+    if (v.GetSize() == 0) {
+      continue;
+    }
+    strm.next_in = const_cast<Bytef *>(reinterpret_cast<const Bytef *>(v.GetPointer()));
+    strm.avail_in = static_cast<uInt>(v.GetSize());
+    if (deflate(&strm, Z_NO_FLUSH) != Z_OK || strm.avail_in != 0) {
+      consumed = false;
+      break;
+    }
+  }
+  int ret = consumed ? deflate(&strm, Z_FINISH) : Z_BUF_ERROR;
+  (void)deflateEnd(&strm);
+  if (ret == Z_STREAM_END) {
+    out->resize(strm.total_out);
+  } else {
+    out->clear();
+  }
+  return Status::OK();
+}
+
+Status CachePool::Decompress(const void *src, size_t stored_sz, WritableSlice *dest, size_t sz) {
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  CHECK_FAIL_RETURN_UNEXPECTED(dest->GetSize() >= sz, "Destination buffer too small. Expect at least " +
+                                                        std::to_string(sz) +
+                                                        " but length = " + std::to_string(dest->GetSize()));
+  uLongf dest_len = sz;
+  int ret = uncompress(reinterpret_cast<Bytef *>(dest->GetMutablePointer()), &dest_len,
+                       reinterpret_cast<const Bytef *>(src), stored_sz);
+  CHECK_FAIL_RETURN_UNEXPECTED(ret == Z_OK && dest_len == sz,
+                               "Failed to decompress the cached buffer, zlib error: " + std::to_string(ret));
+  return Status::OK();
+}
 Path CachePool::GetSpillPath() const {
   auto spill = Path(root_) / subfolder_;
   return spill;
@@ -190,7 +283,7 @@ Path CachePool::GetSpillPath() const {
 
 CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
   tree_->LockShared();  // Prevent any node split while we search.
-  CacheStat cs{-1, -1, 0, 0, 0, 0};
+  CacheStat cs{-1, -1, 0, 0, 0, 0, num_mem_hit_, num_disk_hit_, num_miss_, 0, 0};
   int64_t total_sz = 0;
   if (tree_->begin() != tree_->end()) {
     cs.min_key = tree_->begin().key();
@@ -198,6 +291,7 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
     for (auto it = tree_->begin(); it != tree_->end(); ++it) {
       it.LockShared();
       total_sz += it.value().sz;
+      cs.stored_sz += it.value().stored_sz;
       if (it.value().ptr != nullptr) {
         ++cs.num_mem_cached;
       } else {
@@ -216,6 +310,7 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
       it.Unlock();
     }
   }
+  cs.total_sz = total_sz;
   if (total_sz > 0) {
     // integer arithmetic. NO need to cast to float or double.
     cs.average_cache_sz = total_sz / (cs.num_disk_cached + cs.num_mem_cached);
@@ -237,10 +332,25 @@ Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers
     bld.add_key(key);
     bld.add_size(it->sz);
     bld.add_node_id(it->node_id);
-    bld.add_addr(reinterpret_cast<int64_t>(it->ptr));
+    // A compressed buffer can't be copied as it is. Leave out the address so it goes through Read.
+    bld.add_addr(it->stored_sz < it->sz ? 0 : reinterpret_cast<int64_t>(it->ptr));
     auto offset = bld.Finish();
     *out = offset;
+    if (it->ptr != nullptr) {
+      ++num_mem_hit_;
+    } else {
+      ++num_disk_hit_;
+      // The rows of a batch are located before any of them is read, which gives the disk a head start.
+      // It is only a hint, the row is still read if it fails.
+      if (sm_ != nullptr) {
+        Status rc = sm_->Prefetch(it->storage_key);
+        if (rc.IsError()) {
+          MS_LOG(WARNING) << "Prefetch of key " << key << " failed. " << rc.ToString();
+        }
+      }
+    }
   } else {
+    ++num_miss_;
     // Key not in the cache.
     auto offset = CreateDataLocatorMsg(*fbb, key, 0, 0, 0);
     *out = offset;
@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -48,35 +49,40 @@ class CachePool : public Service {
   // An internal class to locate the whereabouts of a backed up buffer which can be either in
   class DataLocator {
    public:
-    DataLocator() : ptr(nullptr), sz(0), node_id(0), node_hit(false), storage_key(0) {}
+    DataLocator() : ptr(nullptr), sz(0), stored_sz(0), node_id(0), node_hit(false), storage_key(0) {}
     ~DataLocator() = default;
     DataLocator(const DataLocator &other) = default;
     DataLocator &operator=(const DataLocator &other) = default;
     DataLocator(DataLocator &&other) noexcept {
       ptr = other.ptr;
       sz = other.sz;
+      stored_sz = other.stored_sz;
       node_id = other.node_id;
       node_hit = other.node_hit;
       storage_key = other.storage_key;
       other.ptr = nullptr;
       other.sz = 0;
+      other.stored_sz = 0;
       other.storage_key = 0;
     }
     DataLocator &operator=(DataLocator &&other) noexcept {
       if (&other != this) {
         ptr = other.ptr;
         sz = other.sz;
+        stored_sz = other.stored_sz;
         node_id = other.node_id;
         node_hit = other.node_hit;
         storage_key = other.storage_key;
         other.ptr = nullptr;
         other.sz = 0;
+        other.stored_sz = 0;
         other.storage_key = 0;
       }
       return *this;
     }
     pointer ptr;
     size_t sz;
+    size_t stored_sz;   // size in memory or on disk, less than sz if the buffer is compressed
     numa_id_t node_id;  // where the numa node the memory is allocated to
     bool node_hit;      // we can allocate to the preferred node
     StorageManager::key_type storage_key;
@@ -95,13 +101,19 @@ class CachePool : public Service {
     int64_t num_disk_cached;
     int64_t average_cache_sz;
     int64_t num_numa_hit;
+    int64_t num_mem_hit;   // number of fetches served from memory
+    int64_t num_disk_hit;  // number of fetches served from disk
+    int64_t num_miss;      // number of fetches of keys not in the pool
+    int64_t total_sz;      // total size of the buffers
+    int64_t stored_sz;     // total size of the buffers as they are stored
     std::vector<key_type> gap;
   };
 
   /// \brief Constructor
   /// \param alloc Allocator to allocate memory from
   /// \param root Optional disk folder to spill
-  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "");
+  /// \param compress Compress the buffers before they are stored in memory or on disk
+  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "", bool compress = false);
 
   CachePool(const CachePool &) = delete;
   CachePool(CachePool &&) = delete;
@@ -129,7 +141,8 @@ class CachePool : public Service {
   /// \return Error code
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr) const;
 
-  /// \brief Serialize a DataLocator
+  /// \brief Serialize a DataLocator. The fetch of the buffer is counted in the statistics, and the buffer is read
+  /// ahead if it is on disk.
   Status GetDataLocator(key_type, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &,
                         flatbuffers::Offset<DataLocatorMsg> *) const;
 
@@ -143,6 +156,22 @@ class CachePool : public Service {
   /// \note Once locking is off. It is user's responsibility to ensure concurrency
   void SetLocking(bool on_off) { tree_->SetLocking(on_off); }
 
+  /// \brief Compress the slices as one block with the fastest level of zlib, which is what a cache can afford on
+  /// every buffer.
+  /// \param[in] buf A sequence of ReadableSlice objects
+  /// \param[in] sz Total size of the slices
+  /// \param[out] out The compressed block. Empty if the slices can't be compressed within the bound of zlib.
+  /// \return Error code
+  static Status Compress(const std::vector<ReadableSlice> &buf, size_t sz, std::string *out);
+
+  /// \brief Decompress a block produced by Compress.
+  /// \param[in] src The compressed block
+  /// \param[in] stored_sz Size of the compressed block
+  /// \param[out] dest Destination of the buffer
+  /// \param[in] sz Size of the buffer before compression
+  /// \return Error code
+  static Status Decompress(const void *src, size_t stored_sz, WritableSlice *dest, size_t sz);
+
  private:
   std::shared_ptr<NumaMemoryPool> mp_;
   Path root_;
@@ -153,6 +182,10 @@ class CachePool : public Service {
   std::atomic<uint64_t> temp_mem_usage_;  // temporary count on the amount of memory usage by cache every 100Mb (because
                                           // we will adjust soft_mem_limit_ every 100Mb based on this parameter)
   uint64_t min_avail_mem_;                // lower bound of the available memory
+  bool compress_;
+  mutable std::atomic<int64_t> num_mem_hit_;
+  mutable std::atomic<int64_t> num_disk_hit_;
+  mutable std::atomic<int64_t> num_miss_;
   const int kMemoryCapAdjustInterval = 104857600;
 };
 }  // namespace dataset
@@ -304,6 +304,11 @@ Status GetStatRequest::PostReply() {
   stat_.max_row_id = msg->max_row_id();
   stat_.min_row_id = msg->min_row_id();
   stat_.cache_service_state = msg->state();
+  stat_.num_mem_hit = msg->num_mem_hit();
+  stat_.num_disk_hit = msg->num_disk_hit();
+  stat_.num_miss = msg->num_miss();
+  stat_.total_sz = msg->total_sz();
+  stat_.stored_sz = msg->stored_sz();
   return Status::OK();
 }
 
@@ -45,6 +45,11 @@ struct CacheServiceStat {
   row_id_type min_row_id;
   row_id_type max_row_id;
   int8_t cache_service_state;
+  int64_t num_mem_hit;   // rows fetched from memory
+  int64_t num_disk_hit;  // rows fetched from the spill files
+  int64_t num_miss;      // rows asked for but not in the cache
+  int64_t total_sz;      // bytes of all the rows cached
+  int64_t stored_sz;     // bytes the rows take after compression
 };
 
 struct CacheServerCfgInfo {
@@ -244,7 +249,12 @@ class BatchFetchRequest : public BaseRequest {
 class CreateCacheRequest : public BaseRequest {
  public:
   friend class CacheServer;
-  enum class CreateCacheFlag : uint32_t { kNone = 0, kSpillToDisk = 1, kGenerateRowId = 1u << 1L };
+  enum class CreateCacheFlag : uint32_t {
+    kNone = 0,
+    kSpillToDisk = 1,
+    kGenerateRowId = 1u << 1L,
+    kCompress = 1u << 2L
+  };
 
   /// \brief Constructor
   /// \param connection_id
@@ -210,6 +210,8 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
     (flag & CreateCacheRequest::CreateCacheFlag::kSpillToDisk) == CreateCacheRequest::CreateCacheFlag::kSpillToDisk;
   bool generate_id =
     (flag & CreateCacheRequest::CreateCacheFlag::kGenerateRowId) == CreateCacheRequest::CreateCacheFlag::kGenerateRowId;
+  bool compress =
+    (flag & CreateCacheRequest::CreateCacheFlag::kCompress) == CreateCacheRequest::CreateCacheFlag::kCompress;
   if (spill && top_.empty()) {
     RETURN_STATUS_UNEXPECTED("Server is not set up with spill support.");
   }
@@ -234,7 +236,7 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
     RETURN_IF_NOT_OK(GlobalMemoryCheck(cache_mem_sz));
     std::unique_ptr<CacheService> cs;
     try {
-      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id);
+      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id, compress);
       RETURN_IF_NOT_OK(cs->ServiceStart());
       cookie = cs->cookie();
       client_id = cs->num_clients_.fetch_add(1);
@@ -586,6 +588,11 @@ Status CacheServer::GetStat(CacheRequest *rq, CacheReply *reply) {
     bld.add_max_row_id(svc_stat.stat_.max_key);
     bld.add_min_row_id(svc_stat.stat_.min_key);
     bld.add_state(svc_stat.state_);
+    bld.add_num_mem_hit(svc_stat.stat_.num_mem_hit);
+    bld.add_num_disk_hit(svc_stat.stat_.num_disk_hit);
+    bld.add_num_miss(svc_stat.stat_.num_miss);
+    bld.add_total_sz(svc_stat.stat_.total_sz);
+    bld.add_stored_sz(svc_stat.stat_.stored_sz);
     auto offset = bld.Finish();
     fbb.Finish(offset);
     reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
@@ -22,12 +22,13 @@
 
 namespace mindspore {
 namespace dataset {
-CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id)
+CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id, bool compress)
     : root_(root),
       cache_mem_sz_(mem_sz * 1048576L),  // mem_sz is in MB unit
       cp_(nullptr),
       next_id_(0),
       generate_id_(generate_id),
+      compress_(compress),
       num_clients_(0),
       st_(generate_id ? CacheServiceState::kBuildPhase : CacheServiceState::kNone) {}
 
@@ -53,7 +54,7 @@ Status CacheService::DoServiceStart() {
     RETURN_STATUS_UNEXPECTED("Unable to bring up numa memory pool");
   }
   // Put together a CachePool for backing up the Tensor.
-  cp_ = std::make_shared<CachePool>(numa_pool_, root_);
+  cp_ = std::make_shared<CachePool>(numa_pool_, root_, compress_);
   RETURN_IF_NOT_OK(cp_->ServiceStart());
   // Assign a name to this cache. Used for exclusive connection. But we can just use CachePool's name.
   cookie_ = cp_->MyName();
@@ -203,6 +204,7 @@ std::ostream &operator<<(std::ostream &out, const CacheService &cs) {
   } else {
     out << cs.GetSpillPath();
   }
+  out << "\nCompression: " << (cs.compress_ ? "On" : "Off");
   return out;
 }
 
@@ -66,6 +66,8 @@ void CachePerfRun::PrintHelp() {
             << " (Mb)\n"
                "       --spill:          Set spill to disk to True. Default = "
             << std::boolalpha << kDftSpill << "\n"
+            << "       --compress:       Set compress the cached rows to True. Default = " << std::boolalpha
+            << kDftCompress << "\n"
             << "    -w,--workers:        Set the number of parallel workers. Default = " << cfg_.num_parallel_workers()
             << "\n"
                "       --connection:     Set number of TCP/IP connections per pipeline. Default = "
@@ -206,6 +208,7 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
 
   int shuffle = 0;
   int spill = 0;
+  int compress = 0;
 
   const char *const short_opts = ":n:e:p:a:s:r:w:";
   const option long_opts[] = {{"pipeline", required_argument, nullptr, 'n'},
@@ -219,6 +222,7 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
                               {"port", required_argument, nullptr, port_opt},
                               {"hostname", required_argument, nullptr, hostname_opt},
                               {"spill", no_argument, &spill, 1},
+                              {"compress", no_argument, &compress, 1},
                               {"connection", required_argument, nullptr, connect_opt},
                               {"help", no_argument, nullptr, 'h'},
                               {nullptr, no_argument, nullptr, 0}};
@@ -257,6 +261,8 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
           shuffle_ = true;
         } else if (long_opts[option_indxex].flag == &spill) {
           cache_builder_.SetSpill(true);
+        } else if (long_opts[option_indxex].flag == &compress) {
+          cache_builder_.SetCompress(true);
         }
         continue;
       }
@@ -302,7 +308,7 @@ CachePerfRun::CachePerfRun()
       session_(0),
       crc_(0),
       epoch_sync_cnt_(0) {
-  cache_builder_.SetSpill(kDftSpill).SetCacheMemSz(kDftCacheSize);
+  cache_builder_.SetSpill(kDftSpill).SetCompress(kDftCompress).SetCacheMemSz(kDftCacheSize);
 }
 
 CachePerfRun::~CachePerfRun() {
@@ -367,6 +373,33 @@ void CachePerfRun::PrintEpochSummary() const {
   }
 }
 
+Status CachePerfRun::PrintTierSummary(int64_t elapse_ms) {
+  CacheServiceStat stat{};
+  RETURN_IF_NOT_OK(cc_->GetStat(&stat));
+  // The server counts from the start of the session. Only show what is fetched in this epoch.
+  int64_t mem_hit = stat.num_mem_hit - last_stat_.num_mem_hit;
+  int64_t disk_hit = stat.num_disk_hit - last_stat_.num_disk_hit;
+  int64_t miss = stat.num_miss - last_stat_.num_miss;
+  last_stat_ = stat;
+  int64_t num_fetched = mem_hit + disk_hit + miss;
+  auto percent = [num_fetched](int64_t n) {
+    const double kPercent = 100.0;
+    return num_fetched == 0 ? 0.0 : kPercent * static_cast<double>(n) / static_cast<double>(num_fetched);
+  };
+  const double kMsPerSecond = 1000.0;
+  double rows_per_second =
+    elapse_ms == 0 ? 0.0 : static_cast<double>(num_fetched) * kMsPerSecond / static_cast<double>(elapse_ms);
+  std::cout << std::setw(field_width_twelve) << "Mem hit" << std::setw(field_width_twelve) << "Disk hit"
+            << std::setw(field_width_ten) << "Miss" << std::setw(field_width_fourteen) << "Mem hit (%)"
+            << std::setw(field_width_fourteen) << "Disk hit (%)" << std::setw(field_width_fourteen) << "Rows/s"
+            << std::endl;
+  std::cout << std::setw(field_width_twelve) << mem_hit << std::setw(field_width_twelve) << disk_hit
+            << std::setw(field_width_ten) << miss << std::setw(field_width_fourteen) << std::fixed
+            << std::setprecision(2) << percent(mem_hit) << std::setw(field_width_fourteen) << percent(disk_hit)
+            << std::setw(field_width_fourteen) << rows_per_second << std::defaultfloat << std::endl;
+  return Status::OK();
+}
+
 Status CachePerfRun::ListenToPipeline(int32_t workerId) {
   TaskManager::FindMe()->Post();
   int32_t qID = msg_recv_lists_[workerId];
@@ -465,7 +498,9 @@ Status CachePerfRun::StartPipelines() {
                                std::to_string(cache_builder_.GetPrefetchSize()) + "," +
                                std::to_string(cache_builder_.GetCacheMemSz()) + "," +
                                std::to_string(cache_builder_.GetNumConnections()) + "," +
-                               (cache_builder_.isSpill() ? std::string("true").data() : std::string("false").data());
+                               (cache_builder_.isSpill() ? std::string("true").data() : std::string("false").data()) +
+                               "," +
+                               (cache_builder_.isCompress() ? std::string("true").data() : std::string("false").data());
       char *argv[4];
       argv[0] = const_cast<char *>(kCachePipelineBinary);
       argv[1] = pipeline_cfg.data();
@@ -580,6 +615,12 @@ Status CachePerfRun::Run() {
 
   std::cout << std::setw(12) << stat_mem_cached << std::setw(12) << stat_disk_cached << std::setw(16) << stat_avg_cached
             << std::setw(10) << stat_numa_hit << std::endl;
+  if (cache_builder_.isCompress() && stat.stored_sz > 0) {
+    std::cout << "Compression ratio: " << std::fixed << std::setprecision(2)
+              << static_cast<double>(stat.total_sz) / static_cast<double>(stat.stored_sz) << std::defaultfloat
+              << " (" << stat.total_sz << " bytes stored in " << stat.stored_sz << " bytes)" << std::endl;
+  }
+  last_stat_ = stat;
 
   // Toggle write mode off since the rest are just read only.
   // Simplest way is call this special internal function.
@@ -606,6 +647,9 @@ Status CachePerfRun::Run() {
     std::cout << "Epoch " << epoch_num
               << " (read phase) per pipeline per worker summary. Buffer size = " << cc_->GetPrefetchSize() << std::endl;
     PrintEpochSummary();
+    std::cout << "Epoch " << epoch_num << " (read phase) fetches by storage tier." << std::endl;
+    RETURN_IF_NOT_OK(
+      PrintTierSummary(std::chrono::duration_cast<std::chrono::milliseconds>(end_tick - start_tick).count()));
     ++epoch_num;
   }
 
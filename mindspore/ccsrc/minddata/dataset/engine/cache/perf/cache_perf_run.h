@@ -45,6 +45,7 @@ constexpr int32_t kDftNumberOfEpochs = 10;
 constexpr int32_t kDftCacheSize = 0;
 constexpr bool kDftShuffle = false;
 constexpr bool kDftSpill = false;
+constexpr bool kDftCompress = false;
 
 class CachePerfRun {
  public:
@@ -89,10 +90,12 @@ class CachePerfRun {
   std::map<std::pair<int32_t, int32_t>, PipelineWorkerEpochSummary> epoch_results_;
   ConfigManager cfg_;
   std::shared_ptr<CacheClient> cc_;
+  CacheServiceStat last_stat_{};
 
   Status GetSession();
   Status ListenToPipeline(int32_t workerId);
   void PrintEpochSummary() const;
+  Status PrintTierSummary(int64_t elapse_ms);
   Status StartPipelines();
   Status Cleanup();
   int32_t SanityCheck(std::map<int32_t, int32_t> seen_opts);
@@ -45,6 +45,7 @@ constexpr int32_t kDftNumberOfEpochs = 10;
 constexpr int32_t kDftCacheSize = 0;
 constexpr bool kDftShuffle = false;
 constexpr bool kDftSpill = false;
+constexpr bool kDftCompress = false;
 
 class CachePipelineRun {
  public:
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "minddata/dataset/engine/cache/storage_container.h"
+#include <fcntl.h>
 #include <unistd.h>
 #include <vector>
 #include "minddata/dataset/util/log_adapter.h"
@@ -23,7 +24,6 @@
 namespace mindspore {
 namespace dataset {
 Status StorageContainer::Create() {
-  RETURN_IF_NOT_OK(BuddySpace::CreateBuddySpace(&bs_));
   RETURN_IF_NOT_OK(cont_.CreateFile(&fd_));
   is_open_ = true;
   MS_LOG(INFO) << "Container " << cont_ << " created";
@@ -57,19 +57,28 @@ Status StorageContainer::Read(WritableSlice *dest, off64_t offset) const noexcep
   MS_ASSERT(is_open_);
   RETURN_UNEXPECTED_IF_NULL(dest);
   auto sz = dest->GetSize();
+  std::unique_lock<std::mutex> lck(mutex_);
+  if (offset >= wbuf_start_) {
+    // The row is still in the write buffer.
+    CHECK_FAIL_RETURN_UNEXPECTED(offset + static_cast<off64_t>(sz) <= tail_, "Read beyond the end of container");
+    ReadableSlice src(wbuf_.data() + (offset - wbuf_start_), sz);
+    return WritableSlice::Copy(dest, src);
+  }
 #if defined(_WIN32) || defined(_WIN64)
   // Doesn't seem there is any pread64 on mingw.
   // So we will do a seek and then a read under
   // a protection of mutex.
-  std::lock_guard<std::mutex> lck(mutex_);
   auto seek_err = lseek(fd_, offset, SEEK_SET);
   if (seek_err < 0) {
     RETURN_STATUS_UNEXPECTED(strerror(errno));
   }
   auto r_sz = read(fd_, dest->GetMutablePointer(), sz);
 #elif defined(__APPLE__)
+  lck.unlock();
   auto r_sz = pread(fd_, dest->GetMutablePointer(), sz, offset);
 #else
+  // Rows before wbuf_start_ are in the file already, no need to hold the lock to read them.
+  lck.unlock();
   auto r_sz = pread64(fd_, dest->GetMutablePointer(), sz, offset);
 #endif
   if (r_sz != sz) {
@@ -79,23 +88,25 @@ Status StorageContainer::Read(WritableSlice *dest, off64_t offset) const noexcep
   return Status::OK();
 }
 
-Status StorageContainer::Write(const ReadableSlice &dest, off64_t offset) const noexcept {
+Status StorageContainer::Flush() noexcept {
   MS_ASSERT(is_open_);
-  auto sz = dest.GetSize();
+  auto sz = wbuf_.size();
+  if (sz == 0) {
+    return Status::OK();
+  }
+  off64_t offset = wbuf_start_;
 #if defined(_WIN32) || defined(_WIN64)
   // Doesn't seem there is any pwrite64 on mingw.
-  // So we will do a seek and then a read under
-  // a protection of mutex.
-  std::lock_guard<std::mutex> lck(mutex_);
+  // So we will do a seek and then a write. The mutex is held by the caller.
   auto seek_err = lseek(fd_, offset, SEEK_SET);
   if (seek_err < 0) {
     RETURN_STATUS_UNEXPECTED(strerror(errno));
   }
-  auto r_sz = write(fd_, dest.GetPointer(), sz);
+  auto r_sz = write(fd_, wbuf_.data(), sz);
 #elif defined(__APPLE__)
-  auto r_sz = pwrite(fd_, dest.GetPointer(), sz, offset);
+  auto r_sz = pwrite(fd_, wbuf_.data(), sz, offset);
 #else
-  auto r_sz = pwrite64(fd_, dest.GetPointer(), sz, offset);
+  auto r_sz = pwrite64(fd_, wbuf_.data(), sz, offset);
 #endif
   if (r_sz != sz) {
     errno_t err = (r_sz == 0) ? EOF : errno;
@@ -105,10 +116,13 @@ Status StorageContainer::Write(const ReadableSlice &dest, off64_t offset) const
       RETURN_STATUS_UNEXPECTED(strerror(err));
     }
   }
+  wbuf_start_ = tail_;
+  wbuf_.clear();
   return Status::OK();
 }
 
 Status StorageContainer::Insert(const std::vector<ReadableSlice> &buf, off64_t *offset) noexcept {
+  RETURN_UNEXPECTED_IF_NULL(offset);
   size_t sz = 0;
   for (auto &v : buf) {
     sz += v.GetSize();
@@ -116,30 +130,48 @@ Status StorageContainer::Insert(const std::vector<ReadableSlice> &buf, off64_t *
   if (sz == 0) {
     RETURN_STATUS_UNEXPECTED("Unexpected 0 length");
   }
-  if (sz > bs_->GetMaxSize()) {
+  if (static_cast<off64_t>(sz) > kMaxContainerSize) {
     RETURN_STATUS_UNEXPECTED("Request size too big");
   }
-  BSpaceDescriptor bspd{0};
-  addr_t addr = 0;
-  RETURN_IF_NOT_OK(bs_->Alloc(sz, &bspd, &addr));
-  *offset = static_cast<off64_t>(addr);
-  // We will do piecewise copy of the data to a large buffer
-  std::string mem;
+  std::lock_guard<std::mutex> lck(mutex_);
+  if (tail_ + static_cast<off64_t>(sz) > kMaxContainerSize) {
+    // StorageManager will move on to a new container.
+    RETURN_STATUS_ERROR(StatusCode::kMDBuddySpaceFull, "Container is full.");
+  }
+  // Append the row to the write buffer, which is written to disk at once when it is full.
   try {
-    mem.resize(sz);
-    CHECK_FAIL_RETURN_UNEXPECTED(mem.capacity() >= sz, "Programming error");
+    if (wbuf_.capacity() < kWriteBufferSize) {
+      wbuf_.reserve(kWriteBufferSize);
+    }
+    for (auto &v : buf) {
+      (void)wbuf_.append(static_cast<const char *>(v.GetPointer()), v.GetSize());
+    }
   } catch (const std::bad_alloc &e) {
+    // Drop the partial row.
+    wbuf_.resize(static_cast<size_t>(tail_ - wbuf_start_));
     return Status(StatusCode::kMDOutOfMemory);
   }
-  WritableSlice all(mem.data(), sz);
-  size_t pos = 0;
-  for (auto &v : buf) {
-    WritableSlice row_data(all, pos);
-    RETURN_IF_NOT_OK(WritableSlice::Copy(&row_data, v));
-    pos += v.GetSize();
+  *offset = tail_;
+  tail_ += static_cast<off64_t>(sz);
+  if (wbuf_.size() >= kWriteBufferSize) {
+    RETURN_IF_NOT_OK(Flush());
+  }
+  return Status::OK();
+}
+
+Status StorageContainer::Prefetch(off64_t offset, size_t sz) const noexcept {
+  MS_ASSERT(is_open_);
+  {
+    std::lock_guard<std::mutex> lck(mutex_);
+    if (offset >= wbuf_start_) {
+      // Still in memory.
+      return Status::OK();
+    }
   }
-  // Write all data to disk at once
-  RETURN_IF_NOT_OK(Write(all, addr));
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+  // Only a hint, it is fine if the kernel ignores it.
+  (void)posix_fadvise(fd_, offset, static_cast<off64_t>(sz), POSIX_FADV_WILLNEED);
+#endif
   return Status::OK();
 }
 
@@ -157,7 +189,10 @@ StorageContainer::~StorageContainer() noexcept {
 }
 
 std::ostream &operator<<(std::ostream &os, const StorageContainer &s) {
-  os << "File path : " << s.cont_ << "\n" << *(s.bs_.get());
+  std::lock_guard<std::mutex> lck(s.mutex_);
+  os << "File path : " << s.cont_ << "\n"
+     << "Size : " << s.tail_ << "\n"
+     << "Unwritten : " << s.wbuf_.size() << "\n";
   return os;
 }
 
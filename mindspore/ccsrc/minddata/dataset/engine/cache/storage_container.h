@@ -23,7 +23,6 @@
 #include <string>
 #include <vector>
 #include "minddata/dataset/util/system_pool.h"
-#include "minddata/dataset/util/buddy.h"
 #include "minddata/dataset/util/path.h"
 #include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/status.h"
@@ -32,6 +31,9 @@ namespace mindspore {
 namespace dataset {
 class StorageManager;
 
+/// \brief A log structured file of rows. The rows are never freed one by one, so each row is simply appended to the
+/// end of the file. The rows appended since the last write are held in a buffer and written to the file together once
+/// the buffer is full, which turns many small random writes into a few large sequential ones.
 class StorageContainer {
  public:
   friend class StorageManager;
@@ -50,10 +52,14 @@ class StorageContainer {
 
   Status Insert(const std::vector<ReadableSlice> &buf, off64_t *offset) noexcept;
 
-  Status Write(const ReadableSlice &dest, off64_t offset) const noexcept;
-
   Status Read(WritableSlice *dest, off64_t offset) const noexcept;
 
+  /// \brief Hint the OS to read ahead a range of the file which is going to be read soon.
+  /// \param offset Offset of the range
+  /// \param sz Length of the range
+  /// \return Status object
+  Status Prefetch(off64_t offset, size_t sz) const noexcept;
+
   Status Truncate() const noexcept;
 
   bool IsOpen() const { return is_open_; }
@@ -61,17 +67,26 @@ class StorageContainer {
   static Status CreateStorageContainer(std::shared_ptr<StorageContainer> *out_sc, const std::string &path);
 
  private:
+  // Same limit as the BuddySpace used before, a new container is created when this one is full.
+  static constexpr off64_t kMaxContainerSize = 4294967296LL;
+  static constexpr size_t kWriteBufferSize = 1048576;
+
   mutable std::mutex mutex_;
   Path cont_;
   int fd_;
   bool is_open_;
-  std::unique_ptr<BuddySpace> bs_;
+  off64_t tail_;        // end of the rows appended so far
+  off64_t wbuf_start_;  // offset of the first row in wbuf_
+  std::string wbuf_;    // rows not written to the file yet
 
-  // Use the default value of BuddySpace
-  // which can map upto 4G of space.
-  explicit StorageContainer(const std::string &path) : cont_(path), fd_(-1), is_open_(false), bs_(nullptr) {}
+  explicit StorageContainer(const std::string &path)
+      : cont_(path), fd_(-1), is_open_(false), tail_(0), wbuf_start_(0) {}
 
   Status Create();
+
+  /// \brief Write all the rows in wbuf_ to the file.
+  /// \note mutex_ should be held
+  Status Flush() noexcept;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -151,6 +151,16 @@ Status StorageManager::Read(StorageManager::key_type key, WritableSlice *dest, s
   return Status::OK();
 }
 
+Status StorageManager::Prefetch(StorageManager::key_type key) const {
+  auto r = index_.Search(key);
+  if (!r.second) {
+    RETURN_STATUS_UNEXPECTED("Key not found");
+  }
+  value_type v = *(r.first);
+  auto cont = containers_.at(v.first);
+  return cont->Prefetch(v.second.first, v.second.second);
+}
+
 Status StorageManager::DoServiceStop() noexcept {
   Status rc;
   Status rc1;
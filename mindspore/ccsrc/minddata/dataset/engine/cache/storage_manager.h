@@ -66,6 +66,11 @@ class StorageManager : public Service {
 
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead) const;
 
+  /// \brief Start reading ahead a buffer which is going to be read soon.
+  /// \param key The key returned by Write
+  /// \return Status object
+  Status Prefetch(key_type key) const;
+
   Status DoServiceStart() override;
 
   Status DoServiceStop() noexcept override;
@@ -50,6 +50,11 @@ namespace dataset {
 //        - The caller thread of pop() is not equal to the _expectConsumer. This is to enforce
 //          the ordering.
 //
+// First ready mode:
+//   If the Connector is created with first_ready = true, the order is not preserved. Pop() takes the element from
+//   whichever queue has data first (starting from the queue after the last popped one), and any idle consumer can
+//   pop, so a slow producer or consumer does not stall the others.
+//
 // Future improvement:
 //   1. Fault tolerant: Right now, if one of the worker dies, the Connector will not work
 //      properly.
@@ -71,9 +76,11 @@ class Connector {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element for each queue.
-  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : num_producers_(n_producers), num_consumers_(n_consumers) {
-    MS_LOG(DEBUG) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers.";
+  // @param first_ready Whether to deliver the element of whichever queue has data first instead of preserving order.
+  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool first_ready = false)
+      : num_producers_(n_producers), num_consumers_(n_consumers), first_ready_(first_ready) {
+    MS_LOG(DEBUG) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers"
+                  << (first_ready ? " in first ready mode." : ".");
     my_name_ = Services::GetUniqueID();
     // We require the consumers to have ids sequentially from 0 to the num_consumers_-1,
     // Otherwise a ordered list of consumer ids have to be passed here. (not implemented yet)
@@ -96,6 +103,14 @@ class Connector {
   // @param result The address of an object where the popped element will be placed.
   virtual Status Pop(int32_t worker_id,  // The worker-id of the caller. See the requirement at the top of this file.
                      T *result) noexcept {
+    if (first_ready_) {
+      {
+        std::unique_lock<std::mutex> lk(m_);
+        size_t queue_index = 0;
+        RETURN_IF_NOT_OK(PopFirstReady(&lk, result, {}, &queue_index));
+      }
+      return Status::OK();
+    }
     {
       MS_ASSERT(worker_id < num_consumers_);
       std::unique_lock<std::mutex> lk(m_);
@@ -118,7 +133,8 @@ class Connector {
   Status Push(int32_t worker_id, const T &el) noexcept {
     MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
     MS_ASSERT(queues_[worker_id] != nullptr);
-    return (queues_[worker_id]->Add(el));
+    RETURN_IF_NOT_OK(queues_[worker_id]->Add(el));
+    return NotifyReady();
   }
 
   auto out_rows_count() const { return out_buffers_count_.load(); }
@@ -131,9 +147,12 @@ class Connector {
   virtual Status Push(int32_t worker_id, T &&el) noexcept {
     MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
     MS_ASSERT(queues_[worker_id] != nullptr);
-    return (queues_[worker_id]->Add(std::forward<T>(el)));
+    RETURN_IF_NOT_OK(queues_[worker_id]->Add(std::forward<T>(el)));
+    return NotifyReady();
   }
 
+  bool first_ready() const { return first_ready_; }
+
   // Resets the internal index tracking of the queue so that it can be used again with new inputs,
   // starting from the beginning.
   void Reset() {
@@ -186,6 +205,42 @@ class Connector {
   }
 
  protected:
+  // In first ready mode, the producer notifies the consumers after the element is added to its queue. The lock is
+  // taken before notifying, so a consumer can not miss the notification between checking the queues and waiting.
+  Status NotifyReady() {
+    if (first_ready_) {
+      {
+        std::unique_lock<std::mutex> lk(m_);
+      }
+      cv_.NotifyAll();
+    }
+    return Status::OK();
+  }
+
+  // Pop the element from the first non-empty queue starting from pop_from_, the queues flagged in `skip_queues` are
+  // not popped. Must be called when holding m_, so the queue found non-empty can not be emptied by other consumers.
+  // @param lk The lock of m_.
+  // @param result The address of an object where the popped element will be placed.
+  // @param skip_queues The flags of the queues which should not be popped, empty means none.
+  // @param queue_index The index of the queue popped from.
+  Status PopFirstReady(std::unique_lock<std::mutex> *lk, T *result, const std::vector<bool> &skip_queues,
+                       size_t *queue_index) {
+    RETURN_IF_NOT_OK(cv_.Wait(lk, [this, &skip_queues, queue_index]() {
+      for (int32_t offset = 0; offset < num_producers_; offset++) {
+        size_t index = (pop_from_ + offset) % num_producers_;
+        if ((skip_queues.empty() || !skip_queues[index]) && !queues_[index]->empty()) {
+          *queue_index = index;
+          return true;
+        }
+      }
+      return false;
+    }));
+    RETURN_IF_NOT_OK(queues_[*queue_index]->PopFront(result));
+    pop_from_ = (*queue_index + 1) % num_producers_;
+    out_buffers_count_++;
+    return Status::OK();
+  }
+
   std::string my_name_;
 
   // A list of Queues that are thread safe.
@@ -200,6 +255,9 @@ class Connector {
   int32_t num_producers_;
   int32_t num_consumers_;
 
+  // Whether to deliver the element of whichever queue has data first.
+  bool first_ready_;
+
   // Used in the Pop(), when a thread call pop() but it is not the expect_consumer_.
   std::mutex m_;
   CondVar cv_;
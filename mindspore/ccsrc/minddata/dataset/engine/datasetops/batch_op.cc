@@ -22,6 +22,8 @@
 #include "minddata/dataset/core/pybind_support.h"
 #endif
 
+#include "minddata/dataset/engine/datasetops/batch_slot_pool.h"
+#include "minddata/dataset/engine/datasetops/map_op/map_op.h"
 #include "minddata/dataset/kernels/data/data_utils.h"
 #include "minddata/dataset/util/status.h"
 
@@ -49,6 +51,7 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
       batch_num_(0),
       batch_cnt_(0),
       python_mp_(nullptr) {
+  first_ready_ = GlobalContext::config_manager()->first_ready_mode();
   // Adjust connector queue size.  After batch each row is batch_size times larger
   worker_connector_size_ = std::max(1, worker_connector_size_ / start_batch_size_);
   if (num_workers == 1) {
@@ -105,8 +108,10 @@ Status BatchOp::operator()() {
     table = std::make_unique<TensorQTable>();  // this drops when drop == true
     // end of the current epoch, batch_num should start from 0 again
     batch_num = 0;
-    RETURN_IF_NOT_OK(
-      worker_in_queues_[NextWorkerID()]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(BatchCtrl::kEOE))));
+    for (int32_t i = 0; i < NumCtrlRowsToSend(); i++) {
+      RETURN_IF_NOT_OK(
+        worker_in_queues_[NextWorkerID()]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(BatchCtrl::kEOE))));
+    }
     UpdateRepeatAndEpochCounter();
     RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(op_current_epochs_, batch_num, cnt)));
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
@@ -120,8 +125,10 @@ Status BatchOp::operator()() {
     }
 #endif
   }  // end of EofHandled() == false
-  RETURN_IF_NOT_OK(
-    worker_in_queues_[NextWorkerID()]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(BatchCtrl::kEOF))));
+  for (int32_t i = 0; i < NumCtrlRowsToSend(); i++) {
+    RETURN_IF_NOT_OK(
+      worker_in_queues_[NextWorkerID()]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(BatchCtrl::kEOF))));
+  }
   // EOF received, send quit signal to all workers
   for (int32_t ind = 0; ind < num_workers_; ind++) {
     RETURN_IF_NOT_OK(SendQuitFlagToWorker(NextWorkerID()));
@@ -184,6 +191,24 @@ Status CopyTensorToBatch(const std::shared_ptr<Tensor> &element_tensor, std::sha
   return Status::OK();
 }
 
+// Get the batch tensor if the tensors of the column are its slots in order, which the MapOp has written into.
+std::shared_ptr<Tensor> GetFilledBatchTensor(const std::unique_ptr<TensorQTable> *tensor_row_dequeue,
+                                             dsize_t batch_size, size_t column_index) {
+  const std::shared_ptr<Tensor> &base = (*tensor_row_dequeue)->at(0).at(column_index)->ViewBase();
+  if (base == nullptr || base->Rank() == 0 || base->shape()[0] != batch_size) {
+    return nullptr;
+  }
+  for (dsize_t row_index = 0; row_index < batch_size; ++row_index) {
+    const std::shared_ptr<Tensor> &slot = (**tensor_row_dequeue)[row_index][column_index];
+    if (slot->ViewBase() != base || slot->type() != base->type() ||
+        slot->shape().PrependDim(batch_size) != base->shape() ||
+        slot->GetBuffer() != base->GetBuffer() + row_index * slot->SizeInBytes()) {
+      return nullptr;
+    }
+  }
+  return base;
+}
+
 Status BatchOp::ConvertRowsToTensor(const std::unique_ptr<TensorQTable> *tensor_row_dequeue,
                                     std::shared_ptr<Tensor> *batched_tensor, dsize_t batch_size, size_t column_index,
                                     bool contains_per_batch_map) {
@@ -196,6 +221,11 @@ Status BatchOp::ConvertRowsToTensor(const std::unique_ptr<TensorQTable> *tensor_
 
   std::shared_ptr<Tensor> new_tensor;
   if (first_type.IsNumeric()) {  // numeric tensor
+    new_tensor = GetFilledBatchTensor(tensor_row_dequeue, batch_size, column_index);
+    if (new_tensor != nullptr) {
+      *batched_tensor = std::move(new_tensor);
+      return Status::OK();
+    }
     RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, &new_tensor));
     for (auto row_index = 0; row_index < batch_size; ++row_index) {
       const std::shared_ptr<Tensor> &old_tensor = (**tensor_row_dequeue)[row_index][column_index];
@@ -313,19 +343,19 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
       RETURN_IF_NOT_OK(MakeBatchedRow(std::move(table_pair), &batched_tensor_row));
       RETURN_IF_NOT_OK(CollectOpInfoEnd(this->NameWithID(), "WorkerProcess",
                                         {{"TensorRowFlags", TensorRow(TensorRow::kFlagNone).FlagName()}}));
-      RETURN_IF_NOT_OK(worker_out_queues_[workerId]->EmplaceBack(std::move(batched_tensor_row)));
+      RETURN_IF_NOT_OK(SendToCollector(workerId, std::move(batched_tensor_row)));
     } else if (table_pair.second.ctrl_ == BatchCtrl::kEOE) {
       RETURN_IF_NOT_OK(CollectOpInfoEnd(this->NameWithID(), "WorkerProcess",
                                         {{"TensorRowFlags", TensorRow(TensorRow::kFlagEOE).FlagName()}}));
-      RETURN_IF_NOT_OK(worker_out_queues_[workerId]->EmplaceBack(TensorRow(TensorRow::TensorRowFlags::kFlagEOE)));
+      RETURN_IF_NOT_OK(SendToCollector(workerId, TensorRow(TensorRow::TensorRowFlags::kFlagEOE)));
     } else if (table_pair.second.ctrl_ == BatchCtrl::kEOF) {
       RETURN_IF_NOT_OK(CollectOpInfoEnd(this->NameWithID(), "WorkerProcess",
                                         {{"TensorRowFlags", TensorRow(TensorRow::kFlagEOF).FlagName()}}));
-      RETURN_IF_NOT_OK(worker_out_queues_[workerId]->EmplaceBack(TensorRow(TensorRow::TensorRowFlags::kFlagEOF)));
+      RETURN_IF_NOT_OK(SendToCollector(workerId, TensorRow(TensorRow::TensorRowFlags::kFlagEOF)));
     } else if (table_pair.second.ctrl_ == BatchCtrl::kWait) {
       RETURN_IF_NOT_OK(CollectOpInfoEnd(this->NameWithID(), "WorkerProcess",
                                         {{"TensorRowFlags", TensorRow(TensorRow::kFlagWait).FlagName()}}));
-      RETURN_IF_NOT_OK(worker_out_queues_[workerId]->EmplaceBack(TensorRow(TensorRow::TensorRowFlags::kFlagWait)));
+      RETURN_IF_NOT_OK(SendToCollector(workerId, TensorRow(TensorRow::TensorRowFlags::kFlagWait)));
       RETURN_IF_NOT_OK(TaskManager::FindMe()->Wait());  // wait for auto tune update workers successful
       TaskManager::FindMe()->Clear();
     }
@@ -882,6 +912,21 @@ void BatchOp::SetPythonMp(std::shared_ptr<PythonMultiprocessingRuntime> python_m
   python_mp_ = std::move(python_mp);
 }
 
+Status BatchOp::PrepareOperator() {
+  RETURN_IF_NOT_OK(DatasetOp::PrepareOperator());
+  if (!GlobalContext::config_manager()->zero_copy_batch() || first_ready_ || start_batch_size_ <= 1 || pad_ ||
+      !pad_info_.empty() || IsPython()) {
+    return Status::OK();
+  }
+  // the rows must come in order from the MapOp, so that the n-th row since the EOE is the n-th row of the batches.
+  auto map_op = std::dynamic_pointer_cast<MapOp>(child_[0]);
+  if (map_op != nullptr) {
+    MS_LOG(INFO) << "Map workers of " << map_op->NameWithID() << " write into the batch tensors of " << NameWithID();
+    map_op->SetBatchSlots(std::make_shared<BatchSlotPool>(start_batch_size_));
+  }
+  return Status::OK();
+}
+
 Status BatchOp::Launch() {
   // Launch Python multiprocessing. This will create the MP pool and shared memory if needed.
   if (python_mp_) {
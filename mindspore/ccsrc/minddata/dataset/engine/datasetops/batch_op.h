@@ -167,6 +167,11 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
   /// \return vector of int
   std::vector<int32_t> GetMPWorkerPIDs() const override;
 
+  // Let the MapOp right before this op write the rows into the batch tensors when the batches are plain ones,
+  // then the batch tensor is published without copying.
+  // @return Status The status code returned
+  Status PrepareOperator() override;
+
  private:
   // Worker thread for doing the memcpy of batch
   // @param int32_t param workerId
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/batch_slot_pool.h"
+
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include "./securec.h"
+
+namespace mindspore {
+namespace dataset {
+Status BatchSlotPool::GetEntry(const RowPosition &position, size_t column, const TensorShape &shape,
+                               const DataType &type, Entry **entry) {
+  RETURN_UNEXPECTED_IF_NULL(entry);
+  // the rows of the last generation which never come, e.g. the remainder of the last batch, are dropped here.
+  if (position.generation > generation_) {
+    for (auto itr = entries_.begin(); itr != entries_.end();) {
+      itr = std::get<0>(itr->first) < position.generation ? entries_.erase(itr) : std::next(itr);
+    }
+    generation_ = position.generation;
+  }
+  EntryKey key(position.generation, position.seq / batch_size_, column);
+  auto itr = entries_.find(key);
+  if (itr == entries_.end()) {
+    Entry new_entry;
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape.PrependDim(batch_size_), type, &new_entry.base));
+    itr = entries_.emplace(key, std::move(new_entry)).first;
+  }
+  *entry = &itr->second;
+  return Status::OK();
+}
+
+Status BatchSlotPool::GetSlot(const RowPosition &position, size_t column, TensorPtr *slot) {
+  RETURN_UNEXPECTED_IF_NULL(slot);
+  *slot = nullptr;
+  TensorPtr base;
+  {
+    std::unique_lock<std::mutex> lock(mux_);
+    auto last_shape = last_shapes_.find(column);
+    if (position.seq < 0 || last_shape == last_shapes_.end()) {
+      return Status::OK();
+    }
+    const TensorShape &shape = last_shape->second.first;
+    const DataType &type = last_shape->second.second;
+    Entry *entry = nullptr;
+    RETURN_IF_NOT_OK(GetEntry(position, column, shape, type, &entry));
+    if (entry->base->shape() != shape.PrependDim(batch_size_) || entry->base->type() != type) {
+      return Status::OK();
+    }
+    base = entry->base;
+  }
+  return Tensor::CreateSliceView(base, position.seq % batch_size_, slot);
+}
+
+Status BatchSlotPool::Place(const RowPosition &position, size_t column, TensorPtr *tensor) {
+  RETURN_UNEXPECTED_IF_NULL(tensor);
+  RETURN_UNEXPECTED_IF_NULL(*tensor);
+  const TensorPtr &input = *tensor;
+  if (position.seq < 0 || !input->type().IsNumeric() || input->Size() == 0) {
+    return Status::OK();
+  }
+  TensorPtr base;
+  {
+    std::unique_lock<std::mutex> lock(mux_);
+    (void)last_shapes_.insert_or_assign(column, std::make_pair(input->shape(), input->type()));
+    Entry *entry = nullptr;
+    RETURN_IF_NOT_OK(GetEntry(position, column, input->shape(), input->type(), &entry));
+    if (entry->base->shape() == input->shape().PrependDim(batch_size_) && entry->base->type() == input->type()) {
+      base = entry->base;
+    }
+    // the batch tensor lives on in the slots once all the rows are placed.
+    if (++entry->num_placed == batch_size_) {
+      (void)entries_.erase(EntryKey(position.generation, position.seq / batch_size_, column));
+    }
+  }
+  if (base == nullptr) {
+    return Status::OK();
+  }
+  dsize_t index = position.seq % batch_size_;
+  if (input->ViewBase() == base && input->GetBuffer() == base->GetBuffer() + index * input->SizeInBytes()) {
+    // the op has written into the slot.
+    return Status::OK();
+  }
+  TensorPtr slot;
+  RETURN_IF_NOT_OK(Tensor::CreateSliceView(base, index, &slot));
+  errno_t copy_status =
+    memcpy_s(slot->GetMutableBuffer(), slot->SizeInBytes(), input->GetBuffer(), input->SizeInBytes());
+  CHECK_FAIL_RETURN_UNEXPECTED(copy_status == EOK,
+                               "Failed to copy tensor to batch slot, got error_t: " + std::to_string(copy_status));
+  *tensor = std::move(slot);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_SLOT_POOL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_SLOT_POOL_H_
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief The position of a row in the output of an op, generation is the number of EOEs before the row and seq is
+///     the index of the row since the last EOE.
+struct RowPosition {
+  int64_t generation{-1};
+  int64_t seq{-1};
+};
+
+/// \brief Batch tensors shared by a MapOp and the BatchOp right after it. The map workers write the result of a row
+///     into the slot of the row in its batch tensor, which is a view created by Tensor::CreateSliceView, so the
+///     BatchOp can publish the batch tensor as it is instead of copying every row into a new one.
+///     The batch tensor of a column is allocated when the first row of the batch comes, with the shape and type of
+///     that row. A row of another shape or type, e.g. of a column with variable shape, is left as it is, and the
+///     BatchOp falls back to copying. The pool only hands out the slots, whether a batch is made of the slots of one
+///     batch tensor in order is checked by the BatchOp, so a row dropped or out of order costs a copy but no error.
+class BatchSlotPool {
+ public:
+  /// \brief Constructor
+  /// \param[in] batch_size number of rows in a batch
+  explicit BatchSlotPool(int32_t batch_size) : batch_size_(batch_size) {}
+
+  ~BatchSlotPool() = default;
+
+  /// \brief Get the slot of the row in the batch tensor of the column before the row is computed. The slot has the
+  ///     shape and type of the last row placed in this column, and is nullptr if no row has been placed yet.
+  /// \param[in] position position of the row
+  /// \param[in] column index of the column in the row
+  /// \param[out] slot the slot to write into
+  /// \return Status code
+  Status GetSlot(const RowPosition &position, size_t column, TensorPtr *slot);
+
+  /// \brief Place the tensor of the row into its slot. Nothing is copied if the tensor is the slot already,
+  ///     otherwise it is copied into the slot and replaced by the slot. The tensor is left as it is if its shape or
+  ///     type does not match the batch tensor.
+  /// \param[in] position position of the row
+  /// \param[in] column index of the column in the row
+  /// \param[in, out] tensor the tensor of the row
+  /// \return Status code
+  Status Place(const RowPosition &position, size_t column, TensorPtr *tensor);
+
+ private:
+  struct Entry {
+    TensorPtr base;
+    int32_t num_placed{0};
+  };
+
+  // generation, index of the batch and column
+  using EntryKey = std::tuple<int64_t, int64_t, size_t>;
+
+  // find or create the batch tensor of the row, the entry is nullptr if the shape or type does not match.
+  // @note mux_ should be held
+  Status GetEntry(const RowPosition &position, size_t column, const TensorShape &shape, const DataType &type,
+                  Entry **entry);
+
+  int32_t batch_size_;
+  std::mutex mux_;
+  std::map<EntryKey, Entry> entries_;
+  // the shape and type of the last row placed in every column, which the next slots are created with.
+  std::unordered_map<size_t, std::pair<TensorShape, DataType>> last_shapes_;
+  int64_t generation_{0};
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_SLOT_POOL_H_
@@ -827,7 +827,8 @@ Status DataQueueOp::LaunchParallelCopyThread() {
       MsContext::GetInstance()->get_param<std::string>(MS_CTX_DEVICE_TARGET) == kGPUDevice));
     pool_.push_back(pool);
   }
-  gpu_connector_ = std::make_unique<GpuConnector>(num_workers_, 1, queue_capacity_);
+  gpu_connector_ = std::make_unique<GpuConnector>(num_workers_, 1, queue_capacity_,
+                                                  GlobalContext::config_manager()->first_ready_mode());
   receive_queues_.Init(num_workers_, queue_capacity_);
   RETURN_IF_NOT_OK(receive_queues_.Register(tree_->AllTasks()));
   RETURN_IF_NOT_OK(tree_->LaunchWorkers(static_cast<int>(num_workers_),
@@ -1007,6 +1008,8 @@ Status DataQueueOp::SendDataToGPU() {
   RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&current_row));
   first_fetch_flag_ = true;
   int64_t num_buf = 0;
+  // The EOEs sent to the workers on top of one per epoch, which are not counted as received.
+  int64_t num_extra_eoe = 0;
   bool is_break_loop = false;
 
   MS_LOG(INFO) << "Begin to send data to device, channel name: " << channel_name_;
@@ -1044,8 +1047,13 @@ Status DataQueueOp::SendDataToGPU() {
     UpdateRepeatAndEpochCounter();
     if (current_row.eoe()) {
       MS_LOG(INFO) << "EOE Detected";
-      TensorRow eoe_flag(TensorRow::kFlagEOE);
-      RETURN_IF_NOT_OK(receive_queues_[num_buf++ % num_workers_]->Add(std::move(eoe_flag)));
+      // In first ready mode, every worker forwards the EOE, so the connector knows all batches before it are sent.
+      uint32_t num_eoe = gpu_connector_->first_ready() ? num_workers_ : 1;
+      num_extra_eoe += num_eoe - 1;
+      for (uint32_t i = 0; i < num_eoe; i++) {
+        TensorRow eoe_flag(TensorRow::kFlagEOE);
+        RETURN_IF_NOT_OK(receive_queues_[num_buf++ % num_workers_]->Add(std::move(eoe_flag)));
+      }
     }
 
     if (NoExceptionRaised()) {
@@ -1061,7 +1069,7 @@ Status DataQueueOp::SendDataToGPU() {
     RETURN_IF_NOT_OK(receive_queues_[num_buf++ % num_workers_]->Add(std::move(quit_flag)));
   }
 
-  MS_LOG(INFO) << "Device queue received number of batches and EOEs: " << (num_buf - num_workers_);
+  MS_LOG(INFO) << "Device queue received number of batches and EOEs: " << (num_buf - num_workers_ - num_extra_eoe);
 #else
   MS_LOG(WARNING) << "Gpu queue is not supported in ut tests.";
 #endif
@@ -39,6 +39,9 @@ Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
     TensorRow input_row = in[row];
     TensorRow result_row;
     for (size_t i = 0; i < ops_.size(); i++) {
+      if (i + 1 == ops_.size() && num_rows == 1 && !output_slots_.empty() && ops_[i]->WritesToPresetOutput()) {
+        result_row = output_slots_;
+      }
       // Call compute function for cpu
       Status rc = ops_[i]->Compute(input_row, &result_row);
       if (rc.IsError()) {
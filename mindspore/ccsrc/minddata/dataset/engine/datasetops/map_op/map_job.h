@@ -19,6 +19,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "minddata/dataset/core/tensor.h"
@@ -87,8 +88,13 @@ class MapJob {
 
   virtual MapTargetDevice Type() = 0;
 
+  // Set the tensors the last operation writes its result into, if it supports.
+  // @param output_slots one tensor for each output column
+  void SetOutputSlots(TensorRow output_slots) { output_slots_ = std::move(output_slots); }
+
  protected:
   std::vector<std::shared_ptr<TensorOp>> ops_;
+  TensorRow output_slots_;
 };
 
 }  // namespace dataset
@@ -55,6 +55,7 @@ MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std
       python_mp_(nullptr) {
   // Set connector size via config.
   // If caller didn't specify the out_col_names, assume they are same as the in_columns.
+  first_ready_ = GlobalContext::config_manager()->first_ready_mode();
 
   // Build TensorOp from TensorOperation vector
   // This is to ensure each iterator holds its own copy of the TensorOp objects.
@@ -100,13 +101,15 @@ void MapOp::Print(std::ostream &out, bool show_all) const {
 }
 
 // A helper function that fetch worker map job from local queues and extract the data and map job list
-Status MapOp::FetchNextWork(int32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list) {
+Status MapOp::FetchNextWork(int32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list,
+                            RowPosition *position) {
   std::unique_ptr<MapWorkerJob> worker_job;
   // Fetch the next worker job and TensorRow
   RETURN_IF_NOT_OK(worker_in_queues_[static_cast<const int>(worker_id)]->PopFront(&worker_job));
   // Extract the TensorRow and job list from the map worker job.
   *row = std::move(worker_job->tensor_row);
   *job_list = std::move(worker_job->jobs);
+  *position = worker_job->position;
 
   return Status::OK();
 }
@@ -172,6 +175,8 @@ Status MapOp::operator()() {
   TaskManager::FindMe()->Post();
 
   int64_t ep_step = 0, total_step = 0;
+  // position of the row in the batches after this op, which restart at every EOE as the BatchOp does.
+  RowPosition position{0, 0};
 
   RETURN_IF_NOT_OK(callback_manager_.Begin(CallbackParam(0, ep_step, total_step)));
 
@@ -192,6 +197,8 @@ Status MapOp::operator()() {
       RETURN_IF_NOT_OK(callback_manager_.StepBegin(CallbackParam(op_current_epochs_ + 1, ep_step, total_step)));
 
       std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
+      worker_job->position = position;
+      position.seq++;
       int32_t cur_worker_id = NextWorkerID();
 
       // Populate map worker job for a worker to execute
@@ -204,15 +211,21 @@ Status MapOp::operator()() {
     }
 
     // Propagate the eoe row to worker
-    std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
-    RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::move(worker_job)));
+    for (int32_t i = 0; i < NumCtrlRowsToSend(); i++) {
+      std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(TensorRow(TensorRow::kFlagEOE));
+      RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::move(worker_job)));
+    }
+    position.generation++;
+    position.seq = 0;
     UpdateRepeatAndEpochCounter();
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
   }
   // End() is commented out because it might never be called due to the lack of EOF when EpochCtrl is -1
   // Handle eof logic, this code might never be reached if epoch_ctrl = -1.
-  std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
-  RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::move(worker_job)));
+  for (int32_t i = 0; i < NumCtrlRowsToSend(); i++) {
+    std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(TensorRow(TensorRow::kFlagEOF));
+    RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::move(worker_job)));
+  }
 
   // Quit all workers, this code might never be reached if EpochCtrl is -1.
   for (int32_t wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
@@ -281,10 +294,11 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
 
   TensorRow in_row;
   std::vector<std::shared_ptr<MapJob>> job_list;
+  RowPosition position;
 
   RETURN_IF_NOT_OK(CollectOpInfoStart(this->NameWithID(), "WorkerGet"));
   // Fetch next data row and map job list
-  RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list));
+  RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list, &position));
   RETURN_IF_NOT_OK(CollectOpInfoEnd(this->NameWithID(), "WorkerGet", {{"TensorRowFlags", in_row.FlagName()}}));
   RETURN_IF_NOT_OK(CollectOpInfoStart(this->NameWithID(), "WorkerProcess"));
 
@@ -298,7 +312,7 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
       if (in_row.quit()) {
         break;
       }
-      RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(in_row)));
+      RETURN_IF_NOT_OK(SendToCollector(worker_id, std::move(in_row)));
       if (in_row.wait()) {
         RETURN_IF_NOT_OK(TaskManager::FindMe()->Wait());  // wait for auto tune update workers successful
         TaskManager::FindMe()->Clear();
@@ -306,19 +320,25 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
     } else {
       CHECK_FAIL_RETURN_UNEXPECTED(in_row.size() != 0, "[Internal ERROR] MapOp got an empty TensorRow.");
       TensorRow out_row;
+      if (batch_slots_ != nullptr) {
+        RETURN_IF_NOT_OK(PresetBatchSlots(position, job_list));
+      }
       // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
 #if !defined(BUILD_LITE) && defined(ENABLE_D)
       RETURN_IF_NOT_OK(WorkerCompute(in_row, &out_row, job_list, device_context, stream_id));
 #else
       RETURN_IF_NOT_OK(WorkerCompute(in_row, &out_row, job_list));
 #endif
+      if (batch_slots_ != nullptr && out_row.Flags() == TensorRow::kFlagNone) {
+        RETURN_IF_NOT_OK(PlaceBatchSlots(position, &out_row));
+      }
       RETURN_IF_NOT_OK(CollectOpInfoEnd(this->NameWithID(), "WorkerProcess", {{"TensorRowFlags", in_row.FlagName()}}));
       // Push the row onto the connector for next operator to consume.
-      RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(out_row)));
+      RETURN_IF_NOT_OK(SendToCollector(worker_id, std::move(out_row)));
     }
     RETURN_IF_NOT_OK(CollectOpInfoStart(this->NameWithID(), "WorkerGet"));
     // Fetch next data row and map job list
-    RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list));
+    RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list, &position));
     RETURN_IF_NOT_OK(CollectOpInfoEnd(this->NameWithID(), "WorkerGet", {{"TensorRowFlags", in_row.FlagName()}}));
     RETURN_IF_NOT_OK(CollectOpInfoStart(this->NameWithID(), "WorkerProcess"));
   }
@@ -330,6 +350,28 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
   return Status::OK();
 }
 
+Status MapOp::PresetBatchSlots(const RowPosition &position, const std::vector<std::shared_ptr<MapJob>> &job_list) {
+  // only the single output column of a cpu operation can be written in place.
+  if (out_columns_.size() != 1 || job_list.empty() || job_list.back()->Type() != MapTargetDevice::kCpu) {
+    return Status::OK();
+  }
+  std::shared_ptr<Tensor> slot;
+  RETURN_IF_NOT_OK(batch_slots_->GetSlot(position, OutputColumnIndex(0), &slot));
+  if (slot != nullptr) {
+    job_list.back()->SetOutputSlots(TensorRow(1, slot));
+  }
+  return Status::OK();
+}
+
+Status MapOp::PlaceBatchSlots(const RowPosition &position, TensorRow *out_row) {
+  RETURN_UNEXPECTED_IF_NULL(out_row);
+  for (size_t i = 0; i < out_columns_.size() && i < out_row->size(); i++) {
+    size_t column = OutputColumnIndex(i);
+    RETURN_IF_NOT_OK(batch_slots_->Place(position, column, &(*out_row)[column]));
+  }
+  return Status::OK();
+}
+
 #if !defined(BUILD_LITE) && defined(ENABLE_D)
 Status MapOp::WorkerCompute(const TensorRow &in_row, TensorRow *out_row,
                             const std::vector<std::shared_ptr<MapJob>> &job_list, device::DeviceContext *device_context,
@@ -26,6 +26,7 @@
 #include "minddata/dataset/api/python/python_mp.h"
 #include "minddata/dataset/callback/ds_callback.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
+#include "minddata/dataset/engine/datasetops/batch_slot_pool.h"
 #include "minddata/dataset/engine/datasetops/map_op/map_job.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/kernels/tensor_op.h"
@@ -43,6 +44,7 @@ struct MapWorkerJob {
   explicit MapWorkerJob(TensorRow tr) : tensor_row(std::move(tr)) {}
   std::vector<std::shared_ptr<MapJob>> jobs;
   TensorRow tensor_row;
+  RowPosition position;
 };
 
 // MapOp class implements the Map operator. It will apply a list of operations to each record specified by column names.
@@ -151,12 +153,28 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
 
   Status GetNextRowPullMode(TensorRow *const row) override;
 
+  /// Let the workers write the output columns into the batch tensors of the BatchOp right after this op
+  /// \param batch_slots the batch tensors shared with the BatchOp
+  void SetBatchSlots(std::shared_ptr<BatchSlotPool> batch_slots) { batch_slots_ = std::move(batch_slots); }
+
  private:
   // A helper function to create jobs for workers.
   Status GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job, int32_t worker_id);
 
   // A helper function that fetch worker map job from local queues and extract the data and map job list
-  Status FetchNextWork(int32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list);
+  Status FetchNextWork(int32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list,
+                       RowPosition *position);
+
+  // Index of the i-th output column in the output row.
+  size_t OutputColumnIndex(size_t i) const {
+    return in_columns_.size() == out_columns_.size() ? to_process_indices_[i] : i;
+  }
+
+  // Give the slot of the row in the batch tensor to the last operation, which may write the result into it.
+  Status PresetBatchSlots(const RowPosition &position, const std::vector<std::shared_ptr<MapJob>> &job_list);
+
+  // Move the output columns of the row into their slots in the batch tensors.
+  Status PlaceBatchSlots(const RowPosition &position, TensorRow *out_row);
 
   // TensorOperations to be read
   std::vector<std::shared_ptr<TensorOperation>> tensor_operations_;
@@ -180,6 +198,8 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
 
   std::shared_ptr<PythonMultiprocessingRuntime> python_mp_;  // python multiprocessing instance
 
+  std::shared_ptr<BatchSlotPool> batch_slots_;  // batch tensors to write the output into, set by the next BatchOp
+
   // Private function for worker/thread to loop continuously. It comprises the main
   // logic of MapOp: getting the data from previous Op, validating user specified column names,
   // applying a list of TensorOps to each of the data, process the results and then
@@ -28,6 +28,8 @@
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
+#include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/mpmc_queue.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -197,6 +199,7 @@ class ParallelOp : public DatasetOp {
     RETURN_IF_NOT_OK(worker_in_queues_.Register(tree_->AllTasks()));
     RETURN_IF_NOT_OK(worker_out_queues_.Register(tree_->AllTasks()));
     RETURN_IF_NOT_OK(wait_for_workers_post_.Register(tree_->AllTasks()));
+    RETURN_IF_NOT_OK(collector_cv_.Register(tree_->AllTasks()->GetIntrpService()));
 
     RETURN_IF_NOT_OK(tree_->LaunchWorkers(num_workers_,
                                           std::bind(&ParallelOp::WorkerEntry, this, std::placeholders::_1),
@@ -360,9 +363,26 @@ class ParallelOp : public DatasetOp {
     SetStrategy();
     // num_step of current epoch and the total
     ep_step_ = 0, total_step_ = 0;
+    // In first ready mode, the workers which have sent the current eoe or eof.
+    std::vector<bool> finished_workers;
+    int32_t num_finished_workers = 0;
     do {
       TensorRow row;
-      RETURN_IF_NOT_OK(worker_out_queues_[static_cast<const int>(num_rows++ % NumWorkers())]->PopFront(&row));
+      if (first_ready_) {
+        int32_t worker_id = 0;
+        RETURN_IF_NOT_OK(PopFirstReady(&row, &finished_workers, &worker_id));
+        if (row.eoe() || row.eof()) {
+          // The eoe or eof is sent to every worker, handle it once all the workers have sent it.
+          finished_workers[worker_id] = true;
+          if (++num_finished_workers < NumWorkers()) {
+            continue;
+          }
+          num_finished_workers = 0;
+          (void)std::fill(finished_workers.begin(), finished_workers.end(), false);
+        }
+      } else {
+        RETURN_IF_NOT_OK(worker_out_queues_[static_cast<const int>(num_rows++ % NumWorkers())]->PopFront(&row));
+      }
       if (row.wait()) {
         // When collector receives the signal from worker thread, it increments an atomic int
         // If num_worker signals are received, wakes up the main thread
@@ -389,6 +409,57 @@ class ParallelOp : public DatasetOp {
     return Status::OK();
   }
 
+  /// The number of times the main thread sends an eoe or eof to the workers. In first ready mode, the collector pops
+  /// the rows of whichever worker is ready first, so an eoe or eof is sent to every worker, and the collector knows all
+  /// the rows in front of it have been collected once it is received from all the workers.
+  /// \return The number of times to send an eoe or eof
+  int32_t NumCtrlRowsToSend() { return first_ready_ ? NumWorkers() : 1; }
+
+  /// Push a row produced by a worker to its output queue, the collector is notified in first ready mode.
+  /// \param worker_id The id of the worker
+  /// \param row The row to push
+  /// \return Status The status code returned
+  Status SendToCollector(int32_t worker_id, S &&row) {
+    RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(row)));
+    if (first_ready_) {
+      // Take the lock before notifying, so the collector can not miss it between checking the queues and waiting.
+      {
+        std::unique_lock<std::mutex> lock(collector_mux_);
+      }
+      collector_cv_.NotifyAll();
+    }
+    return Status::OK();
+  }
+
+  /// Pop a row from the output queue of whichever worker is ready first, starting from the worker after the last
+  /// popped one. The workers flagged in `finished_workers` are skipped.
+  /// \param row The popped row
+  /// \param finished_workers The flags of the workers to skip, resized to the current number of workers
+  /// \param worker_id The id of the worker popped from
+  /// \return Status The status code returned
+  Status PopFirstReady(S *row, std::vector<bool> *finished_workers, int32_t *worker_id) {
+    int32_t num_workers = NumWorkers();
+    if (finished_workers->size() < static_cast<size_t>(num_workers)) {
+      finished_workers->resize(num_workers, false);
+    }
+    {
+      std::unique_lock<std::mutex> lock(collector_mux_);
+      RETURN_IF_NOT_OK(collector_cv_.Wait(&lock, [this, num_workers, finished_workers, worker_id]() {
+        for (int32_t offset = 0; offset < num_workers; offset++) {
+          int32_t id = (next_collect_id_ + offset) % num_workers;
+          if (!(*finished_workers)[id] && !worker_out_queues_[id]->empty()) {
+            *worker_id = id;
+            return true;
+          }
+        }
+        return false;
+      }));
+    }
+    next_collect_id_ = (*worker_id + 1) % num_workers;
+    // The collector is the only consumer, so the queue found non-empty can not be emptied in between.
+    return worker_out_queues_[*worker_id]->PopFront(row);
+  }
+
   // Wait post used to perform the pausing logic
   WaitPost wait_for_workers_post_;
 
@@ -401,6 +472,10 @@ class ParallelOp : public DatasetOp {
   /// Whether or not to sync worker threads at the end of each epoch
   bool epoch_sync_flag_;
 
+  /// Whether the collector pops the rows of whichever worker is ready first instead of round robin, only the ops which
+  /// send each eoe and eof NumCtrlRowsToSend() times and push rows by SendToCollector can enable it
+  bool first_ready_{false};
+
   /// The number of worker threads
   int32_t num_workers_;
 
@@ -444,10 +519,16 @@ class ParallelOp : public DatasetOp {
 
   /// The size of input/output worker queeus
   int32_t worker_connector_size_;
-  /// queues to hold the input rows to workers
-  QueueList<T> worker_in_queues_;
+  /// queues to hold the input rows to workers, the lock-free MPMCQueue avoids waking all the waiters on every row
+  QueueList<T, MPMCQueue<T>> worker_in_queues_;
   /// queues to hold the output from workers
-  QueueList<S> worker_out_queues_;
+  QueueList<S, MPMCQueue<S>> worker_out_queues_;
+
+  /// lock and condition variable for the collector to wait for the output of workers in first ready mode
+  std::mutex collector_mux_;
+  CondVar collector_cv_;
+  /// the worker id from which the collector starts searching a ready row in first ready mode
+  int32_t next_collect_id_{0};
 
   // lock for num_workers_ read and write
   mutable std::mutex mux_;
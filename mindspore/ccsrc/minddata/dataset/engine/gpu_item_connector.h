@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GPU_ITEM_CONNECTOR_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GPU_ITEM_CONNECTOR_H_
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -37,8 +38,8 @@ struct GpuConnectorItem {
 
 class GpuConnector : public Connector<GpuConnectorItem> {
  public:
-  GpuConnector(int32_t num_producers, int32_t num_consumers, int32_t queue_capacity)
-      : Connector<GpuConnectorItem>(num_producers, num_consumers, queue_capacity) {
+  GpuConnector(int32_t num_producers, int32_t num_consumers, int32_t queue_capacity, bool first_ready = false)
+      : Connector<GpuConnectorItem>(num_producers, num_consumers, queue_capacity, first_ready) {
     for (int i = 0; i < num_producers; i++) {
       is_queue_finished_.push_back(false);
     }
@@ -52,6 +53,9 @@ class GpuConnector : public Connector<GpuConnectorItem> {
 
   Status Pop(int32_t worker_id, GpuConnectorItem *result) noexcept override {
     RETURN_UNEXPECTED_IF_NULL(result);
+    if (first_ready_) {
+      return PopFirstReadyItem(result);
+    }
     {
       MS_ASSERT(worker_id < num_consumers_);
       std::unique_lock<std::mutex> lock(m_);
@@ -83,7 +87,33 @@ class GpuConnector : public Connector<GpuConnectorItem> {
   }
 
  private:
+  // In first ready mode, the EOE and EOF are sent by every producer. The queue which has sent one is not popped
+  // anymore, and the EOE or EOF is delivered once all the producers have sent it, so the items of different epochs
+  // are never mixed.
+  Status PopFirstReadyItem(GpuConnectorItem *result) {
+    std::unique_lock<std::mutex> lock(m_);
+    while (true) {
+      size_t queue_index = 0;
+      RETURN_IF_NOT_OK(PopFirstReady(&lock, result, is_queue_finished_, &queue_index));
+      // empty data_item and eoe_flag=false is EOF
+      bool is_eof = result->data_item.empty() && !result->eoe_flag;
+      if (!result->eoe_flag && !is_eof) {
+        return Status::OK();
+      }
+      is_queue_finished_[queue_index] = true;
+      if (++num_finished_queues_ < num_producers_) {
+        continue;
+      }
+      num_finished_queues_ = 0;
+      if (result->eoe_flag) {
+        (void)std::fill(is_queue_finished_.begin(), is_queue_finished_.end(), false);
+      }
+      return Status::OK();
+    }
+  }
+
   std::vector<bool> is_queue_finished_;
+  int32_t num_finished_queues_{0};
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -54,7 +54,12 @@ Status DatasetCache::from_json(nlohmann::json json_obj, std::shared_ptr<DatasetC
     if (json_cache.find("cache_prefetch_size") != json_cache.end()) {
       prefetch_sz = json_cache["cache_prefetch_size"];
     }
-    *cache = std::make_shared<DatasetCacheImpl>(id, mem_sz, spill, hostname_c, port, num_connections, prefetch_sz);
+    auto cache_impl =
+      std::make_shared<DatasetCacheImpl>(id, mem_sz, spill, hostname_c, port, num_connections, prefetch_sz);
+    if (json_cache.find("compress") != json_cache.end()) {
+      cache_impl->SetCompress(json_cache["compress"]);
+    }
+    *cache = cache_impl;
   }
   return Status::OK();
 }
@@ -31,7 +31,7 @@ Status DatasetCacheImpl::Build() {
   }
 
   CacheClient::Builder builder;
-  builder.SetSessionId(session_id_).SetCacheMemSz(cache_mem_sz_).SetSpill(spill_);
+  builder.SetSessionId(session_id_).SetCacheMemSz(cache_mem_sz_).SetSpill(spill_).SetCompress(compress_);
   if (hostname_) {
     (void)builder.SetHostname(hostname_.value());
   }
@@ -98,6 +98,9 @@ Status DatasetCacheImpl::to_json(nlohmann::json *out_json) {
   if (prefetch_sz_) {
     args["cache_prefetch_size"] = prefetch_sz_.value();
   }
+  if (compress_) {
+    args["compress"] = compress_;
+  }
   *out_json = args;
   return Status::OK();
 }
@@ -75,6 +75,9 @@ class DatasetCacheImpl : public DatasetCache {
 
   Status to_json(nlohmann::json *out_json) override;
 
+  /// \brief Setter function to compress the rows cached by the server (default=False).
+  void SetCompress(bool compress) { compress_ = compress; }
+
   ~DatasetCacheImpl() override = default;
 
  private:
@@ -86,6 +89,7 @@ class DatasetCacheImpl : public DatasetCache {
   std::optional<int32_t> port_;
   std::optional<int32_t> num_connections_;
   std::optional<int32_t> prefetch_sz_;
+  bool compress_{false};
 };
 }  // namespace dataset
 }  // namespace mindspore
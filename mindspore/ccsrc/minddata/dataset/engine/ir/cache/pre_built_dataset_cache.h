@@ -34,6 +34,7 @@ class PreBuiltDatasetCache : public DatasetCacheImpl {
   explicit PreBuiltDatasetCache(std::shared_ptr<CacheClient> cc)
       : DatasetCacheImpl(cc->session_id(), cc->GetCacheMemSz(), cc->isSpill(), StringToChar(cc->GetHostname()),
                          cc->GetPort(), cc->GetNumConnections(), cc->GetPrefetchSize()) {
+    compress_ = cc->isCompress();
     cache_client_ = std::move(cc);
   }
 
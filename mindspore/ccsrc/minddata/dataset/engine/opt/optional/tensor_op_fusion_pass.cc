@@ -24,15 +24,78 @@
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/fused_image_transform_ir.h"
+#include "minddata/dataset/kernels/ir/vision/horizontal_flip_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_horizontal_flip_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_vertical_flip_ir.h"
+#include "minddata/dataset/kernels/ir/vision/rescale_ir.h"
+#include "minddata/dataset/kernels/ir/vision/vertical_flip_ir.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// a single op is not worth fusing.
+constexpr size_t kMinFusedImageTransforms = 2;
+
+// Gets the step of an op which can be fused after the steps so far, is_chw tells whether HWC2CHW is one of them.
+bool GetImageTransformStep(const std::shared_ptr<TensorOperation> &op, bool is_chw, ImageTransformStep *step) {
+  if (op == nullptr) {
+    return false;
+  }
+  nlohmann::json args;
+  if (op->to_json(&args).IsError()) {
+    return false;
+  }
+  *step = ImageTransformStep();
+  auto name = op->Name();
+  // the flips are done in HWC only, and HWC2CHW is done once only.
+  if (name == vision::kHorizontalFlipOperation || name == vision::kRandomHorizontalFlipOperation) {
+    step->type = ImageTransformStep::Type::kHorizontalFlip;
+    step->prob = name == vision::kHorizontalFlipOperation ? 1.0F : args["prob"].get<float>();
+    return !is_chw;
+  }
+  if (name == vision::kVerticalFlipOperation || name == vision::kRandomVerticalFlipOperation) {
+    step->type = ImageTransformStep::Type::kVerticalFlip;
+    step->prob = name == vision::kVerticalFlipOperation ? 1.0F : args["prob"].get<float>();
+    return !is_chw;
+  }
+  if (name == vision::kHwcToChwOperation) {
+    step->type = ImageTransformStep::Type::kHwcToChw;
+    return !is_chw;
+  }
+  if (name == vision::kRescaleOperation) {
+    step->type = ImageTransformStep::Type::kRescale;
+    step->param0 = {args["rescale"].get<float>()};
+    step->param1 = {args["shift"].get<float>()};
+    return true;
+  }
+  if (name == vision::kNormalizeOperation) {
+    step->type = ImageTransformStep::Type::kNormalize;
+    step->param0 = args["mean"].get<std::vector<float>>();
+    step->param1 = args["std"].get<std::vector<float>>();
+    step->is_hwc = args["is_hwc"].get<bool>();
+    return args["device_target"] == "CPU" && step->is_hwc != is_chw;
+  }
+  if (name == transforms::kTypeCastOperation) {
+    step->type = ImageTransformStep::Type::kToFloat32;
+    return args["data_type"] == "float32";
+  }
+  return false;
+}
+}  // namespace
 
 Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
   RETURN_UNEXPECTED_IF_NULL(node);
   RETURN_UNEXPECTED_IF_NULL(modified);
+  RETURN_IF_NOT_OK(FuseDecodeRandomResizedCrop(node, modified));
+  return FuseImageTransforms(node, modified);
+}
+
+Status TensorOpFusionPass::FuseDecodeRandomResizedCrop(const std::shared_ptr<MapNode> &node, bool *const modified) {
   std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
 
   // start temporary code, to deal with pre-built TensorOperation
@@ -66,5 +129,37 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
   *modified = true;
   return Status::OK();
 }
+
+Status TensorOpFusionPass::FuseImageTransforms(const std::shared_ptr<MapNode> &node, bool *const modified) {
+  // the fused op runs on a single column only.
+  RETURN_OK_IF_TRUE(node->InputColumns().size() > 1);
+  std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
+  std::vector<std::shared_ptr<TensorOperation>> new_ops;
+  bool fused = false;
+  size_t begin = 0;
+  while (begin < ops.size()) {
+    std::vector<ImageTransformStep> steps;
+    bool is_chw = false;
+    ImageTransformStep step;
+    while (begin + steps.size() < ops.size() && GetImageTransformStep(ops[begin + steps.size()], is_chw, &step)) {
+      is_chw = is_chw || step.type == ImageTransformStep::Type::kHwcToChw;
+      steps.push_back(step);
+    }
+    if (steps.size() < kMinFusedImageTransforms) {
+      new_ops.push_back(ops[begin]);
+      ++begin;
+      continue;
+    }
+    MS_LOG(INFO) << "Fusing " << steps.size() << " image transforms into one FusedImageTransform.";
+    (void)new_ops.emplace_back(std::make_shared<vision::FusedImageTransformOperation>(steps));
+    begin += steps.size();
+    fused = true;
+  }
+  if (fused) {
+    node->setOperations(new_ops);
+    *modified = true;
+  }
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -31,6 +31,19 @@ class TensorOpFusionPass : public IRNodePass {
   /// \param[in, out] *modified indicates whether the node has been visited
   /// \return Status The status code returned
   Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+  /// \brief Fuses Decode and RandomResizedCrop into RandomCropDecodeResize
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates whether the node has been modified
+  /// \return Status The status code returned
+  Status FuseDecodeRandomResizedCrop(const std::shared_ptr<MapNode> &node, bool *const modified);
+
+  /// \brief Fuses every chain of flips, Rescale, Normalize, HWC2CHW and TypeCast to float32 into one
+  ///     FusedImageTransform, which goes over the image only once
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates whether the node has been modified
+  /// \return Status The status code returned
+  Status FuseImageTransforms(const std::shared_ptr<MapNode> &node, bool *const modified);
 };
 }  // namespace dataset
 }  // namespace mindspore
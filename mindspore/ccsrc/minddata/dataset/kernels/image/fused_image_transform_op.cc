@@ -0,0 +1,295 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/fused_image_transform_op.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "minddata/dataset/kernels/image/vertical_flip_op.h"
+#include "minddata/dataset/util/random.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Rescale or Normalize, with the parameters of every channel expanded to a whole row.
+struct RowArithmetic {
+  ImageTransformStep::Type type;
+  std::vector<float> param0;
+  std::vector<float> param1;
+};
+
+// copy a row of the input to the buffer, from right to left if it is flipped horizontally.
+template <typename TIn, typename TOut>
+void GatherRow(const TIn *src_row, dsize_t width, dsize_t channels, bool h_flip, TOut *row) {
+  if (!h_flip) {
+    for (dsize_t i = 0; i < width * channels; ++i) {
+      row[i] = static_cast<TOut>(src_row[i]);
+    }
+    return;
+  }
+  for (dsize_t x = 0; x < width; ++x) {
+    const TIn *pixel = src_row + (width - 1 - x) * channels;
+    TOut *dst = row + x * channels;
+    for (dsize_t c = 0; c < channels; ++c) {
+      dst[c] = static_cast<TOut>(pixel[c]);
+    }
+  }
+}
+
+// store the buffer as the row y of an HWC image, or as the row y of every channel of a CHW image.
+template <typename T>
+void StoreRow(const T *row, dsize_t y, dsize_t height, dsize_t width, dsize_t channels, bool is_chw, T *out) {
+  if (!is_chw) {
+    (void)std::copy(row, row + width * channels, out + y * width * channels);
+    return;
+  }
+  for (dsize_t c = 0; c < channels; ++c) {
+    T *dst = out + (c * height + y) * width;
+    for (dsize_t x = 0; x < width; ++x) {
+      dst[x] = row[x * channels + c];
+    }
+  }
+}
+
+// repeat the parameters of the channels over a row, then the arithmetic needs no channel index.
+std::vector<float> ExpandToRow(const std::vector<float> &param, dsize_t width, dsize_t channels) {
+  std::vector<float> row(width * channels);
+  for (dsize_t x = 0; x < width; ++x) {
+    for (dsize_t c = 0; c < channels; ++c) {
+      row[x * channels + c] = param.size() == 1 ? param[0] : param[c];
+    }
+  }
+  return row;
+}
+}  // namespace
+
+FusedImageTransformOp::FusedImageTransformOp(std::vector<ImageTransformStep> steps) : steps_(std::move(steps)) {
+  bool is_chw = false;
+  for (const auto &step : steps_) {
+    switch (step.type) {
+      case ImageTransformStep::Type::kHorizontalFlip:
+        (void)ops_.emplace_back(std::make_shared<HorizontalFlipOp>());
+        fusible_ = fusible_ && !is_chw;
+        break;
+      case ImageTransformStep::Type::kVerticalFlip:
+        (void)ops_.emplace_back(std::make_shared<VerticalFlipOp>());
+        fusible_ = fusible_ && !is_chw;
+        break;
+      case ImageTransformStep::Type::kRescale:
+        (void)ops_.emplace_back(std::make_shared<RescaleOp>(step.param0[0], step.param1[0]));
+        break;
+      case ImageTransformStep::Type::kNormalize:
+        (void)ops_.emplace_back(std::make_shared<NormalizeOp>(step.param0, step.param1, step.is_hwc));
+        // the channel of Normalize must be the channel of the current layout.
+        fusible_ = fusible_ && step.is_hwc != is_chw;
+        break;
+      case ImageTransformStep::Type::kHwcToChw:
+        (void)ops_.emplace_back(std::make_shared<HwcToChwOp>());
+        fusible_ = fusible_ && !is_chw;
+        is_chw = true;
+        break;
+      case ImageTransformStep::Type::kToFloat32:
+        (void)ops_.emplace_back(std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT32)));
+        break;
+    }
+    (void)generators_.emplace_back(GetSeed());
+    if (step.prob < 1.0F) {
+      is_deterministic_ = false;
+    }
+  }
+}
+
+void FusedImageTransformOp::Print(std::ostream &out) const {
+  out << Name() << ":";
+  for (const auto &op : ops_) {
+    out << " " << op->Name();
+  }
+  out << std::endl;
+}
+
+void FusedImageTransformOp::SetSeed(uint32_t seed) {
+  // every op of a map is seeded the same, so are the steps here.
+  for (auto &generator : generators_) {
+    generator.seed(seed);
+  }
+}
+
+bool FusedImageTransformOp::CanFuse(const std::shared_ptr<Tensor> &input) const {
+  if (!fusible_ || input->Rank() != kDefaultImageRank || input->Size() == 0) {
+    return false;
+  }
+  if (input->type() != DataType::DE_UINT8 && input->type() != DataType::DE_FLOAT32) {
+    return false;
+  }
+  auto channels = static_cast<size_t>(input->shape()[kChannelIndexHWC]);
+  return std::all_of(steps_.begin(), steps_.end(), [channels](const ImageTransformStep &step) {
+    if (step.type == ImageTransformStep::Type::kRescale) {
+      return step.param0.size() == 1 && step.param1.size() == 1;
+    }
+    if (step.type == ImageTransformStep::Type::kNormalize) {
+      return step.param0.size() == step.param1.size() && (step.param0.size() == 1 || step.param0.size() == channels);
+    }
+    return true;
+  });
+}
+
+Status FusedImageTransformOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  // draw for every random flip first, the generators go the same way whether the input is fused or not.
+  std::vector<bool> apply(steps_.size(), true);
+  for (size_t i = 0; i < steps_.size(); ++i) {
+    if (steps_[i].prob < 1.0F) {
+      std::bernoulli_distribution distribution(steps_[i].prob);
+      apply[i] = distribution(generators_[i]);
+    }
+  }
+  if (!CanFuse(input)) {
+    return ComputeInSequence(input, apply, output);
+  }
+  if (input->type() == DataType::DE_UINT8) {
+    return ComputeFused<uint8_t>(input, apply, output);
+  }
+  return ComputeFused<float>(input, apply, output);
+}
+
+template <typename T>
+Status FusedImageTransformOp::ComputeFused(const std::shared_ptr<Tensor> &input, const std::vector<bool> &apply,
+                                           std::shared_ptr<Tensor> *output) {
+  const dsize_t height = input->shape()[0];
+  const dsize_t width = input->shape()[1];
+  const dsize_t channels = input->shape()[kChannelIndexHWC];
+  bool h_flip = false;
+  bool v_flip = false;
+  bool is_chw = false;
+  bool to_float = false;
+  std::vector<RowArithmetic> arithmetic;
+  for (size_t i = 0; i < steps_.size(); ++i) {
+    if (!apply[i]) {
+      continue;
+    }
+    const auto &step = steps_[i];
+    switch (step.type) {
+      case ImageTransformStep::Type::kHorizontalFlip:
+        h_flip = !h_flip;
+        break;
+      case ImageTransformStep::Type::kVerticalFlip:
+        v_flip = !v_flip;
+        break;
+      case ImageTransformStep::Type::kHwcToChw:
+        is_chw = true;
+        break;
+      case ImageTransformStep::Type::kToFloat32:
+        to_float = true;
+        break;
+      case ImageTransformStep::Type::kRescale:
+      case ImageTransformStep::Type::kNormalize:
+        to_float = true;
+        arithmetic.push_back(
+          {step.type, ExpandToRow(step.param0, width, channels), ExpandToRow(step.param1, width, channels)});
+        break;
+    }
+  }
+
+  TensorShape out_shape = is_chw ? TensorShape({channels, height, width}) : input->shape();
+  DataType out_type = to_float ? DataType(DataType::DE_FLOAT32) : input->type();
+  // write into the preset output if it fits, e.g. a slot of the batch tensor given by MapOp.
+  if (*output == nullptr || (*output)->shape() != out_shape || (*output)->type() != out_type ||
+      (*output)->GetBuffer() == input->GetBuffer()) {
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(out_shape, out_type, output));
+  }
+  const auto *src = reinterpret_cast<const T *>(input->GetBuffer());
+  const dsize_t row_len = width * channels;
+  if (!to_float) {
+    // only the layout changes.
+    auto *dst = reinterpret_cast<T *>((*output)->GetMutableBuffer());
+    std::vector<T> row(row_len);
+    for (dsize_t y = 0; y < height; ++y) {
+      const T *src_row = src + (v_flip ? height - 1 - y : y) * row_len;
+      GatherRow(src_row, width, channels, h_flip, row.data());
+      StoreRow(row.data(), y, height, width, channels, is_chw, dst);
+    }
+    return Status::OK();
+  }
+
+  auto *dst = reinterpret_cast<float *>((*output)->GetMutableBuffer());
+  std::vector<float> row(row_len);
+  for (dsize_t y = 0; y < height; ++y) {
+    const T *src_row = src + (v_flip ? height - 1 - y : y) * row_len;
+    float *buf = row.data();
+    GatherRow(src_row, width, channels, h_flip, buf);
+    for (const auto &step : arithmetic) {
+      const float *param0 = step.param0.data();
+      const float *param1 = step.param1.data();
+      if (step.type == ImageTransformStep::Type::kRescale) {
+        for (dsize_t i = 0; i < row_len; ++i) {
+          buf[i] = buf[i] * param0[i] + param1[i];
+        }
+      } else {
+        // the same expression as Normalize, so the results are the same.
+        for (dsize_t i = 0; i < row_len; ++i) {
+          buf[i] = (buf[i] - param0[i]) / param1[i];
+        }
+      }
+    }
+    StoreRow(buf, y, height, width, channels, is_chw, dst);
+  }
+  return Status::OK();
+}
+
+Status FusedImageTransformOp::ComputeInSequence(const std::shared_ptr<Tensor> &input, const std::vector<bool> &apply,
+                                                std::shared_ptr<Tensor> *output) {
+  std::shared_ptr<Tensor> image = input;
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    if (!apply[i]) {
+      continue;
+    }
+    std::shared_ptr<Tensor> out;
+    RETURN_IF_NOT_OK(ops_[i]->Compute(image, &out));
+    image = std::move(out);
+  }
+  *output = std::move(image);
+  return Status::OK();
+}
+
+Status FusedImageTransformOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  std::vector<TensorShape> shapes = inputs;
+  for (const auto &op : ops_) {
+    std::vector<TensorShape> op_outputs;
+    RETURN_IF_NOT_OK(op->OutputShape(shapes, op_outputs));
+    shapes = std::move(op_outputs);
+  }
+  outputs = std::move(shapes);
+  return Status::OK();
+}
+
+Status FusedImageTransformOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  std::vector<DataType> types = inputs;
+  for (const auto &op : ops_) {
+    std::vector<DataType> op_outputs;
+    RETURN_IF_NOT_OK(op->OutputType(types, op_outputs));
+    types = std::move(op_outputs);
+  }
+  outputs = std::move(types);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
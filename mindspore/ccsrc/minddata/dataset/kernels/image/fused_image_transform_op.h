@@ -0,0 +1,90 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_TRANSFORM_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_TRANSFORM_OP_H_
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief One per-pixel transform of a FusedImageTransformOp.
+struct ImageTransformStep {
+  enum class Type { kHorizontalFlip, kVerticalFlip, kRescale, kNormalize, kHwcToChw, kToFloat32 };
+
+  Type type;
+  // the probability to apply a flip, the flip is not random if it is 1.
+  float prob{1.0};
+  // Rescale: {rescale} and {shift}; Normalize: mean and std.
+  std::vector<float> param0;
+  std::vector<float> param1;
+  // Normalize only.
+  bool is_hwc{true};
+};
+
+/// \brief Runs a chain of flips, Rescale, Normalize, HWC2CHW and the cast to float32 in a single pass over the
+///     image. A row of the output is gathered from the (flipped) row of the input, goes through all the arithmetic in
+///     a buffer which stays in the cache, and is stored in HWC or CHW. The flips, Normalize, HWC2CHW and the cast
+///     give the same results as running the ops one by one. Rescale may be compiled to an fma, so its result may differ
+///     from the standalone op by one float32 rounding, i.e. about 1 ulp. The random flips draw from their own generators
+///     as the standalone ops do.
+class FusedImageTransformOp : public TensorOp {
+ public:
+  explicit FusedImageTransformOp(std::vector<ImageTransformStep> steps);
+
+  ~FusedImageTransformOp() override = default;
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  void SetSeed(uint32_t seed) override;
+
+  bool WritesToPresetOutput() const override { return true; }
+
+  std::string Name() const override { return kFusedImageTransformOp; }
+
+ private:
+  // whether the single pass can handle the input, or the steps are run one by one.
+  bool CanFuse(const std::shared_ptr<Tensor> &input) const;
+
+  template <typename T>
+  Status ComputeFused(const std::shared_ptr<Tensor> &input, const std::vector<bool> &apply,
+                      std::shared_ptr<Tensor> *output);
+
+  Status ComputeInSequence(const std::shared_ptr<Tensor> &input, const std::vector<bool> &apply,
+                           std::shared_ptr<Tensor> *output);
+
+  std::vector<ImageTransformStep> steps_;
+  // the standalone op of every step, the random flips are the deterministic ones and applied as drawn.
+  std::vector<std::shared_ptr<TensorOp>> ops_;
+  // one generator a step, only the random flips use them.
+  std::vector<std::mt19937> generators_;
+  bool fusible_{true};
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_TRANSFORM_OP_H_
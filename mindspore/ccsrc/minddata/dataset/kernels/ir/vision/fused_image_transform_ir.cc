@@ -0,0 +1,73 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/ir/vision/fused_image_transform_ir.h"
+
+#include <algorithm>
+
+#include "minddata/dataset/kernels/ir/validators.h"
+
+namespace mindspore {
+namespace dataset {
+namespace vision {
+// FusedImageTransformOperation
+FusedImageTransformOperation::FusedImageTransformOperation(const std::vector<ImageTransformStep> &steps)
+    : TensorOperation(std::any_of(steps.begin(), steps.end(),
+                                  [](const ImageTransformStep &step) { return step.prob < 1.0F; })),
+      steps_(steps) {}
+
+FusedImageTransformOperation::~FusedImageTransformOperation() = default;
+
+std::string FusedImageTransformOperation::Name() const { return kFusedImageTransformOperation; }
+
+Status FusedImageTransformOperation::ValidateParams() {
+  CHECK_FAIL_RETURN_UNEXPECTED(!steps_.empty(), "FusedImageTransform: steps can not be empty.");
+  for (const auto &step : steps_) {
+    RETURN_IF_NOT_OK(ValidateProbability("FusedImageTransform", step.prob));
+    if (step.type == ImageTransformStep::Type::kRescale) {
+      CHECK_FAIL_RETURN_UNEXPECTED(step.param0.size() == 1 && step.param1.size() == 1,
+                                   "FusedImageTransform: Rescale should have one rescale and one shift.");
+    } else if (step.type == ImageTransformStep::Type::kNormalize) {
+      CHECK_FAIL_RETURN_UNEXPECTED(!step.param0.empty() && step.param0.size() == step.param1.size(),
+                                   "FusedImageTransform: mean and std of Normalize should be of the same size.");
+    }
+  }
+  return Status::OK();
+}
+
+std::shared_ptr<TensorOp> FusedImageTransformOperation::Build() {
+  return std::make_shared<FusedImageTransformOp>(steps_);
+}
+
+Status FusedImageTransformOperation::to_json(nlohmann::json *out_json) {
+  RETURN_UNEXPECTED_IF_NULL(out_json);
+  nlohmann::json steps = nlohmann::json::array();
+  for (const auto &step : steps_) {
+    nlohmann::json args;
+    args["type"] = static_cast<int32_t>(step.type);
+    args["prob"] = step.prob;
+    args["param0"] = step.param0;
+    args["param1"] = step.param1;
+    args["is_hwc"] = step.is_hwc;
+    steps.push_back(args);
+  }
+  nlohmann::json args;
+  args["steps"] = steps;
+  *out_json = args;
+  return Status::OK();
+}
+}  // namespace vision
+}  // namespace dataset
+}  // namespace mindspore
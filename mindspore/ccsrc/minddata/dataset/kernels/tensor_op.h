@@ -108,6 +108,7 @@ constexpr char kDvppSolarizeOp[] = "DvppSolarizeOp";
 constexpr char kDvppVerticalFlipOp[] = "DvppVerticalFlipOp";
 constexpr char kEqualizeOp[] = "EqualizeOp";
 constexpr char kEraseOp[] = "EraseOp";
+constexpr char kFusedImageTransformOp[] = "FusedImageTransformOp";
 constexpr char kGaussianBlurOp[] = "GaussianBlurOp";
 constexpr char kHorizontalFlipOp[] = "HorizontalFlipOp";
 constexpr char kHwcToChwOp[] = "HWC2CHWOp";
@@ -361,6 +362,11 @@ class TensorOp {
 
   virtual void SetSeed(uint32_t seed) {}
 
+  // Returns true if the op writes its result into the tensor already in *output when the shape and type match,
+  // which lets the caller give the memory to write into. Otherwise *output is always replaced.
+  // @return true/false
+  virtual bool WritesToPresetOutput() const { return false; }
+
  protected:
   bool is_deterministic_{true};
 };
@@ -0,0 +1,238 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_MPMC_QUEUE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_MPMC_QUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/services.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+// A bounded multi-producer multi-consumer queue with the same interface as Queue.
+//
+// The elements are kept in a ring of slots, each slot carries a sequence number telling whether it is ready to be
+// written (seq == pos) or to be read (seq == pos + 1) at the position pos, so producers and consumers claim a position
+// with a single CAS and never take a lock when the queue is neither empty nor full. A thread which can not make
+// progress spins for a short while before it parks on a condition variable, and the other side only takes the lock to
+// wake a single waiter when someone is parked, i.e. when the queue goes from empty to non-empty or from full to
+// non-full. The condition variables are registered with the TaskGroup, so a parked thread is woken up by an interrupt
+// just like in Queue.
+//
+// Unlike Queue, the capacity is fixed once created, use Queue where the capacity is tuned at runtime.
+template <typename T>
+class MPMCQueue {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+
+  explicit MPMCQueue(int sz)
+      : sz_(sz > 0 ? static_cast<size_t>(sz) : 1),
+        slots_(std::make_unique<Slot[]>(sz_)),
+        my_name_(Services::GetUniqueID()) {
+    for (size_t i = 0; i < sz_; ++i) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    MS_LOG(DEBUG) << "Create MPMC Q with uuid " << my_name_ << " of size " << sz_ << ".";
+  }
+
+  virtual ~MPMCQueue() = default;
+
+  size_t size() const {
+    // Load the head first, so the result never underflows.
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    return tail >= head ? tail - head : 0;
+  }
+
+  size_t capacity() const { return sz_; }
+
+  // The queue is empty if the element at the head has not been published yet.
+  bool empty() const {
+    size_t head = head_.load(std::memory_order_acquire);
+    return slots_[head % sz_].seq.load(std::memory_order_acquire) != head + 1;
+  }
+
+  // Not thread safe, it should be called when there are no producers or consumers.
+  void Reset() {
+    T val;
+    while (TryPopFront(&val)) {
+    }
+    empty_cv_.ResetIntrpState();
+    full_cv_.ResetIntrpState();
+  }
+
+  // Producer
+  Status Add(const_reference ele) noexcept { return EmplaceBack(ele); }
+
+  Status Add(T &&ele) noexcept { return EmplaceBack(std::forward<T>(ele)); }
+
+  template <typename... Ts>
+  Status EmplaceBack(Ts &&... args) noexcept {
+    // The arguments are only consumed by a successful try, so they can be forwarded again after a failure.
+    for (int i = 0; i < kSpinCount; ++i) {
+      if (TryEmplaceBack(std::forward<Ts>(args)...)) {
+        WakeOne(&num_waiting_consumers_, &empty_cv_);
+        return Status::OK();
+      }
+      Backoff(i);
+    }
+    Status rc = Park(&num_waiting_producers_, &full_cv_,
+                     [this, &args...]() -> bool { return TryEmplaceBack(std::forward<Ts>(args)...); });
+    if (rc.IsOk()) {
+      WakeOne(&num_waiting_consumers_, &empty_cv_);
+    } else {
+      empty_cv_.Interrupt();
+    }
+    return rc;
+  }
+
+  // Consumer
+  Status PopFront(pointer p) {
+    for (int i = 0; i < kSpinCount; ++i) {
+      if (TryPopFront(p)) {
+        WakeOne(&num_waiting_producers_, &full_cv_);
+        return Status::OK();
+      }
+      Backoff(i);
+    }
+    Status rc = Park(&num_waiting_consumers_, &empty_cv_, [this, p]() -> bool { return TryPopFront(p); });
+    if (rc.IsOk()) {
+      WakeOne(&num_waiting_producers_, &full_cv_);
+    } else {
+      full_cv_.Interrupt();
+    }
+    return rc;
+  }
+
+  Status Register(TaskGroup *vg) {
+    Status rc1 = empty_cv_.Register(vg->GetIntrpService());
+    Status rc2 = full_cv_.Register(vg->GetIntrpService());
+    if (rc1.IsOk()) {
+      return rc2;
+    } else {
+      return rc1;
+    }
+  }
+
+ private:
+  // The number of tries before a thread parks, the first half of them are busy tries.
+  static constexpr int kSpinCount = 64;
+
+  struct Slot {
+    std::atomic<size_t> seq{0};
+    T value;
+  };
+
+  // Claim the tail position and construct the element there, return false if the queue is full.
+  template <typename... Ts>
+  bool TryEmplaceBack(Ts &&... args) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = slots_[pos % sz_];
+      size_t seq = slot.seq.load(std::memory_order_acquire);
+      if (seq == pos) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.value = T(std::forward<Ts>(args)...);
+          slot.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (seq < pos) {
+        // The slot still holds the element of the previous round.
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Claim the head position and move the element out, return false if the queue is empty.
+  bool TryPopFront(pointer p) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = slots_[pos % sz_];
+      size_t seq = slot.seq.load(std::memory_order_acquire);
+      if (seq == pos + 1) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          *p = std::move(slot.value);
+          slot.seq.store(pos + sz_, std::memory_order_release);
+          return true;
+        }
+      } else if (seq < pos + 1) {
+        // The element of this round has not been published yet.
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  static void Backoff(int i) {
+    if (i >= kSpinCount / 2) {
+      std::this_thread::yield();
+    }
+  }
+
+  // Park on the condition variable until `pred` succeeds. The waiting counter is published before the last check of
+  // `pred` under the lock, and the other side checks the counter after its own update, so a wake-up can not be lost.
+  template <typename F>
+  Status Park(std::atomic<int32_t> *num_waiting, CondVar *cv, F &&pred) {
+    std::unique_lock<std::mutex> lock(mux_);
+    (void)num_waiting->fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Status rc = cv->Wait(&lock, std::forward<F>(pred));
+    (void)num_waiting->fetch_sub(1, std::memory_order_seq_cst);
+    return rc;
+  }
+
+  // Wake a single waiter of the other side if there is anyone parked.
+  void WakeOne(std::atomic<int32_t> *num_waiting, CondVar *cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (num_waiting->load(std::memory_order_relaxed) > 0) {
+      {
+        std::unique_lock<std::mutex> lock(mux_);
+      }
+      cv->NotifyOne();
+    }
+  }
+
+  size_t sz_;
+  std::unique_ptr<Slot[]> slots_;
+  // The producers and consumers touch different cache lines.
+  alignas(64) std::atomic<size_t> tail_{0};
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<int32_t> num_waiting_producers_{0};
+  std::atomic<int32_t> num_waiting_consumers_{0};
+  std::string my_name_;
+  std::mutex mux_;
+  CondVar empty_cv_;
+  CondVar full_cv_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_MPMC_QUEUE_H_
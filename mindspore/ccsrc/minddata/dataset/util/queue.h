@@ -255,7 +255,8 @@ class Queue {
 
 // A container of queues with [] operator accessors.  Basically this is a wrapper over of a vector of queues
 // to help abstract/simplify code that is maintaining multiple queues.
-template <typename T>
+// The type of queue can be any class with the interface of Queue, e.g. MPMCQueue.
+template <typename T, typename Q = Queue<T>>
 class QueueList {
  public:
   QueueList() {}
@@ -263,7 +264,7 @@ class QueueList {
   void Init(int num_queues, int capacity) {
     (void)queue_list_.reserve(num_queues);
     for (int i = 0; i < num_queues; i++) {
-      (void)queue_list_.emplace_back(std::make_unique<Queue<T>>(capacity));
+      (void)queue_list_.emplace_back(std::make_unique<Q>(capacity));
     }
   }
 
@@ -282,12 +283,12 @@ class QueueList {
     return queue_list_.size();
   }
 
-  std::unique_ptr<Queue<T>> &operator[](const int index) {
+  std::unique_ptr<Q> &operator[](const int index) {
     std::unique_lock<std::mutex> _lock(mux_);
     return queue_list_[index];
   }
 
-  const std::unique_ptr<Queue<T>> &operator[](const int index) const {
+  const std::unique_ptr<Q> &operator[](const int index) const {
     std::unique_lock<std::mutex> _lock(mux_);
     return queue_list_[index];
   }
@@ -296,7 +297,7 @@ class QueueList {
 
   Status AddQueue(TaskGroup *vg) {
     std::unique_lock<std::mutex> _lock(mux_);
-    (void)queue_list_.emplace_back(std::make_unique<Queue<T>>(queue_list_[0]->capacity()));
+    (void)queue_list_.emplace_back(std::make_unique<Q>(queue_list_[0]->capacity()));
     return queue_list_[queue_list_.size() - 1]->Register(vg);
   }
   Status RemoveLastQueue() {
@@ -310,7 +311,7 @@ class QueueList {
   // Queue contains non-copyable objects, so it cannot be added to a vector due to the vector
   // requirement that objects must have copy semantics.  To resolve this, we use a vector of unique
   // pointers.  This allows us to provide dynamic creation of queues in a container.
-  std::vector<std::unique_ptr<Queue<T>>> queue_list_;
+  std::vector<std::unique_ptr<Q>> queue_list_;
 
   mutable std::mutex mux_;
 };
@@ -90,6 +90,7 @@ class ReadableSlice {
 class WritableSlice : public ReadableSlice {
  public:
   friend class StorageContainer;
+  friend class CachePool;
   friend class CacheService;
   friend class CacheServer;
   /// \brief Default constructor
@@ -0,0 +1,182 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+// The suffix of the columnar index file, which is written next to the sqlite index file "<mindrecord file>.db".
+const char kColumnarIndexSuffix[] = ".idx";
+
+// The fixed width columns of the columnar index, which are the same as the columns of the INDEXES table in sqlite.
+enum ColumnarOffset : int {
+  kColRowId = 0,
+  kColRowGroupId,
+  kColPageIdRaw,
+  kColPageOffsetRaw,
+  kColPageOffsetRawEnd,
+  kColPageIdBlob,
+  kColPageOffsetBlob,
+  kColPageOffsetBlobEnd,
+  kColumnarOffsetNum
+};
+
+// The storage type of an index field: int32/int64 fields are stored as int64, float32/float64 fields are stored as
+// float64, and string fields are dictionary encoded, i.e. a uint32 code per row and a dictionary of distinct strings.
+enum class ColumnarFieldType : uint64_t { kInt64 = 0, kFloat64 = 1, kString = 2 };
+
+/// \brief The columnar index of one mindrecord file, which is memory mapped for reading.
+///
+/// The file is made up of 8-byte aligned sections in native byte order:
+///   header:       magic, number of rows, number of fields, length of the shard name and the offsets of the
+///                 kColumnarOffsetNum uint64 columns
+///   shard name:   the file name of the mindrecord file, used to check the index belongs to the file
+///   fields:       a FieldDesc per index field
+///   data:         the field names, the offset columns, the value columns and the dictionaries of the string fields
+/// The rows are sorted by ROW_ID, so the row with id i is the i-th row for the indexes written by ShardIndexGenerator.
+class MINDRECORD_API ShardColumnarIndex {
+ public:
+  ShardColumnarIndex() = default;
+
+  ~ShardColumnarIndex();
+
+  ShardColumnarIndex(const ShardColumnarIndex &) = delete;
+  ShardColumnarIndex &operator=(const ShardColumnarIndex &) = delete;
+
+  /// \brief map the columnar index file and check whether it belongs to the mindrecord file
+  /// \param[in] file_path the path of the columnar index file
+  /// \param[in] shard_name the file name of the mindrecord file
+  /// \param[out] index_ptr the loaded index
+  /// \return Status
+  static Status Load(const std::string &file_path, const std::string &shard_name,
+                     std::shared_ptr<ShardColumnarIndex> *index_ptr);
+
+  /// \brief get the number of rows
+  uint64_t GetNumRows() const { return num_rows_; }
+
+  /// \brief get the position of the row by ROW_ID
+  /// \param[in] row_id the ROW_ID of the row
+  /// \param[out] row the position of the row
+  /// \return Status
+  Status FindRow(uint64_t row_id, uint64_t *row) const;
+
+  /// \brief get the value of an offset column
+  uint64_t GetOffset(ColumnarOffset column, uint64_t row) const { return offsets_[column][row]; }
+
+  /// \brief get the field by the field name generated by ShardIndexGenerator::GenerateFieldName
+  /// \return the id of the field, or -1 if the field is not in the index
+  int GetFieldId(const std::string &field_name) const;
+
+  ColumnarFieldType GetFieldType(int field_id) const { return static_cast<ColumnarFieldType>(fields_[field_id]->type); }
+
+  int64_t GetInt64(int field_id, uint64_t row) const {
+    return reinterpret_cast<const int64_t *>(data_ + fields_[field_id]->values_offset)[row];
+  }
+
+  double GetFloat64(int field_id, uint64_t row) const {
+    return reinterpret_cast<const double *>(data_ + fields_[field_id]->values_offset)[row];
+  }
+
+  std::string GetString(int field_id, uint64_t row) const;
+
+ private:
+  friend class ShardColumnarIndexBuilder;
+
+  struct Header {
+    char magic[8];
+    uint64_t num_rows;
+    uint64_t num_fields;
+    uint64_t shard_name_len;
+    uint64_t offset_columns[kColumnarOffsetNum];
+  };
+
+  struct FieldDesc {
+    uint64_t type;
+    uint64_t name_offset;
+    uint64_t name_len;
+    // int64/float64 values for number fields, uint32 codes for string fields.
+    uint64_t values_offset;
+    // The dictionary of string fields: dict_size + 1 uint64 offsets into the concatenated dictionary strings.
+    uint64_t dict_size;
+    uint64_t dict_offsets_offset;
+    uint64_t dict_data_offset;
+    uint64_t dict_data_len;
+  };
+
+  static constexpr char kMagic[8] = {'M', 'R', 'C', 'I', 'D', 'X', '0', '1'};
+
+  Status Parse(const std::string &shard_name);
+
+  const char *data_{nullptr};
+  uint64_t size_{0};
+  // The buffer of the index file where mmap is not available.
+  std::vector<char> buffer_;
+  bool mapped_{false};
+
+  uint64_t num_rows_{0};
+  const uint64_t *offsets_[kColumnarOffsetNum] = {nullptr};
+  std::vector<const FieldDesc *> fields_;
+  std::map<std::string, int> field_ids_;
+};
+
+/// \brief Collect the rows generated by ShardIndexGenerator and write them as a columnar index file.
+class MINDRECORD_API ShardColumnarIndexBuilder {
+ public:
+  /// \param[in] fields the field names generated by ShardIndexGenerator::GenerateFieldName and their sqlite types
+  explicit ShardColumnarIndexBuilder(const std::vector<std::pair<std::string, std::string>> &fields);
+
+  ~ShardColumnarIndexBuilder() = default;
+
+  /// \brief add a row in the form of the parameters bound to the sqlite insert statement
+  /// \param[in] row_data the tuples of (place holder, sqlite type, value)
+  /// \return Status
+  Status AddRow(const std::vector<std::tuple<std::string, std::string, std::string>> &row_data);
+
+  /// \brief sort the rows by ROW_ID and write the columnar index file
+  /// \param[in] file_path the path of the columnar index file
+  /// \param[in] shard_name the file name of the mindrecord file
+  /// \return Status
+  Status Write(const std::string &file_path, const std::string &shard_name);
+
+ private:
+  struct Field {
+    std::string name;
+    ColumnarFieldType type;
+    std::vector<int64_t> int_values;
+    std::vector<double> float_values;
+    std::vector<uint32_t> codes;
+    std::map<std::string, uint32_t> dict;
+  };
+
+  std::vector<Field> fields_;
+  std::map<std::string, int> place_holders_;
+  std::vector<uint64_t> offsets_[kColumnarOffsetNum];
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
@@ -25,6 +25,7 @@
 #include <tuple>
 #include <utility>
 #include <vector>
+#include "minddata/mindrecord/include/shard_columnar_index.h"
 #include "minddata/mindrecord/include/shard_header.h"
 #include "./sqlite3.h"
 
@@ -34,7 +35,11 @@ using INDEX_FIELDS = std::vector<std::tuple<std::string, std::string, std::strin
 using ROW_DATA = std::vector<std::vector<std::tuple<std::string, std::string, std::string>>>;
 class MINDRECORD_API ShardIndexGenerator {
  public:
-  explicit ShardIndexGenerator(const std::string &file_path, bool append = false);
+  /// \param[in] file_path the path of one of the mindrecord files
+  /// \param[in] append whether the files are opened for appending
+  /// \param[in] columnar_index whether to write a columnar index file next to each sqlite index file, which is
+  ///     memory mapped by ShardReader to look up the rows without sqlite
+  explicit ShardIndexGenerator(const std::string &file_path, bool append = false, bool columnar_index = false);
 
   Status Build();
 
@@ -58,7 +63,7 @@ class MINDRECORD_API ShardIndexGenerator {
   /// \brief create databases for indexes
   Status WriteToDatabase();
 
-  static Status Finalize(const std::vector<std::string> file_names);
+  static Status Finalize(const std::vector<std::string> file_names, bool columnar_index = false);
 
  private:
   static int Callback(void *not_used, int argc, char **argv, char **az_col_name);
@@ -99,6 +104,11 @@ class MINDRECORD_API ShardIndexGenerator {
 
   Status CreateShardNameTable(sqlite3 *db, const std::string &shard_name);
 
+  Status CreateColumnarIndexBuilder(std::unique_ptr<ShardColumnarIndexBuilder> *builder_ptr);
+
+  /// \brief write the columnar index of the shard, or remove the stale one if the columnar index is disabled
+  Status WriteColumnarIndex(const std::string &shard_address, ShardColumnarIndexBuilder *builder);
+
   Status AddBlobPageInfo(std::vector<std::tuple<std::string, std::string, std::string>> &row_data,   // NOLINT
                          const std::shared_ptr<Page> cur_blob_page, uint64_t &cur_blob_page_offset,  // NOLINT
                          std::fstream &in);                                                          // NOLINT
@@ -110,6 +120,7 @@ class MINDRECORD_API ShardIndexGenerator {
 
   std::string file_path_;
   bool append_;
+  bool columnar_index_;
   ShardHeader shard_header_;
   uint64_t page_size_;
   uint64_t header_size_;
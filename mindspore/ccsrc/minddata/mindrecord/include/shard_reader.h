@@ -44,6 +44,7 @@
 #include "minddata/mindrecord/include/common/shard_utils.h"
 #include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_column.h"
+#include "minddata/mindrecord/include/shard_columnar_index.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
@@ -215,6 +216,9 @@ class MINDRECORD_API ShardReader {
   /// \brief get next sample ids in slow load mode
   std::vector<int64_t> GetNextSampleIds();
 
+  /// \brief whether the rows of the shard are looked up from its columnar index instead of sqlite
+  bool UseColumnarIndex(int shard_id) const;
+
  protected:
   /// \brief sqlite call back function
   static int SelectCallback(void *p_data, int num_fields, char **p_fields, char **p_col_names);
@@ -226,6 +230,16 @@ class MINDRECORD_API ShardReader {
                             const std::vector<std::string> &columns,
                             std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
 
+  /// \brief read the label of a sample from the raw page, used when some columns are not in the index
+  Status ReadLabelFromRawPage(std::shared_ptr<std::fstream> fs, int raw_page_id, uint64_t label_start,
+                              uint64_t label_end, const std::vector<std::string> &columns, json *label);
+
+  /// \brief read the rows in [begin, end) of the columnar index of one shard, which replaces the sqlite query
+  Status ReadRowsFromColumnarIndex(int shard_id, int32_t consumer_id, uint64_t begin, uint64_t end,
+                                   const std::vector<std::string> &columns,
+                                   std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
+                                   std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
+
   /// \brief convert json format to expected type
   Status ConvertJsonValue(const std::vector<std::string> &label, const std::vector<std::string> &columns,
                           const json &schema, json *value);
@@ -326,6 +340,7 @@ class MINDRECORD_API ShardReader {
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::vector<std::shared_ptr<ShardColumnarIndex>> columnar_indexes_;            // columnar index list, may be null
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
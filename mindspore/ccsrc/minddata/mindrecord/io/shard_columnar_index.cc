@@ -0,0 +1,348 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/mindrecord/include/shard_columnar_index.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+#include "utils/file_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+constexpr uint64_t kAlignment = 8;
+
+uint64_t AlignUp(uint64_t size) { return (size + kAlignment - 1) / kAlignment * kAlignment; }
+
+// Map from the place holders of the sqlite insert statement to the offset columns.
+const std::map<std::string, int> kOffsetPlaceHolders = {
+  {":ROW_ID", kColRowId},
+  {":ROW_GROUP_ID", kColRowGroupId},
+  {":PAGE_ID_RAW", kColPageIdRaw},
+  {":PAGE_OFFSET_RAW", kColPageOffsetRaw},
+  {":PAGE_OFFSET_RAW_END", kColPageOffsetRawEnd},
+  {":PAGE_ID_BLOB", kColPageIdBlob},
+  {":PAGE_OFFSET_BLOB", kColPageOffsetBlob},
+  {":PAGE_OFFSET_BLOB_END", kColPageOffsetBlobEnd}};
+}  // namespace
+
+ShardColumnarIndex::~ShardColumnarIndex() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (mapped_ && data_ != nullptr) {
+    (void)munmap(const_cast<char *>(data_), size_);
+  }
+#endif
+  data_ = nullptr;
+}
+
+Status ShardColumnarIndex::Load(const std::string &file_path, const std::string &shard_name,
+                                std::shared_ptr<ShardColumnarIndex> *index_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(index_ptr);
+  auto realpath = FileUtils::GetRealPath(file_path.c_str());
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(realpath.has_value(), "Invalid file, failed to get the realpath of columnar index: " +
+                                                          file_path);
+  auto index = std::make_shared<ShardColumnarIndex>();
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(realpath.value().c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fd >= 0, "Invalid file, failed to open columnar index: " + file_path);
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED_MR("Invalid file, failed to get the size of columnar index: " + file_path);
+  }
+  index->size_ = static_cast<uint64_t>(st.st_size);
+  void *addr = mmap(nullptr, index->size_, PROT_READ, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(addr != MAP_FAILED, "[Internal ERROR] Failed to mmap columnar index: " + file_path);
+  index->data_ = static_cast<const char *>(addr);
+  index->mapped_ = true;
+#else
+  std::ifstream fin(realpath.value(), std::ios::in | std::ios::binary | std::ios::ate);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fin.good(), "Invalid file, failed to open columnar index: " + file_path);
+  index->size_ = static_cast<uint64_t>(fin.tellg());
+  index->buffer_.resize(index->size_);
+  (void)fin.seekg(0, std::ios::beg);
+  auto &io_read = fin.read(index->buffer_.data(), index->size_);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(io_read.good(), "[Internal ERROR] Failed to read columnar index: " + file_path);
+  index->data_ = index->buffer_.data();
+#endif
+  RETURN_IF_NOT_OK_MR(index->Parse(shard_name));
+  *index_ptr = index;
+  return Status::OK();
+}
+
+Status ShardColumnarIndex::Parse(const std::string &shard_name) {
+  auto in_range = [this](uint64_t offset, uint64_t len) {
+    return offset % kAlignment == 0 && offset <= size_ && len <= size_ - offset;
+  };
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(size_ >= sizeof(Header), "Invalid columnar index, the file is truncated.");
+  const auto *header = reinterpret_cast<const Header *>(data_);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(memcmp(header->magic, kMagic, sizeof(kMagic)) == 0,
+                                  "Invalid columnar index, the magic number does not match.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(
+    header->shard_name_len <= size_ - sizeof(Header) &&
+      std::string(data_ + sizeof(Header), header->shard_name_len) == shard_name,
+    "Invalid columnar index, it does not belong to mindrecord file: " + shard_name);
+  num_rows_ = header->num_rows;
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(num_rows_ <= size_ / sizeof(uint64_t),
+                                  "Invalid columnar index, the file is truncated.");
+  for (int col = 0; col < kColumnarOffsetNum; ++col) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(in_range(header->offset_columns[col], num_rows_ * sizeof(uint64_t)),
+                                    "Invalid columnar index, the offset column is out of range.");
+    offsets_[col] = reinterpret_cast<const uint64_t *>(data_ + header->offset_columns[col]);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(std::is_sorted(offsets_[kColRowId], offsets_[kColRowId] + num_rows_),
+                                  "Invalid columnar index, the rows are not sorted by row id.");
+
+  uint64_t desc_offset = AlignUp(sizeof(Header) + header->shard_name_len);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(header->num_fields <= size_ / sizeof(FieldDesc) &&
+                                    in_range(desc_offset, header->num_fields * sizeof(FieldDesc)),
+                                  "Invalid columnar index, the field list is out of range.");
+  const auto *descs = reinterpret_cast<const FieldDesc *>(data_ + desc_offset);
+  for (uint64_t i = 0; i < header->num_fields; ++i) {
+    const FieldDesc &desc = descs[i];
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(desc.type <= static_cast<uint64_t>(ColumnarFieldType::kString),
+                                    "Invalid columnar index, unknown field type: " + std::to_string(desc.type));
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(desc.name_offset <= size_ && desc.name_len <= size_ - desc.name_offset,
+                                    "Invalid columnar index, the field name is out of range.");
+    std::string name(data_ + desc.name_offset, desc.name_len);
+    if (static_cast<ColumnarFieldType>(desc.type) == ColumnarFieldType::kString) {
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(
+        in_range(desc.values_offset, num_rows_ * sizeof(uint32_t)) && desc.dict_size < size_ / sizeof(uint64_t) &&
+          in_range(desc.dict_offsets_offset, (desc.dict_size + 1) * sizeof(uint64_t)) &&
+          desc.dict_data_offset <= size_ && desc.dict_data_len <= size_ - desc.dict_data_offset,
+        "Invalid columnar index, the dictionary of field: " + name + " is out of range.");
+      const auto *dict_offsets = reinterpret_cast<const uint64_t *>(data_ + desc.dict_offsets_offset);
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(std::is_sorted(dict_offsets, dict_offsets + desc.dict_size + 1) &&
+                                        dict_offsets[desc.dict_size] <= desc.dict_data_len,
+                                      "Invalid columnar index, the dictionary of field: " + name + " is broken.");
+      const auto *codes = reinterpret_cast<const uint32_t *>(data_ + desc.values_offset);
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(
+        std::all_of(codes, codes + num_rows_, [&desc](uint32_t code) { return code < desc.dict_size; }),
+        "Invalid columnar index, the dictionary code of field: " + name + " is out of range.");
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(in_range(desc.values_offset, num_rows_ * sizeof(uint64_t)),
+                                      "Invalid columnar index, the values of field: " + name + " are out of range.");
+    }
+    field_ids_[name] = static_cast<int>(fields_.size());
+    fields_.push_back(&desc);
+  }
+  return Status::OK();
+}
+
+Status ShardColumnarIndex::FindRow(uint64_t row_id, uint64_t *row) const {
+  RETURN_UNEXPECTED_IF_NULL_MR(row);
+  const uint64_t *row_ids = offsets_[kColRowId];
+  // The row ids are dense from 0 for the indexes written by ShardIndexGenerator.
+  if (row_id < num_rows_ && row_ids[row_id] == row_id) {
+    *row = row_id;
+    return Status::OK();
+  }
+  const uint64_t *iter = std::lower_bound(row_ids, row_ids + num_rows_, row_id);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(iter != row_ids + num_rows_ && *iter == row_id,
+                                  "[Internal ERROR] Failed to find row id: " + std::to_string(row_id) +
+                                    " in columnar index.");
+  *row = static_cast<uint64_t>(iter - row_ids);
+  return Status::OK();
+}
+
+int ShardColumnarIndex::GetFieldId(const std::string &field_name) const {
+  auto iter = field_ids_.find(field_name);
+  return iter == field_ids_.end() ? -1 : iter->second;
+}
+
+std::string ShardColumnarIndex::GetString(int field_id, uint64_t row) const {
+  const FieldDesc *desc = fields_[field_id];
+  uint32_t code = reinterpret_cast<const uint32_t *>(data_ + desc->values_offset)[row];
+  const auto *dict_offsets = reinterpret_cast<const uint64_t *>(data_ + desc->dict_offsets_offset);
+  return std::string(data_ + desc->dict_data_offset + dict_offsets[code], dict_offsets[code + 1] - dict_offsets[code]);
+}
+
+ShardColumnarIndexBuilder::ShardColumnarIndexBuilder(const std::vector<std::pair<std::string, std::string>> &fields) {
+  for (const auto &field : fields) {
+    ColumnarFieldType type = ColumnarFieldType::kString;
+    if (field.second == "INTEGER") {
+      type = ColumnarFieldType::kInt64;
+    } else if (field.second == "REAL") {
+      type = ColumnarFieldType::kFloat64;
+    }
+    place_holders_[":" + field.first] = kColumnarOffsetNum + static_cast<int>(fields_.size());
+    fields_.push_back(Field{field.first, type, {}, {}, {}, {}});
+  }
+  for (const auto &place_holder : kOffsetPlaceHolders) {
+    place_holders_[place_holder.first] = place_holder.second;
+  }
+}
+
+Status ShardColumnarIndexBuilder::AddRow(
+  const std::vector<std::tuple<std::string, std::string, std::string>> &row_data) {
+  size_t num_rows = offsets_[kColRowId].size();
+  try {
+    for (const auto &item : row_data) {
+      auto iter = place_holders_.find(std::get<0>(item));
+      if (iter == place_holders_.end()) {
+        // The INC_ columns of the sqlite index are not needed.
+        continue;
+      }
+      const std::string &value = std::get<2>(item);
+      if (iter->second < kColumnarOffsetNum) {
+        offsets_[iter->second].push_back(std::stoull(value));
+        continue;
+      }
+      Field &field = fields_[iter->second - kColumnarOffsetNum];
+      if (field.type == ColumnarFieldType::kInt64) {
+        field.int_values.push_back(std::stoll(value));
+      } else if (field.type == ColumnarFieldType::kFloat64) {
+        field.float_values.push_back(std::stod(value));
+      } else {
+        auto code = field.dict.emplace(value, static_cast<uint32_t>(field.dict.size())).first->second;
+        field.codes.push_back(code);
+      }
+    }
+  } catch (std::exception &e) {
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to add row to columnar index, " + std::string(e.what()));
+  }
+  // Every column should get exactly one value from the row.
+  for (int col = 0; col < kColumnarOffsetNum; ++col) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(offsets_[col].size() == num_rows + 1,
+                                    "[Internal ERROR] The row of columnar index misses offset column: " +
+                                      std::to_string(col));
+  }
+  for (const auto &field : fields_) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(
+      field.int_values.size() + field.float_values.size() + field.codes.size() == num_rows + 1,
+      "[Internal ERROR] The row of columnar index misses field: " + field.name);
+  }
+  return Status::OK();
+}
+
+Status ShardColumnarIndexBuilder::Write(const std::string &file_path, const std::string &shard_name) {
+  using Header = ShardColumnarIndex::Header;
+  using FieldDesc = ShardColumnarIndex::FieldDesc;
+  const uint64_t num_rows = offsets_[kColRowId].size();
+  std::vector<uint64_t> order(num_rows);
+  std::iota(order.begin(), order.end(), 0);
+  const auto &row_ids = offsets_[kColRowId];
+  std::stable_sort(order.begin(), order.end(), [&row_ids](uint64_t a, uint64_t b) { return row_ids[a] < row_ids[b]; });
+
+  // Lay out the sections, every section starts at an 8-byte aligned offset.
+  Header header{};
+  (void)memcpy(header.magic, ShardColumnarIndex::kMagic, sizeof(header.magic));
+  header.num_rows = num_rows;
+  header.num_fields = fields_.size();
+  header.shard_name_len = shard_name.size();
+  uint64_t desc_offset = AlignUp(sizeof(Header) + shard_name.size());
+  uint64_t offset = desc_offset + fields_.size() * sizeof(FieldDesc);
+  std::vector<FieldDesc> descs(fields_.size());
+  std::vector<std::vector<std::string>> dicts(fields_.size());
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    const Field &field = fields_[i];
+    FieldDesc &desc = descs[i];
+    desc.type = static_cast<uint64_t>(field.type);
+    desc.name_offset = offset;
+    desc.name_len = field.name.size();
+    offset = AlignUp(offset + field.name.size());
+  }
+  for (int col = 0; col < kColumnarOffsetNum; ++col) {
+    header.offset_columns[col] = offset;
+    offset += num_rows * sizeof(uint64_t);
+  }
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    const Field &field = fields_[i];
+    FieldDesc &desc = descs[i];
+    desc.values_offset = offset;
+    if (field.type != ColumnarFieldType::kString) {
+      offset += num_rows * sizeof(uint64_t);
+      continue;
+    }
+    offset = AlignUp(offset + num_rows * sizeof(uint32_t));
+    dicts[i].resize(field.dict.size());
+    for (const auto &entry : field.dict) {
+      dicts[i][entry.second] = entry.first;
+      desc.dict_data_len += entry.first.size();
+    }
+    desc.dict_size = dicts[i].size();
+    desc.dict_offsets_offset = offset;
+    offset += (desc.dict_size + 1) * sizeof(uint64_t);
+    desc.dict_data_offset = offset;
+    offset = AlignUp(offset + desc.dict_data_len);
+  }
+
+  std::vector<char> buffer(offset, 0);
+  auto put = [&buffer](uint64_t pos, const void *src, uint64_t len) {
+    if (len > 0) {
+      (void)memcpy(buffer.data() + pos, src, len);
+    }
+  };
+  put(0, &header, sizeof(Header));
+  put(sizeof(Header), shard_name.data(), shard_name.size());
+  put(desc_offset, descs.data(), descs.size() * sizeof(FieldDesc));
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    put(descs[i].name_offset, fields_[i].name.data(), fields_[i].name.size());
+  }
+  for (int col = 0; col < kColumnarOffsetNum; ++col) {
+    auto *dst = reinterpret_cast<uint64_t *>(buffer.data() + header.offset_columns[col]);
+    for (uint64_t row = 0; row < num_rows; ++row) {
+      dst[row] = offsets_[col][order[row]];
+    }
+  }
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    const Field &field = fields_[i];
+    const FieldDesc &desc = descs[i];
+    if (field.type == ColumnarFieldType::kInt64) {
+      auto *dst = reinterpret_cast<int64_t *>(buffer.data() + desc.values_offset);
+      for (uint64_t row = 0; row < num_rows; ++row) {
+        dst[row] = field.int_values[order[row]];
+      }
+    } else if (field.type == ColumnarFieldType::kFloat64) {
+      auto *dst = reinterpret_cast<double *>(buffer.data() + desc.values_offset);
+      for (uint64_t row = 0; row < num_rows; ++row) {
+        dst[row] = field.float_values[order[row]];
+      }
+    } else {
+      auto *dst = reinterpret_cast<uint32_t *>(buffer.data() + desc.values_offset);
+      for (uint64_t row = 0; row < num_rows; ++row) {
+        dst[row] = field.codes[order[row]];
+      }
+      auto *dict_offsets = reinterpret_cast<uint64_t *>(buffer.data() + desc.dict_offsets_offset);
+      uint64_t dict_pos = 0;
+      for (uint64_t code = 0; code < desc.dict_size; ++code) {
+        dict_offsets[code] = dict_pos;
+        put(desc.dict_data_offset + dict_pos, dicts[i][code].data(), dicts[i][code].size());
+        dict_pos += dicts[i][code].size();
+      }
+      dict_offsets[desc.dict_size] = dict_pos;
+    }
+  }
+
+  std::ofstream fout(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fout.good(), "Invalid file, failed to open columnar index for writing: " + file_path);
+  auto &io_write = fout.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(io_write.good(), "[Internal ERROR] Failed to write columnar index: " + file_path);
+  fout.close();
+  MS_LOG(INFO) << "Write " << num_rows << " rows to columnar index: " << file_path;
+  return Status::OK();
+}
+}  // namespace mindrecord
+}  // namespace mindspore
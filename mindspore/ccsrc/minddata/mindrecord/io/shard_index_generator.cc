@@ -20,9 +20,10 @@
 
 namespace mindspore {
 namespace mindrecord {
-ShardIndexGenerator::ShardIndexGenerator(const std::string &file_path, bool append)
+ShardIndexGenerator::ShardIndexGenerator(const std::string &file_path, bool append, bool columnar_index)
     : file_path_(file_path),
       append_(append),
+      columnar_index_(columnar_index),
       page_size_(0),
       header_size_(0),
       schema_count_(0),
@@ -517,6 +518,10 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
     RETURN_STATUS_UNEXPECTED_MR("Execute SQL statement `BEGIN TRANSACTION;` failed, SQLite result code: " +
                                 std::to_string(sql_code));
   }
+  std::unique_ptr<ShardColumnarIndexBuilder> builder;
+  if (columnar_index_) {
+    RELEASE_AND_RETURN_IF_NOT_OK_MR(CreateColumnarIndexBuilder(&builder), db, in);
+  }
   for (int raw_page_id : raw_page_ids) {
     std::shared_ptr<std::string> sql_ptr;
     RELEASE_AND_RETURN_IF_NOT_OK_MR(GenerateRawSQL(fields_, &sql_ptr), db, in);
@@ -524,6 +529,11 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
     RELEASE_AND_RETURN_IF_NOT_OK_MR(GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in, &row_data_ptr), db,
                                     in);
     RELEASE_AND_RETURN_IF_NOT_OK_MR(BindParameterExecuteSQL(db, *sql_ptr, *row_data_ptr), db, in);
+    if (builder != nullptr) {
+      for (const auto &row : *row_data_ptr) {
+        RELEASE_AND_RETURN_IF_NOT_OK_MR(builder->AddRow(row), db, in);
+      }
+    }
     MS_LOG(INFO) << "Insert " << row_data_ptr->size() << " rows to index db.";
   }
   sql_code = sqlite3_exec(db, "END TRANSACTION;", nullptr, nullptr, nullptr);
@@ -538,6 +548,38 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
   // Close database
   sqlite3_close(db);
   db = nullptr;
+  RETURN_IF_NOT_OK_MR(WriteColumnarIndex(shard_address, builder.get()));
+  return Status::OK();
+}
+
+Status ShardIndexGenerator::CreateColumnarIndexBuilder(std::unique_ptr<ShardColumnarIndexBuilder> *builder_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(builder_ptr);
+  std::vector<std::pair<std::string, std::string>> fields;
+  for (const auto &field : fields_) {
+    std::shared_ptr<Schema> schema_ptr;
+    RETURN_IF_NOT_OK_MR(shard_header_.GetSchemaByID(field.first, &schema_ptr));
+    json json_schema = (schema_ptr->GetSchema())["schema"];
+    std::shared_ptr<std::string> fn_ptr;
+    RETURN_IF_NOT_OK_MR(GenerateFieldName(field, &fn_ptr));
+    fields.emplace_back(*fn_ptr, ConvertJsonToSQL(TakeFieldType(field.second, json_schema)));
+  }
+  *builder_ptr = std::make_unique<ShardColumnarIndexBuilder>(fields);
+  return Status::OK();
+}
+
+Status ShardIndexGenerator::WriteColumnarIndex(const std::string &shard_address, ShardColumnarIndexBuilder *builder) {
+  std::string index_address = shard_address + kColumnarIndexSuffix;
+  if (builder == nullptr) {
+    // The index of the previous writing does not match the rows any more.
+    if (std::ifstream(index_address).good()) {
+      (void)std::remove(index_address.c_str());
+      MS_LOG(WARNING) << "Remove the stale columnar index file: " << index_address;
+    }
+    return Status::OK();
+  }
+  std::shared_ptr<std::string> fn_ptr;
+  RETURN_IF_NOT_OK_MR(GetFileName(shard_address, &fn_ptr));
+  RETURN_IF_NOT_OK_MR(builder->Write(index_address, *fn_ptr));
   return Status::OK();
 }
 
@@ -622,9 +664,9 @@ void ShardIndexGenerator::DatabaseWriter() {
   }
 }
 
-Status ShardIndexGenerator::Finalize(const std::vector<std::string> file_names) {
+Status ShardIndexGenerator::Finalize(const std::vector<std::string> file_names, bool columnar_index) {
   CHECK_FAIL_RETURN_UNEXPECTED_MR(!file_names.empty(), "[Internal ERROR] the size of mindrecord files is 0.");
-  ShardIndexGenerator sg{file_names[0]};
+  ShardIndexGenerator sg{file_names[0], false, columnar_index};
   RETURN_IF_NOT_OK_MR(sg.Build());
   RETURN_IF_NOT_OK_MR(sg.WriteToDatabase());
   return Status::OK();
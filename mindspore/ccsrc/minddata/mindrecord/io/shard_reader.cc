@@ -86,6 +86,20 @@ Status ShardReader::Init(const std::vector<std::string> &file_paths, bool load_d
     sqlite3 *db = nullptr;
     RETURN_IF_NOT_OK_MR(VerifyDataset(&db, file));
     database_paths_.push_back(db);
+    // the columnar index is optional, fall back to sqlite if it is missing or broken
+    std::shared_ptr<ShardColumnarIndex> columnar_index;
+    std::string index_file = file + kColumnarIndexSuffix;
+    if (std::ifstream(index_file).good()) {
+      std::shared_ptr<std::string> fn_ptr;
+      RETURN_IF_NOT_OK_MR(GetFileName(file, &fn_ptr));
+      Status rc = ShardColumnarIndex::Load(index_file, *fn_ptr, &columnar_index);
+      if (rc.IsError()) {
+        MS_LOG(WARNING) << "Failed to load the columnar index: " << index_file << ", read the index from sqlite. "
+                        << rc.ToString();
+        columnar_index = nullptr;
+      }
+    }
+    columnar_indexes_.push_back(columnar_index);
   }
   ShardHeader sh = ShardHeader();
   RETURN_IF_NOT_OK_MR(sh.BuildDataset(file_paths_, load_dataset));
@@ -354,6 +368,7 @@ void ShardReader::FileStreamsOperator() {
       database_paths_[i] = nullptr;
     }
   }
+  columnar_indexes_.clear();
 }
 
 ShardReader::~ShardReader() { Close(); }
@@ -444,32 +459,8 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
         int raw_page_id = std::stoi(labels[i][3]);
         uint64_t label_start = std::stoull(labels[i][4]) + kInt64Len;
         uint64_t label_end = std::stoull(labels[i][5]);
-        CHECK_FAIL_RETURN_UNEXPECTED_MR(label_end >= label_start,
-                                        "The sample's end offset: " + std::to_string(label_end) +
-                                          " should >= start offset: " + std::to_string(label_start) + ", check fail.");
-        auto len = label_end - label_start;
-        auto label_raw = std::vector<uint8_t>(len);
-        auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
-        if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-          fs->close();
-          RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
-        }
-        auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
-        if (!io_read.good() || io_read.fail() || io_read.bad()) {
-          fs->close();
-          RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
-        }
-        json label_json = json::from_msgpack(label_raw);
         json tmp;
-        if (!columns.empty()) {
-          for (const auto &col : columns) {
-            if (label_json.find(col) != label_json.end()) {
-              tmp[col] = label_json[col];
-            }
-          }
-        } else {
-          tmp = label_json;
-        }
+        RETURN_IF_NOT_OK_MR(ReadLabelFromRawPage(fs, raw_page_id, label_start, label_end, columns, &tmp));
         (*col_val_ptr)[shard_id].emplace_back(tmp);
       } else {
         json construct_json;
@@ -493,6 +484,107 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
   return Status::OK();
 }
 
+Status ShardReader::ReadLabelFromRawPage(std::shared_ptr<std::fstream> fs, int raw_page_id, uint64_t label_start,
+                                         uint64_t label_end, const std::vector<std::string> &columns, json *label) {
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(label_end >= label_start,
+                                  "The sample's end offset: " + std::to_string(label_end) +
+                                    " should >= start offset: " + std::to_string(label_start) + ", check fail.");
+  auto len = label_end - label_start;
+  auto label_raw = std::vector<uint8_t>(len);
+  auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
+  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+    fs->close();
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
+  }
+  auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
+  if (!io_read.good() || io_read.fail() || io_read.bad()) {
+    fs->close();
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
+  }
+  json label_json = json::from_msgpack(label_raw);
+  if (!columns.empty()) {
+    for (const auto &col : columns) {
+      if (label_json.find(col) != label_json.end()) {
+        (*label)[col] = label_json[col];
+      }
+    }
+  } else {
+    *label = label_json;
+  }
+  return Status::OK();
+}
+
+Status ShardReader::ReadRowsFromColumnarIndex(
+  int shard_id, int32_t consumer_id, uint64_t begin, uint64_t end, const std::vector<std::string> &columns,
+  std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
+  std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr) {
+  const auto &index = columnar_indexes_[shard_id];
+  RETURN_UNEXPECTED_IF_NULL_MR(index);
+  auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+  std::vector<int> field_ids;
+  std::vector<std::string> field_types;
+  if (all_in_index_) {
+    for (const auto &col : columns) {
+      std::shared_ptr<std::string> fn_ptr;
+      RETURN_IF_NOT_OK_MR(ShardIndexGenerator::GenerateFieldName(std::make_pair(column_schema_id_[col], col), &fn_ptr));
+      int field_id = index->GetFieldId(*fn_ptr);
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(field_id >= 0, "[Internal ERROR] 'column': " + col +
+                                                       " can not found in the columnar index of shard: " +
+                                                       std::to_string(shard_id));
+      field_ids.push_back(field_id);
+      auto &type = schema[col]["type"];
+      field_types.push_back(type.is_string() ? type.get<std::string>() : "");
+    }
+  }
+  auto &offsets = (*offset_ptr)[shard_id];
+  auto &col_vals = (*col_val_ptr)[shard_id];
+  offsets.reserve(offsets.size() + end - begin);
+  col_vals.reserve(col_vals.size() + end - begin);
+  for (uint64_t row = begin; row < end; ++row) {
+    uint64_t group_id = index->GetOffset(kColRowGroupId, row);
+    uint64_t offset_start = index->GetOffset(kColPageOffsetBlob, row) + kInt64Len;
+    uint64_t offset_end = index->GetOffset(kColPageOffsetBlobEnd, row);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(offset_end >= offset_start,
+                                    "The sample's end offset: " + std::to_string(offset_end) +
+                                      " should >= start offset: " + std::to_string(offset_start) + ", check fail.");
+    offsets.emplace_back(std::vector<uint64_t>{static_cast<uint64_t>(shard_id), group_id, offset_start, offset_end});
+    json value;
+    if (!all_in_index_) {
+      RETURN_IF_NOT_OK_MR(ReadLabelFromRawPage(file_streams_random_[consumer_id][shard_id],
+                                               static_cast<int>(index->GetOffset(kColPageIdRaw, row)),
+                                               index->GetOffset(kColPageOffsetRaw, row) + kInt64Len,
+                                               index->GetOffset(kColPageOffsetRawEnd, row), columns, &value));
+    } else {
+      // the same conversion as ConvertJsonValue, but from the typed values without parsing strings
+      for (size_t j = 0; j < columns.size(); ++j) {
+        int field_id = field_ids[j];
+        ColumnarFieldType type = index->GetFieldType(field_id);
+        if (type == ColumnarFieldType::kInt64) {
+          int64_t v = index->GetInt64(field_id, row);
+          if (field_types[j] == "int32") {
+            value[columns[j]] = static_cast<int32_t>(v);
+          } else {
+            value[columns[j]] = v;
+          }
+        } else if (type == ColumnarFieldType::kFloat64) {
+          double v = index->GetFloat64(field_id, row);
+          if (field_types[j] == "float32") {
+            value[columns[j]] = static_cast<float>(v);
+          } else {
+            value[columns[j]] = v;
+          }
+        } else {
+          value[columns[j]] = index->GetString(field_id, row);
+        }
+      }
+    }
+    col_vals.emplace_back(std::move(value));
+  }
+  MS_LOG(DEBUG) << "Succeed to get " << end - begin << " records from shard " << std::to_string(shard_id)
+                << " columnar index.";
+  return Status::OK();
+}
+
 Status ShardReader::ConvertJsonValue(const std::vector<std::string> &label, const std::vector<std::string> &columns,
                                      const json &schema, json *value) {
   constexpr int64_t index = 3;
@@ -613,6 +705,11 @@ Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
   std::vector<std::future<Status>> async_results;
   auto status = Status::OK();
   for (int x = 0; x < shard_count_; x++) {
+    if (columnar_indexes_[x] != nullptr) {
+      async_results.push_back(std::async(std::launch::async, &ShardReader::ReadRowsFromColumnarIndex, this, x, 0, 0,
+                                         columnar_indexes_[x]->GetNumRows(), columns, offset_ptr, col_val_ptr));
+      continue;
+    }
     async_results.push_back(std::async(std::launch::async, &ShardReader::ReadAllRowsInShard, this, x, 0, sql, columns,
                                        offset_ptr, col_val_ptr));
   }
@@ -638,6 +735,14 @@ Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::stri
   auto offset_ptr = std::make_shared<std::vector<std::vector<std::vector<uint64_t>>>>(
     shard_count_, std::vector<std::vector<uint64_t>>{});
   auto col_val_ptr = std::make_shared<std::vector<std::vector<json>>>(shard_count_, std::vector<json>{});
+  if (columnar_indexes_[shard_id] != nullptr) {
+    uint64_t row = 0;
+    RETURN_IF_NOT_OK_MR(columnar_indexes_[shard_id]->FindRow(sample_id, &row));
+    RETURN_IF_NOT_OK_MR(
+      ReadRowsFromColumnarIndex(shard_id, consumer_id, row, row + 1, columns, offset_ptr, col_val_ptr));
+    *row_group_ptr = std::make_shared<ROW_GROUPS>(std::move(*offset_ptr), std::move(*col_val_ptr));
+    return Status::OK();
+  }
   if (all_in_index_) {
     for (unsigned int i = 0; i < columns.size(); ++i) {
       fields += ',';
@@ -1767,5 +1872,10 @@ const std::vector<int64_t> *ShardReader::GetSampleIds() {
 LoadMode ShardReader::GetLoadMode() const { return load_mode_; }
 
 std::vector<int64_t> ShardReader::GetNextSampleIds() { return tasks_.GetNextSampleIds(); }
+
+bool ShardReader::UseColumnarIndex(int shard_id) const {
+  return shard_id >= 0 && static_cast<size_t>(shard_id) < columnar_indexes_.size() &&
+         columnar_indexes_[shard_id] != nullptr;
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -18,6 +18,7 @@
 #include "utils/file_utils.h"
 #include "utils/ms_utils.h"
 #include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_columnar_index.h"
 #include "./securec.h"
 
 namespace mindspore {
@@ -103,6 +104,8 @@ Status ShardWriter::OpenDataFiles(bool append, bool overwrite) {
           if (res2 == 0) {
             MS_LOG(WARNING) << "Succeed to remove the old mindrecord metadata files, path: " << file + ".db";
           }
+          // the columnar index is optional, remove it along with the db file
+          (void)std::remove((whole_path.value() + kColumnarIndexSuffix).c_str());
         } else {
           RETURN_STATUS_UNEXPECTED_MR(
             "Invalid file, mindrecord files already exist. Please check file path: " + file +
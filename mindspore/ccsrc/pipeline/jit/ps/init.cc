@@ -543,6 +543,10 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("aio_block_size", &OffloadContext::aio_block_size, "Get the size of aio block.")
     .def("set_aio_queue_depth", &OffloadContext::set_aio_queue_depth, "Set the depth of aio queue.")
     .def("aio_queue_depth", &OffloadContext::aio_queue_depth, "Get the depth of aio queue.")
+    .def("set_prefetch_kernel_num", &OffloadContext::set_prefetch_kernel_num,
+         "Set the number of kernels to swap in the offloaded tensors ahead.")
+    .def("prefetch_kernel_num", &OffloadContext::prefetch_kernel_num,
+         "Get the number of kernels to swap in the offloaded tensors ahead.")
     .def("set_enable_pinned_mem", &OffloadContext::set_enable_pinned_mem,
          "Set the flag of whether enabling pinned memory.")
     .def("enable_pinned_mem", &OffloadContext::enable_pinned_mem, "Get the flag of whether enabling pinned memory.")
@@ -24,6 +24,8 @@
 #include <string>
 #include "include/backend/device_address.h"
 #include "plugin/device/cpu/hal/device/cpu_hash_table.h"
+#include "plugin/device/cpu/hal/device/cpu_sharded_hash_table.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace device {
@@ -36,6 +38,25 @@ constexpr size_t kCreateFuncIndex = 0;
 constexpr size_t kImportFuncIndex = 1;
 constexpr size_t kClearFuncIndex = 2;
 
+// Set the env to "sharded" to use CPUShardedHashTable as the backend of the cpu hash table.
+constexpr char kCPUHashTableBackendEnv[] = "MS_DEV_CPU_HASH_TABLE_BACKEND";
+constexpr char kShardedCPUHashTableBackend[] = "sharded";
+
+/**
+ * @brief Create the CPU hash table of the backend specified by env `MS_DEV_CPU_HASH_TABLE_BACKEND`.
+ * @param[in] `value_dim`: The value dimension for each key.
+ * @param[in] `default_value`: The initializer name or the default value to pad the missing keys.
+ * @return The created CPU hash table.
+ */
+template <typename KeyType, typename ValueType, typename DefaultType>
+std::shared_ptr<HashTable<KeyType, ValueType>> NewCPUHashTable(size_t value_dim, const DefaultType &default_value) {
+  static const bool use_sharded_backend = (common::GetEnv(kCPUHashTableBackendEnv) == kShardedCPUHashTableBackend);
+  if (use_sharded_backend) {
+    return std::make_shared<CPUShardedHashTable<KeyType, ValueType>>(value_dim, default_value);
+  }
+  return std::make_shared<CPUHashTable<KeyType, ValueType>>(value_dim, default_value);
+}
+
 /**
  * @brief Create CPU hash table and set into `user_data`.
  * @param[in] `user_data`: The input user data which contains meta information to create CPU hash table.
@@ -55,13 +76,13 @@ void CreateCPUHashTable(const UserDataPtr &user_data) {
   if (value_size <= 0) {
     MS_LOG(WARNING) << "Invalid value size:" << value_size;
   }
+  // The hash table is stored as the base class, so the backend is transparent to its users.
   if (default_value->isa<StringImm>()) {
-    user_data->set<CPUHashTable<KeyType, ValueType>>(
-      kUserDataData,
-      std::make_shared<CPUHashTable<KeyType, ValueType>>(value_size, GetValue<std::string>(default_value)));
+    user_data->set<HashTable<KeyType, ValueType>>(
+      kUserDataData, NewCPUHashTable<KeyType, ValueType>(IntToSize(value_size), GetValue<std::string>(default_value)));
   } else if (default_value->isa<FloatImm>()) {
-    user_data->set<CPUHashTable<KeyType, ValueType>>(
-      kUserDataData, std::make_shared<CPUHashTable<KeyType, float>>(value_size, GetValue<float>(default_value)));
+    user_data->set<HashTable<KeyType, ValueType>>(
+      kUserDataData, NewCPUHashTable<KeyType, ValueType>(IntToSize(value_size), GetValue<float>(default_value)));
   } else {
     MS_LOG(EXCEPTION) << "Invalid Default Value:" << default_value;
   }
@@ -78,7 +99,7 @@ template <typename KeyType, typename ValueType>
 bool ImportCPUHashTable(const UserDataPtr &user_data, const void *tensor_data, size_t size) {
   MS_EXCEPTION_IF_NULL(user_data);
   MS_EXCEPTION_IF_NULL(tensor_data);
-  const auto &cpu_hash_table = user_data->get<CPUHashTable<KeyType, ValueType>>(kUserDataData);
+  const auto &cpu_hash_table = user_data->get<HashTable<KeyType, ValueType>>(kUserDataData);
   MS_EXCEPTION_IF_NULL(cpu_hash_table);
   if (!cpu_hash_table->Import({const_cast<void *>(tensor_data), size})) {
     MS_LOG(ERROR) << "Import for hash table failed.";
@@ -94,7 +115,7 @@ bool ImportCPUHashTable(const UserDataPtr &user_data, const void *tensor_data, s
 template <typename KeyType, typename ValueType>
 void ClearCPUHashTable(const UserDataPtr &user_data) {
   MS_EXCEPTION_IF_NULL(user_data);
-  const auto &cpu_hash_table = user_data->get<CPUHashTable<KeyType, ValueType>>(kUserDataData);
+  const auto &cpu_hash_table = user_data->get<HashTable<KeyType, ValueType>>(kUserDataData);
   MS_EXCEPTION_IF_NULL(cpu_hash_table);
   if (!cpu_hash_table->Clear()) {
     MS_LOG(EXCEPTION) << "Clear user data failed.";
@@ -0,0 +1,621 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "plugin/device/cpu/hal/device/cpu_sharded_hash_table.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <string>
+
+#include "utils/log_adapter.h"
+#include "utils/convert_utils_base.h"
+#include "include/common/thread_pool.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kGroupWidth = 16;
+constexpr size_t kMinShardCapacity = kGroupWidth;
+constexpr int8_t kEmptySlot = static_cast<int8_t>(-128);
+constexpr int8_t kDeletedSlot = static_cast<int8_t>(-2);
+constexpr uint64_t kHashBitsForCtrl = 7;
+constexpr uint64_t kCtrlMask = 0x7F;
+// The max load factor of (elements + deleted slots) / slots is 7/8.
+constexpr size_t kMaxLoadNumerator = 7;
+constexpr size_t kMaxLoadDenominator = 8;
+// The batch smaller than this is processed on the calling thread.
+constexpr size_t kMinParallelKeyNum = 4096;
+
+// Return the bit mask of the control bytes in the group which are equal to `ctrl`.
+inline uint32_t MatchGroup(const int8_t *group, int8_t ctrl) {
+#if defined(__SSE2__)
+  __m128i ctrls = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(ctrl), ctrls)));
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < kGroupWidth; ++i) {
+    if (group[i] == ctrl) {
+      mask |= (1U << i);
+    }
+  }
+  return mask;
+#endif
+}
+
+// Return the bit mask of the empty or deleted control bytes in the group, both of them are negative.
+inline uint32_t MatchEmptyOrDeleted(const int8_t *group) {
+#if defined(__SSE2__)
+  __m128i ctrls = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+  return static_cast<uint32_t>(_mm_movemask_epi8(ctrls));
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < kGroupWidth; ++i) {
+    if (group[i] < 0) {
+      mask |= (1U << i);
+    }
+  }
+  return mask;
+#endif
+}
+
+inline size_t LowestBit(uint32_t mask) {
+  size_t index = 0;
+  while ((mask & 1U) == 0) {
+    mask >>= 1;
+    ++index;
+  }
+  return index;
+}
+
+inline size_t RoundUpPowerOfTwo(size_t num) {
+  size_t ret = 1;
+  while (ret < num) {
+    ret <<= 1;
+  }
+  return ret;
+}
+
+// The capacity which holds `num` elements under the max load factor.
+inline size_t CapacityForSize(size_t num) {
+  size_t capacity = RoundUpPowerOfTwo(num * kMaxLoadDenominator / kMaxLoadNumerator + 1);
+  return std::max(capacity, kMinShardCapacity);
+}
+}  // namespace
+
+template <typename Key, typename Value>
+CPUShardedHashTable<Key, Value>::CPUShardedHashTable(size_t value_dim, const std::string &initializer,
+                                                     size_t shard_num)
+    : value_dim_(value_dim), value_size_(value_dim * sizeof(Value)), initializer_(initializer), default_value_(0) {
+  shard_num = RoundUpPowerOfTwo(std::max(shard_num, static_cast<size_t>(1)));
+  while ((static_cast<size_t>(1) << shard_bits_) < shard_num) {
+    ++shard_bits_;
+  }
+  for (size_t i = 0; i < shard_num; ++i) {
+    (void)shards_.emplace_back(std::make_unique<Shard>());
+    ResetShard(shards_.back().get());
+  }
+}
+
+template <typename Key, typename Value>
+CPUShardedHashTable<Key, Value>::CPUShardedHashTable(size_t value_dim, const Value &default_value, size_t shard_num)
+    : CPUShardedHashTable(value_dim, std::string(""), shard_num) {
+  default_value_ = default_value;
+}
+
+template <typename Key, typename Value>
+uint64_t CPUShardedHashTable<Key, Value>::Hash(const Key &key) const {
+  // The finalizer of murmur3, the low bits are used for the slots and the high bits are used for the shards.
+  uint64_t hash = static_cast<uint64_t>(key);
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+template <typename Key, typename Value>
+size_t CPUShardedHashTable<Key, Value>::ShardIndex(uint64_t hash) const {
+  constexpr size_t kHashBits = 64;
+  return shard_bits_ == 0 ? 0 : static_cast<size_t>(hash >> (kHashBits - shard_bits_));
+}
+
+template <typename Key, typename Value>
+int64_t CPUShardedHashTable<Key, Value>::FindSlot(const Shard &shard, const Key &key, uint64_t hash) const {
+  const size_t group_num = shard.ctrl.size() / kGroupWidth;
+  const int8_t ctrl = static_cast<int8_t>(hash & kCtrlMask);
+  size_t group = static_cast<size_t>(hash >> kHashBitsForCtrl) & (group_num - 1);
+  // The triangular probing visits every group once when the group number is a power of two.
+  for (size_t probe = 1; probe <= group_num; ++probe) {
+    const int8_t *group_ctrl = shard.ctrl.data() + group * kGroupWidth;
+    uint32_t match = MatchGroup(group_ctrl, ctrl);
+    while (match != 0) {
+      size_t slot = group * kGroupWidth + LowestBit(match);
+      if (shard.keys[shard.slots[slot]] == key) {
+        return SizeToLong(slot);
+      }
+      match &= match - 1;
+    }
+    if (MatchGroup(group_ctrl, kEmptySlot) != 0) {
+      return -1;
+    }
+    group = (group + probe) & (group_num - 1);
+  }
+  return -1;
+}
+
+template <typename Key, typename Value>
+size_t CPUShardedHashTable<Key, Value>::FindOrInsert(Shard *shard, const Key &key, uint64_t hash, bool *inserted) {
+  auto slot = FindSlot(*shard, key, hash);
+  if (slot >= 0) {
+    *inserted = false;
+    return shard->slots[LongToSize(slot)];
+  }
+
+  size_t size = shard->keys.size();
+  if ((size + shard->deleted_num + 1) * kMaxLoadDenominator > shard->ctrl.size() * kMaxLoadNumerator) {
+    // Grow if the elements occupy more than half of the slots, otherwise just clean the deleted slots.
+    size_t new_capacity = shard->ctrl.size();
+    if ((size + 1) * 2 > new_capacity) {
+      new_capacity *= 2;
+    }
+    Rehash(shard, new_capacity);
+  }
+
+  const size_t group_num = shard->ctrl.size() / kGroupWidth;
+  size_t group = static_cast<size_t>(hash >> kHashBitsForCtrl) & (group_num - 1);
+  for (size_t probe = 1; probe <= group_num; ++probe) {
+    uint32_t match = MatchEmptyOrDeleted(shard->ctrl.data() + group * kGroupWidth);
+    if (match != 0) {
+      size_t new_slot = group * kGroupWidth + LowestBit(match);
+      if (shard->ctrl[new_slot] == kDeletedSlot) {
+        --shard->deleted_num;
+      }
+      shard->ctrl[new_slot] = static_cast<int8_t>(hash & kCtrlMask);
+      shard->slots[new_slot] = static_cast<uint32_t>(size);
+      shard->keys.push_back(key);
+      shard->statuses.push_back(Status::kModified);
+      shard->values.resize(shard->values.size() + value_dim_);
+      *inserted = true;
+      return size;
+    }
+    group = (group + probe) & (group_num - 1);
+  }
+  MS_LOG(EXCEPTION) << "There is no free slot in the hash table shard, capacity: " << shard->ctrl.size();
+}
+
+template <typename Key, typename Value>
+void CPUShardedHashTable<Key, Value>::EraseSlot(Shard *shard, size_t slot) {
+  size_t index = shard->slots[slot];
+  shard->ctrl[slot] = kDeletedSlot;
+  ++shard->deleted_num;
+
+  // Move the last element to the erased position to keep the elements dense.
+  size_t last = shard->keys.size() - 1;
+  if (index != last) {
+    const Key &last_key = shard->keys[last];
+    auto last_slot = FindSlot(*shard, last_key, Hash(last_key));
+    if (last_slot < 0) {
+      MS_LOG(EXCEPTION) << "The key: " << last_key << " is lost in the hash table.";
+    }
+    shard->slots[LongToSize(last_slot)] = static_cast<uint32_t>(index);
+    shard->keys[index] = last_key;
+    shard->statuses[index] = shard->statuses[last];
+    (void)std::copy_n(shard->values.begin() + last * value_dim_, value_dim_, shard->values.begin() + index * value_dim_);
+  }
+  shard->keys.pop_back();
+  shard->statuses.pop_back();
+  shard->values.resize(last * value_dim_);
+}
+
+template <typename Key, typename Value>
+void CPUShardedHashTable<Key, Value>::Rehash(Shard *shard, size_t new_capacity) const {
+  shard->ctrl.assign(new_capacity, kEmptySlot);
+  shard->slots.assign(new_capacity, 0);
+  shard->deleted_num = 0;
+  const size_t group_num = new_capacity / kGroupWidth;
+  for (size_t index = 0; index < shard->keys.size(); ++index) {
+    uint64_t hash = Hash(shard->keys[index]);
+    size_t group = static_cast<size_t>(hash >> kHashBitsForCtrl) & (group_num - 1);
+    for (size_t probe = 1; probe <= group_num; ++probe) {
+      uint32_t match = MatchGroup(shard->ctrl.data() + group * kGroupWidth, kEmptySlot);
+      if (match != 0) {
+        size_t slot = group * kGroupWidth + LowestBit(match);
+        shard->ctrl[slot] = static_cast<int8_t>(hash & kCtrlMask);
+        shard->slots[slot] = static_cast<uint32_t>(index);
+        break;
+      }
+      group = (group + probe) & (group_num - 1);
+    }
+  }
+}
+
+template <typename Key, typename Value>
+void CPUShardedHashTable<Key, Value>::ResetShard(Shard *shard) const {
+  shard->keys.clear();
+  shard->statuses.clear();
+  shard->values.clear();
+  shard->ctrl.assign(kMinShardCapacity, kEmptySlot);
+  shard->slots.assign(kMinShardCapacity, 0);
+  shard->deleted_num = 0;
+}
+
+template <typename Key, typename Value>
+bool CPUShardedHashTable<Key, Value>::InitValues(Value *values, size_t num) const {
+  if (initializer_.empty()) {
+    (void)std::fill_n(values, num * value_dim_, default_value_);
+    return true;
+  }
+  if (initializer_ == kNormalDistribution) {
+    // initialize normal distribution parameter
+    const double mean = 0.0;
+    const double sigma = 0.01;
+    std::random_device rd;
+    const std::uint64_t seed = rd();
+    size_t skip = 0;
+    random::GenerateRandoms<Value, Generator, NormalDistribution>(seed, skip, values, num * value_dim_, mean, sigma);
+  } else if (initializer_ == kOnesDistribution) {
+    (void)std::fill_n(values, num * value_dim_, static_cast<Value>(1));
+  } else if (initializer_ == kZerosDistribution) {
+    (void)std::fill_n(values, num * value_dim_, static_cast<Value>(0));
+  } else {
+    MS_LOG(ERROR) << "Unsupported initializer: " << initializer_;
+    return false;
+  }
+  return true;
+}
+
+template <typename Key, typename Value>
+bool CPUShardedHashTable<Key, Value>::RunOnShards(
+  const Key *keys, size_t key_num,
+  const std::function<bool(Shard *, const std::vector<size_t> &, const std::vector<uint64_t> &)> &func) {
+  MS_ERROR_IF_NULL(keys);
+  std::vector<uint64_t> hashes(key_num);
+  std::vector<std::vector<size_t>> shard_key_indices(shards_.size());
+  for (size_t i = 0; i < key_num; ++i) {
+    hashes[i] = Hash(keys[i]);
+    (void)shard_key_indices[ShardIndex(hashes[i])].emplace_back(i);
+  }
+
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  size_t thread_num = std::min(thread_pool.GetSyncRunThreadNum(), shards_.size());
+  if (key_num < kMinParallelKeyNum || thread_num <= 1) {
+    for (size_t shard_index = 0; shard_index < shards_.size(); ++shard_index) {
+      if (!shard_key_indices[shard_index].empty() &&
+          !func(shards_[shard_index].get(), shard_key_indices[shard_index], hashes)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::atomic_bool success{true};
+  std::vector<common::Task> tasks;
+  for (size_t task_id = 0; task_id < thread_num; ++task_id) {
+    (void)tasks.emplace_back([&, task_id]() {
+      for (size_t shard_index = task_id; shard_index < shards_.size(); shard_index += thread_num) {
+        if (!shard_key_indices[shard_index].empty() &&
+            !func(shards_[shard_index].get(), shard_key_indices[shard_index], hashes)) {
+          success = false;
+          return common::FAIL;
+        }
+      }
+      return common::SUCCESS;
+    });
+  }
+  (void)thread_pool.SyncRun(tasks);
+  return success.load();
+}
+
+template <typename Key, typename Value>
+bool CPUShardedHashTable<Key, Value>::Find(const Key *keys, size_t key_num, bool insert_default_value,
+                                           Value *outputs, void *) {
+  MS_EXCEPTION_IF_NULL(outputs);
+  std::atomic_bool inserted_any{false};
+  auto find_in_shard = [&](Shard *shard, const std::vector<size_t> &indices, const std::vector<uint64_t> &hashes) {
+    // Copy the values of the existing keys under the shared lock first.
+    std::vector<size_t> missing_indices;
+    {
+      std::shared_lock<std::shared_mutex> lock(shard->mutex);
+      for (auto i : indices) {
+        auto slot = FindSlot(*shard, keys[i], hashes[i]);
+        if (slot < 0) {
+          (void)missing_indices.emplace_back(i);
+          continue;
+        }
+        size_t index = shard->slots[LongToSize(slot)];
+        (void)std::copy_n(shard->values.data() + index * value_dim_, value_dim_, outputs + i * value_dim_);
+      }
+    }
+    if (missing_indices.empty()) {
+      return true;
+    }
+    if (!insert_default_value) {
+      MS_LOG(ERROR) << "The key: " << keys[missing_indices.front()] << " does not exist in the hash table.";
+      return false;
+    }
+
+    // Insert the missing keys with the initializer or the default value.
+    std::unique_lock<std::shared_mutex> lock(shard->mutex);
+    for (auto i : missing_indices) {
+      bool inserted = false;
+      size_t index = FindOrInsert(shard, keys[i], hashes[i], &inserted);
+      Value *value = shard->values.data() + index * value_dim_;
+      if (inserted && !InitValues(value, 1)) {
+        return false;
+      }
+      (void)std::copy_n(value, value_dim_, outputs + i * value_dim_);
+    }
+    inserted_any = true;
+    return true;
+  };
+  bool ret = RunOnShards(keys, key_num, find_in_shard);
+  if (inserted_any) {
+    is_dirty_ = true;
+  }
+  return ret;
+}
+
+template <typename Key, typename Value>
+bool CPUShardedHashTable<Key, Value>::Insert(const Key *keys, size_t key_num, const Value *values, void *) {
+  MS_ERROR_IF_NULL(values);
+  auto insert_in_shard = [&](Shard *shard, const std::vector<size_t> &indices, const std::vector<uint64_t> &hashes) {
+    std::unique_lock<std::shared_mutex> lock(shard->mutex);
+    for (auto i : indices) {
+      bool inserted = false;
+      size_t index = FindOrInsert(shard, keys[i], hashes[i], &inserted);
+      (void)std::copy_n(values + i * value_dim_, value_dim_, shard->values.data() + index * value_dim_);
+      shard->statuses[index] = Status::kModified;
+    }
+    return true;
+  };
+  is_dirty_ = true;
+  return RunOnShards(keys, key_num, insert_in_shard);
+}
+
+template <typename Key, typename Value>
+bool CPUShardedHashTable<Key, Value>::Insert(const Key *keys, size_t key_num, const Value *values, Status *statuses,
+                                             void *) {
+  MS_ERROR_IF_NULL(values);
+  MS_ERROR_IF_NULL(statuses);
+  auto insert_in_shard = [&](Shard *shard, const std::vector<size_t> &indices, const std::vector<uint64_t> &hashes) {
+    std::unique_lock<std::shared_mutex> lock(shard->mutex);
+    for (auto i : indices) {
+      bool inserted = false;
+      size_t index = FindOrInsert(shard, keys[i], hashes[i], &inserted);
+      (void)std::copy_n(values + i * value_dim_, value_dim_, shard->values.data() + index * value_dim_);
+      shard->statuses[index] = statuses[i];
+    }
+    return true;
+  };
+  is_dirty_ = true;
+  return RunOnShards(keys, key_num, insert_in_shard);
+}
+
+template <typename Key, typename Value>
+bool CPUShardedHashTable<Key, Value>::Erase(const Key *keys, size_t key_num, void *) {
+  MS_ERROR_IF_NULL(keys);
+  for (size_t i = 0; i < key_num; ++i) {
+    uint64_t hash = Hash(keys[i]);
+    auto shard = shards_[ShardIndex(hash)].get();
+    std::unique_lock<std::shared_mutex> lock(shard->mutex);
+    auto slot = FindSlot(*shard, keys[i], hash);
+    if (slot < 0) {
+      MS_LOG(ERROR) << "The key: " << keys[i] << " does not exist in the hash table.";
+      return false;
+    }
+    EraseSlot(shard, LongToSize(slot));
+  }
+  return true;
+}
+
+template <typename Key, typename Value>
+bool CPUShardedHashTable<Key, Value>::Reserve(size_t new_capacity, void *) {
+  size_t shard_capacity = CapacityForSize((new_capacity + shards_.size() - 1) / shards_.size());
+  for (auto &shard : shards_) {
+    std::unique_lock<std::shared_mutex> lock(shard->mutex);
+    if (shard->ctrl.size() < shard_capacity) {
+      Rehash(shard.get(), shard_capacity);
+    }
+    size_t element_capacity = shard_capacity * kMaxLoadNumerator / kMaxLoadDenominator;
+    shard->keys.reserve(element_capacity);
+    shard->statuses.reserve(element_capacity);
+    shard->values.reserve(element_capacity * value_dim_);
+  }
+  return true;
+}
+
+template <typename Key, typename Value>
+bool CPUShardedHashTable<Key, Value>::GetKeysAndValues(Key *keys, Value *values, void *) {
+  MS_ERROR_IF_NULL(keys);
+  MS_ERROR_IF_NULL(values);
+  size_t offset = 0;
+  for (auto &shard : shards_) {
+    std::shared_lock<std::shared_mutex> lock(shard->mutex);
+    (void)std::copy(shard->keys.begin(), shard->keys.end(), keys + offset);
+    (void)std::copy(shard->values.begin(), shard->values.end(), values + offset * value_dim_);
+    offset += shard->keys.size();
+  }
+  return true;
+}
+
+template <typename Key, typename Value>
+bool CPUShardedHashTable<Key, Value>::Import(const DataLenPair &input_data) {
+  // 1. import input tensor data once receiving kImportTensorNum(3) input tensors: {key_tensor, value_tensor,
+  // status_tensor}
+  if (import_data_list_.size() < kImportTensorNum) {
+    (void)import_data_list_.emplace_back(input_data);
+  }
+  if (import_data_list_.size() != kImportTensorNum) {
+    return true;
+  }
+
+  const auto &input_keys = import_data_list_[0];
+  const auto &input_values = import_data_list_[1];
+  void *host_keys = input_keys.first;
+  void *host_values = input_values.first;
+  MS_ERROR_IF_NULL(host_keys);
+  MS_ERROR_IF_NULL(host_values);
+
+  size_t keys_len = input_keys.second;
+  if (keys_len == 0) {
+    return true;
+  }
+
+  size_t key_num = keys_len / sizeof(Key);
+  std::vector<Status> statuses(key_num, Status::kUnchanged);
+  if (!Insert(static_cast<Key *>(host_keys), key_num, static_cast<Value *>(host_values), statuses.data(), nullptr)) {
+    MS_LOG(ERROR) << "Insert keys and values failed.";
+    return false;
+  }
+  // Clear the list of input tensors
+  import_data_list_.clear();
+  return true;
+}
+
+template <typename Key, typename Value>
+HashTableExportData CPUShardedHashTable<Key, Value>::ExportSliceImpl(size_t begin, size_t end, bool incremental) {
+  if (end < begin) {
+    MS_LOG(EXCEPTION) << "Invalid export position parameter, begin: " << begin << ", end: " << end;
+  }
+
+  std::vector<Key> export_keys;
+  std::vector<Value> export_values;
+  std::vector<Status> export_statuses;
+  size_t shard_begin = 0;
+  for (auto &shard : shards_) {
+    std::shared_lock<std::shared_mutex> lock(shard->mutex);
+    size_t shard_end = shard_begin + shard->keys.size();
+    size_t first = std::max(begin, shard_begin);
+    size_t last = std::min(end, shard_end);
+    for (size_t global_index = first; global_index < last; ++global_index) {
+      size_t index = global_index - shard_begin;
+      if (incremental && shard->statuses[index] == Status::kUnchanged) {
+        continue;
+      }
+      export_keys.push_back(shard->keys[index]);
+      export_statuses.push_back(shard->statuses[index]);
+      (void)export_values.insert(export_values.end(), shard->values.begin() + index * value_dim_,
+                                 shard->values.begin() + (index + 1) * value_dim_);
+    }
+    shard_begin = shard_end;
+    if (shard_begin >= end) {
+      break;
+    }
+  }
+
+  auto keys = std::make_shared<std::vector<char>>(export_keys.size() * sizeof(Key));
+  auto values = std::make_shared<std::vector<char>>(export_values.size() * sizeof(Value));
+  auto statuses = std::make_shared<std::vector<char>>(export_statuses.size() * sizeof(Status));
+  (void)std::copy_n(reinterpret_cast<const char *>(export_keys.data()), keys->size(), keys->data());
+  (void)std::copy_n(reinterpret_cast<const char *>(export_values.data()), values->size(), values->data());
+  (void)std::copy_n(reinterpret_cast<const char *>(export_statuses.data()), statuses->size(), statuses->data());
+  return {keys, values, statuses};
+}
+
+template <typename Key, typename Value>
+HashTableExportData CPUShardedHashTable<Key, Value>::Export(bool incremental) {
+  // Update is_dirty_ to false because already get latest content after export.
+  is_dirty_ = false;
+
+  size_t total_size = size();
+  if (total_size == 0) {
+    return HashTableExportData();
+  }
+  return ExportSliceImpl(0, total_size, incremental);
+}
+
+template <typename Key, typename Value>
+HashTableExportData CPUShardedHashTable<Key, Value>::ExportSlice(bool incremental, bool *last_slice,
+                                                                 size_t slice_size_in_mega_bytes) {
+  MS_EXCEPTION_IF_NULL(last_slice);
+  size_t total_size = size();
+  if (total_size == 0) {
+    *last_slice = true;
+    return HashTableExportData();
+  }
+
+  constexpr size_t mega_byte_to_byte_rate = static_cast<size_t>(1) << 20;
+  size_t slice_size = slice_size_in_mega_bytes * mega_byte_to_byte_rate / value_size_;
+  if (slice_size == 0) {
+    MS_LOG(EXCEPTION) << "The parameter[slice_size_in_mega_bytes] " << slice_size_in_mega_bytes
+                      << " should be greater than the length in meta bytes of one element in hash map: "
+                      << value_size_ / mega_byte_to_byte_rate;
+  }
+
+  if (end_ == 0) {
+    end_ = std::min(begin_ + slice_size, total_size);
+  }
+
+  HashTableExportData ret = ExportSliceImpl(begin_, end_, incremental);
+
+  *last_slice = (end_ == total_size);
+  if (*last_slice) {
+    begin_ = 0;
+    end_ = 0;
+  } else {
+    begin_ += slice_size;
+    end_ = std::min(begin_ + slice_size, total_size);
+  }
+  return ret;
+}
+
+template <typename Key, typename Value>
+size_t CPUShardedHashTable<Key, Value>::capacity() const {
+  size_t capacity = 0;
+  for (auto &shard : shards_) {
+    std::shared_lock<std::shared_mutex> lock(shard->mutex);
+    capacity += shard->ctrl.size();
+  }
+  return capacity;
+}
+
+template <typename Key, typename Value>
+size_t CPUShardedHashTable<Key, Value>::size() const {
+  size_t size = 0;
+  for (auto &shard : shards_) {
+    std::shared_lock<std::shared_mutex> lock(shard->mutex);
+    size += shard->keys.size();
+  }
+  return size;
+}
+
+template <typename Key, typename Value>
+bool CPUShardedHashTable<Key, Value>::is_dirty() const {
+  return is_dirty_.load();
+}
+
+template <typename Key, typename Value>
+bool CPUShardedHashTable<Key, Value>::Clear() {
+  for (auto &shard : shards_) {
+    std::unique_lock<std::shared_mutex> lock(shard->mutex);
+    ResetShard(shard.get());
+    shard->keys.shrink_to_fit();
+    shard->statuses.shrink_to_fit();
+    shard->values.shrink_to_fit();
+  }
+  return true;
+}
+
+template class CPUShardedHashTable<int32_t, float>;
+template class CPUShardedHashTable<int64_t, float>;
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_SHARDED_HASH_TABLE_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_SHARDED_HASH_TABLE_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "runtime/device/hash_table.h"
+#include "plugin/device/cpu/hal/device/cpu_hash_table.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+constexpr static size_t kDefaultHashTableShardNum = 64;
+
+// A hash table base on the host side cpu, which is split into shards by the high bits of the key hash. Each shard is
+// an open addressing table whose slots are probed in groups of 16 control bytes (SIMD compared when SSE2 is
+// available), and the elements of a shard are kept dense: keys, statuses and a contiguous slab of `value_dim` values
+// per element. The batched Find/Insert group the keys by shard, so each shard is locked once per batch and large
+// batches are processed on the thread pool in parallel.
+template <typename Key, typename Value>
+class CPUShardedHashTable : public HashTable<Key, Value> {
+ public:
+  using Status = HashTableElementStatus;
+
+  CPUShardedHashTable(size_t value_dim, const std::string &initializer, size_t shard_num = kDefaultHashTableShardNum);
+  CPUShardedHashTable(size_t value_dim, const Value &default_value, size_t shard_num = kDefaultHashTableShardNum);
+  ~CPUShardedHashTable() override = default;
+
+  // The last parameter `stream` is meaningless for the cpu hash table version.
+  bool Find(const Key *keys, size_t key_num, bool insert_default_value, Value *outputs, void *) override;
+
+  bool Insert(const Key *keys, size_t key_num, const Value *values, void *) override;
+
+  bool Insert(const Key *keys, size_t key_num, const Value *values, Status *statuses, void *) override;
+
+  bool Erase(const Key *keys, size_t key_num, void *) override;
+
+  bool Reserve(size_t new_capacity, void *) override;
+
+  bool GetKeysAndValues(Key *keys, Value *values, void *) override;
+
+  bool Import(const DataLenPair &input_data) override;
+
+  HashTableExportData Export(bool incremental) override;
+
+  // Export a slice from the hash table, the size is specified by the parameter 'slice_size_in_mega_bytes' in MB.
+  HashTableExportData ExportSlice(bool incremental, bool *last_slice, size_t slice_size_in_mega_bytes) override;
+
+  // The total number of slots of all shards.
+  size_t capacity() const override;
+
+  size_t size() const override;
+
+  bool is_dirty() const override;
+
+  bool Clear() override;
+
+ private:
+  struct Shard {
+    // The control byte of each slot: kEmptySlot, kDeletedSlot or the low 7 bits of the hash of the key in the slot.
+    std::vector<int8_t> ctrl;
+    // The element index of each full slot.
+    std::vector<uint32_t> slots;
+    // The elements are dense in [0, keys.size()), the value of element i is values[i * value_dim, (i + 1) * value_dim).
+    std::vector<Key> keys;
+    std::vector<Status> statuses;
+    std::vector<Value> values;
+    size_t deleted_num{0};
+    mutable std::shared_mutex mutex;
+  };
+
+  uint64_t Hash(const Key &key) const;
+  size_t ShardIndex(uint64_t hash) const;
+
+  // Return the slot of the key in the shard, or -1 if the key does not exist.
+  int64_t FindSlot(const Shard &shard, const Key &key, uint64_t hash) const;
+  // Return the index of the element of the key, insert a new element if the key does not exist, `inserted` is set to
+  // true in that case and the value of the new element is uninitialized.
+  size_t FindOrInsert(Shard *shard, const Key &key, uint64_t hash, bool *inserted);
+  void EraseSlot(Shard *shard, size_t slot);
+  // Rebuild the slots of the shard with the new capacity, which also removes all deleted slots.
+  void Rehash(Shard *shard, size_t new_capacity) const;
+  void ResetShard(Shard *shard) const;
+
+  // Fill the values of newly inserted elements by the initializer or the default value.
+  bool InitValues(Value *values, size_t num) const;
+
+  // Group the key indices by shard and run `func` for each shard which has keys, on the thread pool if the batch is
+  // large enough.
+  bool RunOnShards(const Key *keys, size_t key_num,
+                   const std::function<bool(Shard *, const std::vector<size_t> &, const std::vector<uint64_t> &)> &func);
+
+  // Export the elements in the global index interval [begin, end), the global index of an element is its index in the
+  // shard plus the sizes of all shards in front.
+  HashTableExportData ExportSliceImpl(size_t begin, size_t end, bool incremental);
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  size_t shard_bits_{0};
+
+  // The value dimension and byte size for each key.
+  size_t value_dim_;
+  size_t value_size_;
+
+  // These two augments are set for padding the missing keys.
+  std::string initializer_;
+  Value default_value_;
+
+  // The flag records whether the elements of the hash table have changed since the last export, true means that there
+  // has been a change.
+  std::atomic_bool is_dirty_{true};
+
+  // Record the position of slice export, the elements in the interval [begin_, end_) of hash table will be exported.
+  size_t begin_{0};
+  size_t end_{0};
+
+  // The input tensors {key_tensor, value_tensor, status_tensor} received by Import.
+  std::vector<DataLenPair> import_data_list_;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_SHARDED_HASH_TABLE_H_
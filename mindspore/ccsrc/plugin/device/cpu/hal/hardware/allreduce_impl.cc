@@ -17,14 +17,78 @@
 #include "plugin/device/cpu/hal/hardware/allreduce_impl.h"
 
 #include <vector>
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <map>
 #include <memory>
+#include <numeric>
+#include <thread>
 
 namespace mindspore {
 namespace device {
 namespace cpu {
 namespace {
 constexpr size_t kWaitTimeout = 30;
+// The metadata keys of the name of the shared memory and whether it is ready on every host.
+constexpr char kShmNamePrefix[] = "_allreduce_shm_name_";
+constexpr char kShmStatePrefix[] = "_allreduce_shm_state_";
+constexpr char kShmStateReady[] = "1";
+constexpr char kShmStateFailed[] = "0";
+// Retry every second until the other ranks have registered or published the metadata.
+constexpr size_t kShmRetryTimes = 60;
+
+template <typename T>
+T RetryUntil(const std::function<T()> &func, const std::function<bool(const T &)> &done) {
+  T result = func();
+  for (size_t i = 0; i < kShmRetryTimes && !done(result); ++i) {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    result = func();
+  }
+  return result;
+}
+
+// The channel over the collective node of the parameter server framework.
+class CollectiveNodeChannel : public CollectiveChannel {
+ public:
+  explicit CollectiveNodeChannel(const std::shared_ptr<ps::core::CollectiveNode> &node) : node_(node) {
+    MS_EXCEPTION_IF_NULL(node_);
+  }
+  ~CollectiveNodeChannel() override = default;
+
+  bool SendAsync(uint32_t rank, const void *data, size_t size) override {
+    pending_sends_[rank].push_back(node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, rank, data, size));
+    return true;
+  }
+
+  bool WaitForSend(uint32_t rank) override {
+    auto &send_req_ids = pending_sends_[rank];
+    bool success = true;
+    for (auto send_req_id : send_req_ids) {
+      if (!node_->Wait(send_req_id, kWaitTimeout)) {
+        MS_LOG(ERROR) << "Wait sending " << send_req_id << " to rank " << rank << " failed.";
+        success = false;
+      }
+    }
+    send_req_ids.clear();
+    return success;
+  }
+
+  bool Receive(uint32_t rank, const std::function<bool(const void *, size_t)> &consumer) override {
+    std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
+    auto rec_req_id = node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rank, &rec_ptr);
+    if (!node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
+      MS_LOG(ERROR) << "Wait receiving " << rec_req_id << " from rank " << rank << " failed.";
+      return false;
+    }
+    MS_EXCEPTION_IF_NULL(rec_ptr);
+    return consumer(rec_ptr->data(), rec_ptr->size());
+  }
+
+ private:
+  std::shared_ptr<ps::core::CollectiveNode> node_;
+  std::map<uint32_t, std::vector<uint64_t>> pending_sends_;
+};
 }  // namespace
 
 bool AllReduceLauncher::Initialize() {
@@ -43,9 +107,100 @@ bool AllReduceLauncher::Initialize() {
 
   node_role_ = cluster_ctx->node_role();
   rank_size_ = static_cast<size_t>(cluster_ctx->node_num(cluster_ctx->node_role()));
+  ranks_.resize(rank_size_);
+  std::iota(ranks_.begin(), ranks_.end(), 0);
+  if (node_role_ == distributed::kEnvRoleOfScheduler) {
+    return true;
+  }
+  auto forced_algo = CollectiveAlgoSelector::GetInstance().forced_allreduce_algo();
+  if (forced_algo != CollectiveAlgo::kAuto) {
+    MS_LOG(INFO) << "AllReduceLauncher uses the " << CollectiveAlgoName(forced_algo)
+                 << " algorithm over the sockets only as it is forced.";
+    return true;
+  }
+  hierarchical_ = InitShmCollective(cgn);
+  if (!hierarchical_) {
+    shm_collective_ = nullptr;
+  }
+  MS_LOG(INFO) << "AllReduceLauncher on the rank " << rank_id_ << " uses the "
+               << (hierarchical_ ? "hierarchical" : "ring") << " algorithm, local ranks: " << local_ranks_
+               << ", leader ranks: " << leader_ranks_;
   return true;
 }
 
+bool AllReduceLauncher::InitShmCollective(
+  const std::shared_ptr<distributed::cluster::topology::ComputeGraphNode> &cgn) {
+  MS_EXCEPTION_IF_NULL(cgn);
+  // The hostnames are sorted by the rank id, some of them may be missing until all the nodes have registered.
+  auto hostnames = RetryUntil<std::vector<std::string>>(
+    [&cgn, this]() { return cgn->GetHostNames(node_role_); },
+    [this](const std::vector<std::string> &names) { return names.size() == rank_size_; });
+  if (hostnames.size() != rank_size_) {
+    MS_LOG(WARNING) << "Failed to get the hostnames of all the " << rank_size_ << " ranks, got " << hostnames.size();
+    return false;
+  }
+  for (uint32_t rank = 0; rank < rank_size_; ++rank) {
+    if (hostnames[rank] == hostnames[rank_id_]) {
+      local_ranks_.push_back(rank);
+    }
+    auto first = std::find(hostnames.begin(), hostnames.end(), hostnames[rank]);
+    if (LongToSize(std::distance(hostnames.begin(), first)) == rank) {
+      leader_ranks_.push_back(rank);
+    }
+  }
+  if (leader_ranks_.size() == rank_size_) {
+    // Every rank is on a host of its own, the hierarchical algorithm is the same as the ring.
+    return false;
+  }
+
+  bool ready = true;
+  if (local_ranks_.size() > 1) {
+    size_t local_rank = LongToSize(
+      std::distance(local_ranks_.begin(), std::find(local_ranks_.begin(), local_ranks_.end(), rank_id_)));
+    shm_collective_ = std::make_unique<ShmCollective>(local_rank, local_ranks_.size());
+    std::string name_key = node_role_ + kShmNamePrefix + hostnames[rank_id_];
+    if (local_rank == 0) {
+      std::string name;
+      // The other local ranks should be told even if the creation failed, so they do not wait for nothing.
+      ready = shm_collective_->Create(&name);
+      if (!cgn->PutMetadata(name_key, ready ? name : kShmStateFailed)) {
+        MS_LOG(WARNING) << "Failed to publish the name of the shared memory " << name;
+      }
+      ready = ready && shm_collective_->WaitForAttached();
+    } else {
+      auto name = RetryUntil<std::string>([&cgn, &name_key]() { return cgn->GetMetadata(name_key); },
+                                          [](const std::string &value) { return !value.empty(); });
+      ready = !name.empty() && name != kShmStateFailed && shm_collective_->Attach(name) &&
+              shm_collective_->WaitForReady();
+    }
+  }
+  return AgreeOnShmState(cgn, hostnames, ready);
+}
+
+bool AllReduceLauncher::AgreeOnShmState(const std::shared_ptr<distributed::cluster::topology::ComputeGraphNode> &cgn,
+                                        const std::vector<std::string> &hostnames, bool ready) const {
+  MS_EXCEPTION_IF_NULL(cgn);
+  // The leader publishes the state of its host, and every rank uses the hierarchical algorithm only if the shared
+  // memory is ready on all the hosts, otherwise the ranks would run different algorithms and hang.
+  if (rank_id_ == local_ranks_.front()) {
+    std::string state_key = node_role_ + kShmStatePrefix + hostnames[rank_id_];
+    if (!cgn->PutMetadata(state_key, ready ? kShmStateReady : kShmStateFailed)) {
+      MS_LOG(WARNING) << "Failed to publish the state of the shared memory of the host " << hostnames[rank_id_];
+    }
+  }
+  bool all_ready = true;
+  for (auto leader : leader_ranks_) {
+    std::string state_key = node_role_ + kShmStatePrefix + hostnames[leader];
+    auto state = RetryUntil<std::string>([&cgn, &state_key]() { return cgn->GetMetadata(state_key); },
+                                         [](const std::string &value) { return !value.empty(); });
+    if (state != kShmStateReady) {
+      MS_LOG(WARNING) << "The shared memory of the host " << hostnames[leader] << " is not ready, state: " << state;
+      all_ready = false;
+    }
+  }
+  return all_ready;
+}
+
 bool AllReduceLauncher::Finalize() {
   MS_EXCEPTION_IF_NULL(abs_node_);
   if (!abs_node_->Finish()) {
@@ -65,188 +220,73 @@ bool AllReduceLauncher::Execute(const void *input_data, void *const output_data,
   if (node_role_ == distributed::kEnvRoleOfScheduler) {
     return true;
   }
-  size_t data_num = data_size / sizeof(float);
-  if (data_num < rank_size_) {
-    MS_LOG(DEBUG) << "AllReduceLauncher executes ReduceBroadcastAllReduce algorithm on the rank " << rank_id_;
-    return ReduceBroadcastAllReduce(input_data, output_data, data_size);
+  if (hierarchical_) {
+    MS_LOG(DEBUG) << "AllReduceLauncher executes HierarchicalAllReduce algorithm on the rank " << rank_id_;
+    return HierarchicalAllReduce(input_data, output_data, data_size);
   }
-  // If the data number is not less than the node number, the RingAllReduce algorithm is used.
-  MS_LOG(DEBUG) << "AllReduceLauncher executes RingAllReduce algorithm on the rank " << rank_id_;
-  return RingAllReduce(input_data, output_data, data_size);
-}
-
-bool AllReduceLauncher::RingAllReduce(const void *input_data, void *const output_data, size_t data_size) const {
   int memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
   if (memcpy_ret != EOK) {
-    MS_LOG(ERROR) << "RingAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
+    MS_LOG(ERROR) << "AllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
     return false;
   }
-  MS_EXCEPTION_IF_CHECK_FAIL((rank_size_ != 0), "The rank size is zero.");
-  size_t data_num = data_size / sizeof(float);
-  size_t chunk_size = data_num / rank_size_;
-  size_t remainder_size = data_num % rank_size_;
-  std::vector<size_t> chunk_sizes(rank_size_, chunk_size);
-  // The rest of the data should be assigned to each chunk.
-  for (size_t i = 0; i < remainder_size; i++) {
-    chunk_sizes[i]++;
-  }
-  // Store offsets to get every data chunk's address.
-  std::vector<size_t> chunk_offset;
-  for (size_t i = 0; i < rank_size_; i++) {
-    size_t ofs =
-      std::accumulate(chunk_sizes.begin(), chunk_sizes.begin() + SizeToLong(i), size_t(0), std::plus<size_t>());
-    chunk_offset.push_back(ofs);
-  }
+  return AllReduce(reinterpret_cast<float *>(output_data), data_size / sizeof(float), ranks_);
+}
 
-  auto *output_buff = reinterpret_cast<float *>(output_data);
-  uint32_t send_to_rank = SizeToUint((rank_id_ + 1) % rank_size_);
-  uint32_t rec_from_rank = SizeToUint((rank_id_ - 1 + rank_size_) % rank_size_);
-  MS_LOG(DEBUG) << "AllReduce data_num:" << data_num << ", rank_size_:" << rank_size_ << ", rank_id_:" << rank_id_
-                << ", chunk_size:" << chunk_size << ", remainder_size:" << remainder_size
-                << ", chunk_sizes:" << chunk_sizes << ", send_to_rank:" << send_to_rank
-                << ", rec_from_rank:" << rec_from_rank;
-
-  // Ring ReduceScatter.
-  MS_LOG(DEBUG) << "Start Ring ReduceScatter.";
-  MS_EXCEPTION_IF_NULL(abs_node_);
-  for (size_t i = 0; i < rank_size_ - 1; i++) {
-    // Step 1: Async send data to next rank.
-    size_t send_chunk_index = (rank_id_ - i + rank_size_) % rank_size_;
-    float *send_chunk = output_buff + chunk_offset[send_chunk_index];
-    auto send_req_id = abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, send_chunk,
-                                                      chunk_sizes[send_chunk_index] * sizeof(float));
-    // Step 2: Async receive data to next rank and wait until it's done.
-    size_t rec_chunk_index = (rank_id_ - i - 1 + rank_size_) % rank_size_;
-    float *rec_chunk = output_buff + chunk_offset[rec_chunk_index];
-    MS_LOG(DEBUG) << "Ring ReduceScatter send_to_rank:" << send_to_rank << ", rec_from_rank:" << rec_from_rank
-                  << ", send data_num:" << chunk_sizes[send_chunk_index]
-                  << ", rec data_num:" << chunk_sizes[rec_chunk_index] << ", iteration:" << i;
+bool AllReduceLauncher::IsShmAllGatherAvailable() const {
+  return hierarchical_ && shm_collective_ != nullptr && leader_ranks_.size() == 1;
+}
 
-    std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptr);
-    if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring ReduceScatter wait receiving [" << rec_req_id.first << "," << rec_req_id.second
-                    << "] failed.";
-      return false;
-    }
-    // Step 3: Reduce the data, so we can overlap the time cost of send.
-    MS_EXCEPTION_IF_NULL(rec_ptr);
-    const auto *tmp_data = reinterpret_cast<float *>(rec_ptr->data());
-    for (size_t j = 0; j < chunk_sizes[rec_chunk_index]; j++) {
-      rec_chunk[j] += tmp_data[j];
-    }
-    // Step 4: Wait until send is done.
-    if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring ReduceScatter wait sending " << send_req_id << " failed.";
-      return false;
-    }
+bool AllReduceLauncher::ShmAllGather(const void *input_data, void *const output_data, size_t data_size) const {
+  MS_EXCEPTION_IF_NULL(shm_collective_);
+  // All the ranks are on this host, so the local rank is the same as the rank.
+  return shm_collective_->AllGather(input_data, output_data, data_size);
+}
+
+bool AllReduceLauncher::HierarchicalAllReduce(const void *input_data, void *const output_data,
+                                              size_t data_size) const {
+  size_t data_num = data_size / sizeof(float);
+  const auto *input_buff = reinterpret_cast<const float *>(input_data);
+  auto *output_buff = reinterpret_cast<float *>(output_data);
+  if (shm_collective_ != nullptr && leader_ranks_.size() == 1) {
+    // All the ranks are on this host, every rank copies the result out of the shared memory by itself.
+    return shm_collective_->AllReduce(input_buff, output_buff, data_num);
   }
-  MS_LOG(DEBUG) << "End Ring ReduceScatter.";
-
-  // Ring AllGather.
-  MS_LOG(DEBUG) << "Start Ring AllGather.";
-  for (size_t i = 0; i < rank_size_ - 1; i++) {
-    size_t send_chunk_index = (rank_id_ - i + 1 + rank_size_) % rank_size_;
-    float *send_chunk = output_buff + chunk_offset[send_chunk_index];
-    auto send_req_id = abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, send_chunk,
-                                                      chunk_sizes[send_chunk_index] * sizeof(float));
-    size_t rec_chunk_index = (rank_id_ - i + rank_size_) % rank_size_;
-    float *rec_chunk = output_buff + chunk_offset[rec_chunk_index];
-    MS_LOG(DEBUG) << "Ring AllGather send_to_rank:" << send_to_rank << ", rec_from_rank:" << rec_from_rank
-                  << ", send data_num:" << chunk_sizes[send_chunk_index]
-                  << ", rec data_num:" << chunk_sizes[rec_chunk_index] << ", iteration:" << i;
 
-    std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptr);
-    if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring AllGather wait receiving " << rec_req_id << " failed.";
-      return false;
-    }
-    MS_EXCEPTION_IF_NULL(rec_ptr);
-    memcpy_ret = memcpy_s(rec_chunk, chunk_sizes[rec_chunk_index] * sizeof(float), rec_ptr->data(), rec_ptr->size());
-    if (memcpy_ret != 0) {
-      MS_LOG(ERROR) << "Ring AllGather memcpy_s received data error, errorno(" << memcpy_ret << ")";
+  // Step 1: Reduce the data of the ranks on this host to the leader through the shared memory.
+  if (shm_collective_ != nullptr) {
+    if (!shm_collective_->Reduce(input_buff, output_buff, data_num)) {
+      MS_LOG(ERROR) << "HierarchicalAllReduce failed to reduce the data on the host.";
       return false;
     }
-    if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "RingAllReduce wait sending " << send_req_id << " failed.";
+  } else {
+    int memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
+    if (memcpy_ret != EOK) {
+      MS_LOG(ERROR) << "HierarchicalAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
       return false;
     }
   }
-  MS_LOG(DEBUG) << "End Ring AllGather.";
-  return true;
-}
-
-const std::shared_ptr<ps::core::CollectiveNode> &AllReduceLauncher::collective_node() const { return abs_node_; }
-
-bool AllReduceLauncher::ReduceBroadcastAllReduce(const void *input_data, void *const output_data,
-                                                 size_t data_size) const {
-  int memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
-  if (memcpy_ret != EOK) {
-    MS_LOG(ERROR) << "ReduceBroadcastAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
+  // Step 2: AllReduce among the leaders of the hosts over the sockets.
+  if (rank_id_ == local_ranks_.front() && !AllReduce(output_buff, data_num, leader_ranks_)) {
+    MS_LOG(ERROR) << "HierarchicalAllReduce failed to allreduce the data among the hosts.";
     return false;
   }
-  size_t data_num = data_size / sizeof(float);
-  float *output_buff = reinterpret_cast<float *>(output_data);
-  // Reduce data to rank 0 process.
-  MS_LOG(DEBUG) << "Start Reduce to rank 0 process.";
-  MS_EXCEPTION_IF_NULL(abs_node_);
-  if (rank_id_ == 0) {
-    for (uint32_t i = 1; i < rank_size_; i++) {
-      std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-      MS_LOG(DEBUG) << "Reduce rank 0 receive from rank " << i;
-      auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, i, &rec_ptr);
-      if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-        MS_LOG(ERROR) << "Reduce wait receiving " << rec_req_id << " failed.";
-        return false;
-      }
-      MS_EXCEPTION_IF_NULL(rec_ptr);
-      const auto *tmp_data = reinterpret_cast<float *>(rec_ptr->data());
-      for (size_t j = 0; j < data_num; j++) {
-        output_buff[j] += tmp_data[j];
-      }
-    }
-  } else {
-    MS_LOG(DEBUG) << "Reduce send data to rank 0 process.";
-    auto send_req_id =
-      abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, 0, input_data, data_num * sizeof(float));
-    if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Reduce wait sending " << send_req_id << " failed.";
-      return false;
-    }
-  }
-  MS_LOG(DEBUG) << "End Reduce.";
-
-  // Broadcast data to not rank 0 process.
-  MS_LOG(DEBUG) << "Start broadcast from rank 0 to other processes.";
-  if (rank_id_ == 0) {
-    for (uint32_t i = 1; i < rank_size_; i++) {
-      MS_LOG(DEBUG) << "Broadcast data to process " << i;
-      auto send_req_id =
-        abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, i, output_buff, data_num * sizeof(float));
-      if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
-        MS_LOG(ERROR) << "Broadcast wait sending " << send_req_id << " failed.";
-        return false;
-      }
-    }
-  } else {
-    MS_LOG(DEBUG) << "Broadcast receive from rank 0.";
-    std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, 0, &rec_ptr);
-    if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Broadcast wait receiving " << rec_req_id << " failed.";
-      return false;
-    }
-    MS_EXCEPTION_IF_NULL(rec_ptr);
-    memcpy_ret = memcpy_s(output_buff, data_num * sizeof(float), rec_ptr->data(), rec_ptr->size());
-    if (memcpy_ret != 0) {
-      MS_LOG(ERROR) << "Broadcast memcpy_s received data error, errorno(" << memcpy_ret << ")";
-      return false;
-    }
+  // Step 3: Broadcast the result of the leader to the ranks on this host.
+  if (shm_collective_ != nullptr && !shm_collective_->Broadcast(output_data, data_num * sizeof(float))) {
+    MS_LOG(ERROR) << "HierarchicalAllReduce failed to broadcast the data on the host.";
+    return false;
   }
-  MS_LOG(DEBUG) << "End broadcast.";
   return true;
 }
+
+bool AllReduceLauncher::AllReduce(float *data, size_t data_num, const std::vector<uint32_t> &ranks) const {
+  MS_EXCEPTION_IF_NULL(abs_node_);
+  // The algorithm is picked by the data size and the rank size, see CollectiveAlgoSelector.
+  CollectiveNodeChannel channel(abs_node_);
+  CollectiveAlgorithms<float> algorithms(&channel, SizeToUint(rank_id_), ranks);
+  return algorithms.AllReduce(data, data_num);
+}
+
+const std::shared_ptr<ps::core::CollectiveNode> &AllReduceLauncher::collective_node() const { return abs_node_; }
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
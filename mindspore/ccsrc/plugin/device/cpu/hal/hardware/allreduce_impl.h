@@ -19,8 +19,11 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 #include "include/backend/distributed/cluster/cluster_context.h"
 #include "plugin/device/cpu/hal/hardware/ms_collective_node.h"
+#include "plugin/device/cpu/hal/hardware/shm_collective.h"
+#include "plugin/device/cpu/hal/hardware/collective_algorithms.h"
 
 namespace mindspore {
 namespace device {
@@ -37,6 +40,10 @@ class AllReduceLauncher {
 
   bool Execute(const void *input_data, void *const output_data, size_t data_size) const;
 
+  // Whether all the ranks are on this host and share the memory, then AllGather can be done by ShmAllGather.
+  bool IsShmAllGatherAvailable() const;
+  bool ShmAllGather(const void *input_data, void *const output_data, size_t data_size) const;
+
   const std::shared_ptr<ps::core::CollectiveNode> &collective_node() const;
 
  private:
@@ -45,8 +52,25 @@ class AllReduceLauncher {
   std::string node_role_{distributed::kEnvRoleOfWorker};
   std::shared_ptr<ps::core::CollectiveNode> abs_node_{nullptr};
 
-  bool RingAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
-  bool ReduceBroadcastAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
+  // All the ranks, the ranks on this host, and the leader of every host which is the smallest rank on it.
+  std::vector<uint32_t> ranks_;
+  std::vector<uint32_t> local_ranks_;
+  std::vector<uint32_t> leader_ranks_;
+  // Whether the hierarchical algorithm is used, which is agreed by all the ranks.
+  bool hierarchical_{false};
+  // The shared memory of the ranks on this host, nullptr if this rank is the only one on this host.
+  std::unique_ptr<ShmCollective> shm_collective_{nullptr};
+
+  // Set up the shared memory among the ranks on this host, return whether the hierarchical algorithm can be used.
+  bool InitShmCollective(const std::shared_ptr<distributed::cluster::topology::ComputeGraphNode> &cgn);
+  // Whether the hierarchical algorithm can be used on all the hosts.
+  bool AgreeOnShmState(const std::shared_ptr<distributed::cluster::topology::ComputeGraphNode> &cgn,
+                       const std::vector<std::string> &hostnames, bool ready) const;
+
+  // Intra-host shared memory reduce, then inter-host AllReduce among the leaders, then intra-host broadcast.
+  bool HierarchicalAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
+  // AllReduce in place among the ranks over the sockets.
+  bool AllReduce(float *data, size_t data_num, const std::vector<uint32_t> &ranks) const;
 };
 }  // namespace cpu
 }  // namespace device
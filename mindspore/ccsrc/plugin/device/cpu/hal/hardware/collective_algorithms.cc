@@ -0,0 +1,104 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/hal/hardware/collective_algorithms.h"
+
+#include <map>
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr char kEnvCpuAllReduceAlgo[] = "MS_CPU_ALLREDUCE_ALGO";
+constexpr char kEnvCpuCollectiveSmallSize[] = "MS_CPU_COLLECTIVE_SMALL_SIZE";
+constexpr char kEnvCpuCollectiveLargeSize[] = "MS_CPU_COLLECTIVE_LARGE_SIZE";
+// Below 64KB the hops of the ring cost more than sending the whole data log(n) times over the loopback or a LAN.
+constexpr size_t kDefaultSmallSize = 64 << 10;
+constexpr size_t kDefaultLargeSize = 4 << 20;
+
+const std::map<std::string, CollectiveAlgo> kAlgoNames = {{"auto", CollectiveAlgo::kAuto},
+                                                          {"ring", CollectiveAlgo::kRing},
+                                                          {"recursive_doubling", CollectiveAlgo::kRecursiveDoubling},
+                                                          {"rabenseifner", CollectiveAlgo::kRabenseifner},
+                                                          {"tree", CollectiveAlgo::kTree}};
+
+size_t GetSizeFromEnv(const char *env, size_t default_size) {
+  auto value = common::GetEnv(env);
+  if (value.empty()) {
+    return default_size;
+  }
+  try {
+    return std::stoul(value);
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Invalid value of " << env << ": " << value << ", use the default " << default_size;
+    return default_size;
+  }
+}
+}  // namespace
+
+CollectiveAlgoSelector &CollectiveAlgoSelector::GetInstance() {
+  static CollectiveAlgoSelector instance;
+  return instance;
+}
+
+CollectiveAlgoSelector::CollectiveAlgoSelector()
+    : small_size_(GetSizeFromEnv(kEnvCpuCollectiveSmallSize, kDefaultSmallSize)),
+      large_size_(GetSizeFromEnv(kEnvCpuCollectiveLargeSize, kDefaultLargeSize)) {
+  auto algo = common::GetEnv(kEnvCpuAllReduceAlgo);
+  if (!algo.empty()) {
+    auto iter = kAlgoNames.find(algo);
+    if (iter == kAlgoNames.end() || iter->second == CollectiveAlgo::kTree) {
+      MS_LOG(WARNING) << "Invalid AllReduce algorithm " << algo << " set by " << kEnvCpuAllReduceAlgo
+                      << ", which should be one of ring, recursive_doubling and rabenseifner.";
+    } else {
+      forced_allreduce_algo_ = iter->second;
+    }
+  }
+  MS_LOG(INFO) << "The collective algorithms are selected with small size " << small_size_ << ", large size "
+               << large_size_ << " and AllReduce algorithm " << CollectiveAlgoName(forced_allreduce_algo_);
+}
+
+CollectiveAlgo CollectiveAlgoSelector::SelectAllReduce(size_t count, size_t type_size, size_t rank_size) const {
+  if (forced_allreduce_algo_ != CollectiveAlgo::kAuto) {
+    return forced_allreduce_algo_;
+  }
+  size_t data_size = count * type_size;
+  // The chunks of the ring and the halves of Rabenseifner would be empty if the count is less than the rank size.
+  if (rank_size <= 2 || count < rank_size || data_size < small_size_) {
+    return CollectiveAlgo::kRecursiveDoubling;
+  }
+  if (data_size < large_size_) {
+    return CollectiveAlgo::kRabenseifner;
+  }
+  return CollectiveAlgo::kRing;
+}
+
+CollectiveAlgo CollectiveAlgoSelector::SelectAllGather(size_t count, size_t type_size, size_t rank_size) const {
+  return count * type_size * rank_size < small_size_ ? CollectiveAlgo::kTree : CollectiveAlgo::kRing;
+}
+
+std::string CollectiveAlgoName(CollectiveAlgo algo) {
+  for (const auto &[name, value] : kAlgoNames) {
+    if (value == algo) {
+      return name;
+    }
+  }
+  return "unknown";
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,432 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_COLLECTIVE_ALGORITHMS_H_
+#define MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_COLLECTIVE_ALGORITHMS_H_
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "utils/log_adapter.h"
+#include "include/securec.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The point to point communication which the collective algorithms are built on. The messages from a rank must be
+// received in the order they are sent.
+class CollectiveChannel {
+ public:
+  virtual ~CollectiveChannel() = default;
+
+  // Send the data to the rank asynchronously, the data should not be modified until WaitForSend returns.
+  virtual bool SendAsync(uint32_t rank, const void *data, size_t size) = 0;
+
+  // Wait for all the pending sending to the rank to be finished.
+  virtual bool WaitForSend(uint32_t rank) = 0;
+
+  // Receive the next message from the rank and hand it to the consumer, so it can be reduced without another copy.
+  virtual bool Receive(uint32_t rank, const std::function<bool(const void *, size_t)> &consumer) = 0;
+};
+
+enum class CollectiveAlgo { kAuto = 0, kRing, kRecursiveDoubling, kRabenseifner, kTree };
+
+// Pick the algorithm of a collective from the message size and the number of ranks. The latency of the ring is
+// 2 * (n - 1) hops, which dominates for small messages, so:
+//   AllReduce: recursive doubling (log(n) hops, sends all the data every hop) below the small size, Rabenseifner
+//     (2 * log(n) hops, bandwidth optimal) below the large size, and ring above it, which only talks to neighbors.
+//   AllGather: binomial tree gather and broadcast below the small size, ring above it.
+// The thresholds are read from MS_CPU_COLLECTIVE_SMALL_SIZE and MS_CPU_COLLECTIVE_LARGE_SIZE in bytes, and the
+// algorithm of AllReduce can be forced by MS_CPU_ALLREDUCE_ALGO, which is useful to calibrate the thresholds.
+class CollectiveAlgoSelector {
+ public:
+  static CollectiveAlgoSelector &GetInstance();
+
+  CollectiveAlgo SelectAllReduce(size_t count, size_t type_size, size_t rank_size) const;
+  CollectiveAlgo SelectAllGather(size_t count, size_t type_size, size_t rank_size) const;
+
+  // The algorithm of AllReduce set by MS_CPU_ALLREDUCE_ALGO, kAuto if it is not set.
+  CollectiveAlgo forced_allreduce_algo() const { return forced_allreduce_algo_; }
+
+ private:
+  CollectiveAlgoSelector();
+  ~CollectiveAlgoSelector() = default;
+  CollectiveAlgoSelector(const CollectiveAlgoSelector &) = delete;
+  CollectiveAlgoSelector &operator=(const CollectiveAlgoSelector &) = delete;
+
+  CollectiveAlgo forced_allreduce_algo_{CollectiveAlgo::kAuto};
+  size_t small_size_;
+  size_t large_size_;
+};
+
+std::string CollectiveAlgoName(CollectiveAlgo algo);
+
+// The collective algorithms over the ranks given in order, the position of a rank in the ranks is its index in the
+// collective. Only summation is supported for reduction, the same as the callers.
+template <typename T>
+class CollectiveAlgorithms {
+ public:
+  CollectiveAlgorithms(CollectiveChannel *channel, uint32_t rank_id, const std::vector<uint32_t> &ranks)
+      : channel_(channel), ranks_(ranks) {
+    MS_EXCEPTION_IF_NULL(channel_);
+    auto iter = std::find(ranks_.begin(), ranks_.end(), rank_id);
+    MS_EXCEPTION_IF_CHECK_FAIL(iter != ranks_.end(), "The rank " + std::to_string(rank_id) + " is not in the ranks.");
+    index_ = static_cast<size_t>(iter - ranks_.begin());
+  }
+  ~CollectiveAlgorithms() = default;
+
+  // AllReduce the data in place with the algorithm, kAuto picks it by CollectiveAlgoSelector.
+  bool AllReduce(T *data, size_t count, CollectiveAlgo algo = CollectiveAlgo::kAuto);
+  bool RingAllReduce(T *data, size_t count);
+  bool RecursiveDoublingAllReduce(T *data, size_t count);
+  bool RabenseifnerAllReduce(T *data, size_t count);
+
+  // Broadcast the data of the rank at the root index along a binomial tree in log(n) steps.
+  bool TreeBroadcast(T *data, size_t count, size_t root_index);
+
+  // Gather the count elements of every rank in the order of the ranks, along a binomial tree to the first rank and
+  // broadcast back. The data of this rank should be in its block of the output already.
+  bool TreeAllGather(T *output, size_t count);
+
+ private:
+  // Send to a rank and receive from a rank at the same time, the received data should not overlap the sent data.
+  bool Exchange(uint32_t send_rank, const T *send, size_t send_count, uint32_t recv_rank, T *recv, size_t recv_count,
+                bool reduce);
+  bool Send(uint32_t rank, const T *data, size_t count);
+  bool Recv(uint32_t rank, T *data, size_t count, bool reduce);
+
+  // The largest power of two not greater than the rank size.
+  size_t FloorPow2() const;
+  // For the recursive algorithms on n ranks which is not a power of two, the first 2 * (n - p) ranks are folded in
+  // pairs into p ranks, where p is the largest power of two not greater than n. The index among the p ranks is -1 if
+  // this rank is folded and waits for the result in FoldOut.
+  bool FoldIn(T *data, size_t count, size_t pow2, int64_t *folded_index);
+  bool FoldOut(T *data, size_t count, size_t pow2);
+  uint32_t UnfoldedRank(size_t folded_index, size_t pow2) const;
+
+  CollectiveChannel *channel_;
+  std::vector<uint32_t> ranks_;
+  size_t index_;
+};
+
+template <typename T>
+bool CollectiveAlgorithms<T>::Send(uint32_t rank, const T *data, size_t count) {
+  if (!channel_->SendAsync(rank, data, count * sizeof(T)) || !channel_->WaitForSend(rank)) {
+    MS_LOG(ERROR) << "Failed to send data to rank: " << rank;
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool CollectiveAlgorithms<T>::Recv(uint32_t rank, T *data, size_t count, bool reduce) {
+  bool success = channel_->Receive(rank, [data, count, reduce](const void *recv_data, size_t size) {
+    if (size != count * sizeof(T)) {
+      MS_LOG(ERROR) << "The size of the received data is " << size << ", but expected " << (count * sizeof(T));
+      return false;
+    }
+    const T *recv = reinterpret_cast<const T *>(recv_data);
+    if (!reduce) {
+      auto ret = memcpy_s(data, count * sizeof(T), recv, size);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+        return false;
+      }
+      return true;
+    }
+    for (size_t i = 0; i < count; i++) {
+      data[i] += recv[i];
+    }
+    return true;
+  });
+  if (!success) {
+    MS_LOG(ERROR) << "Failed to receive data from rank: " << rank;
+  }
+  return success;
+}
+
+template <typename T>
+bool CollectiveAlgorithms<T>::Exchange(uint32_t send_rank, const T *send, size_t send_count, uint32_t recv_rank,
+                                       T *recv, size_t recv_count, bool reduce) {
+  if (!channel_->SendAsync(send_rank, send, send_count * sizeof(T))) {
+    MS_LOG(ERROR) << "Failed to send data to rank: " << send_rank;
+    return false;
+  }
+  if (!Recv(recv_rank, recv, recv_count, reduce)) {
+    return false;
+  }
+  if (!channel_->WaitForSend(send_rank)) {
+    MS_LOG(ERROR) << "Failed to wait for sending data to rank: " << send_rank;
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+size_t CollectiveAlgorithms<T>::FloorPow2() const {
+  size_t pow2 = 1;
+  while (pow2 * 2 <= ranks_.size()) {
+    pow2 *= 2;
+  }
+  return pow2;
+}
+
+template <typename T>
+bool CollectiveAlgorithms<T>::FoldIn(T *data, size_t count, size_t pow2, int64_t *folded_index) {
+  size_t rem = ranks_.size() - pow2;
+  if (index_ >= 2 * rem) {
+    *folded_index = static_cast<int64_t>(index_ - rem);
+    return true;
+  }
+  // The even one hands its data to the odd one next to it.
+  if (index_ % 2 == 0) {
+    *folded_index = -1;
+    return Send(ranks_[index_ + 1], data, count);
+  }
+  *folded_index = static_cast<int64_t>(index_ / 2);
+  return Recv(ranks_[index_ - 1], data, count, true);
+}
+
+template <typename T>
+bool CollectiveAlgorithms<T>::FoldOut(T *data, size_t count, size_t pow2) {
+  size_t rem = ranks_.size() - pow2;
+  if (index_ >= 2 * rem) {
+    return true;
+  }
+  if (index_ % 2 == 0) {
+    return Recv(ranks_[index_ + 1], data, count, false);
+  }
+  return Send(ranks_[index_ - 1], data, count);
+}
+
+template <typename T>
+uint32_t CollectiveAlgorithms<T>::UnfoldedRank(size_t folded_index, size_t pow2) const {
+  size_t rem = ranks_.size() - pow2;
+  return ranks_[folded_index < rem ? folded_index * 2 + 1 : folded_index + rem];
+}
+
+template <typename T>
+bool CollectiveAlgorithms<T>::AllReduce(T *data, size_t count, CollectiveAlgo algo) {
+  MS_EXCEPTION_IF_NULL(data);
+  if (ranks_.size() <= 1 || count == 0) {
+    return true;
+  }
+  if (algo == CollectiveAlgo::kAuto) {
+    algo = CollectiveAlgoSelector::GetInstance().SelectAllReduce(count, sizeof(T), ranks_.size());
+  }
+  MS_LOG(DEBUG) << "AllReduce " << count << " elements among " << ranks_.size() << " ranks by "
+                << CollectiveAlgoName(algo);
+  switch (algo) {
+    case CollectiveAlgo::kRing:
+      return RingAllReduce(data, count);
+    case CollectiveAlgo::kRabenseifner:
+      return RabenseifnerAllReduce(data, count);
+    default:
+      return RecursiveDoublingAllReduce(data, count);
+  }
+}
+
+template <typename T>
+bool CollectiveAlgorithms<T>::RingAllReduce(T *data, size_t count) {
+  size_t rank_size = ranks_.size();
+  if (count < rank_size) {
+    // Some chunks would be empty.
+    return RecursiveDoublingAllReduce(data, count);
+  }
+  std::vector<size_t> chunk_sizes(rank_size, count / rank_size);
+  // The rest of the data should be assigned to each chunk.
+  for (size_t i = 0; i < count % rank_size; i++) {
+    chunk_sizes[i]++;
+  }
+  std::vector<size_t> chunk_offset(rank_size, 0);
+  for (size_t i = 1; i < rank_size; i++) {
+    chunk_offset[i] = chunk_offset[i - 1] + chunk_sizes[i - 1];
+  }
+  uint32_t send_to_rank = ranks_[(index_ + 1) % rank_size];
+  uint32_t recv_from_rank = ranks_[(index_ + rank_size - 1) % rank_size];
+
+  // Ring ReduceScatter, then ring AllGather.
+  for (size_t i = 0; i < rank_size - 1; i++) {
+    size_t send_index = (index_ + rank_size - i) % rank_size;
+    size_t recv_index = (index_ + rank_size - i - 1) % rank_size;
+    if (!Exchange(send_to_rank, data + chunk_offset[send_index], chunk_sizes[send_index], recv_from_rank,
+                  data + chunk_offset[recv_index], chunk_sizes[recv_index], true)) {
+      MS_LOG(ERROR) << "Ring ReduceScatter failed at iteration " << i;
+      return false;
+    }
+  }
+  for (size_t i = 0; i < rank_size - 1; i++) {
+    size_t send_index = (index_ + rank_size - i + 1) % rank_size;
+    size_t recv_index = (index_ + rank_size - i) % rank_size;
+    if (!Exchange(send_to_rank, data + chunk_offset[send_index], chunk_sizes[send_index], recv_from_rank,
+                  data + chunk_offset[recv_index], chunk_sizes[recv_index], false)) {
+      MS_LOG(ERROR) << "Ring AllGather failed at iteration " << i;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool CollectiveAlgorithms<T>::RecursiveDoublingAllReduce(T *data, size_t count) {
+  size_t pow2 = FloorPow2();
+  int64_t folded_index = -1;
+  if (!FoldIn(data, count, pow2, &folded_index)) {
+    return false;
+  }
+  if (folded_index >= 0) {
+    // The whole data is exchanged with the partner at distance 1, 2, 4... The sent data is reduced after the sending
+    // is done, and every rank adds up in the same order, so all the ranks get the same result.
+    std::vector<T> recv(count);
+    auto index = static_cast<size_t>(folded_index);
+    for (size_t mask = 1; mask < pow2; mask <<= 1) {
+      uint32_t partner = UnfoldedRank(index ^ mask, pow2);
+      if (!Exchange(partner, data, count, partner, recv.data(), count, false)) {
+        MS_LOG(ERROR) << "Recursive doubling AllReduce failed with rank " << partner;
+        return false;
+      }
+      for (size_t i = 0; i < count; i++) {
+        data[i] += recv[i];
+      }
+    }
+  }
+  return FoldOut(data, count, pow2);
+}
+
+template <typename T>
+bool CollectiveAlgorithms<T>::RabenseifnerAllReduce(T *data, size_t count) {
+  if (count < ranks_.size()) {
+    // Some halves would be empty.
+    return RecursiveDoublingAllReduce(data, count);
+  }
+  size_t pow2 = FloorPow2();
+  int64_t folded_index = -1;
+  if (!FoldIn(data, count, pow2, &folded_index)) {
+    return false;
+  }
+  if (folded_index >= 0) {
+    auto index = static_cast<size_t>(folded_index);
+    // ReduceScatter by recursive halving: keep reducing one half of the range and hand the other half to the partner,
+    // the ranges of every level are kept for the AllGather.
+    size_t lo = 0;
+    size_t hi = count;
+    std::vector<std::pair<size_t, size_t>> ranges;
+    for (size_t mask = pow2 >> 1; mask > 0; mask >>= 1) {
+      uint32_t partner = UnfoldedRank(index ^ mask, pow2);
+      size_t mid = lo + (hi - lo) / 2;
+      bool keep_lower = (index & mask) == 0;
+      size_t keep_lo = keep_lower ? lo : mid;
+      size_t keep_hi = keep_lower ? mid : hi;
+      size_t send_lo = keep_lower ? mid : lo;
+      size_t send_hi = keep_lower ? hi : mid;
+      if (!Exchange(partner, data + send_lo, send_hi - send_lo, partner, data + keep_lo, keep_hi - keep_lo, true)) {
+        MS_LOG(ERROR) << "Rabenseifner ReduceScatter failed with rank " << partner;
+        return false;
+      }
+      ranges.emplace_back(lo, hi);
+      lo = keep_lo;
+      hi = keep_hi;
+    }
+    // AllGather by recursive doubling: the partner holds the other half of the range of the level.
+    for (size_t mask = 1; mask < pow2; mask <<= 1) {
+      uint32_t partner = UnfoldedRank(index ^ mask, pow2);
+      auto [parent_lo, parent_hi] = ranges.back();
+      ranges.pop_back();
+      size_t other_lo = lo == parent_lo ? hi : parent_lo;
+      size_t other_hi = lo == parent_lo ? parent_hi : lo;
+      if (!Exchange(partner, data + lo, hi - lo, partner, data + other_lo, other_hi - other_lo, false)) {
+        MS_LOG(ERROR) << "Rabenseifner AllGather failed with rank " << partner;
+        return false;
+      }
+      lo = parent_lo;
+      hi = parent_hi;
+    }
+  }
+  return FoldOut(data, count, pow2);
+}
+
+template <typename T>
+bool CollectiveAlgorithms<T>::TreeBroadcast(T *data, size_t count, size_t root_index) {
+  MS_EXCEPTION_IF_NULL(data);
+  size_t rank_size = ranks_.size();
+  if (rank_size <= 1 || count == 0) {
+    return true;
+  }
+  // The index relative to the root, the rank receives from the one which differs in its lowest set bit.
+  size_t relative = (index_ + rank_size - root_index) % rank_size;
+  size_t mask = 1;
+  while (mask < rank_size) {
+    if ((relative & mask) != 0) {
+      if (!Recv(ranks_[(relative - mask + root_index) % rank_size], data, count, false)) {
+        return false;
+      }
+      break;
+    }
+    mask <<= 1;
+  }
+  // Then it sends to the ones which differ in the lower bits.
+  std::vector<uint32_t> children;
+  for (mask >>= 1; mask > 0; mask >>= 1) {
+    if (relative + mask < rank_size) {
+      uint32_t child = ranks_[(relative + mask + root_index) % rank_size];
+      if (!channel_->SendAsync(child, data, count * sizeof(T))) {
+        MS_LOG(ERROR) << "Failed to send data to rank: " << child;
+        return false;
+      }
+      children.push_back(child);
+    }
+  }
+  for (auto child : children) {
+    if (!channel_->WaitForSend(child)) {
+      MS_LOG(ERROR) << "Failed to wait for sending data to rank: " << child;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool CollectiveAlgorithms<T>::TreeAllGather(T *output, size_t count) {
+  MS_EXCEPTION_IF_NULL(output);
+  size_t rank_size = ranks_.size();
+  if (rank_size <= 1 || count == 0) {
+    return true;
+  }
+  // Binomial gather to the first rank, every rank collects the blocks of its subtree, which are contiguous.
+  for (size_t mask = 1; mask < rank_size; mask <<= 1) {
+    if ((index_ & mask) != 0) {
+      size_t blocks = std::min(mask, rank_size - index_);
+      if (!Send(ranks_[index_ - mask], output + index_ * count, blocks * count)) {
+        return false;
+      }
+      break;
+    }
+    if (index_ + mask < rank_size) {
+      size_t blocks = std::min(mask, rank_size - index_ - mask);
+      if (!Recv(ranks_[index_ + mask], output + (index_ + mask) * count, blocks * count, false)) {
+        return false;
+      }
+    }
+  }
+  return TreeBroadcast(output, count * rank_size, 0);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_COLLECTIVE_ALGORITHMS_H_
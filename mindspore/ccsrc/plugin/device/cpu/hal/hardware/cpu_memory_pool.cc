@@ -24,6 +24,13 @@ namespace cpu {
 namespace {
 const char kMemAvailable[] = "MemAvailable";
 }
+
+CPUMemoryPool::CPUMemoryPool() {
+  // The kernels of the actors alloc and free lots of small tensors concurrently, which are served by the thread caches
+  // unless disabled by MS_ALLOC_CONF=thread_cache:False.
+  SetEnableThreadCache(!common::IsDisableAlllocConfig(common::kAllocThreadCache));
+}
+
 size_t CPUMemoryPool::AllocDeviceMem(size_t alloc_size, DeviceMemPtr *addr) {
   if (alloc_size == 0) {
     MS_LOG(EXCEPTION) << "The memory alloc size is 0.";
@@ -40,7 +40,7 @@ class BACKEND_EXPORT CPUMemoryPool : public DynamicMemPoolBestFit {
   std::string GetMemoryPoolType() const override { return "CPU"; }
 
  private:
-  CPUMemoryPool() = default;
+  CPUMemoryPool();
   DISABLE_COPY_AND_ASSIGN(CPUMemoryPool);
 
   size_t total_used_memory_{0};
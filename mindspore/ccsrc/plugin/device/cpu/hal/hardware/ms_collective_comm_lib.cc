@@ -16,6 +16,7 @@
 
 #include "plugin/device/cpu/hal/hardware/ms_collective_comm_lib.h"
 #include "utils/ms_context.h"
+#include "abstract/utils.h"
 #include "include/backend/distributed/constants.h"
 #include "include/backend/distributed/recovery/recovery_context.h"
 #include "runtime/collective/collective_communication_lib.h"
@@ -35,6 +36,24 @@ using distributed::recovery::RecoveryContext;
 constexpr char kGroupInfoPrefix[] = "group_info_";
 constexpr char kGroupName[] = "group_name";
 constexpr char kUniqueId[] = "unique_id";
+
+namespace {
+// The data types AllGather supports, no matter it gathers through the shared memory or the sockets.
+bool IsAllGatherSupported(TypeId data_type) {
+  switch (data_type) {
+    case TypeId::kNumberTypeInt8:
+    case TypeId::kNumberTypeInt32:
+    case TypeId::kNumberTypeInt:
+    case TypeId::kNumberTypeUInt64:
+    case TypeId::kNumberTypeFloat32:
+    case TypeId::kNumberTypeFloat:
+      return true;
+    default:
+      return false;
+  }
+}
+}  // namespace
+
 MsCollectiveCommLib::MsCollectiveCommLib() {
   // Generate the global group name with node role.
   global_group_name_ = kMCCLGlobalGroupName;
@@ -264,7 +283,15 @@ bool MsCollectiveCommLib::AllGather(const void *send_buff, void *recv_buff, size
   CHECK_IF_NULL(send_buff);
   CHECK_IF_NULL(recv_buff);
   CHECK_IF_NULL(node_);
+  if (!IsAllGatherSupported(data_type)) {
+    MS_LOG(ERROR) << "AllGather does not support the data type: " << TypeIdLabel(data_type);
+    return false;
+  }
 
+  // All the ranks are on this host, gather through the shared memory instead of the sockets.
+  if (launcher_ != nullptr && launcher_->IsShmAllGatherAvailable()) {
+    return launcher_->ShmAllGather(send_buff, recv_buff, send_count * abstract::TypeIdSize(data_type));
+  }
   switch (data_type) {
     case TypeId::kNumberTypeInt8:
       return CollectiveOpsImpl::GetInstance().AllGather<char>(send_buff, recv_buff, send_count, node_);
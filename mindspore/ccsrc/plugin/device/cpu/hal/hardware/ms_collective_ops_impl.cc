@@ -20,6 +20,7 @@
 #include "utils/ms_context.h"
 #include "actor/msg.h"
 #include "plugin/device/cpu/hal/hardware/ms_collective_topo.h"
+#include "plugin/device/cpu/hal/hardware/collective_algorithms.h"
 #include "utils/convert_utils_base.h"
 #include "utils/log_adapter.h"
 
@@ -31,6 +32,50 @@ const char kCollectivePhaseRing[] = "ring";
 const char kCollectivePhaseGather[] = "gather";
 const char kCollectivePhaseReduce[] = "reduce";
 const char kCollectivePhaseBroadcast[] = "broadcast";
+
+uint32_t GetCommTimeout() {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // If enable recovery, set timeout 300s to prevent networking flapping.
+  return context_ptr->get_param<bool>(MS_CTX_ENABLE_RECOVERY) ? kCollectiveCommMaxTimeout : kCollectiveCommTimeout;
+}
+
+// The channel over the tcp connections of the topology node.
+class TopologyChannel : public CollectiveChannel {
+ public:
+  explicit TopologyChannel(const std::shared_ptr<TopologyNode> &topo_node)
+      : topo_node_(topo_node), timeout_(GetCommTimeout()) {
+    MS_EXCEPTION_IF_NULL(topo_node_);
+  }
+  ~TopologyChannel() override = default;
+
+  bool SendAsync(uint32_t rank, const void *data, size_t size) override {
+    return topo_node_->SendAsync(rank, data, size);
+  }
+
+  bool WaitForSend(uint32_t rank) override { return topo_node_->WaitForSend(rank); }
+
+  bool Receive(uint32_t rank, const std::function<bool(const void *, size_t)> &consumer) override {
+    MessageBase *message = nullptr;
+    if (!topo_node_->Receive(rank, &message, timeout_)) {
+      return false;
+    }
+    MS_EXCEPTION_IF_NULL(message);
+    bool ret = consumer(message->body.data(), message->body.length());
+    delete message;
+    return ret;
+  }
+
+ private:
+  std::shared_ptr<TopologyNode> topo_node_;
+  uint32_t timeout_;
+};
+
+std::vector<uint32_t> AllRanks(uint32_t rank_size) {
+  std::vector<uint32_t> ranks(rank_size);
+  std::iota(ranks.begin(), ranks.end(), 0);
+  return ranks;
+}
 }  // namespace
 
 bool MSCollectiveOpsImpl::Initialize() {
@@ -77,11 +122,7 @@ template <typename T>
 bool MSCollectiveOpsImpl::RingAllGatherImpl(uint32_t send_to_rank, uint32_t recv_from_rank, T *output_buff,
                                             const std::vector<size_t> &chunk_offset,
                                             const std::vector<size_t> &chunk_sizes) {
-  auto context_ptr = MsContext::GetInstance();
-  MS_EXCEPTION_IF_NULL(context_ptr);
-  // If enable recovery, set timeout 300s to prevent networking flapping.
-  uint32_t timeout =
-    context_ptr->get_param<bool>(MS_CTX_ENABLE_RECOVERY) ? kCollectiveCommMaxTimeout : kCollectiveCommTimeout;
+  uint32_t timeout = GetCommTimeout();
 
   MS_EXCEPTION_IF_NULL(topo_node_);
   for (size_t i = 0; i < rank_size_ - 1; i++) {
@@ -150,40 +191,65 @@ bool MSCollectiveOpsImpl::Broadcast(const void *sendbuff, void *recvbuff, size_t
     MS_LOG(ERROR) << "The group is empty.";
     return false;
   }
-  uint32_t group_rank_size = SizeToUint(group_info.group_ranks.size());
+  std::vector<uint32_t> ranks;
+  for (uint32_t i = 0; i < group_info.group_ranks.size(); i++) {
+    ranks.push_back(group_to_global_ranks[i]);
+  }
   uint32_t global_root_rank = group_to_global_ranks[root];
 
-  // Broadcast data to processes which are not the root.
-  MS_LOG(DEBUG) << "Start broadcast from root to other processes.";
-  if (rank_id_ == global_root_rank) {
-    for (uint32_t i = 1; i < group_rank_size; i++) {
-      uint32_t dst_rank = group_to_global_ranks[i];
-      MS_LOG(DEBUG) << "Broadcast data to process " << dst_rank;
-
-      if (!topo_node_->SendAsync(dst_rank, const_cast<void *>(sendbuff), count * sizeof(T)) ||
-          !topo_node_->WaitForSend(dst_rank)) {
-        MS_LOG(ERROR) << "Failed to send data to rank: " << dst_rank;
-        return false;
-      }
-    }
-  } else {
-    MS_LOG(DEBUG) << "Broadcast receive from rank 0.";
-
-    MessageBase *message = nullptr;
-    if (!topo_node_->Receive(global_root_rank, &message)) {
-      MS_LOG(ERROR) << "Failed to receive data from rank " << global_root_rank;
+  // Broadcast data along a binomial tree, every process which has received the data forwards it.
+  MS_LOG(DEBUG) << "Start broadcast from root " << global_root_rank << " to other processes.";
+  if (rank_id_ == global_root_rank && recvbuff != sendbuff) {
+    int ret = memcpy_s(recvbuff, count * sizeof(T), sendbuff, count * sizeof(T));
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                    << ", dest size is " << (count * sizeof(T)) << ", src size is " << (count * sizeof(T));
       return false;
     }
+  }
+  TopologyChannel channel(topo_node_);
+  CollectiveAlgorithms<T> algorithms(&channel, rank_id_, ranks);
+  if (!algorithms.TreeBroadcast(reinterpret_cast<T *>(recvbuff), count, root)) {
+    MS_LOG(ERROR) << "Failed to broadcast from rank " << global_root_rank;
+    return false;
+  }
+  MS_LOG(DEBUG) << "End broadcast.";
+  return true;
+}
 
-    MS_EXCEPTION_IF_NULL(message);
-    int ret = memcpy_s(recvbuff, count * sizeof(T), message->body.data(), message->body.length());
+template <typename T>
+bool MSCollectiveOpsImpl::AllReduce(const std::string &data_name, void *sendbuff, void *recvbuff, size_t count) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+
+  // Initialize collective communication parameters.
+  MS_EXCEPTION_IF_NULL(topo_node_);
+  rank_id_ = SizeToUint(topo_node_->rank_id());
+  rank_size_ = SizeToUint(topo_node_->rank_size());
+  if (rank_size_ == 0) {
+    MS_LOG(ERROR) << "Rank size should not be 0.";
+    return false;
+  }
+  if (recvbuff != sendbuff) {
+    int ret = memcpy_s(recvbuff, count * sizeof(T), sendbuff, count * sizeof(T));
     if (ret != EOK) {
       MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
-                    << ", dest size is " << (count * sizeof(T)) << ", src size is " << message->body.length();
+                    << ", dest size is " << (count * sizeof(T)) << ", src size is " << (count * sizeof(T));
       return false;
     }
   }
-  MS_LOG(DEBUG) << "End broadcast.";
+  if (rank_size_ == 1) {
+    MS_LOG(INFO) << "Rank size is 1. Do nothing.";
+    return true;
+  }
+
+  TopologyChannel channel(topo_node_);
+  CollectiveAlgorithms<T> algorithms(&channel, rank_id_, AllRanks(rank_size_));
+  if (!algorithms.AllReduce(reinterpret_cast<T *>(recvbuff), count)) {
+    MS_LOG(ERROR) << "Failed to AllReduce " << data_name << " of " << count << " elements.";
+    return false;
+  }
   return true;
 }
 
@@ -206,6 +272,18 @@ bool MSCollectiveOpsImpl::AllGather(const void *sendbuff, void *recvbuff, size_t
     return true;
   }
 
+  auto algo = CollectiveAlgoSelector::GetInstance().SelectAllGather(send_count, sizeof(T), rank_size_);
+  if (algo == CollectiveAlgo::kTree) {
+    T *output_buff = reinterpret_cast<T *>(recvbuff);
+    int ret = memcpy_s(output_buff + rank_id_ * send_count, send_count * sizeof(T), sendbuff, send_count * sizeof(T));
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+    TopologyChannel channel(topo_node_);
+    CollectiveAlgorithms<T> algorithms(&channel, rank_id_, AllRanks(rank_size_));
+    return algorithms.TreeAllGather(output_buff, send_count);
+  }
   return RingAllGather<T>(sendbuff, recvbuff, send_count);
 }
 }  // namespace cpu
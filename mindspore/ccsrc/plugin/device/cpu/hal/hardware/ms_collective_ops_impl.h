@@ -49,8 +49,8 @@ struct CommunicationGroupInfo {
 };
 
 // MSCollectiveOpsImpl is the collective communication API of the server.
-// For now, it implements two AllReduce algorithms: RingAllReduce and BroadcastAllReduce. Elastic AllReduce is also
-// supported for the elastic scaling feature of the server.
+// AllReduce picks ring, recursive doubling or Rabenseifner by the message size and the rank size, AllGather picks
+// ring or binomial tree, and Broadcast goes along a binomial tree. See CollectiveAlgoSelector.
 class MSCollectiveOpsImpl {
  public:
   explicit MSCollectiveOpsImpl(const std::shared_ptr<TopologyNode> &topo_node)
@@ -92,6 +92,13 @@ class MSCollectiveOpsImpl {
   std::mutex mtx_;
 };
 
+template bool MSCollectiveOpsImpl::AllReduce<float>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                    size_t count);
+template bool MSCollectiveOpsImpl::AllReduce<uint64_t>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                       size_t count);
+template bool MSCollectiveOpsImpl::AllReduce<int>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                  size_t count);
+
 template bool MSCollectiveOpsImpl::AllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
 template bool MSCollectiveOpsImpl::AllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
 template bool MSCollectiveOpsImpl::AllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
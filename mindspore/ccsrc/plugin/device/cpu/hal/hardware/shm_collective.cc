@@ -0,0 +1,304 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/hal/hardware/shm_collective.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include "plugin/device/cpu/kernel/nnacl/fp32/add_fp32.h"
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+#include "include/securec.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// The number of spins before yielding the cpu in a barrier.
+constexpr size_t kSpinCount = 1024;
+// The chunk of every rank is aligned to the cache line, so the ranks never write to the same line.
+constexpr size_t kChunkAlign = 64 / sizeof(float);
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "The atomics in the shared memory must be lock free.");
+
+bool TimedOut(const std::chrono::steady_clock::time_point &start, int64_t timeout) {
+  return std::chrono::steady_clock::now() - start > std::chrono::seconds(timeout);
+}
+}  // namespace
+
+ShmCollective::~ShmCollective() {
+  if (segment_ != nullptr) {
+    (void)munmap(segment_, segment_size_);
+    segment_ = nullptr;
+  }
+  // The segment is not unlinked yet if some local rank failed to attach.
+  if (local_rank_ == 0 && !name_.empty()) {
+    (void)shm_unlink(name_.c_str());
+  }
+}
+
+bool ShmCollective::Create(std::string *name) {
+  MS_EXCEPTION_IF_NULL(name);
+  if (local_size_ < 2) {
+    MS_LOG(ERROR) << "The shared memory collective needs at least 2 local ranks, but got " << local_size_;
+    return false;
+  }
+  // The name is unique to this process, so a segment left by a killed job is never attached by mistake.
+  name_ = "/ms_collective_" + std::to_string(getpid()) + "_" +
+          std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+  int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Failed to create the shared memory " << name_ << ", errno: " << errno;
+    name_.clear();
+    return false;
+  }
+  segment_size_ = kHeaderSize + (local_size_ + 1) * kSlotSize;
+  // The segment is filled with zero, which is the initial value of all the atomics in the header.
+  if (ftruncate(fd, SizeToLong(segment_size_)) != 0) {
+    MS_LOG(ERROR) << "Failed to resize the shared memory " << name_ << " to " << segment_size_
+                  << " bytes, errno: " << errno;
+    (void)close(fd);
+    return false;
+  }
+  if (!Map(fd)) {
+    return false;
+  }
+  *name = name_;
+  MS_LOG(INFO) << "Created the shared memory " << name_ << " of " << segment_size_ << " bytes for " << local_size_
+               << " local ranks.";
+  return true;
+}
+
+bool ShmCollective::Attach(const std::string &name) {
+  if (local_size_ < 2 || local_rank_ == 0) {
+    MS_LOG(ERROR) << "Invalid local rank " << local_rank_ << " of " << local_size_ << " to attach the shared memory.";
+    return false;
+  }
+  int fd = shm_open(name.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Failed to open the shared memory " << name << ", errno: " << errno;
+    return false;
+  }
+  segment_size_ = kHeaderSize + (local_size_ + 1) * kSlotSize;
+  struct stat st = {};
+  if (fstat(fd, &st) != 0 || LongToSize(st.st_size) != segment_size_) {
+    MS_LOG(ERROR) << "The size of the shared memory " << name << " is " << st.st_size << ", but expected "
+                  << segment_size_;
+    (void)close(fd);
+    return false;
+  }
+  if (!Map(fd)) {
+    return false;
+  }
+  (void)header_->attached.fetch_add(1, std::memory_order_acq_rel);
+  return true;
+}
+
+bool ShmCollective::Map(int fd) {
+  segment_ = mmap(nullptr, segment_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (segment_ == MAP_FAILED) {
+    MS_LOG(ERROR) << "Failed to map the shared memory of " << segment_size_ << " bytes, errno: " << errno;
+    segment_ = nullptr;
+    return false;
+  }
+  header_ = reinterpret_cast<ShmHeader *>(segment_);
+  slots_ = reinterpret_cast<unsigned char *>(segment_) + kHeaderSize;
+  return true;
+}
+
+bool ShmCollective::WaitForAttached() {
+  MS_EXCEPTION_IF_NULL(header_);
+  auto start = std::chrono::steady_clock::now();
+  bool success = true;
+  while (header_->attached.load(std::memory_order_acquire) != local_size_ - 1) {
+    if (TimedOut(start, timeout_)) {
+      MS_LOG(WARNING) << "Only " << header_->attached.load() << " of " << (local_size_ - 1)
+                      << " local ranks attached the shared memory " << name_ << " in " << timeout_ << "s.";
+      success = false;
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  (void)shm_unlink(name_.c_str());
+  name_.clear();
+  header_->state.store(static_cast<uint32_t>(success ? ShmState::kReady : ShmState::kFailed),
+                       std::memory_order_release);
+  return success;
+}
+
+bool ShmCollective::WaitForReady() {
+  MS_EXCEPTION_IF_NULL(header_);
+  auto start = std::chrono::steady_clock::now();
+  uint32_t state = static_cast<uint32_t>(ShmState::kPending);
+  // The leader waits for the attaching for at most timeout_, wait longer than that.
+  while ((state = header_->state.load(std::memory_order_acquire)) == static_cast<uint32_t>(ShmState::kPending)) {
+    if (TimedOut(start, timeout_ * 2)) {
+      MS_LOG(WARNING) << "Timed out waiting for the local leader to get the shared memory ready.";
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return state == static_cast<uint32_t>(ShmState::kReady);
+}
+
+bool ShmCollective::Barrier() {
+  MS_EXCEPTION_IF_NULL(header_);
+  uint32_t generation = header_->generation.load(std::memory_order_acquire);
+  if (header_->arrived.fetch_add(1, std::memory_order_acq_rel) == local_size_ - 1) {
+    // The last one resets the counter before releasing the others, so the barrier can be entered again at once.
+    header_->arrived.store(0, std::memory_order_relaxed);
+    (void)header_->generation.fetch_add(1, std::memory_order_release);
+    return true;
+  }
+  auto start = std::chrono::steady_clock::now();
+  size_t spin = 0;
+  while (header_->generation.load(std::memory_order_acquire) == generation) {
+    if (++spin < kSpinCount) {
+      continue;
+    }
+    spin = 0;
+    if (TimedOut(start, timeout_)) {
+      MS_LOG(ERROR) << "Timed out waiting for the local ranks at the barrier of the shared memory, local rank "
+                    << local_rank_ << " of " << local_size_;
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+bool ShmCollective::AllReduce(const float *input, float *output, size_t data_num) {
+  return ReduceStep(input, output, data_num, true);
+}
+
+bool ShmCollective::Reduce(const float *input, float *output, size_t data_num) {
+  return ReduceStep(input, output, data_num, false);
+}
+
+bool ShmCollective::ReduceStep(const float *input, float *output, size_t data_num, bool all) {
+  MS_EXCEPTION_IF_NULL(input);
+  MS_EXCEPTION_IF_NULL(output);
+  MS_EXCEPTION_IF_NULL(header_);
+  const size_t piece_num = kSlotSize / sizeof(float);
+  auto *result = reinterpret_cast<float *>(Slot(local_size_));
+  for (size_t offset = 0; offset < data_num; offset += piece_num) {
+    size_t num = std::min(piece_num, data_num - offset);
+    auto ret = memcpy_s(Slot(local_rank_), kSlotSize, input + offset, num * sizeof(float));
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Failed to copy the data to the shared memory, errorno(" << ret << ")";
+      return false;
+    }
+    if (!Barrier()) {
+      return false;
+    }
+    // Every rank sums up its own chunk of the piece over all the slots.
+    size_t chunk = ((num + local_size_ - 1) / local_size_ + kChunkAlign - 1) / kChunkAlign * kChunkAlign;
+    size_t start = std::min(num, local_rank_ * chunk);
+    size_t end = std::min(num, start + chunk);
+    if (end > start) {
+      int size = SizeToInt(end - start);
+      (void)ElementAdd(reinterpret_cast<const float *>(Slot(0)) + start,
+                       reinterpret_cast<const float *>(Slot(1)) + start, result + start, size);
+      for (size_t i = 2; i < local_size_; ++i) {
+        (void)ElementAdd(result + start, reinterpret_cast<const float *>(Slot(i)) + start, result + start, size);
+      }
+    }
+    // The result area is not written again until all the ranks arrive at the first barrier of the next piece, which
+    // is after they have copied this piece out.
+    if (!Barrier()) {
+      return false;
+    }
+    if (all || local_rank_ == 0) {
+      ret = memcpy_s(output + offset, (data_num - offset) * sizeof(float), result, num * sizeof(float));
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "Failed to copy the result from the shared memory, errorno(" << ret << ")";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool ShmCollective::Broadcast(void *data, size_t data_size) {
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(header_);
+  auto *buff = reinterpret_cast<unsigned char *>(data);
+  for (size_t offset = 0; offset < data_size; offset += kSlotSize) {
+    size_t size = std::min(kSlotSize, data_size - offset);
+    if (local_rank_ == 0) {
+      auto ret = memcpy_s(Slot(0), kSlotSize, buff + offset, size);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "Failed to copy the data to the shared memory, errorno(" << ret << ")";
+        return false;
+      }
+    }
+    if (!Barrier()) {
+      return false;
+    }
+    if (local_rank_ != 0) {
+      auto ret = memcpy_s(buff + offset, data_size - offset, Slot(0), size);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "Failed to copy the data from the shared memory, errorno(" << ret << ")";
+        return false;
+      }
+    }
+    // The slot of the leader is not written again until all the ranks have copied this piece out.
+    if (!Barrier()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ShmCollective::AllGather(const void *input, void *output, size_t data_size) {
+  MS_EXCEPTION_IF_NULL(input);
+  MS_EXCEPTION_IF_NULL(output);
+  MS_EXCEPTION_IF_NULL(header_);
+  const auto *in_buff = reinterpret_cast<const unsigned char *>(input);
+  auto *out_buff = reinterpret_cast<unsigned char *>(output);
+  const size_t out_size = data_size * local_size_;
+  for (size_t offset = 0; offset < data_size; offset += kSlotSize) {
+    size_t size = std::min(kSlotSize, data_size - offset);
+    auto ret = memcpy_s(Slot(local_rank_), kSlotSize, in_buff + offset, size);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Failed to copy the data to the shared memory, errorno(" << ret << ")";
+      return false;
+    }
+    if (!Barrier()) {
+      return false;
+    }
+    for (size_t i = 0; i < local_size_; ++i) {
+      size_t out_offset = i * data_size + offset;
+      ret = memcpy_s(out_buff + out_offset, out_size - out_offset, Slot(i), size);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "Failed to copy the data from the shared memory, errorno(" << ret << ")";
+        return false;
+      }
+    }
+    if (!Barrier()) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
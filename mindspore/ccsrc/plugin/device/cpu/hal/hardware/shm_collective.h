@@ -0,0 +1,104 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_SHM_COLLECTIVE_H_
+#define MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_SHM_COLLECTIVE_H_
+
+#include <atomic>
+#include <string>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The state of the shared memory segment, which is set by the local leader once all the local ranks have attached.
+enum class ShmState : uint32_t { kPending = 0, kReady, kFailed };
+
+// The header at the beginning of the shared memory segment.
+struct ShmHeader {
+  std::atomic<uint32_t> state;
+  // The number of local ranks which have attached the segment except the leader.
+  std::atomic<uint32_t> attached;
+  // The number of local ranks which have arrived at the current barrier.
+  std::atomic<uint32_t> arrived;
+  // Increased every time all the local ranks have arrived, so the barrier can be reused.
+  std::atomic<uint32_t> generation;
+};
+
+// ShmCollective implements the collectives among the ranks on the same host through a POSIX shared memory segment, so
+// the data never goes through the sockets.
+// The segment holds a slot for every local rank and a result area. A large input is processed piece by piece, each
+// piece goes through: every rank copies its piece into its slot, and after a barrier every rank sums up 1/local_size
+// of the piece over all the slots into the result area, so the reduction is done by all the ranks in parallel.
+// The segment is created by the local leader, whose name is published through the meta server node. It is unlinked as
+// soon as all the local ranks have attached, so nothing is left in /dev/shm even if the processes are killed.
+class ShmCollective {
+ public:
+  // The timeout is in seconds, for the local ranks to attach and to arrive at a barrier.
+  ShmCollective(size_t local_rank, size_t local_size, int64_t timeout = kDefaultTimeout)
+      : local_rank_(local_rank), local_size_(local_size), timeout_(timeout) {}
+  ~ShmCollective();
+
+  // Create the segment on the local leader, whose name should be published to the other local ranks by the caller.
+  bool Create(std::string *name);
+  // Attach the segment created by the local leader.
+  bool Attach(const std::string &name);
+  // Wait until all the local ranks have attached and unlink the segment. Only called on the local leader, the result
+  // is published to the other local ranks through the state of the segment.
+  bool WaitForAttached();
+  // Wait for the local leader to tell whether all the local ranks have attached.
+  bool WaitForReady();
+
+  // Sum up the float data of all the local ranks, the result is written to every rank.
+  bool AllReduce(const float *input, float *output, size_t data_num);
+  // Sum up the float data of all the local ranks, the result is written to the local leader only.
+  bool Reduce(const float *input, float *output, size_t data_num);
+  // Copy the data of the local leader to all the local ranks.
+  bool Broadcast(void *data, size_t data_size);
+  // Gather the data of all the local ranks in the order of the local rank.
+  bool AllGather(const void *input, void *output, size_t data_size);
+  // Wait until all the local ranks have arrived, return false if some rank does not arrive in time.
+  bool Barrier();
+
+  size_t local_rank() const { return local_rank_; }
+  size_t local_size() const { return local_size_; }
+
+ private:
+  bool Map(int fd);
+  bool ReduceStep(const float *input, float *output, size_t data_num, bool all);
+  // The slot of the local rank, or the result area if index is local_size_.
+  unsigned char *Slot(size_t index) const { return slots_ + index * kSlotSize; }
+
+  // The size of every slot, which bounds the size of a piece.
+  static constexpr size_t kSlotSize = 4 << 20;
+  // The slots start at a cache line of their own.
+  static constexpr size_t kHeaderSize = 64;
+  // The same as the timeout of the sockets.
+  static constexpr int64_t kDefaultTimeout = 30;
+
+  size_t local_rank_;
+  size_t local_size_;
+  int64_t timeout_;
+  std::string name_;
+  size_t segment_size_{0};
+  void *segment_{nullptr};
+  ShmHeader *header_{nullptr};
+  unsigned char *slots_{nullptr};
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_SHM_COLLECTIVE_H_
@@ -32,6 +32,7 @@
 #include "plugin/device/cpu/kernel/nnacl/fp32/power_fp32.h"
 #include "plugin/device/cpu/kernel/nnacl/fp32/sub_fp32.h"
 #include "plugin/device/cpu/kernel/nnacl/fp32/add_fp32.h"
+#include "plugin/device/cpu/kernel/nnacl/bf16/arithmetic_bf16.h"
 #include "Eigen/Eigen"
 
 namespace mindspore {
@@ -54,6 +55,10 @@ constexpr auto kFloorMod = "FloorMod";
 constexpr auto kSquaredDifference = "SquaredDifference";
 constexpr auto kAtan2 = "Atan2";
 
+using ElementBf16Func = int (*)(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size);
+using ElementOptBf16Func = int (*)(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size,
+                                   bool first_scalar);
+
 template <typename T>
 void ElementRealDiv(const T *input1, const T *input2, T *out, size_t size, size_t delta_1, size_t delta_2) {
   size_t idx_1 = 0;
@@ -196,6 +201,32 @@ class ArithmeticCpuTypeFunc : public CpuKernelFunc {
     }
     is_init_broadcast_ = true;
   }
+  // the same shape and the scalar cases of bf16 are computed in fp32 by nnacl, it returns false for the broadcast.
+  bool LaunchElementBf16(const T *input1, const T *input2, T *out, ElementBf16Func func, ElementOptBf16Func opt_func) {
+    auto in0 = reinterpret_cast<const uint16_t *>(input1);
+    auto in1 = reinterpret_cast<const uint16_t *>(input2);
+    auto output = reinterpret_cast<uint16_t *>(out);
+    if (input_shape1_ == input_shape2_) {
+      auto task = [in0, in1, output, func](size_t start, size_t end) {
+        (void)func(in0 + start, in1 + start, output + start, SizeToInt(end - start));
+      };
+      ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+      return true;
+    }
+    if (op_para_.in_elements_num0_ == 1 || op_para_.in_elements_num1_ == 1) {
+      bool first_scalar = op_para_.in_elements_num0_ == 1;
+      auto task = [in0, in1, output, opt_func, first_scalar](size_t start, size_t end) {
+        if (first_scalar) {
+          (void)opt_func(in0, in1 + start, output + start, SizeToInt(end - start), true);
+        } else {
+          (void)opt_func(in0 + start, in1, output + start, SizeToInt(end - start), false);
+        }
+      };
+      ParallelLaunchAutoSearch(task, output_size_, this, &parallel_search_info_);
+      return true;
+    }
+    return false;
+  }
   void InitComputeFunc() {
     if (kernel_name_ == kAssignAdd || kernel_name_ == kAssignSub) {
       return;
@@ -299,6 +330,11 @@ void ArithmeticCpuTypeFunc<T>::Add(const T *input1, const T *input2, T *out) {
       return;
     }
   }
+  if constexpr (std::is_same_v<T, bfloat16>) {
+    if (LaunchElementBf16(input1, input2, out, ElementAddBf16, ElementOptAddBf16)) {
+      return;
+    }
+  }
   if (!is_init_broadcast_) {
     InitBroadCast();
   }
@@ -345,6 +381,11 @@ void ArithmeticCpuTypeFunc<T>::Sub(const T *input1, const T *input2, T *out) {
       return;
     }
   }
+  if constexpr (std::is_same_v<T, bfloat16>) {
+    if (LaunchElementBf16(input1, input2, out, ElementSubBf16, ElementOptSubBf16)) {
+      return;
+    }
+  }
   if (!is_init_broadcast_) {
     InitBroadCast();
   }
@@ -378,6 +419,11 @@ void ArithmeticCpuTypeFunc<T>::Mul(const T *input1, const T *input2, T *out) {
       return;
     }
   }
+  if constexpr (std::is_same_v<T, bfloat16>) {
+    if (LaunchElementBf16(input1, input2, out, ElementMulBf16, ElementOptMulBf16)) {
+      return;
+    }
+  }
   if (!is_init_broadcast_) {
     InitBroadCast();
   }
@@ -395,6 +441,11 @@ void ArithmeticCpuTypeFunc<T>::Mul(const T *input1, const T *input2, T *out) {
 
 template <typename T>
 void ArithmeticCpuTypeFunc<T>::RealDiv(const T *input1, const T *input2, T *out) {
+  if constexpr (std::is_same_v<T, bfloat16>) {
+    if (LaunchElementBf16(input1, input2, out, ElementDivBf16, ElementOptDivBf16)) {
+      return;
+    }
+  }
   if (input_shape1_ == input_shape2_) {
     auto task = [&](size_t start, size_t end) {
       ElementRealDiv<T>(input1 + start, input2 + start, out + start, end - start, 1, 1);
@@ -849,6 +900,11 @@ static std::map<std::string, std::vector<std::pair<KernelAttr, ArithmeticCpuFunc
      SpecializeArithFunc<uint16_t>},
     {KernelAttr().AddInputAttr(kNumberTypeFloat16).AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
      SpecializeArithFunc<float16>},
+    {KernelAttr()
+       .AddInputAttr(kNumberTypeBFloat16)
+       .AddInputAttr(kNumberTypeBFloat16)
+       .AddOutputAttr(kNumberTypeBFloat16),
+     SpecializeArithFunc<bfloat16>},
     {KernelAttr()
        .AddInputAttr(kNumberTypeComplex64)
        .AddInputAttr(kNumberTypeComplex64)
@@ -880,6 +936,11 @@ static std::map<std::string, std::vector<std::pair<KernelAttr, ArithmeticCpuFunc
      SpecializeArithFunc<uint64_t>},
     {KernelAttr().AddInputAttr(kNumberTypeFloat16).AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
      SpecializeArithFunc<float16>},
+    {KernelAttr()
+       .AddInputAttr(kNumberTypeBFloat16)
+       .AddInputAttr(kNumberTypeBFloat16)
+       .AddOutputAttr(kNumberTypeBFloat16),
+     SpecializeArithFunc<bfloat16>},
     {KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
      SpecializeArithFunc<float>},
     {KernelAttr().AddInputAttr(kNumberTypeFloat64).AddInputAttr(kNumberTypeFloat64).AddOutputAttr(kNumberTypeFloat64),
@@ -947,6 +1008,11 @@ static std::map<std::string, std::vector<std::pair<KernelAttr, ArithmeticCpuFunc
      SpecializeArithFunc<float>},
     {KernelAttr().AddInputAttr(kNumberTypeFloat64).AddInputAttr(kNumberTypeFloat64).AddOutputAttr(kNumberTypeFloat64),
      SpecializeArithFunc<double>},
+    {KernelAttr()
+       .AddInputAttr(kNumberTypeBFloat16)
+       .AddInputAttr(kNumberTypeBFloat16)
+       .AddOutputAttr(kNumberTypeBFloat16),
+     SpecializeArithFunc<bfloat16>},
     {KernelAttr().AddInputAttr(kNumberTypeInt8).AddInputAttr(kNumberTypeInt8).AddOutputAttr(kNumberTypeInt8),
      SpecializeArithFunc<int8_t>},
     {KernelAttr().AddInputAttr(kNumberTypeInt16).AddInputAttr(kNumberTypeInt16).AddOutputAttr(kNumberTypeInt16),
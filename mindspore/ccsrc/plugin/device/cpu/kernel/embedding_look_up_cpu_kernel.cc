@@ -91,6 +91,7 @@ const std::vector<std::pair<KernelAttr, KernelRunFunc>> &EmbeddingLookUpCpuKerne
     ADD_KERNEL(UInt32, Int32, UInt32, uint32_t, int32_t),
     ADD_KERNEL(UInt64, Int32, UInt64, uint64_t, int32_t),
     ADD_KERNEL(Float16, Int32, Float16, float16, int32_t),
+    ADD_KERNEL(BFloat16, Int32, BFloat16, bfloat16, int32_t),
     ADD_KERNEL(Float32, Int32, Float32, float, int32_t),
     ADD_KERNEL(Float64, Int32, Float64, double, int32_t),
 
@@ -104,6 +105,7 @@ const std::vector<std::pair<KernelAttr, KernelRunFunc>> &EmbeddingLookUpCpuKerne
     ADD_KERNEL(UInt32, Int64, UInt32, uint32_t, int64_t),
     ADD_KERNEL(UInt64, Int64, UInt64, uint64_t, int64_t),
     ADD_KERNEL(Float16, Int64, Float16, float16, int64_t),
+    ADD_KERNEL(BFloat16, Int64, BFloat16, bfloat16, int64_t),
     ADD_KERNEL(Float32, Int64, Float32, float, int64_t),
     ADD_KERNEL(Float64, Int64, Float64, double, int64_t),
 
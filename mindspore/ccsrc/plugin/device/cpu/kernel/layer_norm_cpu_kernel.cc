@@ -19,6 +19,7 @@
 #include "kernel/common_utils.h"
 #include "plugin/device/cpu/hal/device/cpu_device_address.h"
 #include "include/common/thread_pool.h"
+#include "plugin/device/cpu/kernel/nnacl/bf16/layer_norm_bf16.h"
 
 namespace mindspore {
 namespace kernel {
@@ -119,6 +120,25 @@ void LayerNormCpuKernelMod::LaunchKernel(const std::vector<KernelTensor *> &inpu
   MS_EXCEPTION_IF_NULL(y);
   MS_EXCEPTION_IF_NULL(mean);
   MS_EXCEPTION_IF_NULL(var);
+  // the params of bf16 repeat inside a block in the common case, which nnacl normalizes with the fp32 accumulation.
+  if constexpr (std::is_same_v<T, bfloat16>) {
+    if (param_num_ <= block_size_) {
+      auto task = [this, x, gamma, beta, y, mean, var](size_t start, size_t end) {
+        LayerNormComputeParam param{};
+        param.epsilon_ = eps_;
+        param.norm_inner_size_ = SizeToInt(block_size_);
+        param.norm_outer_size_ = SizeToInt(end - start);
+        param.params_inner_size_ = SizeToInt(param_num_);
+        param.params_outer_size_ = SizeToInt((end - start) * (block_size_ / param_num_));
+        size_t offset = start * block_size_;
+        (void)LayerNormBf16(reinterpret_cast<const uint16_t *>(x + offset), reinterpret_cast<const uint16_t *>(gamma),
+                            reinterpret_cast<const uint16_t *>(beta), reinterpret_cast<uint16_t *>(y + offset),
+                            mean + start, var + start, &param, 0, 1);
+      };
+      ParallelLaunchAutoSearch(task, block_num_, this, &parallel_search_info_);
+      return;
+    }
+  }
   size_t thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
   if (block_num_ < thread_num) {
     thread_num = block_num_;
@@ -175,6 +195,17 @@ std::vector<std::pair<KernelAttr, LayerNormCpuKernelMod::KernelFunc>> LayerNormC
      .AddOutputAttr(kNumberTypeFloat32)
      .AddOutputAttr(kNumberTypeFloat32),
    &LayerNormCpuKernelMod::LaunchKernel<float16>},
+  {KernelAttr()
+     .AddInputAttr(kNumberTypeBFloat16)
+     .AddInputAttr(kNumberTypeBFloat16)
+     .AddInputAttr(kNumberTypeBFloat16)
+     .AddInputAttr(kObjectTypeNumber, kNumberTypeInt64)
+     .AddInputAttr(kObjectTypeNumber, kNumberTypeInt64)
+     .AddInputAttr(kObjectTypeNumber, kNumberTypeFloat32)
+     .AddOutputAttr(kNumberTypeBFloat16)
+     .AddOutputAttr(kNumberTypeFloat32)
+     .AddOutputAttr(kNumberTypeFloat32),
+   &LayerNormCpuKernelMod::LaunchKernel<bfloat16>},
   {KernelAttr()
      .AddInputAttr(kNumberTypeFloat32)
      .AddInputAttr(kNumberTypeFloat32)
@@ -90,7 +90,7 @@ bool MapTensorEraseCpuKernelMod::LaunchKernel(const std::vector<KernelTensor *>
   auto hash_table_value_type = user_data->get<TypeId>(kHashTableValueType);
   TypeId value_type = *hash_table_value_type;
   if (value_type == kNumberTypeFloat32) {
-    auto hash_table_ptr = user_data->get<device::cpu::CPUHashTable<KeyType, float>>(kUserDataData);
+    auto hash_table_ptr = user_data->get<device::HashTable<KeyType, float>>(kUserDataData);
     if (hash_table_ptr == nullptr) {
       MS_LOG(EXCEPTION) << "Failed to get gpu hash table pointer with value type:" << value_type;
     }
@@ -97,7 +97,7 @@ bool MapTensorGetDataCpuKernelMod::LaunchKernel(const std::vector<KernelTensor *
   // The real hash table should be accessed by user data.
   auto user_data = inputs[kIndex0]->user_data();
   MS_EXCEPTION_IF_NULL(user_data);
-  auto hash_table_ptr = user_data->get<CPUHashTable<KeyType, ValueType>>(kUserDataData);
+  auto hash_table_ptr = user_data->get<device::HashTable<KeyType, ValueType>>(kUserDataData);
   MS_EXCEPTION_IF_NULL(hash_table_ptr);
   return hash_table_ptr->GetKeysAndValues(static_cast<KeyType *>(outputs.at(kIndex0)->device_ptr()),
                                           static_cast<ValueType *>(outputs.at(kIndex1)->device_ptr()), nullptr);
@@ -118,7 +118,7 @@ bool MapTensorGetGradCpuKernelMod::LaunchKernel(const std::vector<KernelTensor *
   MS_EXCEPTION_IF_NULL(hash_table_value_type);
   TypeId value_type = *hash_table_value_type;
   if (value_type == kNumberTypeFloat32) {
-    auto hash_table_ptr = user_data->get<CPUHashTable<KeyType, float>>(kUserDataData);
+    auto hash_table_ptr = user_data->get<device::HashTable<KeyType, float>>(kUserDataData);
     MS_EXCEPTION_IF_NULL(hash_table_ptr);
 
     return hash_table_ptr->Insert(reinterpret_cast<KeyType *>(inputs.at(kIndex1)->device_ptr()),
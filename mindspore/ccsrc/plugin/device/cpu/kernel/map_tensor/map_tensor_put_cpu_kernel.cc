@@ -112,7 +112,7 @@ bool MapTensorPutCpuKernelMod::LaunchKernel(const std::vector<KernelTensor *> &i
   // The real hash table should be accessed by user data.
   auto user_data = inputs[kIndex0]->user_data();
   MS_EXCEPTION_IF_NULL(user_data);
-  auto hash_table_ptr = user_data->get<device::cpu::CPUHashTable<KeyType, ValueType>>(kUserDataData);
+  auto hash_table_ptr = user_data->get<device::HashTable<KeyType, ValueType>>(kUserDataData);
   MS_EXCEPTION_IF_NULL(hash_table_ptr);
   return hash_table_ptr->Insert(static_cast<KeyType *>(inputs.at(kIndex1)->device_ptr()),
                                 inputs.at(kIndex1)->size() / sizeof(KeyType),
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "plugin/device/cpu/kernel/matmul_bf16_cpu_kernel_func.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include "mindspore/core/ops/math_op_name.h"
+#include "plugin/device/cpu/kernel/nnacl/bf16/matmul_bf16.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr size_t kMatMulInputsNum = 4;
+constexpr size_t kBatchMatMulExtInputsNum = 2;
+constexpr size_t kMatMulOutputsNum = 1;
+constexpr size_t kMatrixDimNum = 2;
+
+size_t BatchSize(const ShapeVector &shape) {
+  return std::accumulate(shape.begin(), shape.end() - kMatrixDimNum, size_t(1), std::multiplies<size_t>());
+}
+}  // namespace
+
+void MatMulBf16CpuKernelFunc::InitFunc(const PrimitivePtr &primitive, const std::vector<KernelTensor *> &inputs,
+                                       const std::vector<KernelTensor *> &outputs) {
+  kernel_name_ = primitive->name();
+}
+
+int MatMulBf16CpuKernelFunc::Resize(const std::vector<KernelTensor *> &inputs,
+                                    const std::vector<KernelTensor *> &outputs) {
+  if (kernel_name_ == kBatchMatMulExtOpName) {
+    trans_a_ = false;
+    trans_b_ = false;
+  } else {
+    auto transpose_a_opt = inputs[kIndex2]->GetOptionalValueWithCheck<bool>();
+    auto transpose_b_opt = inputs[kIndex3]->GetOptionalValueWithCheck<bool>();
+    if (!transpose_a_opt.has_value() || !transpose_b_opt.has_value()) {
+      MS_LOG(ERROR) << "For '" << kernel_name_ << "', transpose_a and transpose_b should be specified.";
+      return KRET_RESIZE_FAILED;
+    }
+    trans_a_ = transpose_a_opt.value();
+    trans_b_ = transpose_b_opt.value();
+  }
+  const auto &a_shape = inputs[kIndex0]->GetShapeVector();
+  const auto &b_shape = inputs[kIndex1]->GetShapeVector();
+  const auto &out_shape = outputs[kIndex0]->GetShapeVector();
+  if (a_shape.size() < kMatrixDimNum || b_shape.size() < kMatrixDimNum || out_shape.size() < kMatrixDimNum) {
+    MS_LOG(ERROR) << "For '" << kernel_name_ << "', the rank of the inputs and output must be at least "
+                  << kMatrixDimNum;
+    return KRET_RESIZE_FAILED;
+  }
+  auto a_rank = a_shape.size();
+  auto b_rank = b_shape.size();
+  row_ = LongToSize(trans_a_ ? a_shape[a_rank - 1] : a_shape[a_rank - 2]);
+  deep_ = LongToSize(trans_a_ ? a_shape[a_rank - 2] : a_shape[a_rank - 1]);
+  col_ = LongToSize(trans_b_ ? b_shape[b_rank - 2] : b_shape[b_rank - 1]);
+  batch_ = BatchSize(out_shape);
+  a_batch_ = BatchSize(a_shape);
+  b_batch_ = BatchSize(b_shape);
+  // an input is either batched as the output or shared by all the batches, such as the weight of a linear layer.
+  if ((a_batch_ != batch_ && a_batch_ != 1) || (b_batch_ != batch_ && b_batch_ != 1)) {
+    MS_LOG(ERROR) << "For '" << kernel_name_ << "', the bf16 kernel does not support broadcasting the batch of "
+                  << a_shape << " and " << b_shape;
+    return KRET_RESIZE_FAILED;
+  }
+  a_pack_.resize(trans_a_ ? row_ * deep_ : 0);
+  b_pack_.resize(trans_b_ ? 0 : col_ * deep_);
+  return KRET_OK;
+}
+
+void MatMulBf16CpuKernelFunc::ComputeMatMulOutput(const uint16_t *a, const uint16_t *b, uint16_t *c) {
+  int row = SizeToInt(row_);
+  int col = SizeToInt(col_);
+  int deep = SizeToInt(deep_);
+  // the gemv of the decoding is split by the columns, and the tall matrices are split by the rows.
+  if (col_ >= row_) {
+    auto task = [a, b, c, row, col, deep](size_t start, size_t end) {
+      MatMulBf16(a, b + start * IntToSize(deep), c + start, row, SizeToInt(end - start), deep, col);
+    };
+    ParallelLaunchAutoSearch(task, col_, this, &parallel_search_info_);
+  } else {
+    auto task = [a, b, c, col, deep](size_t start, size_t end) {
+      MatMulBf16(a + start * IntToSize(deep), b, c + start * IntToSize(col), SizeToInt(end - start), col, deep, col);
+    };
+    ParallelLaunchAutoSearch(task, row_, this, &parallel_search_info_);
+  }
+}
+
+bool MatMulBf16CpuKernelFunc::RunFunc(const std::vector<KernelTensor *> &inputs,
+                                      const std::vector<KernelTensor *> &,
+                                      const std::vector<KernelTensor *> &outputs) {
+  if (kernel_name_ == kBatchMatMulExtOpName) {
+    CHECK_KERNEL_INPUTS_NUM(inputs.size(), kBatchMatMulExtInputsNum, kernel_name_);
+  } else {
+    CHECK_KERNEL_INPUTS_NUM(inputs.size(), kMatMulInputsNum, kernel_name_);
+  }
+  CHECK_KERNEL_OUTPUTS_NUM(outputs.size(), kMatMulOutputsNum, kernel_name_);
+  auto a = reinterpret_cast<const uint16_t *>(inputs[kIndex0]->device_ptr());
+  auto b = reinterpret_cast<const uint16_t *>(inputs[kIndex1]->device_ptr());
+  auto c = reinterpret_cast<uint16_t *>(outputs[kIndex0]->device_ptr());
+  MS_EXCEPTION_IF_NULL(a);
+  MS_EXCEPTION_IF_NULL(b);
+  MS_EXCEPTION_IF_NULL(c);
+  size_t a_size = row_ * deep_;
+  size_t b_size = col_ * deep_;
+  const uint16_t *b_packed = b;
+  for (size_t i = 0; i < batch_; ++i) {
+    const uint16_t *a_i = a + (a_batch_ == 1 ? 0 : i * a_size);
+    if (trans_a_) {
+      TransposeBf16(a_i, a_pack_.data(), SizeToInt(deep_), SizeToInt(row_));
+      a_i = a_pack_.data();
+    }
+    // the shared weight is packed once for all the batches.
+    if (b_batch_ != 1 || i == 0) {
+      b_packed = b + (b_batch_ == 1 ? 0 : i * b_size);
+      if (!trans_b_) {
+        TransposeBf16(b_packed, b_pack_.data(), SizeToInt(deep_), SizeToInt(col_));
+        b_packed = b_pack_.data();
+      }
+    }
+    ComputeMatMulOutput(a_i, b_packed, c + i * row_ * col_);
+  }
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
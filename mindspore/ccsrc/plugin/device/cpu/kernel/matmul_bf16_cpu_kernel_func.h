@@ -0,0 +1,58 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_MATMUL_BF16_CPU_KERNEL_FUNC_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_MATMUL_BF16_CPU_KERNEL_FUNC_H_
+
+#include <string>
+#include <vector>
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+// bf16 MatMul, BatchMatMul and BatchMatMulExt, which store bf16 and accumulate in fp32.
+class MatMulBf16CpuKernelFunc : public CpuKernelFunc {
+ public:
+  MatMulBf16CpuKernelFunc() = default;
+  ~MatMulBf16CpuKernelFunc() override = default;
+
+  void InitFunc(const PrimitivePtr &primitive, const std::vector<KernelTensor *> &inputs,
+                const std::vector<KernelTensor *> &outputs) override;
+
+  bool RunFunc(const std::vector<KernelTensor *> &inputs, const std::vector<KernelTensor *> &workspace,
+               const std::vector<KernelTensor *> &outputs) override;
+
+  int Resize(const std::vector<KernelTensor *> &inputs, const std::vector<KernelTensor *> &outputs) override;
+
+ private:
+  void ComputeMatMulOutput(const uint16_t *a, const uint16_t *b, uint16_t *c);
+
+  std::string kernel_name_;
+  bool trans_a_{false};
+  bool trans_b_{false};
+  size_t batch_{1};
+  size_t a_batch_{1};
+  size_t b_batch_{1};
+  size_t row_{0};
+  size_t col_{0};
+  size_t deep_{0};
+  // the a is packed to [row][deep] and the b is packed to [col][deep] when they are not in the layout.
+  std::vector<uint16_t> a_pack_;
+  std::vector<uint16_t> b_pack_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_MATMUL_BF16_CPU_KERNEL_FUNC_H_
@@ -16,6 +16,7 @@
 
 #include "plugin/device/cpu/kernel/matmul_cpu_kernel.h"
 #include "plugin/device/cpu/kernel/eigen/matmul_double_cpu_kernel_func.h"
+#include "plugin/device/cpu/kernel/matmul_bf16_cpu_kernel_func.h"
 #include "plugin/device/cpu/kernel/mkldnn/matmul_cpu_kernel_func.h"
 #include <utility>
 #include <algorithm>
@@ -57,6 +58,13 @@ static std::map<std::string, std::vector<std::pair<KernelAttr, MatMulFuncCreator
        .AddInputAttr(kObjectTypeNumber, kNumberTypeBool)
        .AddOutputAttr(kNumberTypeFloat64),
      []() { return std::make_shared<MatmulDoubleCpuKernelFunc>(); }},
+    {KernelAttr()
+       .AddInputAttr(kNumberTypeBFloat16)
+       .AddInputAttr(kNumberTypeBFloat16)
+       .AddInputAttr(kObjectTypeNumber, kNumberTypeBool)
+       .AddInputAttr(kObjectTypeNumber, kNumberTypeBool)
+       .AddOutputAttr(kNumberTypeBFloat16),
+     []() { return std::make_shared<MatMulBf16CpuKernelFunc>(); }},
     {KernelAttr()
        .AddInputAttr(kNumberTypeInt8)
        .AddInputAttr(kNumberTypeInt8)
@@ -139,6 +147,13 @@ static std::map<std::string, std::vector<std::pair<KernelAttr, MatMulFuncCreator
        .AddInputAttr(kObjectTypeNumber, kNumberTypeBool)
        .AddOutputAttr(kNumberTypeFloat64),
      []() { return std::make_shared<MatmulDoubleCpuKernelFunc>(); }},
+    {KernelAttr()
+       .AddInputAttr(kNumberTypeBFloat16)
+       .AddInputAttr(kNumberTypeBFloat16)
+       .AddInputAttr(kObjectTypeNumber, kNumberTypeBool)
+       .AddInputAttr(kObjectTypeNumber, kNumberTypeBool)
+       .AddOutputAttr(kNumberTypeBFloat16),
+     []() { return std::make_shared<MatMulBf16CpuKernelFunc>(); }},
     {KernelAttr()
        .AddInputAttr(kNumberTypeInt8)
        .AddInputAttr(kNumberTypeInt8)
@@ -214,6 +229,11 @@ static std::map<std::string, std::vector<std::pair<KernelAttr, MatMulFuncCreator
      []() { return std::make_shared<MatMulCpuKernelFunc>(); }},
     {KernelAttr().AddInputAttr(kNumberTypeFloat64).AddInputAttr(kNumberTypeFloat64).AddOutputAttr(kNumberTypeFloat64),
      []() { return std::make_shared<MatmulDoubleCpuKernelFunc>(); }},
+    {KernelAttr()
+       .AddInputAttr(kNumberTypeBFloat16)
+       .AddInputAttr(kNumberTypeBFloat16)
+       .AddOutputAttr(kNumberTypeBFloat16),
+     []() { return std::make_shared<MatMulBf16CpuKernelFunc>(); }},
     {KernelAttr().AddInputAttr(kNumberTypeInt8).AddInputAttr(kNumberTypeInt8).AddOutputAttr(kNumberTypeInt8),
      []() { return std::make_shared<MatmulDoubleCpuKernelFunc>(); }},
     {KernelAttr().AddInputAttr(kNumberTypeInt16).AddInputAttr(kNumberTypeInt16).AddOutputAttr(kNumberTypeInt16),
@@ -244,7 +264,7 @@ static std::map<std::string, std::vector<std::pair<KernelAttr, MatMulFuncCreator
 template <typename T>
 void LaunchEmptyTensor(const std::vector<KernelTensor *> &outputs) {
   auto output = reinterpret_cast<T *>(outputs[kIndex0]->device_ptr());
-  output[kIndex0] = 0;
+  output[kIndex0] = static_cast<T>(0);
 }
 
 static std::map<int, LaunchEmptyTensorFunc> empty_tensor_map_ = {
@@ -254,6 +274,7 @@ static std::map<int, LaunchEmptyTensorFunc> empty_tensor_map_ = {
   {kNumberTypeUInt8, LaunchEmptyTensor<uint8_t>},       {kNumberTypeUInt16, LaunchEmptyTensor<uint16_t>},
   {kNumberTypeUInt32, LaunchEmptyTensor<uint32_t>},     {kNumberTypeUInt64, LaunchEmptyTensor<uint64_t>},
   {kNumberTypeComplex64, LaunchEmptyTensor<complex64>}, {kNumberTypeComplex128, LaunchEmptyTensor<complex128>},
+  {kNumberTypeBFloat16, LaunchEmptyTensor<bfloat16>},
 };
 }  // namespace
 
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/bf16/arithmetic_bf16.h"
+#include "nnacl/bf16/cast_bf16.h"
+#include "nnacl/errorcode.h"
+#include "nnacl/fp32/add_fp32.h"
+#include "nnacl/fp32/div_fp32.h"
+#include "nnacl/fp32/mul_fp32.h"
+#include "nnacl/fp32/sub_fp32.h"
+
+typedef int (*ElementFp32Func)(const float *in0, const float *in1, float *out, int size);
+typedef int (*ElementOptFp32Func)(const float *in0, const float *in1, float *out, int size, bool first_scalar);
+
+static int ElementBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size, ElementFp32Func func) {
+  float in0_tile[BF16_TILE];
+  float in1_tile[BF16_TILE];
+  float out_tile[BF16_TILE];
+  for (int i = 0; i < size; i += BF16_TILE) {
+    int num = MSMIN(BF16_TILE, size - i);
+    Bf16ToFloat32(in0 + i, in0_tile, num);
+    Bf16ToFloat32(in1 + i, in1_tile, num);
+    int ret = func(in0_tile, in1_tile, out_tile, num);
+    if (ret != NNACL_OK) {
+      return ret;
+    }
+    Float32ToBf16(out_tile, out + i, num);
+  }
+  return NNACL_OK;
+}
+
+static int ElementOptBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size, bool first_scalar,
+                          ElementOptFp32Func func) {
+  float scalar = Bf16ToFloat32Scalar(first_scalar ? in0[0] : in1[0]);
+  const uint16_t *vector = first_scalar ? in1 : in0;
+  float vector_tile[BF16_TILE];
+  float out_tile[BF16_TILE];
+  for (int i = 0; i < size; i += BF16_TILE) {
+    int num = MSMIN(BF16_TILE, size - i);
+    Bf16ToFloat32(vector + i, vector_tile, num);
+    int ret = first_scalar ? func(&scalar, vector_tile, out_tile, num, true)
+                           : func(vector_tile, &scalar, out_tile, num, false);
+    if (ret != NNACL_OK) {
+      return ret;
+    }
+    Float32ToBf16(out_tile, out + i, num);
+  }
+  return NNACL_OK;
+}
+
+int ElementAddBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size) {
+  return ElementBf16(in0, in1, out, size, ElementAdd);
+}
+
+int ElementOptAddBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size, bool first_scalar) {
+  return ElementOptBf16(in0, in1, out, size, first_scalar, ElementOptAdd);
+}
+
+int ElementSubBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size) {
+  return ElementBf16(in0, in1, out, size, ElementSub);
+}
+
+int ElementOptSubBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size, bool first_scalar) {
+  return ElementOptBf16(in0, in1, out, size, first_scalar, ElementOptSub);
+}
+
+int ElementMulBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size) {
+  return ElementBf16(in0, in1, out, size, ElementMul);
+}
+
+int ElementOptMulBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size, bool first_scalar) {
+  return ElementOptBf16(in0, in1, out, size, first_scalar, ElementOptMul);
+}
+
+int ElementDivBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size) {
+  return ElementBf16(in0, in1, out, size, ElementDiv);
+}
+
+int ElementOptDivBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size, bool first_scalar) {
+  return ElementOptBf16(in0, in1, out, size, first_scalar, ElementOptDiv);
+}
@@ -0,0 +1,37 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NNACL_BF16_ARITHMETIC_BF16_H_
+#define NNACL_BF16_ARITHMETIC_BF16_H_
+
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* the bf16 elements are computed in fp32 and rounded once when they are stored. */
+int ElementAddBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size);
+int ElementOptAddBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size, bool first_scalar);
+int ElementSubBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size);
+int ElementOptSubBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size, bool first_scalar);
+int ElementMulBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size);
+int ElementOptMulBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size, bool first_scalar);
+int ElementDivBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size);
+int ElementOptDivBf16(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size, bool first_scalar);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNACL_BF16_ARITHMETIC_BF16_H_
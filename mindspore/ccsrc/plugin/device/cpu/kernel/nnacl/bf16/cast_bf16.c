@@ -0,0 +1,55 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/bf16/cast_bf16.h"
+#ifdef ENABLE_AVX
+#include <immintrin.h>
+#endif
+
+void Bf16ToFloat32(const uint16_t *input, float *output, int number) {
+  int i = 0;
+#ifdef ENABLE_AVX
+  for (; i <= number - C8NUM; i += C8NUM) {
+    __m256i bits = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(input + i)));
+    _mm256_storeu_ps(output + i, _mm256_castsi256_ps(_mm256_slli_epi32(bits, 16)));
+  }
+#endif
+  for (; i < number; ++i) {
+    output[i] = Bf16ToFloat32Scalar(input[i]);
+  }
+}
+
+void Float32ToBf16(const float *input, uint16_t *output, int number) {
+  int i = 0;
+#ifdef ENABLE_AVX
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i round_bias = _mm256_set1_epi32(0x7FFF);
+  const __m256i nan = _mm256_set1_epi32(BF16_QUIET_NAN);
+  for (; i <= number - C8NUM; i += C8NUM) {
+    __m256 src = _mm256_loadu_ps(input + i);
+    __m256i bits = _mm256_castps_si256(src);
+    __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+    __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(bits, round_bias), lsb), 16);
+    __m256i is_nan = _mm256_castps_si256(_mm256_cmp_ps(src, src, _CMP_UNORD_Q));
+    rounded = _mm256_blendv_epi8(rounded, nan, is_nan);
+    // the pack works in the 128-bit lanes, the permutation gathers the low halves of both lanes.
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(rounded, rounded), 0xD8);
+    _mm_storeu_si128((__m128i *)(output + i), _mm256_castsi256_si128(packed));
+  }
+#endif
+  for (; i < number; ++i) {
+    output[i] = Float32ToBf16Scalar(input[i]);
+  }
+}
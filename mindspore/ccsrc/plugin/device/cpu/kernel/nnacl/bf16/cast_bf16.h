@@ -0,0 +1,53 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NNACL_BF16_CAST_BF16_H_
+#define NNACL_BF16_CAST_BF16_H_
+
+#include <string.h>
+#include "nnacl/op_base.h"
+
+/* the bf16 kernels convert the data to fp32 by tiles of BF16_TILE elements on the stack. */
+#define BF16_TILE 256
+#define BF16_QUIET_NAN 0x7FC0
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* a bf16 is the high half of a fp32. */
+static inline float Bf16ToFloat32Scalar(uint16_t src) {
+  uint32_t bits = (uint32_t)src << 16;
+  float dst;
+  memcpy(&dst, &bits, sizeof(float));
+  return dst;
+}
+
+/* rounds to the nearest even, the same as mindspore::BFloat16. */
+static inline uint16_t Float32ToBf16Scalar(float src) {
+  if (src != src) {
+    return BF16_QUIET_NAN;
+  }
+  uint32_t bits;
+  memcpy(&bits, &src, sizeof(float));
+  return (uint16_t)((bits + ((bits >> 16) & 1) + 0x7FFF) >> 16);
+}
+
+void Bf16ToFloat32(const uint16_t *input, float *output, int number);
+void Float32ToBf16(const float *input, uint16_t *output, int number);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNACL_BF16_CAST_BF16_H_
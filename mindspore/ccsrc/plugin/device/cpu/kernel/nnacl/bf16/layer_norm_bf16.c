@@ -0,0 +1,102 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/bf16/layer_norm_bf16.h"
+#include <math.h>
+#include "nnacl/bf16/cast_bf16.h"
+#include "nnacl/errorcode.h"
+
+static int LayerNormMeanAndSquareBf16(const uint16_t *src, int num, float *mean, float *variance) {
+  if (num <= 0) {
+    return NNACL_ERR;
+  }
+  float tile[BF16_TILE];
+  float sum = 0.0f;
+  float square_sum = 0.0f;
+  for (int i = 0; i < num; i += BF16_TILE) {
+    int tile_num = MSMIN(BF16_TILE, num - i);
+    Bf16ToFloat32(src + i, tile, tile_num);
+    for (int j = 0; j < tile_num; ++j) {
+      sum += tile[j];
+      square_sum += tile[j] * tile[j];
+    }
+  }
+  *mean = sum / (float)num;
+  // the rounding of E(x^2) - E(x)^2 may go below zero for a constant src.
+  *variance = MSMAX(0.0f, square_sum / (float)num - (*mean) * (*mean));
+  return NNACL_OK;
+}
+
+static void LayerNormGammaAndBetaBf16(uint16_t *dst, const uint16_t *src, const uint16_t *gamma_data,
+                                      const uint16_t *beta_data, int num, const float mean, const float deno) {
+  float src_tile[BF16_TILE];
+  float gamma_tile[BF16_TILE];
+  float beta_tile[BF16_TILE];
+  for (int i = 0; i < num; i += BF16_TILE) {
+    int tile_num = MSMIN(BF16_TILE, num - i);
+    Bf16ToFloat32(src + i, src_tile, tile_num);
+    Bf16ToFloat32(gamma_data + i, gamma_tile, tile_num);
+    Bf16ToFloat32(beta_data + i, beta_tile, tile_num);
+    for (int j = 0; j < tile_num; ++j) {
+      src_tile[j] = (src_tile[j] - mean) * deno * gamma_tile[j] + beta_tile[j];
+    }
+    Float32ToBf16(src_tile, dst + i, tile_num);
+  }
+}
+
+int LayerNormBf16(const uint16_t *src_data, const uint16_t *gamma_data, const uint16_t *beta_data, uint16_t *dst_data,
+                  float *out_mean, float *out_variance, const LayerNormComputeParam *param, int task_id,
+                  int thread_num) {
+  if (src_data == NULL || dst_data == NULL || gamma_data == NULL || beta_data == NULL) {
+    return NNACL_NULL_PTR;
+  }
+  NNACL_CHECK_NULL_RETURN_ERR(param);
+  NNACL_CHECK_ZERO_RETURN_ERR(param->params_inner_size_);
+  NNACL_CHECK_ZERO_RETURN_ERR(param->params_outer_size_);
+  NNACL_CHECK_ZERO_RETURN_ERR(thread_num);
+  int step = UP_DIV(param->norm_outer_size_, thread_num);
+  int thread_end = MSMIN((task_id + 1) * step, param->norm_outer_size_);
+  for (int i = task_id * step; i < thread_end; i++) {
+    const uint16_t *src_norm = src_data + (size_t)i * param->norm_inner_size_;
+    uint16_t *dst_norm = dst_data + (size_t)i * param->norm_inner_size_;
+    float cur_mean = 0.0f;
+    float cur_variance = 0.0f;
+    int ret = LayerNormMeanAndSquareBf16(src_norm, param->norm_inner_size_, &cur_mean, &cur_variance);
+    if (ret != NNACL_OK) {
+      return NNACL_ERR;
+    }
+    if (out_mean != NULL) {
+      out_mean[i] = cur_mean;
+    }
+    if (out_variance != NULL) {
+      out_variance[i] = cur_variance;
+    }
+    const float deno = 1 / sqrtf(cur_variance + param->epsilon_);
+    if (param->norm_outer_size_ <= param->params_outer_size_) {
+      for (int x = 0; x < param->norm_inner_size_ / param->params_inner_size_; x++) {
+        const uint16_t *src_param = src_norm + x * param->params_inner_size_;
+        uint16_t *dst_param = dst_norm + x * param->params_inner_size_;
+        LayerNormGammaAndBetaBf16(dst_param, src_param, gamma_data, beta_data, param->params_inner_size_, cur_mean,
+                                  deno);
+      }
+    } else {
+      int x = i / param->params_outer_size_;
+      const uint16_t *gamma = gamma_data + x * param->norm_inner_size_;
+      const uint16_t *beta = beta_data + x * param->norm_inner_size_;
+      LayerNormGammaAndBetaBf16(dst_norm, src_norm, gamma, beta, param->norm_inner_size_, cur_mean, deno);
+    }
+  }
+  return NNACL_OK;
+}
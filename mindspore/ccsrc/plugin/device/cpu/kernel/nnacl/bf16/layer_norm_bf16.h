@@ -0,0 +1,33 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NNACL_BF16_LAYER_NORM_BF16_H_
+#define NNACL_BF16_LAYER_NORM_BF16_H_
+
+#include "nnacl/op_base.h"
+#include "nnacl/kernel/layer_norm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* the same as LayerNorm of fp32 but the src, gamma, beta and dst are bf16, the mean and variance stay in fp32. */
+int LayerNormBf16(const uint16_t *src_data, const uint16_t *gamma_data, const uint16_t *beta_data, uint16_t *dst_data,
+                  float *out_mean, float *out_variance, const LayerNormComputeParam *param, int task_id,
+                  int thread_num);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNACL_BF16_LAYER_NORM_BF16_H_
@@ -0,0 +1,60 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX512_BF16
+#include "nnacl/bf16/matmul_bf16.h"
+#include <immintrin.h>
+#include "nnacl/bf16/cast_bf16.h"
+
+static inline __m512bh LoadBf16x32(const uint16_t *src) { return (__m512bh)_mm512_loadu_si512((const void *)src); }
+
+void Bf16DotAvx512Bf16(const uint16_t *a, int a_stride, int rows, const uint16_t *b, int deep, float *dots) {
+  int d = 0;
+  if (rows == 1) {
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    for (; d <= deep - C64NUM; d += C64NUM) {
+      // vdpbf16ps multiplies the pairs of bf16 and accumulates them into the fp32 lanes.
+      acc0 = _mm512_dpbf16_ps(acc0, LoadBf16x32(a + d), LoadBf16x32(b + d));
+      acc1 = _mm512_dpbf16_ps(acc1, LoadBf16x32(a + d + C32NUM), LoadBf16x32(b + d + C32NUM));
+    }
+    float dot = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+    for (; d < deep; ++d) {
+      dot += Bf16ToFloat32Scalar(a[d]) * Bf16ToFloat32Scalar(b[d]);
+    }
+    dots[0] = dot;
+    return;
+  }
+  const uint16_t *a_rows[BF16_MATMUL_ROW_TILE];
+  SET_TILE_ROW_PTRS(a, a_stride, rows, BF16_MATMUL_ROW_TILE, a_rows);
+  __m512 acc[BF16_MATMUL_ROW_TILE];
+  for (int r = 0; r < BF16_MATMUL_ROW_TILE; ++r) {
+    acc[r] = _mm512_setzero_ps();
+  }
+  for (; d <= deep - C32NUM; d += C32NUM) {
+    __m512bh weight = LoadBf16x32(b + d);
+    for (int r = 0; r < BF16_MATMUL_ROW_TILE; ++r) {
+      acc[r] = _mm512_dpbf16_ps(acc[r], LoadBf16x32(a_rows[r] + d), weight);
+    }
+  }
+  for (int r = 0; r < rows; ++r) {
+    float dot = _mm512_reduce_add_ps(acc[r]);
+    for (int k = d; k < deep; ++k) {
+      dot += Bf16ToFloat32Scalar(a_rows[r][k]) * Bf16ToFloat32Scalar(b[k]);
+    }
+    dots[r] = dot;
+  }
+}
+#endif
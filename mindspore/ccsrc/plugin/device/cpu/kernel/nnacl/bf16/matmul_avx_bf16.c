@@ -0,0 +1,64 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX
+#include "nnacl/bf16/matmul_bf16.h"
+#include <immintrin.h>
+#include "nnacl/intrinsics/ms_simd_avx_instructions.h"
+#include "nnacl/bf16/cast_bf16.h"
+
+// there is no bf16 arithmetic in avx2, a bf16 is widened to fp32 by shifting it to the high half.
+static inline __m256 LoadBf16x8(const uint16_t *src) {
+  __m256i bits = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)src));
+  return _mm256_castsi256_ps(_mm256_slli_epi32(bits, 16));
+}
+
+void Bf16DotAvx(const uint16_t *a, int a_stride, int rows, const uint16_t *b, int deep, float *dots) {
+  int d = 0;
+  if (rows == 1) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    for (; d <= deep - C16NUM; d += C16NUM) {
+      acc0 = _mm256_fmadd_ps(LoadBf16x8(a + d), LoadBf16x8(b + d), acc0);
+      acc1 = _mm256_fmadd_ps(LoadBf16x8(a + d + C8NUM), LoadBf16x8(b + d + C8NUM), acc1);
+    }
+    float dot = MS_GET_SUM256_F32(_mm256_add_ps(acc0, acc1));
+    for (; d < deep; ++d) {
+      dot += Bf16ToFloat32Scalar(a[d]) * Bf16ToFloat32Scalar(b[d]);
+    }
+    dots[0] = dot;
+    return;
+  }
+  const uint16_t *a_rows[BF16_MATMUL_ROW_TILE];
+  SET_TILE_ROW_PTRS(a, a_stride, rows, BF16_MATMUL_ROW_TILE, a_rows);
+  __m256 acc[BF16_MATMUL_ROW_TILE];
+  for (int r = 0; r < BF16_MATMUL_ROW_TILE; ++r) {
+    acc[r] = _mm256_setzero_ps();
+  }
+  for (; d <= deep - C8NUM; d += C8NUM) {
+    __m256 weight = LoadBf16x8(b + d);
+    for (int r = 0; r < BF16_MATMUL_ROW_TILE; ++r) {
+      acc[r] = _mm256_fmadd_ps(LoadBf16x8(a_rows[r] + d), weight, acc[r]);
+    }
+  }
+  for (int r = 0; r < rows; ++r) {
+    float dot = MS_GET_SUM256_F32(acc[r]);
+    for (int k = d; k < deep; ++k) {
+      dot += Bf16ToFloat32Scalar(a_rows[r][k]) * Bf16ToFloat32Scalar(b[k]);
+    }
+    dots[r] = dot;
+  }
+}
+#endif
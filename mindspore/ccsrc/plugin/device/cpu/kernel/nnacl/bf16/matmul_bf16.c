@@ -0,0 +1,74 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/bf16/matmul_bf16.h"
+#include "nnacl/bf16/cast_bf16.h"
+#ifdef ENABLE_AVX
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+
+void TransposeBf16(const uint16_t *src, uint16_t *dst, int row, int col) {
+  for (int r = 0; r < row; r += C8NUM) {
+    int row_end = MSMIN(row, r + C8NUM);
+    for (int c = 0; c < col; ++c) {
+      for (int k = r; k < row_end; ++k) {
+        dst[(size_t)c * row + k] = src[(size_t)k * col + c];
+      }
+    }
+  }
+}
+
+void Bf16DotC(const uint16_t *a, int a_stride, int rows, const uint16_t *b, int deep, float *dots) {
+  for (int r = 0; r < rows; ++r) {
+    const uint16_t *a_r = a + (size_t)r * a_stride;
+    float dot = 0.0f;
+    for (int d = 0; d < deep; ++d) {
+      dot += Bf16ToFloat32Scalar(a_r[d]) * Bf16ToFloat32Scalar(b[d]);
+    }
+    dots[r] = dot;
+  }
+}
+
+static Bf16DotFunc GetBf16DotFunc(void) {
+#ifdef ENABLE_AVX
+  IntelX86CpuInfoInitOnce();
+#endif
+#ifdef ENABLE_AVX512_BF16
+  if (X86_Avx512Bf16_Support()) {
+    return Bf16DotAvx512Bf16;
+  }
+#endif
+#ifdef ENABLE_AVX
+  if (X86_Avx_Support()) {
+    return Bf16DotAvx;
+  }
+#endif
+  return Bf16DotC;
+}
+
+void MatMulBf16(const uint16_t *a, const uint16_t *b, uint16_t *c, int row, int col, int deep, int stride) {
+  Bf16DotFunc dot_func = GetBf16DotFunc();
+  float dots[BF16_MATMUL_ROW_TILE];
+  for (int r = 0; r < row; r += BF16_MATMUL_ROW_TILE) {
+    int rows = MSMIN(BF16_MATMUL_ROW_TILE, row - r);
+    const uint16_t *a_r = a + (size_t)r * deep;
+    for (int j = 0; j < col; ++j) {
+      dot_func(a_r, deep, rows, b + (size_t)j * deep, deep, dots);
+      for (int i = 0; i < rows; ++i) {
+        c[(size_t)(r + i) * stride + j] = Float32ToBf16Scalar(dots[i]);
+      }
+    }
+  }
+}
@@ -0,0 +1,49 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NNACL_BF16_MATMUL_BF16_H_
+#define NNACL_BF16_MATMUL_BF16_H_
+
+#include "nnacl/op_base.h"
+
+#define BF16_MATMUL_ROW_TILE C4NUM
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* the fp32 dot products of `rows` rows of a (at most BF16_MATMUL_ROW_TILE) with a column of b. */
+typedef void (*Bf16DotFunc)(const uint16_t *a, int a_stride, int rows, const uint16_t *b, int deep, float *dots);
+
+/* src is row-major of [row][col], dst is row-major of [col][row]. */
+void TransposeBf16(const uint16_t *src, uint16_t *dst, int row, int col);
+
+/* c = a * b with the fp32 accumulation: a is row-major of [row][deep], b is the transposed weight of [col][deep], and
+ * c is row-major with the row stride of `stride`. */
+void MatMulBf16(const uint16_t *a, const uint16_t *b, uint16_t *c, int row, int col, int deep, int stride);
+
+void Bf16DotC(const uint16_t *a, int a_stride, int rows, const uint16_t *b, int deep, float *dots);
+
+#ifdef ENABLE_AVX
+void Bf16DotAvx(const uint16_t *a, int a_stride, int rows, const uint16_t *b, int deep, float *dots);
+#endif
+
+#ifdef ENABLE_AVX512_BF16
+void Bf16DotAvx512Bf16(const uint16_t *a, int a_stride, int rows, const uint16_t *b, int deep, float *dots);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNACL_BF16_MATMUL_BF16_H_
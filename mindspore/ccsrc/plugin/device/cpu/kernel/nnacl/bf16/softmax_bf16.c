@@ -0,0 +1,76 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/bf16/softmax_bf16.h"
+#include <float.h>
+#include "nnacl/bf16/cast_bf16.h"
+#include "nnacl/errorcode.h"
+#include "nnacl/fp32/exp_fp32.h"
+
+static float SubMaxAndExp(const uint16_t *src, float *exp_tile, int num, float max) {
+  Bf16ToFloat32(src, exp_tile, num);
+  for (int i = 0; i < num; ++i) {
+    exp_tile[i] -= max;
+  }
+  ExpFp32(exp_tile, exp_tile, num);
+  float sum = 0.0f;
+  for (int i = 0; i < num; ++i) {
+    sum += exp_tile[i];
+  }
+  return sum;
+}
+
+static void ScaleToBf16(float *exp_tile, uint16_t *dst, int num, float scale) {
+  for (int i = 0; i < num; ++i) {
+    exp_tile[i] *= scale;
+  }
+  Float32ToBf16(exp_tile, dst, num);
+}
+
+int SoftmaxLastAxisBf16(const uint16_t *src, uint16_t *dst, int batch, int channel) {
+  float tile[BF16_TILE];
+  for (int b = 0; b < batch; ++b) {
+    const uint16_t *src_b = src + (size_t)b * channel;
+    uint16_t *dst_b = dst + (size_t)b * channel;
+    float max = -FLT_MAX;
+    for (int i = 0; i < channel; i += BF16_TILE) {
+      int num = MSMIN(BF16_TILE, channel - i);
+      Bf16ToFloat32(src_b + i, tile, num);
+      for (int j = 0; j < num; ++j) {
+        max = MSMAX(max, tile[j]);
+      }
+    }
+    if (channel <= BF16_TILE) {
+      // the exp of a short channel stays in the tile, which saves the second exp.
+      float sum = SubMaxAndExp(src_b, tile, channel, max);
+      NNACL_CHECK_TRUE_RET(sum != 0, NNACL_ERR);
+      ScaleToBf16(tile, dst_b, channel, 1.0f / sum);
+      continue;
+    }
+    // the exp is redone rather than kept in dst, so that the output is rounded to bf16 only once.
+    float sum = 0.0f;
+    for (int i = 0; i < channel; i += BF16_TILE) {
+      sum += SubMaxAndExp(src_b + i, tile, MSMIN(BF16_TILE, channel - i), max);
+    }
+    NNACL_CHECK_TRUE_RET(sum != 0, NNACL_ERR);
+    float scale = 1.0f / sum;
+    for (int i = 0; i < channel; i += BF16_TILE) {
+      int num = MSMIN(BF16_TILE, channel - i);
+      (void)SubMaxAndExp(src_b + i, tile, num, max);
+      ScaleToBf16(tile, dst_b + i, num, scale);
+    }
+  }
+  return NNACL_OK;
+}
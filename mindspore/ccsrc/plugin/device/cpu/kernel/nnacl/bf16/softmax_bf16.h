@@ -0,0 +1,30 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NNACL_BF16_SOFTMAX_BF16_H_
+#define NNACL_BF16_SOFTMAX_BF16_H_
+
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* the softmax of the last axis, which accumulates in fp32. */
+int SoftmaxLastAxisBf16(const uint16_t *src, uint16_t *dst, int batch, int channel);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNACL_BF16_SOFTMAX_BF16_H_
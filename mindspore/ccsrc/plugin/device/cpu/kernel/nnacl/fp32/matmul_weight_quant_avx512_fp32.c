@@ -0,0 +1,108 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX512
+#include "nnacl/fp32/matmul_weight_quant_fp32.h"
+#include <immintrin.h>
+
+static inline __m512 LoadWeightInt8x16(const int8_t *b) {
+  return _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i *)b)));
+}
+
+void WeightInt8DotAvx512(const float *a, int a_stride, int rows, const int8_t *b, int start, int end, float *dots) {
+  int d = start;
+  if (rows == 1) {
+    // the gemv is bounded by the weight, two accumulators hide the latency of the fma.
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    for (; d <= end - C32NUM; d += C32NUM) {
+      acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + d), LoadWeightInt8x16(b + d), acc0);
+      acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + d + C16NUM), LoadWeightInt8x16(b + d + C16NUM), acc1);
+    }
+    float dot = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+    for (; d < end; ++d) {
+      dot += a[d] * b[d];
+    }
+    dots[0] = dot;
+    return;
+  }
+  const float *a_rows[WEIGHT_QUANT_ROW_TILE];
+  SET_TILE_ROW_PTRS(a, a_stride, rows, WEIGHT_QUANT_ROW_TILE, a_rows);
+  __m512 acc[WEIGHT_QUANT_ROW_TILE];
+  for (int r = 0; r < WEIGHT_QUANT_ROW_TILE; ++r) {
+    acc[r] = _mm512_setzero_ps();
+  }
+  for (; d <= end - C16NUM; d += C16NUM) {
+    __m512 weight = LoadWeightInt8x16(b + d);
+    for (int r = 0; r < WEIGHT_QUANT_ROW_TILE; ++r) {
+      acc[r] = _mm512_fmadd_ps(_mm512_loadu_ps(a_rows[r] + d), weight, acc[r]);
+    }
+  }
+  for (int r = 0; r < rows; ++r) {
+    float dot = _mm512_reduce_add_ps(acc[r]);
+    for (int k = d; k < end; ++k) {
+      dot += a_rows[r][k] * b[k];
+    }
+    dots[r] = dot;
+  }
+}
+
+// the low nibbles are the elements [0, 16) of the block and the high nibbles are the elements [16, 32).
+static inline void LoadWeightInt4x16x2(const int8_t *block, __m512 *low, __m512 *high) {
+  __m512i packed = _mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i *)block));
+  *low = _mm512_cvtepi32_ps(_mm512_srai_epi32(_mm512_slli_epi32(packed, 28), 28));
+  *high = _mm512_cvtepi32_ps(_mm512_srai_epi32(packed, 4));
+}
+
+void WeightInt4DotAvx512(const float *a, int a_stride, int rows, const int8_t *b, int start, int end, float *dots) {
+  int d = start;
+  __m512 low, high;
+  if (rows == 1) {
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    for (; d <= end - WEIGHT_INT4_BLOCK; d += WEIGHT_INT4_BLOCK) {
+      LoadWeightInt4x16x2(b + d / WEIGHT_INT4_BLOCK * WEIGHT_INT4_BLOCK_BYTES, &low, &high);
+      acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + d), low, acc0);
+      acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + d + C16NUM), high, acc1);
+    }
+    float dot = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+    for (; d < end; ++d) {
+      dot += a[d] * GetWeightInt4(b, d);
+    }
+    dots[0] = dot;
+    return;
+  }
+  const float *a_rows[WEIGHT_QUANT_ROW_TILE];
+  SET_TILE_ROW_PTRS(a, a_stride, rows, WEIGHT_QUANT_ROW_TILE, a_rows);
+  __m512 acc[WEIGHT_QUANT_ROW_TILE];
+  for (int r = 0; r < WEIGHT_QUANT_ROW_TILE; ++r) {
+    acc[r] = _mm512_setzero_ps();
+  }
+  for (; d <= end - WEIGHT_INT4_BLOCK; d += WEIGHT_INT4_BLOCK) {
+    LoadWeightInt4x16x2(b + d / WEIGHT_INT4_BLOCK * WEIGHT_INT4_BLOCK_BYTES, &low, &high);
+    for (int r = 0; r < WEIGHT_QUANT_ROW_TILE; ++r) {
+      acc[r] = _mm512_fmadd_ps(_mm512_loadu_ps(a_rows[r] + d), low, acc[r]);
+      acc[r] = _mm512_fmadd_ps(_mm512_loadu_ps(a_rows[r] + d + C16NUM), high, acc[r]);
+    }
+  }
+  for (int r = 0; r < rows; ++r) {
+    float dot = _mm512_reduce_add_ps(acc[r]);
+    for (int k = d; k < end; ++k) {
+      dot += a_rows[r][k] * GetWeightInt4(b, k);
+    }
+    dots[r] = dot;
+  }
+}
+#endif
@@ -0,0 +1,117 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX
+#include "nnacl/fp32/matmul_weight_quant_fp32.h"
+#include <immintrin.h>
+#include "nnacl/intrinsics/ms_simd_avx_instructions.h"
+
+static inline __m256 LoadWeightInt8x8(const int8_t *b) {
+  return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)b)));
+}
+
+void WeightInt8DotAvx(const float *a, int a_stride, int rows, const int8_t *b, int start, int end, float *dots) {
+  int d = start;
+  if (rows == 1) {
+    // the gemv is bounded by the weight, two accumulators hide the latency of the fma.
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    for (; d <= end - C16NUM; d += C16NUM) {
+      acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + d), LoadWeightInt8x8(b + d), acc0);
+      acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + d + C8NUM), LoadWeightInt8x8(b + d + C8NUM), acc1);
+    }
+    float dot = MS_GET_SUM256_F32(_mm256_add_ps(acc0, acc1));
+    for (; d < end; ++d) {
+      dot += a[d] * b[d];
+    }
+    dots[0] = dot;
+    return;
+  }
+  const float *a_rows[WEIGHT_QUANT_ROW_TILE];
+  SET_TILE_ROW_PTRS(a, a_stride, rows, WEIGHT_QUANT_ROW_TILE, a_rows);
+  __m256 acc[WEIGHT_QUANT_ROW_TILE];
+  for (int r = 0; r < WEIGHT_QUANT_ROW_TILE; ++r) {
+    acc[r] = _mm256_setzero_ps();
+  }
+  for (; d <= end - C8NUM; d += C8NUM) {
+    __m256 weight = LoadWeightInt8x8(b + d);
+    for (int r = 0; r < WEIGHT_QUANT_ROW_TILE; ++r) {
+      acc[r] = _mm256_fmadd_ps(_mm256_loadu_ps(a_rows[r] + d), weight, acc[r]);
+    }
+  }
+  for (int r = 0; r < rows; ++r) {
+    float dot = MS_GET_SUM256_F32(acc[r]);
+    for (int k = d; k < end; ++k) {
+      dot += a_rows[r][k] * b[k];
+    }
+    dots[r] = dot;
+  }
+}
+
+// the low nibbles are the elements [0, 16) of the block and the high nibbles are the elements [16, 32).
+static inline void LoadWeightInt4x8x2(const int8_t *block, int half, __m256 *low, __m256 *high) {
+  __m256i packed = _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)(block + half * C8NUM)));
+  *low = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(packed, 28), 28));
+  *high = _mm256_cvtepi32_ps(_mm256_srai_epi32(packed, 4));
+}
+
+void WeightInt4DotAvx(const float *a, int a_stride, int rows, const int8_t *b, int start, int end, float *dots) {
+  int d = start;
+  __m256 low, high;
+  if (rows == 1) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    for (; d <= end - WEIGHT_INT4_BLOCK; d += WEIGHT_INT4_BLOCK) {
+      const int8_t *block = b + d / WEIGHT_INT4_BLOCK * WEIGHT_INT4_BLOCK_BYTES;
+      for (int half = 0; half < C2NUM; ++half) {
+        LoadWeightInt4x8x2(block, half, &low, &high);
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + d + half * C8NUM), low, acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + d + half * C8NUM + WEIGHT_INT4_BLOCK_BYTES), high, acc1);
+      }
+    }
+    float dot = MS_GET_SUM256_F32(_mm256_add_ps(acc0, acc1));
+    for (; d < end; ++d) {
+      dot += a[d] * GetWeightInt4(b, d);
+    }
+    dots[0] = dot;
+    return;
+  }
+  const float *a_rows[WEIGHT_QUANT_ROW_TILE];
+  SET_TILE_ROW_PTRS(a, a_stride, rows, WEIGHT_QUANT_ROW_TILE, a_rows);
+  __m256 acc[WEIGHT_QUANT_ROW_TILE];
+  for (int r = 0; r < WEIGHT_QUANT_ROW_TILE; ++r) {
+    acc[r] = _mm256_setzero_ps();
+  }
+  for (; d <= end - WEIGHT_INT4_BLOCK; d += WEIGHT_INT4_BLOCK) {
+    const int8_t *block = b + d / WEIGHT_INT4_BLOCK * WEIGHT_INT4_BLOCK_BYTES;
+    for (int half = 0; half < C2NUM; ++half) {
+      LoadWeightInt4x8x2(block, half, &low, &high);
+      int low_d = d + half * C8NUM;
+      int high_d = low_d + WEIGHT_INT4_BLOCK_BYTES;
+      for (int r = 0; r < WEIGHT_QUANT_ROW_TILE; ++r) {
+        acc[r] = _mm256_fmadd_ps(_mm256_loadu_ps(a_rows[r] + low_d), low, acc[r]);
+        acc[r] = _mm256_fmadd_ps(_mm256_loadu_ps(a_rows[r] + high_d), high, acc[r]);
+      }
+    }
+  }
+  for (int r = 0; r < rows; ++r) {
+    float dot = MS_GET_SUM256_F32(acc[r]);
+    for (int k = d; k < end; ++k) {
+      dot += a_rows[r][k] * GetWeightInt4(b, k);
+    }
+    dots[r] = dot;
+  }
+}
+#endif
@@ -0,0 +1,145 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/fp32/matmul_weight_quant_fp32.h"
+#include <string.h>
+#ifdef ENABLE_AVX
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+
+void PackWeightInt4(const int8_t *src, int8_t *dst, int col, int deep) {
+  int col_bytes = WEIGHT_INT4_COL_BYTES(deep);
+  memset(dst, 0, (size_t)col * col_bytes);
+  for (int c = 0; c < col; ++c) {
+    const int8_t *src_c = src + (size_t)c * deep;
+    uint8_t *dst_c = (uint8_t *)dst + (size_t)c * col_bytes;
+    for (int d = 0; d < deep; ++d) {
+      int in_block = d % WEIGHT_INT4_BLOCK;
+      uint8_t *byte = dst_c + d / WEIGHT_INT4_BLOCK * WEIGHT_INT4_BLOCK_BYTES + in_block % WEIGHT_INT4_BLOCK_BYTES;
+      uint8_t nibble = (uint8_t)src_c[d] & 0x0F;
+      *byte |= in_block < WEIGHT_INT4_BLOCK_BYTES ? nibble : (uint8_t)(nibble << 4);
+    }
+  }
+}
+
+void CalcWeightQuantInputSums(const float *a, float *a_sums, int row, int deep, int group_size) {
+  int group_num = UP_DIV(deep, group_size);
+  for (int r = 0; r < row; ++r) {
+    const float *a_r = a + (size_t)r * deep;
+    for (int g = 0; g < group_num; ++g) {
+      int end = MSMIN(deep, (g + 1) * group_size);
+      float sum = 0.0f;
+      for (int d = g * group_size; d < end; ++d) {
+        sum += a_r[d];
+      }
+      a_sums[r * group_num + g] = sum;
+    }
+  }
+}
+
+static void WeightInt8DotC(const float *a, int a_stride, int rows, const int8_t *b, int start, int end,
+                           float *dots) {
+  for (int r = 0; r < rows; ++r) {
+    const float *a_r = a + (size_t)r * a_stride;
+    float dot = 0.0f;
+    for (int d = start; d < end; ++d) {
+      dot += a_r[d] * b[d];
+    }
+    dots[r] = dot;
+  }
+}
+
+static void WeightInt4DotC(const float *a, int a_stride, int rows, const int8_t *b, int start, int end,
+                           float *dots) {
+  for (int r = 0; r < rows; ++r) {
+    const float *a_r = a + (size_t)r * a_stride;
+    float dot = 0.0f;
+    for (int d = start; d < end; ++d) {
+      dot += a_r[d] * GetWeightInt4(b, d);
+    }
+    dots[r] = dot;
+  }
+}
+
+static void MatMulWeightQuantFp32(const float *a, const int8_t *b, float *c, const float *bias, const float *scales,
+                                  const float *zero_points, const float *a_sums, int act_type, int row, int col,
+                                  int deep, int group_size, int stride, int col_bytes, WeightQuantDotFunc dot_func) {
+  int group_num = UP_DIV(deep, group_size);
+  float dots[WEIGHT_QUANT_ROW_TILE];
+  for (int r = 0; r < row; r += WEIGHT_QUANT_ROW_TILE) {
+    int rows = MSMIN(WEIGHT_QUANT_ROW_TILE, row - r);
+    const float *a_r = a + (size_t)r * deep;
+    for (int j = 0; j < col; ++j) {
+      const int8_t *b_j = b + (size_t)j * col_bytes;
+      float acc[WEIGHT_QUANT_ROW_TILE] = {0};
+      for (int g = 0; g < group_num; ++g) {
+        int start = g * group_size;
+        dot_func(a_r, deep, rows, b_j, start, MSMIN(deep, start + group_size), dots);
+        float scale = scales[j * group_num + g];
+        if (zero_points == NULL) {
+          for (int i = 0; i < rows; ++i) {
+            acc[i] += scale * dots[i];
+          }
+        } else {
+          float zero_point = zero_points[j * group_num + g];
+          for (int i = 0; i < rows; ++i) {
+            acc[i] += scale * (dots[i] - zero_point * a_sums[(r + i) * group_num + g]);
+          }
+        }
+      }
+      for (int i = 0; i < rows; ++i) {
+        float value = bias == NULL ? acc[i] : acc[i] + bias[j];
+        if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+          value = MSMAX(0.0f, value);
+        }
+        if (act_type == ActType_Relu6) {
+          value = MSMIN(6.0f, value);
+        }
+        c[(size_t)(r + i) * stride + j] = value;
+      }
+    }
+  }
+}
+
+static WeightQuantDotFunc GetWeightQuantDotFunc(bool is_int4) {
+#ifdef ENABLE_AVX
+  IntelX86CpuInfoInitOnce();
+#endif
+#ifdef ENABLE_AVX512
+  if (X86_Avx512_Support()) {
+    return is_int4 ? WeightInt4DotAvx512 : WeightInt8DotAvx512;
+  }
+#endif
+#ifdef ENABLE_AVX
+  if (X86_Avx_Support()) {
+    return is_int4 ? WeightInt4DotAvx : WeightInt8DotAvx;
+  }
+#endif
+  return is_int4 ? WeightInt4DotC : WeightInt8DotC;
+}
+
+void MatMulInt8WeightFp32(const float *a, const int8_t *b, float *c, const float *bias, const float *scales,
+                          const float *zero_points, const float *a_sums, int act_type, int row, int col, int deep,
+                          int group_size, int stride) {
+  MatMulWeightQuantFp32(a, b, c, bias, scales, zero_points, a_sums, act_type, row, col, deep, group_size, stride, deep,
+                        GetWeightQuantDotFunc(false));
+}
+
+void MatMulInt4WeightFp32(const float *a, const int8_t *b, float *c, const float *bias, const float *scales,
+                          const float *zero_points, const float *a_sums, int act_type, int row, int col, int deep,
+                          int group_size, int stride) {
+  MatMulWeightQuantFp32(a, b, c, bias, scales, zero_points, a_sums, act_type, row, col, deep, group_size, stride,
+                        WEIGHT_INT4_COL_BYTES(deep), GetWeightQuantDotFunc(true));
+}
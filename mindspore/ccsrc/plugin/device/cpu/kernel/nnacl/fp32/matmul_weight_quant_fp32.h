@@ -0,0 +1,73 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NNACL_FP32_MATMUL_WEIGHT_QUANT_FP32_H_
+#define NNACL_FP32_MATMUL_WEIGHT_QUANT_FP32_H_
+
+#include "nnacl/op_base.h"
+
+/* The int4 weight of a column is packed by blocks of 32 along the deep, a block takes 16 bytes: the low nibble of the
+ * byte j is the element j, and the high nibble is the element j + 16. The tail block is padded by zero. */
+#define WEIGHT_INT4_BLOCK 32
+#define WEIGHT_INT4_BLOCK_BYTES 16
+#define WEIGHT_INT4_COL_BYTES(deep) (UP_DIV(deep, WEIGHT_INT4_BLOCK) * WEIGHT_INT4_BLOCK_BYTES)
+#define WEIGHT_INT4_MIN (-8)
+#define WEIGHT_INT4_MAX 7
+#define WEIGHT_QUANT_ROW_TILE C4NUM
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+static inline int8_t GetWeightInt4(const int8_t *b, int index) {
+  int in_block = index % WEIGHT_INT4_BLOCK;
+  int8_t value = b[index / WEIGHT_INT4_BLOCK * WEIGHT_INT4_BLOCK_BYTES + in_block % WEIGHT_INT4_BLOCK_BYTES];
+  return in_block < WEIGHT_INT4_BLOCK_BYTES ? (int8_t)((int8_t)((uint8_t)value << 4) >> 4) : (int8_t)(value >> 4);
+}
+
+/* the dot products of `rows` rows of a (at most WEIGHT_QUANT_ROW_TILE) with a column of b within [start, end). */
+typedef void (*WeightQuantDotFunc)(const float *a, int a_stride, int rows, const int8_t *b, int start, int end,
+                                   float *dots);
+
+/* src is the int8 weight of [col][deep] within [-8, 7], dst takes col * WEIGHT_INT4_COL_BYTES(deep) bytes. */
+void PackWeightInt4(const int8_t *src, int8_t *dst, int col, int deep);
+
+/* a_sums of [row][group_num] are only needed by the zero points. */
+void CalcWeightQuantInputSums(const float *a, float *a_sums, int row, int deep, int group_size);
+
+/* c = a * dequant(b) + bias, which dequantizes the weight in registers: a is row-major of [row][deep], b is the int8 or
+ * packed int4 weight of [col][deep], and scales and zero_points are of [col][group_num], in which a group is
+ * group_size elements along the deep. zero_points may be NULL when the weight is symmetric. The group size of the int4
+ * weight is either the deep or a multiple of WEIGHT_INT4_BLOCK. c is row-major with the row stride of `stride`. */
+void MatMulInt8WeightFp32(const float *a, const int8_t *b, float *c, const float *bias, const float *scales,
+                          const float *zero_points, const float *a_sums, int act_type, int row, int col, int deep,
+                          int group_size, int stride);
+void MatMulInt4WeightFp32(const float *a, const int8_t *b, float *c, const float *bias, const float *scales,
+                          const float *zero_points, const float *a_sums, int act_type, int row, int col, int deep,
+                          int group_size, int stride);
+
+#ifdef ENABLE_AVX
+void WeightInt8DotAvx(const float *a, int a_stride, int rows, const int8_t *b, int start, int end, float *dots);
+void WeightInt4DotAvx(const float *a, int a_stride, int rows, const int8_t *b, int start, int end, float *dots);
+#endif
+
+#ifdef ENABLE_AVX512
+void WeightInt8DotAvx512(const float *a, int a_stride, int rows, const int8_t *b, int start, int end, float *dots);
+void WeightInt4DotAvx512(const float *a, int a_stride, int rows, const int8_t *b, int start, int end, float *dots);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNACL_FP32_MATMUL_WEIGHT_QUANT_FP32_H_
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX512
+#include "nnacl/int8/matmul_avx_int8.h"
+#include <string.h>
+#include <immintrin.h>
+
+#define INT8_TO_UINT8_BIAS ((char)0x80)
+
+// broadcast a row of 16 int8 to the 4 x 128 bits, biased to uint8
+static inline __m512i BroadcastUint8x16(const int8_t *src, __m512i bias) {
+  return _mm512_xor_si512(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)src)), bias);
+}
+
+// broadcast a row of 4 int8 to the 16 x 32 bits, biased to uint8
+static inline __m512i BroadcastUint8x4(const int8_t *src, __m512i bias) {
+  int32_t value;
+  memcpy(&value, src, sizeof(int32_t));
+  return _mm512_xor_si512(_mm512_set1_epi32(value), bias);
+}
+
+// load two tiles of 32 int8 to the low and high 256 bits
+static inline __m512i LoadInt8x32x2(const int8_t *lo, const int8_t *hi) {
+  return _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_loadu_si256((const __m256i *)lo)),
+                            _mm256_loadu_si256((const __m256i *)hi), 1);
+}
+
+#define DPBUSD_ROW4(i, a_vec)                            \
+  acc##i##0 = _mm512_dpbusd_epi32(acc##i##0, a_vec, b0); \
+  acc##i##1 = _mm512_dpbusd_epi32(acc##i##1, a_vec, b1); \
+  acc##i##2 = _mm512_dpbusd_epi32(acc##i##2, a_vec, b2); \
+  acc##i##3 = _mm512_dpbusd_epi32(acc##i##3, a_vec, b3);
+
+#define INIT_ROW4(i)                                                              \
+  __m512i acc##i##0 = _mm512_setzero_si512(), acc##i##1 = _mm512_setzero_si512(); \
+  __m512i acc##i##2 = _mm512_setzero_si512(), acc##i##3 = _mm512_setzero_si512();
+
+// subtract the bias of a and sum up the 4 lanes of every column: 4 tiles x 4 columns
+#define STORE_ROW4(i)                                                     \
+  _mm512_storeu_si512(lanes[i][0], _mm512_sub_epi32(acc##i##0, corr[0])); \
+  _mm512_storeu_si512(lanes[i][1], _mm512_sub_epi32(acc##i##1, corr[1])); \
+  _mm512_storeu_si512(lanes[i][2], _mm512_sub_epi32(acc##i##2, corr[2])); \
+  _mm512_storeu_si512(lanes[i][3], _mm512_sub_epi32(acc##i##3, corr[3]));
+
+void MatmulInt8OptAvx512Vnni(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
+                             const int32_t *a_sums, const int32_t *bias, int mini, int maxi, int out_zp,
+                             const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift,
+                             size_t stride, size_t filter_peroc, const int32_t *filter_zp) {
+  /* row4x16-major * row16x4-major => (int8)row-major, a 4x16 block at a time.
+   * a tile of b is 4 columns x 16 deep, so a column takes 4 int32 lanes, which are added up at last. */
+  const __m512i a_bias = _mm512_set1_epi8(INT8_TO_UINT8_BIAS);
+  int col4 = UP_ROUND(col, C4NUM);
+  for (int c = 0; c < col; c += C16NUM) {
+    const int8_t *b_tile[C4NUM];
+    for (int t = 0; t < C4NUM; t++) {
+      // the tiles out of col4 redo the last tile and are dropped.
+      int tile_c = MSMIN(c + t * C4NUM, col4 - C4NUM);
+      b_tile[t] = b + tile_c * deep16;
+    }
+    __m512i corr[C4NUM];
+    for (int t = 0; t < C4NUM; t++) {
+      corr[t] = _mm512_setzero_si512();
+      for (int d = 0; d < deep16; d += C16NUM) {
+        corr[t] = _mm512_dpbusd_epi32(corr[t], a_bias, _mm512_loadu_si512(b_tile[t] + d * C4NUM));
+      }
+    }
+    for (int r = 0; r < row; r += C4NUM) {
+      const int8_t *a_r = a + r * deep16;
+      INIT_ROW4(0)
+      INIT_ROW4(1)
+      INIT_ROW4(2)
+      INIT_ROW4(3)
+      for (int d = 0; d < deep16; d += C16NUM) {
+        const int8_t *a_d = a_r + d * C4NUM;
+        __m512i b0 = _mm512_loadu_si512(b_tile[0] + d * C4NUM);
+        __m512i b1 = _mm512_loadu_si512(b_tile[1] + d * C4NUM);
+        __m512i b2 = _mm512_loadu_si512(b_tile[2] + d * C4NUM);
+        __m512i b3 = _mm512_loadu_si512(b_tile[3] + d * C4NUM);
+        __m512i a_vec = BroadcastUint8x16(a_d, a_bias);
+        DPBUSD_ROW4(0, a_vec)
+        a_vec = BroadcastUint8x16(a_d + C16NUM, a_bias);
+        DPBUSD_ROW4(1, a_vec)
+        a_vec = BroadcastUint8x16(a_d + C2NUM * C16NUM, a_bias);
+        DPBUSD_ROW4(2, a_vec)
+        a_vec = BroadcastUint8x16(a_d + C3NUM * C16NUM, a_bias);
+        DPBUSD_ROW4(3, a_vec)
+      }
+      int32_t lanes[C4NUM][C4NUM][C16NUM];
+      STORE_ROW4(0)
+      STORE_ROW4(1)
+      STORE_ROW4(2)
+      STORE_ROW4(3)
+      for (int i = 0; i < C4NUM && r + i < row; i++) {
+        for (int j = 0; j < C16NUM && c + j < col; j++) {
+          int cur_r = r + i;
+          int cur_c = c + j;
+          const int32_t *lane = lanes[i][j / C4NUM] + (j % C4NUM) * C4NUM;
+          int32_t value = lane[0] + lane[1] + lane[2] + lane[3];
+          value -= filter_peroc ? a_sums[cur_r] * filter_zp[cur_c] : a_sums[cur_r];
+          value += bias[cur_c];
+          int32_t cur_multiplier = filter_peroc ? multiplier[cur_c] : multiplier[0];
+          int32_t cur_left_shift = filter_peroc ? left_shift[cur_c] : left_shift[0];
+          int32_t cur_right_shift = filter_peroc ? right_shift[cur_c] : right_shift[0];
+          dst[cur_r * stride + cur_c] =
+            MatmulInt8Requant(value, cur_multiplier, cur_left_shift, cur_right_shift, out_zp, mini, maxi);
+        }
+      }
+    }
+  }
+}
+
+#define DPBUSD_ROW8(i) \
+  acc##i = _mm512_dpbusd_epi32(acc##i, BroadcastUint8x4(a_d + (i) * C4NUM, a_bias), b_vec);
+
+void MatmulInt8R8x8Avx512Vnni(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                              size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                              const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                              int32_t maxi, size_t per_channel) {
+  /* row8x4-major * row4x8-major => (int8)row-major, a 8x16 block at a time.
+   * the 4 deep of a column is just an int32 lane, so two tiles of b make up a vector of 16 columns. */
+  const __m512i a_bias = _mm512_set1_epi8(INT8_TO_UINT8_BIAS);
+  size_t row8 = UP_ROUND(row, C8NUM);
+  size_t col8 = UP_ROUND(col, C8NUM);
+  for (size_t c = 0; c < col; c += C16NUM) {
+    const int8_t *b_lo = b + c * deep_4;
+    // the high tile out of col8 redoes the low tile and is dropped.
+    const int8_t *b_hi = c + C8NUM < col8 ? b_lo + C8NUM * deep_4 : b_lo;
+    __m512i corr = _mm512_setzero_si512();
+    for (size_t d = 0; d < deep_4; d += C4NUM) {
+      corr = _mm512_dpbusd_epi32(corr, a_bias, LoadInt8x32x2(b_lo + d * C8NUM, b_hi + d * C8NUM));
+    }
+    for (size_t r = 0; r < row; r += C8NUM) {
+      const int8_t *a_r = a + r * deep_4;
+      __m512i acc0 = _mm512_setzero_si512(), acc1 = _mm512_setzero_si512();
+      __m512i acc2 = _mm512_setzero_si512(), acc3 = _mm512_setzero_si512();
+      __m512i acc4 = _mm512_setzero_si512(), acc5 = _mm512_setzero_si512();
+      __m512i acc6 = _mm512_setzero_si512(), acc7 = _mm512_setzero_si512();
+      for (size_t d = 0; d < deep_4; d += C4NUM) {
+        const int8_t *a_d = a_r + d * C8NUM;
+        __m512i b_vec = LoadInt8x32x2(b_lo + d * C8NUM, b_hi + d * C8NUM);
+        DPBUSD_ROW8(0)
+        DPBUSD_ROW8(1)
+        DPBUSD_ROW8(2)
+        DPBUSD_ROW8(3)
+        DPBUSD_ROW8(4)
+        DPBUSD_ROW8(5)
+        DPBUSD_ROW8(6)
+        DPBUSD_ROW8(7)
+      }
+      int32_t acc[C8NUM][C16NUM];
+      _mm512_storeu_si512(acc[0], _mm512_sub_epi32(acc0, corr));
+      _mm512_storeu_si512(acc[1], _mm512_sub_epi32(acc1, corr));
+      _mm512_storeu_si512(acc[2], _mm512_sub_epi32(acc2, corr));
+      _mm512_storeu_si512(acc[3], _mm512_sub_epi32(acc3, corr));
+      _mm512_storeu_si512(acc[4], _mm512_sub_epi32(acc4, corr));
+      _mm512_storeu_si512(acc[5], _mm512_sub_epi32(acc5, corr));
+      _mm512_storeu_si512(acc[6], _mm512_sub_epi32(acc6, corr));
+      _mm512_storeu_si512(acc[7], _mm512_sub_epi32(acc7, corr));
+      for (size_t i = 0; i < C8NUM && r + i < row; i++) {
+        for (size_t j = 0; j < C16NUM && c + j < col; j++) {
+          size_t cur_r = r + i;
+          size_t cur_c = c + j;
+          int32_t value = acc[i][j];
+          value -= per_channel ? input_sum[(cur_c / C8NUM) * row8 * C8NUM + cur_r * C8NUM + cur_c % C8NUM]
+                               : input_sum[cur_r];
+          value += bias[cur_c];
+          int32_t cur_multiplier = per_channel ? multiplier[cur_c] : multiplier[0];
+          int32_t cur_left_shift = per_channel ? left_shift[cur_c] : left_shift[0];
+          int32_t cur_right_shift = per_channel ? right_shift[cur_c] : right_shift[0];
+          dst[cur_r * stride + cur_c] =
+            MatmulInt8Requant(value, cur_multiplier, cur_left_shift, cur_right_shift, output_zp, mini, maxi);
+        }
+      }
+    }
+  }
+}
+#endif
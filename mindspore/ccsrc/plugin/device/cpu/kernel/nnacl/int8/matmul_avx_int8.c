@@ -0,0 +1,150 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX
+#include "nnacl/int8/matmul_avx_int8.h"
+#include <string.h>
+#include <immintrin.h>
+
+static inline __m256i LoadInt8ToInt16x16(const int8_t *src) {
+  return _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)src));
+}
+
+// broadcast 4 int8 to the 4 quarters of a 16 x int16 vector
+static inline __m256i BroadcastInt8x4ToInt16x16(const int8_t *src) {
+  int32_t value;
+  memcpy(&value, src, sizeof(int32_t));
+  return _mm256_cvtepi8_epi16(_mm_set1_epi32(value));
+}
+
+static inline int32_t ReduceAddInt32x8(__m256i src) {
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(src), _mm256_extracti128_si256(src, 1));
+  sum = _mm_hadd_epi32(sum, sum);
+  sum = _mm_hadd_epi32(sum, sum);
+  return _mm_cvtsi128_si32(sum);
+}
+
+#define MADD_ACC(acc, a_vec, b_vec) acc = _mm256_add_epi32(acc, _mm256_madd_epi16(a_vec, b_vec))
+
+void MatmulInt8OptAvx(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
+                      const int32_t *a_sums, const int32_t *bias, int mini, int maxi, int out_zp,
+                      const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift, size_t stride,
+                      size_t filter_peroc, const int32_t *filter_zp) {
+  /* row4x16-major * row16x4-major => (int8)row-major, a 4x2 block at a time */
+  for (int r = 0; r < row; r += C4NUM) {
+    const int8_t *a_r = a + r * deep16;
+    for (int c = 0; c < col; c += C2NUM) {
+      const int8_t *b_c = b + (c / C4NUM) * deep16 * C4NUM + (c % C4NUM) * C16NUM;
+      __m256i acc00 = _mm256_setzero_si256(), acc01 = _mm256_setzero_si256();
+      __m256i acc10 = _mm256_setzero_si256(), acc11 = _mm256_setzero_si256();
+      __m256i acc20 = _mm256_setzero_si256(), acc21 = _mm256_setzero_si256();
+      __m256i acc30 = _mm256_setzero_si256(), acc31 = _mm256_setzero_si256();
+      for (int d = 0; d < deep16; d += C16NUM) {
+        const int8_t *a_d = a_r + d * C4NUM;
+        const int8_t *b_d = b_c + d * C4NUM;
+        __m256i b0 = LoadInt8ToInt16x16(b_d);
+        __m256i b1 = LoadInt8ToInt16x16(b_d + C16NUM);
+        __m256i a_vec = LoadInt8ToInt16x16(a_d);
+        MADD_ACC(acc00, a_vec, b0);
+        MADD_ACC(acc01, a_vec, b1);
+        a_vec = LoadInt8ToInt16x16(a_d + C16NUM);
+        MADD_ACC(acc10, a_vec, b0);
+        MADD_ACC(acc11, a_vec, b1);
+        a_vec = LoadInt8ToInt16x16(a_d + C2NUM * C16NUM);
+        MADD_ACC(acc20, a_vec, b0);
+        MADD_ACC(acc21, a_vec, b1);
+        a_vec = LoadInt8ToInt16x16(a_d + C3NUM * C16NUM);
+        MADD_ACC(acc30, a_vec, b0);
+        MADD_ACC(acc31, a_vec, b1);
+      }
+      int32_t acc[C4NUM][C2NUM] = {{ReduceAddInt32x8(acc00), ReduceAddInt32x8(acc01)},
+                                   {ReduceAddInt32x8(acc10), ReduceAddInt32x8(acc11)},
+                                   {ReduceAddInt32x8(acc20), ReduceAddInt32x8(acc21)},
+                                   {ReduceAddInt32x8(acc30), ReduceAddInt32x8(acc31)}};
+      for (int i = 0; i < C4NUM && r + i < row; i++) {
+        for (int j = 0; j < C2NUM && c + j < col; j++) {
+          int cur_r = r + i;
+          int cur_c = c + j;
+          int32_t value = acc[i][j];
+          value -= filter_peroc ? a_sums[cur_r] * filter_zp[cur_c] : a_sums[cur_r];
+          value += bias[cur_c];
+          int32_t cur_multiplier = filter_peroc ? multiplier[cur_c] : multiplier[0];
+          int32_t cur_left_shift = filter_peroc ? left_shift[cur_c] : left_shift[0];
+          int32_t cur_right_shift = filter_peroc ? right_shift[cur_c] : right_shift[0];
+          dst[cur_r * stride + cur_c] =
+            MatmulInt8Requant(value, cur_multiplier, cur_left_shift, cur_right_shift, out_zp, mini, maxi);
+        }
+      }
+    }
+  }
+}
+
+void MatmulInt8R8x8Avx(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                       size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                       const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                       int32_t maxi, size_t per_channel) {
+  /* row8x4-major * row4x8-major => (int8)row-major, a 4x8 block at a time */
+  size_t row8 = UP_ROUND(row, C8NUM);
+  for (size_t r = 0; r < row; r += C4NUM) {
+    const int8_t *a_r = a + (r / C8NUM) * deep_4 * C8NUM + (r % C8NUM) * C4NUM;
+    for (size_t c = 0; c < col; c += C8NUM) {
+      const int8_t *b_c = b + c * deep_4;
+      // the low part holds columns 0~3 and the high part holds columns 4~7, two lanes a column.
+      __m256i acc0_lo = _mm256_setzero_si256(), acc0_hi = _mm256_setzero_si256();
+      __m256i acc1_lo = _mm256_setzero_si256(), acc1_hi = _mm256_setzero_si256();
+      __m256i acc2_lo = _mm256_setzero_si256(), acc2_hi = _mm256_setzero_si256();
+      __m256i acc3_lo = _mm256_setzero_si256(), acc3_hi = _mm256_setzero_si256();
+      for (size_t d = 0; d < deep_4; d += C4NUM) {
+        const int8_t *a_d = a_r + d * C8NUM;
+        const int8_t *b_d = b_c + d * C8NUM;
+        __m256i b_lo = LoadInt8ToInt16x16(b_d);
+        __m256i b_hi = LoadInt8ToInt16x16(b_d + C16NUM);
+        __m256i a_vec = BroadcastInt8x4ToInt16x16(a_d);
+        MADD_ACC(acc0_lo, a_vec, b_lo);
+        MADD_ACC(acc0_hi, a_vec, b_hi);
+        a_vec = BroadcastInt8x4ToInt16x16(a_d + C4NUM);
+        MADD_ACC(acc1_lo, a_vec, b_lo);
+        MADD_ACC(acc1_hi, a_vec, b_hi);
+        a_vec = BroadcastInt8x4ToInt16x16(a_d + C2NUM * C4NUM);
+        MADD_ACC(acc2_lo, a_vec, b_lo);
+        MADD_ACC(acc2_hi, a_vec, b_hi);
+        a_vec = BroadcastInt8x4ToInt16x16(a_d + C3NUM * C4NUM);
+        MADD_ACC(acc3_lo, a_vec, b_lo);
+        MADD_ACC(acc3_hi, a_vec, b_hi);
+      }
+      // hadd gives columns 0 1 4 5 2 3 6 7, then swap the middle 64 bits.
+      int32_t acc[C4NUM][C8NUM];
+      _mm256_storeu_si256((__m256i *)acc[0], _mm256_permute4x64_epi64(_mm256_hadd_epi32(acc0_lo, acc0_hi), 0xD8));
+      _mm256_storeu_si256((__m256i *)acc[1], _mm256_permute4x64_epi64(_mm256_hadd_epi32(acc1_lo, acc1_hi), 0xD8));
+      _mm256_storeu_si256((__m256i *)acc[2], _mm256_permute4x64_epi64(_mm256_hadd_epi32(acc2_lo, acc2_hi), 0xD8));
+      _mm256_storeu_si256((__m256i *)acc[3], _mm256_permute4x64_epi64(_mm256_hadd_epi32(acc3_lo, acc3_hi), 0xD8));
+      for (size_t i = 0; i < C4NUM && r + i < row; i++) {
+        for (size_t j = 0; j < C8NUM && c + j < col; j++) {
+          size_t cur_r = r + i;
+          size_t cur_c = c + j;
+          int32_t value = acc[i][j];
+          value -= per_channel ? input_sum[(cur_c / C8NUM) * row8 * C8NUM + cur_r * C8NUM + j] : input_sum[cur_r];
+          value += bias[cur_c];
+          int32_t cur_multiplier = per_channel ? multiplier[cur_c] : multiplier[0];
+          int32_t cur_left_shift = per_channel ? left_shift[cur_c] : left_shift[0];
+          int32_t cur_right_shift = per_channel ? right_shift[cur_c] : right_shift[0];
+          dst[cur_r * stride + cur_c] =
+            MatmulInt8Requant(value, cur_multiplier, cur_left_shift, cur_right_shift, output_zp, mini, maxi);
+        }
+      }
+    }
+  }
+}
+#endif
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNACL_INT8_MATMUL_AVX_INT8_H_
+#define NNACL_INT8_MATMUL_AVX_INT8_H_
+
+#include "nnacl/op_base.h"
+#include "nnacl/int8/fixed_point.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+static inline int8_t MatmulInt8Requant(int32_t value, int32_t multiplier, int32_t left_shift, int32_t right_shift,
+                                       int32_t out_zp, int32_t mini, int32_t maxi) {
+  value = MultiplyByQuantizedMultiplier(value, multiplier, left_shift, right_shift) + out_zp;
+  value = MSMIN(maxi, value);
+  value = MSMAX(mini, value);
+  return (int8_t)value;
+}
+
+#ifdef ENABLE_AVX
+/* same layouts and results as MatmulInt8Opt (row4x16-major * row16x4-major) and MatMulInt8_8x8_r
+ * (row8x4-major * row4x8-major), the products are sign-extended to int16 and accumulated by vpmaddwd. */
+void MatmulInt8OptAvx(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
+                      const int32_t *a_sums, const int32_t *bias, int mini, int maxi, int out_zp,
+                      const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift, size_t stride,
+                      size_t filter_peroc, const int32_t *filter_zp);
+void MatmulInt8R8x8Avx(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                       size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                       const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                       int32_t maxi, size_t per_channel);
+#endif
+
+#ifdef ENABLE_AVX512
+/* the same as the avx ones, but accumulated by vpdpbusd: a is biased to uint8 by 128 and 128 * sum(b) of every
+ * column is subtracted from the result. */
+void MatmulInt8OptAvx512Vnni(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
+                             const int32_t *a_sums, const int32_t *bias, int mini, int maxi, int out_zp,
+                             const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift,
+                             size_t stride, size_t filter_peroc, const int32_t *filter_zp);
+void MatmulInt8R8x8Avx512Vnni(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                              size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                              const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                              int32_t maxi, size_t per_channel);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNACL_INT8_MATMUL_AVX_INT8_H_
@@ -16,6 +16,10 @@
 
 #include "nnacl/int8/matmul_int8.h"
 #include "nnacl/int8/fixed_point.h"
+#ifdef ENABLE_AVX
+#include "nnacl/int8/matmul_avx_int8.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
 
 void RowMajor2Row2x16MajorInt8(const int8_t *src_ptr, int8_t *dst_ptr, int row, int col) {
   int col16 = UP_ROUND(col, C16NUM);
@@ -303,6 +307,23 @@ void MatmulInt8Opt(const int8_t *a, const int8_t *b, int8_t *dst, int row, int c
    * a_sums is  perT  : input_row_sum * filter_zp
    *            perOc : input_row_sum
    * */
+#ifdef ENABLE_AVX
+  IntelX86CpuInfoInitOnce();
+#endif
+#ifdef ENABLE_AVX512
+  if (X86_Avx512Vnni_Support()) {
+    MatmulInt8OptAvx512Vnni(a, b, dst, row, col, deep16, a_sums, bias, mini, maxi, out_zp, multiplier, left_shift,
+                            right_shift, stride, filter_peroc, filter_zp);
+    return;
+  }
+#endif
+#ifdef ENABLE_AVX
+  if (X86_Avx_Support()) {
+    MatmulInt8OptAvx(a, b, dst, row, col, deep16, a_sums, bias, mini, maxi, out_zp, multiplier, left_shift,
+                     right_shift, stride, filter_peroc, filter_zp);
+    return;
+  }
+#endif
   for (int r = 0; r < row; r++) {
     for (int c = 0; c < col; c++) {
       int r4div = r / C4NUM, r4mod = r % C4NUM;
@@ -335,6 +356,23 @@ void MatMulInt8_8x8_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row,
                       const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
                       int32_t maxi, size_t per_channel) {
   /*  row8x4-major * row4x8-major => (int8)row-major  */
+#ifdef ENABLE_AVX
+  IntelX86CpuInfoInitOnce();
+#endif
+#ifdef ENABLE_AVX512
+  if (X86_Avx512Vnni_Support()) {
+    MatmulInt8R8x8Avx512Vnni(a, b, dst, row, col, deep_4, stride, input_sum, bias, left_shift, right_shift, multiplier,
+                             output_zp, mini, maxi, per_channel);
+    return;
+  }
+#endif
+#ifdef ENABLE_AVX
+  if (X86_Avx_Support()) {
+    MatmulInt8R8x8Avx(a, b, dst, row, col, deep_4, stride, input_sum, bias, left_shift, right_shift, multiplier,
+                      output_zp, mini, maxi, per_channel);
+    return;
+  }
+#endif
   for (size_t r = 0; r < row; r++) {
     for (size_t c = 0; c < col; c++) {
       size_t r8div = r / C8NUM, r8mod = r % C8NUM;
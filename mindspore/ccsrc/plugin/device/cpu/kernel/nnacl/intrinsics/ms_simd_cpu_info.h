@@ -48,12 +48,19 @@ const bool X86_Fma_Support(void);
 const bool X86_Sse_Support(void);
 const bool X86_Avx_Support(void);
 const bool X86_Avx512_Support(void);
+const bool X86_Avx512Vnni_Support(void);
+const bool X86_Avx512Bf16_Support(void);
 
 bool IsIntelX86Platform(void);
 X86CpuInfoErrorCodeEnum IntelX86InstructionSetSupportCheck(void);
 
 int IntelX86CpuInfoInit(void);
 
+/* IntelX86CpuInfoInit on the first call only. Called by the x86 dispatch of the int8 matmul, the weight quant fp32
+ * matmul and the bf16 matmul, so the flags are valid even if the runtime never inits the cpu info, as the cpu plugin
+ * running the bf16 MatMul does not. */
+void IntelX86CpuInfoInitOnce(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,6 +17,7 @@
 #include "nnacl/kernel/matmul_base.h"
 #include "nnacl/fp32/pack_fp32.h"
 #include "nnacl/fp32/matmul_fp32.h"
+#include "nnacl/fp32/matmul_weight_quant_fp32.h"
 #include "nnacl/tensor_c_utils.h"
 #include "nnacl/op_base.h"
 
@@ -492,8 +493,154 @@ void MatmulBaseFreePackedMatrixB(KernelBase *self) {
   matmul->matrix_b_.pack_ptr_ = NULL;
 }
 
+int MatmulWeightQuantPackMatrixB(MatmulStruct *matmul) {
+  MatmulWeightQuant *quant = &matmul->weight_quant_;
+  if (quant->pack_ptr_ != NULL) {
+    return NNACL_OK;
+  }
+  MatMulParameter *param = (MatMulParameter *)(matmul->base_.param_);
+  NNACL_CHECK_FALSE(!matmul->b_const_ || param->a_transpose_ || matmul->b_batch_ != 1, NNACL_ERR);
+  NNACL_CHECK_NULL_RETURN_ERR(quant->scales_);
+  TensorC *b_matrix = matmul->base_.in_[SECOND_INPUT];
+  const int8_t *src = (const int8_t *)b_matrix->data_;
+  NNACL_CHECK_NULL_RETURN_ERR(src);
+  int col = matmul->compute_.col_;
+  int deep = matmul->compute_.deep_;
+  NNACL_CHECK_INT_MUL_NOT_OVERFLOW(col, deep, NNACL_ERR);
+  int8_t *trans = NULL;
+  if (!param->b_transpose_) {
+    /* the weight of [deep][col] is transposed, so that a column is contiguous along the deep. */
+    trans = (int8_t *)malloc((size_t)col * deep);
+    NNACL_MALLOC_CHECK_NULL_RETURN_ERR(trans);
+    for (int d = 0; d < deep; ++d) {
+      for (int c = 0; c < col; ++c) {
+        trans[c * deep + d] = src[d * col + c];
+      }
+    }
+    src = trans;
+  }
+  for (int i = 0; quant->is_int4_ && i < col * deep; ++i) {
+    quant->is_int4_ = src[i] >= WEIGHT_INT4_MIN && src[i] <= WEIGHT_INT4_MAX;
+  }
+  if (quant->is_int4_ && quant->group_size_ != deep && quant->group_size_ % WEIGHT_INT4_BLOCK != 0) {
+    quant->is_int4_ = false;
+  }
+
+  bool is_packed = false;
+  size_t data_size = quant->is_int4_ ? (size_t)col * WEIGHT_INT4_COL_BYTES(deep) : (size_t)col * deep;
+  void *data = NULL;
+  if (matmul->is_sharing_pack_) {
+    data = matmul->get_sharing_weight_(matmul->shaing_manager_, b_matrix->data_, data_size, &is_packed);
+  } else {
+    data = malloc(data_size);
+  }
+  if (data == NULL) {
+    free(trans);
+    return NNACL_ERR;
+  }
+  quant->pack_ptr_ = (int8_t *)data;
+  if (!is_packed) {
+    if (quant->is_int4_) {
+      PackWeightInt4(src, quant->pack_ptr_, col, deep);
+    } else {
+      (void)memcpy(quant->pack_ptr_, src, data_size);
+    }
+  }
+  free(trans);
+  return NNACL_OK;
+}
+
+int MatmulWeightQuantParallelRun(MatmulStruct *matmul, int task_id) {
+  NNACL_CHECK_FALSE(task_id < 0 || task_id >= matmul->base_.thread_nr_, NNACL_ERR);
+  MatmulWeightQuant *quant = &matmul->weight_quant_;
+  MatmulComputeParam *compute = &matmul->compute_;
+  MatMulParameter *param = (MatMulParameter *)(matmul->base_.param_);
+
+  int start_oc = matmul->split_points_[task_id];
+  int end_oc = task_id == (matmul->base_.thread_nr_ - 1) ? compute->col_ : matmul->split_points_[task_id + 1];
+  int cur_oc = end_oc - start_oc;
+  if (cur_oc <= 0) {
+    return NNACL_OK;
+  }
+  int group_num = UP_DIV(compute->deep_, quant->group_size_);
+  int col_bytes = quant->is_int4_ ? WEIGHT_INT4_COL_BYTES(compute->deep_) : compute->deep_;
+  const float *a = (const float *)matmul->base_.in_[FIRST_INPUT]->data_;
+  const int8_t *b = quant->pack_ptr_ + (size_t)start_oc * col_bytes;
+  const float *scales = quant->scales_ + start_oc * group_num;
+  const float *zero_points = quant->zero_points_ == NULL ? NULL : quant->zero_points_ + start_oc * group_num;
+  const float *bias = matmul->matrix_c_.pack_ptr_ == NULL ? NULL : matmul->matrix_c_.pack_ptr_ + start_oc;
+  float *c = matmul->output_data_ + start_oc;
+  if (quant->is_int4_) {
+    MatMulInt4WeightFp32(a, b, c, bias, scales, zero_points, quant->a_sums_, param->act_type_, compute->row_num_,
+                         cur_oc, compute->deep_, quant->group_size_, compute->col_);
+  } else {
+    MatMulInt8WeightFp32(a, b, c, bias, scales, zero_points, quant->a_sums_, param->act_type_, compute->row_num_,
+                         cur_oc, compute->deep_, quant->group_size_, compute->col_);
+  }
+  return NNACL_OK;
+}
+
+int MatmulWeightQuantResize(MatmulStruct *matmul) {
+  MatmulComputeParam *compute = &matmul->compute_;
+  NNACL_CHECK_INT_MUL_NOT_OVERFLOW(matmul->a_batch_, compute->row_, NNACL_ERR);
+  compute->row_num_ = matmul->a_batch_ * compute->row_;
+  compute->col_align_ = compute->col_;
+  compute->col_step_ = compute->col_;
+  matmul->out_need_aligned_ = false;
+
+  /* the rows are few for the weight-only quantization, so the threads cut the columns. */
+  int total_col_unit = UP_DIV(compute->col_, C8NUM);
+  matmul->base_.thread_nr_ = NNACL_MAX(NNACL_MIN(matmul->base_.thread_nr_, total_col_unit), 1);
+  int block_col_unit = UP_DIV(total_col_unit, matmul->base_.thread_nr_);
+  int count = 0;
+  for (int split_point = 0; split_point < total_col_unit; split_point += block_col_unit) {
+    matmul->split_points_[count++] = split_point * C8NUM;
+  }
+  matmul->base_.thread_nr_ = count;
+  matmul->parallel_run_ = MatmulWeightQuantParallelRun;
+
+  if (!matmul->matrix_c_.has_packed_) {
+    int ret = MatmulBasePackBiasMatrix(matmul);
+    NNACL_CHECK_FALSE(ret != NNACL_OK, ret);
+    if (!matmul->bias_need_repack_) {
+      matmul->matrix_c_.has_packed_ = true;
+    }
+  }
+  return NNACL_OK;
+}
+
+int MatmulWeightQuantCompute(MatmulStruct *matmul) {
+  MatmulWeightQuant *quant = &matmul->weight_quant_;
+  MatmulComputeParam *compute = &matmul->compute_;
+  NNACL_CHECK_NULL_RETURN_ERR(quant->pack_ptr_);
+  NNACL_CHECK_NULL_RETURN_ERR(matmul->base_.in_[FIRST_INPUT]->data_);
+  matmul->output_data_ = (float *)(matmul->base_.out_[OUTPUT_INDEX]->data_);
+  NNACL_CHECK_NULL_RETURN_ERR(matmul->output_data_);
+
+  if (quant->zero_points_ != NULL) {
+    int group_num = UP_DIV(compute->deep_, quant->group_size_);
+    NNACL_CHECK_INT_MUL_NOT_OVERFLOW(compute->row_num_, group_num, NNACL_ERR);
+    quant->a_sums_ = (float *)(matmul->base_.env_->Alloc(matmul->base_.env_->allocator_,
+                                                          compute->row_num_ * group_num * sizeof(float)));
+    NNACL_MALLOC_CHECK_NULL_RETURN_ERR(quant->a_sums_);
+    CalcWeightQuantInputSums((const float *)matmul->base_.in_[FIRST_INPUT]->data_, quant->a_sums_, compute->row_num_,
+                             compute->deep_, quant->group_size_);
+  }
+  int ret = matmul->base_.env_->ParallelLaunch(matmul->base_.env_->thread_pool_, MatmulFp32Run, matmul,
+                                               matmul->base_.thread_nr_);
+  if (quant->a_sums_ != NULL) {
+    matmul->base_.env_->Free(matmul->base_.env_->allocator_, quant->a_sums_);
+    quant->a_sums_ = NULL;
+  }
+  matmul->output_data_ = NULL;
+  return ret;
+}
+
 int MatmulBaseResize(KernelBase *self) {
   MatmulStruct *matmul = (MatmulStruct *)self;
+  if (matmul->weight_quant_.enable_) {
+    return MatmulWeightQuantResize(matmul);
+  }
 
   int ret = matmul->init_parameter_(matmul);
   NNACL_CHECK_FALSE(ret != NNACL_OK, ret);
@@ -527,6 +674,15 @@ int MatmulBaseRelease(struct KernelBase *self) {
     free(matmul->matrix_c_.pack_ptr_);
     matmul->matrix_c_.pack_ptr_ = NULL;
   }
+  if (matmul->weight_quant_.enable_) {
+    if (matmul->is_sharing_pack_) {
+      matmul->free_sharing_weight_(matmul->shaing_manager_, matmul->weight_quant_.pack_ptr_);
+    } else {
+      free(matmul->weight_quant_.pack_ptr_);
+    }
+    matmul->weight_quant_.pack_ptr_ = NULL;
+    return NNACL_OK;
+  }
   if (matmul->a_const_) {
     if (matmul->is_sharing_pack_) {
       matmul->free_sharing_weight_(matmul->shaing_manager_, matmul->matrix_a_.pack_ptr_);
@@ -553,7 +709,8 @@ int MatmulBasePrepare(struct KernelBase *self) {
   NNACL_CHECK_FALSE(matmul->base_.in_size_ < C2NUM, NNACL_INPUT_TENSOR_ERROR);
   NNACL_CHECK_FALSE(matmul->base_.out_size_ < 1, NNACL_OUTPUT_TENSOR_ERROR);
   NNACL_CHECK_FALSE(matmul->base_.in_[FIRST_INPUT]->data_type_ != kNumberTypeFloat32, NNACL_INPUT_TENSOR_ERROR);
-  NNACL_CHECK_FALSE(matmul->base_.in_[SECOND_INPUT]->data_type_ != kNumberTypeFloat32, NNACL_INPUT_TENSOR_ERROR);
+  int b_data_type = matmul->weight_quant_.enable_ ? kNumberTypeInt8 : kNumberTypeFloat32;
+  NNACL_CHECK_FALSE(matmul->base_.in_[SECOND_INPUT]->data_type_ != b_data_type, NNACL_INPUT_TENSOR_ERROR);
 
   if (matmul->base_.in_size_ == THREE_TENSOR) {
     NNACL_CHECK_TRUE_RET(matmul->base_.in_[THIRD_INPUT]->data_type_ == kNumberTypeFloat32, NNACL_MATMUL_BIAS_INVALID);
@@ -564,18 +721,24 @@ int MatmulBasePrepare(struct KernelBase *self) {
     param->act_type_ != ActType_No && param->act_type_ != ActType_Relu && param->act_type_ != ActType_Relu6,
     NNACL_MATMUL_ACT_TYPE_INVALID);
 
-  int ret = matmul->init_parameter_(matmul);
-  NNACL_CHECK_FALSE(ret != NNACL_OK, ret);
-
-  if (matmul->a_const_) {
-    ret = MatmulBasePackMatrixA(matmul);
+  int ret = NNACL_OK;
+  if (matmul->weight_quant_.enable_) {
+    ret = MatmulWeightQuantPackMatrixB(matmul);
     NNACL_CHECK_FALSE(ret != NNACL_OK, ret);
-    matmul->matrix_a_.has_packed_ = true;
-  }
-  if (matmul->b_const_) {
-    ret = MatmulBasePackMatrixB(matmul);
+  } else {
+    ret = matmul->init_parameter_(matmul);
     NNACL_CHECK_FALSE(ret != NNACL_OK, ret);
-    matmul->matrix_b_.has_packed_ = true;
+
+    if (matmul->a_const_) {
+      ret = MatmulBasePackMatrixA(matmul);
+      NNACL_CHECK_FALSE(ret != NNACL_OK, ret);
+      matmul->matrix_a_.has_packed_ = true;
+    }
+    if (matmul->b_const_) {
+      ret = MatmulBasePackMatrixB(matmul);
+      NNACL_CHECK_FALSE(ret != NNACL_OK, ret);
+      matmul->matrix_b_.has_packed_ = true;
+    }
   }
 
   if (matmul->base_.in_size_ == THREE_TENSOR) {
@@ -591,6 +754,9 @@ int MatmulBasePrepare(struct KernelBase *self) {
 
 int MatmulBaseCompute(struct KernelBase *self) {
   MatmulStruct *matmul = (MatmulStruct *)self;
+  if (matmul->weight_quant_.enable_) {
+    return MatmulWeightQuantCompute(matmul);
+  }
 
   float *out_data = (float *)(matmul->base_.out_[FIRST_INPUT]->data_);
   NNACL_CHECK_FALSE(out_data == NULL, NNACL_ERR);
@@ -55,6 +55,17 @@ typedef struct MatmulComputeParam {
   int block_col_unit_;
 } MatmulComputeParam;
 
+/* matrix-b is an int8 weight which is dequantized in registers, the framework sets the params of it before Prepare. */
+typedef struct MatmulWeightQuant {
+  bool enable_;
+  bool is_int4_;  // packed into int4 if all the weight is within [-8, 7]
+  int group_size_;
+  const float *scales_;       // [col][group_num]
+  const float *zero_points_;  // [col][group_num], NULL if the weight is symmetric
+  int8_t *pack_ptr_;          // [col][deep] int8, or packed int4
+  float *a_sums_;             // [row][group_num], only for the zero points
+} MatmulWeightQuant;
+
 typedef struct MatmulStruct {
   KernelBase base_;
   MatmulComputeParam compute_;
@@ -89,6 +100,7 @@ typedef struct MatmulStruct {
   MatrixInfo matrix_a_;
   MatrixInfo matrix_b_;
   MatrixInfo matrix_c_;
+  MatmulWeightQuant weight_quant_;
 
   void (*matrix_a_pack_fun_)(const float *src_ptr, float *dst_ptr, int row, int col, int start_row, int end_row);
   void (*matrix_b_pack_fun_)(const float *src_ptr, float *dst_ptr, int row, int col, int start_row, int end_row);
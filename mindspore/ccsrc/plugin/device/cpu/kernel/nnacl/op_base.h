@@ -98,6 +98,15 @@
 #define DOWN_DIV(x, y) ((x) / (y))
 #define DOWN_ROUND(x, y) ((x) / (y) * (y))
 
+/* points a_rows[0, tile) to the rows of a, in which the rows out of `rows` redo the first row, so that the loop of a
+ * tile of rows can be unrolled. */
+#define SET_TILE_ROW_PTRS(a, a_stride, rows, tile, a_rows)                             \
+  do {                                                                                 \
+    for (int tile_r_ = 0; tile_r_ < (tile); ++tile_r_) {                               \
+      (a_rows)[tile_r_] = (a) + (size_t)(tile_r_ < (rows) ? tile_r_ : 0) * (a_stride); \
+    }                                                                                  \
+  } while (0)
+
 #define MSVALID(left, x, right) (MSMIN((MSMAX(left, x)), right))
 #define SIZE_MUL_OVERFLOW(x, y) (((x) == 0) ? false : (SIZE_MAX / (x)) < (y))
 #define INT_MUL_OVERFLOW(x, y)                                                                 \
@@ -20,6 +20,7 @@
 #include <unordered_map>
 #include "plugin/device/cpu/hal/device/cpu_device_address.h"
 #include "plugin/device/cpu/kernel/nnacl/fp32/softmax_fp32.h"
+#include "plugin/device/cpu/kernel/nnacl/bf16/softmax_bf16.h"
 
 namespace mindspore {
 namespace kernel {
@@ -40,6 +41,11 @@ struct AccType<float16> {
   using type = float;
 };
 
+template <>
+struct AccType<bfloat16> {
+  using type = float;
+};
+
 template <typename T, typename acc_T>
 void SoftmaxFunc(const T *input_ptr, T *output_ptr, acc_T *sum_data, int start, int end, int dim_axis, int inner_size) {
   for (int i = start; i < end; i++) {
@@ -82,8 +88,8 @@ bool SoftmaxCpuKernelMod::Init(const std::vector<KernelTensor *> &inputs, const
 
   auto dtype = inputs[0]->dtype_id();
   unit_size_ = abstract::TypeIdSize(dtype);
-  // for fp16, use acc_T in workspace
-  unit_size_ = dtype == kNumberTypeFloat16 ? unit_size_ * 2 : unit_size_;
+  // for fp16 and bf16, use acc_T in workspace
+  unit_size_ = (dtype == kNumberTypeFloat16 || dtype == kNumberTypeBFloat16) ? unit_size_ * 2 : unit_size_;
 
   return true;
 }
@@ -166,6 +172,18 @@ bool SoftmaxCpuKernelMod::LaunchKernel(const std::vector<KernelTensor *> &inputs
       return true;
     }
   }
+  if constexpr (std::is_same_v<T, bfloat16>) {
+    if (last_axis_) {
+      auto task = [this, input_data, output_data](size_t start, size_t end) {
+        int batch = SizeToInt(end - start);
+        size_t offset = start * IntToSize(dim_axis_);
+        (void)SoftmaxLastAxisBf16(reinterpret_cast<const uint16_t *>(input_data + offset),
+                                  reinterpret_cast<uint16_t *>(output_data + offset), batch, dim_axis_);
+      };
+      ParallelLaunchAutoSearch(task, output_elements_, this, &parallel_search_info_);
+      return true;
+    }
+  }
 
   auto outter_size = output_elements_ / inner_size_;
   auto task = [this, input_data, output_data, sum_data](int start, int end) {
@@ -179,6 +197,7 @@ bool SoftmaxCpuKernelMod::LaunchKernel(const std::vector<KernelTensor *> &inputs
 
 std::vector<std::pair<KernelAttr, SoftmaxCpuKernelMod::LaunchFunc>> SoftmaxCpuKernelMod::func_list_ = {
   {SOFTMAX_CPU_REG(kNumberTypeFloat16, float16)},
+  {SOFTMAX_CPU_REG(kNumberTypeBFloat16, bfloat16)},
   {SOFTMAX_CPU_REG(kNumberTypeFloat32, float)},
   {SOFTMAX_CPU_REG(kNumberTypeFloat64, double)}};
 
@@ -18,6 +18,8 @@
 #include <fcntl.h>
 #include <libaio.h>
 #include <unistd.h>
+#include <algorithm>
+#include <cerrno>
 #include <limits>
 #include <memory>
 #include <iostream>
@@ -49,7 +51,6 @@ inline size_t IntToSize(int u) {
 }  // namespace
 
 constexpr int kIOSuccess = 0;
-constexpr size_t kMaxPendingAIO = 1024;
 bool AIOContext::Initialize(size_t queue_depth) {
   if (queue_depth == 0) {
     return false;
@@ -67,60 +68,17 @@ bool AIOContext::Initialize(size_t queue_depth) {
 }
 
 bool AIOContext::Finalize() {
+  if (io_context_ != nullptr && io_destroy(io_context_) != kIOSuccess) {
+    return false;
+  }
+  io_context_ = nullptr;
   for (auto cb : iocbs_) {
     delete cb;
   }
   iocbs_.clear();
-  if (io_context_ != nullptr && io_destroy(io_context_) != kIOSuccess) {
-    return false;
-  }
   return true;
 }
 
-IocbHelper::IocbHelper(bool read, int fd, void *buf_base, size_t block_size, size_t byte_num, void *data,
-                       const std::vector<IocbPtr> &iocbs)
-    : read_(read),
-      fd_(fd),
-      cur_buf_(reinterpret_cast<uint8_t *>(buf_base)),
-      block_size_(block_size),
-      total_size_(byte_num),
-      data_(data),
-      iocbs_(iocbs) {
-  batch_size_ = iocbs_.size();
-  if (block_size_ == 0 || batch_size_ == 0) {
-    return;
-  }
-  last_block_size_ = total_size_ % block_size_;
-  total_block_num_ = last_block_size_ == 0 ? total_size_ / block_size_ : total_size_ / block_size_ + 1;
-  last_block_size_ = last_block_size_ == 0 ? block_size_ : last_block_size_;
-  last_batch_size_ = total_block_num_ % batch_size_;
-  total_batch_num_ = last_batch_size_ == 0 ? total_block_num_ / batch_size_ : total_block_num_ / batch_size_ + 1;
-  last_batch_size_ = last_batch_size_ == 0 ? batch_size_ : last_batch_size_;
-}
-
-size_t IocbHelper::PrepareNextBatch() {
-  if (cur_batch_ == total_batch_num_) {
-    return 0;
-  }
-  const bool last_batch = cur_batch_ == total_batch_num_ - 1;
-  size_t cur_batch_size = last_batch ? last_batch_size_ : batch_size_;
-  for (size_t i = 0; i < cur_batch_size; ++i) {
-    const bool last_block = (last_batch && i == cur_batch_size - 1);
-    size_t cur_block_size = last_block ? last_block_size_ : block_size_;
-    const auto &iocb = iocbs_[i];
-    if (read_) {
-      io_prep_pread(iocb, fd_, cur_buf_, cur_block_size, cur_offset_);
-    } else {
-      io_prep_pwrite(iocb, fd_, cur_buf_, cur_block_size, cur_offset_);
-    }
-    iocb->data = data_;
-    cur_offset_ += SizeToLong(block_size_);
-    cur_buf_ += block_size_;
-  }
-  cur_batch_ += 1;
-  return cur_batch_size;
-}
-
 AioPlugin &AioPlugin::GetInstance() {
   static AioPlugin instance;
   return instance;
@@ -130,6 +88,9 @@ bool AioPlugin::Init(const AsyncIOConf &conf) {
   if (inited_) {
     return true;
   }
+  if (conf.block_size == 0) {
+    return false;
+  }
   config_ = conf;
   aio_context_ = std::make_shared<AIOContext>();
   if (!aio_context_->Initialize(SizeToInt(config_.queue_depth))) {
@@ -137,21 +98,22 @@ bool AioPlugin::Init(const AsyncIOConf &conf) {
     aio_context_ = nullptr;
     return false;
   }
-  pending_events_ = new size_t[kMaxPendingAIO];
-  for (size_t i = 0; i < kMaxPendingAIO; ++i) {
-    pending_events_[i] = 0;
-  }
+  free_iocbs_ = aio_context_->iocbs_;
+  submit_iocbs_.reserve(aio_context_->queue_depth_);
   inited_ = true;
   return true;
 }
 
 AioPlugin::~AioPlugin() {
+  // Destroying the context waits for the iocbs in flight, so the files can be closed after that.
   if (aio_context_ != nullptr) {
     aio_context_->Finalize();
   }
-  if (pending_events_ != nullptr) {
-    delete[] pending_events_;
-    pending_events_ = nullptr;
+  for (const auto &[token, request] : requests_) {
+    if (request->fd_ >= 0) {
+      (void)CloseFile(request->fd_);
+      request->fd_ = -1;
+    }
   }
 }
 
@@ -163,69 +125,124 @@ bool AioPlugin::CloseFile(int fd) { return (close(fd) == 0); }
 
 bool AioPlugin::CheckAIOContextValid() { return (aio_context_ != nullptr && aio_context_->io_context_ != nullptr); }
 
-bool AioPlugin::SubmitIocb(size_t num) {
-  const auto submit_ret = io_submit(aio_context_->io_context_, SizeToLong(num), aio_context_->iocbs_.data());
-  return (submit_ret >= 0 && IntToSize(submit_ret) == num);
+void AioPlugin::SubmitWaitingRequests() {
+  submit_iocbs_.clear();
+  while (!waiting_requests_.empty() && !free_iocbs_.empty()) {
+    const auto request = waiting_requests_.front();
+    if (request->failed_ || request->prepared_ == request->byte_num_) {
+      waiting_requests_.pop_front();
+      continue;
+    }
+    const auto block_size = std::min(config_.block_size, request->byte_num_ - request->prepared_);
+    auto cb = free_iocbs_.back();
+    free_iocbs_.pop_back();
+    if (request->read_) {
+      io_prep_pread(cb, request->fd_, request->buf_ + request->prepared_, block_size, SizeToLong(request->prepared_));
+    } else {
+      io_prep_pwrite(cb, request->fd_, request->buf_ + request->prepared_, block_size, SizeToLong(request->prepared_));
+    }
+    cb->data = request.get();
+    request->prepared_ += block_size;
+    ++request->inflight_;
+    submit_iocbs_.emplace_back(cb);
+  }
+  size_t submitted = 0;
+  while (submitted < submit_iocbs_.size()) {
+    const auto submit_ret = io_submit(aio_context_->io_context_, SizeToLong(submit_iocbs_.size() - submitted),
+                                      submit_iocbs_.data() + submitted);
+    if (submit_ret <= 0) {
+      break;
+    }
+    submitted += IntToSize(submit_ret);
+  }
+  // The iocbs which failed to be submitted go back to the free list and fail their requests.
+  for (size_t i = submitted; i < submit_iocbs_.size(); ++i) {
+    auto request = reinterpret_cast<AIORequest *>(submit_iocbs_[i]->data);
+    request->failed_ = true;
+    --request->inflight_;
+    free_iocbs_.emplace_back(submit_iocbs_[i]);
+    FinishRequest(request);
+  }
+  submit_iocbs_.clear();
 }
 
-int AioPlugin::GetEvents(size_t min, size_t max, std::vector<size_t *> *pending_events) {
-  if (max > aio_context_->events_.size()) {
-    aio_context_->events_.resize(max);
+bool AioPlugin::ReapEvents(size_t min, std::unique_lock<std::mutex> *lock) {
+  if (reaping_) {
+    if (min != 0) {
+      reap_cv_.wait(*lock);
+    }
+    return true;
+  }
+  const size_t inflight_num = aio_context_->queue_depth_ - free_iocbs_.size();
+  if (inflight_num == 0) {
+    return true;
+  }
+  // The other threads can still queue and wait their requests while this one is blocked in io_getevents.
+  reaping_ = true;
+  if (min != 0) {
+    lock->unlock();
+  }
+  const auto get_events_ret = io_getevents(aio_context_->io_context_, SizeToLong(std::min(min, inflight_num)),
+                                           SizeToLong(inflight_num), aio_context_->events_.data(), nullptr);
+  if (min != 0) {
+    lock->lock();
+  }
+  reaping_ = false;
+  reap_cv_.notify_all();
+  if (get_events_ret == -EINTR) {
+    return true;
   }
-  const auto get_events_ret =
-    io_getevents(aio_context_->io_context_, SizeToLong(min), SizeToLong(max), aio_context_->events_.data(), nullptr);
   if (get_events_ret < 0) {
-    return get_events_ret;
+    return false;
   }
   const size_t events_num = IntToSize(get_events_ret);
-  if (events_num < min) {
-    return get_events_ret;
-  }
   for (size_t i = 0; i < events_num; ++i) {
-    if (aio_context_->events_[i].data != nullptr) {
-      pending_events->emplace_back(reinterpret_cast<size_t *>(aio_context_->events_[i].data));
+    const auto &event = aio_context_->events_[i];
+    auto cb = event.obj;
+    auto request = reinterpret_cast<AIORequest *>(cb->data);
+    if (event.res != cb->u.c.nbytes) {
+      request->failed_ = true;
     }
+    --request->inflight_;
+    free_iocbs_.emplace_back(cb);
+    FinishRequest(request);
   }
-  return get_events_ret;
+  return true;
 }
 
-bool AioPlugin::FileAIOSync(bool read, const std::string &file_name, void *buf_base, size_t byte_num) {
-  if (!CheckAIOContextValid()) {
-    return false;
+void AioPlugin::FinishRequest(AIORequest *request) {
+  if (request->fd_ < 0 || request->inflight_ != 0 || (!request->failed_ && request->prepared_ < request->byte_num_)) {
+    return;
   }
-  const auto fd = OpenFile(file_name);
-  if (fd < 0) {
-    return false;
+  if (!CloseFile(request->fd_)) {
+    request->failed_ = true;
   }
-  std::lock_guard<std::mutex> lock(aio_mutex_);
-  IocbHelper iocb_helper(read, fd, buf_base, config_.block_size, byte_num, nullptr, aio_context_->iocbs_);
-  auto batch_size = iocb_helper.PrepareNextBatch();
-  while (batch_size != 0) {
-    if (!SubmitIocb(batch_size)) {
-      return false;
-    }
-    std::vector<size_t *> pending_events;
-    const auto get_events_ret = GetEvents(batch_size, batch_size, &pending_events);
-    if (get_events_ret < 0 || IntToSize(get_events_ret) < batch_size) {
+  request->fd_ = -1;
+}
+
+bool AioPlugin::WaitRequest(AsyncIOToken token, std::unique_lock<std::mutex> *lock) {
+  auto iter = requests_.find(token);
+  if (iter == requests_.end()) {
+    return true;
+  }
+  const auto request = iter->second;
+  while (request->fd_ >= 0) {
+    SubmitWaitingRequests();
+    if (!ReapEvents(1, lock)) {
+      // The iocbs of the request may be still in flight, so the request is kept.
       return false;
     }
-    batch_size = iocb_helper.PrepareNextBatch();
   }
-  return CloseFile(fd);
+  (void)requests_.erase(iter);
+  return !request->failed_;
 }
 
-size_t AioPlugin::UpdateAsyncEvents() {
-  size_t update_num;
-  size_t total_update_num = 0;
-  do {
-    std::vector<size_t *> pending_events;
-    update_num = GetEvents(0, SizeToLong(config_.queue_depth), &pending_events);
-    total_update_num += update_num;
-    for (const auto ptr : pending_events) {
-      *ptr -= 1;
-    }
-  } while (update_num == config_.queue_depth);
-  return total_update_num;
+bool AioPlugin::FileAIOSync(bool read, const std::string &file_name, void *buf_base, size_t byte_num) {
+  AsyncIOToken token = kInvalidAsyncIOToken;
+  if (!FileAIOAsync(read, file_name, buf_base, byte_num, &token)) {
+    return false;
+  }
+  return Wait(token);
 }
 
 bool AioPlugin::FileAIOAsync(bool read, const std::string &file_name, void *buf_base, size_t byte_num,
@@ -233,41 +250,35 @@ bool AioPlugin::FileAIOAsync(bool read, const std::string &file_name, void *buf_
   if (!CheckAIOContextValid()) {
     return false;
   }
-  *token = GetNextAsyncToken();
   const auto fd = OpenFile(file_name);
   if (fd < 0) {
     return false;
   }
-  std::lock_guard<std::mutex> lock(aio_mutex_);
-  (void)UpdateAsyncEvents();
-  auto ptr = pending_events_ + *token;
-  IocbHelper iocb_helper(read, fd, buf_base, config_.block_size, byte_num, ptr, aio_context_->iocbs_);
-  auto batch_size = iocb_helper.PrepareNextBatch();
-  while (batch_size != 0) {
-    if (!SubmitIocb(batch_size)) {
-      return false;
-    }
-    pending_events_[*token] += batch_size;
-    (void)UpdateAsyncEvents();
-    batch_size = iocb_helper.PrepareNextBatch();
+  auto request = std::make_shared<AIORequest>();
+  request->read_ = read;
+  request->fd_ = fd;
+  request->buf_ = reinterpret_cast<uint8_t *>(buf_base);
+  request->byte_num_ = byte_num;
+
+  std::unique_lock<std::mutex> lock(aio_mutex_);
+  *token = ++next_token_;
+  requests_[*token] = request;
+  waiting_requests_.emplace_back(request);
+  // Reap what has completed to free as many iocbs as possible, then submit the blocks of all the waiting requests.
+  (void)ReapEvents(0, &lock);
+  SubmitWaitingRequests();
+  FinishRequest(request.get());
+  if (request->failed_) {
+    (void)WaitRequest(*token, &lock);
+    *token = kInvalidAsyncIOToken;
+    return false;
   }
   return true;
 }
 
 bool AioPlugin::Wait(AsyncIOToken token) {
-  while (pending_events_[token] != 0) {
-    std::vector<size_t *> pending_events;
-    const auto ret = GetEvents(0, SizeToLong(config_.queue_depth), &pending_events);
-    if (ret < 0) {
-      return false;
-    }
-    std::lock_guard<std::mutex> lock(aio_mutex_);
-    for (const auto ptr : pending_events) {
-      *ptr -= 1;
-    }
-  }
-  token_pool_.push(token);
-  return true;
+  std::unique_lock<std::mutex> lock(aio_mutex_);
+  return WaitRequest(token, &lock);
 }
 
 bool AioPlugin::Read(const std::string &file_name, void *data, size_t byte_num) {
@@ -286,25 +297,6 @@ bool AioPlugin::WriteAsync(const std::string &file_name, const void *data, size_
   return FileAIOAsync(false, file_name, const_cast<void *>(data), byte_num, token);
 }
 
-AsyncIOToken AioPlugin::GetNextAsyncToken() {
-  if (!token_pool_.empty()) {
-    const auto next_token = token_pool_.front();
-    token_pool_.pop();
-    return next_token;
-  }
-  AsyncIOToken next_token = ++next_token_;
-  if (next_token >= kMaxPendingAIO) {
-    while (token_pool_.empty()) {
-      (void)UpdateAsyncEvents();
-    }
-    next_token = token_pool_.front();
-    token_pool_.pop();
-    --next_token_;
-    return next_token;
-  }
-  return next_token;
-}
-
 AsyncIO *get_aio_instance() { return &AioPlugin::GetInstance(); }
 }  // namespace device
 }  // namespace mindspore
@@ -18,10 +18,11 @@
 #define MINDSPORE_CCSRC_RUNTIME_DEVICE_GSM_FILE_AIO_PLUGIN_H_
 
 #include <libaio.h>
-#include <list>
+#include <condition_variable>
+#include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <vector>
 
@@ -48,31 +49,25 @@ struct AIOContext {
   size_t queue_depth_{0};
 };
 
-class IocbHelper {
- public:
-  IocbHelper(bool read, int fd, void *buf_base, size_t block_size, size_t byte_num, void *data,
-             const std::vector<IocbPtr> &iocbs);
-  size_t PrepareNextBatch();
-
- private:
-  bool read_;
-  int fd_;
-  uint8_t *cur_buf_;
-  size_t block_size_;
-  size_t total_size_;
-  void *data_;
-  const std::vector<IocbPtr> &iocbs_;
-  size_t batch_size_;
-  size_t cur_batch_{0};
-  int64_t cur_offset_{0};
-  size_t last_block_size_;
-  size_t total_block_num_;
-  size_t last_batch_size_;
-  size_t total_batch_num_;
+// A read or write of a whole file, which is split into iocbs of the block size.
+struct AIORequest {
+  bool read_{false};
+  int fd_{-1};
+  uint8_t *buf_{nullptr};
+  size_t byte_num_{0};
+  // The bytes which have been prepared into iocbs.
+  size_t prepared_{0};
+  // The iocbs which have been submitted but not reaped yet.
+  size_t inflight_{0};
+  bool failed_{false};
 };
+using AIORequestPtr = std::shared_ptr<AIORequest>;
 
 using AsyncIOToken = size_t;
 
+// AioPlugin swaps files through Linux native aio with O_DIRECT. The blocks of all the pending requests share one
+// queue of iocbs, so the swaps issued back to back are submitted together and the device is kept busy, while no more
+// than queue depth iocbs are ever in flight.
 class AIO_EXPORT AioPlugin : public AsyncIO {
  public:
   AioPlugin() = default;
@@ -91,19 +86,31 @@ class AIO_EXPORT AioPlugin : public AsyncIO {
   int OpenFile(const std::string &file_name);
   bool CloseFile(int fd);
   bool CheckAIOContextValid();
-  bool SubmitIocb(size_t num);
-  int GetEvents(size_t min, size_t max, std::vector<size_t *> *pending_events);
-  size_t UpdateAsyncEvents();
-  AsyncIOToken GetNextAsyncToken();
+  // Prepare the iocbs of the waiting requests as long as there are free iocbs, and submit them all at once.
+  void SubmitWaitingRequests();
+  // Reap at least min completed iocbs and give them back to the free list. The lock is released while blocking for
+  // the events, and only one thread gets the events at a time, the others wait for it if min is not 0.
+  bool ReapEvents(size_t min, std::unique_lock<std::mutex> *lock);
+  // Close the file once all the blocks of the request have completed, or it has failed.
+  void FinishRequest(AIORequest *request);
+  bool WaitRequest(AsyncIOToken token, std::unique_lock<std::mutex> *lock);
 
  private:
   bool inited_{false};
   AsyncIOConf config_{};
   std::shared_ptr<AIOContext> aio_context_;
-  AsyncIOToken next_token_{};
-  std::queue<AsyncIOToken> token_pool_;
+  AsyncIOToken next_token_{kInvalidAsyncIOToken};
   std::mutex aio_mutex_;
-  size_t *pending_events_;
+  // Whether a thread is getting the events, which are returned in the shared events buffer of the context.
+  bool reaping_{false};
+  std::condition_variable reap_cv_;
+  // The requests which are not finished or not waited yet.
+  std::map<AsyncIOToken, AIORequestPtr> requests_;
+  // The requests which still have blocks to be submitted, in the order of arrival.
+  std::deque<AIORequestPtr> waiting_requests_;
+  // The iocbs which are not in flight, at most queue depth iocbs are in flight at any time.
+  std::vector<IocbPtr> free_iocbs_;
+  std::vector<IocbPtr> submit_iocbs_;
 };
 
 extern "C" AIO_EXPORT AsyncIO *get_aio_instance();
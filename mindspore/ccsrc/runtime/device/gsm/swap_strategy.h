@@ -142,6 +142,8 @@ class SwapContext {
   size_t cpu_mem_size_{0};
   size_t disk_mem_size_{0};
   bool parallel_for_comm_{false};
+  // The number of kernels ahead of the kernel using a swapped tensor to swap it in, 0 for swapping in just in time.
+  size_t prefetch_kernel_num_{0};
   bool offload_param_to_cpu_{false};
   bool offload_param_to_disk_{false};
   bool offload_checkpoint_to_cpu_{false};
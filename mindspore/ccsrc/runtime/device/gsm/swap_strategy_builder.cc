@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "runtime/device/gsm/swap_strategy_builder.h"
+#include <algorithm>
 #include <memory>
 #include <queue>
 #include <set>
@@ -26,6 +27,9 @@
 namespace mindspore {
 namespace device {
 namespace {
+// The swap out is right after the last kernel using the tensor, and the swap in is at least one kernel after it.
+constexpr size_t kMinSwapInDistance = 2;
+
 template <typename T>
 void CheckVectorIndex(const std::vector<T> &input, size_t index) {
   if (input.size() <= index) {
@@ -422,12 +426,35 @@ void SwapStrategyBuilder::HandleFusedTensor() {
   }
 }
 
+size_t SwapStrategyBuilder::GetSwapInIndex(const std::shared_ptr<Span> &span) {
+  MS_EXCEPTION_IF_NULL(span);
+  MS_EXCEPTION_IF_NULL(context_);
+  // Swap in ahead of the kernel using the tensor so the copy overlaps the kernels in between, as long as the device
+  // memory of these kernels can hold the tensor as well. The tensor is swapped in after the kernel swapping it out and
+  // in the same step as the kernel using it.
+  const auto prefetch_num = std::min(context_->prefetch_kernel_num_, span->current_index_);
+  const auto earliest_index =
+    std::max({span->last_index_ + kMinSwapInDistance, span->current_index_ / kernel_num_ * kernel_num_,
+              span->current_index_ - prefetch_num});
+  auto index = span->current_index_;
+  while (index > earliest_index) {
+    auto &mem_used = mem_used_level0_[(index - 1) % kernel_num_];
+    if (mem_used + span->tensor_size_ > total_mem_level0_) {
+      break;
+    }
+    mem_used += span->tensor_size_;
+    --index;
+  }
+  return index % kernel_num_;
+}
+
 void SwapStrategyBuilder::SpanToTensorAction() {
+  CheckVectorIndex(mem_used_level0_, kernel_num_ - 1);
   for (auto span : span_level1_) {
     MS_EXCEPTION_IF_NULL(span);
     AddTensorAction(SwapActionType::kHBM2DDR, span->tensor_id_, span->last_index_ + 1);
     if (!span->output_span_) {
-      AddTensorAction(SwapActionType::kDDR2HBM, span->tensor_id_, span->current_index_ % kernel_num_);
+      AddTensorAction(SwapActionType::kDDR2HBM, span->tensor_id_, GetSwapInIndex(span));
     }
   }
 
@@ -435,7 +462,7 @@ void SwapStrategyBuilder::SpanToTensorAction() {
     MS_EXCEPTION_IF_NULL(span);
     AddTensorAction(SwapActionType::kHBM2DISK, span->tensor_id_, span->last_index_ + 1);
     if (!span->output_span_) {
-      AddTensorAction(SwapActionType::kDISK2HBM, span->tensor_id_, span->current_index_ % kernel_num_);
+      AddTensorAction(SwapActionType::kDISK2HBM, span->tensor_id_, GetSwapInIndex(span));
     }
   }
 }
@@ -53,6 +53,7 @@ class BACKEND_EXPORT SwapStrategyBuilder {
   bool EnoughSpaceForSpan(const std::shared_ptr<Span> &span, std::vector<size_t> *mem_used,
                           size_t total_mem_size) const;
   void SpanToTensorAction();
+  size_t GetSwapInIndex(const std::shared_ptr<Span> &span);
 
  private:
   void ResetState(const KernelGraphPtr &graph, const std::shared_ptr<SwapContext> &context);
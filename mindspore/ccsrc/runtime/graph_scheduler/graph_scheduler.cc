@@ -455,6 +455,11 @@ void GraphScheduler::Initialize() {
   ComputeThreadNums(&actor_thread_num, &actor_and_kernel_thread_num);
   auto actor_manager = ActorMgr::GetActorMgrRef();
   MS_EXCEPTION_IF_NULL(actor_manager);
+  // The actors spawned from now on receive the OpData and OpControl through the lock-free mailbox.
+  if (common::IsEnableRuntimeConfig(common::kRuntimeMpscMailbox)) {
+    MS_LOG(INFO) << "Enable the mpsc mailbox of the actors.";
+    ActorMgr::set_enable_mpsc_mailbox(true);
+  }
   size_t actor_queue_size = 81920;
   auto ret =
     actor_manager->Initialize(true, actor_thread_num, actor_and_kernel_thread_num, actor_queue_size, numa_cpus_);
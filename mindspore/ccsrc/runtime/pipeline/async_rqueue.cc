@@ -67,41 +67,51 @@ void AsyncRQueue::WorkerLoop() {
   }
 
   while (true) {
-    std::shared_ptr<AsyncTask> task = tasks_queue_.Head();
-
-    MS_LOG(DEBUG) << "Get task";
-    MS_EXCEPTION_IF_NULL(task);
-    if (task->task_type() == kExitTask) {
-      tasks_queue_.Dequeue();
-      MS_LOG(DEBUG) << "Thread exit";
-      return;
-    }
+    // Run all the tasks which are ready, the queue is waited on only when it runs dry.
+    auto ready_num = tasks_queue_.WaitForReady();
+    for (; ready_num > 0; --ready_num) {
+      std::shared_ptr<AsyncTask> task = tasks_queue_.Head();
+
+      MS_LOG(DEBUG) << "Get task";
+      MS_EXCEPTION_IF_NULL(task);
+      if (task->task_type() == kExitTask) {
+        tasks_queue_.Dequeue();
+        MS_LOG(DEBUG) << "Thread exit";
+        return;
+      }
 
-    try {
-      task->Run();
-      tasks_queue_.Dequeue();
-    } catch (const std::exception &e) {
-      MS_LOG(INFO) << "Run task failed, error msg:" << e.what();
-      {
-        MsException::Instance().SetException();
-        // MsException is unreliable because it gets modified everywhere.
-        auto e_ptr = std::current_exception();
-        while (!tasks_queue_.IsEmpty()) {
-          auto &t = tasks_queue_.Head();
-          if (t->task_type() == kExitTask) {
-            break;
+      try {
+        task->Run();
+        tasks_queue_.Dequeue();
+      } catch (const std::exception &e) {
+        MS_LOG(INFO) << "Run task failed, error msg:" << e.what();
+        {
+          MsException::Instance().SetException();
+          // MsException is unreliable because it gets modified everywhere.
+          auto e_ptr = std::current_exception();
+          while (!tasks_queue_.IsEmpty()) {
+            auto &t = tasks_queue_.Head();
+            if (t->task_type() == kExitTask) {
+              break;
+            }
+            t->SetException(e_ptr);
+            tasks_queue_.Dequeue();
           }
-          t->SetException(e_ptr);
-          tasks_queue_.Dequeue();
         }
+        // The ready tasks have been taken above.
+        break;
       }
     }
   }
 }
 
 void AsyncRQueue::Push(const AsyncTaskPtr &task) {
-  if (worker_ == nullptr) {
-    worker_ = std::make_unique<std::thread>(&AsyncRQueue::WorkerLoop, this);
+  if (!worker_created_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(worker_mutex_);
+    if (worker_ == nullptr) {
+      worker_ = std::make_unique<std::thread>(&AsyncRQueue::WorkerLoop, this);
+    }
+    worker_created_.store(true, std::memory_order_release);
   }
 
   if (current_level_ == kThreadWaitLevel::kLevelUnknown) {
@@ -113,6 +123,13 @@ void AsyncRQueue::Push(const AsyncTaskPtr &task) {
   if (current_level_ >= wait_level_) {
     MS_LOG(EXCEPTION) << "Cannot push task from thread " << current_level_ << " to queue " << wait_level_;
   }
+  if (tasks_queue_.IsFull()) {
+    uint64_t start_time = 0;
+    PROFILER_START(start_time);
+    tasks_queue_.Enqueue(task);
+    PROFILER_END(start_time, ProfilerModule::kRuntime, ProfilerEvent::kWaitQueueNotFull, name_, false);
+    return;
+  }
   tasks_queue_.Enqueue(task);
 }
 
@@ -133,8 +150,7 @@ void AsyncRQueue::Wait() {
   }
 
   MS_LOG(DEBUG) << "Start to wait thread " << name_;
-  while (!tasks_queue_.IsEmpty()) {
-  }
+  tasks_queue_.WaitForEmpty();
   MsException::Instance().CheckException();
   MS_LOG(DEBUG) << "End to wait thread " << name_;
 }
@@ -191,7 +207,13 @@ void AsyncRQueue::WorkerJoin() {
         MS_LOG(DEBUG) << "Push exit task and notify all";
       }
       worker_->join();
-      MS_LOG(DEBUG) << "Worker join finish";
+      const auto statistics = tasks_queue_.Statistics();
+      MS_LOG(INFO) << "Worker of " << name_ << " join finish, task num: " << statistics.enqueue_count
+                   << ", max queue size: " << statistics.max_size << ", full wait count: "
+                   << statistics.full_wait_count << ", full wait time: " << statistics.full_wait_time
+                   << "ns, empty wait count: " << statistics.empty_wait_count
+                   << ", empty wait time: " << statistics.empty_wait_time << "ns, park count: "
+                   << statistics.park_count;
       MsException::Instance().CheckException();
     }
   } catch (const std::exception &e) {
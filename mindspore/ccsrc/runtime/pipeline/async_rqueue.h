@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_ASYNC_R_QUEUE_H_
 #define MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_ASYNC_R_QUEUE_H_
 
+#include <atomic>
 #include <queue>
 #include <memory>
 #include <thread>
@@ -73,11 +74,17 @@ class BACKEND_EXPORT AsyncRQueue {
   // Reinit resources after fork occurs.
   void ChildAfterFork();
 
+  // The occupancy and the wait time of the queue.
+  RingQueueStatistics Statistics() const { return tasks_queue_.Statistics(); }
+
  protected:
   void WorkerLoop();
   void SetThreadName() const;
 
   std::unique_ptr<std::thread> worker_{nullptr};
+  // The tasks may be pushed by more than one thread, the worker is created by the first one.
+  std::atomic<bool> worker_created_{false};
+  std::mutex worker_mutex_;
   std::string name_;
   kThreadWaitLevel wait_level_;
   inline static std::unordered_map<std::thread::id, kThreadWaitLevel> thread_id_to_wait_level_;
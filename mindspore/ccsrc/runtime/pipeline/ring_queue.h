@@ -19,53 +19,231 @@
 
 #include <atomic>
 #include <array>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <thread>
 
 namespace mindspore {
-// A simple ring buffer (or circular queue) with atomic operations for
-// thread-safe enqueue, dequeue, and check for emptiness.
-// RingQueue is only applicable to single-producer and single-consumer scenarios.
+// The counters of a ring queue, the wait time is in nanoseconds.
+struct RingQueueStatistics {
+  uint64_t enqueue_count{0};
+  uint64_t size{0};
+  uint64_t max_size{0};
+  // The times and the time the producers wait for a full queue.
+  uint64_t full_wait_count{0};
+  uint64_t full_wait_time{0};
+  // The times and the time the consumer waits for an empty queue.
+  uint64_t empty_wait_count{0};
+  uint64_t empty_wait_time{0};
+  // The times a waiting thread is parked after spinning and yielding.
+  uint64_t park_count{0};
+};
+
+// A bounded ring buffer (or circular queue) for multiple producers and a single consumer.
+// Every slot carries a sequence number, so the producers only contend on claiming the tail, and a slot is published to
+// the consumer by its sequence number. The consumer takes the head with Head(), runs it and releases it by Dequeue(),
+// so the queue is not empty until the last task has finished.
+// A thread waiting for the queue spins for a while, then yields, and is parked at last, so an idle queue does not
+// occupy a core.
 template <typename T, std::size_t Capacity>
 class RingQueue {
  public:
-  RingQueue() : head_(0), tail_(0) {}
+  RingQueue() : head_(0), tail_(0) {
+    for (std::size_t i = 0; i < Capacity; ++i) {
+      buffer_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
 
   void Enqueue(const T &value) {
-    std::size_t current_tail = tail_.load(std::memory_order_relaxed);
-    std::size_t next_tail = (current_tail + 1) % Capacity;
-
-    while (next_tail == head_.load(std::memory_order_acquire)) {
+    std::size_t pos = tail_.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    while (true) {
+      slot = &buffer_[pos % Capacity];
+      const auto diff = Distance(slot->sequence.load(std::memory_order_acquire), pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // The slot is still taken by the task of the last round, so the queue is full.
+        WaitFull(slot, pos);
+        pos = tail_.load(std::memory_order_relaxed);
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
     }
-
-    buffer_[current_tail] = value;
-    tail_.store(next_tail, std::memory_order_release);
+    slot->value = value;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    (void)enqueue_count_.fetch_add(1, std::memory_order_relaxed);
+    UpdateMaxSize(pos + 1 - head_.load(std::memory_order_relaxed));
+    WakeUp();
   }
 
   void Dequeue() {
     std::size_t current_head = head_.load(std::memory_order_relaxed);
-    while (current_head == tail_.load(std::memory_order_acquire)) {
-    }
+    Slot *slot = &buffer_[current_head % Capacity];
+    WaitEmpty([slot, current_head]() { return Ready(slot, current_head); });
 
     // Free memory when task is finished.
-    buffer_[current_head] = nullptr;
-    head_.store((current_head + 1) % Capacity, std::memory_order_release);
+    slot->value = T();
+    slot->sequence.store(current_head + Capacity, std::memory_order_release);
+    head_.store(current_head + 1, std::memory_order_release);
+    WakeUp();
   }
 
   const T &Head() {
     std::size_t current_head = head_.load(std::memory_order_acquire);
-    while (current_head == tail_.load(std::memory_order_acquire)) {
+    Slot *slot = &buffer_[current_head % Capacity];
+    WaitEmpty([slot, current_head]() { return Ready(slot, current_head); });
+    return slot->value;
+  }
+
+  // Wait until a task is ready and return the number of the ready tasks from the head, which can be taken by Head()
+  // and Dequeue() one by one without waiting.
+  std::size_t WaitForReady() {
+    std::size_t current_head = head_.load(std::memory_order_acquire);
+    WaitEmpty([this, current_head]() { return Ready(&buffer_[current_head % Capacity], current_head); });
+    std::size_t ready_num = 1;
+    while (ready_num < Capacity &&
+           Ready(&buffer_[(current_head + ready_num) % Capacity], current_head + ready_num)) {
+      ++ready_num;
     }
-    return buffer_[current_head];
+    return ready_num;
+  }
+
+  // Wait until all the tasks are dequeued.
+  void WaitForEmpty() {
+    WaitUntil([this]() { return IsEmpty(); }, nullptr, nullptr);
   }
 
   bool IsEmpty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
 
+  std::size_t Size() const {
+    const auto head = head_.load(std::memory_order_acquire);
+    const auto tail = tail_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  bool IsFull() const { return Size() >= Capacity; }
+
+  RingQueueStatistics Statistics() const {
+    RingQueueStatistics statistics;
+    statistics.enqueue_count = enqueue_count_.load(std::memory_order_relaxed);
+    statistics.size = Size();
+    statistics.max_size = max_size_.load(std::memory_order_relaxed);
+    statistics.full_wait_count = full_wait_count_.load(std::memory_order_relaxed);
+    statistics.full_wait_time = full_wait_time_.load(std::memory_order_relaxed);
+    statistics.empty_wait_count = empty_wait_count_.load(std::memory_order_relaxed);
+    statistics.empty_wait_time = empty_wait_time_.load(std::memory_order_relaxed);
+    statistics.park_count = park_count_.load(std::memory_order_relaxed);
+    return statistics;
+  }
+
  private:
-  std::array<T, Capacity> buffer_;
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  // Check the condition busily for kSpinCount times, then yield for kYieldCount times before parking.
+  static constexpr std::size_t kSpinCount = 1 << 10;
+  static constexpr std::size_t kYieldCount = 1 << 6;
+
+  static std::ptrdiff_t Distance(std::size_t sequence, std::size_t pos) {
+    return static_cast<std::ptrdiff_t>(sequence - pos);
+  }
+
+  static bool Ready(const Slot *slot, std::size_t pos) {
+    return slot->sequence.load(std::memory_order_acquire) == pos + 1;
+  }
+
+  static void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+  }
+
+  void WaitFull(const Slot *slot, std::size_t pos) {
+    WaitUntil([slot, pos]() { return Distance(slot->sequence.load(std::memory_order_acquire), pos) >= 0; },
+              &full_wait_count_, &full_wait_time_);
+  }
+
+  template <typename Pred>
+  void WaitEmpty(const Pred &ready) {
+    WaitUntil(ready, &empty_wait_count_, &empty_wait_time_);
+  }
+
+  template <typename Pred>
+  void WaitUntil(const Pred &ready, std::atomic<uint64_t> *wait_count, std::atomic<uint64_t> *wait_time) {
+    if (ready()) {
+      return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    bool done = false;
+    for (std::size_t i = 0; i < kSpinCount && !done; ++i) {
+      CpuRelax();
+      done = ready();
+    }
+    for (std::size_t i = 0; i < kYieldCount && !done; ++i) {
+      std::this_thread::yield();
+      done = ready();
+    }
+    if (!done) {
+      std::unique_lock<std::mutex> lock(park_mutex_);
+      (void)parked_num_.fetch_add(1, std::memory_order_seq_cst);
+      // Pair with the fence in WakeUp(), either the condition is seen here or the parked thread is seen there.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      park_cv_.wait(lock, ready);
+      (void)parked_num_.fetch_sub(1, std::memory_order_relaxed);
+      (void)park_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (wait_count != nullptr && wait_time != nullptr) {
+      const auto cost =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+      (void)wait_count->fetch_add(1, std::memory_order_relaxed);
+      (void)wait_time->fetch_add(static_cast<uint64_t>(cost), std::memory_order_relaxed);
+    }
+  }
+
+  // Wake up the parked threads after the queue is changed, which costs only a fence if no thread is parked.
+  void WakeUp() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_num_.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(park_mutex_);
+    }
+    park_cv_.notify_all();
+  }
+
+  void UpdateMaxSize(std::size_t size) {
+    auto max_size = max_size_.load(std::memory_order_relaxed);
+    while (size > max_size && !max_size_.compare_exchange_weak(max_size, size, std::memory_order_relaxed)) {
+    }
+  }
+
+  std::array<Slot, Capacity> buffer_;
   // CPU cache line size is 64.
   alignas(64) std::atomic<std::size_t> head_;
   alignas(64) std::atomic<std::size_t> tail_;
+
+  alignas(64) std::atomic<std::size_t> parked_num_{0};
+  std::mutex park_mutex_;
+  std::condition_variable park_cv_;
+
+  std::atomic<uint64_t> enqueue_count_{0};
+  std::atomic<uint64_t> max_size_{0};
+  std::atomic<uint64_t> full_wait_count_{0};
+  std::atomic<uint64_t> full_wait_time_{0};
+  std::atomic<uint64_t> empty_wait_count_{0};
+  std::atomic<uint64_t> empty_wait_time_{0};
+  std::atomic<uint64_t> park_count_{0};
 };
 }  // namespace mindspore
 
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/pynative/op_cache_key.h"
+
+#include <algorithm>
+#include "ir/scalar.h"
+#include "ir/named.h"
+#include "ir/dtype/type.h"
+#include "utils/hashing.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace pynative {
+namespace {
+bool IsStructuralValue(const ValuePtr &value) {
+  MS_EXCEPTION_IF_NULL(value);
+  if (value->isa<Scalar>() || value->isa<StringImm>() || value->isa<Type>() || value->isa<None>()) {
+    return true;
+  }
+  if (value->isa<ValueSequence>()) {
+    const auto &elements = value->cast_ptr<ValueSequence>()->value();
+    return std::all_of(elements.begin(), elements.end(), [](const ValuePtr &element) {
+      return element != nullptr && IsStructuralValue(element);
+    });
+  }
+  return false;
+}
+
+// The hash of ValueSequence only counts the elements, so the elements are hashed here one by one.
+std::size_t StructuralHash(const ValuePtr &value) {
+  if (!value->isa<ValueSequence>()) {
+    return value->hash();
+  }
+  std::size_t hash_sum = value->hash();
+  for (const auto &element : value->cast_ptr<ValueSequence>()->value()) {
+    hash_sum = hash_combine(hash_sum, StructuralHash(element));
+  }
+  return hash_sum;
+}
+}  // namespace
+
+void OpCacheKey::AppendValue(const ValuePtr &value) {
+  if (!IsStructuralValue(value)) {
+    AppendString(value->ToString());
+    return;
+  }
+  AppendInt(kValueMark);
+  values_.push_back(value);
+  Mix(StructuralHash(value));
+}
+
+void OpCacheKeyMatcher::AppendValue(const ValuePtr &value) {
+  if (!matched_) {
+    return;
+  }
+  if (!IsStructuralValue(value)) {
+    AppendString(value->ToString());
+    return;
+  }
+  AppendInt(OpCacheKey::kValueMark);
+  if (!matched_) {
+    return;
+  }
+  const auto &values = key_->values_;
+  matched_ = value_pos_ < values.size() && (values[value_pos_] == value || *values[value_pos_] == *value);
+  ++value_pos_;
+}
+
+bool OpCacheKey::operator==(const OpCacheKey &other) const {
+  if (hash_ != other.hash_ || ints_ != other.ints_ || strs_ != other.strs_ || values_.size() != other.values_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < values_.size(); ++i) {
+    if (values_[i] != other.values_[i] && !(*values_[i] == *other.values_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace pynative
+}  // namespace mindspore
@@ -0,0 +1,158 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_OP_CACHE_KEY_H_
+#define MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_OP_CACHE_KEY_H_
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ir/value.h"
+#include "utils/convert_utils_base.h"
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace pynative {
+// The structural key of a single op graph in the op compiler cache.
+// The key is made up of integers (shapes, dtypes, input types and so on), values (attrs and scalar inputs) compared
+// by value, and strings (formats and the values of the const tensors). A 64-bit fingerprint is folded in while the
+// parts are appended, so a lookup compares the fingerprint first and the parts only on a fingerprint match. A mark is
+// appended to the integers for every value and string, so the order of the parts is kept in the key as well.
+// Clear() keeps the capacity of the buffers, so a key reused for every op does not allocate once it is warmed up.
+class BACKEND_EXPORT OpCacheKey {
+ public:
+  OpCacheKey() = default;
+  ~OpCacheKey() = default;
+
+  void Clear() {
+    hash_ = kSeed;
+    ints_.clear();
+    values_.clear();
+    strs_.clear();
+  }
+
+  void AppendInt(int64_t value) {
+    ints_.push_back(value);
+    Mix(static_cast<uint64_t>(value));
+  }
+
+  void AppendInts(const std::vector<int64_t> &values) {
+    AppendInt(SizeToLong(values.size()));
+    for (auto value : values) {
+      AppendInt(value);
+    }
+  }
+
+  // A string is ended with '\0', so the concatenated strings can not be mistaken for each other.
+  void AppendString(const std::string &str) {
+    AppendInt(kStringMark);
+    (void)strs_.append(str);
+    strs_.push_back('\0');
+    Mix(std::hash<std::string_view>{}(str));
+  }
+
+  // The scalars, strings, types and the sequences of them are kept as the value, and the other values such as the
+  // tensors, whose operator== compares the identity, are kept as the string.
+  void AppendValue(const ValuePtr &value);
+
+  uint64_t hash() const { return hash_; }
+
+  bool operator==(const OpCacheKey &other) const;
+  bool operator!=(const OpCacheKey &other) const { return !(*this == other); }
+
+ private:
+  friend class OpCacheKeyMatcher;
+
+  static constexpr uint64_t kSeed = 0xcbf29ce484222325ULL;
+  // No shape dim, dtype or index is so small, so the marks never clash with them.
+  static constexpr int64_t kStringMark = std::numeric_limits<int64_t>::min();
+  static constexpr int64_t kValueMark = kStringMark + 1;
+
+  // The multiply-xorshift of splitmix64, so that the integers differing in a few low bits are still spread well.
+  void Mix(uint64_t value) {
+    hash_ ^= value + 0x9e3779b97f4a7c15ULL + (hash_ << 6) + (hash_ >> 2);
+    hash_ = (hash_ ^ (hash_ >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash_ = (hash_ ^ (hash_ >> 27)) * 0x94d049bb133111ebULL;
+    hash_ ^= hash_ >> 31;
+  }
+
+  uint64_t hash_{kSeed};
+  std::vector<int64_t> ints_;
+  std::vector<ValuePtr> values_;
+  std::string strs_;
+};
+
+// Match the parts appended in the order they are built against a key built before, with the same interface as
+// OpCacheKey. The parts are compared one by one as they come and nothing is hashed or copied, so an op can be checked
+// against the cached key of the last run without the fingerprint and the table probe. Once a part differs the rest are
+// skipped.
+class BACKEND_EXPORT OpCacheKeyMatcher {
+ public:
+  explicit OpCacheKeyMatcher(const OpCacheKey *key) : key_(key), matched_(key != nullptr) {}
+  ~OpCacheKeyMatcher() = default;
+
+  void Clear() {
+    matched_ = key_ != nullptr;
+    int_pos_ = 0;
+    value_pos_ = 0;
+    str_pos_ = 0;
+  }
+
+  void AppendInt(int64_t value) {
+    if (!matched_) {
+      return;
+    }
+    matched_ = int_pos_ < key_->ints_.size() && key_->ints_[int_pos_] == value;
+    ++int_pos_;
+  }
+
+  void AppendInts(const std::vector<int64_t> &values) {
+    AppendInt(SizeToLong(values.size()));
+    for (auto value : values) {
+      AppendInt(value);
+    }
+  }
+
+  void AppendString(const std::string &str) {
+    AppendInt(OpCacheKey::kStringMark);
+    if (!matched_) {
+      return;
+    }
+    const auto &strs = key_->strs_;
+    matched_ = str_pos_ + str.size() < strs.size() && strs.compare(str_pos_, str.size(), str) == 0 &&
+               strs[str_pos_ + str.size()] == '\0';
+    str_pos_ += str.size() + 1;
+  }
+
+  void AppendValue(const ValuePtr &value);
+
+  // Whether the parts appended since Clear() make up the whole key.
+  bool Matched() const {
+    return matched_ && int_pos_ == key_->ints_.size() && value_pos_ == key_->values_.size() &&
+           str_pos_ == key_->strs_.size();
+  }
+
+ private:
+  const OpCacheKey *key_;
+  bool matched_;
+  size_t int_pos_{0};
+  size_t value_pos_{0};
+  size_t str_pos_{0};
+};
+}  // namespace pynative
+}  // namespace mindspore
+#endif  // MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_OP_CACHE_KEY_H_
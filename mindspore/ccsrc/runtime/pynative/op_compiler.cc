@@ -95,7 +95,7 @@ void SetIgnoreSyncHostToDeviceList(const SimpleGraphPtr &simple_graph) {
 }
 }  // namespace
 
-OpCompiler::OpCompiler() {
+OpCompiler::OpCompiler() : handles_(1 << kHandleBits) {
   session_ = session::SessionFactory::Get().Create(kSessionBasic);
   for (size_t i = 0; i < kNumberTypeEnd; i++) {
     (void)kNumStrCache.emplace_back(std::to_string(i));
@@ -149,20 +149,143 @@ void OpCompiler::AssignStreamIdForSingleOpGraph(const KernelGraphPtr &graph, uin
   }
 }
 
+size_t OpCompilerCache::Probe(const OpCacheKey &key, bool *found) const {
+  const size_t mask = slots_.size() - 1;
+  size_t free_index = slots_.size();
+  // There is always an empty slot as the load factor is kept below one half, so the probing ends.
+  for (size_t index = key.hash() & mask;; index = (index + 1) & mask) {
+    const auto &slot = slots_[index];
+    if (slot.info == nullptr) {
+      if (!slot.erased) {
+        *found = false;
+        return free_index != slots_.size() ? free_index : index;
+      }
+      if (free_index == slots_.size()) {
+        free_index = index;
+      }
+      continue;
+    }
+    if (slot.hash == key.hash() && slot.info->cache_key_ == key) {
+      *found = true;
+      return index;
+    }
+  }
+}
+
+void OpCompilerCache::Rehash(size_t capacity) {
+  auto old_slots = std::move(slots_);
+  slots_ = std::vector<Slot>(capacity);
+  erased_num_ = 0;
+  const size_t mask = capacity - 1;
+  for (auto &old_slot : old_slots) {
+    if (old_slot.info == nullptr) {
+      continue;
+    }
+    size_t index = old_slot.hash & mask;
+    while (slots_[index].info != nullptr) {
+      index = (index + 1) & mask;
+    }
+    slots_[index].hash = old_slot.hash;
+    slots_[index].info = std::move(old_slot.info);
+  }
+}
+
+OpCompilerInfoPtr OpCompilerCache::Find(const OpCacheKey &key) const {
+  if (size_ == 0) {
+    return nullptr;
+  }
+  bool found = false;
+  auto index = Probe(key, &found);
+  return found ? slots_[index].info : nullptr;
+}
+
+void OpCompilerCache::Insert(const OpCompilerInfoPtr &op_compiler_info) {
+  MS_EXCEPTION_IF_NULL(op_compiler_info);
+  if (slots_.empty()) {
+    Rehash(kInitialCapacity);
+  } else if ((size_ + erased_num_ + 1) * 2 > slots_.size()) {
+    // Grow if the table is filled by the live entries, otherwise the tombstones are cleaned in place.
+    Rehash((size_ + 1) * 4 > slots_.size() ? slots_.size() * 2 : slots_.size());
+  }
+  const auto &key = op_compiler_info->cache_key_;
+  bool found = false;
+  auto &slot = slots_[Probe(key, &found)];
+  if (!found) {
+    if (slot.erased) {
+      --erased_num_;
+    }
+    ++size_;
+  }
+  slot.hash = key.hash();
+  slot.info = op_compiler_info;
+  slot.erased = false;
+}
+
+void OpCompilerCache::Erase(const OpCacheKey &key) {
+  if (size_ == 0) {
+    return;
+  }
+  bool found = false;
+  auto &slot = slots_[Probe(key, &found)];
+  if (!found) {
+    return;
+  }
+  slot.info = nullptr;
+  slot.erased = true;
+  --size_;
+  ++erased_num_;
+}
+
+void OpCompilerCache::Clear() {
+  slots_.clear();
+  size_ = 0;
+  erased_num_ = 0;
+}
+
+OpCompiler::OpCompilerHandle &OpCompiler::GetHandle(const Primitive *prim) {
+  // Fibonacci hashing, so the addresses of the primitives, which differ in the middle bits, spread over the slots.
+  constexpr uint64_t kGoldenRatio = 0x9e3779b97f4a7c15ULL;
+  constexpr size_t kAddressBits = 64;
+  auto address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(prim));
+  return handles_[(address * kGoldenRatio) >> (kAddressBits - kHandleBits)];
+}
+
+void OpCompiler::ClearHandles(const OpCompilerInfoPtr &op_compiler_info) {
+  for (auto &handle : handles_) {
+    if (op_compiler_info == nullptr || handle.info == op_compiler_info) {
+      handle = OpCompilerHandle();
+    }
+  }
+}
+
 OpCompilerInfoPtr OpCompiler::Compile(const session::BackendOpRunInfoPtr &op_run_info, bool *single_op_cache_hit,
                                       const std::string &device_name, const uint32_t &device_id) {
   MS_EXCEPTION_IF_NULL(op_run_info);
-  const auto &graph_info = GetSingleOpGraphInfo(op_run_info->base_op_run_info, op_run_info->op_prim);
-  const auto &iter = op_compiler_infos_.find(graph_info);
+  const auto &op_info = op_run_info->base_op_run_info;
+  const auto &op_prim = op_run_info->op_prim;
+  MS_EXCEPTION_IF_NULL(op_prim);
+  // The ops whose cache is erased after the run keep no handle, as their key does not cover the inputs.
+  auto &handle = GetHandle(op_prim.get());
+  if (!op_info.need_earse_cache && handle.prim == op_prim.get() && handle.info != nullptr &&
+      MatchSingleOpCacheKey(op_info, op_prim, handle.info->cache_key_)) {
+    *single_op_cache_hit = true;
+    return handle.info;
+  }
+
+  GetSingleOpCacheKey(op_info, op_prim, &key_buffer_);
   // Check if the graph cache exists.
-  if (iter != op_compiler_infos_.end()) {
-    MS_EXCEPTION_IF_NULL(iter->second);
-    const auto &op_compiler_info = iter->second;
-    MS_EXCEPTION_IF_NULL(op_compiler_info);
+  auto cached_info = op_compiler_infos_.Find(key_buffer_);
+  if (cached_info != nullptr) {
     *single_op_cache_hit = true;
-    return iter->second;
+    if (!op_info.need_earse_cache) {
+      handle = {op_prim.get(), cached_info};
+    }
+    return cached_info;
   }
 
+  // The readable key is only needed by the logs and the profiler, so it is built when the cache misses.
+  auto cache_key = key_buffer_;
+  const auto &graph_info = GetSingleOpGraphInfo(op_run_info->base_op_run_info, op_run_info->op_prim);
   MS_LOG(INFO) << "Run Op cache miss " << graph_info;
   runtime::ProfilerRecorder profiler(runtime::ProfilerModule::kPynative, runtime::ProfilerEvent::kPyNativeOpCompile,
                                      graph_info, true);
@@ -228,8 +351,13 @@ OpCompilerInfoPtr OpCompiler::Compile(const session::BackendOpRunInfoPtr &op_run
     graph_info, graph->graph_id(), graph, device_context, op_run_info->base_op_run_info.need_earse_cache,
     need_refresh_abstract, outputs_with_index, outputs_tensor_num, outputs_padding_type, std::move(simple_graph));
 
+  op_compiler_info->cache_key_ = std::move(cache_key);
+
   graph->set_graph_info(graph_info);
-  op_compiler_infos_[graph_info] = op_compiler_info;
+  op_compiler_infos_.Insert(op_compiler_info);
+  if (!op_info.need_earse_cache) {
+    handle = {op_prim.get(), op_compiler_info};
+  }
   return op_compiler_info;
 }
 
@@ -427,9 +555,108 @@ std::string OpCompiler::GetSingleOpGraphInfo(const pynative::BaseOpRunInfo &op_i
   return graph_info;
 }
 
-void OpCompiler::ClearOpCache(const GraphInfo &graph_info) { (void)op_compiler_infos_.erase(graph_info); }
+void OpCompiler::GetSingleOpCacheKey(const pynative::BaseOpRunInfo &op_info, const PrimitivePtr &op_prim,
+                                     OpCacheKey *key) const {
+  AppendSingleOpCacheKey(op_info, op_prim, key);
+}
+
+bool OpCompiler::MatchSingleOpCacheKey(const pynative::BaseOpRunInfo &op_info, const PrimitivePtr &op_prim,
+                                       const OpCacheKey &key) const {
+  OpCacheKeyMatcher matcher(&key);
+  AppendSingleOpCacheKey(op_info, op_prim, &matcher);
+  return matcher.Matched();
+}
 
-void OpCompiler::ClearAllCache() { op_compiler_infos_.clear(); }
+template <typename Key>
+void OpCompiler::AppendSingleOpCacheKey(const pynative::BaseOpRunInfo &op_info, const PrimitivePtr &op_prim,
+                                        Key *key) const {
+  MS_EXCEPTION_IF_NULL(op_prim);
+  MS_EXCEPTION_IF_NULL(key);
+  if (op_info.expanded_input_values.size() != op_info.input_types.size()) {
+    MS_LOG(EXCEPTION) << "Input tensors size " << op_info.expanded_input_values.size()
+                      << " should be equal to tensors mask size " << op_info.input_types.size();
+  }
+  key->Clear();
+  key->AppendString(op_info.device_target);
+  key->AppendInt(op_info.use_dynamic_shape_process ? 1 : 0);
+  key->AppendString(op_prim->name());
+  bool has_hidden_side_effect;
+  {
+    PrimitiveReadLock read_lock(op_prim->shared_mutex());
+    if (op_info.need_earse_cache) {
+      return;
+    }
+    has_hidden_side_effect = op_prim->HasAttr(GRAPH_FLAG_SIDE_EFFECT_HIDDEN);
+    // The value of the attribute affects the operator selection
+    for (const auto &[attr_name, attr_value] : op_prim->attrs()) {
+      if (kExcludedAttr.find(attr_name) != kExcludedAttr.end()) {
+        continue;
+      }
+      MS_EXCEPTION_IF_NULL(attr_value);
+      key->AppendValue(attr_value);
+    }
+  }
+
+  const auto &depend_list = GetDependList(op_info, op_prim);
+  for (size_t index = 0; index < op_info.expanded_input_values.size(); ++index) {
+    auto const &value = op_info.expanded_input_values[index];
+    MS_EXCEPTION_IF_NULL(value);
+    key->AppendInt(static_cast<int64_t>(op_info.input_types[index]));
+    if (!value->isa<tensor::BaseTensor>()) {
+      key->AppendValue(value);
+      continue;
+    }
+    const auto &input_tensor = value->cast<tensor::BaseTensorPtr>();
+    MS_EXCEPTION_IF_NULL(input_tensor);
+    if (op_info.use_dynamic_shape_process) {
+      key->AppendInt(SizeToLong(input_tensor->shape().size()));
+    } else if (input_tensor->base_shape_ptr() != nullptr) {
+      key->AppendString(input_tensor->base_shape_ptr()->ToString());
+    } else {
+      key->AppendInts(input_tensor->shape());
+    }
+    key->AppendInt(static_cast<int64_t>(input_tensor->data_type()));
+    // In the case of the same shape, but dtype and format are inconsistent
+    auto tensor_addr = input_tensor->device_address();
+    if (tensor_addr != nullptr && !has_hidden_side_effect) {
+      auto p_address = std::dynamic_pointer_cast<device::DeviceAddress>(tensor_addr);
+      MS_EXCEPTION_IF_NULL(p_address);
+      key->AppendInt(static_cast<int64_t>(p_address->address_common()->format_));
+      key->AppendString(p_address->padding_type());
+    }
+    if (op_info.input_types[index] == InputType::kConstant || depend_list.find(index) != depend_list.end()) {
+      key->AppendString(common::AnfAlgo::GetTensorValueString(input_tensor));
+    }
+  }
+
+  key->AppendInt(SizeToLong(op_info.stream_id));
+  // Operator with hidden side effect.
+  if (has_hidden_side_effect) {
+    key->AppendInt(static_cast<int64_t>(op_info.py_prim_id_));
+  }
+
+#ifdef ENABLE_D
+  // Ascend special info.
+  const auto &ascend_special_info = GetGraphInfoForAscendSpecial(op_info, op_prim, "");
+  if (!ascend_special_info.empty()) {
+    key->AppendString(ascend_special_info);
+  }
+#endif
+}
+
+void OpCompiler::ClearOpCache(const OpCompilerInfoPtr &op_compiler_info) {
+  MS_EXCEPTION_IF_NULL(op_compiler_info);
+  op_compiler_infos_.Erase(op_compiler_info->cache_key_);
+  // The ops erased after every run have no handle.
+  if (!op_compiler_info->need_erase_) {
+    ClearHandles(op_compiler_info);
+  }
+}
+
+void OpCompiler::ClearAllCache() {
+  op_compiler_infos_.Clear();
+  ClearHandles(nullptr);
+}
 
 void OpCompiler::UpdateRefNodeOutputDeviceAddress(const KernelGraphPtr &graph) {
   MS_EXCEPTION_IF_NULL(graph);
@@ -28,6 +28,7 @@
 #include "backend/common/session/session_basic.h"
 #include "runtime/hardware/device_context.h"
 #include "runtime/pynative/ir_converter.h"
+#include "runtime/pynative/op_cache_key.h"
 
 namespace mindspore {
 using device::DeviceContext;
@@ -62,10 +63,45 @@ struct OpCompilerInfo {
   const std::vector<size_t> graph_outputs_tensor_num_;
   const std::vector<std::string> graph_outputs_padding_type_;
   const SimpleGraphPtr simple_graph_;
+  // The key in the op compiler cache, with which the cache entry is erased without building the key again.
+  OpCacheKey cache_key_;
   alignas(kAlignSize) std::atomic<bool> ready_{true};
 };
 using OpCompilerInfoPtr = std::shared_ptr<OpCompilerInfo>;
 
+// A flat open addressing hash table from the op cache key to the op compiler info, probed linearly.
+// The slots only hold the fingerprint and the info, and the full key is compared with the one kept in the info when the
+// fingerprint matches, so a hit costs one or two cache lines instead of hashing and comparing a long string.
+class BACKEND_EXPORT OpCompilerCache {
+ public:
+  OpCompilerCache() = default;
+  ~OpCompilerCache() = default;
+
+  OpCompilerInfoPtr Find(const OpCacheKey &key) const;
+  // Insert the info with its cache_key_, the old info of the same key is replaced.
+  void Insert(const OpCompilerInfoPtr &op_compiler_info);
+  void Erase(const OpCacheKey &key);
+  void Clear();
+  size_t size() const { return size_; }
+
+ private:
+  struct Slot {
+    uint64_t hash{0};
+    OpCompilerInfoPtr info{nullptr};
+    // An erased slot is kept as a tombstone, so that the probing of the keys behind it goes on.
+    bool erased{false};
+  };
+  static constexpr size_t kInitialCapacity = 64;
+
+  // Return the slot of the key, or the first free slot on its probing path if the key is not found.
+  size_t Probe(const OpCacheKey &key, bool *found) const;
+  void Rehash(size_t capacity);
+
+  std::vector<Slot> slots_;
+  size_t size_{0};
+  size_t erased_num_{0};
+};
+
 // FuncGraph, Backend and GraphCompiler correspond one-to-one,
 // and GraphCompiler stores the compilation cache of operators.
 // When the graph structure changes, the front-end will send multiple graphs,
@@ -81,15 +117,24 @@ class BACKEND_EXPORT OpCompiler {
 
   // Clear op cache in dynamic scenes.
   // Otherwise, the operator cache will keep growing, resulting in insufficient memory.
-  void ClearOpCache(const mindspore::GraphInfo &graph_info);
+  void ClearOpCache(const OpCompilerInfoPtr &op_compiler_info);
 
   // Accumulate a certain number of operators,
   // and then compile the operators in parallel to improve compilation efficiency.
   void KernelBuild(const OpCompilerInfoPtr &op_compiler_info, const DeviceContext *device_context,
                    bool is_dynamic_shape = false) const;
 
+  // The readable form of the cache key, which is only built for the logs and the profiler when the cache misses.
   std::string GetSingleOpGraphInfo(const pynative::BaseOpRunInfo &op_info, const PrimitivePtr &op_prim) const;
 
+  // Build the structural cache key of the op, which covers the same information as GetSingleOpGraphInfo.
+  void GetSingleOpCacheKey(const pynative::BaseOpRunInfo &op_info, const PrimitivePtr &op_prim,
+                           OpCacheKey *key) const;
+
+  // Whether the op makes up the given cache key, checked part by part without building the key.
+  bool MatchSingleOpCacheKey(const pynative::BaseOpRunInfo &op_info, const PrimitivePtr &op_prim,
+                             const OpCacheKey &key) const;
+
   // Clear anf resources before process exit.
   void ClearAllCache();
 
@@ -104,9 +149,28 @@ class BACKEND_EXPORT OpCompiler {
   KernelGraphPtr GenerateKernelGraph(const session::BackendOpRunInfoPtr &op_run_info,
                                      const device::DeviceContext *device_context) const;
   void AssignStreamIdForSingleOpGraph(const KernelGraphPtr &graph, uint32_t stream_id);
+  // Append the parts of the cache key to an OpCacheKey, or to an OpCacheKeyMatcher.
+  template <typename Key>
+  void AppendSingleOpCacheKey(const pynative::BaseOpRunInfo &op_info, const PrimitivePtr &op_prim, Key *key) const;
+
+  // The op compiler info last returned for a primitive. An op is mostly run again by the same primitive with the same
+  // inputs, so it is matched against the key of the handle first, which skips the fingerprint and the table probe.
+  struct OpCompilerHandle {
+    const Primitive *prim{nullptr};
+    OpCompilerInfoPtr info{nullptr};
+  };
+  static constexpr size_t kHandleBits = 8;
+  OpCompilerHandle &GetHandle(const Primitive *prim);
+  // Clear the handles of the info, or all the handles if it is null.
+  void ClearHandles(const OpCompilerInfoPtr &op_compiler_info);
+
   // All operators shared the same session.
   session::SessionPtr session_;
-  mindspore::HashMap<mindspore::GraphInfo, OpCompilerInfoPtr> op_compiler_infos_;
+  OpCompilerCache op_compiler_infos_;
+  // Reused by every Compile, so that building the key of a cache hit does not allocate.
+  OpCacheKey key_buffer_;
+  // Indexed by the hash of the primitive address, a primitive taking the slot of another one only costs a miss.
+  std::vector<OpCompilerHandle> handles_;
 };
 }  // namespace pynative
 using OpCompilerInfoPtr = pynative::OpCompilerInfoPtr;
@@ -29,6 +29,7 @@ constexpr char kOffloadPath[] = "./offload/";
 constexpr char kOffloadParam[] = "";
 constexpr size_t kAioBlockSize = 1 << 20;
 constexpr size_t kAioQueueDepth = 1024;
+constexpr size_t kPrefetchKernelNum = 2;
 constexpr size_t kGBToByte = 1024 << 20;
 constexpr float kMemRetentionTate = 0.2f;
 }  // namespace
@@ -94,6 +95,10 @@ void OffloadContext::set_aio_block_size(size_t aio_block_size) { aio_block_size_
 
 void OffloadContext::set_aio_queue_depth(size_t aio_queue_depth) { aio_queue_depth_ = aio_queue_depth; }
 
+void OffloadContext::set_prefetch_kernel_num(size_t prefetch_kernel_num) {
+  prefetch_kernel_num_ = prefetch_kernel_num;
+}
+
 void OffloadContext::set_enable_pinned_mem(bool enable_pinned_mem) { enable_pinned_mem_ = enable_pinned_mem; }
 
 void OffloadContext::set_auto_offload(bool auto_offload) { auto_offload_ = auto_offload; }
@@ -113,6 +118,7 @@ OffloadContext::OffloadContext()
       enable_aio_(true),
       aio_block_size_(kAioBlockSize),
       aio_queue_depth_(kAioQueueDepth),
+      prefetch_kernel_num_(kPrefetchKernelNum),
       enable_pinned_mem_(true),
       auto_offload_(true),
       host_mem_block_size_(kGBToByte),
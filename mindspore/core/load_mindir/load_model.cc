@@ -20,10 +20,12 @@
 #include <string>
 #include <memory>
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <stack>
 #include <list>
+#include <thread>
 #include <utility>
 #include <nlohmann/json.hpp>
 #include "mindspore/core/ops/structure_ops.h"
@@ -38,13 +40,16 @@
 #include "ir/functor.h"
 #include "ops/primitive_c.h"
 #include "abstract/abstract_value.h"
+#include "abstract/utils.h"
 #include "abstract/ops/primitive_infer_map.h"
 #include "utils/hash_map.h"
 #include "utils/log_adapter.h"
 #include "utils/check_convert_utils.h"
+#include "utils/ms_utils.h"
 #include "utils/ms_utils_secure.h"
 #include "abstract/abstract_function.h"
 #include "load_mindir/infer_mindir.h"
+#include "load_mindir/mapped_tensor_data.h"
 #include "include/common/debug/common.h"
 #include "proto/mind_ir.pb.h"
 #include "google/protobuf/io/zero_copy_stream_impl.h"
@@ -57,6 +62,8 @@ namespace {
 static constexpr char kConstantValueNode[] = "Constant";
 static constexpr char kQuantParam[] = "quant_param";
 static constexpr char kGraphInputQuantParam[] = "graph_input_quant_param";
+// Set to 1 to map the external data files of MindIR instead of reading them, see MindIRLoader::set_mmap_external_data.
+static constexpr char kEnvMmapExternalData[] = "MS_MINDIR_MMAP_EXTERNAL_DATA";
 
 enum ParseForm : int {
   FORM_PARSE_TYPE = 0,
@@ -341,6 +348,7 @@ class MSANFModelParser {
   void SetMindIRDecKey(const unsigned char *dec_key) { mindir_dec_key_ = dec_key; }
   void SetMindIRKeySize(size_t size) { mindir_key_size_ = size; }
   void SetMindIRDecMode(const std::string &dec_mode) { mindir_dec_mode_ = dec_mode; }
+  void SetMmapExternalData(bool mmap_external_data) { mmap_external_data_ = mmap_external_data; }
 
  private:
   void TrytoBuildCNodeAbstract();
@@ -364,6 +372,11 @@ class MSANFModelParser {
   abstract::AbstractScalarPtr BuildAbstractScalar(const mind_ir::AttributeProto &attr_proto) const;
   bool SetValueForTopGraphParameter(const FuncGraphPtr &topGraph, const std::map<std::string, ValuePtr> &weights);
   bool GetTensorDataFromExternal(const mind_ir::TensorProto &tensor_proto, const tensor::TensorPtr &tensor_info);
+  bool UseMappedExternalData() const;
+  MappedFilePtr GetMappedFile(const std::string &location);
+  tensor::TensorPtr GenerateMappedTensor(const mind_ir::TensorProto &attr_tensor, TypeId data_type,
+                                         const ShapeVector &shape);
+  bool MaterializeExternalData();
   bool BuildInputForFuncGraph(const ParameterPtr &node, const mind_ir::ValueInfoProto &value_proto);
   abstract::AbstractTensorPtr GetAbsTensorFromTensorProto(const mind_ir::TensorProto &tensor_proto);
   CNodePtr BuildCNodeForFuncGraph(const FuncGraphPtr &outputFuncGraph, const mind_ir::NodeProto &node_proto);
@@ -415,6 +428,18 @@ class MSANFModelParser {
   std::string mindir_dec_mode_;
   bool little_endian_ = common::IsLittleByteOrder();
   std::map<std::string, std::unique_ptr<Byte[]>> tenor_data_;
+  // Map the external data files instead of reading them, and create the parameters pointing into the mappings.
+  bool mmap_external_data_{false};
+  std::map<std::string, MappedFilePtr> mapped_files_;
+  // The copies of the external data of the parameters, which are done in parallel after all parameters are built.
+  struct ExternalDataCopy {
+    tensor::TensorPtr tensor;
+    uint8_t *dst;
+    const uint8_t *src;
+    size_t size;
+  };
+  bool defer_external_copy_{false};
+  std::vector<ExternalDataCopy> external_data_copies_;
   bool is_kernel_graph_{false};
   std::list<std::pair<const CNodePtr, const mind_ir::AttributeProto *>> node_abstract_protos_;
 };
@@ -514,9 +539,14 @@ tensor::TensorPtr MSANFModelParser::GenerateTensorPtrFromTensorProto(const mind_
     shape.push_back(attr_tensor.dims(i));
   }
   tensor::TensorPtr tensor = nullptr;
+  bool is_mapped = false;
   if (!attr_tensor.has_compression_type() ||
       attr_tensor.compression_type() == mind_ir::TensorProto_CompressionType_NO_COMPRESSION) {
-    tensor = std::make_shared<tensor::Tensor>(kDefaultValueSwitchMap[attr_tensor_type], shape);
+    tensor = GenerateMappedTensor(attr_tensor, kDefaultValueSwitchMap[attr_tensor_type], shape);
+    is_mapped = tensor != nullptr;
+    if (!is_mapped) {
+      tensor = std::make_shared<tensor::Tensor>(kDefaultValueSwitchMap[attr_tensor_type], shape);
+    }
   } else {
     auto compression_type = static_cast<TensorCompressionType>(static_cast<int>(attr_tensor.compression_type()));
     size_t data_size = 0;
@@ -543,7 +573,7 @@ tensor::TensorPtr MSANFModelParser::GenerateTensorPtrFromTensorProto(const mind_
       MS_LOG(ERROR) << "Failed to copy data from tensor proto.";
       return nullptr;
     }
-  } else if (attr_tensor.has_external_data()) {
+  } else if (attr_tensor.has_external_data() && !is_mapped) {
     auto ret = GetTensorDataFromExternal(attr_tensor, tensor);
     if (!ret) {
       MS_LOG(ERROR) << "Failed to get external data from tensor proto.";
@@ -937,6 +967,13 @@ bool MSANFModelParser::GetTensorDataFromExternal(const mind_ir::TensorProto &ten
   auto it = tenor_data_.find(tensor_proto.external_data().location());
   if (it != tenor_data_.end()) {
     data = it->second.get();
+  } else if (UseMappedExternalData()) {
+    // Only the pages of the tensors which can not be mapped are read.
+    auto mapped_file = GetMappedFile(tensor_proto.external_data().location());
+    if (mapped_file == nullptr) {
+      return false;
+    }
+    data = mapped_file->data();
   } else {
     std::string file = mindir_path_ + "/" + tensor_proto.external_data().location();
     if (mindir_dec_key_ != nullptr) {
@@ -986,6 +1023,16 @@ bool MSANFModelParser::GetTensorDataFromExternal(const mind_ir::TensorProto &ten
     return true;
   }
 
+  if (defer_external_copy_) {
+    if (LongToSize(tensor_proto.external_data().length()) > LongToSize(tensor_info->data().nbytes())) {
+      MS_LOG(ERROR) << "The external data of " << tensor_proto.name() << " is larger than the tensor.";
+      return false;
+    }
+    external_data_copies_.push_back({tensor_info, tensor_data_buf, data + tensor_proto.external_data().offset(),
+                                     LongToSize(tensor_proto.external_data().length())});
+    return true;
+  }
+
   auto ret =
     common::huge_memcpy(tensor_data_buf, tensor_info->data().nbytes(), data + tensor_proto.external_data().offset(),
                         LongToSize(tensor_proto.external_data().length()));
@@ -996,6 +1043,100 @@ bool MSANFModelParser::GetTensorDataFromExternal(const mind_ir::TensorProto &ten
   return true;
 }
 
+bool MSANFModelParser::UseMappedExternalData() const {
+#ifdef _WIN32
+  return false;
+#else
+  // The encrypted data has to be decrypted into the memory anyway.
+  return mmap_external_data_ && mindir_dec_key_ == nullptr;
+#endif
+}
+
+MappedFilePtr MSANFModelParser::GetMappedFile(const std::string &location) {
+  auto iter = mapped_files_.find(location);
+  if (iter != mapped_files_.end()) {
+    return iter->second;
+  }
+  auto mapped_file = MappedFile::Map(mindir_path_ + "/" + location);
+  if (mapped_file == nullptr) {
+    return nullptr;
+  }
+  constexpr Byte is_little_endian = 1;
+  constexpr int byte_order_index = 0;
+  if ((mapped_file->data()[byte_order_index] == is_little_endian) ^ little_endian()) {
+    MS_LOG(ERROR) << "The byte order of export MindIr device and load MindIr device is not same!";
+    return nullptr;
+  }
+  (void)mapped_files_.emplace(location, mapped_file);
+  return mapped_file;
+}
+
+tensor::TensorPtr MSANFModelParser::GenerateMappedTensor(const mind_ir::TensorProto &attr_tensor, TypeId data_type,
+                                                         const ShapeVector &shape) {
+  if (!UseMappedExternalData() || attr_tensor.has_raw_data() || !attr_tensor.has_external_data()) {
+    return nullptr;
+  }
+  const auto &external_data = attr_tensor.external_data();
+  auto type_size = abstract::TypeIdSize(data_type);
+  auto offset = LongToSize(external_data.offset());
+  auto length = LongToSize(external_data.length());
+  // The tensor which is not aligned to its element or not filled by the data exactly is copied instead.
+  if (type_size == 0 || length == 0 || length != type_size * SizeOf(shape) || offset % type_size != 0) {
+    return nullptr;
+  }
+  auto mapped_file = GetMappedFile(external_data.location());
+  if (mapped_file == nullptr || offset > mapped_file->size() || length > mapped_file->size() - offset) {
+    return nullptr;
+  }
+  auto tensor_data = tensor::MakeTensorData<tensor::MappedTensorData>(data_type, shape, mapped_file, offset);
+  return std::make_shared<tensor::Tensor>(data_type, shape, tensor_data);
+}
+
+bool MSANFModelParser::MaterializeExternalData() {
+  if (external_data_copies_.empty()) {
+    return true;
+  }
+  // Split the large tensors, so that the threads are balanced.
+  constexpr size_t kCopyChunkSize = 64 << 20;
+  constexpr size_t kMaxCopyThreadNum = 8;
+  std::vector<ExternalDataCopy> chunks;
+  for (const auto &copy : external_data_copies_) {
+    for (size_t offset = 0; offset < copy.size; offset += kCopyChunkSize) {
+      auto chunk_size = std::min(kCopyChunkSize, copy.size - offset);
+      chunks.push_back({copy.tensor, copy.dst + offset, copy.src + offset, chunk_size});
+    }
+  }
+  external_data_copies_.clear();
+
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<bool> success{true};
+  auto copy_chunks = [&chunks, &next_chunk, &success]() {
+    for (size_t i = next_chunk.fetch_add(1); i < chunks.size(); i = next_chunk.fetch_add(1)) {
+      const auto &chunk = chunks[i];
+      if (common::huge_memcpy(chunk.dst, chunk.size, chunk.src, chunk.size) != EOK) {
+        success = false;
+      }
+    }
+  };
+  size_t thread_num = std::min({static_cast<size_t>(std::thread::hardware_concurrency()), kMaxCopyThreadNum,
+                                chunks.size()});
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_num; ++i) {
+    (void)threads.emplace_back(copy_chunks);
+  }
+  copy_chunks();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (!success) {
+    MS_LOG(ERROR) << "Build parameter occur memcpy_s error.";
+    return false;
+  }
+  MS_LOG(INFO) << "Copy the external data of parameters in " << chunks.size() << " chunks with " << thread_num
+               << " threads.";
+  return true;
+}
+
 bool MSANFModelParser::BuildInputForFuncGraph(const ParameterPtr &node, const mind_ir::ValueInfoProto &value_proto) {
   MS_EXCEPTION_IF_NULL(node);
 
@@ -1080,6 +1221,8 @@ bool MSANFModelParser::ImportParametersForGraph(const FuncGraphPtr &outputFuncGr
   }
 
   MS_LOG(INFO) << "All Parameters size is: " << importProto.parameter_size();
+  // The external data of the parameters is copied after all parameters are built, and before any node uses them.
+  defer_external_copy_ = true;
   for (int i = 0; i < importProto.parameter_size(); ++i) {
     const mind_ir::TensorProto &parameter_proto = importProto.parameter(i);
     if (is_kernel_graph_ && anfnode_build_map_.count(parameter_proto.name()) > 0) {
@@ -1087,9 +1230,16 @@ bool MSANFModelParser::ImportParametersForGraph(const FuncGraphPtr &outputFuncGr
     }
     if (!BuildParameterForFuncGraph(outputFuncGraph->add_parameter(), parameter_proto)) {
       MS_LOG(ERROR) << "Build parameter for funcgraph fail at index: " << i;
+      defer_external_copy_ = false;
+      external_data_copies_.clear();
       return false;
     }
   }
+  defer_external_copy_ = false;
+  if (!MaterializeExternalData()) {
+    MS_LOG(ERROR) << "Copy the external data of the parameters failed.";
+    return false;
+  }
   outputFuncGraph->set_fv_param_count(IntToSize(importProto.parameter_size()));
   return true;
 }
@@ -2599,6 +2749,7 @@ void InitModelParser(MSANFModelParser *model_parser, const MindIRLoader *loader)
   model_parser->SetMindIRDecKey(loader->dec_key());
   model_parser->SetMindIRKeySize(loader->key_len());
   model_parser->SetMindIRDecMode(loader->dec_mode());
+  model_parser->SetMmapExternalData(loader->mmap_external_data() || common::GetEnv(kEnvMmapExternalData) == "1");
 
   if (loader->is_lite()) {
     model_parser->SetLite();
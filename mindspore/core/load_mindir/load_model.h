@@ -75,6 +75,10 @@ class MS_CORE_API MindIRLoader {
   ~MindIRLoader() = default;
 
   void set_has_parallel_info(bool has_parallel_info) { has_parallel_info_ = has_parallel_info; }
+  // Map the external data files read-only and copy-on-write, and create the parameters pointing into the mappings,
+  // so that only the weights touched are read into the memory.
+  void set_mmap_external_data(bool mmap_external_data) { mmap_external_data_ = mmap_external_data; }
+  bool mmap_external_data() const { return mmap_external_data_; }
   void set_weights_value_map(const std::map<string, ValuePtr> &weights_value_map) {
     weights_value_map_ = weights_value_map;
   }
@@ -103,6 +107,7 @@ class MS_CORE_API MindIRLoader {
   bool inc_load_ = false;
   std::map<string, ValuePtr> weights_value_map_;
   bool has_parallel_info_ = false;
+  bool mmap_external_data_ = false;
   LayoutMap layout_map_;
 };
 MS_CORE_API FuncGraphPtr ConvertStreamToFuncGraph(const char *buf, const size_t buf_size, bool is_lite = false);
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "load_mindir/mapped_tensor_data.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "utils/log_adapter.h"
+#include "include/common/debug/common.h"
+
+namespace mindspore {
+std::shared_ptr<MappedFile> MappedFile::Map(const std::string &file_name) {
+#ifdef _WIN32
+  MS_LOG(INFO) << "Mapping the file is not supported on windows, file: " << file_name;
+  return nullptr;
+#else
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open file '" << file_name << "' failed, errno is: " << ErrnoToString(errno);
+    return nullptr;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    MS_LOG(ERROR) << "Get the size of file '" << file_name << "' failed or the file is empty.";
+    (void)close(fd);
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(file_stat.st_size);
+  // The pages are private and writable, so that the runtime can change the weights without touching the file.
+  void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  const int map_errno = errno;
+  // The mapping holds the file by itself.
+  (void)close(fd);
+  if (data == MAP_FAILED) {
+    MS_LOG(ERROR) << "Map file '" << file_name << "' failed, errno is: " << ErrnoToString(map_errno);
+    return nullptr;
+  }
+  MS_LOG(INFO) << "Map file '" << file_name << "' of " << size << " bytes.";
+  return std::shared_ptr<MappedFile>(new MappedFile(static_cast<uint8_t *>(data), size));
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+  if (data_ != nullptr && munmap(data_, size_) != 0) {
+    MS_LOG(ERROR) << "Unmap file failed, errno is: " << ErrnoToString(errno);
+  }
+#endif
+}
+}  // namespace mindspore
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CORE_LOAD_MINDIR_MAPPED_TENSOR_DATA_H
+#define MINDSPORE_CORE_LOAD_MINDIR_MAPPED_TENSOR_DATA_H
+
+#include <memory>
+#include <string>
+#include "ir/base_tensor.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+// A file mapped into the memory privately. The pages are read from the file when they are touched, and a written page
+// is copied on write, so the file is never changed.
+class MappedFile {
+ public:
+  // Return nullptr if the file can not be mapped, or the platform does not support it.
+  static std::shared_ptr<MappedFile> Map(const std::string &file_name);
+  ~MappedFile();
+
+  uint8_t *data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  MappedFile(uint8_t *data, size_t size) : data_(data), size_(size) {}
+  DISABLE_COPY_AND_ASSIGN(MappedFile);
+
+  uint8_t *data_{nullptr};
+  size_t size_{0};
+};
+using MappedFilePtr = std::shared_ptr<MappedFile>;
+
+namespace tensor {
+// The tensor data pointing into a mapped file, which keeps the file mapped while the tensor data is alive.
+template <typename T>
+class MappedTensorData : public TensorData {
+ public:
+  MappedTensorData(const ShapeVector &shape, const MappedFilePtr &file, size_t offset)
+      : ndim_(shape.size()), data_size_(SizeOf(shape)), file_(file), offset_(offset) {}
+
+  ~MappedTensorData() override = default;
+
+  ssize_t size() const override { return static_cast<ssize_t>(data_size_); }
+
+  ssize_t itemsize() const override { return static_cast<ssize_t>(sizeof(T)); }
+
+  ssize_t nbytes() const override { return size() * itemsize(); }
+
+  ssize_t ndim() const override { return static_cast<ssize_t>(ndim_); }
+
+  bool is_sub_data() const override { return false; }
+
+  bool has_sub_data() const override { return false; }
+
+  void *data() override { return file_->data() + offset_; }
+
+  const void *const_data() const override { return file_->data() + offset_; }
+
+  std::string ToString(TypeId type, const ShapeVector &shape, bool use_comma) const override {
+    TensorStringifier<T> stringifier{static_cast<const T *>(const_data()), data_size_, ndim_};
+    return stringifier.ToString(type, shape, use_comma);
+  }
+
+ private:
+  size_t ndim_{0};
+  size_t data_size_{0};
+  MappedFilePtr file_;
+  size_t offset_{0};
+};
+}  // namespace tensor
+}  // namespace mindspore
+#endif  // MINDSPORE_CORE_LOAD_MINDIR_MAPPED_TENSOR_DATA_H
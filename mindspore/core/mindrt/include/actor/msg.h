@@ -88,6 +88,9 @@ class MessageBase {
 
   // The id of remote function to call.
   uint32_t func_id_;
+
+  // The next message in the intrusive chain of MpscMailBox, owned by the mailbox.
+  MessageBase *next_{nullptr};
 };
 }  // namespace mindspore
 
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_POOL_H
+#define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "actor/msg.h"
+#include "mindapi/base/macros.h"
+
+namespace mindspore {
+// The message blocks are recycled through the free lists of the thread which allocates them. The block freed by
+// another thread, e.g. the receiver of the message, is pushed back to the lock-free remote list of its owner, and the
+// owner takes the remote blocks when its local free list is empty, so a sender keeps reusing its blocks no matter
+// which thread frees them. Sizes larger than the biggest size class fall back to the heap directly.
+class MS_CORE_API MessagePool {
+ public:
+  static void *Allocate(size_t size);
+  static void Free(void *ptr, size_t size) noexcept;
+  // The number of the messages which the current thread allocates from the heap instead of the free lists.
+  static size_t HeapAllocatedNum();
+};
+
+// The message whose memory comes from the MessagePool, used on the hot message path such as OpData and OpControl.
+class PooledMessage : public MessageBase {
+ public:
+  using MessageBase::MessageBase;
+  ~PooledMessage() override = default;
+
+  static void *operator new(size_t size) { return MessagePool::Allocate(size); }
+  static void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    try {
+      return MessagePool::Allocate(size);
+    } catch (...) {
+      return nullptr;
+    }
+  }
+  static void operator delete(void *ptr, size_t size) noexcept { MessagePool::Free(ptr, size); }
+  static void operator delete(void *ptr, size_t size, const std::nothrow_t &) noexcept { MessagePool::Free(ptr, size); }
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_POOL_H
@@ -24,6 +24,7 @@
 #include "actor/actor.h"
 #include "actor/log.h"
 #include "actor/actormgr.h"
+#include "actor/msg_pool.h"
 #include "async/apply.h"
 #include "async/future.h"
 
@@ -40,6 +41,26 @@ class MessageAsync : public MessageBase {
   MessageHandler handler;
 };
 
+// Call the member function of actor with the arguments stored in place, which avoids the allocation of
+// std::function and recycles the message memory through the MessagePool.
+template <typename T, typename Method, typename Tuple>
+class MessageAsyncCall : public PooledMessage {
+ public:
+  MessageAsyncCall(Method method, Tuple &&tuple)
+      : PooledMessage("Async", Type::KASYNC), method_(method), tuple_(std::move(tuple)) {}
+  ~MessageAsyncCall() override = default;
+  void Run(ActorBase *actor) override {
+    MINDRT_ASSERT(actor != nullptr);
+    T *t = static_cast<T *>(actor);
+    MINDRT_ASSERT(t != nullptr);
+    Apply(t, method_, static_cast<const Tuple &>(tuple_));
+  }
+
+ private:
+  Method method_;
+  Tuple tuple_;
+};
+
 namespace internal {
 
 template <typename R>
@@ -108,26 +129,20 @@ void Async(const AID &aid, void (T::*method)()) {
 
 template <typename T, typename Arg0, typename Arg1>
 void Async(const AID &aid, void (T::*method)(Arg0), Arg1 &&arg) {
-  std::function<void(ActorBase *)> handler = [method, arg](ActorBase *actor) {
-    MINDRT_ASSERT(actor != nullptr);
-    T *t = static_cast<T *>(actor);
-    MINDRT_ASSERT(t != nullptr);
-    (t->*method)(arg);
-  };
-  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
+  using Method = void (T::*)(Arg0);
+  using Tuple = std::tuple<typename std::decay<Arg1>::type>;
+  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsyncCall<T, Method, Tuple>(
+    method, Tuple(std::forward<Arg1>(arg))));
   MINDRT_OOM_EXIT(msg);
   (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
 }
 
 template <typename T, typename... Args0, typename... Args1>
 void Async(const AID &aid, void (T::*method)(Args0...), std::tuple<Args1...> &&tuple) {
-  std::function<void(ActorBase *)> handler = [method, tuple](ActorBase *actor) {
-    MINDRT_ASSERT(actor != nullptr);
-    T *t = static_cast<T *>(actor);
-    MINDRT_ASSERT(t != nullptr);
-    Apply(t, method, tuple);
-  };
-  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
+  using Method = void (T::*)(Args0...);
+  using Tuple = std::tuple<Args1...>;
+  auto msg =
+    std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsyncCall<T, Method, Tuple>(method, std::move(tuple)));
   MINDRT_OOM_EXIT(msg);
   (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
 }
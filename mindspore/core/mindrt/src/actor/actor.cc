@@ -112,7 +112,23 @@ void ActorBase::Run() {
     return ERRORCODE_SUCCESS;
   };
 
-  if (this->mailbox->TakeAllMsgsEachTime()) {
+  if (this->mailbox->TakeMsgChainEachTime()) {
+    while (auto msgs = mailbox->GetMsgChain()) {
+      while (msgs != nullptr) {
+        std::unique_ptr<MessageBase> msg(msgs);
+        msgs = msgs->next_;
+        msg->next_ = nullptr;
+        if (msgHandler(msg) == ACTOR_TERMINATED) {
+          // the rest msgs are dropped as the other mailboxes do
+          while (msgs != nullptr) {
+            std::unique_ptr<MessageBase> rest(msgs);
+            msgs = msgs->next_;
+          }
+          return;
+        }
+      }
+    }
+  } else if (this->mailbox->TakeAllMsgsEachTime()) {
     while (auto msgs = mailbox->GetMsgs()) {
       for (auto it = msgs->begin(); it != msgs->end(); ++it) {
         std::unique_ptr<MessageBase> &msg = *it;
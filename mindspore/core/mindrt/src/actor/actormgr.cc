@@ -26,6 +26,7 @@
 namespace mindspore {
 ActorMgr ActorMgr::actorMgr;
 std::map<std::string, std::shared_ptr<IOMgr>> ActorMgr::ioMgrs;
+bool ActorMgr::enable_mpsc_mailbox_ = false;
 
 std::shared_ptr<IOMgr> &ActorMgr::GetIOMgrRef(const std::string &protocol) {
   auto it = ioMgrs.find(protocol);
@@ -252,7 +253,12 @@ AID ActorMgr::Spawn(const ActorReference &actor, bool shareThread) {
   MS_LOG(DEBUG) << "ACTOR was spawned,a=" << actor->GetAID().Name().c_str();
 
   if (shareThread) {
-    auto mailbox = std::make_unique<NonblockingMailBox>();
+    std::unique_ptr<MailBox> mailbox;
+    if (enable_mpsc_mailbox_) {
+      mailbox = std::make_unique<MpscMailBox>();
+    } else {
+      mailbox = std::make_unique<NonblockingMailBox>();
+    }
     auto hook = std::make_unique<std::function<void()>>([actor]() {
       auto actor_mgr = actor->get_actor_mgr();
       if (actor_mgr != nullptr) {
@@ -49,6 +49,9 @@ class MS_CORE_API ActorMgr {
 
   ActorThreadPool *GetActorThreadPool() const { return inner_pool_; }
 
+  // Use the lock-free MpscMailBox instead of NonblockingMailBox for the actors spawned on the shared threads.
+  static void set_enable_mpsc_mailbox(bool enable_mpsc_mailbox) { enable_mpsc_mailbox_ = enable_mpsc_mailbox; }
+
   ActorMgr();
   ~ActorMgr();
 
@@ -105,6 +108,7 @@ class MS_CORE_API ActorMgr {
   std::string delegate;
   static ActorMgr actorMgr;
   static std::map<std::string, std::shared_ptr<IOMgr> > ioMgrs;
+  static bool enable_mpsc_mailbox_;
 };  // end of class ActorMgr
 };  // end of namespace mindspore
 #endif
@@ -70,6 +70,51 @@ std::list<std::unique_ptr<MessageBase>> *NonblockingMailBox::GetMsgs() {
   return ret;
 }
 
+MpscMailBox::~MpscMailBox() {
+  auto msg = head_.exchange(nullptr);
+  while (msg != nullptr) {
+    auto next = msg->next_;
+    delete msg;
+    msg = next;
+  }
+}
+
+int MpscMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
+  MessageBase *msgPtr = msg.release();
+  msgPtr->next_ = head_.load(std::memory_order_relaxed);
+  while (!head_.compare_exchange_weak(msgPtr->next_, msgPtr)) {
+  }
+  // only the producer who takes the released flag wakes up the actor
+  if (released_.load() && released_.exchange(false) && notifyHook) {
+    (*notifyHook.get())();
+  }
+  return 0;
+}
+
+MessageBase *MpscMailBox::Reverse(MessageBase *head) {
+  MessageBase *prev = nullptr;
+  while (head != nullptr) {
+    auto next = head->next_;
+    head->next_ = prev;
+    prev = head;
+    head = next;
+  }
+  return prev;
+}
+
+MessageBase *MpscMailBox::GetMsgChain() {
+  auto msgs = head_.exchange(nullptr);
+  if (msgs != nullptr) {
+    return Reverse(msgs);
+  }
+  released_ = true;
+  // a producer may have pushed before the flag is released, take the flag back to handle its msgs here
+  if (head_.load() != nullptr && released_.exchange(false)) {
+    return Reverse(head_.exchange(nullptr));
+  }
+  return nullptr;
+}
+
 int HQueMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
   bool empty = mailbox.Empty();
   MessageBase *msgPtr = msg.release();
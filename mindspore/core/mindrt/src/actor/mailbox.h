@@ -16,6 +16,7 @@
 
 #ifndef MINDSPORE_MAILBOX_H
 #define MINDSPORE_MAILBOX_H
+#include <atomic>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -32,13 +33,19 @@ class MailBox {
   virtual int EnqueueMessage(std::unique_ptr<MessageBase> msg) = 0;
   virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs() = 0;
   virtual std::unique_ptr<MessageBase> GetMsg() = 0;
+  // take all enqueued msgs as a chain linked by MessageBase::next_ in the arrival order, the caller owns the msgs.
+  virtual MessageBase *GetMsgChain() { return nullptr; }
   inline void SetNotifyHook(std::unique_ptr<std::function<void()>> &&hook) { notifyHook = std::move(hook); }
   inline bool TakeAllMsgsEachTime() const { return takeAllMsgsEachTime; }
+  inline bool TakeMsgChainEachTime() const { return takeMsgChainEachTime; }
 
  protected:
   // if this flag is true, GetMsgs() should be invoked to take all enqueued msgs each time, otherwise we can only get
   // one msg by GetMsg() each time.
   bool takeAllMsgsEachTime = true;
+  // if this flag is true, GetMsgChain() should be invoked to take all enqueued msgs each time, it takes precedence
+  // over takeAllMsgsEachTime.
+  bool takeMsgChainEachTime = false;
   std::unique_ptr<std::function<void()>> notifyHook;
 };
 
@@ -82,6 +89,28 @@ class NonblockingMailBox : public MailBox {
   bool released_ = true;
 };
 
+// The lock-free multi-producer single-consumer mailbox. The producers push the msgs to an intrusive stack, and the
+// consumer takes all of them with one exchange and reverses them into the arrival order, so no extra node is
+// allocated for each msg.
+class MpscMailBox : public MailBox {
+ public:
+  MpscMailBox() {
+    takeAllMsgsEachTime = false;
+    takeMsgChainEachTime = true;
+  }
+  virtual ~MpscMailBox();
+  int EnqueueMessage(std::unique_ptr<MessageBase> msg) override;
+  std::list<std::unique_ptr<MessageBase>> *GetMsgs() override { return nullptr; }
+  std::unique_ptr<MessageBase> GetMsg() override { return nullptr; }
+  MessageBase *GetMsgChain() override;
+
+ private:
+  static MessageBase *Reverse(MessageBase *head);
+
+  std::atomic<MessageBase *> head_{nullptr};
+  std::atomic_bool released_{true};
+};
+
 class HQueMailBox : public MailBox {
  public:
   HQueMailBox() { takeAllMsgsEachTime = false; }
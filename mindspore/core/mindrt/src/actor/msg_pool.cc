@@ -0,0 +1,222 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "actor/msg_pool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace mindspore {
+namespace {
+// size classes: 64, 128, 256, 512 bytes, including the block header
+constexpr size_t kMinBlockShift = 6;
+constexpr size_t kSizeClassNum = 4;
+// the max cached blocks of each size class on one thread, the others are returned to the heap
+constexpr size_t kMaxCachedBlockNum = 4096;
+
+class ThreadMessageCache;
+
+// Every pooled block starts with this header and the msg follows it. The owner is the cache the block is allocated
+// from, the block always goes back to the owner wherever it is freed.
+struct alignas(std::max_align_t) BlockHeader {
+  ThreadMessageCache *owner;
+  // valid only while the block is in a free list
+  BlockHeader *next;
+};
+constexpr size_t kHeaderSize = sizeof(BlockHeader);
+constexpr size_t kMaxMsgSize = (static_cast<size_t>(1) << (kMinBlockShift + kSizeClassNum - 1)) - kHeaderSize;
+
+// the messages may still be freed by the other thread local objects after the cache is released at thread exit
+thread_local bool thread_cache_destroyed = false;
+// the cache of the current thread, nullptr if the thread has never allocated a message
+thread_local ThreadMessageCache *current_cache = nullptr;
+// the messages allocated from the heap by the current thread
+thread_local size_t heap_allocated_num = 0;
+
+class ThreadMessageCache {
+ public:
+  ThreadMessageCache() = default;
+  ~ThreadMessageCache() = default;
+
+  void *Allocate(size_t index) {
+    if (heads_[index] == nullptr) {
+      DrainRemoteFree();
+    }
+    auto block = heads_[index];
+    if (block == nullptr) {
+      block = static_cast<BlockHeader *>(::operator new(BlockSize(index)));
+      block->owner = this;
+      ++heap_allocated_num;
+    } else {
+      heads_[index] = block->next;
+      --counts_[index];
+    }
+    return static_cast<void *>(block + 1);
+  }
+
+  // called by the owner thread only
+  void Free(BlockHeader *block, size_t index) {
+    if (counts_[index] >= kMaxCachedBlockNum) {
+      ::operator delete(static_cast<void *>(block));
+      return;
+    }
+    block->next = heads_[index];
+    heads_[index] = block;
+    ++counts_[index];
+  }
+
+  // called by the other threads, the block waits in a lock-free stack until the owner runs out of local blocks
+  void RemoteFree(BlockHeader *block, size_t index) {
+    auto head = remote_heads_[index].load(std::memory_order_relaxed);
+    do {
+      block->next = head;
+    } while (!remote_heads_[index].compare_exchange_weak(head, block, std::memory_order_release,
+                                                         std::memory_order_relaxed));
+  }
+
+  // return the local blocks to the heap when the owner thread exits, the remote ones are kept for the next owner
+  void ReleaseLocalBlocks() {
+    for (size_t i = 0; i < kSizeClassNum; ++i) {
+      while (heads_[i] != nullptr) {
+        auto block = heads_[i];
+        heads_[i] = block->next;
+        ::operator delete(static_cast<void *>(block));
+      }
+      counts_[i] = 0;
+    }
+  }
+
+  static size_t BlockSize(size_t index) { return static_cast<size_t>(1) << (kMinBlockShift + index); }
+
+ private:
+  void DrainRemoteFree() {
+    for (size_t i = 0; i < kSizeClassNum; ++i) {
+      auto block = remote_heads_[i].exchange(nullptr, std::memory_order_acquire);
+      while (block != nullptr) {
+        auto next = block->next;
+        Free(block, i);
+        block = next;
+      }
+    }
+  }
+
+  BlockHeader *heads_[kSizeClassNum]{nullptr};
+  size_t counts_[kSizeClassNum]{0};
+  std::atomic<BlockHeader *> remote_heads_[kSizeClassNum]{};
+};
+
+// The caches of the exited threads. The blocks still in flight are freed to them later, so they are handed over to
+// the new threads instead of being deleted.
+class RetiredCaches {
+ public:
+  static RetiredCaches &GetInstance() {
+    // never destructed, the threads may exit after the static objects are destroyed
+    static auto *instance = new RetiredCaches();
+    return *instance;
+  }
+
+  ThreadMessageCache *Adopt() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!caches_.empty()) {
+        auto cache = caches_.back();
+        caches_.pop_back();
+        return cache;
+      }
+    }
+    return new ThreadMessageCache();
+  }
+
+  void Retire(ThreadMessageCache *cache) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    caches_.push_back(cache);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<ThreadMessageCache *> caches_;
+};
+
+class ThreadCacheHolder {
+ public:
+  ThreadCacheHolder() : cache_(RetiredCaches::GetInstance().Adopt()) { current_cache = cache_; }
+  ~ThreadCacheHolder() {
+    current_cache = nullptr;
+    thread_cache_destroyed = true;
+    cache_->ReleaseLocalBlocks();
+    RetiredCaches::GetInstance().Retire(cache_);
+  }
+
+  ThreadMessageCache *cache() const { return cache_; }
+
+ private:
+  ThreadMessageCache *cache_;
+};
+
+inline size_t SizeClassIndex(size_t size) {
+  size_t index = 0;
+  while (ThreadMessageCache::BlockSize(index) < size) {
+    ++index;
+  }
+  return index;
+}
+
+ThreadMessageCache *GetThreadMessageCache() {
+  static thread_local ThreadCacheHolder holder;
+  return holder.cache();
+}
+}  // namespace
+
+void *MessagePool::Allocate(size_t size) {
+  if (size > kMaxMsgSize) {
+    ++heap_allocated_num;
+    return ::operator new(size);
+  }
+  if (thread_cache_destroyed) {
+    ++heap_allocated_num;
+    auto block = static_cast<BlockHeader *>(::operator new(size + kHeaderSize));
+    block->owner = nullptr;
+    return static_cast<void *>(block + 1);
+  }
+  return GetThreadMessageCache()->Allocate(SizeClassIndex(size + kHeaderSize));
+}
+
+void MessagePool::Free(void *ptr, size_t size) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  if (size > kMaxMsgSize) {
+    ::operator delete(ptr);
+    return;
+  }
+  auto block = static_cast<BlockHeader *>(ptr) - 1;
+  auto owner = block->owner;
+  if (owner == nullptr) {
+    ::operator delete(static_cast<void *>(block));
+    return;
+  }
+  auto index = SizeClassIndex(size + kHeaderSize);
+  if (owner == current_cache) {
+    owner->Free(block, index);
+  } else {
+    owner->RemoteFree(block, index);
+  }
+}
+
+size_t MessagePool::HeapAllocatedNum() { return heap_allocated_num; }
+}  // namespace mindspore
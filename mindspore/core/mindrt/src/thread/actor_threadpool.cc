@@ -24,6 +24,11 @@
 namespace mindspore {
 size_t ActorThreadPool::actor_queue_size_ = kMaxHqueueSize;
 
+namespace {
+// the actor worker running on the current thread, used to push the woken actors to the local deque
+thread_local ActorWorker *current_actor_worker = nullptr;
+}  // namespace
+
 void ActorWorker::CreateThread() { thread_ = std::make_unique<std::thread>(&ActorWorker::RunWithSpin, this); }
 
 void ActorWorker::RunWithSpin() {
@@ -39,6 +44,7 @@ void ActorWorker::RunWithSpin() {
   _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
   _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
 #endif
+  current_actor_worker = this;
   while (alive_) {
     // only run either local KernelTask or PoolQueue ActorTask
     if (RunLocalKernelTask() || RunQueueActorTask()) {
@@ -57,7 +63,20 @@ bool ActorWorker::RunQueueActorTask() {
   if (pool_ == nullptr) {
     return false;
   }
-  auto actor = reinterpret_cast<ActorThreadPool *>(pool_)->PopActorFromQueue();
+  auto pool = reinterpret_cast<ActorThreadPool *>(pool_);
+  ActorBase *actor = nullptr;
+  if (pool->schedule_mode() == kWorkStealingSchedule) {
+    // local deque first for cache locality, then the global queue, then the other workers
+    actor = local_actor_queue_.Pop();
+    if (actor == nullptr) {
+      actor = pool->PopActorFromQueue();
+    }
+    if (actor == nullptr) {
+      actor = StealActor();
+    }
+  } else {
+    actor = pool->PopActorFromQueue();
+  }
   if (actor == nullptr) {
     return false;
   }
@@ -66,6 +85,32 @@ bool ActorWorker::RunQueueActorTask() {
   return true;
 }
 
+bool ActorWorker::PushLocalActor(ActorBase *actor) {
+  if (!local_actor_queue_.IsInit()) {
+    return false;
+  }
+  return local_actor_queue_.Push(actor);
+}
+
+ActorBase *ActorWorker::StealActor() {
+  // xorshift32
+  steal_seed_ ^= steal_seed_ << 13;
+  steal_seed_ ^= steal_seed_ >> 17;
+  steal_seed_ ^= steal_seed_ << 5;
+  return reinterpret_cast<ActorThreadPool *>(pool_)->StealActorFromWorkers(this, steal_seed_);
+}
+
+void ActorWorker::StopThread() {
+  {
+    std::lock_guard<std::mutex> _l(mutex_);
+    alive_ = false;
+  }
+  cond_var_->notify_one();
+  if (thread_ != nullptr && thread_->joinable()) {
+    thread_->join();
+  }
+}
+
 bool ActorWorker::ActorActive() {
   if (status_ != kThreadIdle) {
     return false;
@@ -84,14 +129,7 @@ ActorThreadPool::~ActorThreadPool() {
   bool terminate = false;
   int count = 0;
   do {
-    {
-#ifdef USE_HQUEUE
-      terminate = actor_queue_.Empty();
-#else
-      std::lock_guard<std::mutex> _l(actor_mutex_);
-      terminate = actor_queue_.empty();
-#endif
-    }
+    terminate = ActorQueuesEmpty();
     if (!terminate) {
       for (auto &worker : workers_) {
         worker->Active();
@@ -99,6 +137,11 @@ ActorThreadPool::~ActorThreadPool() {
       std::this_thread::yield();
     }
   } while (!terminate && count++ < kMaxCount);
+  // the actor threads steal from and activate the other workers, so all of them exit before any worker is deleted
+  for (auto worker : actor_workers_) {
+    worker->StopThread();
+  }
+  actor_workers_.clear();
   for (auto &worker : workers_) {
     delete worker;
     worker = nullptr;
@@ -109,6 +152,49 @@ ActorThreadPool::~ActorThreadPool() {
 #endif
 }
 
+bool ActorThreadPool::ActorQueuesEmpty() {
+  {
+#ifdef USE_HQUEUE
+    if (!actor_queue_.Empty()) {
+      return false;
+    }
+#else
+    std::lock_guard<std::mutex> _l(actor_mutex_);
+    if (!actor_queue_.empty()) {
+      return false;
+    }
+#endif
+  }
+  if (schedule_mode_ == kWorkStealingSchedule) {
+    for (auto worker : actor_workers_) {
+      if (!worker->LocalActorQueueEmpty()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+ActorBase *ActorThreadPool::StealActorFromWorkers(ActorWorker *thief, uint32_t random) {
+  size_t actor_thread_num = actor_workers_.size();
+  if (actor_thread_num <= 1) {
+    return nullptr;
+  }
+  size_t start = random % actor_thread_num;
+  for (size_t i = 0; i < actor_thread_num; ++i) {
+    auto victim = actor_workers_[(start + i) % actor_thread_num];
+    if (victim == thief) {
+      continue;
+    }
+    auto actor = victim->StealLocalActor();
+    if (actor != nullptr) {
+      THREAD_DEBUG("actor[%s] is stolen", actor->GetAID().Name().c_str());
+      return actor;
+    }
+  }
+  return nullptr;
+}
+
 ActorBase *ActorThreadPool::PopActorFromQueue() {
 #ifdef USE_HQUEUE
   return actor_queue_.Dequeue();
@@ -127,7 +213,13 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   if (!actor) {
     return;
   }
-  {
+  // the actor woken up by an actor thread of this pool stays on the same thread, fall back to the global queue
+  // when the local deque is full or the actor is woken up by the other threads
+  auto current_worker = current_actor_worker;
+  if (schedule_mode_ == kWorkStealingSchedule && current_worker != nullptr && current_worker->BelongTo(this) &&
+      current_worker->PushLocalActor(actor)) {
+    THREAD_DEBUG("actor[%s] enqueue local success", actor->GetAID().Name().c_str());
+  } else {
 #ifdef USE_HQUEUE
     while (!actor_queue_.Enqueue(actor)) {
     }
@@ -138,8 +230,7 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   }
   THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
   // active one idle actor thread if exist
-  for (size_t i = 0; i < actor_thread_num_; ++i) {
-    auto worker = reinterpret_cast<ActorWorker *>(workers_[i]);
+  for (auto worker : actor_workers_) {
     if (worker->ActorActive()) {
       break;
     }
@@ -178,23 +269,33 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
     return THREAD_ERROR;
   }
 
-  if (ThreadPool::CreateThreads<ActorWorker>(actor_thread_num_, core_list) != THREAD_OK) {
+  // create all the workers before starting any thread, so that workers_ and actor_workers_ are not changed while the
+  // actor threads read them
+  std::lock_guard<std::mutex> _l(pool_mutex_);
+  size_t start = workers_.size();
+  if (CreateWorkers<ActorWorker>(actor_thread_num_, core_list) != THREAD_OK) {
     return THREAD_ERROR;
   }
-
-  if (kernel_thread_num > 0) {
-    return ThreadPool::CreateThreads<Worker>(kernel_thread_num, core_list);
+  for (size_t i = start; i < workers_.size(); ++i) {
+    actor_workers_.push_back(static_cast<ActorWorker *>(workers_[i]));
+  }
+  if (kernel_thread_num > 0 && CreateWorkers<Worker>(kernel_thread_num, core_list) != THREAD_OK) {
+    actor_workers_.clear();
+    return THREAD_ERROR;
   }
+  StartWorkers(start);
   return THREAD_OK;
 }
 
 ActorThreadPool *ActorThreadPool::CreateThreadPool(size_t actor_thread_num, size_t all_thread_num,
-                                                   const std::vector<int> &core_list, BindMode bind_mode) {
+                                                   const std::vector<int> &core_list, BindMode bind_mode,
+                                                   ActorScheduleMode schedule_mode) {
   std::lock_guard<std::mutex> lock(create_thread_pool_muntex_);
   ActorThreadPool *pool = new (std::nothrow) ActorThreadPool();
   if (pool == nullptr) {
     return nullptr;
   }
+  pool->schedule_mode_ = schedule_mode;
   int ret = pool->InitAffinityInfo();
   if (ret != THREAD_OK) {
     delete pool;
@@ -214,11 +315,12 @@ ActorThreadPool *ActorThreadPool::CreateThreadPool(size_t actor_thread_num, size
   return pool;
 }
 
-ActorThreadPool *ActorThreadPool::CreateThreadPool(size_t thread_num) {
+ActorThreadPool *ActorThreadPool::CreateThreadPool(size_t thread_num, ActorScheduleMode schedule_mode) {
   ActorThreadPool *pool = new (std::nothrow) ActorThreadPool();
   if (pool == nullptr) {
     return nullptr;
   }
+  pool->schedule_mode_ = schedule_mode;
   int ret = pool->CreateThreads(thread_num, thread_num, {});
   if (ret != THREAD_OK) {
     delete pool;
@@ -26,16 +26,37 @@
 #include "thread/core_affinity.h"
 #include "actor/actor.h"
 #include "thread/hqueue.h"
+#include "thread/steal_queue.h"
 #ifndef USE_HQUEUE
 #define USE_HQUEUE
 #endif
 namespace mindspore {
+constexpr size_t kLocalActorQueueSize = 1024;
+
+// The way the actor thread pool dispatches runnable actors to actor threads.
+enum ActorScheduleMode {
+  // all actors go through the global actor queue shared by every actor thread
+  kGlobalQueueSchedule = 0,
+  // every actor thread has its own deque, pops it in LIFO order and steals from the others when it is empty,
+  // the actors woken up by an actor thread are pushed to the deque of the same thread
+  kWorkStealingSchedule = 1,
+};
+
 class ActorThreadPool;
 class ActorWorker : public Worker {
  public:
-  explicit ActorWorker(ThreadPool *pool, size_t index) : Worker(pool, index) {}
+  explicit ActorWorker(ThreadPool *pool, size_t index) : Worker(pool, index), steal_seed_(index + 1) {
+    // the deque must be ready before the thread starts, it is only used in kWorkStealingSchedule mode
+    (void)local_actor_queue_.Init(static_cast<int64_t>(kLocalActorQueueSize));
+  }
   void CreateThread() override;
   bool ActorActive();
+  bool PushLocalActor(ActorBase *actor);
+  ActorBase *StealLocalActor() { return local_actor_queue_.Steal(); }
+  bool LocalActorQueueEmpty() const { return !local_actor_queue_.IsInit() || local_actor_queue_.Empty(); }
+  bool BelongTo(const ThreadPool *pool) const { return pool_ == pool; }
+  // stop the actor thread and wait until it exits, the worker itself stays valid for the other threads
+  void StopThread();
   ~ActorWorker() override {
     {
       std::lock_guard<std::mutex> _l(mutex_);
@@ -53,7 +74,7 @@ class ActorWorker : public Worker {
       }
     }
 
-    if (thread_->joinable()) {
+    if (thread_ != nullptr && thread_->joinable()) {
       thread_->join();
     }
     local_task_queue_ = nullptr;
@@ -62,20 +83,27 @@ class ActorWorker : public Worker {
  private:
   void RunWithSpin();
   bool RunQueueActorTask();
+  ActorBase *StealActor();
+
+  StealQueue<ActorBase> local_actor_queue_;
+  // xorshift state used to pick the victim worker randomly
+  uint32_t steal_seed_{1};
 };
 
 class MS_CORE_API ActorThreadPool : public ThreadPool {
  public:
   // create ThreadPool that contains actor thread and kernel thread
-  static ActorThreadPool *CreateThreadPool(size_t actor_thread_num, size_t all_thread_num, BindMode bind_mode) {
+  static ActorThreadPool *CreateThreadPool(size_t actor_thread_num, size_t all_thread_num, BindMode bind_mode,
+                                           ActorScheduleMode schedule_mode = kGlobalQueueSchedule) {
     std::vector<int> core_list;
-    return ActorThreadPool::CreateThreadPool(actor_thread_num, all_thread_num, core_list, bind_mode);
+    return ActorThreadPool::CreateThreadPool(actor_thread_num, all_thread_num, core_list, bind_mode, schedule_mode);
   }
 
   static ActorThreadPool *CreateThreadPool(size_t actor_thread_num, size_t all_thread_num,
-                                           const std::vector<int> &core_list, BindMode bind_mode);
+                                           const std::vector<int> &core_list, BindMode bind_mode,
+                                           ActorScheduleMode schedule_mode = kGlobalQueueSchedule);
   // create ThreadPool that contains only actor thread
-  static ActorThreadPool *CreateThreadPool(size_t thread_num);
+  static ActorThreadPool *CreateThreadPool(size_t thread_num, ActorScheduleMode schedule_mode = kGlobalQueueSchedule);
   ~ActorThreadPool() override;
 
   static void set_actor_queue_size(size_t actor_queue_size) { actor_queue_size_ = actor_queue_size; }
@@ -84,6 +112,10 @@ class MS_CORE_API ActorThreadPool : public ThreadPool {
   virtual void PushActorToQueue(ActorBase *actor);
   virtual ActorBase *PopActorFromQueue();
 
+  ActorScheduleMode schedule_mode() const { return schedule_mode_; }
+  // steal one actor from the deque of a random actor worker except the thief itself
+  ActorBase *StealActorFromWorkers(ActorWorker *thief, uint32_t random);
+
  protected:
   ActorThreadPool() = default;
 
@@ -97,6 +129,12 @@ class MS_CORE_API ActorThreadPool : public ThreadPool {
 
  private:
   int CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list);
+  bool ActorQueuesEmpty();
+
+  ActorScheduleMode schedule_mode_{kGlobalQueueSchedule};
+  // the actor workers of workers_, filled before any thread starts and cleared after all the actor threads exit,
+  // so the actor threads read it without a lock
+  std::vector<ActorWorker *> actor_workers_;
 
   // Support to set the size of actor queue.
   static size_t actor_queue_size_;
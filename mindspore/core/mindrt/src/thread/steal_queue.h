@@ -0,0 +1,118 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_RUNTIME_STEAL_QUEUE_H_
+#define MINDSPORE_CORE_MINDRT_RUNTIME_STEAL_QUEUE_H_
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+namespace mindspore {
+// implement a bounded lock-free work-stealing deque
+// refer to https://www.di.ens.fr/~zappa/readings/ppopp13.pdf
+// Push and Pop can only be called by the owner thread and work on the bottom in LIFO order,
+// Steal can be called by any other thread and takes the oldest element from the top.
+template <typename T>
+class StealQueue {
+ public:
+  StealQueue(const StealQueue &) = delete;
+  StealQueue &operator=(const StealQueue &) = delete;
+  StealQueue() {}
+  virtual ~StealQueue() {}
+
+  bool IsInit() const { return buffer_ != nullptr; }
+
+  // the size will be rounded up to the power of 2
+  bool Init(int64_t sz) {
+    if (IsInit() || sz <= 0) {
+      return false;
+    }
+    int64_t capacity = 1;
+    while (capacity < sz) {
+      capacity <<= 1;
+    }
+    buffer_ = std::make_unique<std::atomic<T *>[]>(static_cast<size_t>(capacity));
+    for (int64_t i = 0; i < capacity; ++i) {
+      buffer_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    mask_ = capacity - 1;
+    top_ = 0;
+    bottom_ = 0;
+    return true;
+  }
+
+  // owner only, return false when the queue is full
+  bool Push(T *t) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    if (b - top > mask_) {
+      return false;
+    }
+    buffer_[b & mask_].store(t, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // owner only, take the latest pushed element
+  T *Pop() {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > b) {
+      // empty
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T *ret = buffer_[b & mask_].load(std::memory_order_relaxed);
+    if (top == b) {
+      // the last element, race with the thieves
+      if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        ret = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return ret;
+  }
+
+  // any thread, take the oldest element
+  T *Steal() {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (top >= b) {
+      return nullptr;
+    }
+    T *ret = buffer_[top & mask_].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return ret;
+  }
+
+  bool Empty() const { return bottom_.load(std::memory_order_acquire) <= top_.load(std::memory_order_acquire); }
+
+ private:
+  // top and bottom are written by different threads, keep them in different cache lines
+  alignas(64) std::atomic<int64_t> top_{0};
+  alignas(64) std::atomic<int64_t> bottom_{0};
+  std::unique_ptr<std::atomic<T *>[]> buffer_{nullptr};
+  int64_t mask_{0};
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_MINDRT_RUNTIME_STEAL_QUEUE_H_
@@ -44,7 +44,7 @@ Worker::~Worker() {
     }
   }
 
-  if (thread_->joinable()) {
+  if (thread_ != nullptr && thread_->joinable()) {
     thread_->join();
   }
   pool_ = nullptr;
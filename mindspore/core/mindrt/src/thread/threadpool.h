@@ -198,6 +198,23 @@ class MS_CORE_API ThreadPool {
   virtual bool SetRunnerID(const std::string &runner_id) { return false; }
   template <typename T = Worker>
   int CreateThreads(size_t thread_num, const std::vector<int> &core_list) {
+    std::lock_guard<std::mutex> _l(pool_mutex_);
+    size_t start = workers_.size();
+    if (CreateWorkers<T>(thread_num, core_list) != THREAD_OK) {
+      return THREAD_ERROR;
+    }
+    StartWorkers(start);
+    return THREAD_OK;
+  }
+
+ protected:
+  ThreadPool() = default;
+
+  int InitAffinityInfo();
+
+  // append thread_num workers of type T to workers_ without starting their threads, the caller holds pool_mutex_
+  template <typename T = Worker>
+  int CreateWorkers(size_t thread_num, const std::vector<int> &core_list) {
     size_t core_num = std::thread::hardware_concurrency();
     thread_num = thread_num < core_num ? thread_num : core_num;
     THREAD_INFO("ThreadInfo, Num: [%zu], CoreNum: [%zu]", thread_num, core_num);
@@ -205,7 +222,6 @@ class MS_CORE_API ThreadPool {
       THREAD_INFO("Current thread as working thread.");
       return THREAD_OK;
     }
-    std::lock_guard<std::mutex> _l(pool_mutex_);
     size_t start = workers_.size();
     for (size_t i = 0; i < thread_num; ++i) {
       auto worker = new (std::nothrow) T(this, workers_.size());
@@ -214,22 +230,21 @@ class MS_CORE_API ThreadPool {
       size_t queues_idx = start + i;
       if (queues_idx >= task_queues_.size()) {
         THREAD_ERROR("task_queues out of range.");
+        delete worker;
         return THREAD_ERROR;
       }
       worker->InitLocalTaskQueue(task_queues_[queues_idx].get());
       workers_.push_back(worker);
     }
-    for (size_t i = 0; i < thread_num; ++i) {
-      workers_[start + i]->CreateThread();
-      THREAD_INFO("create kernel thread[%zu]", i);
-    }
     return THREAD_OK;
   }
-
- protected:
-  ThreadPool() = default;
-
-  int InitAffinityInfo();
+  // start the threads of the workers from workers_[start] on, the caller holds pool_mutex_
+  void StartWorkers(size_t start) {
+    for (size_t i = start; i < workers_.size(); ++i) {
+      workers_[i]->CreateThread();
+      THREAD_INFO("create kernel thread[%zu]", i - start);
+    }
+  }
 
   void DistributeTask(std::vector<TaskSplit> *task_list, Task *task, int task_num, Worker *curr) const;
   void CalculateScales(const std::vector<Worker *> &workers, int sum_frequency) const;
@@ -72,6 +72,7 @@ const char kAllocVmmAlignSize[] = "vmm_align_size";
 const char kAllocMemoryRecycle[] = "memory_recycle";
 const char kAllocMemoryTracker[] = "memory_tracker";
 const char kAllocDefragMemoryStepFreq[] = "defrag_memory_step_freq";
+const char kAllocThreadCache[] = "thread_cache";
 
 // Runtime dev config.
 const char kRuntimeConf[] = "MS_DEV_RUNTIME_CONF";
@@ -83,6 +84,8 @@ const char kRuntimeView[] = "view";
 const char kRuntimeInsertTensorMove[] = "insert_tensormove";
 const char kRuntimeAllfinite[] = "all_finite";
 const char kRuntimeParalletAssignAddOpt[] = "parallel_assignadd_opt";
+const char kRuntimeSomasIncremental[] = "somas_incremental";
+const char kRuntimeMpscMailbox[] = "mpsc_mailbox";
 // Runtime debug config.
 const char kRuntimeSynchronize[] = "synchronize";
 const char kRuntimeMemoryTrack[] = "memory_track";
@@ -79,6 +79,11 @@ static const char *const kSharedThreadPoolSection = "shared_thread_pool";
 static const char *const kEnableSharedThreadPoolKey = "enable_shared_thread_pool";
 static const char *const kThreadNumLimitPerWorkerKey = "thread_num_limit_per_worker";
 static const char *const kThreadNumRemainingPerWorkerKey = "thread_num_remaining_per_worker";
+// dynamic batching of model pool
+static const char *const kDynamicBatchingSection = "dynamic_batching";
+static const char *const kEnableDynamicBatchingKey = "enable_dynamic_batching";
+static const char *const kMaxBatchSizeKey = "max_batch_size";
+static const char *const kMaxWaitTimeUsKey = "max_wait_time_us";
 // model pool inner section and key
 static const char *const kInnerModelParallelRunnerSection = "inner_model_parallel_runner";
 static const char *const kInnerSharingWeightCopyBufKey = "sharing_weight_copy_buf";
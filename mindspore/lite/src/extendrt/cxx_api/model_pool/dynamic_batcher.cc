@@ -0,0 +1,293 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/extendrt/cxx_api/model_pool/dynamic_batcher.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+#include "src/common/log_adapter.h"
+namespace mindspore {
+bool DynamicBatcher::CanBatch(const std::vector<MSTensor> &inputs) const {
+  if (inputs.empty()) {
+    return false;
+  }
+  int64_t batch_size = -1;
+  for (auto &input : inputs) {
+    if (input.IsDevice() || input.DataType() == DataType::kObjectTypeString) {
+      return false;
+    }
+    auto shape = input.Shape();
+    if (shape.empty() || shape[0] <= 0 || (batch_size != -1 && shape[0] != batch_size)) {
+      return false;
+    }
+    batch_size = shape[0];
+    if (input.DataSize() == 0 || input.DataSize() % static_cast<size_t>(batch_size) != 0) {
+      return false;
+    }
+  }
+  return static_cast<size_t>(batch_size) < max_batch_size_;
+}
+
+Status DynamicBatcher::CheckRequest(const Request &request) {
+  for (auto &input : *request.inputs) {
+    if (input.Data() == nullptr) {
+      MS_LOG(ERROR) << "the data of input " << input.Name() << " is nullptr.";
+      return kLiteParamInvalid;
+    }
+  }
+  // every output of the batch is split along the first dimension, so are the outputs given by the user.
+  for (auto &output : *request.outputs) {
+    auto shape = output.Shape();
+    if (!shape.empty() && shape[0] != static_cast<int64_t>(request.batch_size)) {
+      MS_LOG(ERROR) << "the first dimension of user output " << output.Name() << " is " << shape[0]
+                    << ", but the batch size of request is " << request.batch_size;
+      return kLiteParamInvalid;
+    }
+  }
+  return kSuccess;
+}
+
+bool DynamicBatcher::IsCompatible(const Request &request, const Batch &batch) {
+  const auto &inputs = *request.inputs;
+  const auto &batch_inputs = *batch.requests.front()->inputs;
+  if (inputs.size() != batch_inputs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (inputs[i].DataType() != batch_inputs[i].DataType()) {
+      return false;
+    }
+    auto shape = inputs[i].Shape();
+    auto batch_shape = batch_inputs[i].Shape();
+    if (shape.size() != batch_shape.size() || !std::equal(shape.begin() + 1, shape.end(), batch_shape.begin() + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status DynamicBatcher::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs) {
+  auto enqueue_time = std::chrono::steady_clock::now();
+  Request request;
+  request.inputs = &inputs;
+  request.outputs = outputs;
+  request.batch_size = static_cast<size_t>(inputs.front().Shape()[0]);
+  // a bad request is rejected alone, it must not fail the batch it would join.
+  auto status = CheckRequest(request);
+  if (status != kSuccess) {
+    return status;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (open_batch_ != nullptr && open_batch_->batch_size + request.batch_size <= max_batch_size_ &&
+      IsCompatible(request, *open_batch_)) {
+    // join the open batch and wait for its leader to run it.
+    auto batch = open_batch_;
+    batch->requests.push_back(&request);
+    batch->batch_size += request.batch_size;
+    if (batch->batch_size >= max_batch_size_) {
+      batch->closed = true;
+      open_batch_ = nullptr;
+      batch->cv.notify_all();
+    }
+    batch->cv.wait(lock, [&batch] { return batch->done; });
+    return request.status;
+  }
+  if (open_batch_ != nullptr) {
+    // the request can not join the open batch, so there is no point in waiting for the open batch any more.
+    open_batch_->closed = true;
+    open_batch_->cv.notify_all();
+    open_batch_ = nullptr;
+  }
+  auto batch = std::make_shared<Batch>();
+  batch->enqueue_time = enqueue_time;
+  batch->requests.push_back(&request);
+  batch->batch_size = request.batch_size;
+  open_batch_ = batch;
+  (void)batch->cv.wait_for(lock, std::chrono::microseconds(max_wait_time_us_), [&batch] { return batch->closed; });
+  batch->closed = true;
+  if (open_batch_ == batch) {
+    open_batch_ = nullptr;
+  }
+  lock.unlock();
+  RunBatch(batch.get());
+  lock.lock();
+  batch->done = true;
+  batch->cv.notify_all();
+  return request.status;
+}
+
+void DynamicBatcher::RunBatch(Batch *batch) {
+  if (batch->requests.size() == 1) {
+    auto request = batch->requests.front();
+    request->status = run_func_(*request->inputs, request->outputs);
+    if (request->status != kSuccess) {
+      return;
+    }
+  } else if (RunRequests(batch) != kSuccess) {
+    MS_LOG(WARNING) << "Run a batch of " << batch->requests.size() << " requests failed, batch size: "
+                    << batch->batch_size << ", run the requests one by one.";
+    RunRequestsOneByOne(batch);
+    return;
+  }
+  auto cost = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - batch->enqueue_time).count();
+  RecordLatency(batch->batch_size, cost);
+}
+
+void DynamicBatcher::RunRequestsOneByOne(Batch *batch) {
+  for (auto request : batch->requests) {
+    request->status = run_func_(*request->inputs, request->outputs);
+  }
+}
+
+Status DynamicBatcher::RunRequests(Batch *batch) {
+  std::vector<MSTensor> batch_inputs;
+  auto status = ConcatInputs(*batch, &batch_inputs);
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "concat the inputs of batch failed.";
+    return status;
+  }
+  std::vector<MSTensor> batch_outputs;
+  status = run_func_(batch_inputs, &batch_outputs);
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "predict batch failed, batch size: " << batch->batch_size;
+    return status;
+  }
+  return ScatterOutputs(*batch, batch_outputs);
+}
+
+Status DynamicBatcher::ConcatInputs(const Batch &batch, std::vector<MSTensor> *batch_inputs) {
+  const auto &first_inputs = *batch.requests.front()->inputs;
+  for (size_t i = 0; i < first_inputs.size(); i++) {
+    auto shape = first_inputs[i].Shape();
+    shape[0] = static_cast<int64_t>(batch.batch_size);
+    auto tensor = MSTensor::CreateTensor(first_inputs[i].Name(), first_inputs[i].DataType(), shape, nullptr, 0);
+    if (tensor == nullptr) {
+      MS_LOG(ERROR) << "create batch input tensor failed.";
+      return kLiteNullptr;
+    }
+    auto dst = static_cast<uint8_t *>(tensor->MutableData());
+    size_t batch_data_size = tensor->DataSize();
+    if (dst == nullptr) {
+      MS_LOG(ERROR) << "malloc batch input tensor failed.";
+      delete tensor;
+      return kLiteMemoryFailed;
+    }
+    size_t offset = 0;
+    for (auto request : batch.requests) {
+      const auto &input = (*request->inputs)[i];
+      auto data = input.Data();
+      if (data == nullptr || offset + input.DataSize() > batch_data_size) {
+        MS_LOG(ERROR) << "input " << input.Name() << " is invalid for batching.";
+        delete tensor;
+        return kLiteError;
+      }
+      (void)memcpy(dst + offset, data.get(), input.DataSize());
+      offset += input.DataSize();
+    }
+    batch_inputs->push_back(*tensor);
+    delete tensor;
+  }
+  return kSuccess;
+}
+
+Status DynamicBatcher::CheckUserOutputs(const Request &request, const Batch &batch,
+                                        const std::vector<MSTensor> &batch_outputs) {
+  auto &user_outputs = *request.outputs;
+  if (user_outputs.empty()) {
+    return kSuccess;
+  }
+  if (user_outputs.size() != batch_outputs.size()) {
+    MS_LOG(ERROR) << "user outputs size is: " << user_outputs.size()
+                  << ", but model outputs size is: " << batch_outputs.size();
+    return kLiteError;
+  }
+  for (size_t i = 0; i < batch_outputs.size(); i++) {
+    size_t size = batch_outputs[i].DataSize() / batch.batch_size * request.batch_size;
+    if (user_outputs[i].DataSize() != size || user_outputs[i].Data() == nullptr) {
+      MS_LOG(ERROR) << "user output " << user_outputs[i].Name() << " size is: " << user_outputs[i].DataSize()
+                    << ", but the output size of request is: " << size;
+      return kLiteError;
+    }
+  }
+  return kSuccess;
+}
+
+// All the checks are done before any output is written, so a failed request never gets partial outputs.
+Status DynamicBatcher::ScatterOutputs(const Batch &batch, const std::vector<MSTensor> &batch_outputs) {
+  for (auto &output : batch_outputs) {
+    auto shape = output.Shape();
+    if (shape.empty() || shape[0] != static_cast<int64_t>(batch.batch_size) || output.Data() == nullptr) {
+      MS_LOG(ERROR) << "the first dimension of output " << output.Name() << " is not the batch size "
+                    << batch.batch_size;
+      return kLiteError;
+    }
+  }
+  for (auto request : batch.requests) {
+    // the outputs of the request do not match the model, only the request fails.
+    request->status = CheckUserOutputs(*request, batch, batch_outputs);
+  }
+  std::vector<size_t> offsets(batch_outputs.size(), 0);
+  for (auto request : batch.requests) {
+    std::vector<MSTensor> new_outputs;
+    for (size_t i = 0; i < batch_outputs.size() && request->status == kSuccess; i++) {
+      auto &output = batch_outputs[i];
+      size_t size = output.DataSize() / batch.batch_size * request->batch_size;
+      auto src = static_cast<const uint8_t *>(output.Data().get()) + offsets[i];
+      if (!request->outputs->empty()) {
+        // user's data, copy the rows to it.
+        (void)memcpy(request->outputs->at(i).MutableData(), src, size);
+        continue;
+      }
+      auto shape = output.Shape();
+      shape[0] = static_cast<int64_t>(request->batch_size);
+      auto tensor = MSTensor::CreateTensor(output.Name(), output.DataType(), shape, src, size);
+      if (tensor == nullptr) {
+        MS_LOG(ERROR) << "create output tensor of request failed.";
+        request->status = kLiteNullptr;
+        break;
+      }
+      new_outputs.push_back(*tensor);
+      delete tensor;
+    }
+    for (size_t i = 0; i < batch_outputs.size(); i++) {
+      offsets[i] += batch_outputs[i].DataSize() / batch.batch_size * request->batch_size;
+    }
+    if (request->status == kSuccess && request->outputs->empty()) {
+      *request->outputs = std::move(new_outputs);
+    }
+  }
+  return kSuccess;
+}
+
+void DynamicBatcher::RecordLatency(size_t batch_size, double cost_ms) {
+  std::lock_guard<std::mutex> lock(histogram_mutex_);
+  auto &histogram = histograms_[batch_size];
+  histogram.count++;
+  histogram.total_ms += cost_ms;
+  histogram.max_ms = std::max(histogram.max_ms, cost_ms);
+  size_t bucket = 0;
+  for (double bound = 1; bucket < BatchLatencyHistogram::kBucketNum - 1 && cost_ms >= bound; bound *= 2) {
+    bucket++;
+  }
+  histogram.buckets[bucket]++;
+}
+
+std::map<size_t, BatchLatencyHistogram> DynamicBatcher::GetLatencyHistograms() {
+  std::lock_guard<std::mutex> lock(histogram_mutex_);
+  return histograms_;
+}
+}  // namespace mindspore
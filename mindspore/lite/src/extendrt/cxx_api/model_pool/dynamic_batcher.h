@@ -0,0 +1,104 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_DYNAMIC_BATCHER_H_
+#define MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_DYNAMIC_BATCHER_H_
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "include/api/model_parallel_runner.h"
+#include "include/api/status.h"
+#include "include/api/types.h"
+namespace mindspore {
+// Gather concurrent predict requests into one batch along the first dimension.
+//
+// There is no batching thread: the first request of a batch becomes the leader, it waits until the batch is full or
+// the max wait time is up, then concatenates the inputs, runs the batch and scatters the outputs back to the other
+// requests of the batch, which just wait for the result. So several batches can be run by different workers at the
+// same time. Requests with different shapes except the first dimension or different data types go to different
+// batches. A request with invalid inputs or outputs is rejected before it joins a batch. If a batch fails as a whole,
+// its requests are retried one at a time, so every request gets its own status; a request whose outputs do not match
+// the batch outputs fails alone and its outputs are left untouched. The following batches are not affected.
+class DynamicBatcher {
+ public:
+  using RunFunc = std::function<Status(const std::vector<MSTensor> &, std::vector<MSTensor> *)>;
+
+  DynamicBatcher(size_t max_batch_size, int64_t max_wait_time_us, RunFunc run_func)
+      : max_batch_size_(max_batch_size), max_wait_time_us_(max_wait_time_us), run_func_(std::move(run_func)) {}
+
+  ~DynamicBatcher() = default;
+
+  // Whether the inputs can be batched with others, i.e. host tensors with the same first dimension.
+  bool CanBatch(const std::vector<MSTensor> &inputs) const;
+
+  Status Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs);
+
+  // Latency histograms of the batches, keyed by the batch size.
+  std::map<size_t, BatchLatencyHistogram> GetLatencyHistograms();
+
+ private:
+  struct Request {
+    const std::vector<MSTensor> *inputs = nullptr;
+    std::vector<MSTensor> *outputs = nullptr;
+    size_t batch_size = 0;
+    Status status = kSuccess;
+  };
+
+  struct Batch {
+    std::vector<Request *> requests;
+    // the time when the leader request is enqueued, the latency of the batch includes the queueing time.
+    std::chrono::steady_clock::time_point enqueue_time;
+    size_t batch_size = 0;
+    bool closed = false;
+    bool done = false;
+    std::condition_variable cv;
+  };
+
+  static Status CheckRequest(const Request &request);
+
+  static bool IsCompatible(const Request &request, const Batch &batch);
+
+  void RunBatch(Batch *batch);
+
+  void RunRequestsOneByOne(Batch *batch);
+
+  Status RunRequests(Batch *batch);
+
+  Status ConcatInputs(const Batch &batch, std::vector<MSTensor> *batch_inputs);
+
+  Status ScatterOutputs(const Batch &batch, const std::vector<MSTensor> &batch_outputs);
+
+  static Status CheckUserOutputs(const Request &request, const Batch &batch,
+                                 const std::vector<MSTensor> &batch_outputs);
+
+  void RecordLatency(size_t batch_size, double cost_ms);
+
+  size_t max_batch_size_;
+  int64_t max_wait_time_us_;
+  RunFunc run_func_;
+
+  std::mutex mutex_;
+  // The batch which still accepts requests.
+  std::shared_ptr<Batch> open_batch_ = nullptr;
+
+  std::mutex histogram_mutex_;
+  std::map<size_t, BatchLatencyHistogram> histograms_;
+};
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_DYNAMIC_BATCHER_H_
@@ -197,4 +197,12 @@ Status ModelParallelRunner::Predict(const std::vector<MSTensor> &inputs, std::ve
   }
   return model_parallel_runner_impl_->Predict(inputs, outputs, before, after);
 }
+
+std::map<size_t, BatchLatencyHistogram> ModelParallelRunner::GetBatchLatencyHistograms() {
+  if (model_parallel_runner_impl_ == nullptr) {
+    MS_LOG(ERROR) << "Please initialize ModelParallelRunner before calling GetBatchLatencyHistograms API.";
+    return {};
+  }
+  return model_parallel_runner_impl_->GetBatchLatencyHistograms();
+}
 }  // namespace mindspore
@@ -106,6 +106,16 @@ Status ModelParallelRunnerImpl::Predict(const std::vector<MSTensor> &inputs, std
   }
   return kSuccess;
 }
+
+std::map<size_t, BatchLatencyHistogram> ModelParallelRunnerImpl::GetBatchLatencyHistograms() {
+  std::shared_lock<std::shared_mutex> l(model_parallel_runner_impl_mutex_);
+  if (model_pool_ == nullptr) {
+    MS_LOG(ERROR) << "Please initialize ModelParallelRunner before calling GetBatchLatencyHistograms API.";
+    return {};
+  }
+  return model_pool_->GetBatchLatencyHistograms();
+}
+
 ModelParallelRunnerImpl::~ModelParallelRunnerImpl() {
   MS_LOG(INFO) << "delete model pool begin.";
   std::unique_lock<std::shared_mutex> l(model_parallel_runner_impl_mutex_);
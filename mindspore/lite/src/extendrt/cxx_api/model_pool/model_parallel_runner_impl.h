@@ -39,6 +39,8 @@ class ModelParallelRunnerImpl {
   Status Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
                  const MSKernelCallBack &before = nullptr, const MSKernelCallBack &after = nullptr);
 
+  std::map<size_t, BatchLatencyHistogram> GetBatchLatencyHistograms();
+
  private:
   ModelPool *model_pool_ = nullptr;
   std::shared_mutex model_parallel_runner_impl_mutex_;
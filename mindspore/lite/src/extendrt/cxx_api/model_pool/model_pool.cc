@@ -44,6 +44,8 @@ constexpr int kInvalidNumaId = -1;
 constexpr int kNumDefaultInterOpParallel = 4;
 constexpr int kNumCoreNumTimes = 5;
 constexpr int kDefaultThreadNumTimes = 2;
+constexpr int kDefaultMaxBatchSize = 32;
+constexpr int64_t kDefaultMaxWaitTimeUs = 1000;
 }  // namespace
 
 int ModelPool::GetDefaultThreadNum(int worker_num) {
@@ -939,12 +941,67 @@ Status ModelPool::ParseSharedThreadPoolParam(const std::shared_ptr<RunnerConfig>
   return ParseParamByConfigInfo(runner_config->GetConfigInfo());
 }
 
+Status ModelPool::ParseDynamicBatchingParam(const std::shared_ptr<RunnerConfig> &runner_config) {
+  if (runner_config == nullptr) {
+    MS_LOG(INFO) << "runner config is nullptr.";
+    return kSuccess;
+  }
+  std::map<std::string, std::map<std::string, std::string>> config_info;
+  if (!runner_config->GetConfigPath().empty()) {
+    int ret = lite::GetAllSectionInfoFromConfigFile(runner_config->GetConfigPath(), &config_info);
+    if (ret != lite::RET_OK) {
+      MS_LOG(ERROR) << "GetAllSectionInfoFromConfigFile failed.";
+      return kLiteError;
+    }
+  }
+  // the config info set by user overrides the config file.
+  auto user_config_info = runner_config->GetConfigInfo();
+  for (auto &item : user_config_info[lite::kDynamicBatchingSection]) {
+    config_info[lite::kDynamicBatchingSection][item.first] = item.second;
+  }
+  auto dynamic_batching = config_info.find(lite::kDynamicBatchingSection);
+  if (dynamic_batching == config_info.end() ||
+      dynamic_batching->second[lite::kEnableDynamicBatchingKey] != "true") {
+    MS_LOG(INFO) << "not use dynamic batching.";
+    return kSuccess;
+  }
+  auto &dynamic_batching_param = dynamic_batching->second;
+  int max_batch_size = kDefaultMaxBatchSize;
+  if (!dynamic_batching_param[lite::kMaxBatchSizeKey].empty()) {
+    max_batch_size = std::atoi(dynamic_batching_param[lite::kMaxBatchSizeKey].c_str());
+    if (max_batch_size <= 1) {
+      MS_LOG(WARNING) << "max_batch_size is invalid, max_batch_size: " << max_batch_size;
+      return kLiteParamInvalid;
+    }
+  }
+  int64_t max_wait_time_us = kDefaultMaxWaitTimeUs;
+  if (!dynamic_batching_param[lite::kMaxWaitTimeUsKey].empty()) {
+    max_wait_time_us = std::atoll(dynamic_batching_param[lite::kMaxWaitTimeUsKey].c_str());
+    if (max_wait_time_us < 0) {
+      MS_LOG(WARNING) << "max_wait_time_us is invalid, max_wait_time_us: " << max_wait_time_us;
+      return kLiteParamInvalid;
+    }
+  }
+  dynamic_batcher_ = std::make_shared<DynamicBatcher>(
+    max_batch_size, max_wait_time_us, [this](const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs) {
+      return DispatchPredict(inputs, outputs, nullptr, nullptr);
+    });
+  MS_LOG(INFO) << "use dynamic batching, max batch size: " << max_batch_size
+               << " | max wait time: " << max_wait_time_us << "us";
+  return kSuccess;
+}
+
 ModelPoolConfig ModelPool::Init(const std::shared_ptr<RunnerConfig> &runner_config) {
   auto status = ParseSharedThreadPoolParam(runner_config);
   if (status != kSuccess) {
     MS_LOG(WARNING) << "ParseSharedThreadPoolParam failed, Not use thread pool shared.";
     enable_shared_thread_pool_ = false;
   }
+  status = ParseDynamicBatchingParam(runner_config);
+  if (status != kSuccess) {
+    MS_LOG(WARNING) << "ParseDynamicBatchingParam failed, Not use dynamic batching.";
+    dynamic_batcher_ = nullptr;
+  }
   ModelPoolConfig model_pool_config = {};
   status = CanUseAllPhysicalResources();
   if (status != kSuccess) {
@@ -1115,6 +1172,14 @@ Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTen
       return kSuccess;
     }
   }
+  if (dynamic_batcher_ != nullptr && before == nullptr && after == nullptr && dynamic_batcher_->CanBatch(inputs)) {
+    return dynamic_batcher_->Predict(inputs, outputs);
+  }
+  return DispatchPredict(inputs, outputs, before, after);
+}
+
+Status ModelPool::DispatchPredict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                                  const MSKernelCallBack &before, const MSKernelCallBack &after) {
   int max_wait_worker_node_id = 0;
   int max_wait_worker_num = 0;
   auto available_worker = GetMaxWaitWorkerNum(&max_wait_worker_node_id, &max_wait_worker_num);
@@ -1142,8 +1207,21 @@ Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTen
   return kSuccess;
 }
 
+std::map<size_t, BatchLatencyHistogram> ModelPool::GetBatchLatencyHistograms() {
+  if (dynamic_batcher_ == nullptr) {
+    return {};
+  }
+  return dynamic_batcher_->GetLatencyHistograms();
+}
+
 ModelPool::~ModelPool() {
   MS_LOG(INFO) << "free model pool.";
+  for (auto &item : GetBatchLatencyHistograms()) {
+    auto &histogram = item.second;
+    MS_LOG(INFO) << "dynamic batch size: " << item.first << " | count: " << histogram.count
+                 << " | avg latency: " << histogram.total_ms / histogram.count << "ms"
+                 << " | max latency: " << histogram.max_ms << "ms";
+  }
   if (predict_task_queue_ != nullptr) {
     predict_task_queue_->SetPredictTaskDone();
   }
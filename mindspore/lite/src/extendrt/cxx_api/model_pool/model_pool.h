@@ -28,6 +28,7 @@
 #include "include/api/status.h"
 #include "include/api/context.h"
 #include "include/api/model_parallel_runner.h"
+#include "src/extendrt/cxx_api/model_pool/dynamic_batcher.h"
 #include "src/extendrt/cxx_api/model_pool/model_worker.h"
 #include "src/extendrt/cxx_api/model_pool/predict_task_queue.h"
 namespace mindspore {
@@ -62,7 +63,13 @@ class ModelPool {
   Status Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
                  const MSKernelCallBack &before = nullptr, const MSKernelCallBack &after = nullptr);
 
+  // latency histograms of the dynamic batches, keyed by the batch size, empty if dynamic batching is not used.
+  std::map<size_t, BatchLatencyHistogram> GetBatchLatencyHistograms();
+
  private:
+  Status DispatchPredict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                         const MSKernelCallBack &before, const MSKernelCallBack &after);
+
   ModelPoolConfig CreateModelPoolConfig(const std::shared_ptr<RunnerConfig> &runner_config);
   std::shared_ptr<Context> GetInitContext(const std::shared_ptr<RunnerConfig> &runner_config);
 
@@ -117,6 +124,8 @@ class ModelPool {
 
   Status ParseParamByConfigInfo(std::map<std::string, std::map<std::string, std::string>> config_info);
 
+  Status ParseDynamicBatchingParam(const std::shared_ptr<RunnerConfig> &runner_config);
+
   Status CheckSharingThreadPoolParam(const ModelPoolConfig &model_pool_config);
 
   Status ParseDeviceIds(const std::shared_ptr<RunnerConfig> &runner_config, ModelPoolConfig *model_pool_config);
@@ -170,6 +179,9 @@ class ModelPool {
   int thread_num_limit_ = 0;
   int remaining_thread_num_ = 0;
 
+  // gather concurrent requests into one batch, nullptr if dynamic batching is not used.
+  std::shared_ptr<DynamicBatcher> dynamic_batcher_ = nullptr;
+
   char *graph_buf_ = nullptr;
   // malloc for graph_buf_
   std::shared_ptr<Allocator> allocator_ = nullptr;
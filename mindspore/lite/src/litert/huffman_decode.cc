@@ -15,181 +15,333 @@
  */
 
 #include "src/litert/huffman_decode.h"
-#include <queue>
+#include <algorithm>
+#include <cstdlib>
+#include "src/litert/inner_context.h"
 
 namespace mindspore {
 namespace lite {
-STATUS HuffmanDecode::DoHuffmanDecode(const std::string &input_str, void *decoded_data, size_t data_len) {
-  if (decoded_data == nullptr) {
-    MS_LOG(ERROR) << "decoded_data is nullptr.";
-    return RET_ERROR;
-  }
+namespace {
+constexpr size_t kByteBits = 8;
+constexpr size_t kBufferBits = 64;
+constexpr int kDecimalBase = 10;
 
-  int status;
-  std::string huffman_decoded_str;
-  auto key_pos = input_str.find_first_of('#');
-  auto code_pos = input_str.find_first_of('#', key_pos + 1);
-  if (key_pos == std::string::npos || code_pos == std::string::npos) {
-    MS_LOG(ERROR) << "not found '#' in input_str";
-    return RET_ERROR;
+// Read the stream from the most significant bit of each byte, the bits after the end of the stream are zeros.
+class HuffmanBitReader {
+ public:
+  HuffmanBitReader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+  uint32_t Peek(size_t bit_num) {
+    if (count_ < bit_num) {
+      Refill();
+    }
+    return static_cast<uint32_t>(buffer_ >> (kBufferBits - bit_num));
   }
-  if (key_pos + 1 > input_str.size() || code_pos + 1 > input_str.size()) {
-    MS_LOG(ERROR) << "pos extend input_str size.";
-    return RET_ERROR;
+
+  void Skip(size_t bit_num) {
+    buffer_ <<= bit_num;
+    count_ -= bit_num;
+    consumed_ += bit_num;
   }
-  auto key = input_str.substr(0, key_pos);
-  auto code = input_str.substr(key_pos + 1, code_pos - key_pos - 1);
-  auto encoded_data = input_str.substr(code_pos + 1);
 
-  auto root = new (std::nothrow) HuffmanNode();
-  if (root == nullptr) {
-    MS_LOG(ERROR) << "new HuffmanNode failed.";
-    return RET_MEMORY_FAILED;
+  bool Exhausted() const { return consumed_ > size_ * kByteBits; }
+
+ private:
+  void Refill() {
+    while (count_ <= kBufferBits - kByteBits) {
+      uint64_t byte = next_ < size_ ? data_[next_] : 0;
+      ++next_;
+      buffer_ |= byte << (kBufferBits - kByteBits - count_);
+      count_ += kByteBits;
+    }
   }
-  root->left = nullptr;
-  root->right = nullptr;
-  root->parent = nullptr;
 
-  status = RebuildHuffmanTree(key, code, root);
-  if (status != RET_OK) {
-    MS_LOG(ERROR) << "Rebuild huffman tree failed.";
-    delete root;
-    return status;
+  const uint8_t *data_;
+  size_t size_;
+  size_t next_ = 0;
+  uint64_t buffer_ = 0;
+  size_t count_ = 0;
+  size_t consumed_ = 0;
+};
+
+// Decode the symbols until PSEUDO_EOF or the end of the stream if `stop_at_eof`, otherwise exactly `out_len` symbols.
+STATUS DecodeSymbols(const HuffmanTableEntry *table, HuffmanBitReader *reader, int8_t *out, size_t out_len,
+                     bool stop_at_eof, size_t *decoded_len) {
+  size_t pos = 0;
+  while (stop_at_eof || pos < out_len) {
+    size_t width = HuffmanTable::kRootBits;
+    const HuffmanTableEntry *entry = &table[reader->Peek(width)];
+    while (entry->kind == HuffmanTable::kSubTable) {
+      reader->Skip(width);
+      width = entry->bits;
+      entry = &table[static_cast<size_t>(entry->value) + reader->Peek(width)];
+    }
+    if (entry->kind == HuffmanTable::kEmpty) {
+      MS_LOG(ERROR) << "the huffman code is incomplete.";
+      return RET_ERROR;
+    }
+    reader->Skip(entry->bits);
+    if (reader->Exhausted()) {
+      if (stop_at_eof) {
+        break;
+      }
+      MS_LOG(ERROR) << "the huffman chunk ends before its " << out_len << " symbols.";
+      return RET_ERROR;
+    }
+    if (entry->kind == HuffmanTable::kEof) {
+      if (stop_at_eof) {
+        break;
+      }
+      MS_LOG(ERROR) << "find the pseudo-EOF in the huffman chunk.";
+      return RET_ERROR;
+    }
+    if (pos == out_len) {
+      MS_LOG(ERROR) << "the decoded data exceeds " << out_len << " bytes.";
+      return RET_ERROR;
+    }
+    out[pos++] = static_cast<int8_t>(entry->value);
   }
+  *decoded_len = pos;
+  return RET_OK;
+}
 
-  status = DoHuffmanDecompress(root, encoded_data, &huffman_decoded_str);
-  if (status != RET_OK) {
-    MS_LOG(ERROR) << "DoHuffmanDecompress failed.";
-    delete root;
-    return status;
+const char *FindSeparator(const char *begin, const char *end) {
+  return static_cast<const char *>(memchr(begin, kHuffmanSeparator, static_cast<size_t>(end - begin)));
+}
+
+template <typename T>
+T ReadUnaligned(const uint8_t *data) {
+  T value;
+  (void)memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+struct HuffmanChunks {
+  const HuffmanTableEntry *table = nullptr;
+  const uint8_t *bits = nullptr;
+  size_t bits_len = 0;
+  std::vector<uint64_t> offsets;
+  int8_t *output = nullptr;
+  size_t symbol_num = 0;
+  size_t chunk_symbols = 0;
+  int task_num = 1;
+};
+
+STATUS DecodeChunk(const HuffmanChunks &chunks, size_t index) {
+  auto begin = chunks.offsets[index];
+  auto end = index + 1 < chunks.offsets.size() ? chunks.offsets[index + 1] : chunks.bits_len;
+  auto first_symbol = index * chunks.chunk_symbols;
+  auto symbol_num = std::min(chunks.chunk_symbols, chunks.symbol_num - first_symbol);
+  HuffmanBitReader reader(chunks.bits + begin, end - begin);
+  size_t decoded_len = 0;
+  return DecodeSymbols(chunks.table, &reader, chunks.output + first_symbol, symbol_num, false, &decoded_len);
+}
+
+int DecodeChunksRun(void *cdata, int task_id, float, float) {
+  auto chunks = static_cast<const HuffmanChunks *>(cdata);
+  for (size_t index = static_cast<size_t>(task_id); index < chunks->offsets.size();
+       index += static_cast<size_t>(chunks->task_num)) {
+    if (DecodeChunk(*chunks, index) != RET_OK) {
+      MS_LOG(ERROR) << "Decode the huffman chunk " << index << " failed.";
+      return RET_ERROR;
+    }
   }
+  return RET_OK;
+}
 
-  size_t len = huffman_decoded_str.length();
-  if (data_len >= len) {
-    memcpy(decoded_data, huffman_decoded_str.c_str(), len);
-  } else {
-    FreeHuffmanNodeTree(root);
+STATUS ParseChunks(const uint8_t *header, size_t header_len, size_t data_len, HuffmanChunks *chunks) {
+  constexpr size_t kFixedHeaderLen = sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint32_t);
+  if (header_len < kFixedHeaderLen) {
+    MS_LOG(ERROR) << "the header of the huffman chunks is incomplete.";
     return RET_ERROR;
   }
-  FreeHuffmanNodeTree(root);
+  auto symbol_num = ReadUnaligned<uint64_t>(header);
+  auto chunk_symbols = ReadUnaligned<uint32_t>(header + sizeof(uint64_t));
+  auto chunk_num = ReadUnaligned<uint32_t>(header + sizeof(uint64_t) + sizeof(uint32_t));
+  if (symbol_num > data_len || chunk_symbols == 0 ||
+      chunk_num != (symbol_num + chunk_symbols - 1) / chunk_symbols) {
+    MS_LOG(ERROR) << "the header of the huffman chunks is invalid, symbol num: " << symbol_num
+                  << ", chunk symbols: " << chunk_symbols << ", chunk num: " << chunk_num;
+    return RET_ERROR;
+  }
+  if ((header_len - kFixedHeaderLen) / sizeof(uint64_t) < chunk_num) {
+    MS_LOG(ERROR) << "the offsets of the huffman chunks are incomplete.";
+    return RET_ERROR;
+  }
+  auto offsets = header + kFixedHeaderLen;
+  chunks->bits = offsets + chunk_num * sizeof(uint64_t);
+  chunks->bits_len = header_len - kFixedHeaderLen - chunk_num * sizeof(uint64_t);
+  chunks->offsets.resize(chunk_num);
+  uint64_t last_offset = 0;
+  for (size_t i = 0; i < chunk_num; ++i) {
+    chunks->offsets[i] = ReadUnaligned<uint64_t>(offsets + i * sizeof(uint64_t));
+    if (chunks->offsets[i] < last_offset || chunks->offsets[i] > chunks->bits_len) {
+      MS_LOG(ERROR) << "the offset of the huffman chunk " << i << " is invalid: " << chunks->offsets[i];
+      return RET_ERROR;
+    }
+    last_offset = chunks->offsets[i];
+  }
+  chunks->symbol_num = symbol_num;
+  chunks->chunk_symbols = chunk_symbols;
   return RET_OK;
 }
+}  // namespace
 
-STATUS HuffmanDecode::RebuildHuffmanTree(std::string keys, std::string codes, const HuffmanNodePtr &root) {
-  CHECK_NULL_RETURN(root);
-  HuffmanNodePtr cur_node;
-  HuffmanNodePtr tmp_node;
-  HuffmanNodePtr new_node;
-
-  auto huffman_keys = Str2Vec(std::move(keys));
-  auto huffman_codes = Str2Vec(std::move(codes));
-
-  for (size_t i = 0; i < huffman_codes.size(); ++i) {
-    auto key = stoi(huffman_keys[i]);
-    auto code = huffman_codes[i];
-    auto code_len = code.length();
-    cur_node = root;
-    for (size_t j = 0; j < code_len; ++j) {
-      if (code[j] == '0') {
-        tmp_node = cur_node->left;
-      } else if (code[j] == '1') {
-        tmp_node = cur_node->right;
-      } else {
-        MS_LOG(ERROR) << "find huffman code is not 0 or 1";
-        return RET_ERROR;
-      }
-
-      if (tmp_node == nullptr) {
-        new_node = new (std::nothrow) HuffmanNode();
-        if (new_node == nullptr) {
-          MS_LOG(ERROR) << "new HuffmanNode failed.";
-          return RET_MEMORY_FAILED;
-        }
-        new_node->left = nullptr;
-        new_node->right = nullptr;
-        new_node->parent = cur_node;
-
-        if (j == code_len - 1) {
-          new_node->key = key;
-          new_node->code = code;
-        }
-
-        if (code[j] == '0') {
-          cur_node->left = new_node;
-        } else {
-          cur_node->right = new_node;
-        }
-
-        tmp_node = new_node;
-      } else if (j == code_len - 1) {
-        MS_LOG(ERROR) << "the huffman code is incomplete.";
-        return RET_ERROR;
-      } else if (tmp_node->left == nullptr && tmp_node->right == nullptr) {
-        MS_LOG(ERROR) << "the huffman code is incomplete";
-        return RET_ERROR;
-      }
-      cur_node = tmp_node;
+STATUS HuffmanTable::Build(const char *keys, size_t keys_len, const char *codes, size_t codes_len) {
+  CHECK_NULL_RETURN(keys);
+  CHECK_NULL_RETURN(codes);
+  entries_.assign(1u << kRootBits, HuffmanTableEntry());
+  std::string key_str(keys, keys_len);
+  const char *key_pos = key_str.c_str();
+  const char *code_pos = codes;
+  const char *codes_end = codes + codes_len;
+  while (true) {
+    while (code_pos < codes_end && *code_pos == ' ') {
+      ++code_pos;
+    }
+    if (code_pos == codes_end) {
+      break;
     }
+    const char *code_end = code_pos;
+    while (code_end < codes_end && *code_end != ' ') {
+      ++code_end;
+    }
+    char *key_end = nullptr;
+    auto key = strtol(key_pos, &key_end, kDecimalBase);
+    if (key_end == key_pos) {
+      MS_LOG(ERROR) << "the huffman keys are fewer than the codes.";
+      return RET_ERROR;
+    }
+    key_pos = key_end;
+    auto ret = Insert(static_cast<int>(key), code_pos, static_cast<size_t>(code_end - code_pos));
+    if (ret != RET_OK) {
+      return ret;
+    }
+    code_pos = code_end;
   }
   return RET_OK;
 }
 
-STATUS HuffmanDecode::DoHuffmanDecompress(HuffmanNodePtr root, std::string encoded_data, std::string *decoded_str) {
-  CHECK_NULL_RETURN(decoded_str);
-  CHECK_NULL_RETURN(root);
-  HuffmanNodePtr cur_node = root;
-  bool pseudo_eof = false;
-  size_t pos = 0;
-  unsigned char flag;
-
-  decoded_str->clear();
-  while (pos < encoded_data.length()) {
-    auto u_char = static_cast<unsigned char>(encoded_data[pos]);
-    flag = 0x80;
-    for (size_t i = 0; i < 8; ++i) {  // traverse the 8 bit num, to find the leaf node
-      if (u_char & flag) {
-        cur_node = cur_node->right;
-      } else {
-        cur_node = cur_node->left;
-      }
-      CHECK_NULL_RETURN(cur_node);
-      if (cur_node->left == nullptr && cur_node->right == nullptr) {
-        auto key = cur_node->key;
-        if (key == PSEUDO_EOF) {
-          pseudo_eof = true;
-          break;
-        } else {
-          *decoded_str += static_cast<char>(cur_node->key);
-          cur_node = root;
-        }
+STATUS HuffmanTable::Insert(int key, const char *code, size_t code_len) {
+  auto code_bits = [code](size_t begin, size_t bit_num, size_t width, size_t *index) {
+    *index = 0;
+    for (size_t i = 0; i < bit_num; ++i) {
+      if (code[begin + i] != '0' && code[begin + i] != '1') {
+        MS_LOG(ERROR) << "find huffman code is not 0 or 1";
+        return false;
       }
-      flag = flag >> 1;
+      *index = (*index << 1) | static_cast<size_t>(code[begin + i] - '0');
     }
-    pos++;
-    if (pseudo_eof) {
-      break;
+    *index <<= width - bit_num;
+    return true;
+  };
+  if (code_len == 0) {
+    MS_LOG(ERROR) << "the huffman code of " << key << " is empty.";
+    return RET_ERROR;
+  }
+  size_t table = 0;
+  size_t width = kRootBits;
+  size_t depth = 0;
+  size_t index = 0;
+  while (code_len - depth > width) {
+    if (!code_bits(depth, width, width, &index)) {
+      return RET_ERROR;
+    }
+    auto &entry = entries_[table + index];
+    if (entry.kind == kEmpty) {
+      entry.kind = kSubTable;
+      entry.value = static_cast<int32_t>(entries_.size());
+      entry.bits = static_cast<uint8_t>(kSubBits);
+      entries_.resize(entries_.size() + (1u << kSubBits));
+    } else if (entry.kind != kSubTable) {
+      MS_LOG(ERROR) << "the huffman code is incomplete.";
+      return RET_ERROR;
     }
+    // The entries may have been moved by the resize.
+    const auto &sub_table = entries_[table + index];
+    table = static_cast<size_t>(sub_table.value);
+    depth += width;
+    width = sub_table.bits;
+  }
+  auto bit_num = code_len - depth;
+  if (!code_bits(depth, bit_num, width, &index)) {
+    return RET_ERROR;
+  }
+  // A code shorter than the table is repeated for all the bits following it.
+  for (size_t i = 0; i < (1u << (width - bit_num)); ++i) {
+    auto &entry = entries_[table + index + i];
+    if (entry.kind != kEmpty) {
+      MS_LOG(ERROR) << "the huffman code is incomplete.";
+      return RET_ERROR;
+    }
+    entry.kind = key == PSEUDO_EOF ? kEof : kSymbol;
+    entry.value = key;
+    entry.bits = static_cast<uint8_t>(bit_num);
   }
   return RET_OK;
 }
 
-void HuffmanDecode::FreeHuffmanNodeTree(HuffmanNodePtr root) {
-  if (root == nullptr) {
-    return;
+STATUS HuffmanDecode::DoHuffmanDecode(const std::string &input_str, void *decoded_data, size_t data_len) {
+  return DoHuffmanDecode(reinterpret_cast<const uint8_t *>(input_str.data()), input_str.size(), decoded_data,
+                         data_len);
+}
+
+STATUS HuffmanDecode::DoHuffmanDecode(const uint8_t *input, size_t input_len, void *decoded_data, size_t data_len,
+                                      const InnerContext *context) {
+  CHECK_NULL_RETURN(input);
+  if (decoded_data == nullptr) {
+    MS_LOG(ERROR) << "decoded_data is nullptr.";
+    return RET_ERROR;
   }
-  std::queue<HuffmanNodePtr> node_queue;
-  node_queue.push(root);
-  while (!node_queue.empty()) {
-    auto cur_node = node_queue.front();
-    node_queue.pop();
-    if (cur_node->left != nullptr) {
-      node_queue.push(cur_node->left);
-    }
-    if (cur_node->right != nullptr) {
-      node_queue.push(cur_node->right);
+  auto begin = reinterpret_cast<const char *>(input);
+  auto end = begin + input_len;
+  bool chunked = input_len > 0 && *begin == kHuffmanSeparator;
+  if (chunked) {
+    ++begin;
+  }
+  auto key_pos = FindSeparator(begin, end);
+  auto code_pos = key_pos == nullptr ? nullptr : FindSeparator(key_pos + 1, end);
+  if (key_pos == nullptr || code_pos == nullptr) {
+    MS_LOG(ERROR) << "not found '#' in input_str";
+    return RET_ERROR;
+  }
+  HuffmanTable table;
+  auto status = table.Build(begin, static_cast<size_t>(key_pos - begin), key_pos + 1,
+                            static_cast<size_t>(code_pos - key_pos - 1));
+  if (status != RET_OK) {
+    MS_LOG(ERROR) << "Rebuild huffman table failed.";
+    return status;
+  }
+  auto bits = reinterpret_cast<const uint8_t *>(code_pos + 1);
+  auto bits_len = static_cast<size_t>(end - code_pos - 1);
+  auto output = static_cast<int8_t *>(decoded_data);
+  if (!chunked) {
+    HuffmanBitReader reader(bits, bits_len);
+    size_t decoded_len = 0;
+    status = DecodeSymbols(table.entries(), &reader, output, data_len, true, &decoded_len);
+    if (status != RET_OK) {
+      MS_LOG(ERROR) << "DoHuffmanDecompress failed.";
     }
-    delete (cur_node);
+    return status;
+  }
+
+  HuffmanChunks chunks;
+  status = ParseChunks(bits, bits_len, data_len, &chunks);
+  if (status != RET_OK) {
+    return status;
   }
+  chunks.table = table.entries();
+  chunks.output = output;
+  if (context != nullptr && context->thread_pool_ != nullptr && chunks.offsets.size() > 1) {
+    chunks.task_num = std::min(context->thread_num_, static_cast<int>(chunks.offsets.size()));
+  }
+  status = chunks.task_num > 1 ? ParallelLaunch(context, DecodeChunksRun, &chunks, chunks.task_num)
+                               : DecodeChunksRun(&chunks, 0, 0, 0);
+  if (status != RET_OK) {
+    MS_LOG(ERROR) << "Decode the huffman chunks failed.";
+    return RET_ERROR;
+  }
+  return RET_OK;
 }
 }  // namespace lite
 }  // namespace mindspore
@@ -17,8 +17,8 @@
 #ifndef MINDSPORE_LITE_SRC_RUNTIME_HUFFMAN_DECODE_H_
 #define MINDSPORE_LITE_SRC_RUNTIME_HUFFMAN_DECODE_H_
 
+#include <cstdint>
 #include <cstring>
-#include <utility>
 #include <string>
 #include <vector>
 
@@ -28,17 +28,39 @@
 namespace mindspore {
 namespace lite {
 const int PSEUDO_EOF = 128;
+// The huffman stream is `keys#codes#bits`, in which the keys and the codes are separated by spaces, and the bits end
+// with the code of PSEUDO_EOF. The chunked stream is `#keys#codes#header bits`, which never starts like the former one
+// since the keys are not empty. Its header is the uint64 symbol number, the uint32 symbol number of a chunk, the uint32
+// chunk number and the uint64 byte offset of each chunk in the bits. Every chunk starts at a byte and has no
+// PSEUDO_EOF, so that the chunks can be decoded in parallel.
+constexpr char kHuffmanSeparator = '#';
+constexpr size_t kHuffmanChunkSymbols = 64 * 1024;
 
-struct HuffmanNode {
-  int key;
-  unsigned int freq;
-  std::string code;
-  HuffmanNode *left = nullptr;
-  HuffmanNode *right = nullptr;
-  HuffmanNode *parent = nullptr;
+struct InnerContext;
+
+struct HuffmanTableEntry {
+  int32_t value = 0;  // the key of the symbol, or the offset of the sub table
+  uint8_t bits = 0;   // the code bits of the symbol in this level, or the index bits of the sub table
+  uint8_t kind = 0;
 };
 
-using HuffmanNodePtr = HuffmanNode *;
+// The multi-level lookup table of the huffman codes. The root table is indexed by the first kRootBits bits of the
+// stream, and a code longer than that goes on to a sub table indexed by the next kSubBits bits, and so on.
+class HuffmanTable {
+ public:
+  enum EntryKind : uint8_t { kEmpty = 0, kSymbol, kEof, kSubTable };
+  static constexpr size_t kRootBits = 10;
+  static constexpr size_t kSubBits = 6;
+
+  STATUS Build(const char *keys, size_t keys_len, const char *codes, size_t codes_len);
+
+  const HuffmanTableEntry *entries() const { return entries_.data(); }
+
+ private:
+  STATUS Insert(int key, const char *code, size_t code_len);
+
+  std::vector<HuffmanTableEntry> entries_;
+};
 
 class HuffmanDecode {
  public:
@@ -46,34 +68,13 @@ class HuffmanDecode {
 
   static STATUS DoHuffmanDecode(const std::string &input_str, void *decoded_data, size_t data_len);
 
+  // The chunks of the chunked stream are decoded on the thread pool of the context if it is given.
+  static STATUS DoHuffmanDecode(const uint8_t *input, size_t input_len, void *decoded_data, size_t data_len,
+                                const InnerContext *context = nullptr);
+
  private:
   HuffmanDecode() = default;
-
-  static void FreeHuffmanNodeTree(HuffmanNodePtr root);
-
-  static STATUS RebuildHuffmanTree(std::string key, std::string code, const HuffmanNodePtr &root);
-
-  static STATUS DoHuffmanDecompress(HuffmanNodePtr root, std::string encoded_data, std::string *decoded_str);
-
-  static std::vector<std::string> Str2Vec(std::string s) {
-    size_t i = 0;
-    std::vector<std::string> vec;
-    while (i < s.length()) {
-      size_t j = i;
-      while (j < s.length() && s[j] != ' ') {
-        j++;
-      }
-      if (j != i) {
-        vec.push_back(s.substr(i, j - i));
-        i = j + 1;
-      } else {
-        i = j;
-      }
-    }
-    return vec;
-  }
 };
-
 }  // namespace lite
 }  // namespace mindspore
 #endif  // MINDSPORE_LITE_SRC_RUNTIME_HUFFMAN_DECODE_H_
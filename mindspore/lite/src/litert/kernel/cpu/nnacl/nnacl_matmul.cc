@@ -15,11 +15,13 @@
  */
 
 #include "nnacl/nnacl_matmul.h"
+#include <algorithm>
 #include "nnacl/nnacl_manager.h"
 #include "include/errorcode.h"
 #include "nnacl/kernel/matmul_base.h"
 #include "nnacl/cxx_utils.h"
 #include "src/litert/pack_weight_manager.h"
+#include "src/litert/weight_decoder.h"
 #if defined(PARALLEL_INFERENCE) && defined(ENABLE_MINDRT)
 #include "thread/parallel_thread_pool_manager.h"
 #endif
@@ -43,7 +45,12 @@ int MatmulKernel::Prepare() {
   matmul->infer_shape_ = InferShapeDone();
   matmul->a_const_ = in_tensors_[FIRST_INPUT]->IsConst() && !op_parameter_->is_train_session_;
   matmul->b_const_ = in_tensors_[SECOND_INPUT]->IsConst() && !op_parameter_->is_train_session_;
-  int ret = kernel_->Prepare(kernel_);
+  int ret = InitWeightQuant();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Init the weight quant of matmul failed. Kernel: " << name();
+    return ret;
+  }
+  ret = kernel_->Prepare(kernel_);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "NNACL matmul/fc prepare failed. Kernel: " << name() << ", ret: " << ret;
     return ret;
@@ -55,6 +62,38 @@ int MatmulKernel::Prepare() {
   return ReSize();
 }
 
+int MatmulKernel::InitWeightQuant() {
+  // the weight kept in int8 by WeightDecoder::DequantNode is dequantized in registers by the nnacl kernel.
+  auto weight = in_tensors_[SECOND_INPUT];
+  if (weight->data_type() != kNumberTypeInt8) {
+    return RET_OK;
+  }
+  auto quant_params = weight->quant_params();
+  auto param = reinterpret_cast<MatMulParameter *>(op_parameter_);
+  if (op_parameter_->type_ != PrimitiveType_MatMulFusion || quant_params.empty() || weight->shape().size() != C2NUM ||
+      !weight->IsConst() || op_parameter_->is_train_session_ || param->a_transpose_) {
+    MS_LOG(ERROR) << "The int8 weight of " << name() << " can not be dequantized by the fp32 matmul.";
+    return RET_ERROR;
+  }
+  int col = weight->shape().at(param->b_transpose_ ? 0 : 1);
+  int deep = weight->shape().at(param->b_transpose_ ? 1 : 0);
+  auto ret = lite::WeightDecoder::GetFusedDequantParams(weight, col, &weight_scales_, &weight_zero_points_);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  bool symmetric = std::all_of(weight_zero_points_.begin(), weight_zero_points_.end(),
+                               [](float zero_point) { return zero_point == 0; });
+  MatmulStruct *matmul = reinterpret_cast<MatmulStruct *>(kernel_);
+  matmul->weight_quant_.enable_ = true;
+  // the int4 weight is stored unpacked in int8, the kernel repacks it if all the weight is within [-8, 7].
+  matmul->weight_quant_.is_int4_ = std::all_of(quant_params.begin(), quant_params.end(),
+                                               [](const lite::LiteQuantParam &quant) { return quant.bitNum <= 4; });
+  matmul->weight_quant_.group_size_ = deep;
+  matmul->weight_quant_.scales_ = weight_scales_.data();
+  matmul->weight_quant_.zero_points_ = symmetric ? nullptr : weight_zero_points_.data();
+  return RET_OK;
+}
+
 int MatmulKernel::ReSize() {
   CHECK_NULL_RETURN(kernel_);
   MatmulStruct *matmul = reinterpret_cast<MatmulStruct *>(kernel_);
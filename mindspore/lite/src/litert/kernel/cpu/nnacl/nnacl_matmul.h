@@ -31,6 +31,11 @@ class MatmulKernel : public NNACLKernel {
   int ReSize() override;
   int Prepare() override;
   int PreparePackedWeight(const lite::Tensor *tensor) override;
+
+ private:
+  int InitWeightQuant();
+  std::vector<float> weight_scales_;
+  std::vector<float> weight_zero_points_;
 };
 }  // namespace mindspore::nnacl
 #endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_NNACL_MATMUL_H_
@@ -184,7 +184,7 @@ int LiteSession::ConvertTensorsData(const lite::LiteModel *model, size_t tensor_
   int compress_type = src_tensor->handler()->weightQuantCompressType();
   int ret = RET_NO_CHANGE;
   if (compress_type != kFSEInfer) {
-    ret = WeightDecoder::DecompressTensor(*src_tensor, dst_tensor);
+    ret = WeightDecoder::DecompressTensor(*src_tensor, dst_tensor, context_.get());
   }
   if (ret == RET_NO_CHANGE) {
     if (dst_tensor->Size() == 0 || src_tensor->length() < dst_tensor->Size()) {
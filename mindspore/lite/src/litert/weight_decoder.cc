@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include "src/litert/weight_decoder.h"
@@ -111,7 +112,8 @@ int WeightDecoder::DecodeKMeansWeight(lite::Tensor *tensor, TypeId dst_data_type
   return RET_OK;
 }
 
-int WeightDecoder::DecodeHuffmanCode(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor) {
+int WeightDecoder::DecodeHuffmanCode(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor,
+                                     const InnerContext *context) {
   MS_ASSERT(src_tensor.handler() != nullptr);
   MS_ASSERT(src_tensor.data() != nullptr);
   MS_ASSERT(dst_tensor != nullptr);
@@ -121,8 +123,6 @@ int WeightDecoder::DecodeHuffmanCode(const SchemaTensorWrapper &src_tensor, lite
   if (src_tensor.data() == nullptr) {
     return RET_NO_CHANGE;
   }
-  auto data = reinterpret_cast<const char *>(src_tensor.data());
-  std::string encode_str(data, src_tensor.length());
   dst_tensor->FreeData();
   dst_tensor->set_data(nullptr);
   auto ret = dst_tensor->MallocData();
@@ -132,7 +132,8 @@ int WeightDecoder::DecodeHuffmanCode(const SchemaTensorWrapper &src_tensor, lite
   }
   auto dst_data = dst_tensor->data();
   MS_ASSERT(dst_data != nullptr);
-  ret = HuffmanDecode::DoHuffmanDecode(encode_str, dst_data, dst_tensor->Size());
+  ret = HuffmanDecode::DoHuffmanDecode(static_cast<const uint8_t *>(src_tensor.data()), src_tensor.length(), dst_data,
+                                       dst_tensor->Size(), context);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "DoHuffmanDecode failed.";
     return ret;
@@ -175,12 +176,13 @@ int WeightDecoder::UnPackToInt(const SchemaTensorWrapper &src_tensor, lite::Tens
   }
 }
 
-int WeightDecoder::UnPack(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor) {
+int WeightDecoder::UnPack(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor,
+                          const InnerContext *context) {
   MS_ASSERT(src_tensor.handler() != nullptr);
   MS_ASSERT(src_tensor.data() != nullptr);
   STATUS ret = RET_OK;
   if (src_tensor.handler()->enableHuffmanCode()) {
-    ret = WeightDecoder::DecodeHuffmanCode(src_tensor, dst_tensor);
+    ret = WeightDecoder::DecodeHuffmanCode(src_tensor, dst_tensor, context);
     if (ret != RET_OK && ret != RET_NO_CHANGE) {
       MS_LOG(ERROR) << "Decode huffman code failed: " << ret;
     }
@@ -485,7 +487,8 @@ bool NeedBitUppackCheck(const SchemaTensorWrapper &src_tensor) {
 }
 
 int WeightDecoder::DequantNode(const OpParameter *op_parameter, const std::vector<Tensor *> &in_tensors,
-                               TypeId dst_data_type, const std::string &model_version, bool float_mode) {
+                               TypeId dst_data_type, const std::string &model_version, bool float_mode,
+                               bool fused_dequant) {
 #ifndef WEIGHT_DECODE_CLIP
   if (op_parameter->quant_type_ != static_cast<int>(schema::QuantType_QUANT_WEIGHT) &&
       !(op_parameter->quant_type_ == static_cast<int>(schema::QuantType_QUANT_ALL) && float_mode)) {
@@ -494,6 +497,10 @@ int WeightDecoder::DequantNode(const OpParameter *op_parameter, const std::vecto
   int index = 0;
   for (auto &tensor : in_tensors) {
     MS_CHECK_TRUE_RET(tensor != nullptr, RET_ERROR);
+    if (fused_dequant && dst_data_type == kNumberTypeFloat32 && IsFusedDequantWeight(op_parameter, tensor, index)) {
+      index++;
+      continue;
+    }
     auto preferred_dim = GetPreferredDim(in_tensors, op_parameter, index++, tensor->shape(), model_version);
     auto ret = WeightDecoder::DequantTensor(tensor, preferred_dim, dst_data_type);
     if (ret != RET_OK && ret != RET_NO_CHANGE) {
@@ -514,13 +521,78 @@ int WeightDecoder::DequantNode(const OpParameter *op_parameter, const std::vecto
 #endif
 }
 
-int WeightDecoder::DecompressTensor(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor) {
+bool WeightDecoder::IsFusedDequantWeight(const OpParameter *op_parameter, const Tensor *tensor, int index) {
+#if !defined(WEIGHT_DECODE_CLIP) && defined(ENABLE_AVX)
+  MS_ASSERT(op_parameter != nullptr && tensor != nullptr);
+  if (op_parameter->type_ != schema::PrimitiveType_MatMulFusion || index != kWeightIndex) {
+    return false;
+  }
+  auto matmul_parameter = reinterpret_cast<const MatMulParameter *>(op_parameter);
+  auto shape = tensor->shape();
+  if (matmul_parameter->a_transpose_ || !tensor->IsConst() || tensor->data_type() != kNumberTypeInt8 ||
+      shape.size() != DIMENSION_2D || !tensor->quant_clusters().empty()) {
+    return false;
+  }
+  auto quant_params = tensor->quant_params();
+  if (quant_params.empty() || !quant_params.front().inited) {
+    return false;
+  }
+  // the per-channel params of the weight of matmul are always along the column.
+  auto col = shape.at(matmul_parameter->b_transpose_ ? 0 : 1);
+  if (quant_params.size() != kPerTensor && quant_params.size() != static_cast<size_t>(col)) {
+    return false;
+  }
+  return std::all_of(quant_params.begin(), quant_params.end(),
+                     [](const LiteQuantParam &param) {
+                       return param.mean_corr == 0 || (param.scale != 0 && param.var_corr != 0);
+                     });
+#else
+  return false;
+#endif
+}
+
+int WeightDecoder::GetFusedDequantParams(const Tensor *tensor, int col, std::vector<float> *scales,
+                                         std::vector<float> *zero_points) {
+#ifndef WEIGHT_DECODE_CLIP
+  MS_ASSERT(tensor != nullptr && scales != nullptr && zero_points != nullptr);
+  auto quant_params = tensor->quant_params();
+  if (quant_params.size() != kPerTensor && quant_params.size() != static_cast<size_t>(col)) {
+    MS_LOG(ERROR) << tensor->tensor_name() << " has " << quant_params.size() << " quant params for " << col
+                  << " columns.";
+    return RET_ERROR;
+  }
+  scales->resize(col);
+  zero_points->resize(col);
+  for (int i = 0; i < col; ++i) {
+    if (quant_params.size() == kPerTensor) {
+      // the same as DequantPerLayerData, which ignores the corrections.
+      scales->at(i) = static_cast<float>(quant_params.front().scale);
+      zero_points->at(i) = static_cast<float>(quant_params.front().zeroPoint);
+      continue;
+    }
+    // (q - zp) * scale * var_corr + mean_corr of DequantPerChannelData.
+    const auto &param = quant_params.at(i);
+    auto var_corr = (param.var_corr < 0 || param.var_corr > kMaxVarCorr) ? 1.0f : param.var_corr;
+    auto scale = static_cast<float>(param.scale) * var_corr;
+    scales->at(i) = scale;
+    zero_points->at(i) = param.zeroPoint - (scale == 0 ? 0 : param.mean_corr / scale);
+  }
+  return RET_OK;
+#else
+  MS_LOG(ERROR) << "Do not support fused dequant params.";
+  return RET_NOT_SUPPORT;
+#endif
+}
+
+int WeightDecoder::DecompressTensor(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor,
+                                    const InnerContext *context) {
   MS_ASSERT(src_tensor.handler() != nullptr);
   MS_ASSERT(dst_tensor != nullptr);
 #ifndef WEIGHT_DECODE_CLIP
   if (src_tensor.handler()->weightQuantCompressType() == schema::WeightQuantCompressType_FSE ||
       src_tensor.handler()->weightQuantCompressType() == schema::WeightQuantCompressType_FSE_INT) {
-    return quant::FSEDecoder::DeCompress(src_tensor, dst_tensor, src_tensor.handler()->weightQuantCompressType());
+    return quant::FSEDecoder::DeCompress(src_tensor, dst_tensor, src_tensor.handler()->weightQuantCompressType(),
+                                         context);
   } else if (src_tensor.handler()->weightQuantCompressType() == schema::WeightQuantCompressType_INDEXING) {
     return IndexingDecompress(src_tensor, dst_tensor);
   } else if (src_tensor.handler()->weightQuantCompressType() == schema::WeightQuantCompressType_SPARSE) {
@@ -529,7 +601,7 @@ int WeightDecoder::DecompressTensor(const SchemaTensorWrapper &src_tensor, lite:
   if (!NeedBitUppackCheck(src_tensor)) {
     return RET_NO_CHANGE;
   } else {
-    return WeightDecoder::UnPack(src_tensor, dst_tensor);
+    return WeightDecoder::UnPack(src_tensor, dst_tensor, context);
   }
 #else
   if (src_tensor.handler()->weightQuantCompressType() != schema::WeightQuantCompressType_NONE) {
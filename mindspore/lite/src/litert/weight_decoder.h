@@ -30,6 +30,7 @@
 #include "src/common/utils.h"
 #include "src/tensor.h"
 #include "src/litert/lite_model.h"
+#include "src/litert/inner_context.h"
 
 static constexpr int kPerTensor = 1;
 static constexpr int kBitNumMix = 0;
@@ -44,9 +45,17 @@ namespace mindspore::lite {
 
 class MS_API WeightDecoder {
  public:
+  // The weights which the fp32 cpu kernels dequantize in registers are kept quantized if fused_dequant is true.
   static int DequantNode(const OpParameter *op_parameter, const std::vector<Tensor *> &in_tensors, TypeId dst_data_type,
-                         const std::string &model_version, bool float_mode);
-  static int DecompressTensor(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor);
+                         const std::string &model_version, bool float_mode, bool fused_dequant = false);
+  // The int8 weight of MatMulFusion quantized per tensor or per column, whose dequantization is fused into the matmul.
+  static bool IsFusedDequantWeight(const OpParameter *op_parameter, const Tensor *tensor, int index);
+  // The column c is dequantized by (q - zero_points[c]) * scales[c], which folds in var_corr and mean_corr.
+  static int GetFusedDequantParams(const Tensor *tensor, int col, std::vector<float> *scales,
+                                   std::vector<float> *zero_points);
+  // The context is optional, its thread pool decodes the compressed weights in parallel if they are chunked.
+  static int DecompressTensor(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor,
+                              const InnerContext *context = nullptr);
 
   static int CompareVersion(const std::string &version1, const std::string &version2) {
     std::istringstream iss1(version1);
@@ -122,9 +131,10 @@ class MS_API WeightDecoder {
 
   static int UnPackToInt(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor);
 
-  static int DecodeHuffmanCode(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor);
+  static int DecodeHuffmanCode(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor,
+                               const InnerContext *context);
 
-  static int UnPack(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor);
+  static int UnPack(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor, const InnerContext *context);
 
   static STATUS SparseDecompress(const SchemaTensorWrapper &src_tensor, Tensor *dst_tensor);
 
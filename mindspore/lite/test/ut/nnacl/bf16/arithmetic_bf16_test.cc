@@ -0,0 +1,91 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/bf16/arithmetic_bf16.h"
+#include "nnacl/bf16/cast_bf16.h"
+#include "nnacl/errorcode.h"
+
+namespace mindspore {
+class ArithmeticBf16Test : public mindspore::CommonTest {
+ public:
+  ArithmeticBf16Test() {}
+};
+
+namespace {
+// several tiles of the conversion and a tail of the vector loop.
+constexpr int kSize = 3 * BF16_TILE + 13;
+
+using ElementBf16Func = int (*)(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size);
+using ElementOptBf16Func = int (*)(const uint16_t *in0, const uint16_t *in1, uint16_t *out, int size,
+                                   bool first_scalar);
+
+struct ArithmeticCase {
+  std::string name;
+  ElementBf16Func func;
+  ElementOptBf16Func opt_func;
+  std::function<float(float, float)> ref;
+};
+
+std::vector<uint16_t> RandomBf16(size_t size, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(0.5f, 8.0f);
+  std::uniform_int_distribution<int> sign(0, 1);
+  std::vector<uint16_t> data(size);
+  for (auto &value : data) {
+    value = Float32ToBf16Scalar(sign(gen) == 0 ? dist(gen) : -dist(gen));
+  }
+  return data;
+}
+
+// the fp32 result of the widened bf16 is rounded to bf16 once.
+uint16_t RefBf16(const ArithmeticCase &arith_case, uint16_t in0, uint16_t in1) {
+  return Float32ToBf16Scalar(arith_case.ref(Bf16ToFloat32Scalar(in0), Bf16ToFloat32Scalar(in1)));
+}
+}  // namespace
+
+/// Feature: the bf16 arithmetic of nnacl.
+/// Description: add, sub, mul and div two bf16 tensors of the same shape, and a tensor with a scalar on either side.
+/// Expectation: every element is the fp32 result of the widened inputs rounded to bf16 once.
+TEST_F(ArithmeticBf16Test, ElementBf16) {
+  const std::vector<ArithmeticCase> cases = {
+    {"add", ElementAddBf16, ElementOptAddBf16, [](float x, float y) { return x + y; }},
+    {"sub", ElementSubBf16, ElementOptSubBf16, [](float x, float y) { return x - y; }},
+    {"mul", ElementMulBf16, ElementOptMulBf16, [](float x, float y) { return x * y; }},
+    {"div", ElementDivBf16, ElementOptDivBf16, [](float x, float y) { return x / y; }},
+  };
+  auto in0 = RandomBf16(kSize, 1);
+  auto in1 = RandomBf16(kSize, 2);
+  std::vector<uint16_t> out(kSize);
+  for (const auto &arith_case : cases) {
+    ASSERT_EQ(arith_case.func(in0.data(), in1.data(), out.data(), kSize), NNACL_OK);
+    for (int i = 0; i < kSize; ++i) {
+      ASSERT_EQ(out[i], RefBf16(arith_case, in0[i], in1[i])) << arith_case.name << " " << i;
+    }
+    ASSERT_EQ(arith_case.opt_func(in0.data(), in1.data(), out.data(), kSize, true), NNACL_OK);
+    for (int i = 0; i < kSize; ++i) {
+      ASSERT_EQ(out[i], RefBf16(arith_case, in0[0], in1[i])) << arith_case.name << " first scalar " << i;
+    }
+    ASSERT_EQ(arith_case.opt_func(in0.data(), in1.data(), out.data(), kSize, false), NNACL_OK);
+    for (int i = 0; i < kSize; ++i) {
+      ASSERT_EQ(out[i], RefBf16(arith_case, in0[i], in1[0])) << arith_case.name << " second scalar " << i;
+    }
+  }
+}
+}  // namespace mindspore
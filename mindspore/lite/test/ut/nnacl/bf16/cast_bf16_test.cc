@@ -0,0 +1,111 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/bf16/cast_bf16.h"
+
+namespace mindspore {
+class CastBf16Test : public mindspore::CommonTest {
+ public:
+  CastBf16Test() {}
+};
+
+namespace {
+float FromBits(uint32_t bits) {
+  float value;
+  memcpy(&value, &bits, sizeof(float));
+  return value;
+}
+
+// the fp32 inputs and the bf16 expected by the round to nearest even.
+struct RoundCase {
+  uint32_t input;
+  uint16_t expect;
+};
+
+const std::vector<RoundCase> kRoundCases = {
+  {0x3F800000, 0x3F80},  // 1.0 is exact
+  {0x3F800001, 0x3F80},  // below the half rounds down
+  {0x3F807FFF, 0x3F80},
+  {0x3F808000, 0x3F80},  // a tie rounds to the even 0x3F80
+  {0x3F818000, 0x3F82},  // a tie rounds to the even 0x3F82
+  {0x3F808001, 0x3F81},  // above the half rounds up
+  {0xBF808000, 0xBF80},  // the ties of the negative values
+  {0xBF818000, 0xBF82},
+  {0x7F7FFFFF, 0x7F80},  // the max fp32 rounds up to inf
+  {0x7F800000, 0x7F80},  // inf
+  {0xFF800000, 0xFF80},  // -inf
+  {0x80000000, 0x8000},  // -0
+  {0x00008000, 0x0000},  // a tie of the denormals rounds to the even zero
+  {0x00018000, 0x0002},
+  {0x7FC00000, BF16_QUIET_NAN},  // the nans become the quiet nan, never inf
+  {0x7F800001, BF16_QUIET_NAN},
+  {0xFFFFFFFF, BF16_QUIET_NAN},
+};
+}  // namespace
+
+/// Feature: the bf16 conversion of nnacl.
+/// Description: round the ties, the values around them, the inf, the max fp32 and the nans by the scalar and by the
+/// vector loop, in which the cases are repeated so that the vector loop sees each of them at every lane.
+/// Expectation: both round to the nearest even, and every nan becomes the quiet nan.
+TEST_F(CastBf16Test, Float32ToBf16Round) {
+  for (const auto &round_case : kRoundCases) {
+    ASSERT_EQ(Float32ToBf16Scalar(FromBits(round_case.input)), round_case.expect) << std::hex << round_case.input;
+  }
+  constexpr int kLanes = 9;
+  std::vector<float> input;
+  std::vector<uint16_t> expect;
+  for (int lane = 0; lane < kLanes; ++lane) {
+    input.push_back(1.0f);
+    expect.push_back(0x3F80);
+    for (const auto &round_case : kRoundCases) {
+      input.push_back(FromBits(round_case.input));
+      expect.push_back(round_case.expect);
+    }
+  }
+  std::vector<uint16_t> output(input.size());
+  Float32ToBf16(input.data(), output.data(), static_cast<int>(input.size()));
+  ASSERT_EQ(output, expect);
+}
+
+/// Feature: the bf16 conversion of nnacl.
+/// Description: widen every bf16 to fp32, then round it back, by both the scalar and the vector loop.
+/// Expectation: every bf16 but the nans is restored, the nans are widened to nans.
+TEST_F(CastBf16Test, Bf16RoundTrip) {
+  constexpr int kBf16Num = 1 << 16;
+  std::vector<uint16_t> input(kBf16Num);
+  for (int i = 0; i < kBf16Num; ++i) {
+    input[i] = static_cast<uint16_t>(i);
+  }
+  std::vector<float> widened(kBf16Num);
+  Bf16ToFloat32(input.data(), widened.data(), kBf16Num);
+  std::vector<uint16_t> output(kBf16Num);
+  Float32ToBf16(widened.data(), output.data(), kBf16Num);
+  for (int i = 0; i < kBf16Num; ++i) {
+    float expect = Bf16ToFloat32Scalar(input[i]);
+    ASSERT_EQ(memcmp(&widened[i], &expect, sizeof(float)), 0) << i;
+    if (std::isnan(widened[i])) {
+      ASSERT_EQ(output[i], BF16_QUIET_NAN) << i;
+    } else {
+      ASSERT_EQ(output[i], input[i]) << i;
+      ASSERT_EQ(Float32ToBf16Scalar(widened[i]), input[i]) << i;
+    }
+  }
+}
+}  // namespace mindspore
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/bf16/cast_bf16.h"
+#include "nnacl/bf16/layer_norm_bf16.h"
+#include "nnacl/errorcode.h"
+#include "nnacl/fp32/layer_norm_fp32.h"
+
+namespace mindspore {
+class LayerNormBf16Test : public mindspore::CommonTest {
+ public:
+  LayerNormBf16Test() {}
+};
+
+namespace {
+std::vector<uint16_t> RandomBf16(size_t size, float low, float high, uint32_t seed, std::vector<float> *widened) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(low, high);
+  std::vector<uint16_t> data(size);
+  widened->resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = Float32ToBf16Scalar(dist(gen));
+    (*widened)[i] = Bf16ToFloat32Scalar(data[i]);
+  }
+  return data;
+}
+
+// the layer norm of bf16 against the fp32 layer norm of the widened inputs, in which the params of params_inner_size
+// repeat in every norm of norm_inner_size.
+void CheckLayerNorm(int norm_outer_size, int norm_inner_size, int params_inner_size, int thread_num) {
+  LayerNormComputeParam param{};
+  param.epsilon_ = 1e-5f;
+  param.norm_inner_size_ = norm_inner_size;
+  param.norm_outer_size_ = norm_outer_size;
+  param.params_inner_size_ = params_inner_size;
+  param.params_outer_size_ = norm_outer_size * (norm_inner_size / params_inner_size);
+  size_t size = static_cast<size_t>(norm_outer_size) * norm_inner_size;
+  std::vector<float> src_fp32;
+  std::vector<float> gamma_fp32;
+  std::vector<float> beta_fp32;
+  auto src = RandomBf16(size, 1.0f, 5.0f, norm_inner_size, &src_fp32);
+  auto gamma = RandomBf16(params_inner_size, 0.5f, 1.5f, 1, &gamma_fp32);
+  auto beta = RandomBf16(params_inner_size, -1.0f, 1.0f, 2, &beta_fp32);
+
+  std::vector<uint16_t> dst(size);
+  std::vector<float> mean(norm_outer_size);
+  std::vector<float> variance(norm_outer_size);
+  for (int task_id = 0; task_id < thread_num; ++task_id) {
+    ASSERT_EQ(LayerNormBf16(src.data(), gamma.data(), beta.data(), dst.data(), mean.data(), variance.data(), &param,
+                            task_id, thread_num),
+              NNACL_OK);
+  }
+  std::vector<float> expect(size);
+  std::vector<float> expect_mean(norm_outer_size);
+  std::vector<float> expect_variance(norm_outer_size);
+  ASSERT_EQ(LayerNorm(src_fp32.data(), gamma_fp32.data(), beta_fp32.data(), expect.data(), expect_mean.data(),
+                      expect_variance.data(), &param, 0, 1),
+            NNACL_OK);
+  for (int i = 0; i < norm_outer_size; ++i) {
+    ASSERT_NEAR(mean[i], expect_mean[i], 1e-4);
+    ASSERT_NEAR(variance[i], expect_variance[i], 1e-3);
+  }
+  for (size_t i = 0; i < size; ++i) {
+    // the output is rounded to bf16 once, which keeps 8 bits of the mantissa.
+    ASSERT_NEAR(Bf16ToFloat32Scalar(dst[i]), expect[i], std::fabs(expect[i]) / 128 + 1e-3) << i;
+  }
+}
+}  // namespace
+
+/// Feature: the bf16 layer norm of nnacl.
+/// Description: normalize within a tile and across several tiles, with the params of the whole norm and of a part of
+/// it, split to several threads.
+/// Expectation: the output is the fp32 layer norm of the widened inputs within a bf16 rounding, and the mean and the
+/// variance stay in fp32.
+TEST_F(LayerNormBf16Test, LayerNorm) {
+  CheckLayerNorm(5, 24, 24, 1);
+  CheckLayerNorm(7, 3 * BF16_TILE + 9, 3 * BF16_TILE + 9, 3);
+  CheckLayerNorm(4, 64, 16, 2);
+}
+}  // namespace mindspore
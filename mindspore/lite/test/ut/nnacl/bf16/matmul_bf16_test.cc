@@ -0,0 +1,149 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/bf16/cast_bf16.h"
+#include "nnacl/bf16/matmul_bf16.h"
+#ifdef ENABLE_AVX
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+
+namespace mindspore {
+class MatmulBf16Test : public mindspore::CommonTest {
+ public:
+  MatmulBf16Test() {}
+};
+
+namespace {
+// the deeps cover the unrolled loops of both avx2 and avx512 and the tails after them.
+const std::vector<int> kDeeps = {1, 7, 8, 15, 16, 17, 31, 32, 63, 64, 65, 100, 129};
+
+std::vector<uint16_t> RandomBf16(size_t size, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+  std::vector<uint16_t> data(size);
+  for (auto &value : data) {
+    value = Float32ToBf16Scalar(dist(gen));
+  }
+  return data;
+}
+
+// the fp32 reference of the dot product of the widened bf16, which is accumulated in double.
+double RefDot(const uint16_t *a, const uint16_t *b, int deep, double *abs_sum) {
+  double dot = 0;
+  *abs_sum = 0;
+  for (int d = 0; d < deep; ++d) {
+    double product = static_cast<double>(Bf16ToFloat32Scalar(a[d])) * Bf16ToFloat32Scalar(b[d]);
+    dot += product;
+    *abs_sum += std::fabs(product);
+  }
+  return dot;
+}
+
+// the products of two bf16 are exact in fp32, so only the order of the fp32 accumulation differs from the reference.
+void CheckDotFunc(Bf16DotFunc dot_func) {
+  for (int deep : kDeeps) {
+    for (int rows = 1; rows <= BF16_MATMUL_ROW_TILE; ++rows) {
+      // the rows of a are apart by a stride longer than the deep.
+      int a_stride = deep + 3;
+      auto a = RandomBf16(static_cast<size_t>(rows) * a_stride, deep * 10 + rows);
+      auto b = RandomBf16(deep, deep);
+      std::vector<float> dots(BF16_MATMUL_ROW_TILE, NAN);
+      dot_func(a.data(), a_stride, rows, b.data(), deep, dots.data());
+      for (int r = 0; r < rows; ++r) {
+        double abs_sum = 0;
+        double expect = RefDot(a.data() + r * a_stride, b.data(), deep, &abs_sum);
+        ASSERT_NEAR(dots[r], expect, 1e-5 * abs_sum) << "deep " << deep << " rows " << rows << " row " << r;
+      }
+      // the dot products out of `rows` are not written.
+      for (int r = rows; r < BF16_MATMUL_ROW_TILE; ++r) {
+        ASSERT_TRUE(std::isnan(dots[r]));
+      }
+    }
+  }
+}
+}  // namespace
+
+/// Feature: the bf16 matmul of nnacl.
+/// Description: the dot products of the C code for 1 to 4 rows and the deeps around the tiles.
+/// Expectation: the same as the fp32 reference of the widened bf16.
+TEST_F(MatmulBf16Test, DotC) { CheckDotFunc(Bf16DotC); }
+
+#ifdef ENABLE_AVX
+/// Feature: the bf16 matmul of nnacl.
+/// Description: the dot products of avx2, which widens bf16 to fp32 and accumulates by fma.
+/// Expectation: the same as the fp32 reference of the widened bf16.
+TEST_F(MatmulBf16Test, DotAvx) {
+  (void)IntelX86CpuInfoInit();
+  if (!X86_Avx_Support()) {
+    return;
+  }
+  CheckDotFunc(Bf16DotAvx);
+}
+#endif
+
+#ifdef ENABLE_AVX512_BF16
+/// Feature: the bf16 matmul of nnacl.
+/// Description: the dot products of vdpbf16ps, run only on the cpus with avx512 bf16.
+/// Expectation: the same as the fp32 reference of the widened bf16.
+TEST_F(MatmulBf16Test, DotAvx512Bf16) {
+  (void)IntelX86CpuInfoInit();
+  if (!X86_Avx512Bf16_Support()) {
+    return;
+  }
+  CheckDotFunc(Bf16DotAvx512Bf16);
+}
+#endif
+
+/// Feature: the bf16 matmul of nnacl.
+/// Description: multiply a of several row tiles and a tail by the transposed b, into c with a row stride longer than
+/// the col, by the dot function chosen for the cpu.
+/// Expectation: c is the fp32 reference rounded to bf16, within one rounding of the accumulation, and the padding of
+/// c is not touched.
+TEST_F(MatmulBf16Test, MatMulBf16) {
+  constexpr int kRow = 11;
+  constexpr int kCol = 5;
+  constexpr int kDeep = 77;
+  constexpr int kStride = kCol + 2;
+  constexpr uint16_t kPadding = 0xABCD;
+  auto a = RandomBf16(kRow * kDeep, 1);
+  auto b = RandomBf16(kDeep * kCol, 2);
+  std::vector<uint16_t> b_trans(kCol * kDeep);
+  TransposeBf16(b.data(), b_trans.data(), kDeep, kCol);
+  for (int d = 0; d < kDeep; ++d) {
+    for (int j = 0; j < kCol; ++j) {
+      ASSERT_EQ(b_trans[j * kDeep + d], b[d * kCol + j]);
+    }
+  }
+  std::vector<uint16_t> c(kRow * kStride, kPadding);
+  MatMulBf16(a.data(), b_trans.data(), c.data(), kRow, kCol, kDeep, kStride);
+  for (int i = 0; i < kRow; ++i) {
+    for (int j = 0; j < kStride; ++j) {
+      if (j >= kCol) {
+        ASSERT_EQ(c[i * kStride + j], kPadding);
+        continue;
+      }
+      double abs_sum = 0;
+      double expect = RefDot(a.data() + i * kDeep, b_trans.data() + j * kDeep, kDeep, &abs_sum);
+      // a bf16 keeps 8 bits of the mantissa.
+      ASSERT_NEAR(Bf16ToFloat32Scalar(c[i * kStride + j]), expect, std::fabs(expect) / 256 + 1e-6 * abs_sum)
+        << i << " " << j;
+    }
+  }
+}
+}  // namespace mindspore
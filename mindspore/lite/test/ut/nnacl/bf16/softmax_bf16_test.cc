@@ -0,0 +1,71 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/bf16/cast_bf16.h"
+#include "nnacl/bf16/softmax_bf16.h"
+#include "nnacl/errorcode.h"
+#include "nnacl/fp32/softmax_fp32.h"
+
+namespace mindspore {
+class SoftmaxBf16Test : public mindspore::CommonTest {
+ public:
+  SoftmaxBf16Test() {}
+};
+
+namespace {
+// the softmax of bf16 against the fp32 softmax of the widened input.
+void CheckSoftmax(int batch, int channel) {
+  std::mt19937 gen(batch * 1000 + channel);
+  std::uniform_real_distribution<float> dist(-8.0f, 8.0f);
+  size_t size = static_cast<size_t>(batch) * channel;
+  std::vector<uint16_t> src(size);
+  std::vector<float> src_fp32(size);
+  for (size_t i = 0; i < size; ++i) {
+    src[i] = Float32ToBf16Scalar(dist(gen));
+    src_fp32[i] = Bf16ToFloat32Scalar(src[i]);
+  }
+  std::vector<uint16_t> dst(size);
+  ASSERT_EQ(SoftmaxLastAxisBf16(src.data(), dst.data(), batch, channel), NNACL_OK);
+  std::vector<float> expect(size);
+  ASSERT_EQ(SoftmaxLastAxis(src_fp32.data(), expect.data(), batch, channel), NNACL_OK);
+  for (int b = 0; b < batch; ++b) {
+    float sum = 0;
+    for (int c = 0; c < channel; ++c) {
+      size_t index = static_cast<size_t>(b) * channel + c;
+      float value = Bf16ToFloat32Scalar(dst[index]);
+      // the output is rounded to bf16 once, which keeps 8 bits of the mantissa.
+      ASSERT_NEAR(value, expect[index], expect[index] / 128 + 1e-7) << "channel " << channel << " at " << index;
+      sum += value;
+    }
+    ASSERT_NEAR(sum, 1.0f, 1.0f / 128) << "channel " << channel << " batch " << b;
+  }
+}
+}  // namespace
+
+/// Feature: the bf16 softmax of nnacl.
+/// Description: the softmax of the last axis within a tile, which keeps the exp in the tile, and across several tiles,
+/// which redoes the exp.
+/// Expectation: the output is the fp32 softmax of the widened input within a bf16 rounding, and a batch sums to 1.
+TEST_F(SoftmaxBf16Test, SoftmaxLastAxis) {
+  CheckSoftmax(3, 1);
+  CheckSoftmax(3, 17);
+  CheckSoftmax(2, BF16_TILE);
+  CheckSoftmax(2, 2 * BF16_TILE + 5);
+}
+}  // namespace mindspore
@@ -0,0 +1,220 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/int8/matmul_int8.h"
+#include "nnacl/int8/fixed_point.h"
+#ifdef ENABLE_AVX
+#include "nnacl/int8/matmul_avx_int8.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+
+namespace mindspore {
+class MatmulAvxInt8Test : public mindspore::CommonTest {
+ public:
+  MatmulAvxInt8Test() {}
+};
+
+namespace {
+using MatmulOptFunc = void (*)(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
+                               const int32_t *a_sums, const int32_t *bias, int mini, int maxi, int out_zp,
+                               const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift,
+                               size_t stride, size_t filter_peroc, const int32_t *filter_zp);
+using MatmulR8x8Func = void (*)(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                                size_t stride, const int32_t *input_sum, const int32_t *bias,
+                                const int32_t *left_shift, const int32_t *right_shift, const int32_t *multiplier,
+                                int32_t output_zp, int32_t mini, int32_t maxi, size_t per_channel);
+
+constexpr int kOutZp = 3;
+constexpr int kActMin = -128;
+constexpr int kActMax = 127;
+
+// row-major a (row x deep) and b (col x deep) of the full int8 range, and the quant params of every column.
+struct MatmulCase {
+  MatmulCase(int row, int col, int deep, bool per_channel) : row(row), col(col), deep(deep), per_channel(per_channel) {
+    std::mt19937 gen(row * 10000 + col * 100 + deep);
+    std::uniform_int_distribution<int> int8_dist(INT8_MIN, INT8_MAX);
+    std::uniform_int_distribution<int> sum_dist(-20000, 20000);
+    a.resize(row * deep);
+    b.resize(col * deep);
+    for (auto &v : a) {
+      v = static_cast<int8_t>(int8_dist(gen));
+    }
+    for (auto &v : b) {
+      v = static_cast<int8_t>(int8_dist(gen));
+    }
+    // the extreme values, which overflow int16 when two products are added up.
+    a[0] = INT8_MIN;
+    b[0] = INT8_MIN;
+    input_sum.resize(row * col);
+    for (auto &v : input_sum) {
+      v = sum_dist(gen);
+    }
+    bias.resize(col);
+    multiplier.resize(col);
+    left_shift.resize(col);
+    right_shift.resize(col);
+    for (int c = 0; c < col; c++) {
+      bias[c] = sum_dist(gen);
+      multiplier[c] = (1 << 30) + c * 1000;
+      left_shift[c] = 0;
+      right_shift[c] = -12 - c % 3;
+    }
+  }
+
+  int8_t Expect(int r, int c) const {
+    int32_t value = 0;
+    for (int d = 0; d < deep; d++) {
+      value += a[r * deep + d] * b[c * deep + d];
+    }
+    int qc = per_channel ? c : 0;
+    value = value - input_sum[r * col + qc] + bias[c];
+    value = MultiplyByQuantizedMultiplier(value, multiplier[qc], left_shift[qc], right_shift[qc]) + kOutZp;
+    return static_cast<int8_t>(MSMAX(kActMin, MSMIN(kActMax, value)));
+  }
+
+  void Check(const std::vector<int8_t> &out) const {
+    for (int r = 0; r < row; r++) {
+      for (int c = 0; c < col; c++) {
+        ASSERT_EQ(out[r * col + c], Expect(r, c)) << "row " << r << " col " << c;
+      }
+    }
+  }
+
+  int row;
+  int col;
+  int deep;
+  bool per_channel;
+  std::vector<int8_t> a;
+  std::vector<int8_t> b;
+  // input_sum[r * col + c] is what is subtracted from the (r, c) element, only column 0 is used per-tensor.
+  std::vector<int32_t> input_sum;
+  std::vector<int32_t> bias;
+  std::vector<int32_t> multiplier;
+  std::vector<int32_t> left_shift;
+  std::vector<int32_t> right_shift;
+};
+
+void RunMatmulOpt(const MatmulCase &mc, MatmulOptFunc func) {
+  int row4 = UP_ROUND(mc.row, C4NUM);
+  int col4 = UP_ROUND(mc.col, C4NUM);
+  int deep16 = UP_ROUND(mc.deep, C16NUM);
+  std::vector<int8_t> pack_a(row4 * deep16, 0);
+  std::vector<int8_t> pack_b(col4 * deep16, 0);
+  RowMajor2Row16x4MajorInt8(mc.a.data(), pack_a.data(), mc.row, mc.deep);
+  RowMajor2Row16x4MajorInt8(mc.b.data(), pack_b.data(), mc.col, mc.deep);
+  // per-channel a_sums is multiplied by filter_zp, so put the sums in a_sums and 1 in filter_zp for column 0.
+  std::vector<int32_t> a_sums(row4, 0);
+  std::vector<int32_t> filter_zp(mc.col, 1);
+  for (int r = 0; r < mc.row; r++) {
+    a_sums[r] = mc.input_sum[r * mc.col];
+  }
+  MatmulCase per_row = mc;
+  for (int r = 0; r < mc.row; r++) {
+    for (int c = 0; c < mc.col; c++) {
+      per_row.input_sum[r * mc.col + c] = a_sums[r];
+    }
+  }
+  std::vector<int8_t> out(mc.row * mc.col, 0);
+  func(pack_a.data(), pack_b.data(), out.data(), mc.row, mc.col, deep16, a_sums.data(), mc.bias.data(), kActMin,
+       kActMax, kOutZp, mc.multiplier.data(), mc.left_shift.data(), mc.right_shift.data(), mc.col, mc.per_channel,
+       filter_zp.data());
+  per_row.Check(out);
+}
+
+void RunMatmulR8x8(const MatmulCase &mc, MatmulR8x8Func func) {
+  int row8 = UP_ROUND(mc.row, C8NUM);
+  int col8 = UP_ROUND(mc.col, C8NUM);
+  int deep4 = UP_ROUND(mc.deep, C4NUM);
+  std::vector<int8_t> pack_a(row8 * deep4, 0);
+  std::vector<int8_t> pack_b(col8 * deep4, 0);
+  RowMajor2Row8x4MajorInt8(mc.a.data(), pack_a.data(), mc.row, mc.deep);
+  RowMajor2Row8x4MajorInt8(mc.b.data(), pack_b.data(), mc.col, mc.deep);
+  std::vector<int32_t> input_sum(mc.per_channel ? col8 * row8 : row8, 0);
+  for (int r = 0; r < mc.row; r++) {
+    if (!mc.per_channel) {
+      input_sum[r] = mc.input_sum[r * mc.col];
+      continue;
+    }
+    for (int c = 0; c < mc.col; c++) {
+      input_sum[(c / C8NUM) * row8 * C8NUM + r * C8NUM + c % C8NUM] = mc.input_sum[r * mc.col + c];
+    }
+  }
+  std::vector<int8_t> out(mc.row * mc.col, 0);
+  func(pack_a.data(), pack_b.data(), out.data(), mc.row, mc.col, deep4, mc.col, input_sum.data(), mc.bias.data(),
+       mc.left_shift.data(), mc.right_shift.data(), mc.multiplier.data(), kOutZp, kActMin, kActMax, mc.per_channel);
+  mc.Check(out);
+}
+
+const std::vector<std::vector<int>> kShapes = {{1, 1, 1}, {4, 4, 16}, {5, 7, 33}, {13, 21, 70}, {32, 40, 300}};
+
+void TestMatmulOpt(MatmulOptFunc func) {
+  for (auto &shape : kShapes) {
+    RunMatmulOpt(MatmulCase(shape[0], shape[1], shape[2], false), func);
+    RunMatmulOpt(MatmulCase(shape[0], shape[1], shape[2], true), func);
+  }
+}
+
+void TestMatmulR8x8(MatmulR8x8Func func) {
+  for (auto &shape : kShapes) {
+    RunMatmulR8x8(MatmulCase(shape[0], shape[1], shape[2], false), func);
+    RunMatmulR8x8(MatmulCase(shape[0], shape[1], shape[2], true), func);
+  }
+}
+}  // namespace
+
+/// Feature: int8 matmul
+/// Description: MatmulInt8Opt and MatMulInt8_8x8_r, which dispatch to the x86 kernels when supported
+/// Expectation: the same as the reference
+TEST_F(MatmulAvxInt8Test, MatmulInt8Dispatch) {
+#ifdef ENABLE_AVX
+  (void)IntelX86CpuInfoInit();
+#endif
+#ifndef ENABLE_ARM
+  TestMatmulOpt(MatmulInt8Opt);
+#endif
+  TestMatmulR8x8(MatMulInt8_8x8_r);
+}
+
+#ifdef ENABLE_AVX
+/// Feature: int8 matmul
+/// Description: the avx kernels with the full int8 range
+/// Expectation: the same as the reference
+TEST_F(MatmulAvxInt8Test, MatmulInt8Avx) {
+  (void)IntelX86CpuInfoInit();
+  if (!X86_Avx_Support()) {
+    return;
+  }
+  TestMatmulOpt(MatmulInt8OptAvx);
+  TestMatmulR8x8(MatmulInt8R8x8Avx);
+}
+#endif
+
+#ifdef ENABLE_AVX512
+/// Feature: int8 matmul
+/// Description: the avx512 vnni kernels with the full int8 range
+/// Expectation: the same as the reference
+TEST_F(MatmulAvxInt8Test, MatmulInt8Avx512Vnni) {
+  (void)IntelX86CpuInfoInit();
+  if (!X86_Avx512Vnni_Support()) {
+    return;
+  }
+  TestMatmulOpt(MatmulInt8OptAvx512Vnni);
+  TestMatmulR8x8(MatmulInt8R8x8Avx512Vnni);
+}
+#endif
+}  // namespace mindspore
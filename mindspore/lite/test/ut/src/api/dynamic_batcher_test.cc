@@ -0,0 +1,251 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/extendrt/cxx_api/model_pool/dynamic_batcher.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace {
+constexpr int64_t kFeatureNum = 2;
+
+MSTensor CreateInput(float value) {
+  std::vector<float> data(kFeatureNum, value);
+  auto tensor = MSTensor::CreateTensor("input", DataType::kNumberTypeFloat32, {1, kFeatureNum}, data.data(),
+                                       data.size() * sizeof(float));
+  MSTensor input = *tensor;
+  delete tensor;
+  return input;
+}
+
+// the model doubles its input, and records the batch size of every run.
+class FakeModel {
+ public:
+  explicit FakeModel(size_t fail_runs = 0) : fail_runs_(fail_runs) {}
+
+  Status Run(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      batch_sizes_.push_back(inputs.front().Shape()[0]);
+      if (batch_sizes_.size() <= fail_runs_) {
+        return kLiteError;
+      }
+    }
+    auto &input = inputs.front();
+    auto src = static_cast<const float *>(input.Data().get());
+    std::vector<float> data(src, src + input.ElementNum());
+    for (auto &value : data) {
+      value *= 2;
+    }
+    auto tensor =
+      MSTensor::CreateTensor("output", DataType::kNumberTypeFloat32, input.Shape(), data.data(), input.DataSize());
+    outputs->push_back(*tensor);
+    delete tensor;
+    return kSuccess;
+  }
+
+  std::vector<int64_t> BatchSizes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batch_sizes_;
+  }
+
+ private:
+  size_t fail_runs_;
+  std::mutex mutex_;
+  std::vector<int64_t> batch_sizes_;
+};
+
+void CheckOutputs(const std::vector<MSTensor> &outputs, float value) {
+  ASSERT_EQ(outputs.size(), 1);
+  ASSERT_EQ(outputs[0].Shape(), std::vector<int64_t>({1, kFeatureNum}));
+  auto data = static_cast<const float *>(outputs[0].Data().get());
+  for (int64_t j = 0; j < kFeatureNum; j++) {
+    ASSERT_EQ(data[j], value);
+  }
+}
+
+DynamicBatcher::RunFunc BindModel(FakeModel *model) {
+  return [model](const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs) {
+    return model->Run(inputs, outputs);
+  };
+}
+
+// run `request_num` requests at the same time, the request i has the input of value i and the outputs `outputs[i]`,
+// which are given by the user if they are not empty.
+std::vector<Status> ConcurrentPredict(DynamicBatcher *batcher, size_t request_num,
+                                      std::vector<std::vector<MSTensor>> *outputs) {
+  std::vector<Status> statuses(request_num);
+  outputs->resize(request_num);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < request_num; i++) {
+    threads.emplace_back([batcher, i, &statuses, outputs]() {
+      std::vector<MSTensor> inputs = {CreateInput(static_cast<float>(i))};
+      statuses[i] = batcher->Predict(inputs, &(*outputs)[i]);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return statuses;
+}
+}  // namespace
+
+class DynamicBatcherTest : public mindspore::CommonTest {
+ public:
+  DynamicBatcherTest() {}
+};
+
+/// Feature: Dynamic batching of ModelPool.
+/// Description: Several requests arrive within the max wait time and fill up a batch.
+/// Expectation: The requests are run as one batch, every request gets its own rows of the output.
+TEST_F(DynamicBatcherTest, CoalesceRequests) {
+  constexpr size_t kRequestNum = 4;
+  FakeModel model;
+  // the wait time is long enough for all the requests to join, the batch is run as soon as it is full.
+  DynamicBatcher batcher(kRequestNum, 10 * 1000 * 1000, BindModel(&model));
+  std::vector<MSTensor> inputs = {CreateInput(0)};
+  ASSERT_TRUE(batcher.CanBatch(inputs));
+
+  std::vector<std::vector<MSTensor>> outputs;
+  auto statuses = ConcurrentPredict(&batcher, kRequestNum, &outputs);
+  ASSERT_EQ(model.BatchSizes(), std::vector<int64_t>({static_cast<int64_t>(kRequestNum)}));
+  for (size_t i = 0; i < kRequestNum; i++) {
+    ASSERT_EQ(statuses[i], kSuccess);
+    CheckOutputs(outputs[i], static_cast<float>(2 * i));
+  }
+  auto histograms = batcher.GetLatencyHistograms();
+  ASSERT_EQ(histograms.size(), 1);
+  ASSERT_EQ(histograms[kRequestNum].count, 1);
+}
+
+/// Feature: Dynamic batching of ModelPool.
+/// Description: A single request does not fill up the batch.
+/// Expectation: The batch is flushed after the max wait time, its latency includes the time waiting in the queue.
+TEST_F(DynamicBatcherTest, FlushOnTimeout) {
+  constexpr int64_t kMaxWaitTimeUs = 20 * 1000;
+  FakeModel model;
+  DynamicBatcher batcher(8, kMaxWaitTimeUs, BindModel(&model));
+  std::vector<MSTensor> inputs = {CreateInput(3)};
+  std::vector<MSTensor> outputs;
+  auto start = std::chrono::steady_clock::now();
+  ASSERT_EQ(batcher.Predict(inputs, &outputs), kSuccess);
+  auto cost_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  ASSERT_GE(cost_us.count(), kMaxWaitTimeUs);
+  ASSERT_EQ(model.BatchSizes(), std::vector<int64_t>({1}));
+  ASSERT_EQ(outputs.size(), 1);
+  ASSERT_EQ(static_cast<const float *>(outputs[0].Data().get())[0], 6.0f);
+
+  auto histograms = batcher.GetLatencyHistograms();
+  ASSERT_EQ(histograms[1].count, 1);
+  ASSERT_GE(histograms[1].max_ms, static_cast<double>(kMaxWaitTimeUs) / 1000);
+}
+
+/// Feature: Dynamic batching of ModelPool.
+/// Description: The run of a batch fails, then another batch is run.
+/// Expectation: The requests of the failed batch are retried one by one and succeed, the next batch is still batched
+/// and succeeds.
+TEST_F(DynamicBatcherTest, RetryFailedBatchOneByOne) {
+  constexpr size_t kRequestNum = 2;
+  FakeModel model(1);
+  DynamicBatcher batcher(kRequestNum, 10 * 1000 * 1000, BindModel(&model));
+
+  std::vector<std::vector<MSTensor>> outputs;
+  auto statuses = ConcurrentPredict(&batcher, kRequestNum, &outputs);
+  for (size_t i = 0; i < kRequestNum; i++) {
+    ASSERT_EQ(statuses[i], kSuccess);
+    CheckOutputs(outputs[i], static_cast<float>(2 * i));
+  }
+  ASSERT_EQ(model.BatchSizes(), std::vector<int64_t>({static_cast<int64_t>(kRequestNum), 1, 1}));
+  ASSERT_TRUE(batcher.GetLatencyHistograms().empty());
+
+  outputs.clear();
+  statuses = ConcurrentPredict(&batcher, kRequestNum, &outputs);
+  for (auto &status : statuses) {
+    ASSERT_EQ(status, kSuccess);
+  }
+  ASSERT_EQ(model.BatchSizes(), std::vector<int64_t>({static_cast<int64_t>(kRequestNum), 1, 1,
+                                                      static_cast<int64_t>(kRequestNum)}));
+  ASSERT_EQ(batcher.GetLatencyHistograms()[kRequestNum].count, 1);
+}
+
+/// Feature: Dynamic batching of ModelPool.
+/// Description: The run of a batch fails, and so do the runs of its requests one by one.
+/// Expectation: Every request gets the error of its own run.
+TEST_F(DynamicBatcherTest, PropagateRequestError) {
+  constexpr size_t kRequestNum = 2;
+  FakeModel model(1 + kRequestNum);
+  DynamicBatcher batcher(kRequestNum, 10 * 1000 * 1000, BindModel(&model));
+
+  std::vector<std::vector<MSTensor>> outputs;
+  auto statuses = ConcurrentPredict(&batcher, kRequestNum, &outputs);
+  for (size_t i = 0; i < kRequestNum; i++) {
+    ASSERT_EQ(statuses[i], kLiteError);
+    ASSERT_TRUE(outputs[i].empty());
+  }
+  ASSERT_EQ(model.BatchSizes(), std::vector<int64_t>({static_cast<int64_t>(kRequestNum), 1, 1}));
+}
+
+/// Feature: Dynamic batching of ModelPool.
+/// Description: One request gives user outputs whose first dimension is not its batch size.
+/// Expectation: The request is rejected before it joins a batch, the other request is run alone and succeeds.
+TEST_F(DynamicBatcherTest, RejectInvalidRequest) {
+  constexpr size_t kRequestNum = 2;
+  FakeModel model;
+  DynamicBatcher batcher(kRequestNum, 20 * 1000, BindModel(&model));
+
+  std::vector<std::vector<MSTensor>> outputs(kRequestNum);
+  std::vector<float> user_data(2 * kFeatureNum, -1);
+  auto user_output = MSTensor::CreateTensor("output", DataType::kNumberTypeFloat32, {2, kFeatureNum},
+                                            user_data.data(), user_data.size() * sizeof(float));
+  outputs[0].push_back(*user_output);
+  delete user_output;
+  auto statuses = ConcurrentPredict(&batcher, kRequestNum, &outputs);
+  ASSERT_EQ(statuses[0], kLiteParamInvalid);
+  ASSERT_EQ(statuses[1], kSuccess);
+  CheckOutputs(outputs[1], 2.0f);
+  ASSERT_EQ(model.BatchSizes(), std::vector<int64_t>({1}));
+}
+
+/// Feature: Dynamic batching of ModelPool.
+/// Description: In a batch, one request gives a user output whose size does not match the output rows of the request.
+/// Expectation: Only this request fails and its user output is left untouched, the other requests get their outputs.
+TEST_F(DynamicBatcherTest, ScatterOutputsPerRequest) {
+  constexpr size_t kRequestNum = 3;
+  FakeModel model;
+  DynamicBatcher batcher(kRequestNum, 10 * 1000 * 1000, BindModel(&model));
+
+  std::vector<std::vector<MSTensor>> outputs(kRequestNum);
+  std::vector<float> user_data(kFeatureNum + 1, -1);
+  auto user_output = MSTensor::CreateTensor("output", DataType::kNumberTypeFloat32, {1, kFeatureNum + 1},
+                                            user_data.data(), user_data.size() * sizeof(float));
+  outputs[1].push_back(*user_output);
+  delete user_output;
+  auto statuses = ConcurrentPredict(&batcher, kRequestNum, &outputs);
+  ASSERT_EQ(model.BatchSizes(), std::vector<int64_t>({static_cast<int64_t>(kRequestNum)}));
+  ASSERT_EQ(statuses[1], kLiteError);
+  auto data = static_cast<const float *>(outputs[1][0].Data().get());
+  for (int64_t j = 0; j < kFeatureNum + 1; j++) {
+    ASSERT_EQ(data[j], -1.0f);
+  }
+  for (size_t i = 0; i < kRequestNum; i += 2) {
+    ASSERT_EQ(statuses[i], kSuccess);
+    CheckOutputs(outputs[i], static_cast<float>(2 * i));
+  }
+}
+}  // namespace mindspore
@@ -240,4 +240,59 @@ TEST_F(ModelParallelRunnerTest, RunnerInitByBuf) {
     tensor.SetData(nullptr);
   }
 }
+
+TEST_F(ModelParallelRunnerTest, GetBatchLatencyHistogramsWithoutInit) {
+  ModelParallelRunner runner;
+  ASSERT_TRUE(runner.GetBatchLatencyHistograms().empty());
+}
+
+TEST_F(ModelParallelRunnerTest, RunnerGetBatchLatencyHistograms) {
+  auto config = std::make_shared<RunnerConfig>();
+  ASSERT_NE(nullptr, config);
+
+  auto context = std::make_shared<Context>();
+  ASSERT_NE(nullptr, context);
+  auto &device_list = context->MutableDeviceInfo();
+  auto device_info = std::make_shared<mindspore::CPUDeviceInfo>();
+  ASSERT_NE(nullptr, device_info);
+  device_list.push_back(device_info);
+  ASSERT_EQ(device_list.size(), 1);
+
+  config->SetContext(context);
+  config->SetWorkersNum(2);
+  config->SetConfigInfo("dynamic_batching", {{"enable_dynamic_batching", "true"}, {"max_wait_time_us", "1000"}});
+  ModelParallelRunner runner;
+  auto status = runner.Init(model_path, config);
+  ASSERT_EQ(status, kSuccess);
+  ASSERT_TRUE(runner.GetBatchLatencyHistograms().empty());
+
+  auto inputs = runner.GetInputs();
+  SetInputTensorData(&inputs);
+  // the first predict warms up the workers, it is not batched.
+  std::vector<MSTensor> outputs;
+  status = runner.Predict(inputs, &outputs);
+  ASSERT_EQ(status, kSuccess);
+  outputs.clear();
+  status = runner.Predict(inputs, &outputs);
+  ASSERT_EQ(status, kSuccess);
+  ASSERT_EQ(outputs.size(), 1);
+  ASSERT_EQ(outputs[0].DataSize(), kOutputDataSize);
+  // free user data
+  for (auto &tensor : inputs) {
+    char *data = static_cast<char *>(tensor.MutableData());
+    delete[] data;
+    tensor.SetData(nullptr);
+  }
+
+  auto histograms = runner.GetBatchLatencyHistograms();
+  ASSERT_EQ(histograms.size(), 1);
+  auto &histogram = histograms[1];
+  ASSERT_EQ(histogram.count, 1);
+  ASSERT_GT(histogram.max_ms, 0);
+  size_t bucket_count = 0;
+  for (size_t i = 0; i < BatchLatencyHistogram::kBucketNum; i++) {
+    bucket_count += histogram.buckets[i];
+  }
+  ASSERT_EQ(bucket_count, 1);
+}
 }  // namespace mindspore
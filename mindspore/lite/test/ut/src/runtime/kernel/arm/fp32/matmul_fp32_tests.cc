@@ -13,7 +13,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <iostream>
+#include <vector>
 #include "src/common/log_adapter.h"
 #include "common/common_test.h"
 #include "nnacl/fp32/pack_fp32.h"
@@ -22,6 +24,7 @@
 #include "src/executor/kernel_exec.h"
 #include "src/litert/tensor_category.h"
 #include "src/litert/kernel/cpu/nnacl/nnacl_manager.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
 
 namespace mindspore {
 class TestMatMulFp32 : public mindspore::CommonTest {
@@ -373,4 +376,154 @@ TEST_F(TestMatMulFp32, batch) {
   for (auto t : inputs_) delete t;
   for (auto t : outputs_) delete t;
 }
+
+struct Int8WeightCase {
+  int row;
+  int deep;
+  int col;
+  bool b_transpose;
+  int bit_num;
+  bool per_channel;
+  bool symmetric;
+  bool has_bias;
+  ActType act_type;
+};
+
+// The int8 weight is kept in int8 and dequantized by the fp32 matmul, the output is checked against the matmul of the
+// dequantized weight.
+void RunInt8WeightMatmul(const Int8WeightCase &test_case) {
+#ifdef ENABLE_AVX
+  (void)IntelX86CpuInfoInit();
+#endif
+  const int row = test_case.row;
+  const int deep = test_case.deep;
+  const int col = test_case.col;
+  auto matmul_param = new MatMulParameter();
+  matmul_param->a_transpose_ = false;
+  matmul_param->b_transpose_ = test_case.b_transpose;
+  matmul_param->has_bias_ = test_case.has_bias;
+  matmul_param->act_type_ = test_case.act_type;
+  matmul_param->op_parameter_.thread_num_ = 2;
+  matmul_param->op_parameter_.type_ = schema::PrimitiveType_MatMulFusion;
+
+  std::vector<float> a(row * deep);
+  for (int i = 0; i < row * deep; ++i) {
+    a[i] = static_cast<float>(i % 7) * 0.25f - 0.5f;
+  }
+  // b[c][d] of the weight in [col][deep], which is stored as [deep][col] without b_transpose.
+  std::vector<int8_t> b(col * deep);
+  int range = 1 << test_case.bit_num;
+  for (int i = 0; i < col * deep; ++i) {
+    b[i] = static_cast<int8_t>(i * 37 % range - range / 2);
+  }
+  int quant_num = test_case.per_channel ? col : 1;
+  std::vector<float> scales(quant_num);
+  std::vector<int> zero_points(quant_num);
+  for (int i = 0; i < quant_num; ++i) {
+    scales[i] = 0.05f / static_cast<float>(i + 1);
+    zero_points[i] = test_case.symmetric ? 0 : (i + 2) % 3 - 1;
+  }
+  std::vector<float> bias(col);
+  for (int c = 0; c < col; ++c) {
+    bias[c] = static_cast<float>(c % 5) * 0.5f - 1.0f;
+  }
+
+  std::vector<lite::Tensor *> inputs_;
+  std::vector<lite::Tensor *> outputs_;
+  auto in_t = new lite::Tensor(kNumberTypeFloat32, {row, deep}, mindspore::NHWC, lite::Category::VAR);
+  in_t->MallocData();
+  memcpy(in_t->MutableData(), a.data(), a.size() * sizeof(float));
+  inputs_.push_back(in_t);
+  std::vector<int> weight_shape = test_case.b_transpose ? std::vector<int>{col, deep} : std::vector<int>{deep, col};
+  auto weight_t = new lite::Tensor(kNumberTypeInt8, weight_shape, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  weight_t->MallocData();
+  auto weight_data = reinterpret_cast<int8_t *>(weight_t->MutableData());
+  for (int c = 0; c < col; ++c) {
+    for (int d = 0; d < deep; ++d) {
+      weight_data[test_case.b_transpose ? c * deep + d : d * col + c] = b[c * deep + d];
+    }
+  }
+  for (int i = 0; i < quant_num; ++i) {
+    lite::LiteQuantParam quant_param;
+    quant_param.scale = scales[i];
+    quant_param.zeroPoint = zero_points[i];
+    quant_param.bitNum = test_case.bit_num;
+    weight_t->AddQuantParam(quant_param);
+  }
+  inputs_.push_back(weight_t);
+  if (test_case.has_bias) {
+    auto bias_t = new lite::Tensor(kNumberTypeFloat32, {col}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+    bias_t->MallocData();
+    memcpy(bias_t->MutableData(), bias.data(), bias.size() * sizeof(float));
+    inputs_.push_back(bias_t);
+  }
+  auto out_t = new lite::Tensor(kNumberTypeFloat32, {row, col}, mindspore::NHWC, lite::Category::VAR);
+  out_t->MallocData();
+  outputs_.push_back(out_t);
+
+  std::vector<float> correct(row * col);
+  for (int r = 0; r < row; ++r) {
+    for (int c = 0; c < col; ++c) {
+      int q = test_case.per_channel ? c : 0;
+      double sum = test_case.has_bias ? bias[c] : 0;
+      for (int d = 0; d < deep; ++d) {
+        sum += static_cast<double>(a[r * deep + d]) * (b[c * deep + d] - zero_points[q]) * scales[q];
+      }
+      if (test_case.act_type == ActType_Relu) {
+        sum = std::max(sum, 0.0);
+      }
+      correct[r * col + c] = static_cast<float>(sum);
+    }
+  }
+  auto ctx = new lite::InnerContext;
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(lite::RET_OK, ctx->Init());
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_MatMulFusion};
+  auto *mm = nnacl::NNACLKernelRegistry(reinterpret_cast<OpParameter *>(matmul_param), inputs_, outputs_, ctx, desc);
+  ASSERT_NE(mm, nullptr);
+  ASSERT_EQ(lite::RET_OK, mm->Prepare());
+  ASSERT_EQ(lite::RET_OK, mm->Run());
+  ASSERT_EQ(0, CommonTest::CompareOutputData(reinterpret_cast<float *>(outputs_[0]->MutableData()), correct.data(),
+                                             row * col, 0.0001));
+  delete mm;
+  delete ctx;
+  for (auto t : inputs_) delete t;
+  for (auto t : outputs_) delete t;
+}
+
+/// Feature: weight-only quantized matmul.
+/// Description: an int4 weight with b_transpose and per-channel quant params, which is repacked into nibbles.
+/// Expectation: the same as the matmul of the dequantized weight.
+TEST_F(TestMatMulFp32, int8_weight_transb) {
+  RunInt8WeightMatmul({2, 40, 3, true, 4, true, false, false, ActType_No});
+  // more rows than a row tile, and the deep has a tail after the simd blocks.
+  RunInt8WeightMatmul({5, 77, 19, true, 4, true, false, false, ActType_No});
+}
+
+/// Feature: weight-only quantized matmul.
+/// Description: an int8 weight of the full range with b_transpose, with per-channel quant params, and with the
+/// asymmetric and the symmetric per-tensor quant params.
+/// Expectation: the same as the matmul of the dequantized weight.
+TEST_F(TestMatMulFp32, int8_weight_bit8) {
+  RunInt8WeightMatmul({1, 77, 19, true, 8, true, false, false, ActType_No});
+  RunInt8WeightMatmul({5, 77, 19, true, 8, false, false, false, ActType_No});
+  RunInt8WeightMatmul({5, 77, 19, true, 8, false, true, false, ActType_No});
+}
+
+/// Feature: weight-only quantized matmul.
+/// Description: a weight of [deep][col] without b_transpose, which is transposed when the weight is packed, as int4
+/// and int8.
+/// Expectation: the same as the matmul of the dequantized weight.
+TEST_F(TestMatMulFp32, int8_weight_no_transb) {
+  RunInt8WeightMatmul({3, 64, 17, false, 4, true, false, false, ActType_No});
+  RunInt8WeightMatmul({6, 70, 17, false, 8, false, false, false, ActType_No});
+}
+
+/// Feature: weight-only quantized matmul.
+/// Description: the weight with a bias and relu, per-channel and per-tensor.
+/// Expectation: the same as the relu of the matmul of the dequantized weight plus the bias.
+TEST_F(TestMatMulFp32, int8_weight_bias_relu) {
+  RunInt8WeightMatmul({5, 77, 19, true, 8, true, false, true, ActType_Relu});
+  RunInt8WeightMatmul({4, 96, 11, false, 4, false, false, true, ActType_Relu});
+}
 }  // namespace mindspore
@@ -0,0 +1,313 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/func_graph.h"
+#include "ir/tensor.h"
+#include "schema/inner/model_generated.h"
+#include "src/common/utils.h"
+#include "src/litert/huffman_decode.h"
+#include "src/litert/inner_context.h"
+#include "src/litert/schema_tensor_wrapper.h"
+#include "src/tensor.h"
+#include "tools/converter/quantizer/fse_decoder.h"
+#include "tools/converter/quantizer/fse_encoder.h"
+#define private public
+#include "tools/converter/quantizer/huffman_encode.h"
+#undef private
+
+namespace mindspore {
+namespace {
+constexpr int kSymbolNum = 20;
+constexpr double kSymbolProbability = 0.45;
+// Fewer symbols than a chunk, so the weight is written in the legacy layout.
+constexpr size_t kSmallDataSize = 10000;
+// Several chunks of huffman codes and several segments of FSE, the last ones are not full.
+constexpr size_t kLargeDataSize = 5 * 64 * 1024 + 123;
+constexpr int kThreadNum = 4;
+// The weight size of the load time benchmark.
+constexpr size_t kBenchmarkDataSize = 4 * 1024 * 1024;
+
+// The rare symbols get codes longer than both the root table and a sub table of the decoder.
+std::vector<int8_t> BuildData(size_t size) {
+  std::mt19937 random(0);
+  std::geometric_distribution<int> distribution(kSymbolProbability);
+  std::vector<int8_t> data(size);
+  for (auto &value : data) {
+    value = static_cast<int8_t>(std::min(distribution(random), kSymbolNum - 1) - kSymbolNum / 2);
+  }
+  return data;
+}
+
+std::string HuffmanCompress(const std::vector<int8_t> &data) {
+  lite::HuffmanEncode encode;
+  lite::HuffmanPriorityQueue pq;
+  if (encode.GetHuffmanPriorityQueue(data.data(), data.size(), &pq) != lite::RET_OK ||
+      encode.BuildHuffmanTree(&pq) != lite::RET_OK ||
+      encode.DoHuffmanCompress(data.data(), data.size()) != lite::RET_OK) {
+    return "";
+  }
+  return encode.huffman_encoded_str_;
+}
+
+std::vector<int8_t> HuffmanDecompress(const std::string &encoded, size_t size, const lite::InnerContext *context) {
+  std::vector<int8_t> decoded(size);
+  if (lite::HuffmanDecode::DoHuffmanDecode(reinterpret_cast<const uint8_t *>(encoded.data()), encoded.size(),
+                                           decoded.data(), decoded.size(), context) != lite::RET_OK) {
+    return {};
+  }
+  return decoded;
+}
+
+// Compress the data as the weight of a parameter, and return the tensor in the model with the compressed data.
+std::unique_ptr<schema::TensorT> FSECompress(const std::vector<int8_t> &data, const schema::QuantParamT &quant_param,
+                                             TensorCompressionType compress_type) {
+  auto graph = std::make_shared<FuncGraph>();
+  auto weight = graph->add_parameter();
+  auto tensor_info = std::make_shared<tensor::Tensor>(kNumberTypeInt8, ShapeVector{static_cast<int64_t>(data.size())});
+  if (memcpy_s(tensor_info->data_c(), tensor_info->Size(), data.data(), data.size()) != EOK) {
+    return nullptr;
+  }
+  weight->set_default_param(tensor_info);
+  lite::quant::FSEEncoder encoder;
+  if (encoder.Compress(weight, {quant_param}, compress_type) != lite::RET_OK) {
+    return nullptr;
+  }
+  auto compressed = weight->default_param()->cast<tensor::TensorPtr>();
+  auto tensor = std::make_unique<schema::TensorT>();
+  tensor->nodeType = lite::NodeType_ValueNode;
+  tensor->dataType = compressed->data_type();
+  tensor->dims = {static_cast<int32_t>(data.size())};
+  auto compressed_data = static_cast<const uint8_t *>(compressed->data_c());
+  tensor->data.assign(compressed_data, compressed_data + compressed->Size());
+  tensor->weightQuantCompressType = compress_type == kFSE ? schema::WeightQuantCompressType_FSE
+                                                          : schema::WeightQuantCompressType_FSE_INT;
+  return tensor;
+}
+
+// The unary codes make the codes of the rare symbols longer than both the root table and a sub table.
+std::map<int, std::string> BuildUnaryCodes() {
+  std::map<int, std::string> codes;
+  for (int i = 0; i < kSymbolNum; ++i) {
+    codes[i - kSymbolNum / 2] = std::string(i, '1') + "0";
+  }
+  codes[lite::PSEUDO_EOF] = std::string(kSymbolNum, '1');
+  return codes;
+}
+
+// Write the weight in the legacy layout, which the converter uses only for the weights smaller than a chunk.
+std::string EncodeLegacy(const std::vector<int8_t> &data, const std::map<int, std::string> &codes) {
+  std::string keys;
+  std::string code_str;
+  for (const auto &code : codes) {
+    keys += std::to_string(code.first) + " ";
+    code_str += code.second + " ";
+  }
+  std::string bits;
+  size_t bit_count = 0;
+  auto append = [&bits, &bit_count](const std::string &code) {
+    for (auto bit : code) {
+      if (bit_count == 0) {
+        bits.push_back(0);
+      }
+      bits.back() |= static_cast<char>((bit - '0') << (7 - bit_count));
+      bit_count = (bit_count + 1) % 8;
+    }
+  };
+  for (auto value : data) {
+    append(codes.at(value));
+  }
+  append(codes.at(lite::PSEUDO_EOF));
+  return keys + lite::kHuffmanSeparator + code_str + lite::kHuffmanSeparator + bits;
+}
+
+// The decoder before the lookup tables, which walks a tree one bit at a time.
+std::vector<int8_t> TreeDecode(const std::string &encoded, const std::map<int, std::string> &codes) {
+  struct Node {
+    int key = 0;
+    int child[2] = {-1, -1};
+  };
+  std::vector<Node> nodes(1);
+  for (const auto &code : codes) {
+    int node = 0;
+    for (auto bit : code.second) {
+      if (nodes[node].child[bit - '0'] < 0) {
+        nodes[node].child[bit - '0'] = static_cast<int>(nodes.size());
+        nodes.emplace_back();
+      }
+      node = nodes[node].child[bit - '0'];
+    }
+    nodes[node].key = code.first;
+  }
+  std::vector<int8_t> decoded;
+  auto bits_begin = encoded.find(lite::kHuffmanSeparator, encoded.find(lite::kHuffmanSeparator) + 1) + 1;
+  int node = 0;
+  for (size_t pos = bits_begin; pos < encoded.size(); ++pos) {
+    for (int i = 7; i >= 0; --i) {
+      node = nodes[node].child[(static_cast<unsigned char>(encoded[pos]) >> i) & 1];
+      if (nodes[node].child[0] < 0 && nodes[node].child[1] < 0) {
+        if (nodes[node].key == lite::PSEUDO_EOF) {
+          return decoded;
+        }
+        decoded.push_back(static_cast<int8_t>(nodes[node].key));
+        node = 0;
+      }
+    }
+  }
+  return decoded;
+}
+
+template <typename T>
+std::vector<T> FSEDecompress(const schema::Tensor &src, TypeId data_type, size_t size,
+                             const lite::InnerContext *context) {
+  lite::SchemaTensorWrapper wrapper;
+  if (!wrapper.Init(src, lite::SCHEMA_CUR, "")) {
+    return {};
+  }
+  lite::Tensor dst(data_type, {static_cast<int>(size)});
+  if (dst.MallocData() != lite::RET_OK ||
+      lite::quant::FSEDecoder::DeCompress(wrapper, &dst, src.weightQuantCompressType(), context) != lite::RET_OK) {
+    return {};
+  }
+  auto dst_data = static_cast<const T *>(dst.data());
+  return std::vector<T>(dst_data, dst_data + size);
+}
+}  // namespace
+
+class WeightDecodeTest : public mindspore::CommonTest {
+ public:
+  WeightDecodeTest() = default;
+
+  void SetUp() override {
+    context_.thread_num_ = kThreadNum;
+    ASSERT_EQ(context_.Init(), lite::RET_OK);
+  }
+
+ protected:
+  lite::InnerContext context_;
+};
+
+/// Feature: Huffman decode of the compressed weights.
+/// Description: Compress a weight smaller than a chunk by the converter, then decode it, and decode it into an output
+/// which is too small.
+/// Expectation: The weight is written in the legacy layout and decoded back, the too small output fails.
+TEST_F(WeightDecodeTest, HuffmanDecodeLegacy) {
+  const auto data = BuildData(kSmallDataSize);
+  const auto encoded = HuffmanCompress(data);
+  ASSERT_FALSE(encoded.empty());
+  ASSERT_NE(encoded.front(), lite::kHuffmanSeparator);
+  ASSERT_EQ(HuffmanDecompress(encoded, data.size(), nullptr), data);
+  ASSERT_EQ(HuffmanDecompress(encoded, data.size(), &context_), data);
+
+  std::vector<int8_t> decoded(data.size() - 1);
+  ASSERT_NE(lite::HuffmanDecode::DoHuffmanDecode(encoded, decoded.data(), decoded.size()), lite::RET_OK);
+}
+
+/// Feature: Huffman decode of the compressed weights.
+/// Description: Compress a weight of several chunks by the converter, then decode it serially and on the thread pool,
+/// and decode the stream with the last byte cut.
+/// Expectation: The weight is written in the chunked layout and both decodes get it back, the cut stream fails.
+TEST_F(WeightDecodeTest, HuffmanDecodeChunked) {
+  const auto data = BuildData(kLargeDataSize);
+  const auto encoded = HuffmanCompress(data);
+  ASSERT_FALSE(encoded.empty());
+  ASSERT_EQ(encoded.front(), lite::kHuffmanSeparator);
+  ASSERT_EQ(HuffmanDecompress(encoded, data.size(), nullptr), data);
+  ASSERT_EQ(HuffmanDecompress(encoded, data.size(), &context_), data);
+
+  ASSERT_TRUE(HuffmanDecompress(encoded.substr(0, encoded.size() - 1), data.size(), nullptr).empty());
+  ASSERT_TRUE(HuffmanDecompress(encoded.substr(0, encoded.size() - 1), data.size(), &context_).empty());
+}
+
+/// Feature: FSE decode of the compressed weights.
+/// Description: Compress a weight of several segments by the converter, as FSE with the float centroids and as
+/// FSE_INT, then decode them serially and with the segments on the thread pool.
+/// Expectation: The chunk ends of every segment are written, and both decodes get the dequantized weight back.
+TEST_F(WeightDecodeTest, FSEDecodeSegments) {
+  const auto data = BuildData(kLargeDataSize);
+  schema::QuantParamT quant_param;
+  quant_param.scale = 0.5;
+  quant_param.zeroPoint = 1;
+
+  auto fse = FSECompress(data, quant_param, kFSE);
+  ASSERT_NE(fse, nullptr);
+  lite::quant::FSEBuffer fse_buffer;
+  ASSERT_EQ(lite::quant::FSEDecoder::DecodeBuffer(reinterpret_cast<int8_t *>(fse->data.data()), fse->data.size(),
+                                                  &fse_buffer),
+            lite::RET_OK);
+  ASSERT_GT(fse_buffer.chunk_ends_count, 1u);
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  builder.Finish(schema::Tensor::Pack(builder, fse.get()));
+  auto fse_tensor = flatbuffers::GetRoot<schema::Tensor>(builder.GetBufferPointer());
+  auto serial = FSEDecompress<float>(*fse_tensor, kNumberTypeFloat32, data.size(), nullptr);
+  ASSERT_EQ(serial.size(), data.size());
+  for (size_t i = 0; i < data.size(); ++i) {
+    ASSERT_FLOAT_EQ(serial[i], static_cast<float>((data[i] - quant_param.zeroPoint) * quant_param.scale));
+  }
+  ASSERT_EQ(FSEDecompress<float>(*fse_tensor, kNumberTypeFloat32, data.size(), &context_), serial);
+
+  auto fse_int = FSECompress(data, quant_param, kFSEInt);
+  ASSERT_NE(fse_int, nullptr);
+  flatbuffers::FlatBufferBuilder int_builder(1024);
+  int_builder.Finish(schema::Tensor::Pack(int_builder, fse_int.get()));
+  auto fse_int_tensor = flatbuffers::GetRoot<schema::Tensor>(int_builder.GetBufferPointer());
+  ASSERT_EQ(FSEDecompress<int8_t>(*fse_int_tensor, kNumberTypeInt8, data.size(), nullptr), data);
+  ASSERT_EQ(FSEDecompress<int8_t>(*fse_int_tensor, kNumberTypeInt8, data.size(), &context_), data);
+}
+
+/// Feature: Huffman decode of the compressed weights.
+/// Description: Load time benchmark, off by default, run it with --gtest_also_run_disabled_tests. Decode a 4M weight
+/// in the legacy layout by the tree decoder and by the table decoder, and in the chunked layout of the converter
+/// serially and on the thread pool.
+/// Expectation: All of them get the weight back, and the time of each one is logged.
+TEST_F(WeightDecodeTest, DISABLED_HuffmanDecodeBenchmark) {
+  const auto codes = BuildUnaryCodes();
+  const auto data = BuildData(kBenchmarkDataSize);
+  const auto legacy = EncodeLegacy(data, codes);
+  const auto chunked = HuffmanCompress(data);
+  ASSERT_FALSE(chunked.empty());
+  ASSERT_EQ(chunked.front(), lite::kHuffmanSeparator);
+
+  auto start_time = lite::GetTimeUs();
+  auto tree_decoded = TreeDecode(legacy, codes);
+  auto tree_time = lite::GetTimeUs() - start_time;
+  ASSERT_EQ(tree_decoded, data);
+
+  start_time = lite::GetTimeUs();
+  auto table_decoded = HuffmanDecompress(legacy, data.size(), nullptr);
+  auto table_time = lite::GetTimeUs() - start_time;
+  ASSERT_EQ(table_decoded, data);
+
+  start_time = lite::GetTimeUs();
+  auto chunked_decoded = HuffmanDecompress(chunked, data.size(), nullptr);
+  auto chunked_time = lite::GetTimeUs() - start_time;
+  ASSERT_EQ(chunked_decoded, data);
+
+  start_time = lite::GetTimeUs();
+  auto parallel_decoded = HuffmanDecompress(chunked, data.size(), &context_);
+  auto parallel_time = lite::GetTimeUs() - start_time;
+  ASSERT_EQ(parallel_decoded, data);
+  MS_LOG(INFO) << "Decode " << data.size() << " bytes, tree: " << tree_time << "us, table: " << table_time
+               << "us, chunked: " << chunked_time << "us, chunked with " << kThreadNum
+               << " threads: " << parallel_time << "us.";
+}
+}  // namespace mindspore
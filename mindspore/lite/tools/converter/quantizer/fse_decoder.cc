@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include "tools/converter/quantizer/fse_decoder.h"
+#include "tools/converter/quantizer/fse_chunk_end.h"
 #include "include/errorcode.h"
 #include "src/common/log_adapter.h"
 #include "src/common/log_util.h"
@@ -27,6 +29,107 @@ namespace {
 constexpr size_t kTableExtend = 3;
 constexpr size_t kAlignOffset = 7;
 constexpr size_t kThreeBytes = 3;
+constexpr size_t kMaxTableLog = 16;
+constexpr int8_t kMaxBitCount = 64;
+
+template <typename C_TYPE, typename OUT_TYPE>
+struct FSESegments {
+  const FSEBuffer *fse_buffer = nullptr;
+  const uint16_t *states_table = nullptr;
+  const uint8_t *bit_count_table = nullptr;
+  const uint16_t *symbol_table = nullptr;
+  const C_TYPE *centroids = nullptr;
+  OUT_TYPE *output = nullptr;
+  size_t output_count = 0;
+  int task_num = 1;
+};
+
+// The encoder records the chunk end, which is the position in the bit stream and the state after encoding the last
+// symbol of each segment, so every segment is decoded backwards from its chunk end like the whole stream.
+template <typename C_TYPE, typename OUT_TYPE>
+int FSEDecodeSegment(const FSESegments<C_TYPE, OUT_TYPE> &segments, size_t index) {
+  const auto &fse_buffer = *segments.fse_buffer;
+  ChunkEndData chunk_end(fse_buffer.chunk_ends[index]);
+  auto chunk_index = static_cast<int32_t>(chunk_end.bs_position);
+  auto bit_count = static_cast<int8_t>(chunk_end.bit_count);
+  if (bit_count == 0) {
+    chunk_index--;
+    bit_count = kMaxBitCount;
+  }
+  FSEBitStream bs;
+  bs.SetChunks(fse_buffer.chunks);
+  bs.SetCurrChunkIndex(chunk_index);
+  bs.SetCurrBitCount(bit_count);
+  // The last chunk is not in the chunks, but serialized as the current chunk.
+  bs.SetCurrChunk(chunk_index + 1 > fse_buffer.curr_chunk_index ? fse_buffer.curr_chunk
+                                                                   : fse_buffer.chunks[chunk_index + 1]);
+  const size_t segment_count = fse_buffer.chunk_ends_count;
+  auto begin = segments.output_count * index / segment_count;
+  auto count = segments.output_count * (index + 1) / segment_count - begin;
+  auto output = segments.output + begin;
+  auto state = chunk_end.state;
+  while (count > 0 && ((bs.GetCurrChunkIndex() >= 0) || (segments.bit_count_table[state] == 0) ||
+                       (bs.GetCurrBitCount() > 0))) {
+    output[--count] = static_cast<OUT_TYPE>(segments.centroids[segments.symbol_table[state]]);
+    state = segments.states_table[state] + bs.Pop(segments.bit_count_table[state]);
+  }
+  if (count != 0) {
+    MS_LOG(ERROR) << "the bit stream of the segment " << index << " ends before " << count << " symbols.";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+template <typename C_TYPE, typename OUT_TYPE>
+int FSEDecodeSegmentsRun(void *cdata, int task_id, float, float) {
+  auto segments = static_cast<const FSESegments<C_TYPE, OUT_TYPE> *>(cdata);
+  for (size_t index = static_cast<size_t>(task_id); index < segments->fse_buffer->chunk_ends_count;
+       index += static_cast<size_t>(segments->task_num)) {
+    if (FSEDecodeSegment(*segments, index) != RET_OK) {
+      return RET_ERROR;
+    }
+  }
+  return RET_OK;
+}
+
+template <typename C_TYPE, typename OUT_TYPE>
+int FSEDecodeSegments(const FSEBuffer &fse_buffer, OUT_TYPE *output, size_t output_count,
+                      const InnerContext *context) {
+  CHECK_NULL_RETURN(output);
+  if (fse_buffer.table_log > kMaxTableLog) {
+    MS_LOG(ERROR) << "table_log is invalid: " << fse_buffer.table_log;
+    return RET_ERROR;
+  }
+  size_t table_size = 1u << fse_buffer.table_log;
+  std::vector<uint16_t> states_table(table_size);
+  std::vector<uint8_t> bit_count_table(table_size);
+  std::vector<uint16_t> symbol_table(table_size);
+  auto ret = FSEDecoder::FSECreateStatesForDecoding(fse_buffer.frequency, fse_buffer.frequency_count,
+                                                    fse_buffer.table_log, states_table.data(),
+                                                    bit_count_table.data(), symbol_table.data());
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "FSE create states for decoding failed.";
+    return RET_ERROR;
+  }
+  for (size_t i = 0; i < fse_buffer.chunk_ends_count; i++) {
+    ChunkEndData chunk_end(fse_buffer.chunk_ends[i]);
+    if (chunk_end.state >= table_size || chunk_end.bit_count > static_cast<uint16_t>(kMaxBitCount) ||
+        static_cast<int64_t>(chunk_end.bs_position) > static_cast<int64_t>(fse_buffer.curr_chunk_index) + 1) {
+      MS_LOG(ERROR) << "the chunk end " << i << " is invalid.";
+      return RET_ERROR;
+    }
+  }
+  FSESegments<C_TYPE, OUT_TYPE> segments;
+  segments.fse_buffer = &fse_buffer;
+  segments.states_table = states_table.data();
+  segments.bit_count_table = bit_count_table.data();
+  segments.symbol_table = symbol_table.data();
+  segments.centroids = static_cast<const C_TYPE *>(fse_buffer.centroids);
+  segments.output = output;
+  segments.output_count = output_count;
+  segments.task_num = std::min(context->thread_num_, static_cast<int>(fse_buffer.chunk_ends_count));
+  return ParallelLaunch(context, FSEDecodeSegmentsRun<C_TYPE, OUT_TYPE>, &segments, segments.task_num);
+}
 }  // namespace
 int FSEDecoder::FSECreateStatesForDecoding(const uint32_t *symbol_frequency, int symbol_frequency_count,
                                            size_t table_log, uint16_t *new_state_baseline, uint8_t *bit_count,
@@ -162,7 +265,7 @@ int FSEDecoder::DecodeBuffer(int8_t *buffer, size_t data_size, FSEBuffer *fse_bu
 }
 
 int FSEDecoder::DeCompress(const SchemaTensorWrapper &src_tensor, Tensor *dst_tensor,
-                           schema::WeightQuantCompressType compress_type) {
+                           schema::WeightQuantCompressType compress_type, const InnerContext *context) {
   CHECK_NULL_RETURN(src_tensor.handler());
   CHECK_NULL_RETURN(src_tensor.data());
   CHECK_NULL_RETURN(dst_tensor);
@@ -170,81 +273,42 @@ int FSEDecoder::DeCompress(const SchemaTensorWrapper &src_tensor, Tensor *dst_te
     MS_LOG(ERROR) << "tensor data is nullptr.";
     return RET_ERROR;
   }
-  auto total_size = src_tensor.length();
   int out_sz = dst_tensor->ElementsNum();
   MS_CHECK_GT(out_sz, 0, RET_ERROR);
   // deserialize from `data`:
-  FSEBitStream bs;
-
-  size_t i = 0;
   auto data8 = reinterpret_cast<int8_t *>(const_cast<void *>(src_tensor.data()));
   CHECK_NULL_RETURN(data8);
-  // 16bit for frequency_count
-  uint16_t frequency_count = *(reinterpret_cast<uint16_t *>(&data8[i]));
-  i += sizeof(uint16_t);
-  if (i > total_size) {
-    MS_LOG(ERROR) << "index over total size"
-                  << " index:" << i << " total size:" << total_size;
-    return RET_ERROR;
-  }
-  // 16bit for table_log
-  size_t table_log = *(reinterpret_cast<uint16_t *>(&data8[i]));
-  i += sizeof(uint16_t);
-  if (i > total_size) {
-    MS_LOG(ERROR) << "index over total size"
-                  << " index:" << i << " total size:" << total_size;
-    return RET_ERROR;
-  }
-  // 32bit for ChunkCount
-  bs.SetChunkCount(*(reinterpret_cast<uint32_t *>(&data8[i])));
-  const int offset = 2;
-  // 32bit for CurrChunkIndex
-  bs.SetCurrChunkIndex(bs.GetChunkCount() - offset);
-  i += sizeof(uint32_t);
-  if (i > total_size) {
-    MS_LOG(ERROR) << "index over total size"
-                  << " index:" << i << " total size:" << total_size;
-    return RET_ERROR;
-  }
-  // 32bit * frequency_count for frequency
-  auto *frequency = reinterpret_cast<uint32_t *>(&data8[i]);
-  i += frequency_count * sizeof(uint32_t);
-  // Used for 8-byte(64bit) alignment
-  i = ((i + kAlignOffset) >> kTableExtend) << kTableExtend;
-  if (i > total_size) {
-    MS_LOG(ERROR) << "index over total size"
-                  << " index:" << i << " total size:" << total_size;
-    return RET_ERROR;
-  }
-  // 32bit * frequency_count for centroids
-  auto centroids = reinterpret_cast<void *>(&data8[i]);
-  i += frequency_count * sizeof(float);
-  // Used for 8-byte(64bit) alignment
-  i = ((i + kAlignOffset) >> kTableExtend) << kTableExtend;
-  if (i > total_size) {
-    MS_LOG(ERROR) << "index over total size"
-                  << " index:" << i << " total size:" << total_size;
-    return RET_ERROR;
-  }
-  // 64bit * bs.GetCurrChunkIndex() + 1 for Chunks.
-  bs.SetChunks(reinterpret_cast<uint64_t *>(&data8[i]));
-  i += (bs.GetCurrChunkIndex() + 1) * sizeof(uint64_t);
-  if (i > total_size) {
-    MS_LOG(ERROR) << "index over total size"
-                  << " index:" << i << " total size:" << total_size;
+  FSEBuffer fse_buffer;
+  auto ret = DecodeBuffer(data8, src_tensor.length(), &fse_buffer);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Decode the FSE buffer failed.";
     return RET_ERROR;
   }
-  // 64bit for CurrChunk
-  bs.SetCurrChunk(*(reinterpret_cast<uint64_t *>(&data8[i])));
-  i += sizeof(uint64_t);
-  if (i > total_size) {
-    MS_LOG(ERROR) << "index over total size"
-                  << " index:" << i << " total size:" << total_size;
-    return RET_ERROR;
+  if (context != nullptr && context->thread_pool_ != nullptr && fse_buffer.chunk_ends_count > 1) {
+    if (compress_type == schema::WeightQuantCompressType_FSE) {
+      ret = FSEDecodeSegments<float, float>(fse_buffer, static_cast<float *>(dst_tensor->data()), out_sz, context);
+    } else if (src_tensor.handler()->dataType() == kNumberTypeInt8) {
+      ret = FSEDecodeSegments<int, int8_t>(fse_buffer, static_cast<int8_t *>(dst_tensor->data()), out_sz, context);
+    } else {
+      ret = FSEDecodeSegments<int, int16_t>(fse_buffer, static_cast<int16_t *>(dst_tensor->data()), out_sz, context);
+    }
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "FSE Decode the segments failed.";
+      return RET_ERROR;
+    }
+    return RET_OK;
   }
-  // 8bit for CurrBitCount
-  bs.SetCurrBitCount(*(reinterpret_cast<uint8_t *>(&data8[i])));
-  int ret;
+
+  FSEBitStream bs;
+  bs.SetChunkCount(fse_buffer.chunk_count);
+  bs.SetCurrChunkIndex(fse_buffer.curr_chunk_index);
+  bs.SetChunks(fse_buffer.chunks);
+  bs.SetCurrChunk(fse_buffer.curr_chunk);
+  bs.SetCurrBitCount(static_cast<int8_t>(fse_buffer.curr_bit_count));
+  auto frequency = fse_buffer.frequency;
+  auto frequency_count = fse_buffer.frequency_count;
+  auto centroids = fse_buffer.centroids;
+  auto table_log = fse_buffer.table_log;
   if (compress_type == schema::WeightQuantCompressType_FSE) {
     ret = FSEDecode<float, float>(&bs, static_cast<float *>(dst_tensor->data()), out_sz, frequency, frequency_count,
                                   static_cast<float *>(centroids), table_log);
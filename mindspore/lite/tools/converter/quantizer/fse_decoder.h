@@ -22,6 +22,7 @@
 #include "tools/converter/quantizer/fse_bit_stream.h"
 #include "src/tensor.h"
 #include "src/litert/lite_model.h"
+#include "src/litert/inner_context.h"
 
 namespace mindspore::lite::quant {
 struct FSEBuffer {
@@ -44,8 +45,9 @@ class FSEDecoder {
   FSEDecoder() = default;
   ~FSEDecoder() = default;
 
+  // The segments split by the chunk ends are decoded on the thread pool of the context if it is given.
   static int DeCompress(const SchemaTensorWrapper &src_tensor, Tensor *dst_tensor,
-                        schema::WeightQuantCompressType compress_type);
+                        schema::WeightQuantCompressType compress_type, const InnerContext *context = nullptr);
 
   static int FSECreateStatesForDecoding(const uint32_t *symbol_frequency, int symbol_frequency_count, size_t table_log,
                                         uint16_t *new_state_baseline, uint8_t *bit_count, uint16_t *symbol_table);
@@ -37,6 +37,20 @@ constexpr size_t kAlignHalfSize = 4u;
 constexpr float kUpRoundOffSet = 0.5f;
 constexpr size_t kMaxModelBufferSize = 1024u * 1024 * 1024 * 2;  // 2G
 constexpr size_t PARALLEL_MIN_SIZE = 10000;
+// Without a given number, the weights for the CPU are split into the segments of this many symbols at least, so that
+// the runtime decodes them in parallel.
+constexpr size_t kDecodeSegmentSize = 64 * 1024;
+constexpr size_t kMaxDecodeSegments = 64;
+
+size_t GetSegmentCount(size_t symbol_count, mindspore::TensorCompressionType compress_type, int max_segments) {
+  if (symbol_count <= PARALLEL_MIN_SIZE) {
+    return 1;
+  }
+  if (compress_type == mindspore::kFSEInfer || max_segments > 1) {
+    return static_cast<size_t>(std::max(max_segments, 1));
+  }
+  return std::min(kMaxDecodeSegments, std::max<size_t>(symbol_count / kDecodeSegmentSize, 1));
+}
 }  // namespace
 
 int FSEEncoder::FSECreateStatesForEncoding(const uint32_t *frequency, size_t frequency_count, size_t table_log,
@@ -131,10 +145,12 @@ int FSEEncoder::Compress(const ParameterPtr &weight, const std::vector<schema::Q
     free(fse_quant.symbol_table);
     return ret;
   }
-  size_t num_chunk_ends = (fse_quant.symbol_table_count > PARALLEL_MIN_SIZE) ? max_segments : 1;
+  size_t num_chunk_ends = GetSegmentCount(fse_quant.symbol_table_count, compress_type, max_segments);
   fse_quant.chunk_ends = static_cast<ChunkEndData *>(malloc(num_chunk_ends * sizeof(ChunkEndData)));
   if (fse_quant.chunk_ends == nullptr) {
     MS_LOG(ERROR) << "malloc memory failed.";
+    bs.Free();
+    free(fse_quant.symbol_table);
     return RET_ERROR;
   }
   fse_quant.num_chunk_ends = num_chunk_ends;
@@ -142,19 +158,21 @@ int FSEEncoder::Compress(const ParameterPtr &weight, const std::vector<schema::Q
                   fse_quant.chunk_ends, fse_quant.size, table_log);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "FSE Encode failed.";
+    bs.Free();
     free(fse_quant.symbol_table);
+    free(fse_quant.chunk_ends);
     return ret;
   }
   bs.Flush();
   // Serializing to out:
   ret = SerializingToTensor(weight, &bs, fse_quant, table_log, compress_type);
+  bs.Free();
+  free(fse_quant.symbol_table);
+  free(fse_quant.chunk_ends);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "Serializing To Tensor failed.";
-    free(fse_quant.symbol_table);
     return ret;
   }
-  bs.Free();
-  free(fse_quant.symbol_table);
   return RET_OK;
 }
 
@@ -341,7 +359,14 @@ int FSEEncoder::SerializingToBuffer(const FSEBitStream *bs, const FSEQuant &fse_
     MS_LOG(ERROR) << " too many symbol.";
     return RET_ERROR;
   }
-  if ((compress_type == mindspore::kFSEInfer) && (fse_quant.num_chunk_ends > 0)) {
+  // The chunk ends are behind all the data, which the runtime without parallel decoding never reads. They are optional
+  // for the CPU, so they are dropped if the buffer can not hold them.
+  bool with_chunk_ends = compress_type == mindspore::kFSEInfer && fse_quant.num_chunk_ends > 0;
+  if (compress_type != mindspore::kFSEInfer && fse_quant.num_chunk_ends > 1) {
+    size_t chunk_ends_size = kAlignHalfSize + sizeof(uint32_t) + fse_quant.num_chunk_ends * sizeof(uint64_t);
+    with_chunk_ends = offset + chunk_ends_size <= max_size;
+  }
+  if (with_chunk_ends) {
     while (offset % kAlignHalfSize != 0) {
       CHECK_LARGE_RETURN(offset + sizeof(uint8_t), max_size);
       *(reinterpret_cast<uint8_t *>(&out8[offset])) = (uint8_t)0;
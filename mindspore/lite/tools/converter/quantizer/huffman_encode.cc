@@ -172,8 +172,6 @@ int HuffmanEncode::BuildHuffmanTree(HuffmanPriorityQueue *pq) {
 
 int HuffmanEncode::DoHuffmanCompress(const int8_t *input_datas, const size_t data_size) {
   MS_ASSERT(input_datas != nullptr);
-  unsigned char out_c;
-  string code_str;
   std::map<int, string>::iterator iter;
   std::vector<std::string> encode_str = {"", "", ""};
 
@@ -183,33 +181,67 @@ int HuffmanEncode::DoHuffmanCompress(const int8_t *input_datas, const size_t dat
     encode_str[1] += iter->second + " ";
   }
 
+  bool chunked = data_size > kHuffmanChunkSymbols;
+  std::vector<uint64_t> chunk_offsets;
+  unsigned char out_c = 0;
+  size_t bit_count = 0;
+  auto flush_byte = [&encode_str, &out_c, &bit_count]() {
+    if (bit_count != 0) {
+      encode_str[2] += static_cast<char>(out_c);
+      out_c = 0;
+      bit_count = 0;
+    }
+  };
+  auto append_code = [&encode_str, &out_c, &bit_count](const std::string &code) {
+    for (auto bit : code) {
+      out_c |= static_cast<unsigned char>((bit == '0' ? 0 : 1) << ((quant::k8Bit - 1) - bit_count));
+      if (++bit_count == quant::k8Bit) {
+        encode_str[2] += static_cast<char>(out_c);
+        out_c = 0;
+        bit_count = 0;
+      }
+    }
+  };
   for (size_t i = 0; i < data_size; i++) {
+    // Every chunk starts at a byte.
+    if (chunked && i % kHuffmanChunkSymbols == 0) {
+      flush_byte();
+      chunk_offsets.push_back(encode_str[2].size());
+    }
     auto raw_num = input_datas[i];
     iter = huffman_table_.find(raw_num);
     if (iter != huffman_table_.end()) {
-      code_str += iter->second;
+      append_code(iter->second);
     } else {
       MS_LOG(ERROR) << "Can't find the huffman code " << raw_num;
       return RET_ERROR;
     }
   }
-  iter = huffman_table_.find(PSEUDO_EOF);
-  if (iter != huffman_table_.end()) {
-    code_str += iter->second;
-  } else {
-    MS_LOG(ERROR) << "Can't find the huffman code pseudo-EOF";
-    return RET_ERROR;
-  }
-  out_c = 0;
-  for (size_t i = 0; i < code_str.length(); i++) {
-    auto tmp_c = code_str[i] == '0' ? 0 : 1;
-    out_c += tmp_c << ((quant::k8Bit - 1) - (i % quant::k8Bit));
-    if ((i + 1) % quant::k8Bit == 0 || i == code_str.length() - 1) {
-      encode_str[2] += out_c;
-      out_c = 0;
+  if (!chunked) {
+    iter = huffman_table_.find(PSEUDO_EOF);
+    if (iter != huffman_table_.end()) {
+      append_code(iter->second);
+    } else {
+      MS_LOG(ERROR) << "Can't find the huffman code pseudo-EOF";
+      return RET_ERROR;
     }
   }
-  huffman_encoded_str_ = encode_str[0] + "#" + encode_str[1] + "#" + encode_str[2];
+  flush_byte();
+  if (!chunked) {
+    huffman_encoded_str_ = encode_str[0] + kHuffmanSeparator + encode_str[1] + kHuffmanSeparator + encode_str[2];
+    return RET_OK;
+  }
+  huffman_encoded_str_ = kHuffmanSeparator + encode_str[0] + kHuffmanSeparator + encode_str[1] + kHuffmanSeparator;
+  auto append_value = [this](const auto &value) {
+    (void)huffman_encoded_str_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+  append_value(static_cast<uint64_t>(data_size));
+  append_value(static_cast<uint32_t>(kHuffmanChunkSymbols));
+  append_value(static_cast<uint32_t>(chunk_offsets.size()));
+  for (auto offset : chunk_offsets) {
+    append_value(offset);
+  }
+  huffman_encoded_str_ += encode_str[2];
   return RET_OK;
 }
 
@@ -29,10 +29,10 @@
 #include "schema/inner/model_generated.h"
 #include "securec/include/securec.h"
 #include "src/common/log_adapter.h"
+#include "src/litert/huffman_decode.h"
 
 namespace mindspore {
 namespace lite {
-const int PSEUDO_EOF = 128;
 
 struct HuffmanNode {
   int key;
@@ -68,6 +68,7 @@ class HuffmanEncode {
 
   int BuildHuffmanTree(HuffmanPriorityQueue *pq);
 
+  // A weight of more than kHuffmanChunkSymbols is written in the chunked layout of huffman_decode.h.
   int DoHuffmanCompress(const int8_t *input_datas, size_t data_size);
 };
 
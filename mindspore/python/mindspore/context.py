@@ -1144,6 +1144,8 @@ def set_offload_context(offload_config):
             - enable_aio (bool): The flag of whether enabling aio. Default: ``True``.
             - aio_block_size (str): The size of aio block. The format is "xxGB".
             - aio_queue_depth (int): The depth of aio queue.
+            - prefetch_kernel_num (int): The number of kernels ahead of the kernel using an offloaded tensor to swap
+              it in, if the device memory is enough. ``0`` means swapping in just before the kernel. Default: ``2``.
             - offload_param (str):  The param for offload destination, cpu or disk, Default: ``""``.
             - offload_checkpoint (str):  The checkpoint for offload destination, only valid if recompute is turned on,
               cpu or disk, Default: ``""``.
@@ -47,6 +47,8 @@ __all__ = ['set_sending_batches', 'load', '_init_device_info',
            'set_auto_offload', 'get_auto_offload',
            'set_enable_watchdog', 'get_enable_watchdog',
            'set_fast_recovery', 'get_fast_recovery',
+           'set_first_ready_mode', 'get_first_ready_mode',
+           'set_zero_copy_batch', 'get_zero_copy_batch',
            'set_debug_mode', 'get_debug_mode',
            'set_error_samples_mode', 'get_error_samples_mode', 'ErrorSamplesMode',
            'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval']
@@ -897,6 +899,87 @@ def get_fast_recovery():
     return _config.get_fast_recovery()
 
 
+def set_first_ready_mode(first_ready_mode):
+    """
+    Set whether the parallel operations of the dataset pipeline deliver whichever row is ready first, instead of
+    preserving the row order. When enabled, a slow worker of `map` or `batch` operation does not stall the other
+    workers, which gives higher and steadier throughput for the pipelines that do not need the exact row order.
+
+    Note:
+        The setting takes effect for the pipelines created afterwards. In first ready mode, the order of the rows
+        within an epoch may differ from run to run, but the rows of different epochs are never mixed.
+
+    Args:
+        first_ready_mode (bool): Whether to deliver whichever row is ready first.
+
+    Raises:
+        TypeError: If `first_ready_mode` is not a boolean data type.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_first_ready_mode(True)
+    """
+    if not isinstance(first_ready_mode, bool):
+        raise TypeError("first_ready_mode must be a boolean dtype.")
+    _config.set_first_ready_mode(first_ready_mode)
+
+
+def get_first_ready_mode():
+    """
+    Get whether the parallel operations of the dataset pipeline deliver whichever row is ready first.
+    It is set to False by default.
+
+    Returns:
+        bool, whether the first ready mode is enabled.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> first_ready_mode = ds.config.get_first_ready_mode()
+    """
+    return _config.get_first_ready_mode()
+
+
+def set_zero_copy_batch(zero_copy_batch):
+    """
+    Set whether the workers of a `map` operation write the rows straight into the batch tensors of the `batch`
+    operation right after it. When enabled, the batch is published as it is instead of being copied together from
+    the rows, which saves a full pass over the memory of every batch.
+
+    Note:
+        The setting takes effect for the pipelines created afterwards. It only applies to a `batch` operation without
+        `per_batch_map`, `pad_info` or a batch size function which directly follows a `map` operation, and does not
+        apply in first ready mode. The columns whose shape varies from row to row are still copied.
+
+    Args:
+        zero_copy_batch (bool): Whether the map workers write the rows into the batch tensors directly.
+
+    Raises:
+        TypeError: If `zero_copy_batch` is not a boolean data type.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_zero_copy_batch(True)
+    """
+    if not isinstance(zero_copy_batch, bool):
+        raise TypeError("zero_copy_batch must be a boolean dtype.")
+    _config.set_zero_copy_batch(zero_copy_batch)
+
+
+def get_zero_copy_batch():
+    """
+    Get whether the workers of a `map` operation write the rows straight into the batch tensors.
+    It is set to False by default.
+
+    Returns:
+        bool, whether the zero copy batch is enabled.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> zero_copy_batch = ds.config.get_zero_copy_batch()
+    """
+    return _config.get_zero_copy_batch()
+
+
 def set_debug_mode(debug_mode_flag: bool, debug_hook_list: list = None):
     """
     Set the debug_mode flag of the dataset pipeline. When enabled, the dataset pipeline is run synchronously and
@@ -91,6 +91,7 @@ class FileWriter:
 
         self._shard_num = shard_num
         self._index_generator = True
+        self._columnar_index = False
         suffix_shard_size = len(str(self._shard_num - 1))
 
         if self._shard_num == 1:
@@ -419,6 +420,34 @@ class FileWriter:
         """
         self._writer.set_page_size(page_size)
 
+    def set_columnar_index(self, enable):
+        """
+        Whether to write a columnar index file `*.idx` next to each index file `*.db` when commit. \
+        The columnar index is memory mapped by the reader, so the index fields and the offsets of \
+        a sample are looked up without querying the index file `*.db`, which speeds up random \
+        access of large datasets. The index file `*.db` is still written and used when the \
+        columnar index is missing. The columnar index is not written when encode mode or hash \
+        check is enabled.
+
+        Args:
+            enable (bool): Whether to write the columnar index. Default: ``False``.
+
+        Raises:
+            ParamValueError: If `enable` is not bool.
+
+        Examples:
+            >>> from mindspore.mindrecord import FileWriter
+            >>> writer = FileWriter(file_name="test.mindrecord", shard_num=1)
+            >>> writer.set_columnar_index(True)
+        """
+        if not isinstance(enable, bool):
+            raise ParamValueError("Parameter enable's type is not bool.")
+        self._columnar_index = enable
+
+    def _use_columnar_index(self):
+        """The columnar index is not encrypted, so it is only written for plain mindrecord files."""
+        return self._columnar_index and _get_enc_key() is None and _get_hash_mode() is None
+
     def commit(self):  # pylint: disable=W0212
         """
         Flush data in memory to disk and generate the corresponding database files.
@@ -444,9 +473,10 @@ class FileWriter:
             self._writer.commit()
             if self._index_generator:
                 if self._append:
-                    self._generator = ShardIndexGenerator(self._file_name, self._append)
+                    self._generator = ShardIndexGenerator(self._file_name, self._append, self._use_columnar_index())
                 elif len(self._paths) >= 1:
-                    self._generator = ShardIndexGenerator(os.path.realpath(self._paths[0]), self._append)
+                    self._generator = ShardIndexGenerator(os.path.realpath(self._paths[0]), self._append,
+                                                          self._use_columnar_index())
                 self._generator.build()
                 self._generator.write_to_db()
         else:
@@ -471,6 +501,9 @@ class FileWriter:
             if os.path.exists(index_file):
                 os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
                 index_files.append(index_file)
+            columnar_index_file = item + ".idx"
+            if os.path.exists(columnar_index_file):
+                os.chmod(columnar_index_file, stat.S_IRUSR | stat.S_IWUSR)
 
         for item in self._paths:
             if os.path.exists(item):
@@ -489,7 +522,7 @@ class FileWriter:
 
     def _index_worker(self, i):
         """The worker do the index generator"""
-        generator = ShardIndexGenerator(os.path.realpath(self._paths[i]), False)
+        generator = ShardIndexGenerator(os.path.realpath(self._paths[i]), False, self._use_columnar_index())
         generator.build()
         generator.write_to_db()
 
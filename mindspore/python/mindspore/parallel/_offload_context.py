@@ -38,6 +38,7 @@ class _OffloadConfig:
     ENABLE_AIO = "enable_aio"
     AIO_BLOCK_SIZE = "aio_block_size"
     AIO_QUEUE_DEPTH = "aio_queue_depth"
+    PREFETCH_KERNEL_NUM = "prefetch_kernel_num"
     ENABLE_PINNED_MEM = "enable_pinned_mem"
     AUTO_OFFLOAD = "auto_offload"
     CPU_RATIO = "cpu_ratio"
@@ -156,6 +157,12 @@ class _OffloadContext:
             aio_queue_depth, "aio_queue_depth", "set_aio_queue_depth")
         self._context_handle.set_aio_queue_depth(aio_queue_depth)
 
+    def set_prefetch_kernel_num(self, prefetch_kernel_num):
+        """Set prefetch_kernel_num"""
+        Validator.check_non_negative_int(
+            prefetch_kernel_num, "prefetch_kernel_num", "set_prefetch_kernel_num")
+        self._context_handle.set_prefetch_kernel_num(prefetch_kernel_num)
+
     def set_enable_pinned_mem(self, enable_pinned_mem):
         """Set enable_pinned_mem"""
         Validator.check_bool(
@@ -205,6 +212,7 @@ class _OffloadContext:
                                    _OffloadConfig.HBM_RATIO, _OffloadConfig.OFFLOAD_CPU_SIZE,
                                    _OffloadConfig.OFFLOAD_DISK_SIZE, _OffloadConfig.ENABLE_AIO,
                                    _OffloadConfig.AIO_BLOCK_SIZE, _OffloadConfig.AIO_QUEUE_DEPTH,
+                                   _OffloadConfig.PREFETCH_KERNEL_NUM,
                                    _OffloadConfig.ENABLE_PINNED_MEM, _OffloadConfig.AUTO_OFFLOAD,
                                    _OffloadConfig.OFFLOAD_CHECKPOINT]:
                 unknown_config.append(config_name)
@@ -228,6 +236,7 @@ class _OffloadContext:
             _OffloadConfig.ENABLE_AIO: self._context_handle.enable_aio(),
             _OffloadConfig.AIO_BLOCK_SIZE: self._context_handle.aio_block_size(),
             _OffloadConfig.AIO_QUEUE_DEPTH: self._context_handle.aio_queue_depth(),
+            _OffloadConfig.PREFETCH_KERNEL_NUM: self._context_handle.prefetch_kernel_num(),
             _OffloadConfig.ENABLE_PINNED_MEM: self._context_handle.enable_pinned_mem(),
             _OffloadConfig.AUTO_OFFLOAD: self._context_handle.auto_offload(),
             _OffloadConfig.HOST_MEM_BLOCk_SIZE: self._context_handle.host_mem_block_size(),
@@ -266,6 +275,7 @@ _set_offload_context_func_map = {
     _OffloadConfig.ENABLE_AIO: offload_context().set_enable_aio,
     _OffloadConfig.AIO_BLOCK_SIZE: offload_context().set_aio_block_size,
     _OffloadConfig.AIO_QUEUE_DEPTH: offload_context().set_aio_queue_depth,
+    _OffloadConfig.PREFETCH_KERNEL_NUM: offload_context().set_prefetch_kernel_num,
     _OffloadConfig.ENABLE_PINNED_MEM: offload_context().set_enable_pinned_mem,
     _OffloadConfig.AUTO_OFFLOAD: offload_context().set_auto_offload,
     _OffloadConfig.HOST_MEM_BLOCk_SIZE: offload_context().set_host_mem_block_size,
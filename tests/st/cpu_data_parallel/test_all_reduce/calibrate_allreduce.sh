@@ -0,0 +1,74 @@
+#!/bin/bash
+# Copyright 2024 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+# Calibrate the thresholds of the cpu AllReduce algorithms over localhost.
+# Usage: bash calibrate_allreduce.sh [WORKER_NUM] [PORT], the ports from PORT to PORT + 2 are used.
+# Every algorithm runs run_allreduce_bandwidth.py with WORKER_NUM workers, then the fastest algorithm of every size
+# and the thresholds to set by MS_CPU_COLLECTIVE_SMALL_SIZE and MS_CPU_COLLECTIVE_LARGE_SIZE are printed.
+
+WORKER_NUM=${1:-8}
+PORT=${2:-8122}
+export MS_WORKER_NUM=${WORKER_NUM}
+export MS_SCHED_HOST=127.0.0.1
+
+for algo in recursive_doubling rabenseifner ring; do
+    export MS_CPU_ALLREDUCE_ALGO=${algo}
+    # Every run has a scheduler port of its own, the last one may not be released yet.
+    export MS_SCHED_PORT=${PORT}
+    PORT=$((PORT + 1))
+    MS_ROLE=MS_SCHED python3 run_allreduce_bandwidth.py >scheduler_${algo}.log 2>&1 &
+    sched_pid=${!}
+    process_pid=()
+    for((i=0;i<${WORKER_NUM};i++));
+    do
+        MS_ROLE=MS_WORKER python3 run_allreduce_bandwidth.py >worker_${algo}_${i}.log 2>&1 &
+        process_pid[${i}]=${!}
+    done
+    wait ${sched_pid}
+    for((i=0;i<${WORKER_NUM};i++));
+    do
+        wait ${process_pid[${i}]}
+        if [ ${?} != 0 ]; then
+            echo "[ERROR] run ${algo} on worker ${i} failed."
+            exit 1
+        fi
+    done
+    grep "bus bandwidth" worker_${algo}_0.log
+done
+
+python3 - <<'PYEOF'
+import re
+
+times = {}
+for algo in ["recursive_doubling", "rabenseifner", "ring"]:
+    with open(f"worker_{algo}_0.log") as log:
+        for line in log:
+            match = re.search(r"algo: (\w+), size: (\d+) bytes, time: ([\d.]+) ms", line)
+            if match:
+                times.setdefault(int(match.group(2)), {})[algo] = float(match.group(3))
+
+small_size, large_size = None, None
+for size in sorted(times):
+    best = min(times[size], key=times[size].get)
+    print(f"size: {size} bytes, fastest: {best}, " +
+          ", ".join(f"{algo}: {elapsed:.3f} ms" for algo, elapsed in times[size].items()))
+    if best != "recursive_doubling" and small_size is None:
+        small_size = size
+    if best == "ring" and large_size is None:
+        large_size = size
+print(f"export MS_CPU_COLLECTIVE_SMALL_SIZE={small_size or max(times) + 1}")
+print(f"export MS_CPU_COLLECTIVE_LARGE_SIZE={large_size or max(times) + 1}")
+PYEOF
@@ -0,0 +1,69 @@
+# Copyright 2024 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""measure the bus bandwidth of AllReduce, run with MS_CPU_ALLREDUCE_ALGO=ring to compare with the ring algorithm"""
+
+import os
+import time
+import numpy as np
+
+from mindspore import Tensor
+from mindspore import context
+from mindspore import nn
+from mindspore.ops import operations as P
+from mindspore.communication.management import init, get_group_size, get_rank
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+context.set_ps_context(enable_ssl=False)
+init()
+
+SIZES = [4, 256, 4 << 10, 64 << 10, 256 << 10, 1 << 20, 4 << 20, 16 << 20, 64 << 20]
+WARMUP = 2
+ITERATIONS = 10
+
+
+class Net(nn.Cell):
+    def __init__(self):
+        super(Net, self).__init__()
+        self.all_reduce = P.AllReduce()
+
+    def construct(self, x):
+        return self.all_reduce(x)
+
+
+def run_all_reduce_bandwidth():
+    """ Run all reduce of every size and print the bus bandwidth"""
+    rank_size = get_group_size()
+    algo = os.getenv("MS_CPU_ALLREDUCE_ALGO", "auto")
+    for size in SIZES:
+        net = Net()
+        x_np = np.ones(size // 4, np.float32) * (get_rank() + 1)
+        x_input = Tensor(x_np)
+        for _ in range(WARMUP):
+            output = net(x_input)
+        start = time.time()
+        for _ in range(ITERATIONS):
+            output = net(x_input)
+        elapsed = (time.time() - start) / ITERATIONS
+        assert np.array_equal(output.asnumpy(), np.ones(size // 4, np.float32) * rank_size * (rank_size + 1) / 2)
+        # Every byte is sent and received 2 * (n - 1) / n times by the ring, the bus bandwidth is comparable among the
+        # numbers of ranks and algorithms.
+        bus_bandwidth = 2 * (rank_size - 1) / rank_size * size / elapsed / (1 << 30)
+        if get_rank() == 0:
+            print(f"algo: {algo}, size: {size} bytes, time: {elapsed * 1000:.3f} ms, "
+                  f"bus bandwidth: {bus_bandwidth:.3f} GB/s", flush=True)
+
+
+run_all_reduce_bandwidth()
@@ -52,3 +52,36 @@ def test_allreduce_small_scale_data():
         return
     return_code = os.system("bash build_allreduce_net_cluster.sh run_allreduce_small_scale_data.py 8081")
     assert return_code == 0
+
+
+@arg_mark(plat_marks=['cpu_linux'], level_mark='level1', card_mark='onecard', essential_mark='unessential')
+def test_allreduce_bandwidth():
+    """
+    Feature: CPU data parallel.
+    Description: Test AllReduce of various sizes on CPU with the ring algorithm and the shared memory algorithm
+        picked for the ranks on the same host, the bus bandwidth is printed in worker_0.log.
+    Expectation: Each node obtains all node reduced result with both algorithms.
+    """
+    if sys.platform != 'linux':
+        return
+    return_code = os.system("MS_CPU_ALLREDUCE_ALGO=ring bash build_allreduce_net_cluster.sh "
+                            "run_allreduce_bandwidth.py 8120")
+    assert return_code == 0
+    os.system("grep 'bus bandwidth' worker_0.log")
+    return_code = os.system("bash build_allreduce_net_cluster.sh run_allreduce_bandwidth.py 8121")
+    assert return_code == 0
+    os.system("grep 'bus bandwidth' worker_0.log")
+
+
+@arg_mark(plat_marks=['cpu_linux'], level_mark='level1', card_mark='onecard', essential_mark='unessential')
+def test_allreduce_calibration():
+    """
+    Feature: CPU data parallel.
+    Description: Test AllReduce of various sizes on CPU with recursive doubling, Rabenseifner and ring, and print the
+        thresholds to select them.
+    Expectation: Each node obtains all node reduced result with every algorithm.
+    """
+    if sys.platform != 'linux':
+        return
+    return_code = os.system("bash calibrate_allreduce.sh 6 8122")
+    assert return_code == 0
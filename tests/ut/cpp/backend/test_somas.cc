@@ -0,0 +1,244 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "include/backend/kernel_graph.h"
+#include "backend/common/somas/somas_node.h"
+#include "backend/common/somas/somas_solver_pre.h"
+#include "backend/common/somas/somas_stream.h"
+#define private public
+#define protected public
+#include "backend/common/somas/somas.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace somas {
+namespace {
+constexpr size_t kAlignSize = 512;
+// More nodes and tensors than the threshold of computing the conflict matrix in parallel.
+constexpr size_t kLargeNodeNum = 2100;
+constexpr size_t kChainNodeNum = 20;
+
+class TestSomasImpl : public Somas {
+ private:
+  bool Initialize() override { return true; }
+  string GetDeviceName() const override { return "UT"; }
+  size_t GetAlignSize(size_t original_size) const override {
+    return (original_size + kAlignSize - 1) / kAlignSize * kAlignSize;
+  }
+  bool GetDependExecOrderFlag(const session::KernelGraph &) const override { return false; }
+  bool InitDevSpecControlTensors(const session::KernelGraph &) override { return true; }
+  bool DevSpecNodeProcess(const session::KernelGraph &) override { return true; }
+  bool NeedContiguous(const std::vector<size_t> &) const override { return false; }
+};
+
+SomasNodePtr AddNode(Somas *somas) {
+  auto id = somas->nodes_list_.size();
+  auto node = std::make_shared<SomasNode>("Default/node_" + std::to_string(id), id, kCommonNode, 0);
+  somas->nodes_list_.push_back(node);
+  return node;
+}
+
+SomasTensorPtr AddTensor(Somas *somas, const SomasNodePtr &node, size_t size, bool is_workspace = false,
+                         LifeLongType lifelong = kLifeLongNone) {
+  auto tensor = std::make_shared<SomasTensor>(somas->tensors_list_.size(), node->GetId(), 0, size, size, lifelong);
+  tensor->type_ = is_workspace ? kWorkspace : kCommon;
+  tensor->lifetime_.start_ = node->GetId();
+  tensor->lifetime_.end_ = node->GetId();
+  if (is_workspace) {
+    node->workspace_tensors_.push_back(tensor);
+  } else {
+    node->output_tensors_.push_back(tensor);
+  }
+  somas->tensors_list_.push_back(tensor);
+  return tensor;
+}
+
+void AddConsumer(const SomasTensorPtr &tensor, const SomasNodePtr &producer, const SomasNodePtr &consumer) {
+  tensor->consumer_list_.push_back(consumer->GetId());
+  (void)tensor->destination_nodes_.insert(consumer->GetId());
+  tensor->lifetime_.end_ = std::max(tensor->lifetime_.end_, consumer->GetId());
+  (void)consumer->ancestor_nodes_.insert(producer);
+}
+
+// A random graph whose nodes depend on one or two of the recent nodes, every node outputs a tensor used by some of
+// the later nodes, and some of the tensors live from the start or to the end of the graph.
+void BuildRandomGraph(Somas *somas, size_t node_num, uint32_t seed) {
+  constexpr size_t kWindow = 16;
+  std::mt19937 gen(seed);
+  for (size_t i = 0; i < node_num; ++i) {
+    auto node = AddNode(somas);
+    for (size_t j = 0; j < 2 && i > 0; ++j) {
+      auto ancestor = somas->nodes_list_[i - 1 - gen() % std::min(i, kWindow)];
+      (void)node->ancestor_nodes_.insert(ancestor);
+    }
+    auto lifelong = kLifeLongNone;
+    if (gen() % 50 == 0) {
+      lifelong = i % 2 == 0 ? kLifeLongGraphStart : kLifeLongGraphEnd;
+    }
+    (void)AddTensor(somas, node, (gen() % 16 + 1) * kAlignSize, false, lifelong);
+  }
+  for (size_t i = 0; i + 1 < node_num; ++i) {
+    const auto &producer = somas->nodes_list_[i];
+    const auto &tensor = producer->output_tensors_[0];
+    auto consumer_num = gen() % 3 + 1;
+    for (size_t j = 0; j < consumer_num; ++j) {
+      auto consumer_id = i + 1 + gen() % std::min(node_num - i - 1, kWindow);
+      if (tensor->destination_nodes_.count(consumer_id) == 0) {
+        AddConsumer(tensor, producer, somas->nodes_list_[consumer_id]);
+      }
+    }
+  }
+}
+
+// A chain of nodes, each of which outputs a tensor used by the next node, so two slots are enough for all the tensors.
+void BuildChainGraph(Somas *somas, size_t node_num) {
+  for (size_t i = 0; i < node_num; ++i) {
+    auto node = AddNode(somas);
+    (void)AddTensor(somas, node, kAlignSize * 4);
+    if (i > 0) {
+      AddConsumer(somas->tensors_list_[i - 1], somas->nodes_list_[i - 1], node);
+    }
+  }
+}
+
+bool IsConflict(const Somas &somas, size_t id1, size_t id2) {
+  return somas.tensors_list_[id1]->IsLifelong() || somas.tensors_list_[id2]->IsLifelong() ||
+         !somas.reuse_matrix_[id1].IsBitTrue(id2) || !somas.reuse_matrix_[id2].IsBitTrue(id1);
+}
+
+// Every two tensors which may be alive at the same time are placed at disjoint addresses.
+void CheckNoOverlap(const Somas &somas) {
+  const auto &tensors = somas.tensors_list_;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    for (size_t j = i + 1; j < tensors.size(); ++j) {
+      if (!IsConflict(somas, i, j)) {
+        continue;
+      }
+      auto overlap = tensors[i]->GetOffset() < tensors[j]->GetOffset() + tensors[j]->GetAlignedSize() &&
+                     tensors[j]->GetOffset() < tensors[i]->GetOffset() + tensors[i]->GetAlignedSize();
+      ASSERT_FALSE(overlap) << "tensor " << i << " at " << tensors[i]->GetOffset() << " and tensor " << j << " at "
+                            << tensors[j]->GetOffset() << " overlap";
+    }
+  }
+}
+}  // namespace
+
+class TestSomas : public UT::Common {
+ public:
+  TestSomas() {}
+};
+
+/// Feature: SOMAS conflict matrix.
+/// Description: compute the conflict matrix of a graph large enough to be split into several jobs, once by the jobs
+/// and once in a single job.
+/// Expectation: the two matrices are the same bit for bit.
+TEST_F(TestSomas, ParallelConflictMatrixEqualsSerial) {
+  constexpr uint32_t kSeed = 2024;
+  TestSomasImpl parallel;
+  BuildRandomGraph(&parallel, kLargeNodeNum, kSeed);
+  parallel.ComputeConflictMatrix();
+  TestSomasImpl serial;
+  serial.parallel_compute_ = false;
+  BuildRandomGraph(&serial, kLargeNodeNum, kSeed);
+  serial.ComputeConflictMatrix();
+
+  ASSERT_EQ(parallel.reuse_matrix_.size(), kLargeNodeNum);
+  ASSERT_EQ(serial.reuse_matrix_.size(), kLargeNodeNum);
+  size_t reuse_num = 0;
+  for (size_t i = 0; i < kLargeNodeNum; ++i) {
+    ASSERT_EQ(parallel.reuse_matrix_[i].bit_, serial.reuse_matrix_[i].bit_) << "row " << i << " differs";
+    const auto &bits = serial.reuse_matrix_[i].bit_;
+    reuse_num += static_cast<size_t>(std::count(bits.begin(), bits.end(), true));
+  }
+  // The graph is not trivial, some tensors can share memory and some can not.
+  ASSERT_GT(reuse_num, 0);
+  ASSERT_LT(reuse_num, kLargeNodeNum * (kLargeNodeNum - 1));
+}
+
+/// Feature: SOMAS incremental planning.
+/// Description: plan a graph, then plan the same graph again in a new SOMAS instance.
+/// Expectation: the second time the cached plan is reused instead of solving, and every tensor gets the same offset.
+TEST_F(TestSomas, RepeatedGraphReusesCachedPlan) {
+  auto graph = std::make_shared<session::KernelGraph>();
+  graph->set_graph_id(1);
+  TestSomasImpl first;
+  first.device_name_ = "UT_REPEATED_GRAPH";
+  first.enable_incremental_ = true;
+  BuildChainGraph(&first, kChainNodeNum);
+  first.ComputeConflictMatrix();
+  first.Solve(*graph);
+  ASSERT_FALSE(first.plan_reused_);
+  first.SaveIncrementalPlan(*graph);
+
+  TestSomasImpl second;
+  second.device_name_ = first.device_name_;
+  second.enable_incremental_ = true;
+  BuildChainGraph(&second, kChainNodeNum);
+  second.ComputeConflictMatrix();
+  second.Solve(*graph);
+  ASSERT_TRUE(second.plan_reused_);
+  for (size_t i = 0; i < kChainNodeNum; ++i) {
+    ASSERT_EQ(second.tensors_list_[i]->GetOffset(), first.tensors_list_[i]->GetOffset());
+  }
+  CheckNoOverlap(second);
+}
+
+/// Feature: SOMAS incremental planning.
+/// Description: plan a graph, then plan a changed graph with a new graph id, in which the first tensor lives longer
+/// and a node gets a new workspace.
+/// Expectation: the previous plan is reused for most of the tensors, and the tensors which may be alive at the same
+/// time, including the moved and the new ones, never overlap.
+TEST_F(TestSomas, IncrementalPlanHasNoOverlap) {
+  constexpr size_t kWorkspaceNode = 5;
+  auto graph = std::make_shared<session::KernelGraph>();
+  graph->set_graph_id(1);
+  TestSomasImpl origin;
+  origin.device_name_ = "UT_CHANGED_GRAPH";
+  origin.enable_incremental_ = true;
+  BuildChainGraph(&origin, kChainNodeNum);
+  origin.ComputeConflictMatrix();
+  origin.Solve(*graph);
+  ASSERT_FALSE(origin.plan_reused_);
+  CheckNoOverlap(origin);
+  origin.SaveIncrementalPlan(*graph);
+
+  auto changed_graph = std::make_shared<session::KernelGraph>();
+  changed_graph->set_graph_id(2);
+  TestSomasImpl changed;
+  changed.device_name_ = origin.device_name_;
+  changed.enable_incremental_ = true;
+  BuildChainGraph(&changed, kChainNodeNum);
+  AddConsumer(changed.tensors_list_[0], changed.nodes_list_[0], changed.nodes_list_[2]);
+  (void)AddTensor(&changed, changed.nodes_list_[kWorkspaceNode], kAlignSize, true);
+  changed.ComputeConflictMatrix();
+  ASSERT_TRUE(IsConflict(changed, 0, 2));
+  changed.Solve(*changed_graph);
+  ASSERT_TRUE(changed.plan_reused_);
+  CheckNoOverlap(changed);
+  size_t same_offset_num = 0;
+  for (size_t i = 0; i < kChainNodeNum; ++i) {
+    same_offset_num += changed.tensors_list_[i]->GetOffset() == origin.tensors_list_[i]->GetOffset() ? 1 : 0;
+  }
+  ASSERT_GE(same_offset_num, kChainNodeNum - 1);
+}
+}  // namespace somas
+}  // namespace mindspore
@@ -13,7 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <cstring>
 #include <random>
+#include <thread>
 #include <unordered_set>
 
 #include "common/common_test.h"
@@ -308,5 +311,116 @@ TEST_F(TestMemDynamicAllocator, test_malloc_with_multi_stream) {
   EXPECT_EQ(mem_pool_.stream_pair_addresses_.size(), 2);
   EXPECT_EQ(mem_pool_.stream_pair_addresses_[std::make_pair(user_stream_id, memory_stream_id)].size(), 0);
 }
+
+/// Feature: test thread cache of mem dynamic allocator.
+/// Description: alloc and free small memory through the thread cache, and flush the thread caches back to the pool.
+/// Expectation: the memory is reused from the thread cache, and the statistics exclude the memory held by the cache.
+TEST_F(TestMemDynamicAllocator, test_thread_cache_statistics) {
+  constexpr size_t kSmallSize = 1024;
+  constexpr size_t kAllocNum = 100;
+  mem_pool_.SetEnableThreadCache(true);
+  auto common_mem_pool = mem_pool_.common_mem();
+  auto addr1 = mem_pool_.AllocTensorMem(kSmallSize - 1);
+  EXPECT_NE(addr1, nullptr);
+  EXPECT_EQ(mem_pool_.TotalUsedMemStatistics(), kSmallSize);
+  EXPECT_EQ(mem_pool_.UsedMemPeakStatistics(), kSmallSize);
+  EXPECT_EQ(mem_pool_.TotalUsedMemStatistics() + mem_pool_.TotalIdleMemStatistics(), mem_pool_.TotalMemStatistics());
+  mem_pool_.FreeTensorMem(addr1);
+  EXPECT_EQ(mem_pool_.TotalUsedMemStatistics(), expected_size_zero);
+  EXPECT_EQ(mem_pool_.TotalIdleMemStatistics(), mem_pool_.TotalMemStatistics());
+  // The last freed memory is reused from the thread cache.
+  auto addr2 = mem_pool_.AllocTensorMem(kSmallSize);
+  EXPECT_EQ(addr2, addr1);
+  EXPECT_EQ(mem_pool_.UsedMemPeakStatistics(), kSmallSize);
+
+  // The memory refilled into the thread cache is not counted in the peak.
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < kAllocNum; ++i) {
+    addrs.push_back(mem_pool_.AllocTensorMem(kSmallSize * 2));
+    EXPECT_NE(addrs.back(), nullptr);
+  }
+  EXPECT_EQ(mem_pool_.TotalUsedMemStatistics(), kSmallSize + kAllocNum * kSmallSize * 2);
+  EXPECT_EQ(mem_pool_.UsedMemPeakStatistics(), kSmallSize + kAllocNum * kSmallSize * 2);
+  EXPECT_EQ(mem_pool_.MaxMemAllocatedStatistics(), kSmallSize + kAllocNum * kSmallSize * 2);
+  for (auto addr : addrs) {
+    mem_pool_.FreeTensorMem(addr);
+  }
+  mem_pool_.FreeTensorMem(addr2);
+  EXPECT_EQ(mem_pool_.TotalUsedMemStatistics(), expected_size_zero);
+  EXPECT_EQ(mem_pool_.TotalIdleMemStatistics(), mem_pool_.TotalMemStatistics());
+
+  // All the memory is combined in the pool after flushing the thread caches.
+  mem_pool_.FlushThreadCaches();
+  EXPECT_EQ(common_mem_pool->mps_.total_used_mem_size_, expected_size_zero);
+  EXPECT_EQ(common_mem_pool->mem_bufs_[std::make_pair(kDefaultStreamId, DynamicMemBufStatus::kMemBufIdle)].size(),
+            expected_size_one);
+}
+
+/// Feature: test thread cache of mem dynamic allocator.
+/// Description: alloc and free small memory of random sizes in several threads, and free memory in other threads.
+/// Expectation: the memory in use never overlaps, and all the memory is back to the pool after flushing.
+TEST_F(TestMemDynamicAllocator, test_thread_cache_multi_thread) {
+  constexpr size_t kThreadNum = 4;
+  constexpr size_t kLoopNum = 2000;
+  mem_pool_.SetEnableThreadCache(true);
+  std::vector<std::vector<std::pair<DeviceMemPtr, size_t>>> live_addrs(kThreadNum);
+  std::vector<size_t> error_counts(kThreadNum, 0);
+  auto check_and_free = [this](const std::pair<DeviceMemPtr, size_t> &addr, unsigned char value) {
+    auto data = static_cast<unsigned char *>(addr.first);
+    bool ok = std::all_of(data, data + addr.second, [value](unsigned char c) { return c == value; });
+    mem_pool_.FreeTensorMem(addr.first);
+    return ok;
+  };
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreadNum; ++t) {
+    threads.emplace_back([&, t]() {
+      std::mt19937 gen(t);
+      std::uniform_int_distribution<size_t> size_dist(1, kThreadCacheMaxBufSize);
+      auto &addrs = live_addrs[t];
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        if (!addrs.empty() && gen() % 2 == 0) {
+          auto index = gen() % addrs.size();
+          error_counts[t] += check_and_free(addrs[index], static_cast<unsigned char>(t + 1)) ? 0 : 1;
+          addrs[index] = addrs.back();
+          addrs.pop_back();
+          continue;
+        }
+        auto size = size_dist(gen);
+        auto addr = mem_pool_.AllocTensorMem(size);
+        if (addr == nullptr) {
+          ++error_counts[t];
+          continue;
+        }
+        (void)memset(addr, static_cast<int>(t + 1), size);
+        addrs.emplace_back(addr, size);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  // Free the memory left by every thread in another thread.
+  threads.clear();
+  for (size_t t = 0; t < kThreadNum; ++t) {
+    threads.emplace_back([&, t]() {
+      auto owner = (t + 1) % kThreadNum;
+      for (const auto &addr : live_addrs[owner]) {
+        error_counts[t] += check_and_free(addr, static_cast<unsigned char>(owner + 1)) ? 0 : 1;
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (size_t t = 0; t < kThreadNum; ++t) {
+    EXPECT_EQ(error_counts[t], expected_size_zero);
+  }
+  EXPECT_EQ(mem_pool_.TotalUsedMemStatistics(), expected_size_zero);
+  mem_pool_.FlushThreadCaches();
+  auto common_mem_pool = mem_pool_.common_mem();
+  EXPECT_EQ(common_mem_pool->mps_.total_used_mem_size_, expected_size_zero);
+  EXPECT_EQ(common_mem_pool->mem_bufs_[std::make_pair(kDefaultStreamId, DynamicMemBufStatus::kMemBufIdle)].size(),
+            expected_size_one);
+}
 }  // namespace device
 }  // namespace mindspore
@@ -0,0 +1,227 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "actor/actor.h"
+#include "mindrt/include/async/async.h"
+#include "mindrt/include/mindrt.hpp"
+#include "thread/actor_threadpool.h"
+#include "thread/steal_queue.h"
+
+namespace mindspore {
+class TestActorThreadPool : public UT::Common {
+ public:
+  TestActorThreadPool() = default;
+  virtual ~TestActorThreadPool() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+namespace {
+constexpr size_t kActorThreadNum = 4;
+constexpr size_t kChainNum = 64;
+constexpr size_t kChainLength = 8;
+constexpr int kRoundNum = 200;
+
+// Every hop forwards the token to the next actor of the chain, the last actor of the chain counts the arrivals.
+class HopActor : public ActorBase {
+ public:
+  HopActor(const std::string &name, ActorThreadPool *pool, std::atomic<int64_t> *arrived)
+      : ActorBase(name, pool), arrived_(arrived) {}
+  ~HopActor() override = default;
+
+  void set_next(const AID &next) { next_ = next; }
+  void Hop(int round) {
+    if (next_.Name().empty()) {
+      (void)arrived_->fetch_add(1);
+      return;
+    }
+    Async(next_, &HopActor::Hop, round);
+  }
+
+ private:
+  AID next_;
+  std::atomic<int64_t> *arrived_;
+};
+
+struct DispatchResult {
+  double latency_us{0};
+  double throughput{0};
+};
+
+DispatchResult RunChains(ActorScheduleMode schedule_mode, const std::string &prefix) {
+  DispatchResult result;
+  auto pool = ActorThreadPool::CreateThreadPool(kActorThreadNum, schedule_mode);
+  if (pool == nullptr) {
+    return result;
+  }
+  std::atomic<int64_t> arrived{0};
+  std::vector<std::shared_ptr<HopActor>> actors;
+  std::vector<AID> heads;
+  for (size_t chain = 0; chain < kChainNum; ++chain) {
+    AID next;
+    for (size_t i = 0; i < kChainLength; ++i) {
+      auto name = prefix + "_" + std::to_string(chain) + "_" + std::to_string(kChainLength - i);
+      auto actor = std::make_shared<HopActor>(name, pool, &arrived);
+      actor->set_next(next);
+      next = ActorMgr::GetActorMgrRef()->Spawn(actor);
+      actors.push_back(actor);
+    }
+    heads.push_back(next);
+  }
+
+  // latency: a single token walks through one chain at a time
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRoundNum; ++round) {
+    int64_t expect = arrived.load() + 1;
+    Async(heads[0], &HopActor::Hop, round);
+    while (arrived.load() < expect) {
+      std::this_thread::yield();
+    }
+  }
+  auto cost = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  result.latency_us = cost / (kRoundNum * kChainLength);
+
+  // throughput: all the chains run concurrently
+  int64_t expect = arrived.load() + static_cast<int64_t>(kRoundNum * kChainNum);
+  start = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRoundNum; ++round) {
+    for (const auto &head : heads) {
+      Async(head, &HopActor::Hop, round);
+    }
+  }
+  while (arrived.load() < expect) {
+    std::this_thread::yield();
+  }
+  cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  result.throughput = static_cast<double>(kRoundNum * kChainNum * kChainLength) / cost;
+
+  for (const auto &actor : actors) {
+    Terminate(actor->GetAID());
+  }
+  for (const auto &actor : actors) {
+    Await(actor->GetAID());
+  }
+  delete pool;
+  return result;
+}
+}  // namespace
+
+/// Feature: work stealing deque of actor thread pool.
+/// Description: the owner pushes and pops while the thieves steal concurrently.
+/// Expectation: every element is taken exactly once.
+TEST_F(TestActorThreadPool, test_steal_queue) {
+  StealQueue<int> queue;
+  EXPECT_TRUE(queue.Init(100));
+  EXPECT_FALSE(queue.Init(100));
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.Pop(), nullptr);
+  EXPECT_EQ(queue.Steal(), nullptr);
+
+  // the capacity is rounded up to 128
+  std::vector<int> values(128);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int>(i);
+    EXPECT_TRUE(queue.Push(&values[i]));
+  }
+  int extra = 0;
+  EXPECT_FALSE(queue.Push(&extra));
+  // lifo for the owner and fifo for the thieves
+  EXPECT_EQ(queue.Pop(), &values.back());
+  EXPECT_EQ(queue.Steal(), &values.front());
+
+  constexpr size_t kNum = 100000;
+  std::vector<int> items(kNum);
+  std::vector<std::atomic<int>> taken(kNum);
+  std::atomic<size_t> total{0};
+  std::atomic_bool done{false};
+  while (queue.Pop() != nullptr) {
+  }
+  auto thief = [&]() {
+    while (!done) {
+      auto item = queue.Steal();
+      if (item != nullptr) {
+        (void)taken[static_cast<size_t>(*item)].fetch_add(1);
+        (void)total.fetch_add(1);
+      }
+    }
+  };
+  std::thread thief1(thief);
+  std::thread thief2(thief);
+  auto take = [&](int *item) {
+    if (item != nullptr) {
+      (void)taken[static_cast<size_t>(*item)].fetch_add(1);
+      (void)total.fetch_add(1);
+    }
+  };
+  for (size_t i = 0; i < kNum; ++i) {
+    items[i] = static_cast<int>(i);
+    while (!queue.Push(&items[i])) {
+      take(queue.Pop());
+    }
+    if (i % 2 == 0) {
+      take(queue.Pop());
+    }
+  }
+  while (total.load() < kNum) {
+    take(queue.Pop());
+  }
+  done = true;
+  thief1.join();
+  thief2.join();
+  for (size_t i = 0; i < kNum; ++i) {
+    EXPECT_EQ(taken[i].load(), 1);
+  }
+}
+
+/// Feature: work stealing schedule mode of actor thread pool.
+/// Description: run the same actor chains with the global queue and the work stealing deques.
+/// Expectation: all the messages arrive in both modes, the dispatch latency and throughput are reported.
+TEST_F(TestActorThreadPool, test_work_stealing_dispatch) {
+  auto global = RunChains(kGlobalQueueSchedule, "global");
+  auto stealing = RunChains(kWorkStealingSchedule, "stealing");
+  EXPECT_GT(global.throughput, 0);
+  EXPECT_GT(stealing.throughput, 0);
+  MS_LOG(INFO) << "Global queue dispatch latency: " << global.latency_us
+               << " us/hop, throughput: " << global.throughput << " hops/s";
+  MS_LOG(INFO) << "Work stealing dispatch latency: " << stealing.latency_us
+               << " us/hop, throughput: " << stealing.throughput << " hops/s";
+}
+
+/// Feature: work stealing schedule mode of actor thread pool.
+/// Description: create and destroy the pool repeatedly while its idle actor threads keep stealing from each other,
+/// with and without the kernel threads.
+/// Expectation: the pool is created and destroyed without touching a deleted worker.
+TEST_F(TestActorThreadPool, test_work_stealing_create_and_destroy) {
+  constexpr int kLoopNum = 50;
+  for (int i = 0; i < kLoopNum; ++i) {
+    auto pool = ActorThreadPool::CreateThreadPool(kActorThreadNum, kWorkStealingSchedule);
+    ASSERT_NE(pool, nullptr);
+    delete pool;
+    pool = ActorThreadPool::CreateThreadPool(kActorThreadNum, kActorThreadNum * 2, Power_NoBind, kWorkStealingSchedule);
+    ASSERT_NE(pool, nullptr);
+    delete pool;
+  }
+}
+}  // namespace mindspore
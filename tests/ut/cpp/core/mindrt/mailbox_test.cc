@@ -0,0 +1,209 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "actor/actor.h"
+#include "actor/mailbox.h"
+#include "actor/msg_pool.h"
+#include "mindrt/include/async/async.h"
+#include "mindrt/include/mindrt.hpp"
+
+namespace mindspore {
+class TestMailBox : public UT::Common {
+ public:
+  TestMailBox() = default;
+  virtual ~TestMailBox() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+namespace {
+class CountActor : public ActorBase {
+ public:
+  explicit CountActor(const std::string &name) : ActorBase(name) {}
+  ~CountActor() override = default;
+
+  void Count(int producer, int index) {
+    // the msgs from the same producer keep the order
+    if (index == last_index_[producer] + 1) {
+      last_index_[producer] = index;
+    } else {
+      disorder_ = true;
+    }
+    (void)count_.fetch_add(1);
+  }
+
+  int count() const { return count_.load(); }
+  bool disorder() const { return disorder_; }
+
+ private:
+  std::atomic_int count_{0};
+  int last_index_[4]{-1, -1, -1, -1};
+  bool disorder_{false};
+};
+}  // namespace
+
+/// Feature: lock-free mpsc mailbox.
+/// Description: enqueue msgs from several producers and drain them as chains.
+/// Expectation: the notify hook is called once per wake-up and the msgs of each producer keep the order.
+TEST_F(TestMailBox, test_mpsc_mailbox) {
+  MpscMailBox mailbox;
+  EXPECT_TRUE(mailbox.TakeMsgChainEachTime());
+  std::atomic_int notify_num{0};
+  mailbox.SetNotifyHook(std::make_unique<std::function<void()>>([&notify_num]() { (void)notify_num.fetch_add(1); }));
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(mailbox.EnqueueMessage(std::make_unique<MessageBase>(std::to_string(i))), 0);
+  }
+  // only the first msg wakes up the consumer
+  EXPECT_EQ(notify_num.load(), 1);
+  auto msgs = mailbox.GetMsgChain();
+  int index = 0;
+  while (msgs != nullptr) {
+    std::unique_ptr<MessageBase> msg(msgs);
+    msgs = msgs->next_;
+    EXPECT_EQ(msg->Name(), std::to_string(index++));
+  }
+  EXPECT_EQ(index, 3);
+  EXPECT_EQ(mailbox.GetMsgChain(), nullptr);
+
+  // the consumer is released, the next msg wakes it up again
+  EXPECT_EQ(mailbox.EnqueueMessage(std::make_unique<MessageBase>("next")), 0);
+  EXPECT_EQ(notify_num.load(), 2);
+}
+
+/// Feature: message pool.
+/// Description: free a pooled msg and allocate another one with the same size on the same thread.
+/// Expectation: the memory is reused.
+TEST_F(TestMailBox, test_message_pool) {
+  auto first = new PooledMessage("first");
+  void *addr = static_cast<void *>(first);
+  delete first;
+  auto second = new PooledMessage("second");
+  EXPECT_EQ(static_cast<void *>(second), addr);
+  delete second;
+
+  constexpr size_t kLargeSize = 4096;
+  void *large = MessagePool::Allocate(kLargeSize);
+  EXPECT_NE(large, nullptr);
+  MessagePool::Free(large, kLargeSize);
+}
+
+/// Feature: message pool.
+/// Description: a producer thread allocates pooled msgs and a consumer thread frees them, as an actor sending OpData
+/// to an actor on another thread does.
+/// Expectation: once the producer has warmed up its cache, it allocates no msg from the heap.
+TEST_F(TestMailBox, test_message_pool_cross_thread) {
+  constexpr size_t kRingSize = 1024;
+  constexpr size_t kWarmUpNum = kRingSize * 2;
+  constexpr size_t kMsgNum = 200000;
+  std::vector<std::atomic<PooledMessage *>> ring(kRingSize);
+  for (auto &slot : ring) {
+    slot.store(nullptr);
+  }
+  std::atomic_bool warmed_up{false};
+  std::atomic<size_t> wrong_msg_num{0};
+  size_t warm_up_heap_num = 0;
+  size_t heap_num = 0;
+
+  std::thread producer([&]() {
+    // more blocks than the msgs which can be in flight at the same time
+    std::vector<PooledMessage *> warm_up_msgs(kWarmUpNum);
+    auto begin_heap_num = MessagePool::HeapAllocatedNum();
+    for (auto &msg : warm_up_msgs) {
+      msg = new PooledMessage("warm_up");
+    }
+    for (auto msg : warm_up_msgs) {
+      delete msg;
+    }
+    warm_up_heap_num = MessagePool::HeapAllocatedNum() - begin_heap_num;
+    warmed_up = true;
+    begin_heap_num = MessagePool::HeapAllocatedNum();
+    for (size_t i = 0; i < kMsgNum; ++i) {
+      auto msg = new PooledMessage("op_data");
+      auto &slot = ring[i % kRingSize];
+      PooledMessage *expected = nullptr;
+      while (!slot.compare_exchange_weak(expected, msg)) {
+        expected = nullptr;
+        std::this_thread::yield();
+      }
+    }
+    heap_num = MessagePool::HeapAllocatedNum() - begin_heap_num;
+  });
+  std::thread consumer([&]() {
+    while (!warmed_up) {
+      std::this_thread::yield();
+    }
+    for (size_t i = 0; i < kMsgNum; ++i) {
+      auto &slot = ring[i % kRingSize];
+      PooledMessage *msg = nullptr;
+      while ((msg = slot.exchange(nullptr)) == nullptr) {
+        std::this_thread::yield();
+      }
+      if (msg->Name() != "op_data") {
+        (void)wrong_msg_num.fetch_add(1);
+      }
+      delete msg;
+    }
+  });
+  producer.join();
+  consumer.join();
+  EXPECT_EQ(wrong_msg_num.load(), 0);
+  EXPECT_GT(warm_up_heap_num, 0);
+  EXPECT_EQ(heap_num, 0);
+}
+
+/// Feature: actors with mpsc mailbox.
+/// Description: several threads send msgs to one actor spawned with the mpsc mailbox.
+/// Expectation: all msgs are handled and the msgs of each sender keep the order.
+TEST_F(TestMailBox, test_actor_with_mpsc_mailbox) {
+  constexpr int kProducerNum = 4;
+  constexpr int kMsgNum = 10000;
+  auto pool = ActorThreadPool::CreateThreadPool(2);
+  ASSERT_NE(pool, nullptr);
+  ActorMgr::set_enable_mpsc_mailbox(true);
+  auto actor = std::make_shared<CountActor>("mpsc_count_actor");
+  actor->set_thread_pool(pool);
+  auto aid = ActorMgr::GetActorMgrRef()->Spawn(actor);
+  ActorMgr::set_enable_mpsc_mailbox(false);
+
+  std::vector<std::thread> producers;
+  for (int producer = 0; producer < kProducerNum; ++producer) {
+    producers.emplace_back([aid, producer]() {
+      for (int i = 0; i < kMsgNum; ++i) {
+        Async(aid, &CountActor::Count, producer, i);
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  while (actor->count() < kProducerNum * kMsgNum) {
+    std::this_thread::yield();
+  }
+  EXPECT_FALSE(actor->disorder());
+  Terminate(aid);
+  Await(aid);
+  delete pool;
+}
+}  // namespace mindspore
@@ -0,0 +1,150 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/engine/datasetops/batch_op.h"
+#include "minddata/dataset/engine/datasetops/batch_slot_pool.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestBatchSlotPool : public UT::Common {
+ protected:
+  // a float tensor of the shape filled with the value
+  static std::shared_ptr<Tensor> Filled(const TensorShape &shape, float value) {
+    std::shared_ptr<Tensor> tensor;
+    EXPECT_OK(Tensor::CreateEmpty(shape, DataType(DataType::DE_FLOAT32), &tensor));
+    EXPECT_OK(tensor->Fill<float>(value));
+    return tensor;
+  }
+
+  // batch the first column of the rows as BatchOp does
+  static std::shared_ptr<Tensor> Batch(const std::vector<std::shared_ptr<Tensor>> &rows) {
+    auto table = std::make_unique<TensorQTable>();
+    for (const auto &tensor : rows) {
+      table->emplace_back(TensorRow(1, tensor));
+    }
+    std::shared_ptr<Tensor> batched;
+    EXPECT_OK(BatchOp::ConvertRowsToTensor(&table, &batched, static_cast<dsize_t>(rows.size()), 0, false));
+    return batched;
+  }
+
+  static void CheckBatch(const std::shared_ptr<Tensor> &batched, const std::vector<float> &values) {
+    ASSERT_EQ(batched->shape()[0], static_cast<dsize_t>(values.size()));
+    dsize_t row_size = batched->Size() / batched->shape()[0];
+    auto itr = batched->begin<float>();
+    for (size_t row = 0; row < values.size(); ++row) {
+      for (dsize_t i = 0; i < row_size; ++i, ++itr) {
+        ASSERT_EQ(*itr, values[row]);
+      }
+    }
+  }
+};
+
+/// Feature: Tensor slice view
+/// Description: Write through a view of a row of a tensor, then release the base tensor
+/// Expectation: The base sees the write, and the view keeps the memory of the base alive
+TEST_F(MindDataTestBatchSlotPool, TestSliceView) {
+  MS_LOG(INFO) << "Doing MindDataTestBatchSlotPool-TestSliceView.";
+  auto base = Filled(TensorShape({4, 2, 3}), 0);
+  std::shared_ptr<Tensor> view;
+  ASSERT_OK(Tensor::CreateSliceView(base, 2, &view));
+  EXPECT_EQ(view->shape(), TensorShape({2, 3}));
+  EXPECT_EQ(view->ViewBase(), base);
+  EXPECT_EQ(view->GetBuffer(), base->GetBuffer() + 2 * view->SizeInBytes());
+  ASSERT_OK(view->Fill<float>(1));
+  CheckBatch(base, {0, 0, 1, 0});
+
+  std::shared_ptr<Tensor> out_of_range;
+  EXPECT_ERROR(Tensor::CreateSliceView(base, 4, &out_of_range));
+
+  base.reset();
+  for (auto itr = view->begin<float>(); itr != view->end<float>(); ++itr) {
+    EXPECT_EQ(*itr, 1);
+  }
+}
+
+/// Feature: BatchSlotPool
+/// Description: Place the rows of a batch into the slots, written in place or copied, and batch them
+/// Expectation: The batch tensor of the slots is published without copying
+TEST_F(MindDataTestBatchSlotPool, TestPlaceAndPublish) {
+  MS_LOG(INFO) << "Doing MindDataTestBatchSlotPool-TestPlaceAndPublish.";
+  constexpr int32_t batch_size = 3;
+  const TensorShape shape({2, 2});
+  BatchSlotPool pool(batch_size);
+  std::vector<std::shared_ptr<Tensor>> rows;
+
+  // no row has been placed, nothing to predict the slot from.
+  std::shared_ptr<Tensor> slot;
+  ASSERT_OK(pool.GetSlot({0, 0}, 0, &slot));
+  EXPECT_EQ(slot, nullptr);
+  auto row = Filled(shape, 10);
+  ASSERT_OK(pool.Place({0, 0}, 0, &row));
+  ASSERT_NE(row->ViewBase(), nullptr);
+  rows.push_back(row);
+
+  // the op writes into the slot.
+  ASSERT_OK(pool.GetSlot({0, 1}, 0, &slot));
+  ASSERT_NE(slot, nullptr);
+  EXPECT_EQ(slot->ViewBase(), rows[0]->ViewBase());
+  ASSERT_OK(slot->Fill<float>(11));
+  row = slot;
+  ASSERT_OK(pool.Place({0, 1}, 0, &row));
+  EXPECT_EQ(row, slot);
+  rows.push_back(row);
+
+  row = Filled(shape, 12);
+  ASSERT_OK(pool.Place({0, 2}, 0, &row));
+  rows.push_back(row);
+
+  auto batched = Batch(rows);
+  EXPECT_EQ(batched, rows[0]->ViewBase());
+  CheckBatch(batched, {10, 11, 12});
+
+  // the next batch gets a new batch tensor.
+  row = Filled(shape, 13);
+  ASSERT_OK(pool.Place({0, 3}, 0, &row));
+  EXPECT_NE(row->ViewBase(), batched);
+}
+
+/// Feature: BatchSlotPool
+/// Description: Place rows of different shapes, and batch the slots out of order
+/// Expectation: The rows which do not fit are left as they are, and the batch is copied as before
+TEST_F(MindDataTestBatchSlotPool, TestFallback) {
+  MS_LOG(INFO) << "Doing MindDataTestBatchSlotPool-TestFallback.";
+  constexpr int32_t batch_size = 2;
+  BatchSlotPool pool(batch_size);
+  auto first = Filled(TensorShape({3}), 1);
+  ASSERT_OK(pool.Place({0, 0}, 0, &first));
+  auto second = Filled(TensorShape({4}), 2);
+  auto original = second;
+  ASSERT_OK(pool.Place({0, 1}, 0, &second));
+  EXPECT_EQ(second, original);
+  EXPECT_EQ(second->ViewBase(), nullptr);
+
+  std::vector<std::shared_ptr<Tensor>> rows;
+  for (int64_t seq = 2; seq < 4; ++seq) {
+    auto row = Filled(TensorShape({3}), static_cast<float>(seq));
+    ASSERT_OK(pool.Place({0, seq}, 0, &row));
+    rows.push_back(row);
+  }
+  std::swap(rows[0], rows[1]);
+  auto batched = Batch(rows);
+  EXPECT_NE(batched, rows[0]->ViewBase());
+  CheckBatch(batched, {3, 2});
+}
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <sys/stat.h>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/cache/cache_pool.h"
+#include "minddata/dataset/engine/cache/storage_container.h"
+#include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/slice.h"
+
+using namespace mindspore::dataset;
+
+namespace {
+// A row made of a repeated pattern, so zlib can shrink it.
+std::string MakeRow(size_t sz, char seed) {
+  std::string row(sz, '\0');
+  for (size_t i = 0; i < sz; ++i) {
+    row[i] = static_cast<char>(seed + static_cast<char>(i % 16));
+  }
+  return row;
+}
+
+off64_t FileSize(const std::string &path) {
+  struct stat st {};
+  if (stat(path.c_str(), &st) != 0) {
+    return -1;
+  }
+  return st.st_size;
+}
+}  // namespace
+
+class MindDataTestCacheStorage : public UT::Common {
+ public:
+  void SetUp() override {
+    char dir_template[] = "/tmp/cache_storage_ut_XXXXXX";
+    ASSERT_NE(mkdtemp(dir_template), nullptr);
+    root_ = dir_template;
+  }
+
+  void TearDown() override {
+    if (!root_.empty()) {
+      (void)Path(root_ + "/container").Remove();
+      (void)Path(root_).Remove();
+    }
+  }
+
+ protected:
+  std::string root_;
+};
+
+/// Feature: Cache compression
+/// Description: Compress a row given as several slices and decompress it
+/// Expectation: The row shrinks and is restored byte for byte
+TEST_F(MindDataTestCacheStorage, TestCompressRoundTrip) {
+  std::string head = MakeRow(1000, 'a');
+  std::string tail = MakeRow(3000, 'A');
+  std::vector<ReadableSlice> buf = {ReadableSlice(head.data(), head.size()), ReadableSlice(nullptr, 0),
+                                    ReadableSlice(tail.data(), tail.size())};
+  size_t sz = head.size() + tail.size();
+  std::string compressed;
+  ASSERT_OK(CachePool::Compress(buf, sz, &compressed));
+  ASSERT_FALSE(compressed.empty());
+  ASSERT_LT(compressed.size(), sz);
+
+  std::string out(sz, '\0');
+  WritableSlice dest(out.data(), out.size());
+  ASSERT_OK(CachePool::Decompress(compressed.data(), compressed.size(), &dest, sz));
+  ASSERT_EQ(out, head + tail);
+}
+
+/// Feature: Cache compression
+/// Description: Decompress a corrupted block, and decompress into a buffer smaller than the row
+/// Expectation: Both fail with an error instead of writing a partial row
+TEST_F(MindDataTestCacheStorage, TestDecompressError) {
+  std::string row = MakeRow(4096, '0');
+  std::vector<ReadableSlice> buf = {ReadableSlice(row.data(), row.size())};
+  std::string compressed;
+  ASSERT_OK(CachePool::Compress(buf, row.size(), &compressed));
+  ASSERT_FALSE(compressed.empty());
+
+  std::string out(row.size(), '\0');
+  WritableSlice dest(out.data(), out.size());
+  std::string corrupted = compressed;
+  corrupted[corrupted.size() / 2] = static_cast<char>(~corrupted[corrupted.size() / 2]);
+  EXPECT_ERROR(CachePool::Decompress(corrupted.data(), corrupted.size(), &dest, row.size()));
+
+  std::string small(row.size() - 1, '\0');
+  WritableSlice small_dest(small.data(), small.size());
+  EXPECT_ERROR(CachePool::Decompress(compressed.data(), compressed.size(), &small_dest, row.size()));
+}
+
+/// Feature: Cache spill
+/// Description: Append rows to a container until the write buffer is flushed, then read all of them back
+/// Expectation: The rows are appended back to back, and read back the same from the write buffer and from the file
+TEST_F(MindDataTestCacheStorage, TestContainerAppendAndRead) {
+  std::string path = root_ + "/container";
+  std::shared_ptr<StorageContainer> sc;
+  ASSERT_OK(StorageContainer::CreateStorageContainer(&sc, path));
+
+  constexpr size_t kRowSize = 100 * 1024;
+  constexpr size_t kRowNum = StorageContainer::kWriteBufferSize / kRowSize + 2;
+  std::vector<std::string> rows;
+  std::vector<off64_t> offsets;
+  for (size_t i = 0; i < kRowNum; ++i) {
+    rows.push_back(MakeRow(kRowSize, static_cast<char>('a' + i)));
+    // Give the row as two slices, they are stored as one.
+    std::vector<ReadableSlice> buf = {ReadableSlice(rows[i].data(), kRowSize / 2),
+                                      ReadableSlice(rows[i].data() + kRowSize / 2, kRowSize - kRowSize / 2)};
+    off64_t offset = -1;
+    ASSERT_OK(sc->Insert(buf, &offset));
+    ASSERT_EQ(offset, static_cast<off64_t>(i * kRowSize));
+    offsets.push_back(offset);
+    if (i == 0) {
+      // The first row is still in the write buffer.
+      ASSERT_EQ(FileSize(path), 0);
+    }
+  }
+  // The full buffer went to the file in one write, the last rows are still in memory.
+  off64_t file_sz = FileSize(path);
+  ASSERT_GE(file_sz, static_cast<off64_t>(StorageContainer::kWriteBufferSize));
+  ASSERT_LT(file_sz, static_cast<off64_t>(kRowNum * kRowSize));
+
+  for (size_t i = 0; i < kRowNum; ++i) {
+    ASSERT_OK(sc->Prefetch(offsets[i], kRowSize));
+    std::string out(kRowSize, '\0');
+    WritableSlice dest(out.data(), out.size());
+    ASSERT_OK(sc->Read(&dest, offsets[i]));
+    ASSERT_EQ(out, rows[i]);
+  }
+
+  // Reading past the last row fails.
+  std::string out(kRowSize, '\0');
+  WritableSlice dest(out.data(), out.size());
+  EXPECT_ERROR(sc->Read(&dest, static_cast<off64_t>(kRowNum * kRowSize - kRowSize / 2)));
+
+  // An empty row is rejected.
+  std::vector<ReadableSlice> empty = {ReadableSlice(nullptr, 0)};
+  off64_t offset = -1;
+  EXPECT_ERROR(sc->Insert(empty, &offset));
+}
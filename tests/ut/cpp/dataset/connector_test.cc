@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <fcntl.h>
 #include <iostream>
 #include <memory>
@@ -47,10 +48,13 @@ public:
 
   void SetSleepMilliSec(uint32_t ms) { sleep_ms_ = ms; }
 
+  void SetFirstReady(bool first_ready) { first_ready_ = first_ready; }
+
 private:
   std::unique_ptr<TaskGroup> tg_;
   uint32_t last_input_;
   uint32_t sleep_ms_ = 0;
+  bool first_ready_ = false;
   std::vector<uint32_t> input_;
   WaitPost wp;
 
@@ -123,6 +127,20 @@ TEST_F(MindDataTestConnector, Test2) {
   ASSERT_TRUE(rc.IsOk());
 }
 
+/// Feature: Connector
+/// Description: Test Connector in first ready mode with multiple producers and multiple consumers with random delay
+///     after push/pop, a chain of three layers of thread groups connected by two Connectors between two layers.
+/// Expectation: Runs successfully, all the elements are collected exactly once
+TEST_F(MindDataTestConnector, Test3) {
+  MS_LOG(INFO) << "MindDataTestConnector Test3: first ready mode.";
+  this->SetSleepMilliSec(30);
+  this->SetFirstReady(true);
+  Status rc = this->Run_test_1();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
+
 
 
 // Implementation of MindDataTestConnector class and the helper functions.
@@ -189,11 +207,13 @@ Status MindDataTestConnector::Run_test_1() {
 
   auto conn1 = std::make_shared<Connector<uint32_t>>(l1_threads,  // num of producers
                                                      l2_threads,  // num of consumers
-                                                     conn1_qcap);  // the cap of each queue
+                                                     conn1_qcap,  // the cap of each queue
+                                                     first_ready_);  // whether to pop the first ready queue
 
   auto conn2 = std::make_shared<Connector<uint32_t>>(l2_threads,
                                                      l3_threads,
-                                                     conn2_qcap);
+                                                     conn2_qcap,
+                                                     first_ready_);
 
   rc = conn1->Register(tg_.get());
   RETURN_IF_NOT_OK(rc);
@@ -263,7 +283,8 @@ Status MindDataTestConnector::SerialWorkerPull(
 
     // Signal master thread after it processed the last_input_.
     // This will trigger the MidWorkerJob threads to quit their worker loop.
-    if (res == last_input_) {
+    // In first ready mode the elements are not in order, so wait until all of them are collected.
+    if (first_ready_ ? output->size() == last_input_ : res == last_input_) {
       MS_LOG(INFO) << "All data is collected.";
       wp.Set();
       break;
@@ -314,6 +335,15 @@ Status MindDataTestConnector::MidWorkerJob(
 }
 
 Status MindDataTestConnector::ValidateOutput(const std::vector<uint32_t> &output) {
+  if (first_ready_) {
+    // The order is not preserved in first ready mode, but each element should be collected exactly once.
+    std::vector<uint32_t> sorted_output(output);
+    std::sort(sorted_output.begin(), sorted_output.end());
+    if (sorted_output != input_) {
+      return Status(StatusCode::kMDUnexpectedError, "Output vector is not a permutation of the input.");
+    }
+    return Status::OK();
+  }
   int prev = 0;
   for (auto el : output) {
     if (prev >= el) {
@@ -0,0 +1,179 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/kernels/data/data_utils.h"
+#include "minddata/dataset/kernels/image/fused_image_transform_op.h"
+#include "minddata/dataset/kernels/image/horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/random_vertical_flip_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "minddata/dataset/kernels/image/vertical_flip_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestFusedImageTransformOp : public UT::CVOP::CVOpCommon {
+ protected:
+  MindDataTestFusedImageTransformOp() : CVOpCommon() {}
+
+  // run the ops one by one
+  static std::shared_ptr<Tensor> RunInSequence(const std::vector<std::shared_ptr<TensorOp>> &ops,
+                                               const std::shared_ptr<Tensor> &input) {
+    TensorRow row = {input};
+    for (const auto &op : ops) {
+      TensorRow out;
+      EXPECT_OK(op->Compute(row, &out));
+      row = out;
+    }
+    return row[0];
+  }
+
+  template <typename T>
+  static void CheckEqual(const std::shared_ptr<Tensor> &expect, const std::shared_ptr<Tensor> &actual,
+                         float tolerance = 0) {
+    ASSERT_EQ(expect->shape(), actual->shape());
+    ASSERT_EQ(expect->type(), actual->type());
+    auto expect_itr = expect->begin<T>();
+    auto actual_itr = actual->begin<T>();
+    for (; expect_itr != expect->end<T>(); ++expect_itr, ++actual_itr) {
+      ASSERT_LE(std::fabs(static_cast<float>(*expect_itr) - static_cast<float>(*actual_itr)), tolerance);
+    }
+  }
+
+  ImageTransformStep Step(ImageTransformStep::Type type, float prob = 1.0) {
+    ImageTransformStep step;
+    step.type = type;
+    step.prob = prob;
+    return step;
+  }
+
+  std::vector<float> mean_ = {0.485, 0.456, 0.406};
+  std::vector<float> std_ = {0.229, 0.224, 0.225};
+};
+
+/// Feature: FusedImageTransform op
+/// Description: Test flips, Rescale, Normalize and HWC2CHW fused into one pass
+/// Expectation: Output is equal to the output of the ops run one by one
+TEST_F(MindDataTestFusedImageTransformOp, TestNormalizeChain) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageTransformOp-TestNormalizeChain.";
+  ImageTransformStep rescale = Step(ImageTransformStep::Type::kRescale);
+  rescale.param0 = {1.0 / 255};
+  rescale.param1 = {0};
+  ImageTransformStep normalize = Step(ImageTransformStep::Type::kNormalize);
+  normalize.param0 = mean_;
+  normalize.param1 = std_;
+  std::vector<ImageTransformStep> steps = {Step(ImageTransformStep::Type::kHorizontalFlip),
+                                           Step(ImageTransformStep::Type::kVerticalFlip), rescale, normalize,
+                                           Step(ImageTransformStep::Type::kHwcToChw)};
+  auto op = std::make_shared<FusedImageTransformOp>(steps);
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(op->Compute(input_tensor_, &output));
+
+  std::vector<std::shared_ptr<TensorOp>> ops = {
+    std::make_shared<HorizontalFlipOp>(), std::make_shared<VerticalFlipOp>(), std::make_shared<RescaleOp>(1.0 / 255, 0),
+    std::make_shared<NormalizeOp>(mean_, std_, true), std::make_shared<HwcToChwOp>()};
+  auto expect = RunInSequence(ops, input_tensor_);
+  // Rescale may be done with fma or not, the rest is exact.
+  CheckEqual<float>(expect, output, 1e-5);
+
+  std::vector<TensorShape> out_shapes;
+  ASSERT_OK(op->OutputShape({input_tensor_->shape()}, out_shapes));
+  EXPECT_EQ(out_shapes[0], output->shape());
+}
+
+/// Feature: FusedImageTransform op
+/// Description: Test flips and HWC2CHW only, which keep the type of the input
+/// Expectation: Output is the same as the output of the ops run one by one
+TEST_F(MindDataTestFusedImageTransformOp, TestLayoutOnly) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageTransformOp-TestLayoutOnly.";
+  std::vector<ImageTransformStep> steps = {Step(ImageTransformStep::Type::kVerticalFlip),
+                                           Step(ImageTransformStep::Type::kHwcToChw)};
+  auto op = std::make_shared<FusedImageTransformOp>(steps);
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(op->Compute(input_tensor_, &output));
+  auto expect = RunInSequence({std::make_shared<VerticalFlipOp>(), std::make_shared<HwcToChwOp>()}, input_tensor_);
+  CheckEqual<uint8_t>(expect, output);
+}
+
+/// Feature: FusedImageTransform op
+/// Description: Test the random flips with the same seed as the standalone ops
+/// Expectation: Output is the same as the output of the random ops run one by one
+TEST_F(MindDataTestFusedImageTransformOp, TestRandomFlip) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageTransformOp-TestRandomFlip.";
+  constexpr uint32_t seed = 5;
+  std::vector<ImageTransformStep> steps = {Step(ImageTransformStep::Type::kHorizontalFlip, 0.5),
+                                           Step(ImageTransformStep::Type::kVerticalFlip, 0.5)};
+  std::shared_ptr<TensorOp> op = std::make_shared<FusedImageTransformOp>(steps);
+  EXPECT_FALSE(op->Deterministic());
+  op->SetSeed(seed);
+  std::vector<std::shared_ptr<TensorOp>> ops = {std::make_shared<RandomHorizontalFlipOp>(0.5),
+                                                std::make_shared<RandomVerticalFlipOp>(0.5)};
+  for (auto &random_op : ops) {
+    random_op->SetSeed(seed);
+  }
+  constexpr int num_runs = 10;
+  for (int i = 0; i < num_runs; i++) {
+    std::shared_ptr<Tensor> output;
+    ASSERT_OK(op->Compute(input_tensor_, &output));
+    CheckEqual<uint8_t>(RunInSequence(ops, input_tensor_), output);
+  }
+}
+
+/// Feature: FusedImageTransform op
+/// Description: Test a 4 dimension tensor, which is not fused but run by the ops one by one
+/// Expectation: Output is the same as the output of the ops run one by one
+TEST_F(MindDataTestFusedImageTransformOp, TestOp4Dim) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageTransformOp-TestOp4Dim.";
+  std::vector<std::shared_ptr<Tensor>> tensor_list = {input_tensor_, input_tensor_};
+  std::shared_ptr<Tensor> input_4d;
+  ASSERT_OK(TensorVectorToBatchTensor(tensor_list, &input_4d));
+  ImageTransformStep normalize = Step(ImageTransformStep::Type::kNormalize);
+  normalize.param0 = {121.0, 115.0, 100.0};
+  normalize.param1 = {70.0, 68.0, 71.0};
+  auto op = std::make_shared<FusedImageTransformOp>(
+    std::vector<ImageTransformStep>{Step(ImageTransformStep::Type::kHorizontalFlip), normalize});
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(op->Compute(input_4d, &output));
+  auto expect = RunInSequence(
+    {std::make_shared<HorizontalFlipOp>(), std::make_shared<NormalizeOp>(normalize.param0, normalize.param1, true)},
+    input_4d);
+  CheckEqual<float>(expect, output);
+}
+
+/// Feature: FusedImageTransform op
+/// Description: Test the output preset with a tensor of the output shape and type, as MapOp does with batch slots
+/// Expectation: The result is written into the preset tensor
+TEST_F(MindDataTestFusedImageTransformOp, TestPresetOutput) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageTransformOp-TestPresetOutput.";
+  std::vector<ImageTransformStep> steps = {Step(ImageTransformStep::Type::kHorizontalFlip),
+                                           Step(ImageTransformStep::Type::kHwcToChw)};
+  auto op = std::make_shared<FusedImageTransformOp>(steps);
+  EXPECT_TRUE(op->WritesToPresetOutput());
+  std::vector<TensorShape> out_shapes;
+  ASSERT_OK(op->OutputShape({input_tensor_->shape()}, out_shapes));
+  std::shared_ptr<Tensor> preset;
+  ASSERT_OK(Tensor::CreateEmpty(out_shapes[0], input_tensor_->type(), &preset));
+  TensorRow output(1, preset);
+  ASSERT_OK(op->Compute(TensorRow(1, input_tensor_), &output));
+  EXPECT_EQ(output[0], preset);
+  auto expect = RunInSequence({std::make_shared<HorizontalFlipOp>(), std::make_shared<HwcToChwOp>()}, input_tensor_);
+  CheckEqual<uint8_t>(expect, output[0]);
+}
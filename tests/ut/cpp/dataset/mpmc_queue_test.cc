@@ -0,0 +1,154 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/util/mpmc_queue.h"
+#include "minddata/dataset/util/queue.h"
+#include "minddata/dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestMPMCQueue : public UT::Common {
+ public:
+  MindDataTestMPMCQueue() {}
+
+  void SetUp() {}
+};
+
+namespace {
+// Push `num_rows` integers through the queue with `num_producers` producers and `num_consumers` consumers, check that
+// every integer is popped exactly once and return the number of rows per second.
+template <typename Q>
+double RunProducersConsumers(int32_t num_producers, int32_t num_consumers, int32_t num_rows, int32_t capacity) {
+  TaskGroup vg;
+  Q que(capacity);
+  EXPECT_TRUE(que.Register(&vg).IsOk());
+  std::vector<std::atomic<int32_t>> popped(num_rows);
+  for (auto &cnt : popped) {
+    cnt = 0;
+  }
+  std::atomic<int32_t> num_popped(0);
+  auto start = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < num_producers; ++i) {
+    EXPECT_TRUE(vg.CreateAsyncTask("Producer", [&que, i, num_producers, num_rows]() -> Status {
+                    TaskManager::FindMe()->Post();
+                    for (int32_t v = i; v < num_rows; v += num_producers) {
+                      RETURN_IF_NOT_OK(que.Add(v));
+                    }
+                    return Status::OK();
+                  })
+                  .IsOk());
+  }
+  for (int32_t i = 0; i < num_consumers; ++i) {
+    EXPECT_TRUE(vg.CreateAsyncTask("Consumer", [&que, &popped, &num_popped, i, num_consumers, num_rows]() -> Status {
+                    TaskManager::FindMe()->Post();
+                    // Each consumer pops the same number of rows, so no one is left waiting at the end.
+                    for (int32_t n = i; n < num_rows; n += num_consumers) {
+                      int32_t v = -1;
+                      RETURN_IF_NOT_OK(que.PopFront(&v));
+                      (void)popped[v].fetch_add(1);
+                      (void)num_popped.fetch_add(1);
+                    }
+                    return Status::OK();
+                  })
+                  .IsOk());
+  }
+  vg.join_all();
+  double cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  EXPECT_EQ(num_popped.load(), num_rows);
+  for (int32_t v = 0; v < num_rows; ++v) {
+    EXPECT_EQ(popped[v].load(), 1);
+  }
+  EXPECT_TRUE(que.empty());
+  return num_rows / cost;
+}
+}  // namespace
+
+/// Feature: MPMCQueue
+/// Description: Test MPMCQueue in a single thread, including moving unique pointers and wrapping around the ring
+/// Expectation: Elements are popped in FIFO order
+TEST_F(MindDataTestMPMCQueue, TestFIFO) {
+  MPMCQueue<std::unique_ptr<int>> que(3);
+  EXPECT_TRUE(que.empty());
+  EXPECT_EQ(que.capacity(), 3);
+  for (int round = 0; round < 4; ++round) {
+    for (int i = 0; i < 3; ++i) {
+      ASSERT_TRUE(que.Add(std::make_unique<int>(round * 3 + i)).IsOk());
+    }
+    EXPECT_EQ(que.size(), 3);
+    EXPECT_FALSE(que.empty());
+    for (int i = 0; i < 3; ++i) {
+      std::unique_ptr<int> v;
+      ASSERT_TRUE(que.PopFront(&v).IsOk());
+      ASSERT_NE(v, nullptr);
+      EXPECT_EQ(*v, round * 3 + i);
+    }
+    EXPECT_TRUE(que.empty());
+  }
+  ASSERT_TRUE(que.EmplaceBack(new int(100)).IsOk());
+  que.Reset();
+  EXPECT_TRUE(que.empty());
+  EXPECT_EQ(que.size(), 0);
+}
+
+/// Feature: MPMCQueue
+/// Description: Test MPMCQueue with multiple producers and consumers on a small queue, so both sides block
+/// Expectation: Every element is popped exactly once
+TEST_F(MindDataTestMPMCQueue, TestMultiThreads) {
+  (void)RunProducersConsumers<MPMCQueue<int32_t>>(4, 4, 20000, 2);
+  (void)RunProducersConsumers<MPMCQueue<int32_t>>(1, 8, 20000, 16);
+  (void)RunProducersConsumers<MPMCQueue<int32_t>>(8, 1, 20000, 16);
+}
+
+/// Feature: MPMCQueue
+/// Description: Test Interrupt on the MPMCQueue while a consumer is parked on the empty queue
+/// Expectation: The consumer returns kMDInterrupted
+TEST_F(MindDataTestMPMCQueue, TestInterrupt) {
+  TaskGroup vg;
+  MPMCQueue<int> que(3);
+  ASSERT_TRUE(que.Register(&vg).IsOk());
+  ASSERT_TRUE(vg.CreateAsyncTask("Consumer", [&que]() -> Status {
+                  TaskManager::FindMe()->Post();
+                  int v;
+                  Status rc = que.PopFront(&v);
+                  EXPECT_TRUE(rc == StatusCode::kMDInterrupted);
+                  return rc;
+                })
+                .IsOk());
+  vg.GetIntrpService()->InterruptAll();
+  vg.join_all(Task::WaitFlag::kNonBlocking);
+}
+
+/// Feature: MPMCQueue
+/// Description: Benchmark Queue and MPMCQueue with the number of producers and consumers of a parallel op
+/// Expectation: Every element is popped exactly once, the throughput is reported
+TEST_F(MindDataTestMPMCQueue, TestBenchmark) {
+  const int32_t num_rows = 200000;
+  const int32_t capacity = 16;
+  for (int32_t num_threads : {1, 4, 32}) {
+    double mutex_throughput = RunProducersConsumers<Queue<int32_t>>(num_threads, num_threads, num_rows, capacity);
+    double mpmc_throughput = RunProducersConsumers<MPMCQueue<int32_t>>(num_threads, num_threads, num_rows, capacity);
+    MS_LOG(INFO) << num_threads << " producers and consumers, Queue: " << mutex_throughput
+                 << " rows/s, MPMCQueue: " << mpmc_throughput << " rows/s.";
+  }
+}
@@ -29,6 +29,7 @@
 #include "minddata/dataset/include/dataset/vision_lite.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/fused_image_transform_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
 
@@ -120,3 +121,51 @@ TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassPreBuiltTensorO
   ASSERT_EQ(fused_ops.size(), 1);
   ASSERT_EQ(fused_ops[0]->Name(), kRandomCropDecodeResizeOp);
 }
+
+/// Feature: IR Optimization
+/// Description: Test TensorOpFusionPass by fusing the flips, Rescale, Normalize and HWC2CHW after Decode
+/// Expectation: The chain after Decode is fused into one FusedImageTransform
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassImageTransforms) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassImageTransforms.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto flip_op = vision::RandomHorizontalFlip(0.5);
+  auto rescale_op = vision::Rescale(1.0 / 255, 0);
+  auto normalize_op = vision::Normalize({0.485, 0.456, 0.406}, {0.229, 0.224, 0.225});
+  auto hwc2chw_op = vision::HWC2CHW();
+  std::shared_ptr<Dataset> root =
+    ImageFolder(folder_path, false)->Map({decode_op, flip_op, rescale_op, normalize_op, hwc2chw_op}, {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  // no deepcopy is performed because this doesn't go through tree_adapter
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, true);
+  ASSERT_NE(map_node, nullptr);
+  auto fused_ops = map_node->operations();
+  ASSERT_EQ(fused_ops.size(), 2);
+  ASSERT_EQ(fused_ops[0]->Name(), vision::kDecodeOperation);
+  ASSERT_EQ(fused_ops[1]->Name(), vision::kFusedImageTransformOperation);
+  EXPECT_TRUE(fused_ops[1]->IsRandomOp());
+}
+
+/// Feature: IR Optimization
+/// Description: Test TensorOpFusionPass with a flip after HWC2CHW, which can not be fused
+/// Expectation: The ops are not changed
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassFlipAfterHwcToChw) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassFlipAfterHwcToChw.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto hwc2chw_op = vision::HWC2CHW();
+  auto flip_op = vision::HorizontalFlip();
+  std::shared_ptr<Dataset> root = ImageFolder(folder_path, false)->Map({decode_op, hwc2chw_op, flip_op}, {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, false);
+  ASSERT_NE(map_node, nullptr);
+  ASSERT_EQ(map_node->operations().size(), 3);
+}
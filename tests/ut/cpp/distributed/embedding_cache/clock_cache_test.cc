@@ -0,0 +1,100 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include <list>
+
+#include "common/common_test.h"
+#include "distributed/embedding_cache/cache_strategy/clock_cache.h"
+
+namespace mindspore {
+namespace distributed {
+class TestClockCache : public UT::Common {
+ public:
+  TestClockCache() = default;
+  virtual ~TestClockCache() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+using Element = typename ClockCache<int, int>::Element;
+/// Feature: test clock cache all api.
+/// Description: test clock cache data structure and interface.
+/// Expectation: all interface work normally or throw expectant exception.
+TEST_F(TestClockCache, test_clock_cache) {
+  distributed::ClockCache<int, int> cache(5);
+  EXPECT_EQ(cache.capacity(), 5);
+  EXPECT_THROW(cache.Back(), std::runtime_error);
+
+  std::vector<int> keys = {1, 2, 3};
+  std::vector<int> values = {11, 22, 33};
+  EXPECT_NO_THROW(cache.Put(keys.data(), keys.size(), values.data()));
+  EXPECT_TRUE(cache.Exists(1));
+  EXPECT_TRUE(cache.Exists(2));
+  EXPECT_TRUE(cache.Exists(3));
+  EXPECT_FALSE(cache.Exists(4));
+  EXPECT_EQ(cache.size(), 3);
+  EXPECT_FALSE(cache.IsFull());
+  EXPECT_EQ((cache.Front()), (std::pair<int, int>(3, 33)));
+
+  // Batch get, the key 4 misses.
+  std::vector<int> query_keys = {2, 4, 3};
+  std::vector<int> query_values(query_keys.size());
+  bool hits[3];
+  EXPECT_EQ(cache.Get(query_keys.data(), query_keys.size(), query_values.data(), hits), 2);
+  EXPECT_TRUE(hits[0]);
+  EXPECT_FALSE(hits[1]);
+  EXPECT_TRUE(hits[2]);
+  EXPECT_EQ(query_values[0], 22);
+  EXPECT_EQ(query_values[2], 33);
+  EXPECT_EQ(cache.hit_count(), 2);
+  EXPECT_EQ(cache.miss_count(), 1);
+  EXPECT_EQ((cache.Front()), (std::pair<int, int>(3, 33)));
+
+  // The key 1 is the only element without reference bit, so it is evicted first.
+  EXPECT_EQ((cache.Back()), (std::pair<int, int>(1, 11)));
+  EXPECT_EQ((cache.Export().back()), (std::pair<int, int>(1, 11)));
+  std::vector<Element> evict_elements;
+  EXPECT_NO_THROW(cache.TryEvict(3, &evict_elements));
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(evict_elements.size(), 1);
+  EXPECT_EQ((evict_elements.front()), (std::pair<int, int>(1, 11)));
+  EXPECT_EQ(cache.evicted_count(), 1);
+
+  // The reference bits of key 2 and 3 are cleared by the hand, then the key 2 is evicted.
+  evict_elements.clear();
+  EXPECT_NO_THROW(cache.TryEvict(4, &evict_elements));
+  EXPECT_EQ(evict_elements.size(), 1);
+  EXPECT_EQ((evict_elements.front()), (std::pair<int, int>(2, 22)));
+
+  int value = 0;
+  EXPECT_FALSE(cache.Get(2, &value));
+  EXPECT_TRUE(cache.Get(3, &value));
+  EXPECT_EQ(value, 33);
+  EXPECT_NO_THROW(cache.Put(3, 333));
+  EXPECT_TRUE(cache.Get(3, &value));
+  EXPECT_EQ(value, 333);
+
+  for (int key = 10; key < 14; ++key) {
+    EXPECT_NO_THROW(cache.Put(key, key));
+  }
+  EXPECT_TRUE(cache.IsFull());
+  EXPECT_THROW(cache.Put(20, 20), std::runtime_error);
+  EXPECT_EQ(cache.Export().size(), 5);
+  EXPECT_THROW(cache.TryEvict(6, &evict_elements), std::runtime_error);
+}
+}  // namespace distributed
+}  // namespace mindspore
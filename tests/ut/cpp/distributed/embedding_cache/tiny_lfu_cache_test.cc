@@ -0,0 +1,155 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/common_test.h"
+#include "distributed/embedding_cache/cache_strategy/lru_cache.h"
+#include "distributed/embedding_cache/cache_strategy/clock_cache.h"
+#include "distributed/embedding_cache/cache_strategy/tiny_lfu_cache.h"
+
+namespace mindspore {
+namespace distributed {
+class TestTinyLFUCache : public UT::Common {
+ public:
+  TestTinyLFUCache() = default;
+  virtual ~TestTinyLFUCache() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+namespace {
+using Element = typename TinyLFUCache<int, int>::Element;
+
+// Access the keys batch by batch in the same way as the embedding storage: query the cache, evict for the miss keys and
+// insert the miss keys. Return the hit rate.
+double RunTrace(Cache<int, int> *cache, const std::vector<int> &trace, size_t batch_size) {
+  std::vector<int> values(batch_size);
+  std::unique_ptr<bool[]> hits = std::make_unique<bool[]>(batch_size);
+  std::vector<Element> evicted_elements;
+  for (size_t begin = 0; begin < trace.size(); begin += batch_size) {
+    size_t num = std::min(batch_size, trace.size() - begin);
+    (void)cache->Get(trace.data() + begin, num, values.data(), hits.get());
+    std::vector<int> miss_keys;
+    for (size_t i = 0; i < num; ++i) {
+      if (!hits[i] && !cache->Exists(trace[begin + i])) {
+        miss_keys.push_back(trace[begin + i]);
+      }
+    }
+    cache->TryEvict(miss_keys.size(), &evicted_elements);
+    for (auto key : miss_keys) {
+      if (!cache->Exists(key)) {
+        cache->Put(key, key);
+      }
+    }
+  }
+  return static_cast<double>(cache->hit_count()) / (cache->hit_count() + cache->miss_count());
+}
+}  // namespace
+
+/// Feature: test tiny lfu cache all api.
+/// Description: test tiny lfu cache data structure and interface.
+/// Expectation: all interface work normally or throw expectant exception.
+TEST_F(TestTinyLFUCache, test_tiny_lfu_cache) {
+  // The window holds 1 element and the main space holds 4 elements.
+  distributed::TinyLFUCache<int, int> cache(5);
+  EXPECT_EQ(cache.capacity(), 5);
+  EXPECT_THROW(cache.Front(), std::runtime_error);
+
+  std::vector<int> keys = {1, 2, 3, 4, 5};
+  std::vector<int> values = {11, 22, 33, 44, 55};
+  EXPECT_NO_THROW(cache.Put(keys.data(), keys.size(), values.data()));
+  EXPECT_EQ(cache.size(), 5);
+  EXPECT_TRUE(cache.IsFull());
+  EXPECT_THROW(cache.Put(6, 66), std::runtime_error);
+  EXPECT_EQ((cache.Front()), (std::pair<int, int>(5, 55)));
+  EXPECT_EQ(cache.Export().size(), 5);
+
+  // Make the keys 1, 2, 3 and 4 frequent.
+  int value = 0;
+  for (int round = 0; round < 3; ++round) {
+    for (int key = 1; key <= 4; ++key) {
+      EXPECT_TRUE(cache.Get(key, &value));
+      EXPECT_EQ(value, key * 11);
+    }
+  }
+
+  // The one-off keys can not replace the frequent keys in the main space, only the window element is evicted.
+  std::vector<Element> evict_elements;
+  for (int key = 100; key < 110; ++key) {
+    EXPECT_FALSE(cache.Get(key, &value));
+    EXPECT_NO_THROW(cache.TryEvict(1, &evict_elements));
+    EXPECT_NO_THROW(cache.Put(key, key));
+  }
+  EXPECT_EQ(evict_elements.size(), 10);
+  EXPECT_EQ(cache.evicted_count(), 10);
+  for (int key = 1; key <= 4; ++key) {
+    EXPECT_TRUE(cache.Exists(key));
+  }
+  EXPECT_TRUE(cache.Exists(109));
+
+  // A key accessed frequently while not in the cache is admitted into the main space.
+  for (int round = 0; round < 8; ++round) {
+    EXPECT_FALSE(cache.Get(200, &value));
+  }
+  EXPECT_NO_THROW(cache.TryEvict(1, &evict_elements));
+  EXPECT_NO_THROW(cache.Put(200, 200));
+  EXPECT_NO_THROW(cache.TryEvict(1, &evict_elements));
+  EXPECT_TRUE(cache.Exists(200));
+  EXPECT_EQ(cache.size(), 4);
+
+  EXPECT_THROW(cache.TryEvict(6, &evict_elements), std::runtime_error);
+  EXPECT_NO_THROW(cache.TryEvict(5, &evict_elements));
+  EXPECT_EQ(cache.size(), 0);
+}
+
+/// Feature: test the hit rate of cache strategies.
+/// Description: access skewed keys mixed with scans of one-off keys with the lru, clock and tiny lfu caches.
+/// Expectation: the tiny lfu cache keeps the hot keys during the scans and gets higher hit rate than the lru cache.
+TEST_F(TestTinyLFUCache, test_scan_resistance) {
+  constexpr size_t kCapacity = 1000;
+  constexpr size_t kHotKeyNum = 800;
+  constexpr size_t kBatchSize = 100;
+  constexpr int kRoundNum = 50;
+  constexpr size_t kScanLength = 2000;
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> hot_distribution(0, kHotKeyNum - 1);
+  std::vector<int> trace;
+  int scan_key = static_cast<int>(kHotKeyNum);
+  for (int round = 0; round < kRoundNum; ++round) {
+    for (size_t i = 0; i < kCapacity; ++i) {
+      trace.push_back(hot_distribution(rng));
+    }
+    for (size_t i = 0; i < kScanLength; ++i) {
+      trace.push_back(scan_key++);
+    }
+  }
+
+  LRUCache<int, int> lru_cache(kCapacity);
+  ClockCache<int, int> clock_cache(kCapacity);
+  TinyLFUCache<int, int> tiny_lfu_cache(kCapacity);
+  double lru_hit_rate = RunTrace(&lru_cache, trace, kBatchSize);
+  double clock_hit_rate = RunTrace(&clock_cache, trace, kBatchSize);
+  double tiny_lfu_hit_rate = RunTrace(&tiny_lfu_cache, trace, kBatchSize);
+  MS_LOG(INFO) << "Hit rate of lru cache: " << lru_hit_rate << ", clock cache: " << clock_hit_rate
+               << ", tiny lfu cache: " << tiny_lfu_hit_rate;
+  EXPECT_GT(tiny_lfu_hit_rate, lru_hit_rate);
+  EXPECT_GE(clock_hit_rate, lru_hit_rate);
+}
+}  // namespace distributed
+}  // namespace mindspore
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <map>
+#include <random>
 #include <vector>
 #include <string>
 
@@ -118,6 +119,94 @@ TEST_F(TestLocalFileStorage, test_local_file_storage) {
 
   EXPECT_NO_THROW(local_file->Finalize());
 }
+
+/// Feature: Test batched read of local file persistent storage.
+/// Description: Write key-value pairs across many block files, read them in random order with the memory mapped block
+/// files and with PRead.
+/// Expectation: The values read by both ways are equal to the values written, the missing keys are skipped.
+TEST_F(TestLocalFileStorage, test_local_file_storage_batched_read) {
+  std::string storage_file_path = "./local_file_storage_batched_read";
+  if (!FileIOUtils::IsFileOrDirExist(storage_file_path)) {
+    FileIOUtils::CreateDir(storage_file_path);
+  }
+  auto ret = FileUtils::GetRealPath(storage_file_path.c_str());
+  if (!ret.has_value()) {
+    MS_LOG(EXCEPTION) << "Cannot get real path of local file storage.";
+  }
+
+  size_t embedding_dim = 8;
+  size_t key_num = 1000;
+  std::vector<int64_t> keys(key_num);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::mt19937 rng(0);
+  std::shuffle(keys.begin(), keys.end(), rng);
+  std::vector<float> values_to_write(key_num * embedding_dim);
+  for (size_t i = 0; i < key_num; i++) {
+    for (size_t j = 0; j < embedding_dim; j++) {
+      values_to_write[i * embedding_dim + j] = static_cast<float>(keys[i] * embedding_dim + j);
+    }
+  }
+
+  // Some keys to read don't exist in file.
+  size_t read_key_num = 500;
+  std::vector<int64_t> keys_to_read(read_key_num);
+  for (auto &key : keys_to_read) {
+    key = static_cast<int64_t>(rng() % (key_num + key_num / 10));
+  }
+
+  for (const std::string enable_mmap_read : {"true", "false"}) {
+    std::map<std::string, std::string> config_map;
+    config_map.emplace(kFileStoragePath, ret.value() + "/" + enable_mmap_read);
+    FileIOUtils::CreateDir(config_map[kFileStoragePath]);
+    config_map.emplace(kElementSize, std::to_string(embedding_dim));
+    // The max block length 4096 bytes, which holds 128 elements.
+    config_map.emplace(kMaxBlockLength, "4096");
+    config_map.emplace(kEnableMmapRead, enable_mmap_read);
+    config_map.emplace(kReadQueueDepth, "2");
+
+    LocalFile<int64_t, float> local_file(config_map);
+    EXPECT_NO_THROW(local_file.Initialize());
+    EXPECT_NO_THROW(local_file.Write({keys.data(), keys.size() * sizeof(int64_t)},
+                                     {values_to_write.data(), values_to_write.size() * sizeof(float)}));
+
+    std::vector<float> values_to_read(read_key_num * embedding_dim, -1.0);
+    EXPECT_NO_THROW(local_file.Read({keys_to_read.data(), keys_to_read.size() * sizeof(int64_t)},
+                                    {values_to_read.data(), values_to_read.size() * sizeof(float)}));
+    for (size_t i = 0; i < read_key_num; i++) {
+      for (size_t j = 0; j < embedding_dim; j++) {
+        float expected = keys_to_read[i] < static_cast<int64_t>(key_num)
+                           ? static_cast<float>(keys_to_read[i] * embedding_dim + j)
+                           : -1.0;
+        EXPECT_EQ(values_to_read[i * embedding_dim + j], expected);
+      }
+    }
+
+    // The values rewritten are visible to the following reads.
+    std::vector<float> new_values(embedding_dim, 100.0);
+    EXPECT_NO_THROW(
+      local_file.Write({keys.data(), sizeof(int64_t)}, {new_values.data(), embedding_dim * sizeof(float)}));
+    std::vector<float> value_to_read(embedding_dim);
+    EXPECT_NO_THROW(
+      local_file.Read({keys.data(), sizeof(int64_t)}, {value_to_read.data(), embedding_dim * sizeof(float)}));
+    EXPECT_EQ(value_to_read, new_values);
+    EXPECT_NO_THROW(local_file.Finalize());
+  }
+}
+
+/// Feature: Test the read queue depth config of local file persistent storage.
+/// Description: Create local files with positive, negative, zero and malformed read queue depths.
+/// Expectation: Only the positive depth is accepted, the others throw instead of being wrapped around or ignored.
+TEST_F(TestLocalFileStorage, test_local_file_storage_read_queue_depth) {
+  std::map<std::string, std::string> config_map;
+  config_map.emplace(kFileStoragePath, "./local_file_storage_read_queue_depth");
+  config_map.emplace(kElementSize, "8");
+  config_map[kReadQueueDepth] = "4";
+  EXPECT_NO_THROW((LocalFile<int64_t, float>(config_map)));
+  for (const std::string read_queue_depth : {"-1", "0", "abc", "2x", "99999999999999999999"}) {
+    config_map[kReadQueueDepth] = read_queue_depth;
+    EXPECT_THROW((LocalFile<int64_t, float>(config_map)), std::runtime_error);
+  }
+}
 }  // namespace storage
 }  // namespace distributed
 }  // namespace mindspore
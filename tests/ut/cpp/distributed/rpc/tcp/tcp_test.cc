@@ -26,6 +26,8 @@
 #define private public
 #include "include/backend/distributed/rpc/tcp/tcp_server.h"
 #include "include/backend/distributed/rpc/tcp/tcp_client.h"
+#include "distributed/rpc/tcp/tcp_comm.h"
+#include "distributed/rpc/tcp/tcp_socket_operation.h"
 #include "include/backend/distributed/rpc/tcp/constants.h"
 #include "common/common_test.h"
 
@@ -59,6 +61,49 @@ static void IncrDataMsgNum(size_t number) { g_data_msg_num += number; }
 
 static size_t GetDataMsgNum() { return g_data_msg_num; }
 
+// Send the whole message as TCPSocketOperation does when every MSG_ZEROCOPY send fails with ENOBUFS, or as if the
+// zero copy sends are accepted when `issue_zero_copy` is set.
+class FakeZeroCopySocketOperation : public TCPSocketOperation {
+ public:
+  explicit FakeZeroCopySocketOperation(bool issue_zero_copy) : issue_zero_copy_(issue_zero_copy) {}
+  int SendMessage(Connection *connection, struct msghdr *sendMsg, size_t totalSendLen, size_t *sendLen) override {
+    *sendLen = totalSendLen;
+    if (issue_zero_copy_) {
+      ++connection->zero_copy_next_id;
+      connection->send_zero_copy_issued = true;
+    }
+    return IO_RW_OK;
+  }
+
+ private:
+  bool issue_zero_copy_;
+};
+
+// Set an environment variable for the scope, and restore the old value when leaving the scope.
+class EnvGuard {
+ public:
+  EnvGuard(const char *name, const char *value) : name_(name) {
+    const char *old_value = getenv(name);
+    if (old_value != nullptr) {
+      has_old_value_ = true;
+      old_value_ = old_value;
+    }
+    (void)setenv(name, value, 1);
+  }
+  ~EnvGuard() {
+    if (has_old_value_) {
+      (void)setenv(name_.c_str(), old_value_.c_str(), 1);
+    } else {
+      (void)unsetenv(name_.c_str());
+    }
+  }
+
+ private:
+  std::string name_;
+  bool has_old_value_{false};
+  std::string old_value_;
+};
+
 std::atomic<int> m_sendNum(0);
 std::string m_localIP = "127.0.0.1";
 bool m_notRemote = false;
@@ -335,6 +380,106 @@ TEST_F(TCPTest, SendLargeMessages) {
   server->Finalize();
 }
 
+/// Feature: test sending large messages with several event loops and zero copy.
+/// Description: start a socket server and a client with 2 pairs of event loops, and send large messages over zero copy.
+/// Expectation: the server received all the messages, and the client handed the message bodies back.
+TEST_F(TCPTest, SendLargeMessagesWithZeroCopy) {
+  Init();
+  EnvGuard event_loop_num(kEnvEventLoopNum, "2");
+  EnvGuard zero_copy_threshold(kEnvZeroCopyThreshold, "4096");
+
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize();
+  ASSERT_TRUE(ret);
+  server->SetMessageHandler([](MessageBase *const message) -> MessageBase *const {
+    IncrDataMsgNum(1);
+    return NULL_MSG;
+  });
+
+  auto client_url = "127.0.0.1:1234";
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  ret = client->Initialize();
+  ASSERT_TRUE(ret);
+  EXPECT_EQ(2, client->tcp_comm_->send_event_loops_.size());
+
+  auto ip = server->GetIP();
+  auto port = server->GetPort();
+  auto server_url = ip + ":" + std::to_string(port);
+  // Count the message bodies handed back, which are allocated by malloc in CreateMessage.
+  static std::atomic<size_t> free_num(0);
+  free_num = 0;
+  client->Connect(server_url, 60, [](void *data) {
+    free(data);
+    ++free_num;
+    return true;
+  });
+
+  size_t msg_cnt = 5;
+  size_t large_msg_size = 1024000;
+  for (int i = 0; i < msg_cnt; ++i) {
+    auto message = CreateMessage(server_url, client_url, large_msg_size);
+    client->SendAsync(std::move(message));
+  }
+
+  WaitForDataMsg(msg_cnt, 15);
+  EXPECT_EQ(msg_cnt, GetDataMsgNum());
+
+  // A zero copy body is handed back once the kernel reports the send is complete, which may come after the server
+  // has received the message.
+  size_t retry = 50;
+  while (free_num < msg_cnt && retry-- > 0) {
+    usleep(100000);
+  }
+  EXPECT_EQ(msg_cnt, free_num);
+
+  client->Disconnect(server_url);
+  client->Finalize();
+  server->Finalize();
+  // Every body is handed back exactly once.
+  EXPECT_EQ(msg_cnt, free_num);
+}
+
+/// Feature: test releasing the message bodies of the zero copy sends.
+/// Description: flush a message above the zero copy threshold whose sends all fall back to copying, and another one
+/// which goes out with zero copy.
+/// Expectation: the copied body is handed back at once, the zero copy body waits for the completion of its send.
+TEST_F(TCPTest, ReleaseZeroCopyFallbackMessage) {
+  static std::atomic<size_t> free_num(0);
+  free_num = 0;
+  SendMetrics send_metrics;
+  Connection conn;
+  conn.source = "127.0.0.1:1234";
+  conn.send_metrics = &send_metrics;
+  conn.zero_copy_enabled = true;
+  conn.zero_copy_threshold = 4096;
+  conn.SetMessageFreeCallback([](void *data) {
+    free(data);
+    ++free_num;
+    return true;
+  });
+
+  size_t large_msg_size = 8192;
+  FakeZeroCopySocketOperation copy_operation(false);
+  conn.socket_operation = &copy_operation;
+  conn.send_message_queue.push(CreateMessage("127.0.0.1:2345", conn.source, large_msg_size).release());
+  conn.output_buffer_size = large_msg_size;
+  EXPECT_EQ(large_msg_size, conn.Flush());
+  EXPECT_TRUE(conn.send_zero_copy);
+  EXPECT_TRUE(conn.zero_copy_pending.empty());
+  EXPECT_EQ(1, free_num);
+
+  FakeZeroCopySocketOperation zero_copy_operation(true);
+  conn.socket_operation = &zero_copy_operation;
+  conn.send_message_queue.push(CreateMessage("127.0.0.1:2345", conn.source, large_msg_size).release());
+  conn.output_buffer_size = large_msg_size;
+  EXPECT_EQ(large_msg_size, conn.Flush());
+  ASSERT_EQ(1, conn.zero_copy_pending.size());
+  EXPECT_EQ(1, free_num);
+  conn.ReleaseZeroCopyMessages(conn.zero_copy_next_id - 1);
+  EXPECT_TRUE(conn.zero_copy_pending.empty());
+  EXPECT_EQ(2, free_num);
+}
+
 /// Feature: test delete invalid tcp connection used in connection pool in tcp client when some socket error happened.
 /// Description: start a socket server and tcp client pair and stop the tcp server.
 /// Expectation: the connection from the tcp client to the tcp server will be deleted automatically.
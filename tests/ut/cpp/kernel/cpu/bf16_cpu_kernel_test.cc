@@ -0,0 +1,354 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "base/bfloat16.h"
+#define private public
+#define protected public
+#include "plugin/device/cpu/kernel/arithmetic_cpu_kernel.h"
+#include "plugin/device/cpu/kernel/embedding_look_up_cpu_kernel.h"
+#include "plugin/device/cpu/kernel/layer_norm_cpu_kernel.h"
+#include "plugin/device/cpu/kernel/matmul_bf16_cpu_kernel_func.h"
+#include "plugin/device/cpu/kernel/softmax_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+namespace {
+std::vector<bfloat16> RandomBf16(size_t size, float low, float high, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(low, high);
+  std::vector<bfloat16> data(size);
+  for (auto &value : data) {
+    value = bfloat16(dist(gen));
+  }
+  return data;
+}
+
+size_t ShapeSize(const ShapeVector &shape) {
+  size_t size = 1;
+  for (auto dim : shape) {
+    size *= static_cast<size_t>(dim);
+  }
+  return size;
+}
+}  // namespace
+
+class Bf16CpuKernelTest : public UT::Common {
+ public:
+  Bf16CpuKernelTest() {}
+
+  void SetUp() override { kernel_tensors_.clear(); }
+
+  KernelTensor *CreateTensor(const ShapeVector &shape, const TypePtr &dtype, void *data, size_t size) {
+    auto shape_ab = std::make_shared<abstract::Shape>(shape);
+    auto new_abstract = std::make_shared<abstract::AbstractTensor>(dtype, shape_ab);
+    auto res_tensor = std::make_shared<KernelTensor>(new_abstract->GetShape(), new_abstract->GetType(), kValueAny);
+    res_tensor->set_format(mindspore::Format::NCHW);
+    res_tensor->set_device_ptr(data);
+    res_tensor->set_size(size);
+    kernel_tensors_.push_back(res_tensor);
+    return res_tensor.get();
+  }
+
+  template <typename T>
+  KernelTensor *CreateTensor(const ShapeVector &shape, const TypePtr &dtype, std::vector<T> *data) {
+    return CreateTensor(shape, dtype, data->data(), data->size() * sizeof(T));
+  }
+
+  // the scalar and tuple inputs, such as the transposes and the axes, which the kernels read at Init or Resize.
+  KernelTensor *CreateValue(const ValuePtr &value) {
+    auto value_abstract = value->ToAbstract();
+    auto res_tensor = std::make_shared<KernelTensor>(value_abstract->GetShape(), value_abstract->GetType(), value);
+    kernel_tensors_.push_back(res_tensor);
+    return res_tensor.get();
+  }
+
+  // init the kernel by the primitive of the op, resize it and launch it with the workspace it asks for.
+  void Run(NativeCpuKernelMod *kernel, const std::string &op_name, const std::vector<KernelTensor *> &inputs,
+           const std::vector<KernelTensor *> &outputs) {
+    ASSERT_TRUE(kernel->Init(std::make_shared<Primitive>(op_name), inputs, outputs));
+    ASSERT_EQ(kernel->Resize(inputs, outputs), KRET_OK);
+    std::vector<std::vector<uint8_t>> workspace_data;
+    std::vector<KernelTensor *> workspace;
+    for (auto size : kernel->GetWorkspaceSizeList()) {
+      workspace_data.emplace_back(size);
+    }
+    for (auto &data : workspace_data) {
+      workspace.push_back(CreateTensor({SizeToLong(data.size())}, kUInt8, &data));
+    }
+    ASSERT_TRUE(kernel->Launch(inputs, workspace, outputs));
+  }
+
+  std::vector<std::shared_ptr<KernelTensor>> kernel_tensors_;
+};
+
+// the matmul of the widened bf16 accumulated in double, and the sum of the abs of the products for the tolerance.
+double RefDot(const std::vector<bfloat16> &a, size_t a_offset, size_t a_step, const std::vector<bfloat16> &b,
+              size_t b_offset, size_t b_step, size_t deep, double *abs_sum) {
+  double dot = 0;
+  *abs_sum = 0;
+  for (size_t d = 0; d < deep; ++d) {
+    double product =
+      static_cast<double>(static_cast<float>(a[a_offset + d * a_step])) * static_cast<float>(b[b_offset + d * b_step]);
+    dot += product;
+    *abs_sum += std::fabs(product);
+  }
+  return dot;
+}
+
+void CheckMatMul(Bf16CpuKernelTest *test, const std::string &op_name, size_t batch, size_t b_batch, size_t row,
+                 size_t col, size_t deep, bool trans_a, bool trans_b) {
+  ShapeVector a_shape = trans_a ? ShapeVector{SizeToLong(deep), SizeToLong(row)}
+                                : ShapeVector{SizeToLong(row), SizeToLong(deep)};
+  ShapeVector b_shape = trans_b ? ShapeVector{SizeToLong(col), SizeToLong(deep)}
+                                : ShapeVector{SizeToLong(deep), SizeToLong(col)};
+  ShapeVector c_shape{SizeToLong(row), SizeToLong(col)};
+  if (op_name != "MatMul") {
+    (void)a_shape.insert(a_shape.begin(), SizeToLong(batch));
+    (void)b_shape.insert(b_shape.begin(), SizeToLong(b_batch));
+    (void)c_shape.insert(c_shape.begin(), SizeToLong(batch));
+  }
+  auto a = RandomBf16(ShapeSize(a_shape), -2.0f, 2.0f, 1);
+  auto b = RandomBf16(ShapeSize(b_shape), -2.0f, 2.0f, 2);
+  std::vector<bfloat16> c(ShapeSize(c_shape));
+  std::vector<KernelTensor *> inputs = {test->CreateTensor(a_shape, kBFloat16, &a),
+                                        test->CreateTensor(b_shape, kBFloat16, &b),
+                                        test->CreateValue(MakeValue(trans_a)), test->CreateValue(MakeValue(trans_b))};
+  std::vector<KernelTensor *> outputs = {test->CreateTensor(c_shape, kBFloat16, &c)};
+
+  MatMulBf16CpuKernelFunc matmul;
+  matmul.InitFunc(std::make_shared<Primitive>(op_name), inputs, outputs);
+  ASSERT_EQ(matmul.Resize(inputs, outputs), KRET_OK);
+  ASSERT_TRUE(matmul.RunFunc(inputs, {}, outputs));
+  for (size_t n = 0; n < batch; ++n) {
+    size_t a_base = n * row * deep;
+    size_t b_base = (b_batch == 1 ? 0 : n) * col * deep;
+    for (size_t i = 0; i < row; ++i) {
+      for (size_t j = 0; j < col; ++j) {
+        double abs_sum = 0;
+        double expect = RefDot(a, a_base + (trans_a ? i : i * deep), trans_a ? row : 1, b,
+                               b_base + (trans_b ? j * deep : j), trans_b ? 1 : col, deep, &abs_sum);
+        // a bf16 keeps 8 bits of the mantissa.
+        ASSERT_NEAR(static_cast<float>(c[(n * row + i) * col + j]), expect, std::fabs(expect) / 256 + 1e-5 * abs_sum)
+          << op_name << " batch " << n << " at " << i << " " << j;
+      }
+    }
+  }
+}
+
+/// Feature: the bf16 MatMul and BatchMatMul of cpu.
+/// Description: run the bf16 matmul func that the bf16 registrations create, with either input transposed, by the
+/// columns for the gemv and by the rows for the tall matrix, and a batch of b shared by the batches of a.
+/// Expectation: the output is the matmul of the widened inputs within a bf16 rounding.
+TEST_F(Bf16CpuKernelTest, MatMul) {
+  CheckMatMul(this, "MatMul", 1, 1, 1, 37, 70, false, true);
+  CheckMatMul(this, "MatMul", 1, 1, 29, 6, 33, true, false);
+  CheckMatMul(this, "MatMul", 1, 1, 9, 9, 16, true, true);
+  CheckMatMul(this, "BatchMatMul", 3, 3, 5, 7, 19, false, false);
+  CheckMatMul(this, "BatchMatMul", 2, 1, 13, 4, 40, false, true);
+}
+
+/// Feature: the bf16 arithmetic of cpu.
+/// Description: Add, Sub, Mul and RealDiv of the same shapes and with a scalar, which run by nnacl, and of the
+/// broadcast shapes, which run by the common loop.
+/// Expectation: every element is the fp32 result of the widened inputs rounded to bf16 once.
+TEST_F(Bf16CpuKernelTest, Arithmetic) {
+  struct ArithmeticCase {
+    std::string op_name;
+    std::function<float(float, float)> ref;
+  };
+  const std::vector<ArithmeticCase> cases = {
+    {"Add", [](float x, float y) { return x + y; }},
+    {"Sub", [](float x, float y) { return x - y; }},
+    {"Mul", [](float x, float y) { return x * y; }},
+    {"RealDiv", [](float x, float y) { return x / y; }},
+  };
+  const std::vector<std::vector<ShapeVector>> shapes = {
+    {{2, 3, 37}, {2, 3, 37}, {2, 3, 37}},
+    {{1}, {2, 3, 37}, {2, 3, 37}},
+    {{2, 3, 37}, {1}, {2, 3, 37}},
+    {{2, 1, 37}, {1, 3, 37}, {2, 3, 37}},
+  };
+  for (const auto &arith_case : cases) {
+    for (size_t shape_i = 0; shape_i < shapes.size(); ++shape_i) {
+      const auto &shape = shapes[shape_i];
+      auto x = RandomBf16(ShapeSize(shape[kIndex0]), 0.5f, 8.0f, 1);
+      auto y = RandomBf16(ShapeSize(shape[kIndex1]), 0.5f, 8.0f, 2);
+      std::vector<bfloat16> out(ShapeSize(shape[kIndex2]));
+      auto arithmetic = std::make_shared<ArithmeticCpuKernelMod>(arith_case.op_name);
+      Run(arithmetic.get(), arith_case.op_name,
+          {CreateTensor(shape[kIndex0], kBFloat16, &x), CreateTensor(shape[kIndex1], kBFloat16, &y)},
+          {CreateTensor(shape[kIndex2], kBFloat16, &out)});
+      size_t inner = LongToSize(shape[kIndex2].back());
+      size_t middle = LongToSize(shape[kIndex2][kIndex1]);
+      for (size_t i = 0; i < out.size(); ++i) {
+        auto index = [&shape, i, inner, middle](size_t input) {
+          const auto &input_shape = shape[input];
+          if (input_shape.size() == 1) {
+            return size_t(0);
+          }
+          size_t outer_i = i / (middle * inner);
+          size_t middle_i = (i / inner) % middle;
+          return ((input_shape[kIndex0] == 1 ? 0 : outer_i) * LongToSize(input_shape[kIndex1]) +
+                  (input_shape[kIndex1] == 1 ? 0 : middle_i)) *
+                   inner +
+                 i % inner;
+        };
+        float expect = arith_case.ref(static_cast<float>(x[index(kIndex0)]), static_cast<float>(y[index(kIndex1)]));
+        ASSERT_EQ(out[i].int_value(), bfloat16(expect).int_value())
+          << arith_case.op_name << " shape case " << shape_i << " at " << i;
+      }
+    }
+  }
+}
+
+/// Feature: the bf16 Softmax of cpu.
+/// Description: the softmax of the last axis, which runs by nnacl, and of the first axis, which runs by the common
+/// loop with the fp32 sum in the workspace.
+/// Expectation: the output is the softmax of the widened input within the bf16 roundings.
+TEST_F(Bf16CpuKernelTest, Softmax) {
+  constexpr size_t kOuter = 3;
+  constexpr size_t kInner = 300;
+  for (int64_t axis : {-1, 0}) {
+    auto x = RandomBf16(kOuter * kInner, -8.0f, 8.0f, 1);
+    std::vector<bfloat16> out(x.size());
+    ShapeVector shape{SizeToLong(kOuter), SizeToLong(kInner)};
+    auto softmax = std::make_shared<SoftmaxCpuKernelMod>();
+    Run(softmax.get(), "Softmax",
+        {CreateTensor(shape, kBFloat16, &x), CreateValue(MakeValue(std::vector<int64_t>{axis}))},
+        {CreateTensor(shape, kBFloat16, &out)});
+    size_t axis_size = axis == 0 ? kOuter : kInner;
+    size_t axis_step = axis == 0 ? kInner : 1;
+    for (size_t i = 0; i < x.size(); ++i) {
+      size_t axis_i = axis == 0 ? i / kInner : i % kInner;
+      size_t base = i - axis_i * axis_step;
+      double max = -INFINITY;
+      for (size_t k = 0; k < axis_size; ++k) {
+        max = std::max(max, static_cast<double>(static_cast<float>(x[base + k * axis_step])));
+      }
+      double sum = 0;
+      for (size_t k = 0; k < axis_size; ++k) {
+        sum += std::exp(static_cast<float>(x[base + k * axis_step]) - max);
+      }
+      double expect = std::exp(static_cast<float>(x[i]) - max) / sum;
+      // the last axis is rounded to bf16 once, the common loop also rounds the exp and the sum.
+      ASSERT_NEAR(static_cast<float>(out[i]), expect, expect / (axis == 0 ? 64 : 128) + 1e-7)
+        << "axis " << axis << " at " << i;
+    }
+  }
+}
+
+/// Feature: the bf16 LayerNorm of cpu.
+/// Description: normalize the last two axes with the params repeated in the norm, which runs by nnacl, and the last
+/// axis with the params of the last two axes, which runs by the common loop.
+/// Expectation: the output is the layer norm of the widened inputs within the bf16 roundings, and the mean and the
+/// variance are fp32.
+TEST_F(Bf16CpuKernelTest, LayerNorm) {
+  const ShapeVector x_shape{4, 2, 24};
+  struct LayerNormCase {
+    int64_t begin_norm_axis;
+    int64_t begin_params_axis;
+    ShapeVector params_shape;
+    ShapeVector mean_shape;
+    // the common loop also rounds the mean and the std to bf16.
+    double relative_tolerance;
+    double abs_tolerance;
+  };
+  const std::vector<LayerNormCase> cases = {
+    {1, -1, {24}, {4, 1, 1}, 1.0 / 128, 1e-2},
+    {2, 1, {2, 24}, {4, 2, 1}, 1.0 / 32, 5e-2},
+  };
+  constexpr float kEps = 1e-5f;
+  for (const auto &norm_case : cases) {
+    auto x = RandomBf16(ShapeSize(x_shape), 1.0f, 5.0f, 1);
+    auto gamma = RandomBf16(ShapeSize(norm_case.params_shape), 0.5f, 1.5f, 2);
+    auto beta = RandomBf16(ShapeSize(norm_case.params_shape), -1.0f, 1.0f, 3);
+    std::vector<bfloat16> y(x.size());
+    std::vector<float> mean(ShapeSize(norm_case.mean_shape));
+    std::vector<float> var(mean.size());
+    auto layer_norm = std::make_shared<LayerNormCpuKernelMod>();
+    Run(layer_norm.get(), "LayerNorm",
+        {CreateTensor(x_shape, kBFloat16, &x), CreateTensor(norm_case.params_shape, kBFloat16, &gamma),
+         CreateTensor(norm_case.params_shape, kBFloat16, &beta), CreateValue(MakeValue(norm_case.begin_norm_axis)),
+         CreateValue(MakeValue(norm_case.begin_params_axis)), CreateValue(MakeValue(kEps))},
+        {CreateTensor(x_shape, kBFloat16, &y), CreateTensor(norm_case.mean_shape, kFloat32, &mean),
+         CreateTensor(norm_case.mean_shape, kFloat32, &var)});
+    size_t block_size = x.size() / mean.size();
+    for (size_t n = 0; n < mean.size(); ++n) {
+      double sum = 0;
+      double square_sum = 0;
+      for (size_t j = n * block_size; j < (n + 1) * block_size; ++j) {
+        double x_j = static_cast<float>(x[j]);
+        sum += x_j;
+        square_sum += x_j * x_j;
+      }
+      double expect_mean = sum / block_size;
+      double expect_var = square_sum / block_size - expect_mean * expect_mean;
+      ASSERT_NEAR(mean[n], expect_mean, 1e-4);
+      ASSERT_NEAR(var[n], expect_var, 1e-3);
+      for (size_t j = n * block_size; j < (n + 1) * block_size; ++j) {
+        size_t param_j = j % gamma.size();
+        double expect = (static_cast<float>(x[j]) - expect_mean) / std::sqrt(expect_var + kEps) *
+                          static_cast<float>(gamma[param_j]) +
+                        static_cast<float>(beta[param_j]);
+        double tolerance = std::fabs(expect) * norm_case.relative_tolerance + norm_case.abs_tolerance;
+        ASSERT_NEAR(static_cast<float>(y[j]), expect, tolerance)
+          << "begin_norm_axis " << norm_case.begin_norm_axis << " at " << j;
+      }
+    }
+  }
+}
+
+/// Feature: the bf16 EmbeddingLookup of cpu.
+/// Description: look up the rows of bf16 params by the int32 and int64 indices with an offset, in which some indices
+/// are out of the params.
+/// Expectation: the rows are copied bit by bit, and the indices out of the params give zeros.
+TEST_F(Bf16CpuKernelTest, EmbeddingLookup) {
+  constexpr size_t kRows = 6;
+  constexpr size_t kDim = 5;
+  const int64_t offset = 1;
+  auto check = [this, offset](auto indices, const TypePtr &indices_type) {
+    auto params = RandomBf16(kRows * kDim, -4.0f, 4.0f, 1);
+    std::vector<int64_t> offset_data = {offset};
+    std::vector<bfloat16> out(indices.size() * kDim, bfloat16(1.0f));
+    ShapeVector indices_shape{SizeToLong(indices.size())};
+    auto embedding = std::make_shared<EmbeddingLookUpCpuKernelMod>();
+    Run(embedding.get(), "EmbeddingLookup",
+        {CreateTensor({SizeToLong(kRows), SizeToLong(kDim)}, kBFloat16, &params),
+         CreateTensor(indices_shape, indices_type, &indices), CreateTensor({1}, kInt64, &offset_data)},
+        {CreateTensor({SizeToLong(indices.size()), SizeToLong(kDim)}, kBFloat16, &out)});
+    for (size_t i = 0; i < indices.size(); ++i) {
+      int64_t row = static_cast<int64_t>(indices[i]) - offset;
+      for (size_t d = 0; d < kDim; ++d) {
+        uint16_t expect = (row >= 0 && row < SizeToLong(kRows)) ? params[LongToSize(row) * kDim + d].int_value() : 0;
+        ASSERT_EQ(out[i * kDim + d].int_value(), expect) << "index " << indices[i];
+      }
+    }
+  };
+  check(std::vector<int32_t>{1, 6, 0, 3, 7, 2, 2}, kInt32);
+  check(std::vector<int64_t>{6, -1, 4, 1, 100}, kInt64);
+}
+}  // namespace kernel
+}  // namespace mindspore
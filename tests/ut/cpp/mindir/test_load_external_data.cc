@@ -0,0 +1,125 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "load_mindir/load_model.h"
+#include "load_mindir/mapped_tensor_data.h"
+#include "ir/anf.h"
+#include "ir/tensor.h"
+#include "proto/mind_ir.pb.h"
+
+namespace mindspore {
+namespace {
+constexpr char kDataFileName[] = "external_data_test.bin";
+// The aligned weight is mapped, and the misaligned one is copied.
+constexpr size_t kAlignedOffset = 8;
+constexpr size_t kMisalignedOffset = 42;
+constexpr size_t kElementNum = 6;
+
+void AddParameter(mind_ir::GraphProto *graph, const std::string &name, size_t offset) {
+  auto parameter = graph->add_parameter();
+  parameter->set_name(name);
+  parameter->set_data_type(mind_ir::TensorProto_DataType_FLOAT);
+  parameter->add_dims(2);
+  parameter->add_dims(3);
+  auto external_data = parameter->mutable_external_data();
+  external_data->set_location(kDataFileName);
+  external_data->set_offset(SizeToLong(offset));
+  external_data->set_length(SizeToLong(kElementNum * sizeof(float)));
+}
+
+std::string BuildModel() {
+  mind_ir::ModelProto model;
+  model.set_producer_name("MindSpore");
+  model.set_model_version("2.3.0");
+  model.set_little_endian(common::IsLittleByteOrder());
+  auto graph = model.mutable_graph();
+  graph->set_name("external_data_graph");
+  AddParameter(graph, "aligned_weight", kAlignedOffset);
+  AddParameter(graph, "misaligned_weight", kMisalignedOffset);
+  graph->add_output()->set_name("aligned_weight");
+  graph->add_output()->set_name("misaligned_weight");
+  return model.SerializeAsString();
+}
+
+std::vector<float> WriteDataFile(const std::string &file_name) {
+  std::vector<uint8_t> buffer(kMisalignedOffset + kElementNum * sizeof(float), 0);
+  buffer[0] = common::IsLittleByteOrder() ? 1 : 0;
+  std::vector<float> values;
+  for (size_t i = 0; i < kElementNum; ++i) {
+    values.push_back(static_cast<float>(i) + 0.5f);
+  }
+  (void)memcpy(buffer.data() + kAlignedOffset, values.data(), kElementNum * sizeof(float));
+  (void)memcpy(buffer.data() + kMisalignedOffset, values.data(), kElementNum * sizeof(float));
+  std::ofstream ofs(file_name, std::ios::binary);
+  (void)ofs.write(reinterpret_cast<const char *>(buffer.data()), SizeToLong(buffer.size()));
+  return values;
+}
+
+std::vector<tensor::TensorPtr> GetWeights(const FuncGraphPtr &func_graph) {
+  std::vector<tensor::TensorPtr> weights;
+  for (const auto &node : func_graph->parameters()) {
+    auto parameter = node->cast<ParameterPtr>();
+    if (parameter != nullptr && parameter->has_default()) {
+      weights.push_back(parameter->default_param()->cast<tensor::TensorPtr>());
+    }
+  }
+  return weights;
+}
+}  // namespace
+
+class TestLoadExternalData : public UT::Common {
+ public:
+  TestLoadExternalData() = default;
+};
+
+/// Feature: Load the external data of MindIR by mapping the data file.
+/// Description: Load the weights with and without mapping, and write the mapped weight.
+/// Expectation: The weights are the same, only the aligned weight is mapped, and the write does not reach the file.
+TEST_F(TestLoadExternalData, test_mmap_external_data) {
+  const auto values = WriteDataFile(std::string("./") + kDataFileName);
+  const auto model = BuildModel();
+  for (bool mmap_external_data : {false, true}) {
+    MindIRLoader loader;
+    loader.set_mmap_external_data(mmap_external_data);
+    auto func_graph = loader.LoadMindIR(model.data(), model.size(), ".");
+    ASSERT_NE(func_graph, nullptr);
+    auto weights = GetWeights(func_graph);
+    ASSERT_EQ(weights.size(), 2);
+    for (const auto &weight : weights) {
+      ASSERT_NE(weight, nullptr);
+      EXPECT_EQ(memcmp(weight->data_c(), values.data(), kElementNum * sizeof(float)), 0);
+    }
+    auto mapped_data = dynamic_cast<tensor::MappedTensorData<float> *>(&weights[0]->data());
+    EXPECT_EQ(mapped_data != nullptr, mmap_external_data);
+    EXPECT_EQ(dynamic_cast<tensor::MappedTensorData<float> *>(&weights[1]->data()), nullptr);
+    // The mapping is private, so the written weight is copied.
+    static_cast<float *>(weights[0]->data_c())[0] = -1.0f;
+  }
+
+  MindIRLoader loader;
+  loader.set_mmap_external_data(true);
+  auto func_graph = loader.LoadMindIR(model.data(), model.size(), ".");
+  ASSERT_NE(func_graph, nullptr);
+  auto weights = GetWeights(func_graph);
+  ASSERT_EQ(weights.size(), 2);
+  EXPECT_EQ(static_cast<float *>(weights[0]->data_c())[0], values[0]);
+  (void)std::remove(kDataFileName);
+}
+}  // namespace mindspore
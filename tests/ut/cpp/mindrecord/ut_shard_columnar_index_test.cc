@@ -0,0 +1,286 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_columnar_index.h"
+#include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_reader.h"
+#include "minddata/mindrecord/include/shard_writer.h"
+#include "ut_common.h"
+
+using std::string;
+using std::vector;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const char kIndexFile[] = "./columnar_index_test.mindrecord.idx";
+const char kShardName[] = "columnar_index_test.mindrecord";
+const char kDatasetFile[] = "./columnar_reader_test.mindrecord";
+const uint64_t kDatasetRows = 10;
+
+using Sample = std::tuple<std::map<string, vector<uint8_t>>, json>;
+
+vector<std::tuple<string, string, string>> MakeRow(uint64_t row_id, int64_t label, double score, const string &name) {
+  vector<std::tuple<string, string, string>> row = {
+    {":ROW_ID", "INTEGER", std::to_string(row_id)},
+    {":ROW_GROUP_ID", "INTEGER", std::to_string(row_id / 2)},
+    {":PAGE_ID_RAW", "INTEGER", "0"},
+    {":PAGE_OFFSET_RAW", "INTEGER", std::to_string(row_id * 10)},
+    {":PAGE_OFFSET_RAW_END", "INTEGER", std::to_string(row_id * 10 + 10)},
+    {":PAGE_ID_BLOB", "INTEGER", "1"},
+    {":PAGE_OFFSET_BLOB", "INTEGER", std::to_string(row_id * 100)},
+    {":PAGE_OFFSET_BLOB_END", "INTEGER", std::to_string(row_id * 100 + 100)},
+    {":INC_0", "INTEGER", "0"},
+    {":label_0", "INTEGER", std::to_string(label)},
+    {":INC_1", "INTEGER", "1"},
+    {":score_0", "REAL", std::to_string(score)},
+    {":INC_2", "INTEGER", "2"},
+    {":name_0", "TEXT", name}};
+  return row;
+}
+// write a dataset of one shard, its index fields are of all the types of the columnar index
+void WriteDataset(bool columnar_index) {
+  json schema_json =
+    R"({"file_name": {"type": "string"}, "label": {"type": "int32"}, "score": {"type": "float64"}})"_json;
+  auto schema = Schema::Build("annotation", schema_json);
+  ASSERT_NE(schema, nullptr);
+  auto header = std::make_shared<ShardHeader>();
+  auto schema_id = static_cast<uint64_t>(header->AddSchema(schema));
+  vector<std::pair<uint64_t, string>> index_fields = {
+    {schema_id, "file_name"}, {schema_id, "label"}, {schema_id, "score"}};
+  ASSERT_TRUE(header->AddIndexFields(index_fields).IsOk());
+
+  std::map<uint64_t, vector<json>> raw_data;
+  vector<vector<uint8_t>> blob_data;
+  for (uint64_t i = 0; i < kDatasetRows; ++i) {
+    json row;
+    row["file_name"] = "image_" + std::to_string(i % 3) + ".jpg";
+    row["label"] = static_cast<int32_t>(kDatasetRows - i);
+    row["score"] = 0.25 * i;
+    raw_data[schema_id].push_back(row);
+    blob_data.emplace_back(i + 1, static_cast<uint8_t>(i));
+  }
+  ShardWriter writer;
+  ASSERT_TRUE(writer.Open({kDatasetFile}).IsOk());
+  ASSERT_TRUE(writer.SetShardHeader(header).IsOk());
+  ASSERT_TRUE(writer.WriteRawData(raw_data, blob_data).IsOk());
+  ASSERT_TRUE(writer.Commit().IsOk());
+
+  ShardIndexGenerator generator(kDatasetFile, false, columnar_index);
+  ASSERT_TRUE(generator.Build().IsOk());
+  ASSERT_TRUE(generator.WriteToDatabase().IsOk());
+}
+
+// read all the samples in order, `use_columnar_index` is whether the reader looks up the rows from the columnar index
+vector<Sample> ReadDataset(const vector<string> &columns, LoadMode load_mode, bool *use_columnar_index) {
+  ShardReader reader;
+  vector<Sample> samples;
+  if (reader.Open({kDatasetFile}, true, 1, columns, {}, 0, load_mode).IsError() || reader.Launch().IsError()) {
+    return samples;
+  }
+  *use_columnar_index = reader.UseColumnarIndex(0);
+  while (true) {
+    auto batch = reader.GetNext();
+    if (batch.empty()) {
+      break;
+    }
+    samples.insert(samples.end(), batch.begin(), batch.end());
+  }
+  reader.Close();
+  return samples;
+}
+}  // namespace
+
+class TestShardColumnarIndex : public UT::Common {
+ public:
+  TestShardColumnarIndex() {}
+
+  void TearDown() override {
+    (void)remove(kIndexFile);
+    (void)remove(kDatasetFile);
+    (void)remove((string(kDatasetFile) + ".db").c_str());
+    (void)remove((string(kDatasetFile) + kColumnarIndexSuffix).c_str());
+  }
+};
+
+/// Feature: ShardColumnarIndex
+/// Description: Write the rows out of order with ShardColumnarIndexBuilder and load the columnar index file
+/// Expectation: The rows are sorted by ROW_ID and the offsets and field values are the same as written
+TEST_F(TestShardColumnarIndex, TestWriteAndLoad) {
+  MS_LOG(INFO) << FormatInfo("Test ShardColumnarIndex write and load");
+  ShardColumnarIndexBuilder builder({{"label_0", "INTEGER"}, {"score_0", "REAL"}, {"name_0", "TEXT"}});
+  const uint64_t kNumRows = 6;
+  const vector<string> names = {"cat", "dog", "", "cat", "bird", "dog"};
+  for (uint64_t i = 0; i < kNumRows; ++i) {
+    uint64_t row_id = kNumRows - 1 - i;
+    ASSERT_TRUE(builder.AddRow(MakeRow(row_id, -static_cast<int64_t>(row_id), row_id * 0.5, names[row_id])).IsOk());
+  }
+  ASSERT_TRUE(builder.Write(kIndexFile, kShardName).IsOk());
+
+  std::shared_ptr<ShardColumnarIndex> index;
+  ASSERT_TRUE(ShardColumnarIndex::Load(kIndexFile, kShardName, &index).IsOk());
+  ASSERT_EQ(index->GetNumRows(), kNumRows);
+  int label_id = index->GetFieldId("label_0");
+  int score_id = index->GetFieldId("score_0");
+  int name_id = index->GetFieldId("name_0");
+  ASSERT_GE(label_id, 0);
+  ASSERT_GE(score_id, 0);
+  ASSERT_GE(name_id, 0);
+  EXPECT_EQ(index->GetFieldId("INC_0"), -1);
+  EXPECT_EQ(index->GetFieldType(label_id), ColumnarFieldType::kInt64);
+  EXPECT_EQ(index->GetFieldType(score_id), ColumnarFieldType::kFloat64);
+  EXPECT_EQ(index->GetFieldType(name_id), ColumnarFieldType::kString);
+  for (uint64_t row_id = 0; row_id < kNumRows; ++row_id) {
+    uint64_t row = kNumRows;
+    ASSERT_TRUE(index->FindRow(row_id, &row).IsOk());
+    EXPECT_EQ(row, row_id);
+    EXPECT_EQ(index->GetOffset(kColRowId, row), row_id);
+    EXPECT_EQ(index->GetOffset(kColRowGroupId, row), row_id / 2);
+    EXPECT_EQ(index->GetOffset(kColPageOffsetRawEnd, row), row_id * 10 + 10);
+    EXPECT_EQ(index->GetOffset(kColPageIdBlob, row), 1);
+    EXPECT_EQ(index->GetOffset(kColPageOffsetBlob, row), row_id * 100);
+    EXPECT_EQ(index->GetInt64(label_id, row), -static_cast<int64_t>(row_id));
+    EXPECT_DOUBLE_EQ(index->GetFloat64(score_id, row), row_id * 0.5);
+    EXPECT_EQ(index->GetString(name_id, row), names[row_id]);
+  }
+  uint64_t row = 0;
+  EXPECT_FALSE(index->FindRow(kNumRows, &row).IsOk());
+}
+
+/// Feature: ShardColumnarIndex
+/// Description: Load a columnar index with the wrong shard name, a truncated columnar index and an incomplete row
+/// Expectation: Load and AddRow fail, so the reader falls back to sqlite
+TEST_F(TestShardColumnarIndex, TestInvalidIndex) {
+  MS_LOG(INFO) << FormatInfo("Test ShardColumnarIndex with invalid index");
+  ShardColumnarIndexBuilder builder({{"label_0", "INTEGER"}, {"score_0", "REAL"}, {"name_0", "TEXT"}});
+  for (uint64_t row_id = 0; row_id < 4; ++row_id) {
+    ASSERT_TRUE(builder.AddRow(MakeRow(row_id, row_id, row_id, "name")).IsOk());
+  }
+  auto row = MakeRow(4, 4, 4, "name");
+  row.pop_back();
+  EXPECT_FALSE(builder.AddRow(row).IsOk());
+
+  ShardColumnarIndexBuilder good_builder(vector<std::pair<string, string>>{{"label_0", "INTEGER"}});
+  ASSERT_TRUE(good_builder.AddRow({{":ROW_ID", "INTEGER", "0"},
+                                   {":ROW_GROUP_ID", "INTEGER", "0"},
+                                   {":PAGE_ID_RAW", "INTEGER", "0"},
+                                   {":PAGE_OFFSET_RAW", "INTEGER", "0"},
+                                   {":PAGE_OFFSET_RAW_END", "INTEGER", "0"},
+                                   {":PAGE_ID_BLOB", "INTEGER", "0"},
+                                   {":PAGE_OFFSET_BLOB", "INTEGER", "0"},
+                                   {":PAGE_OFFSET_BLOB_END", "INTEGER", "0"},
+                                   {":label_0", "INTEGER", "7"}})
+                .IsOk());
+  ASSERT_TRUE(good_builder.Write(kIndexFile, kShardName).IsOk());
+  std::shared_ptr<ShardColumnarIndex> index;
+  EXPECT_FALSE(ShardColumnarIndex::Load(kIndexFile, "other.mindrecord", &index).IsOk());
+
+  // Drop the tail of the file.
+  std::ifstream fin(kIndexFile, std::ios::binary);
+  string content((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+  fin.close();
+  std::ofstream fout(kIndexFile, std::ios::binary | std::ios::trunc);
+  (void)fout.write(content.data(), content.size() - sizeof(uint64_t));
+  fout.close();
+  EXPECT_FALSE(ShardColumnarIndex::Load(kIndexFile, kShardName, &index).IsOk());
+}
+
+/// Feature: ShardColumnarIndex
+/// Description: Write a dataset with the columnar index, read it with ShardReader in the fast and lazy load modes, for
+/// the index columns only and for all the columns, then read it again from sqlite after removing the columnar index
+/// Expectation: The columnar index is used while it exists, and the samples and their order are the same as sqlite's
+TEST_F(TestShardColumnarIndex, TestReadSameAsSqlite) {
+  MS_LOG(INFO) << FormatInfo("Test ShardReader with columnar index");
+  WriteDataset(true);
+  string index_file = string(kDatasetFile) + kColumnarIndexSuffix;
+  ASSERT_TRUE(std::ifstream(index_file).good());
+
+  const vector<vector<string>> column_lists = {{"label", "file_name", "score"}, {}};
+  const vector<LoadMode> load_modes = {LoadMode::kFast, LoadMode::kLazy};
+  vector<vector<Sample>> columnar_samples;
+  for (const auto &columns : column_lists) {
+    for (auto load_mode : load_modes) {
+      bool use_columnar_index = false;
+      columnar_samples.push_back(ReadDataset(columns, load_mode, &use_columnar_index));
+      EXPECT_TRUE(use_columnar_index);
+      ASSERT_EQ(columnar_samples.back().size(), kDatasetRows);
+    }
+  }
+  for (uint64_t i = 0; i < kDatasetRows; ++i) {
+    const auto &label = std::get<1>(columnar_samples[0][i]);
+    EXPECT_EQ(label["label"], static_cast<int32_t>(kDatasetRows - i));
+    EXPECT_EQ(label["file_name"], "image_" + std::to_string(i % 3) + ".jpg");
+    EXPECT_DOUBLE_EQ(label["score"].get<double>(), 0.25 * i);
+  }
+
+  ASSERT_EQ(remove(index_file.c_str()), 0);
+  size_t k = 0;
+  for (const auto &columns : column_lists) {
+    for (auto load_mode : load_modes) {
+      bool use_columnar_index = true;
+      auto sqlite_samples = ReadDataset(columns, load_mode, &use_columnar_index);
+      EXPECT_FALSE(use_columnar_index);
+      EXPECT_EQ(sqlite_samples, columnar_samples[k++]);
+    }
+  }
+}
+
+/// Feature: ShardColumnarIndex
+/// Description: Write a dataset with the columnar index, corrupt the columnar index and read the dataset
+/// Expectation: The reader falls back to sqlite and reads the same samples as without the columnar index
+TEST_F(TestShardColumnarIndex, TestReadFallbackToSqlite) {
+  MS_LOG(INFO) << FormatInfo("Test ShardReader with corrupted columnar index");
+  WriteDataset(false);
+  string index_file = string(kDatasetFile) + kColumnarIndexSuffix;
+  ASSERT_FALSE(std::ifstream(index_file).good());
+  bool use_columnar_index = true;
+  auto expected_samples = ReadDataset({}, LoadMode::kFast, &use_columnar_index);
+  EXPECT_FALSE(use_columnar_index);
+  ASSERT_EQ(expected_samples.size(), kDatasetRows);
+
+  ShardIndexGenerator generator(kDatasetFile, false, true);
+  ASSERT_TRUE(generator.Build().IsOk());
+  ASSERT_TRUE(generator.WriteToDatabase().IsOk());
+  std::ifstream fin(index_file, std::ios::binary);
+  string content((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+  fin.close();
+  ASSERT_GT(content.size(), sizeof(uint64_t));
+  // break the magic number at the head of the file
+  content[0] = static_cast<char>(~content[0]);
+  std::ofstream fout(index_file, std::ios::binary | std::ios::trunc);
+  (void)fout.write(content.data(), content.size());
+  fout.close();
+
+  for (auto load_mode : {LoadMode::kFast, LoadMode::kLazy}) {
+    use_columnar_index = true;
+    auto samples = ReadDataset({}, load_mode, &use_columnar_index);
+    EXPECT_FALSE(use_columnar_index);
+    EXPECT_EQ(samples, expected_samples);
+  }
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -0,0 +1,189 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_test.h"
+#include "plugin/device/cpu/hal/device/cpu_hash_table.h"
+#include "plugin/device/cpu/hal/device/cpu_sharded_hash_table.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUShardedHashTable : public UT::Common {
+ public:
+  TestCPUShardedHashTable() = default;
+  virtual ~TestCPUShardedHashTable() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+using Key = int64_t;
+using Value = float;
+
+namespace {
+// Return the lookup and insert throughput in keys per second.
+std::pair<double, double> MeasureThroughput(HashTable<Key, Value> *hash_table, const std::vector<Key> &keys,
+                                            size_t value_dim) {
+  std::vector<Value> values(keys.size() * value_dim, 1.0);
+  auto start = std::chrono::steady_clock::now();
+  (void)hash_table->Insert(keys.data(), keys.size(), values.data(), nullptr);
+  double insert_cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  start = std::chrono::steady_clock::now();
+  (void)hash_table->Find(keys.data(), keys.size(), false, values.data(), nullptr);
+  double find_cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return {keys.size() / find_cost, keys.size() / insert_cost};
+}
+}  // namespace
+
+/// Feature: test cpu sharded hash table all api.
+/// Description: test cpu sharded hash table data structure and interface.
+/// Expectation: all interface work normally.
+TEST_F(TestCPUShardedHashTable, test_cpu_sharded_hash_table) {
+  size_t value_dim = 4;
+  size_t key_num = 1000;
+  size_t erase_key_num = 500;
+  CPUShardedHashTable<Key, Value> hash_table(value_dim, "ones");
+
+  // Keys and values to insert.
+  std::vector<Key> keys_to_insert(key_num);
+  std::iota(keys_to_insert.begin(), keys_to_insert.end(), -100);
+  std::vector<Value> value_to_insert(key_num * value_dim);
+  for (size_t i = 0; i < key_num; i++) {
+    for (size_t j = 0; j < value_dim; j++) {
+      value_to_insert[i * value_dim + j] = static_cast<Value>(i);
+    }
+  }
+
+  // Keys and values check map.
+  std::unordered_map<Key, std::vector<Value>> keys_values;
+  for (size_t i = 0; i < key_num; ++i) {
+    keys_values.emplace(keys_to_insert[i], std::vector<Value>(value_to_insert.begin() + i * value_dim,
+                                                              value_to_insert.begin() + (i + 1) * value_dim));
+  }
+
+  std::vector<Key> keys_to_check(key_num);
+  std::vector<Value> values_to_check(key_num * value_dim);
+
+  EXPECT_TRUE(hash_table.Reserve(key_num, nullptr));
+  EXPECT_GE(hash_table.capacity(), key_num);
+  EXPECT_TRUE(hash_table.Insert(keys_to_insert.data(), key_num, value_to_insert.data(), nullptr));
+  EXPECT_TRUE(hash_table.Find(keys_to_insert.data(), key_num, false, values_to_check.data(), nullptr));
+  EXPECT_EQ(values_to_check, value_to_insert);
+  EXPECT_TRUE(hash_table.is_dirty());
+  EXPECT_EQ(hash_table.size(), key_num);
+
+  EXPECT_TRUE(hash_table.GetKeysAndValues(keys_to_check.data(), values_to_check.data(), nullptr));
+  for (size_t i = 0; i < key_num; ++i) {
+    EXPECT_TRUE(keys_values.find(keys_to_check[i]) != keys_values.end());
+    EXPECT_EQ(keys_values[keys_to_check[i]], std::vector<Value>(values_to_check.begin() + i * value_dim,
+                                                                values_to_check.begin() + (i + 1) * value_dim));
+  }
+
+  // The full export equals to the incremental export because all the elements are modified.
+  HashTableExportData full_export_data, incre_export_data;
+  EXPECT_NO_THROW(full_export_data = hash_table.Export(false));
+  EXPECT_NO_THROW(incre_export_data = hash_table.Export(true));
+  EXPECT_FALSE(hash_table.is_dirty());
+  EXPECT_EQ(*full_export_data[0], *incre_export_data[0]);
+  EXPECT_EQ(*full_export_data[1], *incre_export_data[1]);
+  EXPECT_EQ(*full_export_data[2], *incre_export_data[2]);
+  EXPECT_EQ(full_export_data[0]->size(), key_num * sizeof(Key));
+  EXPECT_EQ(full_export_data[1]->size(), key_num * value_dim * sizeof(Value));
+  EXPECT_EQ(full_export_data[2]->size(), key_num * sizeof(HashTableElementStatus));
+
+  // Only the elements which are not unchanged are exported incrementally.
+  std::vector<HashTableElementStatus> statuses_to_insert(key_num, HashTableElementStatus::kUnchanged);
+  statuses_to_insert[0] = HashTableElementStatus::kModified;
+  EXPECT_TRUE(
+    hash_table.Insert(keys_to_insert.data(), key_num, value_to_insert.data(), statuses_to_insert.data(), nullptr));
+  EXPECT_NO_THROW(incre_export_data = hash_table.Export(true));
+  EXPECT_EQ(incre_export_data[0]->size(), sizeof(Key));
+  EXPECT_EQ(*reinterpret_cast<Key *>(incre_export_data[0]->data()), keys_to_insert[0]);
+
+  // Export by slices, each slice holds 1M / (value_dim * sizeof(Value)) elements at most.
+  bool last_slice = false;
+  size_t exported_num = 0;
+  while (!last_slice) {
+    HashTableExportData slice;
+    EXPECT_NO_THROW(slice = hash_table.ExportSlice(false, &last_slice, 1));
+    exported_num += slice[0]->size() / sizeof(Key);
+  }
+  EXPECT_EQ(exported_num, key_num);
+
+  // The remaining elements are still found after erasing.
+  EXPECT_TRUE(hash_table.Erase(keys_to_insert.data(), erase_key_num, nullptr));
+  EXPECT_EQ(hash_table.size(), key_num - erase_key_num);
+  EXPECT_FALSE(hash_table.Erase(keys_to_insert.data(), 1, nullptr));
+  EXPECT_TRUE(hash_table.Find(keys_to_insert.data() + erase_key_num, key_num - erase_key_num, false,
+                              values_to_check.data(), nullptr));
+  EXPECT_EQ(std::vector<Value>(values_to_check.begin(), values_to_check.begin() + (key_num - erase_key_num) * value_dim),
+            std::vector<Value>(value_to_insert.begin() + erase_key_num * value_dim, value_to_insert.end()));
+
+  // The missing keys are padded by the initializer.
+  EXPECT_FALSE(hash_table.Find(keys_to_insert.data(), erase_key_num, false, values_to_check.data(), nullptr));
+  EXPECT_TRUE(hash_table.Find(keys_to_insert.data(), erase_key_num, true, values_to_check.data(), nullptr));
+  EXPECT_EQ(std::vector<Value>(values_to_check.begin(), values_to_check.begin() + erase_key_num * value_dim),
+            std::vector<Value>(erase_key_num * value_dim, 1.0));
+  EXPECT_EQ(hash_table.size(), key_num);
+
+  EXPECT_TRUE(hash_table.Clear());
+  EXPECT_EQ(hash_table.size(), 0);
+}
+
+/// Feature: test cpu sharded hash table with large batches.
+/// Description: insert and find a large batch of random keys with the cpu hash table and the sharded one.
+/// Expectation: both hash tables return the same values, the lookup and insert throughput are reported.
+TEST_F(TestCPUShardedHashTable, test_cpu_sharded_hash_table_throughput) {
+  size_t value_dim = 8;
+  size_t key_num = 200000;
+  std::mt19937_64 rng(0);
+  std::vector<Key> keys(key_num);
+  for (auto &key : keys) {
+    key = static_cast<Key>(rng() % (key_num * 4));
+  }
+
+  CPUHashTable<Key, Value> hash_table(value_dim, 0.0f);
+  CPUShardedHashTable<Key, Value> sharded_hash_table(value_dim, 0.0f);
+  auto throughput = MeasureThroughput(&hash_table, keys, value_dim);
+  auto sharded_throughput = MeasureThroughput(&sharded_hash_table, keys, value_dim);
+  EXPECT_EQ(hash_table.size(), sharded_hash_table.size());
+
+  // Find the inserted keys together with some missing keys, which are padded by the default value.
+  for (size_t i = 0; i < key_num; i += 2) {
+    keys[i] = static_cast<Key>(rng() % (key_num * 8));
+  }
+  std::vector<Value> values(key_num * value_dim);
+  std::vector<Value> sharded_values(key_num * value_dim);
+  EXPECT_TRUE(hash_table.Find(keys.data(), key_num, true, values.data(), nullptr));
+  EXPECT_TRUE(sharded_hash_table.Find(keys.data(), key_num, true, sharded_values.data(), nullptr));
+  EXPECT_EQ(values, sharded_values);
+  EXPECT_EQ(hash_table.size(), sharded_hash_table.size());
+
+  MS_LOG(INFO) << "CPU hash table lookup: " << throughput.first << " keys/s, insert: " << throughput.second
+               << " keys/s.";
+  MS_LOG(INFO) << "CPU sharded hash table lookup: " << sharded_throughput.first
+               << " keys/s, insert: " << sharded_throughput.second << " keys/s.";
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
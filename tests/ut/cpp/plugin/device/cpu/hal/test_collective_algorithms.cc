@@ -0,0 +1,182 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include "plugin/device/cpu/hal/hardware/collective_algorithms.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// The messages in flight between the ranks, keyed by the sender and the receiver.
+struct MessageBoard {
+  std::mutex mutex;
+  std::condition_variable cond_var;
+  std::map<std::pair<uint32_t, uint32_t>, std::deque<std::string>> messages;
+};
+
+class MemoryChannel : public CollectiveChannel {
+ public:
+  MemoryChannel(MessageBoard *board, uint32_t rank_id) : board_(board), rank_id_(rank_id) {}
+  ~MemoryChannel() override = default;
+
+  bool SendAsync(uint32_t rank, const void *data, size_t size) override {
+    std::lock_guard<std::mutex> lock(board_->mutex);
+    board_->messages[{rank_id_, rank}].emplace_back(static_cast<const char *>(data), size);
+    board_->cond_var.notify_all();
+    return true;
+  }
+
+  bool WaitForSend(uint32_t) override { return true; }
+
+  bool Receive(uint32_t rank, const std::function<bool(const void *, size_t)> &consumer) override {
+    std::unique_lock<std::mutex> lock(board_->mutex);
+    auto &queue = board_->messages[{rank, rank_id_}];
+    if (!board_->cond_var.wait_for(lock, std::chrono::seconds(10), [&queue] { return !queue.empty(); })) {
+      return false;
+    }
+    std::string message = std::move(queue.front());
+    queue.pop_front();
+    lock.unlock();
+    return consumer(message.data(), message.size());
+  }
+
+ private:
+  MessageBoard *board_;
+  uint32_t rank_id_;
+};
+
+// Run the function on every rank in a thread of its own, the ranks are not in the order of the rank id.
+void RunOnRanks(size_t rank_size, const std::function<bool(CollectiveAlgorithms<float> *, size_t)> &func) {
+  MessageBoard board;
+  std::vector<uint32_t> ranks;
+  for (size_t i = 0; i < rank_size; ++i) {
+    ranks.push_back(static_cast<uint32_t>((rank_size - i) * 3));
+  }
+  std::vector<char> results(rank_size, false);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < rank_size; ++i) {
+    threads.emplace_back([&, i]() {
+      MemoryChannel channel(&board, ranks[i]);
+      CollectiveAlgorithms<float> algorithms(&channel, ranks[i], ranks);
+      results[i] = func(&algorithms, i);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < rank_size; ++i) {
+    EXPECT_TRUE(results[i]) << "rank size " << rank_size << ", index " << i;
+  }
+  for (const auto &iter : board.messages) {
+    EXPECT_TRUE(iter.second.empty()) << "message left from " << iter.first.first << " to " << iter.first.second;
+  }
+}
+}  // namespace
+
+class TestCollectiveAlgorithms : public UT::Common {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+/// Feature: cpu collective algorithms.
+/// Description: AllReduce with ring, recursive doubling and Rabenseifner on rank sizes which are power of two or not,
+/// and counts less than or not divisible by the rank size.
+/// Expectation: every rank gets the sum of the data of all the ranks.
+TEST_F(TestCollectiveAlgorithms, AllReduce) {
+  for (size_t rank_size = 1; rank_size <= 9; ++rank_size) {
+    for (size_t count : {1, 3, 8, 13, 1001}) {
+      for (auto algo : {CollectiveAlgo::kRing, CollectiveAlgo::kRecursiveDoubling, CollectiveAlgo::kRabenseifner,
+                        CollectiveAlgo::kAuto}) {
+        RunOnRanks(rank_size, [rank_size, count, algo](CollectiveAlgorithms<float> *algorithms, size_t index) {
+          std::vector<float> data(count);
+          for (size_t i = 0; i < count; ++i) {
+            data[i] = static_cast<float>(index * 10 + i);
+          }
+          if (!algorithms->AllReduce(data.data(), count, algo)) {
+            return false;
+          }
+          for (size_t i = 0; i < count; ++i) {
+            if (data[i] != static_cast<float>(rank_size * (rank_size - 1) * 5 + rank_size * i)) {
+              return false;
+            }
+          }
+          return true;
+        });
+      }
+    }
+  }
+}
+
+/// Feature: cpu collective algorithms.
+/// Description: broadcast along the binomial tree from every root, and gather along the binomial tree.
+/// Expectation: every rank gets the data of the root, and the data of all the ranks in order.
+TEST_F(TestCollectiveAlgorithms, TreeBroadcastAndAllGather) {
+  constexpr size_t count = 5;
+  for (size_t rank_size = 1; rank_size <= 9; ++rank_size) {
+    for (size_t root = 0; root < rank_size; ++root) {
+      RunOnRanks(rank_size, [root](CollectiveAlgorithms<float> *algorithms, size_t index) {
+        std::vector<float> data(count, index == root ? 1.0 : 0.0);
+        if (!algorithms->TreeBroadcast(data.data(), count, root)) {
+          return false;
+        }
+        return std::all_of(data.begin(), data.end(), [](float value) { return value == 1.0; });
+      });
+    }
+    RunOnRanks(rank_size, [rank_size](CollectiveAlgorithms<float> *algorithms, size_t index) {
+      std::vector<float> output(count * rank_size, -1);
+      for (size_t i = 0; i < count; ++i) {
+        output[index * count + i] = static_cast<float>(index * 100 + i);
+      }
+      if (!algorithms->TreeAllGather(output.data(), count)) {
+        return false;
+      }
+      for (size_t i = 0; i < output.size(); ++i) {
+        if (output[i] != static_cast<float>(i / count * 100 + i % count)) {
+          return false;
+        }
+      }
+      return true;
+    });
+  }
+}
+
+/// Feature: cpu collective algorithms.
+/// Description: select the algorithm by the message size and the rank size with the default thresholds.
+/// Expectation: recursive doubling for small messages, Rabenseifner for medium ones and ring for large ones.
+TEST_F(TestCollectiveAlgorithms, SelectAlgorithm) {
+  auto &selector = CollectiveAlgoSelector::GetInstance();
+  if (selector.forced_allreduce_algo() != CollectiveAlgo::kAuto) {
+    return;
+  }
+  EXPECT_EQ(selector.SelectAllReduce(1, sizeof(float), 8), CollectiveAlgo::kRecursiveDoubling);
+  EXPECT_EQ(selector.SelectAllReduce(1 << 20, sizeof(float), 2), CollectiveAlgo::kRecursiveDoubling);
+  EXPECT_EQ(selector.SelectAllReduce(1 << 18, sizeof(float), 8), CollectiveAlgo::kRabenseifner);
+  EXPECT_EQ(selector.SelectAllReduce(1 << 24, sizeof(float), 8), CollectiveAlgo::kRing);
+  EXPECT_EQ(selector.SelectAllGather(1, sizeof(float), 8), CollectiveAlgo::kTree);
+  EXPECT_EQ(selector.SelectAllGather(1 << 24, sizeof(float), 8), CollectiveAlgo::kRing);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
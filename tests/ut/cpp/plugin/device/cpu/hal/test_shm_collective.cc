@@ -0,0 +1,198 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "plugin/device/cpu/hal/hardware/shm_collective.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kLocalSize = 4;
+// The timeout in seconds of the failure cases.
+constexpr int64_t kShortTimeout = 1;
+// Larger than a slot of 4MB, so the data is processed in several pieces.
+constexpr size_t kDataNum = (6 << 20) / sizeof(float) + 3;
+// No local rank is absent.
+constexpr size_t kNoAbsentRank = SIZE_MAX;
+
+// The value of the element i on the local rank.
+float InputValue(size_t local_rank, size_t i) { return static_cast<float>(local_rank + 1) + static_cast<float>(i % 7); }
+
+// Fork the local ranks 1 to local_size - 1, which attach the segment created by the leader and run `func`, except that
+// `absent_rank` exits at once. The leader runs `leader_func` after the forks. Return whether every rank succeeded.
+bool RunLocalRanks(size_t local_size, int64_t timeout, size_t absent_rank,
+                   const std::function<bool(ShmCollective *)> &func,
+                   const std::function<bool(ShmCollective *)> &leader_func, std::string *name = nullptr) {
+  ShmCollective leader(0, local_size, timeout);
+  std::string shm_name;
+  if (!leader.Create(&shm_name)) {
+    return false;
+  }
+  if (name != nullptr) {
+    *name = shm_name;
+  }
+  std::vector<pid_t> pids;
+  for (size_t local_rank = 1; local_rank < local_size; ++local_rank) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      bool success = true;
+      if (local_rank != absent_rank) {
+        ShmCollective shm(local_rank, local_size, timeout);
+        success = shm.Attach(shm_name) && func(&shm);
+      }
+      // Never return to gtest in the child process.
+      _exit(success ? 0 : 1);
+    }
+    if (pid < 0) {
+      break;
+    }
+    pids.push_back(pid);
+  }
+  bool success = pids.size() == local_size - 1 && leader_func(&leader);
+  for (auto pid : pids) {
+    int status = 0;
+    success = waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0 && success;
+  }
+  return success;
+}
+
+bool CheckAllReduce(ShmCollective *shm) {
+  std::vector<float> input(kDataNum);
+  for (size_t i = 0; i < kDataNum; ++i) {
+    input[i] = InputValue(shm->local_rank(), i);
+  }
+  std::vector<float> output(kDataNum, 0);
+  if (!shm->AllReduce(input.data(), output.data(), kDataNum)) {
+    return false;
+  }
+  for (size_t i = 0; i < kDataNum; ++i) {
+    float expect = 0;
+    for (size_t rank = 0; rank < shm->local_size(); ++rank) {
+      expect += InputValue(rank, i);
+    }
+    if (output[i] != expect) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+class TestShmCollective : public UT::Common {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+/// Feature: shared memory collective of the cpu collective library.
+/// Description: 4 local ranks in 4 processes AllReduce data of several pieces, twice in a row.
+/// Expectation: every rank gets the sum of all the ranks both times.
+TEST_F(TestShmCollective, AllReduce) {
+  auto func = [](ShmCollective *shm) {
+    return shm->WaitForReady() && CheckAllReduce(shm) && CheckAllReduce(shm);
+  };
+  auto leader_func = [](ShmCollective *shm) {
+    return shm->WaitForAttached() && CheckAllReduce(shm) && CheckAllReduce(shm);
+  };
+  ASSERT_TRUE(RunLocalRanks(kLocalSize, kShortTimeout * 10, kNoAbsentRank, func, leader_func));
+}
+
+/// Feature: shared memory collective of the cpu collective library.
+/// Description: 4 local ranks pass the barrier for many rounds, every rank counts itself in a shared counter of the
+/// round before the barrier.
+/// Expectation: after each barrier every rank sees all the ranks counted in the round.
+TEST_F(TestShmCollective, Barrier) {
+  constexpr size_t kRounds = 200;
+  auto *counters = static_cast<std::atomic<uint32_t> *>(mmap(
+    nullptr, kRounds * sizeof(std::atomic<uint32_t>), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+  ASSERT_NE(counters, MAP_FAILED);
+  for (size_t i = 0; i < kRounds; ++i) {
+    counters[i].store(0);
+  }
+  auto run_rounds = [counters](ShmCollective *shm) {
+    for (size_t i = 0; i < kRounds; ++i) {
+      (void)counters[i].fetch_add(1);
+      if (!shm->Barrier() || counters[i].load() != shm->local_size()) {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto func = [&run_rounds](ShmCollective *shm) { return shm->WaitForReady() && run_rounds(shm); };
+  auto leader_func = [&run_rounds](ShmCollective *shm) { return shm->WaitForAttached() && run_rounds(shm); };
+  bool success = RunLocalRanks(kLocalSize, kShortTimeout * 10, kNoAbsentRank, func, leader_func);
+  (void)munmap(counters, kRounds * sizeof(std::atomic<uint32_t>));
+  ASSERT_TRUE(success);
+}
+
+/// Feature: shared memory collective of the cpu collective library.
+/// Description: a local rank never attaches the segment.
+/// Expectation: the leader and the attached ranks are told the segment is not ready, which makes the AllReduce fall
+/// back to the sockets, and the segment is unlinked.
+TEST_F(TestShmCollective, FallbackOnMissingRank) {
+  auto func = [](ShmCollective *shm) { return !shm->WaitForReady(); };
+  auto leader_func = [](ShmCollective *shm) { return !shm->WaitForAttached(); };
+  std::string name;
+  ASSERT_TRUE(RunLocalRanks(kLocalSize, kShortTimeout, kLocalSize - 1, func, leader_func, &name));
+  // Nothing is left in /dev/shm.
+  int fd = shm_open(name.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+  EXPECT_LT(fd, 0);
+  if (fd >= 0) {
+    (void)close(fd);
+  }
+}
+
+/// Feature: shared memory collective of the cpu collective library.
+/// Description: a local rank leaves without arriving at the barrier of an AllReduce.
+/// Expectation: the other ranks fail with a timeout instead of hanging.
+TEST_F(TestShmCollective, BarrierTimeout) {
+  auto func = [](ShmCollective *shm) {
+    if (!shm->WaitForReady()) {
+      return false;
+    }
+    if (shm->local_rank() == kLocalSize - 1) {
+      return true;
+    }
+    return !CheckAllReduce(shm);
+  };
+  auto leader_func = [](ShmCollective *shm) { return shm->WaitForAttached() && !CheckAllReduce(shm); };
+  ASSERT_TRUE(RunLocalRanks(kLocalSize, kShortTimeout, kNoAbsentRank, func, leader_func));
+}
+
+/// Feature: shared memory collective of the cpu collective library.
+/// Description: create with a single local rank, and attach a segment which does not exist.
+/// Expectation: both fail, so the AllReduce falls back to the sockets.
+TEST_F(TestShmCollective, InvalidSetup) {
+  std::string name;
+  ShmCollective single(0, 1);
+  EXPECT_FALSE(single.Create(&name));
+  ShmCollective shm(1, kLocalSize);
+  EXPECT_FALSE(shm.Attach("/ms_collective_not_exist"));
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,201 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/value.h"
+#include "ir/scalar.h"
+#include "ir/tensor.h"
+#include "runtime/pynative/op_compiler.h"
+
+namespace mindspore {
+namespace pynative {
+namespace {
+OpCacheKey BuildKey(const std::string &op_name, const ShapeVector &shape, int64_t axis) {
+  OpCacheKey key;
+  key.AppendString("CPU");
+  key.AppendString(op_name);
+  key.AppendValue(MakeValue(axis));
+  key.AppendInts(shape);
+  key.AppendInt(static_cast<int64_t>(kNumberTypeFloat32));
+  return key;
+}
+
+OpCompilerInfoPtr BuildInfo(const OpCacheKey &key) {
+  auto op_compiler_info =
+    std::make_shared<OpCompilerInfo>("", 0, nullptr, nullptr, false, false, std::vector<KernelWithIndex>(),
+                                     std::vector<size_t>(), std::vector<std::string>(), nullptr);
+  op_compiler_info->cache_key_ = key;
+  return op_compiler_info;
+}
+}  // namespace
+
+class TestOpCompilerCache : public UT::Common {
+ public:
+  TestOpCompilerCache() = default;
+};
+
+/// Feature: Op compiler cache key.
+/// Description: Build the keys of the same op with the same or different shapes, attrs and order of the parts.
+/// Expectation: The keys are equal only if all the parts are equal in the same order.
+TEST_F(TestOpCompilerCache, test_op_cache_key) {
+  EXPECT_EQ(BuildKey("ReduceSum", {2, 3}, 1), BuildKey("ReduceSum", {2, 3}, 1));
+  EXPECT_EQ(BuildKey("ReduceSum", {2, 3}, 1).hash(), BuildKey("ReduceSum", {2, 3}, 1).hash());
+  EXPECT_NE(BuildKey("ReduceSum", {2, 3}, 1), BuildKey("ReduceSum", {3, 2}, 1));
+  EXPECT_NE(BuildKey("ReduceSum", {2, 3}, 1), BuildKey("ReduceSum", {2, 3}, 0));
+  EXPECT_NE(BuildKey("ReduceSum", {2, 3}, 1), BuildKey("ReduceMax", {2, 3}, 1));
+  EXPECT_NE(BuildKey("ReduceSum", {2, 3}, 1), BuildKey("ReduceSum", {2, 3, 1}, 1));
+
+  // A tuple attr is compared by its elements.
+  OpCacheKey tuple_key1;
+  tuple_key1.AppendValue(MakeValue(std::vector<int64_t>{0, 1}));
+  OpCacheKey tuple_key2;
+  tuple_key2.AppendValue(MakeValue(std::vector<int64_t>{0, 1}));
+  OpCacheKey tuple_key3;
+  tuple_key3.AppendValue(MakeValue(std::vector<int64_t>{1, 0}));
+  EXPECT_EQ(tuple_key1, tuple_key2);
+  EXPECT_NE(tuple_key1, tuple_key3);
+
+  // The same strings in different positions make different keys.
+  OpCacheKey string_key1;
+  string_key1.AppendString("ab");
+  string_key1.AppendInt(1);
+  OpCacheKey string_key2;
+  string_key2.AppendInt(1);
+  string_key2.AppendString("ab");
+  OpCacheKey string_key3;
+  string_key3.AppendString("a");
+  string_key3.AppendString("b");
+  string_key3.AppendInt(1);
+  EXPECT_NE(string_key1, string_key2);
+  EXPECT_NE(string_key1, string_key3);
+
+  // A tensor value is kept as its string, so the equal tensors make the same key.
+  OpCacheKey tensor_key1;
+  tensor_key1.AppendValue(std::make_shared<tensor::Tensor>(static_cast<int64_t>(1)));
+  OpCacheKey tensor_key2;
+  tensor_key2.AppendValue(std::make_shared<tensor::Tensor>(static_cast<int64_t>(1)));
+  EXPECT_EQ(tensor_key1, tensor_key2);
+
+  auto key = BuildKey("ReduceSum", {2, 3}, 1);
+  key.Clear();
+  EXPECT_EQ(key, OpCacheKey());
+}
+
+/// Feature: Op compiler cache handle.
+/// Description: Match the parts of the same op with the same or different shapes, attrs, values and number of parts
+/// against a cached key.
+/// Expectation: The parts match only if they make up the whole key in the same order.
+TEST_F(TestOpCompilerCache, test_op_cache_key_matcher) {
+  const auto key = BuildKey("ReduceSum", {2, 3}, 1);
+  auto match = [&key](const std::string &op_name, const ShapeVector &shape, int64_t axis) {
+    OpCacheKeyMatcher matcher(&key);
+    matcher.Clear();
+    matcher.AppendString("CPU");
+    matcher.AppendString(op_name);
+    matcher.AppendValue(MakeValue(axis));
+    matcher.AppendInts(shape);
+    matcher.AppendInt(static_cast<int64_t>(kNumberTypeFloat32));
+    return matcher;
+  };
+  EXPECT_TRUE(match("ReduceSum", {2, 3}, 1).Matched());
+  EXPECT_FALSE(match("ReduceSum", {3, 2}, 1).Matched());
+  EXPECT_FALSE(match("ReduceSum", {2, 3, 1}, 1).Matched());
+  EXPECT_FALSE(match("ReduceSum", {2, 3}, 0).Matched());
+  EXPECT_FALSE(match("ReduceMax", {2, 3}, 1).Matched());
+  // A string which is a prefix of the cached one does not match.
+  EXPECT_FALSE(match("Reduce", {2, 3}, 1).Matched());
+
+  // Missing or extra parts do not match.
+  auto extra = match("ReduceSum", {2, 3}, 1);
+  extra.AppendInt(0);
+  EXPECT_FALSE(extra.Matched());
+  OpCacheKeyMatcher missing(&key);
+  missing.Clear();
+  missing.AppendString("CPU");
+  missing.AppendString("ReduceSum");
+  EXPECT_FALSE(missing.Matched());
+
+  // A tensor value is matched by its string, and a tuple by its elements.
+  OpCacheKey value_key;
+  value_key.AppendValue(std::make_shared<tensor::Tensor>(static_cast<int64_t>(1)));
+  value_key.AppendValue(MakeValue(std::vector<int64_t>{0, 1}));
+  auto match_values = [&value_key](int64_t tensor_value, const std::vector<int64_t> &tuple) {
+    OpCacheKeyMatcher matcher(&value_key);
+    matcher.Clear();
+    matcher.AppendValue(std::make_shared<tensor::Tensor>(tensor_value));
+    matcher.AppendValue(MakeValue(tuple));
+    return matcher.Matched();
+  };
+  EXPECT_TRUE(match_values(1, {0, 1}));
+  EXPECT_FALSE(match_values(2, {0, 1}));
+  EXPECT_FALSE(match_values(1, {1, 0}));
+
+  // The matcher is reused after Clear().
+  auto matcher = match("ReduceMax", {2, 3}, 1);
+  EXPECT_FALSE(matcher.Matched());
+  matcher.Clear();
+  matcher.AppendString("CPU");
+  matcher.AppendString("ReduceSum");
+  matcher.AppendValue(MakeValue(static_cast<int64_t>(1)));
+  matcher.AppendInts({2, 3});
+  matcher.AppendInt(static_cast<int64_t>(kNumberTypeFloat32));
+  EXPECT_TRUE(matcher.Matched());
+}
+
+/// Feature: Op compiler cache.
+/// Description: Insert more entries than the initial capacity, erase half of them and insert them again.
+/// Expectation: Every live entry is found by an equal key and every erased one is not found.
+TEST_F(TestOpCompilerCache, test_op_compiler_cache) {
+  constexpr int64_t kEntryNum = 1000;
+  OpCompilerCache cache;
+  std::vector<OpCompilerInfoPtr> infos;
+  for (int64_t i = 0; i < kEntryNum; ++i) {
+    infos.push_back(BuildInfo(BuildKey("Add", {i, i % 7}, i % 3)));
+    cache.Insert(infos.back());
+  }
+  EXPECT_EQ(cache.size(), kEntryNum);
+  for (int64_t i = 0; i < kEntryNum; ++i) {
+    EXPECT_EQ(cache.Find(BuildKey("Add", {i, i % 7}, i % 3)), infos[i]);
+  }
+  EXPECT_EQ(cache.Find(BuildKey("Sub", {1, 1}, 1)), nullptr);
+
+  for (int64_t i = 0; i < kEntryNum; i += 2) {
+    cache.Erase(infos[i]->cache_key_);
+  }
+  EXPECT_EQ(cache.size(), kEntryNum / 2);
+  for (int64_t i = 0; i < kEntryNum; ++i) {
+    EXPECT_EQ(cache.Find(BuildKey("Add", {i, i % 7}, i % 3)), i % 2 == 0 ? nullptr : infos[i]);
+  }
+
+  // Insert the erased ones again, which reuses the tombstones, and replace one of the live ones.
+  for (int64_t i = 0; i < kEntryNum; i += 2) {
+    cache.Insert(infos[i]);
+  }
+  auto new_info = BuildInfo(infos[1]->cache_key_);
+  cache.Insert(new_info);
+  EXPECT_EQ(cache.size(), kEntryNum);
+  EXPECT_EQ(cache.Find(infos[1]->cache_key_), new_info);
+  EXPECT_EQ(cache.Find(infos[0]->cache_key_), infos[0]);
+
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.Find(infos[0]->cache_key_), nullptr);
+}
+}  // namespace pynative
+}  // namespace mindspore
@@ -14,6 +14,10 @@
 * limitations under the License.
 */
 
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
 #include "gtest/gtest.h"
 #include "mockcpp/mockcpp.hpp"
 #include "runtime/pipeline/ring_queue.h"
@@ -49,4 +53,65 @@ TEST_F(RingQueueTest, TestRingQueue1) {
 
   ASSERT_EQ(queue1.IsEmpty(), true);
 }
+
+/// Feature: Test PyNative RingQueue.
+/// Description: Enqueue from several producers into a small queue, and take the ready tasks in batches.
+/// Expectation: All the tasks are dequeued in the order of every producer, and the counters are updated.
+TEST_F(RingQueueTest, TestRingQueueMultiProducer) {
+  constexpr size_t kProducerNum = 4;
+  constexpr size_t kTaskNum = 10000;
+  RingQueue<std::shared_ptr<size_t>, 16> queue;
+  std::vector<std::thread> producers;
+  for (size_t producer = 0; producer < kProducerNum; ++producer) {
+    producers.emplace_back([&queue, producer]() {
+      for (size_t i = 0; i < kTaskNum; ++i) {
+        queue.Enqueue(std::make_shared<size_t>(producer * kTaskNum + i));
+      }
+    });
+  }
+
+  std::vector<size_t> next(kProducerNum, 0);
+  size_t dequeue_num = 0;
+  while (dequeue_num < kProducerNum * kTaskNum) {
+    auto ready_num = queue.WaitForReady();
+    ASSERT_GT(ready_num, 0);
+    for (; ready_num > 0; --ready_num) {
+      auto element = queue.Head();
+      ASSERT_NE(element, nullptr);
+      const size_t producer = *element / kTaskNum;
+      ASSERT_LT(producer, kProducerNum);
+      ASSERT_EQ(*element % kTaskNum, next[producer]);
+      ++next[producer];
+      queue.Dequeue();
+      ++dequeue_num;
+    }
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  queue.WaitForEmpty();
+  ASSERT_EQ(queue.IsEmpty(), true);
+
+  const auto statistics = queue.Statistics();
+  ASSERT_EQ(statistics.enqueue_count, kProducerNum * kTaskNum);
+  ASSERT_EQ(statistics.size, 0);
+  ASSERT_LE(statistics.max_size, 16);
+}
+
+/// Feature: Test PyNative RingQueue.
+/// Description: The consumer waits on an empty queue until a task is enqueued by another thread.
+/// Expectation: The consumer is woken up and gets the task.
+TEST_F(RingQueueTest, TestRingQueueWakeUp) {
+  RingQueue<std::shared_ptr<size_t>, 16> queue;
+  size_t value = 0;
+  std::thread consumer([&queue, &value]() {
+    value = *queue.Head();
+    queue.Dequeue();
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  queue.Enqueue(std::make_shared<size_t>(1));
+  consumer.join();
+  ASSERT_EQ(value, 1);
+  ASSERT_EQ(queue.IsEmpty(), true);
+}
 } // namespace mindspore
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/device/gsm/io_handle.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore::device {
+namespace {
+// The directory to create the swap directory in, which should be on the local NVMe disk to measure the real bandwidth.
+// The working directory is used by default rather than /tmp, which may be a tmpfs without O_DIRECT.
+constexpr char kEnvSwapBenchmarkPath[] = "MS_SWAP_BENCHMARK_PATH";
+constexpr char kDefaultSwapBenchmarkPath[] = ".";
+constexpr char kLinuxAioLibName[] = "libaio_plugin.so";
+constexpr char kLinuxAioInstanceFuncName[] = "get_aio_instance";
+constexpr size_t kSwapAlignSize = 512;
+constexpr size_t kLayerNum = 16;
+constexpr size_t kPrefetchLayerNum = 2;
+constexpr size_t kBytesPerMB = 1 << 20;
+
+struct AlignedFree {
+  void operator()(uint8_t *ptr) const { std::free(ptr); }
+};
+using ActivationPtr = std::unique_ptr<uint8_t[], AlignedFree>;
+
+double GetBandwidth(size_t byte_num, const std::chrono::steady_clock::time_point &start) {
+  std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+  return cost.count() > 0 ? static_cast<double>(byte_num) / kBytesPerMB / cost.count() : 0;
+}
+}  // namespace
+
+class TestSwapIOBenchmark : public UT::Common {
+ public:
+  TestSwapIOBenchmark() = default;
+
+  void SetUp() override {
+    auto swap_path = common::GetEnv(kEnvSwapBenchmarkPath);
+    if (swap_path.empty()) {
+      swap_path = kDefaultSwapBenchmarkPath;
+    }
+    std::string dir_template = swap_path + "/swap_io_benchmark_XXXXXX";
+    ASSERT_NE(mkdtemp(dir_template.data()), nullptr);
+    swap_dir_ = dir_template;
+  }
+
+  void TearDown() override {
+    for (const auto &file_name : file_names_) {
+      (void)unlink(file_name.c_str());
+    }
+    if (!swap_dir_.empty()) {
+      (void)rmdir(swap_dir_.c_str());
+    }
+  }
+
+ protected:
+  std::string swap_dir_;
+  std::vector<std::string> file_names_;
+};
+
+/// Feature: Swap io benchmark
+/// Description: Swap the activations of a synthetic chain graph out layer by layer as in the forward pass, and swap
+/// them in in the reversed order as in the backward pass, with the reads issued kPrefetchLayerNum layers ahead.
+/// Expectation: The activations swapped in are the same as the ones swapped out, and the bandwidth is logged.
+TEST_F(TestSwapIOBenchmark, test_swap_activations_of_chain_graph) {
+  auto io_handle = std::make_shared<IOHandle>();
+  io_handle->LoadAio(kLinuxAioLibName, kLinuxAioInstanceFuncName);
+
+  // The activations get smaller layer by layer like the feature maps of a convolution network.
+  std::vector<ActivationPtr> activations;
+  std::vector<size_t> sizes;
+  size_t total_size = 0;
+  for (size_t i = 0; i < kLayerNum; ++i) {
+    const size_t size = (kLayerNum - i) * kBytesPerMB / 4 + (i + 1) * kSwapAlignSize;
+    activations.emplace_back(static_cast<uint8_t *>(std::aligned_alloc(kSwapAlignSize, size)));
+    ASSERT_NE(activations.back(), nullptr);
+    for (size_t j = 0; j < size; ++j) {
+      activations.back()[j] = static_cast<uint8_t>(i * 31 + j);
+    }
+    sizes.emplace_back(size);
+    file_names_.emplace_back(swap_dir_ + "/activation_" + std::to_string(i));
+    total_size += size;
+  }
+
+  // Forward: every activation is swapped out as soon as it is produced, and waited only at the end of the pass.
+  std::vector<AsyncIOToken> tokens(kLayerNum, kInvalidAsyncIOToken);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kLayerNum; ++i) {
+    ASSERT_TRUE(io_handle->WriteAsync(file_names_[i], activations[i].get(), sizes[i], &tokens[i]));
+  }
+  for (size_t i = 0; i < kLayerNum; ++i) {
+    ASSERT_TRUE(io_handle->Wait(tokens[i]));
+  }
+  MS_LOG(INFO) << "Swap out " << total_size << " bytes at " << GetBandwidth(total_size, start) << " MB/s";
+
+  // Backward: the activation of every layer is read kPrefetchLayerNum layers before it is used.
+  std::vector<ActivationPtr> swapped_in(kLayerNum);
+  for (size_t i = 0; i < kLayerNum; ++i) {
+    swapped_in[i].reset(static_cast<uint8_t *>(std::aligned_alloc(kSwapAlignSize, sizes[i])));
+    ASSERT_NE(swapped_in[i], nullptr);
+  }
+  const auto read = [&](size_t layer) {
+    return io_handle->ReadAsync(file_names_[layer], swapped_in[layer].get(), sizes[layer], &tokens[layer]);
+  };
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kPrefetchLayerNum && i < kLayerNum; ++i) {
+    ASSERT_TRUE(read(kLayerNum - 1 - i));
+  }
+  for (size_t i = kLayerNum; i-- > 0;) {
+    if (i >= kPrefetchLayerNum) {
+      ASSERT_TRUE(read(i - kPrefetchLayerNum));
+    }
+    ASSERT_TRUE(io_handle->Wait(tokens[i]));
+    EXPECT_EQ(memcmp(swapped_in[i].get(), activations[i].get(), sizes[i]), 0);
+  }
+  MS_LOG(INFO) << "Swap in " << total_size << " bytes at " << GetBandwidth(total_size, start) << " MB/s";
+
+  for (const auto &file_name : file_names_) {
+    EXPECT_TRUE(io_handle->DeleteSwapFile(file_name));
+  }
+}
+}  // namespace mindspore::device
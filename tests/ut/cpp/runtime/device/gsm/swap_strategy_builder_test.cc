@@ -147,4 +147,92 @@ TEST_F(TestSwapStrategyBuilder, test_swap_strategy_with_all_reduce_nodes) {
   }
   EXPECT_EQ(all_actions.size(), 4);
 }
-}  // namespace mindspore::device
\ No newline at end of file
+
+namespace {
+// Get the kernel index before which every tensor is swapped in.
+std::map<size_t, size_t> GetSwapInIndexes(const std::shared_ptr<SwapStrategy> &strategy) {
+  std::map<size_t, size_t> swap_in_indexes;
+  for (const auto &link : strategy->links_) {
+    auto iter = strategy->actions_.find(link->to_);
+    if (iter == strategy->actions_.end()) {
+      continue;
+    }
+    for (const auto &action : iter->second->actions_) {
+      if (action->action_ == SwapActionType::kDDR2HBM || action->action_ == SwapActionType::kDISK2HBM) {
+        swap_in_indexes[action->tensor_id_] = link->from_;
+      }
+    }
+  }
+  return swap_in_indexes;
+}
+
+// Plan the swap in of single spans on a graph whose kernels use the given device memory.
+class SwapInIndexBuilder : public SwapStrategyBuilder {
+ public:
+  SwapInIndexBuilder(size_t prefetch_kernel_num, const std::vector<size_t> &mem_used, size_t total_mem) {
+    context_ = std::make_shared<SwapContext>();
+    context_->prefetch_kernel_num_ = prefetch_kernel_num;
+    kernel_num_ = mem_used.size();
+    mem_used_level0_ = mem_used;
+    total_mem_level0_ = total_mem;
+  }
+
+  size_t SwapInIndex(size_t tensor_size, size_t last_index, size_t current_index) {
+    auto span = std::make_shared<Span>();
+    span->tensor_size_ = tensor_size;
+    span->last_index_ = last_index;
+    span->current_index_ = current_index;
+    return GetSwapInIndex(span);
+  }
+
+  const std::vector<size_t> &mem_used() const { return mem_used_level0_; }
+};
+}  // namespace
+
+/// Feature: SwapStrategyBuilder
+/// Description: Test SwapStrategyBuilder with prefetch kernel num
+/// Expectation: The same tensors are swapped, and every tensor is swapped in no later than without prefetch, and as
+/// many kernels ahead as the prefetch kernel num and the device memory of the kernels in between allow
+TEST_F(TestSwapStrategyBuilder, test_swap_strategy_with_prefetch) {
+  auto builder = std::make_shared<SwapStrategyBuilder>();
+  auto context = std::make_shared<SwapContext>();
+  auto kernel_graph = kernel_graph_add_with_all_reduce_net_;
+  EXPECT_NE(kernel_graph, nullptr);
+
+  context->cpu_mem_size_ = 100;
+  context->hbm_mem_size_ = 250;
+  auto strategy = builder->Build(kernel_graph, context);
+  EXPECT_NE(strategy, nullptr);
+  const auto swap_in_indexes = GetSwapInIndexes(strategy);
+
+  for (size_t prefetch_kernel_num : {1, 2, 8}) {
+    context->prefetch_kernel_num_ = prefetch_kernel_num;
+    auto prefetch_strategy = builder->Build(kernel_graph, context);
+    EXPECT_NE(prefetch_strategy, nullptr);
+    EXPECT_EQ(prefetch_strategy->kernel_num_, strategy->kernel_num_);
+    const auto prefetch_swap_in_indexes = GetSwapInIndexes(prefetch_strategy);
+    EXPECT_EQ(prefetch_swap_in_indexes.size(), swap_in_indexes.size());
+    for (const auto &[tensor_id, index] : prefetch_swap_in_indexes) {
+      auto iter = swap_in_indexes.find(tensor_id);
+      EXPECT_NE(iter, swap_in_indexes.end());
+      if (iter != swap_in_indexes.end()) {
+        EXPECT_LE(index, iter->second);
+      }
+    }
+  }
+
+  // The tensor used by the kernel 6 is swapped in 2 kernels ahead, and the kernels in between hold it.
+  SwapInIndexBuilder prefetch_builder(2, {0, 0, 0, 0, 50, 50, 50, 50}, 100);
+  EXPECT_EQ(prefetch_builder.SwapInIndex(30, 1, 6), 4);
+  EXPECT_EQ(prefetch_builder.mem_used(), std::vector<size_t>({0, 0, 0, 0, 80, 80, 50, 50}));
+  // The kernel 5 can not hold another one, so it is swapped in just in time.
+  EXPECT_EQ(prefetch_builder.SwapInIndex(30, 1, 6), 6);
+  // The swap in is never before the kernel after the swap out.
+  EXPECT_EQ(prefetch_builder.SwapInIndex(10, 3, 6), 5);
+  // The tensor used by the kernel 2 of the second step is swapped in within that step.
+  EXPECT_EQ(prefetch_builder.SwapInIndex(10, 1, 10), 0);
+  // Without prefetch the tensor is swapped in just in time.
+  SwapInIndexBuilder builder_without_prefetch(0, std::vector<size_t>(8, 0), 100);
+  EXPECT_EQ(builder_without_prefetch.SwapInIndex(30, 1, 6), 6);
+}
+}  // namespace mindspore::device
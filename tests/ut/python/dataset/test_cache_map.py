@@ -803,6 +803,11 @@ def test_cache_map_parameter_check():
     assert "Argument spilling with value illegal is not of type" in str(
         info.value)
 
+    with pytest.raises(TypeError) as info:
+        ds.DatasetCache(session_id=1, size=0, compress="illegal")
+    assert "Argument compress with value illegal is not of type" in str(
+        info.value)
+
     with pytest.raises(TypeError) as err:
         ds.DatasetCache(session_id=1, size=0, hostname=50052)
     assert "Argument hostname with value 50052 is not of type" in str(
@@ -25,7 +25,7 @@ def test_set_offload_context():
     """
     offload_config = {"offload_param": "CPU", "offload_path": "./", "offload_cpu_size": "1.0GB",
                       "enable_aio": False, "aio_block_size": "0.5GB", "aio_queue_depth": 9999,
-                      "enable_pinned_mem": True}
+                      "prefetch_kernel_num": 3, "enable_pinned_mem": True}
     context.set_offload_context(offload_config=offload_config)
     offload_config_ = context.get_offload_context()
     offload_param = offload_config_.get("offload_param", None)
@@ -34,6 +34,7 @@ def test_set_offload_context():
     enable_aio = offload_config_.get("enable_aio", None)
     aio_block_size = offload_config_.get("aio_block_size", None)
     aio_queue_depth = offload_config_.get("aio_queue_depth", None)
+    prefetch_kernel_num = offload_config_.get("prefetch_kernel_num", None)
     enable_pinned_mem = offload_config_.get("enable_pinned_mem", None)
     assert offload_param == "cpu"
     assert offload_path == "./"
@@ -41,8 +42,11 @@ def test_set_offload_context():
     assert not enable_aio
     assert aio_block_size == 1 << 29
     assert aio_queue_depth == 9999
+    assert prefetch_kernel_num == 3
     assert enable_pinned_mem
     with pytest.raises(ValueError):
         context.set_offload_context(offload_config={"offload_param": "gpu"})
     with pytest.raises(ValueError):
         context.set_offload_context(offload_config={"offload_disk_size": "1"})
+    with pytest.raises(ValueError):
+        context.set_offload_context(offload_config={"prefetch_kernel_num": -1})